@@ -11,7 +11,10 @@
 /************************************************************************
  * Constructors
  ***********************************************************************/
-ConfigProtocol::ConfigProtocol() { INDICE_STRING_DELIM_ = ','; }
+ConfigProtocol::ConfigProtocol() {
+  balance_regions_ = false;
+  INDICE_STRING_DELIM_ = ',';
+}
 
 /************************************************************************
  * Public Accessors
@@ -26,6 +29,8 @@ CircuitModelId ConfigProtocol::memory_model() const { return memory_model_; }
 
 int ConfigProtocol::num_regions() const { return num_regions_; }
 
+bool ConfigProtocol::balance_regions() const { return balance_regions_; }
+
 size_t ConfigProtocol::num_prog_clocks() const {
   if (type_ != CONFIG_MEM_SCAN_CHAIN) {
     return 1;
@@ -141,6 +146,10 @@ void ConfigProtocol::set_num_regions(const int& num_regions) {
   num_regions_ = num_regions;
 }
 
+void ConfigProtocol::set_balance_regions(const bool& balance_regions) {
+  balance_regions_ = balance_regions;
+}
+
 void ConfigProtocol::set_prog_clock_port(const openfpga::BasicPort& port) {
   prog_clk_port_ = port;
   prog_clk_ccff_head_indices_.resize(prog_clk_port_.get_width());
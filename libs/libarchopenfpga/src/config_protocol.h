@@ -31,6 +31,9 @@ class ConfigProtocol {
   std::string memory_model_name() const;
   CircuitModelId memory_model() const;
   int num_regions() const;
+  /* Identify if configurable children are assigned to regions by their
+   * number of configuration bits rather than their count */
+  bool balance_regions() const;
 
   /* Find the number of programming clocks, only valid for configuration chain
    * type! */
@@ -63,6 +66,7 @@ class ConfigProtocol {
   void set_memory_model_name(const std::string& memory_model_name);
   void set_memory_model(const CircuitModelId& memory_model);
   void set_num_regions(const int& num_regions);
+  void set_balance_regions(const bool& balance_regions);
 
   /* Add the programming clock port */
   void set_prog_clock_port(const openfpga::BasicPort& port);
@@ -111,6 +115,8 @@ class ConfigProtocol {
 
   /* Number of configurable regions */
   int num_regions_;
+  /* Balance the number of configuration bits among configurable regions */
+  bool balance_regions_;
 
   /* Programming clock managment: This is only applicable to configuration chain
    * protocols */
@@ -3,6 +3,8 @@
 
 /* Constants for XML parsers, including readers and writers */
 constexpr const char* XML_CONFIG_PROTOCOL_NUM_REGIONS_ATTR = "num_regions";
+constexpr const char* XML_CONFIG_PROTOCOL_BALANCE_REGIONS_ATTR =
+  "balance_regions";
 constexpr const char* XML_CONFIG_PROTOCOL_CCFF_PROG_CLOCK_NODE_NAME =
   "programming_clock";
 constexpr const char* XML_CONFIG_PROTOCOL_CCFF_PROG_CLOCK_PORT_ATTR = "port";
@@ -178,6 +178,12 @@ static void read_xml_config_organization(pugi::xml_node& xml_config_orgz,
                    config_protocol.num_regions());
   }
 
+  /* Parse the option to balance configurable regions by configuration bits */
+  config_protocol.set_balance_regions(
+    get_attribute(xml_config_orgz, XML_CONFIG_PROTOCOL_BALANCE_REGIONS_ATTR,
+                  loc_data, pugiutil::ReqOpt::OPTIONAL)
+      .as_bool(false));
+
   /* Parse Configuration chain protocols */
   if (config_protocol.type() == CONFIG_MEM_SCAN_CHAIN) {
     /* First pass: Get the programming clock port size */
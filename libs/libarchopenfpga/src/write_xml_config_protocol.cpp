@@ -34,6 +34,10 @@ static void write_xml_config_organization(std::fstream& fp, const char* fname,
     circuit_lib.model_name(config_protocol.memory_model()).c_str());
   write_xml_attribute(fp, XML_CONFIG_PROTOCOL_NUM_REGIONS_ATTR,
                       config_protocol.num_regions());
+  if (true == config_protocol.balance_regions()) {
+    write_xml_attribute(fp, XML_CONFIG_PROTOCOL_BALANCE_REGIONS_ATTR,
+                        config_protocol.balance_regions());
+  }
   fp << "/>"
      << "\n";
 
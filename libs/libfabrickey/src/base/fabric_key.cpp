@@ -2,6 +2,7 @@
 
 #include <algorithm>
 
+#include "openfpga_bin_stream.h"
 #include "vtr_assert.h"
 #include "vtr_log.h"
 
@@ -67,21 +68,19 @@ std::vector<FabricKeyId> FabricKey::find_key_by_alias(
     VTR_LOG_WARN(
       "Empty alias is given! This may cause unexpected results, i.e., a whole "
       "data base is dumped!\n");
-  }
-  size_t num_found_keys = 0;
-  for (FabricKeyId key_id : key_ids_) {
-    if (key_alias(key_id) == alias) {
-      num_found_keys++;
+    std::vector<FabricKeyId> found_keys;
+    for (FabricKeyId key_id : key_ids_) {
+      if (key_alias(key_id).empty()) {
+        found_keys.push_back(key_id);
+      }
     }
+    return found_keys;
   }
-  std::vector<FabricKeyId> found_keys;
-  found_keys.reserve(num_found_keys);
-  for (FabricKeyId key_id : key_ids_) {
-    if (key_alias(key_id) == alias) {
-      found_keys.push_back(key_id);
-    }
+  auto result = alias2key_lookup_.find(alias);
+  if (result == alias2key_lookup_.end()) {
+    return std::vector<FabricKeyId>();
   }
-  return found_keys;
+  return result->second;
 }
 
 std::vector<FabricKeyId> FabricKey::region_keys(
@@ -193,14 +192,13 @@ void FabricKey::add_key_to_region(const FabricRegionId& region_id,
   /* validate the region_id */
   VTR_ASSERT(valid_region_id(region_id));
 
-  /* Check if the key is already in the region */
-  if (region_key_ids_[region_id].end() !=
-      std::find(region_key_ids_[region_id].begin(),
-                region_key_ids_[region_id].end(), key_id)) {
+  /* Check if the key is already in the region. The region of a key is
+   * recorded when it is added, which avoids searching the keys of a large
+   * region */
+  if (region_id == key_regions_[key_id]) {
     VTR_LOG_WARN(
       "Try to add a key '%s' which is already in the region '%lu'!\n",
       key_name(key_id).c_str(), size_t(region_id));
-    VTR_ASSERT(region_id == key_regions_[key_id]);
     return; /* Nothing to do but leave a warning! */
   }
 
@@ -263,6 +261,21 @@ void FabricKey::set_key_alias(const FabricKeyId& key_id,
   /* validate the key_id */
   VTR_ASSERT(valid_key_id(key_id));
 
+  /* Update fast look-up */
+  if (!key_alias_[key_id].empty()) {
+    std::vector<FabricKeyId>& prev_keys = alias2key_lookup_[key_alias_[key_id]];
+    prev_keys.erase(std::find(prev_keys.begin(), prev_keys.end(), key_id));
+    if (prev_keys.empty()) {
+      alias2key_lookup_.erase(key_alias_[key_id]);
+    }
+  }
+  if (!alias.empty()) {
+    /* Keep the keys in the same sequence as they are created */
+    std::vector<FabricKeyId>& curr_keys = alias2key_lookup_[alias];
+    curr_keys.insert(
+      std::upper_bound(curr_keys.begin(), curr_keys.end(), key_id), key_id);
+  }
+
   key_alias_[key_id] = alias;
 }
 
@@ -392,6 +405,80 @@ void FabricKey::set_sub_key_alias(const FabricSubKeyId& key_id,
   sub_key_alias_[key_id] = alias;
 }
 
+/************************************************************************
+ * Public serializers
+ ***********************************************************************/
+/* Dump all the internal data to a binary stream, except the fast look-ups
+ * which are rebuilt when reading.
+ * Note that the sequence of data must be the same as read_from_bin_stream()
+ */
+void FabricKey::write_to_bin_stream(std::ostream& fp) const {
+  /* Top-level keys and regions */
+  write_bin(fp, region_ids_);
+  write_bin(fp, region_key_ids_);
+  write_bin(fp, key_ids_);
+  write_bin(fp, key_names_);
+  write_bin(fp, key_values_);
+  write_bin(fp, key_coordinates_);
+  write_bin(fp, key_regions_);
+  write_bin(fp, key_alias_);
+  write_bin(fp, bl_bank_ids_);
+  write_bin(fp, bl_bank_data_ports_);
+  write_bin(fp, wl_bank_ids_);
+  write_bin(fp, wl_bank_data_ports_);
+
+  /* Sub modules and their keys */
+  write_bin(fp, sub_key_module_ids_);
+  write_bin(fp, sub_key_module_names_);
+  write_bin(fp, module_sub_keys_);
+  write_bin(fp, sub_key_ids_);
+  write_bin(fp, sub_key_names_);
+  write_bin(fp, sub_key_values_);
+  write_bin(fp, sub_key_alias_);
+}
+
+/* Restore all the internal data from a binary stream, which is created by
+ * write_to_bin_stream(). Any existing data will be overwritten
+ */
+void FabricKey::read_from_bin_stream(std::istream& fp) {
+  /* Top-level keys and regions */
+  read_bin(fp, region_ids_);
+  read_bin(fp, region_key_ids_);
+  read_bin(fp, key_ids_);
+  read_bin(fp, key_names_);
+  read_bin(fp, key_values_);
+  read_bin(fp, key_coordinates_);
+  read_bin(fp, key_regions_);
+  read_bin(fp, key_alias_);
+  read_bin(fp, bl_bank_ids_);
+  read_bin(fp, bl_bank_data_ports_);
+  read_bin(fp, wl_bank_ids_);
+  read_bin(fp, wl_bank_data_ports_);
+
+  /* Sub modules and their keys */
+  read_bin(fp, sub_key_module_ids_);
+  read_bin(fp, sub_key_module_names_);
+  read_bin(fp, module_sub_keys_);
+  read_bin(fp, sub_key_ids_);
+  read_bin(fp, sub_key_names_);
+  read_bin(fp, sub_key_values_);
+  read_bin(fp, sub_key_alias_);
+
+  /* Rebuild the fast look-ups, where keys are visited in the sequence of
+   * their ids */
+  alias2key_lookup_.clear();
+  alias2key_lookup_.reserve(key_ids_.size());
+  for (const FabricKeyId& key_id : key_ids_) {
+    if (!key_alias_[key_id].empty()) {
+      alias2key_lookup_[key_alias_[key_id]].push_back(key_id);
+    }
+  }
+  module2subkey_lookup_.clear();
+  for (const FabricKeyModuleId& module_id : sub_key_module_ids_) {
+    module2subkey_lookup_[sub_key_module_names_[module_id]] = module_id;
+  }
+}
+
 /************************************************************************
  * Internal invalidators/validators
  ***********************************************************************/
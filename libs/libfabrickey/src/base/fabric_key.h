@@ -5,8 +5,11 @@
  * This file include the declaration of fabric key
  *******************************************************************/
 #include <array>
+#include <istream>
 #include <map>
+#include <ostream>
 #include <string>
+#include <unordered_map>
 
 /* Headers from vtrutil library */
 #include "vtr_geometry.h"
@@ -177,6 +180,14 @@ class FabricKey {
   void set_sub_key_alias(const FabricSubKeyId& key_id,
                          const std::string& alias);
 
+ public: /* Public serializers */
+  /* Write all the internal data to a binary stream, which can be restored by
+   * read_from_bin_stream() without parsing the fabric key file again */
+  void write_to_bin_stream(std::ostream& fp) const;
+  /* Restore all the internal data from a binary stream. Any existing data will
+   * be overwritten */
+  void read_from_bin_stream(std::istream& fp);
+
  public: /* Public invalidators/validators */
   bool valid_region_id(const FabricRegionId& region_id) const;
   bool valid_key_id(const FabricKeyId& key_id) const;
@@ -208,6 +219,8 @@ class FabricKey {
   vtr::vector<FabricKeyId, FabricRegionId> key_regions_;
   /* Optional alias for each key, with which a key can also be represented */
   vtr::vector<FabricKeyId, std::string> key_alias_;
+  /* Fast look-up for keys with a non-empty alias, sorted by key ids */
+  std::unordered_map<std::string, std::vector<FabricKeyId>> alias2key_lookup_;
 
   /* Unique ids for each BL shift register bank */
   vtr::vector<FabricRegionId,
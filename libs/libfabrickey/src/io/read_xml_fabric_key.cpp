@@ -2,459 +2,480 @@
  * This file includes the top-level function of this library
  * which reads an XML of a fabric key to the associated
  * data structures
+ *
+ * Fabric keys of large devices can be hundreds of MB. The file is parsed
+ * as a stream, without building a document tree, and the parsed fabric key
+ * can be cached in a binary file, which is loaded instead of parsing the
+ * XML again as long as the XML is not changed.
  *******************************************************************/
 #include <string>
 
-/* Headers from pugi XML library */
-#include "pugixml.hpp"
-#include "pugixml_util.hpp"
-
 /* Headers from vtr util library */
 #include "vtr_assert.h"
+#include "vtr_log.h"
 #include "vtr_time.h"
 
 /* Headers from openfpga util library */
+#include "openfpga_file_cache.h"
 #include "openfpga_port_parser.h"
 #include "openfpga_reserved_words.h"
 #include "openfpga_tokenizer.h"
+#include "openfpga_xml_stream.h"
 
 /* Headers from libarchfpga */
 #include "arch_error.h"
 #include "fabric_key_xml_constants.h"
 #include "read_xml_fabric_key.h"
-#include "read_xml_util.h"
 
 namespace openfpga {  // Begin namespace openfpga
 
+/* Any change on the data of fabric key should increase the version number */
+constexpr const char* FABRIC_KEY_CACHE_MAGIC = "OPENFPGA_FABRIC_KEY_CACHE";
+constexpr size_t FABRIC_KEY_CACHE_VERSION = 1;
+
 /********************************************************************
- * Parse XML codes of a <key> to an object of FabricKey
+ * The number of objects, e.g., keys, is only known at the end of their
+ * parent element, while a DOM parser can count the children in advance.
+ * Objects are created on demand when their ids are found, and the largest
+ * id is checked against the number of child elements at the end.
  *******************************************************************/
-static void read_xml_module_key(pugi::xml_node& xml_component_key,
-                                const pugiutil::loc_data& loc_data,
-                                FabricKey& fabric_key,
-                                const FabricKeyModuleId& module_id) {
-  /* Find the id of component key */
-  size_t id = get_attribute(xml_component_key,
-                            XML_FABRIC_KEY_KEY_ATTRIBUTE_ID_NAME, loc_data)
-                .as_int();
+class FabricKeyIdCounter {
+ public: /* Public accessors */
+  /* Number of objects which are expected by the child elements */
+  size_t num_expected_ids() const { return base_ + num_elements_; }
+  size_t num_created_ids() const { return num_ids_; }
+
+ public: /* Public mutators */
+  void reset(const size_t& base) {
+    base_ = base;
+    num_elements_ = 0;
+    num_ids_ = base;
+    last_id_line_ = 0;
+  }
+  void add_element() { ++num_elements_; }
+  /* Return the number of objects to be created for a given id */
+  size_t add_id(const size_t& id, const size_t& line) {
+    if (id < num_ids_) {
+      return 0;
+    }
+    size_t num_new_ids = id + 1 - num_ids_;
+    num_ids_ = id + 1;
+    last_id_line_ = line;
+    return num_new_ids;
+  }
+  /* Error out if any id is out of range, as the DOM parser does */
+  void check(const char* msg) const {
+    if (num_ids_ > num_expected_ids()) {
+      throw XmlStreamError(
+        std::string("Invalid ") + msg + " '" + std::to_string(num_ids_ - 1) +
+          "' (in total " + std::to_string(num_expected_ids()) + ")!",
+        last_id_line_);
+    }
+  }
 
-  FabricSubKeyId sub_key_id = fabric_key.sub_keys(module_id)[id];
+ private: /* Internal data */
+  size_t base_ = 0;
+  size_t num_elements_ = 0;
+  size_t num_ids_ = 0;
+  size_t last_id_line_ = 0;
+};
+
+class FabricKeyXmlHandler : public XmlStreamHandler {
+ public: /* Constructors */
+  FabricKeyXmlHandler(FabricKey& fabric_key, const size_t& file_size)
+    : fabric_key_(fabric_key), max_id_(file_size) {}
+
+ public: /* Callbacks */
+  void start_element(const XmlStreamElement& element) override;
+  void end_element(const XmlStreamElement& element) override;
+
+ private: /* Internal parsers */
+  size_t read_id(const XmlStreamElement& element, const char* attribute);
+  void read_fabric_key_module(const XmlStreamElement& element);
+  void read_fabric_region(const XmlStreamElement& element);
+  void read_region_child(const XmlStreamElement& element);
+  void read_region_key(const XmlStreamElement& element);
+  void read_region_bank(const XmlStreamElement& element);
+  void read_module_key(const XmlStreamElement& element);
+
+ private: /* Internal data */
+  FabricKey& fabric_key_;
+  /* Each object takes at least a few characters in the file, so that an id
+   * beyond the size of file must be invalid. This avoids creating a huge
+   * number of objects before the id can be checked */
+  size_t max_id_;
+
+  /* Status of the current module */
+  bool top_module_ = false;
+  FabricKeyModuleId module_id_;
+  std::vector<FabricSubKeyId> module_keys_;
+  FabricKeyIdCounter region_counter_;
+  FabricKeyIdCounter key_counter_;
+  FabricKeyIdCounter sub_key_counter_;
+
+  /* Status of the current region */
+  FabricRegionId region_id_;
+  bool bl_banks_found_ = false;
+  bool wl_banks_found_ = false;
+
+  /* Status of the current <bl/wl_shift_register_banks>, if any */
+  bool in_bl_banks_ = false;
+  bool in_wl_banks_ = false;
+  FabricKeyIdCounter bank_counter_;
+};
 
-  if (false == fabric_key.valid_sub_key_id(sub_key_id)) {
-    archfpga_throw(loc_data.filename_c_str(), loc_data.line(xml_component_key),
-                   "Invalid 'id' attribute '%d' (in total %lu keys)!\n", id,
-                   fabric_key.sub_keys(module_id).size());
+/********************************************************************
+ * Read an id, which should not be negative
+ *******************************************************************/
+size_t FabricKeyXmlHandler::read_id(const XmlStreamElement& element,
+                                    const char* attribute) {
+  int id = element.get_int_attribute(attribute);
+  if (id < 0 || size_t(id) > max_id_) {
+    element.error(std::string("Invalid '") + attribute + "' attribute '" +
+                  std::to_string(id) + "'!");
   }
+  return size_t(id);
+}
 
-  VTR_ASSERT_SAFE(true == fabric_key.valid_sub_key_id(sub_key_id));
+/********************************************************************
+ * Parse XML codes of a <key> under a regular module
+ *******************************************************************/
+void FabricKeyXmlHandler::read_module_key(const XmlStreamElement& element) {
+  /* Find the id of component key */
+  size_t id = read_id(element, XML_FABRIC_KEY_KEY_ATTRIBUTE_ID_NAME);
+  for (size_t ikey = sub_key_counter_.add_id(id, element.line()); ikey > 0;
+       --ikey) {
+    module_keys_.push_back(fabric_key_.create_module_key(module_id_));
+  }
+  FabricSubKeyId sub_key_id = module_keys_[id];
+  VTR_ASSERT_SAFE(true == fabric_key_.valid_sub_key_id(sub_key_id));
 
   /* If we have an alias, set the value as well */
   const std::string& alias =
-    get_attribute(xml_component_key, XML_FABRIC_KEY_KEY_ATTRIBUTE_ALIAS_NAME,
-                  loc_data, pugiutil::ReqOpt::OPTIONAL)
-      .as_string();
+    element.get_optional_attribute(XML_FABRIC_KEY_KEY_ATTRIBUTE_ALIAS_NAME);
   if (!alias.empty()) {
-    fabric_key.set_sub_key_alias(sub_key_id, alias);
+    fabric_key_.set_sub_key_alias(sub_key_id, alias);
   }
 
   /* If we have the alias set, name and valus are optional then
    * Otherwise, they are mandatory attributes
    */
-  pugiutil::ReqOpt required_name_value = pugiutil::ReqOpt::OPTIONAL;
   if (true == alias.empty()) {
-    required_name_value = pugiutil::ReqOpt::REQUIRED;
+    fabric_key_.set_sub_key_name(
+      sub_key_id,
+      element.get_attribute(XML_FABRIC_KEY_KEY_ATTRIBUTE_NAME_NAME));
+    fabric_key_.set_sub_key_value(
+      sub_key_id,
+      element.get_int_attribute(XML_FABRIC_KEY_KEY_ATTRIBUTE_VALUE_NAME));
+  } else {
+    fabric_key_.set_sub_key_name(
+      sub_key_id,
+      element.get_optional_attribute(XML_FABRIC_KEY_KEY_ATTRIBUTE_NAME_NAME));
+    fabric_key_.set_sub_key_value(
+      sub_key_id, element.get_optional_int_attribute(
+                    XML_FABRIC_KEY_KEY_ATTRIBUTE_VALUE_NAME, 0));
   }
-
-  const std::string& name =
-    get_attribute(xml_component_key, XML_FABRIC_KEY_KEY_ATTRIBUTE_NAME_NAME,
-                  loc_data, required_name_value)
-      .as_string();
-  const size_t& value =
-    get_attribute(xml_component_key, XML_FABRIC_KEY_KEY_ATTRIBUTE_VALUE_NAME,
-                  loc_data, required_name_value)
-      .as_int();
-
-  fabric_key.set_sub_key_name(sub_key_id, name);
-  fabric_key.set_sub_key_value(sub_key_id, value);
 }
 
 /********************************************************************
- * Parse XML codes of a <key> to an object of FabricKey
+ * Parse XML codes of a <key> under a region
  *******************************************************************/
-static void read_xml_region_key(pugi::xml_node& xml_component_key,
-                                const pugiutil::loc_data& loc_data,
-                                FabricKey& fabric_key,
-                                const FabricRegionId& fabric_region) {
+void FabricKeyXmlHandler::read_region_key(const XmlStreamElement& element) {
   /* Find the id of component key */
-  const size_t& id =
-    get_attribute(xml_component_key, XML_FABRIC_KEY_KEY_ATTRIBUTE_ID_NAME,
-                  loc_data)
-      .as_int();
-
-  if (false == fabric_key.valid_key_id(FabricKeyId(id))) {
-    archfpga_throw(loc_data.filename_c_str(), loc_data.line(xml_component_key),
-                   "Invalid 'id' attribute '%d' (in total %lu keys)!\n", id,
-                   fabric_key.keys().size());
+  size_t id = read_id(element, XML_FABRIC_KEY_KEY_ATTRIBUTE_ID_NAME);
+  for (size_t ikey = key_counter_.add_id(id, element.line()); ikey > 0;
+       --ikey) {
+    fabric_key_.create_key();
   }
-
-  VTR_ASSERT_SAFE(true == fabric_key.valid_key_id(FabricKeyId(id)));
+  FabricKeyId key_id = FabricKeyId(id);
+  VTR_ASSERT_SAFE(true == fabric_key_.valid_key_id(key_id));
 
   /* If we have an alias, set the value as well */
   const std::string& alias =
-    get_attribute(xml_component_key, XML_FABRIC_KEY_KEY_ATTRIBUTE_ALIAS_NAME,
-                  loc_data, pugiutil::ReqOpt::OPTIONAL)
-      .as_string();
+    element.get_optional_attribute(XML_FABRIC_KEY_KEY_ATTRIBUTE_ALIAS_NAME);
   if (!alias.empty()) {
-    fabric_key.set_key_alias(FabricKeyId(id), alias);
+    fabric_key_.set_key_alias(key_id, alias);
   }
 
   /* If we have the alias set, name and valus are optional then
    * Otherwise, they are mandatory attributes
    */
-  pugiutil::ReqOpt required_name_value = pugiutil::ReqOpt::OPTIONAL;
   if (true == alias.empty()) {
-    required_name_value = pugiutil::ReqOpt::REQUIRED;
+    fabric_key_.set_key_name(
+      key_id, element.get_attribute(XML_FABRIC_KEY_KEY_ATTRIBUTE_NAME_NAME));
+    fabric_key_.set_key_value(
+      key_id,
+      element.get_int_attribute(XML_FABRIC_KEY_KEY_ATTRIBUTE_VALUE_NAME));
+  } else {
+    fabric_key_.set_key_name(
+      key_id,
+      element.get_optional_attribute(XML_FABRIC_KEY_KEY_ATTRIBUTE_NAME_NAME));
+    fabric_key_.set_key_value(
+      key_id, element.get_optional_int_attribute(
+                XML_FABRIC_KEY_KEY_ATTRIBUTE_VALUE_NAME, 0));
   }
-
-  const std::string& name =
-    get_attribute(xml_component_key, XML_FABRIC_KEY_KEY_ATTRIBUTE_NAME_NAME,
-                  loc_data, required_name_value)
-      .as_string();
-  const size_t& value =
-    get_attribute(xml_component_key, XML_FABRIC_KEY_KEY_ATTRIBUTE_VALUE_NAME,
-                  loc_data, required_name_value)
-      .as_int();
-
-  fabric_key.set_key_name(FabricKeyId(id), name);
-  fabric_key.set_key_value(FabricKeyId(id), value);
-  fabric_key.add_key_to_region(fabric_region, FabricKeyId(id));
+  fabric_key_.add_key_to_region(region_id_, key_id);
 
   /* Parse coordinates */
   vtr::Point<int> coord;
-  coord.set_x(get_attribute(xml_component_key,
-                            XML_FABRIC_KEY_KEY_ATTRIBUTE_COLUMN_NAME, loc_data,
-                            pugiutil::ReqOpt::OPTIONAL)
-                .as_int(-1));
-  coord.set_y(get_attribute(xml_component_key,
-                            XML_FABRIC_KEY_KEY_ATTRIBUTE_ROW_NAME, loc_data,
-                            pugiutil::ReqOpt::OPTIONAL)
-                .as_int(-1));
-  if (fabric_key.valid_key_coordinate(coord)) {
-    fabric_key.set_key_coordinate(FabricKeyId(id), coord);
+  coord.set_x(element.get_optional_int_attribute(
+    XML_FABRIC_KEY_KEY_ATTRIBUTE_COLUMN_NAME, -1));
+  coord.set_y(element.get_optional_int_attribute(
+    XML_FABRIC_KEY_KEY_ATTRIBUTE_ROW_NAME, -1));
+  if (fabric_key_.valid_key_coordinate(coord)) {
+    fabric_key_.set_key_coordinate(key_id, coord);
   }
 }
 
 /********************************************************************
- * Parse XML codes of a <bank> under <bl_shift_register_banks> to an object of
- *FabricKey
+ * Parse XML codes of a <bank> under <bl_shift_register_banks> or
+ * <wl_shift_register_banks>
  *******************************************************************/
-static void read_xml_region_bl_shift_register_bank(
-  pugi::xml_node& xml_bank, const pugiutil::loc_data& loc_data,
-  FabricKey& fabric_key, const FabricRegionId& fabric_region) {
+void FabricKeyXmlHandler::read_region_bank(const XmlStreamElement& element) {
   /* Find the id of the bank */
-  FabricBitLineBankId bank_id = FabricBitLineBankId(
-    get_attribute(xml_bank,
-                  XML_FABRIC_KEY_BLWL_SHIFT_REGISTER_BANK_ATTRIBUTE_ID_NAME,
-                  loc_data)
-      .as_int());
-
-  if (!fabric_key.valid_bl_bank_id(fabric_region, bank_id)) {
-    archfpga_throw(loc_data.filename_c_str(), loc_data.line(xml_bank),
-                   "Invalid 'id' attribute '%lu' (in total %lu BL banks)!\n",
-                   size_t(bank_id), fabric_key.bl_banks(fabric_region).size());
+  size_t id = read_id(
+    element, XML_FABRIC_KEY_BLWL_SHIFT_REGISTER_BANK_ATTRIBUTE_ID_NAME);
+  for (size_t ibank = bank_counter_.add_id(id, element.line()); ibank > 0;
+       --ibank) {
+    if (in_bl_banks_) {
+      fabric_key_.create_bl_shift_register_bank(region_id_);
+    } else {
+      fabric_key_.create_wl_shift_register_bank(region_id_);
+    }
   }
 
-  VTR_ASSERT_SAFE(true == fabric_key.valid_bl_bank_id(fabric_region, bank_id));
-
   /* Parse the ports */
-  std::string data_ports =
-    get_attribute(xml_bank,
-                  XML_FABRIC_KEY_BLWL_SHIFT_REGISTER_BANK_ATTRIBUTE_RANGE_NAME,
-                  loc_data)
-      .as_string();
+  std::string data_ports = element.get_attribute(
+    XML_FABRIC_KEY_BLWL_SHIFT_REGISTER_BANK_ATTRIBUTE_RANGE_NAME);
   /* Split with ',' if we have multiple ports */
   openfpga::StringToken tokenizer(data_ports);
   for (const std::string& data_port : tokenizer.split(',')) {
     openfpga::PortParser data_port_parser(data_port);
-    fabric_key.add_data_port_to_bl_shift_register_bank(fabric_region, bank_id,
-                                                       data_port_parser.port());
-  }
-}
-
-/********************************************************************
- * Parse XML codes of a <bl_shift_register_banks> to an object of FabricKey
- *******************************************************************/
-static void read_xml_region_bl_shift_register_banks(
-  pugi::xml_node& xml_bl_bank, const pugiutil::loc_data& loc_data,
-  FabricKey& fabric_key, const FabricRegionId& fabric_region) {
-  size_t num_banks = count_children(
-    xml_bl_bank, XML_FABRIC_KEY_BLWL_SHIFT_REGISTER_BANK_NODE_NAME, loc_data,
-    pugiutil::ReqOpt::OPTIONAL);
-  fabric_key.reserve_bl_shift_register_banks(fabric_region, num_banks);
-
-  for (size_t ibank = 0; ibank < num_banks; ++ibank) {
-    fabric_key.create_bl_shift_register_bank(fabric_region);
-  }
-
-  for (pugi::xml_node xml_bank : xml_bl_bank.children()) {
-    /* Error out if the XML child has an invalid name! */
-    if (xml_bank.name() !=
-        std::string(XML_FABRIC_KEY_BLWL_SHIFT_REGISTER_BANK_NODE_NAME)) {
-      bad_tag(xml_bank, loc_data, xml_bl_bank,
-              {XML_FABRIC_KEY_BLWL_SHIFT_REGISTER_BANK_NODE_NAME});
+    if (in_bl_banks_) {
+      fabric_key_.add_data_port_to_bl_shift_register_bank(
+        region_id_, FabricBitLineBankId(id), data_port_parser.port());
+    } else {
+      fabric_key_.add_data_port_to_wl_shift_register_bank(
+        region_id_, FabricWordLineBankId(id), data_port_parser.port());
     }
-    read_xml_region_bl_shift_register_bank(xml_bank, loc_data, fabric_key,
-                                           fabric_region);
   }
 }
 
 /********************************************************************
- * Parse XML codes of a <bank> under <wl_shift_register_banks> to an object of
- *FabricKey
+ * Parse XML codes of a child under a region. Any child is counted as a key,
+ * in the same way as the number of keys is estimated by a DOM parser
  *******************************************************************/
-static void read_xml_region_wl_shift_register_bank(
-  pugi::xml_node& xml_bank, const pugiutil::loc_data& loc_data,
-  FabricKey& fabric_key, const FabricRegionId& fabric_region) {
-  /* Find the id of the bank */
-  FabricWordLineBankId bank_id = FabricWordLineBankId(
-    get_attribute(xml_bank,
-                  XML_FABRIC_KEY_BLWL_SHIFT_REGISTER_BANK_ATTRIBUTE_ID_NAME,
-                  loc_data)
-      .as_int());
-
-  if (!fabric_key.valid_wl_bank_id(fabric_region, bank_id)) {
-    archfpga_throw(loc_data.filename_c_str(), loc_data.line(xml_bank),
-                   "Invalid 'id' attribute '%lu' (in total %lu WL banks)!\n",
-                   size_t(bank_id), fabric_key.wl_banks(fabric_region).size());
-  }
+void FabricKeyXmlHandler::read_region_child(const XmlStreamElement& element) {
+  key_counter_.add_element();
 
-  VTR_ASSERT_SAFE(true == fabric_key.valid_wl_bank_id(fabric_region, bank_id));
+  if (element.name() == XML_FABRIC_KEY_KEY_NODE_NAME) {
+    read_region_key(element);
+    return;
+  }
 
-  /* Parse the ports */
-  std::string data_ports =
-    get_attribute(xml_bank,
-                  XML_FABRIC_KEY_BLWL_SHIFT_REGISTER_BANK_ATTRIBUTE_RANGE_NAME,
-                  loc_data)
-      .as_string();
-  /* Split with ',' if we have multiple ports */
-  openfpga::StringToken tokenizer(data_ports);
-  for (const std::string& data_port : tokenizer.split(',')) {
-    openfpga::PortParser data_port_parser(data_port);
-    fabric_key.add_data_port_to_wl_shift_register_bank(fabric_region, bank_id,
-                                                       data_port_parser.port());
+  /* Parse the BL/WL shift register banks for this region, which should be
+   * unique in a region */
+  in_bl_banks_ =
+    (element.name() == XML_FABRIC_KEY_BL_SHIFT_REGISTER_BANKS_NODE_NAME);
+  in_wl_banks_ =
+    (element.name() == XML_FABRIC_KEY_WL_SHIFT_REGISTER_BANKS_NODE_NAME);
+  if ((in_bl_banks_ && bl_banks_found_) || (in_wl_banks_ && wl_banks_found_)) {
+    element.error("Multiple <" + element.name() + "> found in <" +
+                  XML_FABRIC_KEY_REGION_NODE_NAME + ">!");
   }
+  bl_banks_found_ |= in_bl_banks_;
+  wl_banks_found_ |= in_wl_banks_;
+  bank_counter_.reset(0);
 }
 
 /********************************************************************
- * Parse XML codes of a <bl_shift_register_banks> to an object of FabricKey
+ * Parse XML codes of a <region>
  *******************************************************************/
-static void read_xml_region_wl_shift_register_banks(
-  pugi::xml_node& xml_wl_bank, const pugiutil::loc_data& loc_data,
-  FabricKey& fabric_key, const FabricRegionId& fabric_region) {
-  size_t num_banks = count_children(
-    xml_wl_bank, XML_FABRIC_KEY_BLWL_SHIFT_REGISTER_BANK_NODE_NAME, loc_data,
-    pugiutil::ReqOpt::OPTIONAL);
-  fabric_key.reserve_wl_shift_register_banks(fabric_region, num_banks);
-
-  for (size_t ibank = 0; ibank < num_banks; ++ibank) {
-    fabric_key.create_wl_shift_register_bank(fabric_region);
+void FabricKeyXmlHandler::read_fabric_region(const XmlStreamElement& element) {
+  /* Error out if the XML child has an invalid name! */
+  if (element.name() != XML_FABRIC_KEY_REGION_NODE_NAME) {
+    element.bad_tag(XML_FABRIC_KEY_MODULE_NODE_NAME,
+                    {XML_FABRIC_KEY_REGION_NODE_NAME});
   }
+  region_counter_.add_element();
 
-  for (pugi::xml_node xml_bank : xml_wl_bank.children()) {
-    /* Error out if the XML child has an invalid name! */
-    if (xml_bank.name() !=
-        std::string(XML_FABRIC_KEY_BLWL_SHIFT_REGISTER_BANK_NODE_NAME)) {
-      bad_tag(xml_bank, loc_data, xml_wl_bank,
-              {XML_FABRIC_KEY_BLWL_SHIFT_REGISTER_BANK_NODE_NAME});
-    }
-    read_xml_region_wl_shift_register_bank(xml_bank, loc_data, fabric_key,
-                                           fabric_region);
-  }
-}
-
-/********************************************************************
- * Parse XML codes of a <key> to an object of FabricKey
- *******************************************************************/
-static void read_xml_fabric_region(pugi::xml_node& xml_region,
-                                   const pugiutil::loc_data& loc_data,
-                                   FabricKey& fabric_key) {
   /* Find the unique id for the region */
-  const FabricRegionId& region_id = FabricRegionId(
-    get_attribute(xml_region, XML_FABRIC_KEY_REGION_ATTRIBUTE_ID_NAME, loc_data)
-      .as_int());
-  if (false == fabric_key.valid_region_id(region_id)) {
-    archfpga_throw(loc_data.filename_c_str(), loc_data.line(xml_region),
-                   "Invalid region id '%lu' (in total %lu regions)!\n",
-                   size_t(region_id), fabric_key.regions().size());
+  size_t id = read_id(element, XML_FABRIC_KEY_REGION_ATTRIBUTE_ID_NAME);
+  for (size_t iregion = region_counter_.add_id(id, element.line());
+       iregion > 0; --iregion) {
+    fabric_key_.create_region();
   }
-  VTR_ASSERT_SAFE(true == fabric_key.valid_region_id(region_id));
-
-  /* Reserve memory space for the keys in the region */
-  size_t num_keys = count_children(xml_region, XML_FABRIC_KEY_KEY_NODE_NAME,
-                                   loc_data, pugiutil::ReqOpt::OPTIONAL);
-  fabric_key.reserve_region_keys(region_id, num_keys);
-
-  /* Parse the key for this region */
-  if (0 < num_keys) {
-    pugi::xml_node xml_key =
-      get_first_child(xml_region, XML_FABRIC_KEY_KEY_NODE_NAME, loc_data);
-    while (xml_key) {
-      read_xml_region_key(xml_key, loc_data, fabric_key, region_id);
-      xml_key = xml_key.next_sibling(xml_key.name());
-    }
-  }
-
-  /* Parse the BL shift register bank for this region */
-  pugi::xml_node xml_bl_bank = get_single_child(
-    xml_region, XML_FABRIC_KEY_BL_SHIFT_REGISTER_BANKS_NODE_NAME, loc_data,
-    pugiutil::ReqOpt::OPTIONAL);
-  read_xml_region_bl_shift_register_banks(xml_bl_bank, loc_data, fabric_key,
-                                          region_id);
-
-  /* Parse the WL shift register bank for this region */
-  pugi::xml_node xml_wl_bank = get_single_child(
-    xml_region, XML_FABRIC_KEY_WL_SHIFT_REGISTER_BANKS_NODE_NAME, loc_data,
-    pugiutil::ReqOpt::OPTIONAL);
-  read_xml_region_wl_shift_register_banks(xml_wl_bank, loc_data, fabric_key,
-                                          region_id);
+  region_id_ = FabricRegionId(id);
+  VTR_ASSERT_SAFE(true == fabric_key_.valid_region_id(region_id_));
+  bl_banks_found_ = false;
+  wl_banks_found_ = false;
 }
 
 /********************************************************************
- * Parse XML codes of a <module> which is a top-level module
+ * Parse XML codes of a <module> to an object of FabricKey
+ * - For top-level module, we expect a fixed name. If so, its children are
+ *   regions
+ * - For regular module, its children are keys
  *******************************************************************/
-static void read_xml_fabric_key_top_module(pugi::xml_node& xml_module,
-                                           const pugiutil::loc_data& loc_data,
-                                           FabricKey& fabric_key) {
-  size_t num_regions =
-    std::distance(xml_module.children().begin(), xml_module.children().end());
-  /* Reserve memory space for the region */
-  fabric_key.reserve_regions(num_regions);
-  for (size_t iregion = 0; iregion < num_regions; ++iregion) {
-    fabric_key.create_region();
+void FabricKeyXmlHandler::read_fabric_key_module(
+  const XmlStreamElement& element) {
+  /* Error out if the XML child has an invalid name! */
+  if (element.name() != XML_FABRIC_KEY_MODULE_NODE_NAME) {
+    element.bad_tag(XML_FABRIC_KEY_ROOT_NAME,
+                    {XML_FABRIC_KEY_MODULE_NODE_NAME});
   }
-
-  /* Reserve memory space for the keys */
-  size_t num_keys = 0;
-
-  for (pugi::xml_node xml_region : xml_module.children()) {
-    /* Error out if the XML child has an invalid name! */
-    if (xml_region.name() != std::string(XML_FABRIC_KEY_REGION_NODE_NAME)) {
-      bad_tag(xml_region, loc_data, xml_module,
-              {XML_FABRIC_KEY_REGION_NODE_NAME});
-    }
-    num_keys +=
-      std::distance(xml_region.children().begin(), xml_region.children().end());
+  std::string name =
+    element.get_attribute(XML_FABRIC_KEY_MODULE_ATTRIBUTE_NAME_NAME);
+  top_module_ = (name == std::string(openfpga::FPGA_TOP_MODULE_NAME));
+  if (top_module_) {
+    region_counter_.reset(fabric_key_.num_regions());
+    key_counter_.reset(fabric_key_.num_keys());
+    return;
   }
 
-  fabric_key.reserve_keys(num_keys);
-  for (size_t ikey = 0; ikey < num_keys; ++ikey) {
-    fabric_key.create_key();
+  module_id_ = fabric_key_.create_module(name);
+  if (!fabric_key_.valid_module_id(module_id_)) {
+    element.error("Duplicated module '" + name + "'!");
   }
+  module_keys_.clear();
+  sub_key_counter_.reset(0);
+}
 
-  /* Iterate over the children under this node,
-   * each child should be named after circuit_model
-   */
-  for (pugi::xml_node xml_region : xml_module.children()) {
-    /* Error out if the XML child has an invalid name! */
-    if (xml_region.name() != std::string(XML_FABRIC_KEY_REGION_NODE_NAME)) {
-      bad_tag(xml_region, loc_data, xml_module,
-              {XML_FABRIC_KEY_REGION_NODE_NAME});
-    }
-    read_xml_fabric_region(xml_region, loc_data, fabric_key);
+void FabricKeyXmlHandler::start_element(const XmlStreamElement& element) {
+  switch (element.depth()) {
+    case 0:
+      if (element.name() != XML_FABRIC_KEY_ROOT_NAME) {
+        element.error(std::string("Expected root <") +
+                      XML_FABRIC_KEY_ROOT_NAME + "> but found <" +
+                      element.name() + ">!");
+      }
+      break;
+    case 1:
+      read_fabric_key_module(element);
+      break;
+    case 2:
+      if (top_module_) {
+        read_fabric_region(element);
+      } else {
+        /* Error out if the XML child has an invalid name! */
+        if (element.name() != XML_FABRIC_KEY_KEY_NODE_NAME) {
+          element.bad_tag(XML_FABRIC_KEY_MODULE_NODE_NAME,
+                          {XML_FABRIC_KEY_KEY_NODE_NAME});
+        }
+        sub_key_counter_.add_element();
+        read_module_key(element);
+      }
+      break;
+    case 3:
+      if (top_module_) {
+        read_region_child(element);
+      }
+      break;
+    case 4:
+      if (in_bl_banks_ || in_wl_banks_) {
+        /* Error out if the XML child has an invalid name! */
+        if (element.name() !=
+            XML_FABRIC_KEY_BLWL_SHIFT_REGISTER_BANK_NODE_NAME) {
+          element.bad_tag(in_bl_banks_
+                            ? XML_FABRIC_KEY_BL_SHIFT_REGISTER_BANKS_NODE_NAME
+                            : XML_FABRIC_KEY_WL_SHIFT_REGISTER_BANKS_NODE_NAME,
+                          {XML_FABRIC_KEY_BLWL_SHIFT_REGISTER_BANK_NODE_NAME});
+        }
+        bank_counter_.add_element();
+        read_region_bank(element);
+      }
+      break;
+    default:
+      /* Anything deeper is not part of a fabric key */
+      break;
   }
 }
 
 /********************************************************************
- * Parse XML codes of a <module> which is a regular module
+ * Check the ids and create the remaining objects when a parent element
+ * ends, so that the fabric key is the same as the one by a DOM parser
  *******************************************************************/
-static void read_xml_fabric_key_module(pugi::xml_node& xml_module,
-                                       const pugiutil::loc_data& loc_data,
-                                       FabricKey& fabric_key) {
-  std::string name =
-    get_attribute(xml_module, XML_FABRIC_KEY_MODULE_ATTRIBUTE_NAME_NAME,
-                  loc_data)
-      .as_string();
-  FabricKeyModuleId module_id = fabric_key.create_module(name);
-
-  /* Parse all the sub keys */
-  size_t num_keys =
-    std::distance(xml_module.children().begin(), xml_module.children().end());
-
-  /* Reserve for better memory efficiency */
-  fabric_key.reserve_module_keys(module_id, num_keys);
-  for (size_t ikey = 0; ikey < num_keys; ++ikey) {
-    fabric_key.create_module_key(module_id);
-  }
-
-  for (pugi::xml_node xml_key : xml_module.children()) {
-    /* Error out if the XML child has an invalid name! */
-    if (xml_key.name() != std::string(XML_FABRIC_KEY_KEY_NODE_NAME)) {
-      bad_tag(xml_key, loc_data, xml_module, {XML_FABRIC_KEY_KEY_NODE_NAME});
+void FabricKeyXmlHandler::end_element(const XmlStreamElement& element) {
+  if (1 == element.depth() && top_module_) {
+    region_counter_.check("region id");
+    key_counter_.check("'id' attribute");
+    for (size_t iregion = region_counter_.num_created_ids();
+         iregion < region_counter_.num_expected_ids(); ++iregion) {
+      fabric_key_.create_region();
+    }
+    for (size_t ikey = key_counter_.num_created_ids();
+         ikey < key_counter_.num_expected_ids(); ++ikey) {
+      fabric_key_.create_key();
+    }
+  } else if (1 == element.depth()) {
+    sub_key_counter_.check("'id' attribute");
+    for (size_t ikey = sub_key_counter_.num_created_ids();
+         ikey < sub_key_counter_.num_expected_ids(); ++ikey) {
+      fabric_key_.create_module_key(module_id_);
+    }
+  } else if (3 == element.depth() && (in_bl_banks_ || in_wl_banks_)) {
+    bank_counter_.check(in_bl_banks_ ? "BL bank id" : "WL bank id");
+    for (size_t ibank = bank_counter_.num_created_ids();
+         ibank < bank_counter_.num_expected_ids(); ++ibank) {
+      if (in_bl_banks_) {
+        fabric_key_.create_bl_shift_register_bank(region_id_);
+      } else {
+        fabric_key_.create_wl_shift_register_bank(region_id_);
+      }
     }
-    read_xml_module_key(xml_key, loc_data, fabric_key, module_id);
+    in_bl_banks_ = false;
+    in_wl_banks_ = false;
   }
 }
 
 /********************************************************************
- * Parse XML codes of a <module> to an object of FabricKey
- * - For top-level module, we expect a fixed name. If so, we use a special
- *parser
- * - For regular module, we follow regular parser
+ * Parse a fabric key file in memory
  *******************************************************************/
-static void read_xml_fabric_keys_by_modules(pugi::xml_node& xml_module,
-                                            const pugiutil::loc_data& loc_data,
-                                            FabricKey& fabric_key) {
-  std::string name =
-    get_attribute(xml_module, XML_FABRIC_KEY_MODULE_ATTRIBUTE_NAME_NAME,
-                  loc_data)
-      .as_string();
-  if (name == std::string(openfpga::FPGA_TOP_MODULE_NAME)) {
-    read_xml_fabric_key_top_module(xml_module, loc_data, fabric_key);
-  } else {
-    read_xml_fabric_key_module(xml_module, loc_data, fabric_key);
+static FabricKey read_xml_fabric_key_stream(const char* key_fname,
+                                            const MappedFile& xml_file) {
+  FabricKey fabric_key;
+  FabricKeyXmlHandler handler(fabric_key, xml_file.size());
+  try {
+    parse_xml_stream(xml_file.data(), xml_file.size(), handler);
+  } catch (XmlStreamError& e) {
+    archfpga_throw(key_fname, e.line(), "%s", e.what());
   }
+  return fabric_key;
 }
 
 /********************************************************************
  * Parse XML codes about <fabric> to an object of FabricKey
+ * When a cache file is given, the fabric key is loaded from the cache if
+ * the XML is not changed since the cache is written. Otherwise, the cache
+ * is (re)written after parsing the XML.
  *******************************************************************/
-FabricKey read_xml_fabric_key(const char* key_fname) {
+FabricKey read_xml_fabric_key(const char* key_fname,
+                              const std::string& cache_fname) {
   vtr::ScopedStartFinishTimer timer("Read Fabric Key");
 
-  FabricKey fabric_key;
-
-  /* Parse the file */
-  pugi::xml_document doc;
-  pugiutil::loc_data loc_data;
-
-  try {
-    loc_data = pugiutil::load_xml(doc, key_fname);
-
-    pugi::xml_node xml_root =
-      get_single_child(doc, XML_FABRIC_KEY_ROOT_NAME, loc_data);
-
-    /* Under the root node, we expect only modules */
-    size_t num_modules =
-      std::distance(xml_root.children().begin(), xml_root.children().end());
-
-    /* Reserve for memory efficiency */
-    fabric_key.reserve_modules(num_modules);
-
-    /* Walk through the modules, fill keys one by one */
-    for (pugi::xml_node xml_module : xml_root.children()) {
-      /* Error out if the XML child has an invalid name! */
-      if (xml_module.name() != std::string(XML_FABRIC_KEY_MODULE_NODE_NAME)) {
-        bad_tag(xml_module, loc_data, xml_root,
-                {XML_FABRIC_KEY_MODULE_NODE_NAME});
-      }
-      /* Parse fabric keys by module */
-      read_xml_fabric_keys_by_modules(xml_module, loc_data, fabric_key);
-    }
+  MappedFile xml_file;
+  if (!xml_file.open(key_fname)) {
+    archfpga_throw(key_fname, 0, "Unable to open fabric key file!\n");
+  }
+  if (cache_fname.empty()) {
+    return read_xml_fabric_key_stream(key_fname, xml_file);
+  }
 
-  } catch (pugiutil::XmlError& e) {
-    archfpga_throw(key_fname, e.line(), "%s", e.what());
+  uint64_t digest = file_digest(xml_file.data(), xml_file.size());
+  FabricKey fabric_key;
+  if (read_file_cache(
+        cache_fname, FABRIC_KEY_CACHE_MAGIC, FABRIC_KEY_CACHE_VERSION, digest,
+        [&](std::istream& fp) { fabric_key.read_from_bin_stream(fp); })) {
+    VTR_LOG("Loaded fabric key from cache '%s'\n", cache_fname.c_str());
+    return fabric_key;
   }
 
+  fabric_key = read_xml_fabric_key_stream(key_fname, xml_file);
+  if (write_file_cache(
+        cache_fname, FABRIC_KEY_CACHE_MAGIC, FABRIC_KEY_CACHE_VERSION, digest,
+        [&](std::ostream& fp) { fabric_key.write_to_bin_stream(fp); })) {
+    VTR_LOG("Wrote fabric key to cache '%s'\n", cache_fname.c_str());
+  }
   return fabric_key;
 }
 
@@ -4,6 +4,8 @@
 /********************************************************************
  * Include header files that are required by function declaration
  *******************************************************************/
+#include <string>
+
 #include "fabric_key.h"
 
 /********************************************************************
@@ -12,7 +14,8 @@
 
 namespace openfpga {  // Begin namespace openfpga
 
-FabricKey read_xml_fabric_key(const char* key_fname);
+FabricKey read_xml_fabric_key(const char* key_fname,
+                              const std::string& cache_fname = "");
 
 }  // End of namespace openfpga
 
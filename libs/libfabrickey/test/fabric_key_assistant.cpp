@@ -38,7 +38,6 @@ static int check_input_and_ref_key_alias_match(
   VTR_LOG(
     "Checking key alias matching between reference key and input keys...\n");
   for (openfpga::FabricKeyId key_id : ref_key.keys()) {
-    /* Note that this is slow. May consider to build a map first */
     std::string curr_alias = ref_key.key_alias(key_id);
     std::vector<openfpga::FabricKeyId> input_found_keys =
       input_key.find_key_by_alias(curr_alias);
@@ -69,7 +68,6 @@ static int check_input_and_ref_key_alias_match(
   if (num_errors) {
     size_t num_input_keys_checked = 0;
     for (openfpga::FabricKeyId key_id : input_key.keys()) {
-      /* Note that this is slow. May consider to build a map first */
       std::string curr_alias = input_key.key_alias(key_id);
       std::vector<openfpga::FabricKeyId> ref_found_keys =
         ref_key.find_key_by_alias(curr_alias);
@@ -154,7 +152,6 @@ static int update_input_key(openfpga::FabricKey& input_key,
   float progress = 0.;
   VTR_LOG("Pairing key alias between reference key and input keys...\n");
   for (openfpga::FabricKeyId key_id : input_key.keys()) {
-    /* Note that this is slow. May consider to build a map first */
     std::string curr_alias = input_key.key_alias(key_id);
     std::vector<openfpga::FabricKeyId> ref_found_keys =
       ref_key.find_key_by_alias(curr_alias);
@@ -64,11 +64,12 @@ ConfigBlockId BitstreamManager::bit_parent_block(
   return bit_parent_blocks_[bit_id];
 }
 
-std::string BitstreamManager::block_name(const ConfigBlockId& block_id) const {
+const std::string& BitstreamManager::block_name(
+  const ConfigBlockId& block_id) const {
   /* Ensure the input ids are valid */
   VTR_ASSERT(true == valid_block_id(block_id));
 
-  return block_names_[block_id];
+  return block_names_[block_id].str();
 }
 
 ConfigBlockId BitstreamManager::block_parent(
@@ -108,7 +109,47 @@ std::vector<ConfigBitId> BitstreamManager::block_bits(
   return bits;
 }
 
-/* Find the child block in a bitstream manager with a given name */
+/* Find a configuration bit by its hierarchical path, i.e., the names of
+ * the blocks from a top block joined by dots, followed by the index of the
+ * bit in its parent block */
+ConfigBitId BitstreamManager::find_bit(const std::string& path) const {
+  PortParser port_parser(path, PORT_PARSER_SUPPORT_SINGLE_INDEX_FORMAT);
+  if (!port_parser.valid()) {
+    return ConfigBitId::INVALID();
+  }
+  BasicPort port = port_parser.port();
+  StringToken tokenizer(port.get_name());
+  std::vector<std::string> blocks = tokenizer.split(".");
+  if (blocks.empty()) {
+    return ConfigBitId::INVALID();
+  }
+
+  /* Walk down the hierarchy from a top block */
+  ConfigBlockId block_id = ConfigBlockId::INVALID();
+  for (const ConfigBlockId& cand : find_bitstream_manager_top_blocks(*this)) {
+    if (block_name(cand) == blocks[0]) {
+      block_id = cand;
+      break;
+    }
+  }
+  for (size_t i = 1; i < blocks.size() && valid_block_id(block_id); ++i) {
+    block_id = find_child_block(block_id, blocks[i]);
+  }
+  if (!valid_block_id(block_id)) {
+    return ConfigBitId::INVALID();
+  }
+
+  /* Configuration bits are only stored under leaf blocks */
+  if (!child_block_ids_[block_id].empty()) {
+    return ConfigBitId::INVALID();
+  }
+  std::vector<ConfigBitId> ids = block_bits(block_id);
+  if (port.get_lsb() >= ids.size()) {
+    return ConfigBitId::INVALID();
+  }
+  return ids[port.get_lsb()];
+}
+
 ConfigBlockId BitstreamManager::find_child_block(
   const ConfigBlockId& block_id, const std::string& child_block_name) const {
   /* Ensure the input ids are valid */
@@ -116,8 +157,14 @@ ConfigBlockId BitstreamManager::find_child_block(
 
   std::vector<ConfigBlockId> candidates;
 
-  for (const ConfigBlockId& child : block_children(block_id)) {
-    if (0 == child_block_name.compare(block_name(child))) {
+  /* A name which is not in the symbol table cannot be a block name */
+  Symbol child_block_symbol = Symbol::find(child_block_name);
+  if (!child_block_symbol.is_valid()) {
+    return ConfigBlockId::INVALID();
+  }
+
+  for (const ConfigBlockId& child : child_block_ids_[block_id]) {
+    if (child_block_symbol == block_names_[child]) {
       candidates.push_back(child);
     }
   }
@@ -154,6 +201,23 @@ std::string BitstreamManager::block_output_net_ids(
   return block_output_net_ids_[block_id];
 }
 
+void BitstreamManager::memory_usage(MemoryUsage& usage) const {
+  usage.add_container(invalid_block_ids_);
+  usage.add_container(block_bit_id_lsbs_);
+  usage.add_container(block_bit_lengths_);
+  usage.add_container(block_names_);
+  usage.add_container(parent_block_ids_);
+  usage.add_container(child_block_ids_);
+  usage.add_container(block_path_ids_);
+  usage.add_container(block_input_net_ids_);
+  usage.add_container(block_output_net_ids_);
+  usage.add_container(invalid_bit_ids_);
+  usage.add_container(bit_values_);
+  usage.add_container(bit_parent_blocks_);
+
+  usage.add_lookup(block_name2ids_);
+}
+
 /******************************************************************************
  * Public Mutators
  ******************************************************************************/
@@ -225,7 +289,7 @@ void BitstreamManager::set_block_name(const ConfigBlockId& block_id,
                                       const std::string& block_name) {
   /* Ensure the input ids are valid */
   VTR_ASSERT(true == valid_block_id(block_id));
-  block_names_[block_id] = block_name;
+  block_names_[block_id] = Symbol(block_name);
 }
 
 void BitstreamManager::reserve_child_blocks(const ConfigBlockId& parent_block,
@@ -300,6 +364,14 @@ void BitstreamManager::add_output_net_id_to_block(
   block_output_net_ids_[block] = output_net_id;
 }
 
+void BitstreamManager::set_bit_value(const ConfigBitId& bit_id,
+                                     const bool& value) {
+  /* Ensure a valid id */
+  VTR_ASSERT(true == valid_bit_id(bit_id));
+
+  bit_values_[bit_id] = value ? '1' : '0';
+}
+
 void BitstreamManager::overwrite_bitstream(const std::string& path,
                                            const bool& value) {
   PortParser port_parser(path, PORT_PARSER_SUPPORT_SINGLE_INDEX_FORMAT);
@@ -308,59 +380,14 @@ void BitstreamManager::overwrite_bitstream(const std::string& path,
                    "overwrite_bitstream bit path '%s' does not match format "
                    "<full path in the hierarchy of FPGA fabric>[bit index]",
                    path.c_str());
-  } else {
-    BasicPort port = port_parser.port();
-    size_t bit = port.get_lsb();
-    StringToken tokenizer(port.get_name());
-    std::vector<std::string> blocks = tokenizer.split(".");
-    std::vector<ConfigBlockId> block_ids;
-    ConfigBlockId block_id = ConfigBlockId::INVALID();
-    size_t found = 0;
-    for (size_t i = 0; i < blocks.size(); i++) {
-      if (i == 0) {
-        block_ids = find_bitstream_manager_top_blocks(*this);
-      } else {
-        block_ids = block_children(block_id);
-      }
-      // Reset
-      block_id = ConfigBlockId::INVALID();
-      // Find the one from the list that match the name
-      for (auto id : block_ids) {
-        if (block_name(id) == blocks[i]) {
-          block_id = id;
-          break;
-        }
-      }
-      if (block_id != ConfigBlockId::INVALID()) {
-        // Found one that match the name
-        found++;
-        if (found == blocks.size()) {
-          // Last one, no more child must end here
-          if (block_children(block_id).size() == 0) {
-            std::vector<ConfigBitId> ids = block_bits(block_id);
-            if (bit < ids.size()) {
-              VTR_ASSERT(valid_bit_id(ids[bit]));
-              bit_values_[ids[bit]] = value ? '1' : '0';
-            } else {
-              // No configuration bits at all or out of range, invalidate
-              found = 0;
-            }
-          } else {
-            // There are more child, hence the path still no end, invalidate
-            found = 0;
-          }
-        }
-      } else {
-        // Cannot match the name, just stop
-        break;
-      }
-    }
-    if (found != blocks.size()) {
-      archfpga_throw(__FILE__, __LINE__,
-                     "Failed to find path '%s' to overwrite bitstream",
-                     path.c_str());
-    }
   }
+  ConfigBitId bit_id = find_bit(path);
+  if (!valid_bit_id(bit_id)) {
+    archfpga_throw(__FILE__, __LINE__,
+                   "Failed to find path '%s' to overwrite bitstream",
+                   path.c_str());
+  }
+  set_bit_value(bit_id, value);
 }
 
 /******************************************************************************
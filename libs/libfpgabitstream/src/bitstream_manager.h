@@ -43,6 +43,8 @@
 #include <vector>
 
 #include "bitstream_manager_fwd.h"
+#include "openfpga_memory_usage.h"
+#include "openfpga_symbol.h"
 #include "vtr_vector.h"
 
 /* begin namespace openfpga */
@@ -140,7 +142,7 @@ class BitstreamManager {
   ConfigBlockId bit_parent_block(const ConfigBitId& bit_id) const;
 
   /* Find a name of a block */
-  std::string block_name(const ConfigBlockId& block_id) const;
+  const std::string& block_name(const ConfigBlockId& block_id) const;
 
   /* Find the parent of a block */
   ConfigBlockId block_parent(const ConfigBlockId& block_id) const;
@@ -156,6 +158,11 @@ class BitstreamManager {
   ConfigBlockId find_child_block(const ConfigBlockId& block_id,
                                  const std::string& child_block_name) const;
 
+  /* Find the configuration bit at a given path, in the format of
+   * <full path in the hierarchy of FPGA fabric>[bit index].
+   * Return an invalid id if the path is malformed or not found */
+  ConfigBitId find_bit(const std::string& path) const;
+
   /* Find path id of a block */
   int block_path_id(const ConfigBlockId& block_id) const;
 
@@ -165,6 +172,9 @@ class BitstreamManager {
   /* Find input net ids of a block */
   std::string block_output_net_ids(const ConfigBlockId& block_id) const;
 
+  /* Accumulate the heap memory used by the bitstream database */
+  void memory_usage(MemoryUsage& usage) const;
+
  public: /* Public Mutators */
   /* Add a new configuration bit to the bitstream manager */
   ConfigBitId add_bit(const ConfigBlockId& parent_block, const bool& bit_value);
@@ -213,6 +223,9 @@ class BitstreamManager {
   void add_output_net_id_to_block(const ConfigBlockId& block,
                                   const std::string& output_net_id);
 
+  /* Set the value of a configuration bit */
+  void set_bit_value(const ConfigBitId& bit_id, const bool& value);
+
   /* Set bit to the bitstream at the given path */
   void overwrite_bitstream(const std::string& path, const bool& value);
 
@@ -238,7 +251,7 @@ class BitstreamManager {
    * can be instanciated Therefore, this block graph can be considered as a
    * flattened graph of ModuleGraph
    */
-  vtr::vector<ConfigBlockId, std::string> block_names_;
+  vtr::vector<ConfigBlockId, Symbol> block_names_;
   vtr::vector<ConfigBlockId, ConfigBlockId> parent_block_ids_;
   vtr::vector<ConfigBlockId, std::vector<ConfigBlockId>> child_block_ids_;
 
@@ -6,11 +6,15 @@
  *       should NOT be a member function!
  *******************************************************************/
 #include <algorithm>
+#include <string>
 
 /* Headers from vtrutil library */
 #include "bitstream_manager_utils.h"
 #include "vtr_assert.h"
 
+/* Headers from openfpgautil library */
+#include "openfpga_file_cache.h"
+
 /* begin namespace openfpga */
 namespace openfpga {
 
@@ -46,6 +50,24 @@ std::vector<ConfigBlockId> find_bitstream_manager_block_hierarchy(
   return block_hierarchy;
 }
 
+/********************************************************************
+ * Find the full hierarchical name of a block, where the names of the
+ * blocks from the top-level one are joined by dots, e.g.,
+ *   fpga_top.grid_clb_1__1_.logical_tile_clb_mode_clb__0
+ *******************************************************************/
+std::string find_bitstream_manager_block_hierarchy_name(
+  const BitstreamManager& bitstream_manager, const ConfigBlockId& block) {
+  std::string name;
+  for (const ConfigBlockId& parent :
+       find_bitstream_manager_block_hierarchy(bitstream_manager, block)) {
+    if (!name.empty()) {
+      name += std::string(".");
+    }
+    name += bitstream_manager.block_name(parent);
+  }
+  return name;
+}
+
 /********************************************************************
  * Find all the top-level blocks in a bitstream manager,
  * which have no parents
@@ -130,4 +152,29 @@ size_t rec_find_bitstream_manager_block_sum_of_bits(
   return sum_of_bits;
 }
 
+/********************************************************************
+ * Compute a digest of the structure of a bitstream database, i.e., the
+ * name and parent of each block and the parent block of each bit, while
+ * the values of the bits are excluded. Two databases with the same digest
+ * can be considered as built for the same fabric, so that their bits can
+ * be mapped one by one
+ *******************************************************************/
+uint64_t bitstream_manager_structure_digest(
+  const BitstreamManager& bitstream_manager) {
+  std::string buffer;
+  buffer.reserve(bitstream_manager.num_blocks() * 16 +
+                 bitstream_manager.num_bits() * sizeof(size_t));
+  for (const ConfigBlockId& block : bitstream_manager.blocks()) {
+    buffer += bitstream_manager.block_name(block);
+    buffer.push_back('\0');
+    size_t parent = size_t(bitstream_manager.block_parent(block));
+    buffer.append(reinterpret_cast<const char*>(&parent), sizeof(parent));
+  }
+  for (const ConfigBitId& bit : bitstream_manager.bits()) {
+    size_t parent = size_t(bitstream_manager.bit_parent_block(bit));
+    buffer.append(reinterpret_cast<const char*>(&parent), sizeof(parent));
+  }
+  return file_digest(buffer.data(), buffer.size());
+}
+
 } /* end namespace openfpga */
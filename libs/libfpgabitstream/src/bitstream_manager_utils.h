@@ -4,6 +4,8 @@
 /********************************************************************
  * Include header files that are required by function declaration
  *******************************************************************/
+#include <cstdint>
+#include <string>
 #include <vector>
 
 #include "bitstream_manager.h"
@@ -19,6 +21,9 @@ std::vector<ConfigBlockId> find_bitstream_manager_block_hierarchy(
   const BitstreamManager& bitstream_manager, const ConfigBlockId& block,
   const std::string& top_block_name = "");
 
+std::string find_bitstream_manager_block_hierarchy_name(
+  const BitstreamManager& bitstream_manager, const ConfigBlockId& block);
+
 std::vector<ConfigBlockId> find_bitstream_manager_top_blocks(
   const BitstreamManager& bitstream_manager);
 
@@ -31,6 +36,9 @@ size_t find_bitstream_manager_config_bit_index_in_grandparent_block(
 size_t rec_find_bitstream_manager_block_sum_of_bits(
   const BitstreamManager& bitstream_manager, const ConfigBlockId& block);
 
+uint64_t bitstream_manager_structure_digest(
+  const BitstreamManager& bitstream_manager);
+
 } /* end namespace openfpga */
 
 #endif
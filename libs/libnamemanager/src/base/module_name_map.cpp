@@ -7,6 +7,7 @@
 #include <algorithm>
 
 #include "command_exit_codes.h"
+#include "openfpga_bin_stream.h"
 #include "vtr_assert.h"
 #include "vtr_log.h"
 #include "vtr_time.h"
@@ -55,6 +56,11 @@ std::vector<std::string> ModuleNameMap::tags() const {
   return keys;
 }
 
+void ModuleNameMap::memory_usage(MemoryUsage& usage) const {
+  usage.add_container(tag2names_);
+  usage.add_lookup(name2tags_);
+}
+
 int ModuleNameMap::set_tag_to_name_pair(const std::string& tag,
                                         const std::string& name) {
   /*  tagA <--x--> nameA
@@ -86,4 +92,14 @@ void ModuleNameMap::clear() {
   name2tags_.clear();
 }
 
+void ModuleNameMap::write_to_bin_stream(std::ostream& fp) const {
+  write_bin(fp, tag2names_);
+  write_bin(fp, name2tags_);
+}
+
+void ModuleNameMap::read_from_bin_stream(std::istream& fp) {
+  read_bin(fp, tag2names_);
+  read_bin(fp, name2tags_);
+}
+
 } /* end namespace openfpga */
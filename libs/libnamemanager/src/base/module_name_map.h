@@ -4,10 +4,14 @@
 /********************************************************************
  * Include header files required by the data structure definition
  *******************************************************************/
+#include <istream>
 #include <map>
+#include <ostream>
 #include <string>
 #include <vector>
 
+#include "openfpga_memory_usage.h"
+
 /* Begin namespace openfpga */
 namespace openfpga {
 
@@ -30,6 +34,8 @@ class ModuleNameMap {
 
   /** @brief return a list of all the current keys */
   std::vector<std::string> tags() const;
+  /** @brief Accumulate the heap memory used by the name mapping */
+  void memory_usage(MemoryUsage& usage) const;
 
  public: /* Public mutators */
   /** @brief Create the one-on-one mapping between an built-in name and a
@@ -38,6 +44,14 @@ class ModuleNameMap {
   /** @brief Reset to empty status. Clear all the storage */
   void clear();
 
+ public: /* Public serializers */
+  /** @brief Write all the internal data to a binary stream, which can be
+   * restored by read_from_bin_stream() */
+  void write_to_bin_stream(std::ostream& fp) const;
+  /** @brief Restore all the internal data from a binary stream. Any existing
+   * data will be overwritten */
+  void read_from_bin_stream(std::istream& fp);
+
  private: /* Internal Data */
   /* built-in name -> customized_name
    * Create a double link to check any customized name is mapped to more than 1
@@ -1,79 +1,153 @@
 /********************************************************************
  * This file includes the top-level function of this library
- * which reads an XML of clock network file to the associated
+ * which reads an XML of module naming rules to the associated
  * data structures
  *******************************************************************/
 #include <string>
-
-/* Headers from pugi XML library */
-#include "pugixml.hpp"
-#include "pugixml_util.hpp"
+#include <utility>
 
 /* Headers from vtr util library */
 #include "vtr_assert.h"
 #include "vtr_log.h"
 #include "vtr_time.h"
 
+/* Headers from openfpgautil library */
+#include "openfpga_file_cache.h"
+#include "openfpga_xml_stream.h"
+
 /* Headers from libarchfpga */
 #include "arch_error.h"
 #include "command_exit_codes.h"
 #include "module_name_map_xml_constants.h"
 #include "read_xml_module_name_map.h"
-#include "read_xml_util.h"
 
 namespace openfpga {  // Begin namespace openfpga
 
-/********************************************************************
- * Parse XML codes of a <port> to an object of I/O naming
- *******************************************************************/
-static int read_xml_module_name_binding(pugi::xml_node& xml_binding,
-                                        const pugiutil::loc_data& loc_data,
-                                        ModuleNameMap& module_name_map) {
-  std::string default_name =
-    get_attribute(xml_binding, XML_MODULE_NAME_ATTRIBUTE_DEFAULT, loc_data)
-      .as_string();
-  std::string given_name =
-    get_attribute(xml_binding, XML_MODULE_NAME_ATTRIBUTE_GIVEN, loc_data)
-      .as_string();
-
-  return module_name_map.set_tag_to_name_pair(default_name, given_name);
-}
+/* Identifiers of the binary cache of module name maps. Increase the version
+ * whenever the layout of ModuleNameMap::write_to_bin_stream() changes */
+constexpr const char* MODULE_NAME_MAP_CACHE_MAGIC =
+  "OPENFPGA_MODULE_NAME_MAP_CACHE";
+constexpr size_t MODULE_NAME_MAP_CACHE_VERSION = 1;
 
 /********************************************************************
- * Parse XML codes about <ports> to an object of ClockNetwork
+ * Handler of the streaming parser, which parses each <module_name>
+ * as soon as it is read. Parsing stops at the first invalid binding
  *******************************************************************/
-int read_xml_module_name_map(const char* fname,
-                             ModuleNameMap& module_name_map) {
-  vtr::ScopedStartFinishTimer timer("Read module rename rules");
+class ModuleNameMapXmlHandler : public XmlStreamHandler {
+ public: /* Constructors */
+  ModuleNameMapXmlHandler(ModuleNameMap& module_name_map)
+    : module_name_map_(module_name_map), status_(CMD_EXEC_SUCCESS) {}
 
-  int status = CMD_EXEC_SUCCESS;
+ public: /* Public accessors */
+  int status() const { return status_; }
 
-  /* Parse the file */
-  pugi::xml_document doc;
-  pugiutil::loc_data loc_data;
+ public: /* Callbacks */
+  void start_element(const XmlStreamElement& element) override {
+    if (0 == element.depth()) {
+      if (element.name() != std::string(XML_MODULE_NAMES_ROOT_NAME)) {
+        element.error(std::string("Expected root tag <") +
+                      XML_MODULE_NAMES_ROOT_NAME + ">");
+      }
+      return;
+    }
+    if (1 != element.depth()) {
+      return;
+    }
+    /* Error out if the XML child has an invalid name! */
+    if (element.name() != std::string(XML_MODULE_NAME_NODE_NAME)) {
+      element.bad_tag(XML_MODULE_NAMES_ROOT_NAME, {XML_MODULE_NAME_NODE_NAME});
+    }
+    if (CMD_EXEC_SUCCESS != status_) {
+      return;
+    }
+    std::string default_name =
+      element.get_attribute(XML_MODULE_NAME_ATTRIBUTE_DEFAULT);
+    std::string given_name =
+      element.get_attribute(XML_MODULE_NAME_ATTRIBUTE_GIVEN);
+    status_ = module_name_map_.set_tag_to_name_pair(default_name, given_name);
+  }
+
+  void end_element(const XmlStreamElement& /*element*/) override {}
 
+ private: /* Internal data */
+  ModuleNameMap& module_name_map_;
+  int status_;
+};
+
+/********************************************************************
+ * Parse the whole XML file to a module name map
+ *******************************************************************/
+static int read_xml_module_name_map_stream(const char* fname,
+                                           const MappedFile& xml_file,
+                                           ModuleNameMap& module_name_map) {
+  ModuleNameMapXmlHandler handler(module_name_map);
   try {
-    loc_data = pugiutil::load_xml(doc, fname);
+    parse_xml_stream(xml_file.data(), xml_file.size(), handler);
+  } catch (XmlStreamError& e) {
+    archfpga_throw(fname, e.line(), "%s", e.what());
+  }
+  if (CMD_EXEC_SUCCESS != handler.status()) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
+  return CMD_EXEC_SUCCESS;
+}
 
-    pugi::xml_node xml_root =
-      get_single_child(doc, XML_MODULE_NAMES_ROOT_NAME, loc_data);
+/********************************************************************
+ * Parse XML codes about <module_names> to an object of ModuleNameMap
+ * The rules are added to the existing ones of the module name map.
+ * When a cache file is given, the rules are loaded from the cache if
+ * the XML is not changed since the cache is written. Otherwise, the cache
+ * is (re)written after parsing the XML.
+ *******************************************************************/
+int read_xml_module_name_map(const char* fname, ModuleNameMap& module_name_map,
+                             const std::string& cache_fname) {
+  vtr::ScopedStartFinishTimer timer("Read module rename rules");
 
-    for (pugi::xml_node xml_binding : xml_root.children()) {
-      /* Error out if the XML child has an invalid name! */
-      if (xml_binding.name() != std::string(XML_MODULE_NAME_NODE_NAME)) {
-        bad_tag(xml_binding, loc_data, xml_root, {XML_MODULE_NAME_NODE_NAME});
-      }
-      status =
-        read_xml_module_name_binding(xml_binding, loc_data, module_name_map);
-      if (status != CMD_EXEC_SUCCESS) {
-        return CMD_EXEC_FATAL_ERROR;
-      }
+  MappedFile xml_file;
+  if (!xml_file.open(fname)) {
+    archfpga_throw(fname, 0, "Unable to open module name map file!\n");
+  }
+  if (cache_fname.empty()) {
+    return read_xml_module_name_map_stream(fname, xml_file, module_name_map);
+  }
+
+  /* The cache only contains the rules of the XML file, which are merged to
+   * the existing rules afterwards */
+  uint64_t digest = file_digest(xml_file.data(), xml_file.size());
+  ModuleNameMap file_name_map;
+  if (read_file_cache(
+        cache_fname, MODULE_NAME_MAP_CACHE_MAGIC, MODULE_NAME_MAP_CACHE_VERSION,
+        digest,
+        [&](std::istream& fp) { file_name_map.read_from_bin_stream(fp); })) {
+    VTR_LOG("Loaded module rename rules from cache '%s'\n",
+            cache_fname.c_str());
+  } else {
+    file_name_map.clear();
+    int status =
+      read_xml_module_name_map_stream(fname, xml_file, file_name_map);
+    if (CMD_EXEC_SUCCESS != status) {
+      return status;
+    }
+    if (write_file_cache(
+          cache_fname, MODULE_NAME_MAP_CACHE_MAGIC,
+          MODULE_NAME_MAP_CACHE_VERSION, digest,
+          [&](std::ostream& fp) { file_name_map.write_to_bin_stream(fp); })) {
+      VTR_LOG("Wrote module rename rules to cache '%s'\n",
+              cache_fname.c_str());
     }
-  } catch (pugiutil::XmlError& e) {
-    archfpga_throw(fname, e.line(), "%s", e.what());
   }
 
-  return status;
+  if (module_name_map.tags().empty()) {
+    module_name_map = std::move(file_name_map);
+    return CMD_EXEC_SUCCESS;
+  }
+  for (const std::string& tag : file_name_map.tags()) {
+    if (CMD_EXEC_SUCCESS !=
+        module_name_map.set_tag_to_name_pair(tag, file_name_map.name(tag))) {
+      return CMD_EXEC_FATAL_ERROR;
+    }
+  }
+  return CMD_EXEC_SUCCESS;
 }
 
 }  // End of namespace openfpga
@@ -4,9 +4,9 @@
 /********************************************************************
  * Include header files that are required by function declaration
  *******************************************************************/
+#include <string>
+
 #include "module_name_map.h"
-#include "pugixml.hpp"
-#include "pugixml_util.hpp"
 
 /********************************************************************
  * Function declaration
@@ -14,7 +14,8 @@
 
 namespace openfpga {  // Begin namespace openfpga
 
-int read_xml_module_name_map(const char* fname, ModuleNameMap& module_name_map);
+int read_xml_module_name_map(const char* fname, ModuleNameMap& module_name_map,
+                             const std::string& cache_fname = "");
 
 }  // End of namespace openfpga
 
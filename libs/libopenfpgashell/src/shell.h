@@ -54,6 +54,19 @@ namespace openfpga {
  * shell.run();
  *
  ********************************************************************/
+/* Memory of the process, in kB, around the execution of a command */
+struct ShellCommandMemoryRecord {
+  std::string cmd_line;
+  /* Number of commands which are executing this command, e.g., source */
+  size_t depth;
+  size_t rss_before_kb;
+  size_t rss_after_kb;
+  /* Peak during the command. When the peak of the process cannot be reset,
+   * this is the peak since the start of the process, i.e., an upper bound */
+  size_t peak_rss_kb;
+  bool exact_peak;
+};
+
 template <class T>
 class Shell {
  public: /* Types */
@@ -105,10 +118,17 @@ class Shell {
     const ShellCommandId& cmd_id) const;
   std::vector<ShellCommandId> commands_by_class(
     const ShellCommandClassId& cmd_class_id) const;
+  /* Memory records of all the executed commands, in the order they start */
+  const std::vector<ShellCommandMemoryRecord>& command_memory_records() const;
+  bool record_memory() const;
 
  public: /* Public mutators */
   void set_name(const char* name);
   void add_title(const char* title);
+  /* Record the memory of each executed command. The peak memory of the
+   * process is reset when a command starts, which disturbs any external tool
+   * monitoring the peak memory of the process. Disabled by default */
+  void set_record_memory(const bool& enable);
   ShellCommandId add_command(const Command& cmd, const char* descr,
                              const bool& hidden = false);
   void set_command_class(const ShellCommandId& cmd_id,
@@ -183,6 +203,17 @@ class Shell {
   void set_command_dependency(
     const ShellCommandId& cmd_id,
     const std::vector<ShellCommandId>& cmd_dependency);
+  /* Declare that a command can be used in place of another command when
+   * checking dependencies. For example, a command which restores the data
+   * from a file may replace the command which builds the data */
+  void add_command_alternative(const ShellCommandId& cmd_id,
+                               const ShellCommandId& alt_cmd_id);
+  /* Mark a command as never executed, so that any command depending on it
+   * cannot be executed until it is executed again. When 'dependents' is true,
+   * the commands depending on it, directly or indirectly, are marked as well
+   */
+  void reset_command_status(const ShellCommandId& cmd_id,
+                            const bool& dependents = false);
   ShellCommandClassId add_command_class(const char* name);
 
  public: /* Public validators */
@@ -196,6 +227,9 @@ class Shell {
    * commands to run */
   void run_script_mode(const char* script_file_name, T& context,
                        const bool& batch_mode = false);
+  /* Execute all the commands in a script file without entering the
+   * interactive mode. Stop at the first fatal error and return its status */
+  int execute_script(const char* script_file_name, T& context);
   /* Print all the commands by their classes. This is actually the help desk */
   void print_commands(const bool& show_hidden = false) const;
   /* Find the exit code (assume quit shell now) */
@@ -212,6 +246,10 @@ class Shell {
   int execute_command(const char* cmd_line, T& common_context,
                       const bool& allow_hidden_command = true);
 
+ private: /* Internal mutators */
+  /* Raise the peak memory of the commands under execution */
+  void update_running_command_peaks(const size_t& peak_rss_kb);
+
  private: /* Internal data */
   /* Name of the shell, this will appear in the interactive mode */
   std::string name_;
@@ -288,6 +326,9 @@ class Shell {
    */
   vtr::vector<ShellCommandId, std::vector<ShellCommandId>>
     command_dependencies_;
+  /* Commands which can satisfy a dependency on a given command */
+  vtr::vector<ShellCommandId, std::vector<ShellCommandId>>
+    command_alternatives_;
 
   /* Fast name look-up */
   std::map<std::string, ShellCommandId> command_name2ids_;
@@ -297,6 +338,13 @@ class Shell {
 
   /* Timer */
   std::clock_t time_start_;
+
+  /* Memory of each executed command. Commands called by another command are
+   * recorded after their caller, with a higher depth */
+  bool record_memory_;
+  std::vector<ShellCommandMemoryRecord> command_memory_records_;
+  /* Records of the commands under execution, from the outermost one */
+  std::vector<size_t> running_command_records_;
 };
 
 } /* End namespace openfpga */
@@ -9,7 +9,9 @@
 #include "vtr_assert.h"
 
 /* Headers from openfpgautil library */
+#include "openfpga_memory_usage.h"
 #include "openfpga_tokenizer.h"
+#include "openfpga_trace.h"
 
 /* Headers from readline library */
 #include <readline/readline.h>
@@ -29,6 +31,7 @@ template<class T>
 Shell<T>::Shell() {
   name_ = std::string("shell_no_name");
   time_start_ = 0;
+  record_memory_ = false;
 }
 
 /************************************************************************
@@ -101,6 +104,16 @@ std::vector<ShellCommandId> Shell<T>::commands_by_class(const ShellCommandClassI
   return commands_by_classes_[cmd_class_id];
 }
 
+template<class T>
+const std::vector<ShellCommandMemoryRecord>& Shell<T>::command_memory_records() const {
+  return command_memory_records_;
+}
+
+template<class T>
+bool Shell<T>::record_memory() const {
+  return record_memory_;
+}
+
 /************************************************************************
  * Public mutators
  ***********************************************************************/
@@ -114,6 +127,11 @@ void Shell<T>::add_title(const char* title) {
   title_ = std::string(title);
 }
 
+template<class T>
+void Shell<T>::set_record_memory(const bool& enable) {
+  record_memory_ = enable;
+}
+
 /* Add a command with it description */
 template<class T>
 ShellCommandId Shell<T>::add_command(const Command& cmd, const char* descr, const bool& hidden) {
@@ -142,6 +160,7 @@ ShellCommandId Shell<T>::add_command(const Command& cmd, const char* descr, cons
   command_macro_execute_functions_.emplace_back();
   command_status_.push_back(CMD_EXEC_NONE); /* By default, the command should be marked as fatal error as it has been never executed */
   command_dependencies_.emplace_back();
+  command_alternatives_.emplace_back();
 
   /* Register the name in the name2id map */
   command_name2ids_[cmd.name()] = shell_cmd;
@@ -237,6 +256,41 @@ void Shell<T>::set_command_dependency(const ShellCommandId& cmd_id,
   command_dependencies_[cmd_id] = dependent_cmds;
 }
 
+template<class T>
+void Shell<T>::add_command_alternative(const ShellCommandId& cmd_id,
+                                       const ShellCommandId& alt_cmd_id) {
+  VTR_ASSERT(true == valid_command_id(cmd_id));
+  VTR_ASSERT(true == valid_command_id(alt_cmd_id));
+  command_alternatives_[cmd_id].push_back(alt_cmd_id);
+}
+
+template<class T>
+void Shell<T>::reset_command_status(const ShellCommandId& cmd_id,
+                                    const bool& dependents) {
+  VTR_ASSERT(true == valid_command_id(cmd_id));
+  /* A command may be reached through more than one dependency */
+  vtr::vector<ShellCommandId, bool> visited(command_ids_.size(), false);
+  std::vector<ShellCommandId> cmds_to_reset(1, cmd_id);
+  visited[cmd_id] = true;
+  while (!cmds_to_reset.empty()) {
+    ShellCommandId curr_cmd = cmds_to_reset.back();
+    cmds_to_reset.pop_back();
+    command_status_[curr_cmd] = CMD_EXEC_NONE;
+    if (!dependents) {
+      continue;
+    }
+    for (const ShellCommandId& dep_cmd : commands()) {
+      if (command_dependencies_[dep_cmd].end() !=
+          std::find(command_dependencies_[dep_cmd].begin(),
+                    command_dependencies_[dep_cmd].end(), curr_cmd) &&
+          !visited[dep_cmd]) {
+        visited[dep_cmd] = true;
+        cmds_to_reset.push_back(dep_cmd);
+      }
+    }
+  }
+}
+
 /* Add a command with it description */
 template<class T>
 ShellCommandClassId Shell<T>::add_command_class(const char* name) {
@@ -310,6 +364,41 @@ void Shell<T>::run_script_mode(const char* script_file_name,
     VTR_LOG("%s\n", title().c_str());
   } 
 
+  /* Check the file before executing any command */
+  std::ifstream fp(script_file_name);
+
+  if (!fp.is_open()) {
+    /* Fail to open the file, ask user to check */
+    VTR_LOG("Fail to open the script file: %s! Please check its location\n",
+            script_file_name);
+    return; 
+  }
+  fp.close();
+
+  int status = execute_script(script_file_name, context);
+
+  /* Check the execution status of the script, 
+   * if fatal error happened, we should abort immediately 
+   */
+  if (CMD_EXEC_FATAL_ERROR == status) {
+    VTR_LOG("Fatal error occurred!\n");
+    /* If in the batch mode, we will exit with errors */ 
+    VTR_LOGV(batch_mode, "%s Abort\n", name_.c_str());
+    if (batch_mode) {
+      exit(CMD_EXEC_FATAL_ERROR);
+    }
+    /* If not in the batch mode, we will got to interactive mode */ 
+    VTR_LOGV(!batch_mode, "Enter interactive mode\n");
+  }
+
+  /* If not in batch mode, switch to interactive mode, stay tuned */
+  if (!batch_mode) {
+    run_interactive_mode(context, true); 
+  }
+}
+
+template <class T>
+int Shell<T>::execute_script(const char* script_file_name, T& context) {
   std::string line;
 
   /* Create an input file stream */
@@ -319,7 +408,7 @@ void Shell<T>::run_script_mode(const char* script_file_name,
     /* Fail to open the file, ask user to check */
     VTR_LOG("Fail to open the script file: %s! Please check its location\n",
             script_file_name);
-    return; 
+    return CMD_EXEC_FATAL_ERROR; 
   }
 
   /* Consider that each line may not end due to the continued line charactor 
@@ -388,24 +477,14 @@ void Shell<T>::run_script_mode(const char* script_file_name,
        * if fatal error happened, we should abort immediately 
        */
       if (CMD_EXEC_FATAL_ERROR == status) {
-        VTR_LOG("Fatal error occurred!\n");
-        /* If in the batch mode, we will exit with errors */ 
-        VTR_LOGV(batch_mode, "%s Abort\n", name_.c_str());
-        if (batch_mode) {
-          exit(CMD_EXEC_FATAL_ERROR);
-        }
-        /* If not in the batch mode, we will got to interactive mode */ 
-        VTR_LOGV(!batch_mode, "Enter interactive mode\n");
-        break;
+        fp.close();
+        return CMD_EXEC_FATAL_ERROR;
       }
     }
   }
   fp.close();
 
-  /* If not in batch mode, switch to interactive mode, stay tuned */
-  if (!batch_mode) {
-    run_interactive_mode(context, true); 
-  }
+  return CMD_EXEC_SUCCESS;
 }
 
 template <class T>
@@ -550,8 +629,16 @@ int Shell<T>::execute_command(const char* cmd_line,
 
   /* Check the dependency graph to see if all the prequistics have been met */
   for (const ShellCommandId& dep_cmd : command_dependencies_[cmd_id]) {
-    if ( (CMD_EXEC_NONE == command_status_[dep_cmd])
-      || (CMD_EXEC_FATAL_ERROR == command_status_[dep_cmd]) ) {
+    /* A dependency is met when the command itself or any of its alternatives succeeds */
+    bool dep_met = (CMD_EXEC_NONE != command_status_[dep_cmd])
+                && (CMD_EXEC_FATAL_ERROR != command_status_[dep_cmd]);
+    for (const ShellCommandId& alt_cmd : command_alternatives_[dep_cmd]) {
+      if ( (CMD_EXEC_NONE != command_status_[alt_cmd])
+        && (CMD_EXEC_FATAL_ERROR != command_status_[alt_cmd]) ) {
+        dep_met = true;
+      }
+    }
+    if (!dep_met) {
       VTR_LOG("Command '%s' is required to be executed before command '%s'!\n",
               commands_[dep_cmd].name().c_str(), commands_[cmd_id].name().c_str());
       /* Echo the command help desk */
@@ -598,6 +685,25 @@ int Shell<T>::execute_command(const char* cmd_line,
   /* Parse succeed. Let user to confirm selected options */ 
   print_command_context(commands_[cmd_id], command_contexts_[cmd_id]);
 
+  /* Each command is a top-level scope in the trace */
+  OPENFPGA_TRACE_SCOPE_DETAIL(commands_[cmd_id].name(), cmd_line);
+
+  /* Record the memory of the command when requested. The peak of the process
+   * is reset for each command, so the peak reached so far is kept by the
+   * commands which are calling this command, e.g., source */
+  if (record_memory_) {
+    update_running_command_peaks(get_peak_rss_kb());
+    ShellCommandMemoryRecord record;
+    record.cmd_line = std::string(cmd_line);
+    record.depth = running_command_records_.size();
+    record.rss_before_kb = get_current_rss_kb();
+    record.rss_after_kb = record.rss_before_kb;
+    record.peak_rss_kb = record.rss_before_kb;
+    record.exact_peak = reset_peak_rss();
+    running_command_records_.push_back(command_memory_records_.size());
+    command_memory_records_.push_back(record);
+  }
+
   /* Execute the command depending on the type of function ! */ 
   switch (command_execute_function_types_[cmd_id]) {
   case PLUGIN:
@@ -628,10 +734,20 @@ int Shell<T>::execute_command(const char* cmd_line,
     /* This is not allowed! Error out */
     VTR_LOG_ERROR("Invalid type of execute function for command '%s'!\n",
                   commands_[cmd_id].name().c_str());
+    if (record_memory_) {
+      running_command_records_.pop_back();
+      command_memory_records_.pop_back();
+    }
     /* Exit the shell using the exit() function inside this class! */
     return CMD_EXEC_FATAL_ERROR;
   }
 
+  if (record_memory_) {
+    command_memory_records_[running_command_records_.back()].rss_after_kb = get_current_rss_kb();
+    update_running_command_peaks(std::max(get_current_rss_kb(), get_peak_rss_kb()));
+    running_command_records_.pop_back();
+  }
+
   /* Forbid users to return the status CMD_EXEC_NONE */
   if (CMD_EXEC_NONE == command_status_[cmd_id]) {
     VTR_LOG_ERROR("It is illegal to return never-executed status for an executed command!\n");
@@ -641,6 +757,16 @@ int Shell<T>::execute_command(const char* cmd_line,
   return command_status_[cmd_id];
 }
 
+/************************************************************************
+ * Internal mutators
+ ***********************************************************************/
+template<class T>
+void Shell<T>::update_running_command_peaks(const size_t& peak_rss_kb) {
+  for (const size_t& irecord : running_command_records_) {
+    command_memory_records_[irecord].peak_rss_kb = std::max(command_memory_records_[irecord].peak_rss_kb, peak_rss_kb);
+  }
+}
+
 /************************************************************************
  * Public invalidators/validators 
  ***********************************************************************/
@@ -0,0 +1,391 @@
+#ifndef OPENFPGA_BIN_STREAM_H
+#define OPENFPGA_BIN_STREAM_H
+
+/********************************************************************
+ * This file includes template functions to write/read data structures
+ * to/from a binary stream. They are used to dump the internal data of
+ * large databases (e.g., module graph) to a file, which can be loaded
+ * later without rebuilding the database from scratch.
+ *
+ * Encoding rules:
+ * - Numbers and enumerators are written in their native binary format
+ * - Strong ids are written as their index (size_t)
+ * - Strings and containers are written as a size (size_t) followed by
+ *   each of their elements
+ * - Symbols are written as their strings, as handles are only valid in
+ *   the process which creates them
+ *
+ * Note that the binary format is not portable across machines with
+ * different endianness. A version number should be added by the caller
+ * to detect any incompatible file.
+ *
+ * Sizes of strings and containers are checked before any memory is
+ * allocated, so that a corrupted or truncated file fails the stream
+ * rather than exhausting the memory. As a failed read leaves a data
+ * structure partially loaded, data structures should be read into
+ * temporary objects, which replace the original ones only when the whole
+ * stream is read successfully.
+ *******************************************************************/
+#include <istream>
+#include <map>
+#include <ostream>
+#include <string>
+#include <type_traits>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "openfpga_port.h"
+#include "openfpga_symbol.h"
+#include "vtr_geometry.h"
+#include "vtr_strong_id.h"
+#include "vtr_vector.h"
+
+/* namespace openfpga begins */
+namespace openfpga {
+
+/********************************************************************
+ * Declaration of all the writers/readers
+ * They must be declared before definition, as containers are defined
+ * recursively on their elements
+ *******************************************************************/
+template <typename T>
+typename std::enable_if<std::is_arithmetic<T>::value ||
+                        std::is_enum<T>::value>::type
+write_bin(std::ostream& fp, const T& data);
+template <typename T>
+typename std::enable_if<std::is_arithmetic<T>::value ||
+                        std::is_enum<T>::value>::type
+read_bin(std::istream& fp, T& data);
+
+template <typename tag, typename T, T sentinel>
+void write_bin(std::ostream& fp, const vtr::StrongId<tag, T, sentinel>& data);
+template <typename tag, typename T, T sentinel>
+void read_bin(std::istream& fp, vtr::StrongId<tag, T, sentinel>& data);
+
+void write_bin(std::ostream& fp, const std::string& data);
+void read_bin(std::istream& fp, std::string& data);
+
+void write_bin(std::ostream& fp, const Symbol& data);
+void read_bin(std::istream& fp, Symbol& data);
+
+void write_bin(std::ostream& fp, const BasicPort& data);
+void read_bin(std::istream& fp, BasicPort& data);
+
+template <typename T>
+void write_bin(std::ostream& fp, const vtr::Point<T>& data);
+template <typename T>
+void read_bin(std::istream& fp, vtr::Point<T>& data);
+
+template <typename T>
+void write_bin(std::ostream& fp, const vtr::Rect<T>& data);
+template <typename T>
+void read_bin(std::istream& fp, vtr::Rect<T>& data);
+
+template <typename T1, typename T2>
+void write_bin(std::ostream& fp, const std::pair<T1, T2>& data);
+template <typename T1, typename T2>
+void read_bin(std::istream& fp, std::pair<T1, T2>& data);
+
+void write_bin(std::ostream& fp, const std::vector<bool>& data);
+void read_bin(std::istream& fp, std::vector<bool>& data);
+
+template <typename T>
+void write_bin(std::ostream& fp, const std::vector<T>& data);
+template <typename T>
+void read_bin(std::istream& fp, std::vector<T>& data);
+
+template <typename K>
+void write_bin(std::ostream& fp, const vtr::vector<K, bool>& data);
+template <typename K>
+void read_bin(std::istream& fp, vtr::vector<K, bool>& data);
+
+template <typename K, typename V>
+void write_bin(std::ostream& fp, const vtr::vector<K, V>& data);
+template <typename K, typename V>
+void read_bin(std::istream& fp, vtr::vector<K, V>& data);
+
+template <typename K, typename V>
+void write_bin(std::ostream& fp, const std::map<K, V>& data);
+template <typename K, typename V>
+void read_bin(std::istream& fp, std::map<K, V>& data);
+
+template <typename T>
+void write_bin(std::ostream& fp, const std::unordered_set<T>& data);
+template <typename T>
+void read_bin(std::istream& fp, std::unordered_set<T>& data);
+
+/********************************************************************
+ * Definition
+ *******************************************************************/
+template <typename T>
+typename std::enable_if<std::is_arithmetic<T>::value ||
+                        std::is_enum<T>::value>::type
+write_bin(std::ostream& fp, const T& data) {
+  fp.write(reinterpret_cast<const char*>(&data), sizeof(T));
+}
+
+template <typename T>
+typename std::enable_if<std::is_arithmetic<T>::value ||
+                        std::is_enum<T>::value>::type
+read_bin(std::istream& fp, T& data) {
+  fp.read(reinterpret_cast<char*>(&data), sizeof(T));
+}
+
+/* Sizes up to this limit only cost a small allocation, so they are
+ * accepted without seeking the stream, which is costly for file streams */
+constexpr size_t BIN_STREAM_UNCHECKED_SIZE = size_t(1) << 16;
+/* Limit of sizes when the bytes left in a stream are unknown */
+constexpr size_t BIN_STREAM_MAX_SIZE = size_t(1) << 32;
+
+/********************************************************************
+ * Read the size of a string or a container. As each element takes at
+ * least one byte, a size larger than the number of bytes left in the
+ * stream can only come from a corrupted or truncated file. In such case,
+ * the stream is failed and a size of 0 is returned.
+ *******************************************************************/
+inline size_t read_bin_size(std::istream& fp) {
+  size_t num_elem = 0;
+  read_bin(fp, num_elem);
+  if (fp.fail()) {
+    return 0;
+  }
+  if (num_elem <= BIN_STREAM_UNCHECKED_SIZE) {
+    return num_elem;
+  }
+
+  size_t max_size = BIN_STREAM_MAX_SIZE;
+  std::streampos curr_pos = fp.tellg();
+  if (std::streampos(-1) != curr_pos) {
+    fp.seekg(0, std::ios_base::end);
+    std::streampos end_pos = fp.tellg();
+    fp.seekg(curr_pos);
+    if (fp.fail()) {
+      return 0;
+    }
+    max_size = size_t(end_pos - curr_pos);
+  }
+  if (num_elem > max_size) {
+    fp.setstate(std::ios_base::failbit);
+    return 0;
+  }
+  return num_elem;
+}
+
+template <typename tag, typename T, T sentinel>
+void write_bin(std::ostream& fp, const vtr::StrongId<tag, T, sentinel>& data) {
+  write_bin(fp, size_t(data));
+}
+
+template <typename tag, typename T, T sentinel>
+void read_bin(std::istream& fp, vtr::StrongId<tag, T, sentinel>& data) {
+  size_t index = 0;
+  read_bin(fp, index);
+  data = vtr::StrongId<tag, T, sentinel>(T(index));
+}
+
+inline void write_bin(std::ostream& fp, const std::string& data) {
+  write_bin(fp, data.size());
+  fp.write(data.data(), data.size());
+}
+
+inline void read_bin(std::istream& fp, std::string& data) {
+  size_t num_chars = read_bin_size(fp);
+  data.resize(num_chars);
+  fp.read(&data[0], num_chars);
+}
+
+inline void write_bin(std::ostream& fp, const Symbol& data) {
+  write_bin(fp, data.str());
+}
+
+inline void read_bin(std::istream& fp, Symbol& data) {
+  std::string str;
+  read_bin(fp, str);
+  data = Symbol(str);
+}
+
+inline void write_bin(std::ostream& fp, const BasicPort& data) {
+  write_bin(fp, data.get_name());
+  /* Use the raw lsb and msb, so that invalid ports are kept as they are */
+  write_bin(fp, data.get_lsb());
+  write_bin(fp, data.get_msb());
+  write_bin(fp, data.get_origin_port_width());
+}
+
+inline void read_bin(std::istream& fp, BasicPort& data) {
+  std::string name;
+  size_t lsb = 0;
+  size_t msb = 0;
+  size_t origin_port_width = 0;
+  read_bin(fp, name);
+  read_bin(fp, lsb);
+  read_bin(fp, msb);
+  read_bin(fp, origin_port_width);
+  data.set_name(name);
+  data.set_lsb(lsb);
+  data.set_msb(msb);
+  data.set_origin_port_width(origin_port_width);
+}
+
+template <typename T>
+void write_bin(std::ostream& fp, const vtr::Point<T>& data) {
+  write_bin(fp, data.x());
+  write_bin(fp, data.y());
+}
+
+template <typename T>
+void read_bin(std::istream& fp, vtr::Point<T>& data) {
+  T x = T();
+  T y = T();
+  read_bin(fp, x);
+  read_bin(fp, y);
+  data = vtr::Point<T>(x, y);
+}
+
+template <typename T>
+void write_bin(std::ostream& fp, const vtr::Rect<T>& data) {
+  write_bin(fp, data.xmin());
+  write_bin(fp, data.ymin());
+  write_bin(fp, data.xmax());
+  write_bin(fp, data.ymax());
+}
+
+template <typename T>
+void read_bin(std::istream& fp, vtr::Rect<T>& data) {
+  T xmin = T();
+  T ymin = T();
+  T xmax = T();
+  T ymax = T();
+  read_bin(fp, xmin);
+  read_bin(fp, ymin);
+  read_bin(fp, xmax);
+  read_bin(fp, ymax);
+  data = vtr::Rect<T>(xmin, ymin, xmax, ymax);
+}
+
+template <typename T1, typename T2>
+void write_bin(std::ostream& fp, const std::pair<T1, T2>& data) {
+  write_bin(fp, data.first);
+  write_bin(fp, data.second);
+}
+
+template <typename T1, typename T2>
+void read_bin(std::istream& fp, std::pair<T1, T2>& data) {
+  read_bin(fp, data.first);
+  read_bin(fp, data.second);
+}
+
+inline void write_bin(std::ostream& fp, const std::vector<bool>& data) {
+  write_bin(fp, data.size());
+  for (const bool elem : data) {
+    write_bin(fp, elem);
+  }
+}
+
+inline void read_bin(std::istream& fp, std::vector<bool>& data) {
+  size_t num_elem = read_bin_size(fp);
+  data.resize(num_elem);
+  for (size_t ielem = 0; ielem < num_elem; ++ielem) {
+    bool elem = false;
+    read_bin(fp, elem);
+    data[ielem] = elem;
+  }
+}
+
+template <typename T>
+void write_bin(std::ostream& fp, const std::vector<T>& data) {
+  write_bin(fp, data.size());
+  for (const T& elem : data) {
+    write_bin(fp, elem);
+  }
+}
+
+template <typename T>
+void read_bin(std::istream& fp, std::vector<T>& data) {
+  size_t num_elem = read_bin_size(fp);
+  data.resize(num_elem);
+  for (T& elem : data) {
+    read_bin(fp, elem);
+  }
+}
+
+template <typename K>
+void write_bin(std::ostream& fp, const vtr::vector<K, bool>& data) {
+  write_bin(fp, data.size());
+  for (const bool elem : data) {
+    write_bin(fp, elem);
+  }
+}
+
+template <typename K>
+void read_bin(std::istream& fp, vtr::vector<K, bool>& data) {
+  size_t num_elem = read_bin_size(fp);
+  data.resize(num_elem);
+  for (size_t ielem = 0; ielem < num_elem; ++ielem) {
+    bool elem = false;
+    read_bin(fp, elem);
+    data[K(ielem)] = elem;
+  }
+}
+
+template <typename K, typename V>
+void write_bin(std::ostream& fp, const vtr::vector<K, V>& data) {
+  write_bin(fp, data.size());
+  for (const V& elem : data) {
+    write_bin(fp, elem);
+  }
+}
+
+template <typename K, typename V>
+void read_bin(std::istream& fp, vtr::vector<K, V>& data) {
+  size_t num_elem = read_bin_size(fp);
+  data.resize(num_elem);
+  for (V& elem : data) {
+    read_bin(fp, elem);
+  }
+}
+
+template <typename K, typename V>
+void write_bin(std::ostream& fp, const std::map<K, V>& data) {
+  write_bin(fp, data.size());
+  for (const auto& elem : data) {
+    write_bin(fp, elem.first);
+    write_bin(fp, elem.second);
+  }
+}
+
+template <typename K, typename V>
+void read_bin(std::istream& fp, std::map<K, V>& data) {
+  size_t num_elem = read_bin_size(fp);
+  data.clear();
+  for (size_t ielem = 0; ielem < num_elem; ++ielem) {
+    K key;
+    read_bin(fp, key);
+    read_bin(fp, data[key]);
+  }
+}
+
+template <typename T>
+void write_bin(std::ostream& fp, const std::unordered_set<T>& data) {
+  write_bin(fp, data.size());
+  for (const T& elem : data) {
+    write_bin(fp, elem);
+  }
+}
+
+template <typename T>
+void read_bin(std::istream& fp, std::unordered_set<T>& data) {
+  size_t num_elem = read_bin_size(fp);
+  data.clear();
+  data.reserve(num_elem);
+  for (size_t ielem = 0; ielem < num_elem; ++ielem) {
+    T elem;
+    read_bin(fp, elem);
+    data.insert(elem);
+  }
+}
+
+} /* namespace openfpga ends */
+
+#endif
@@ -0,0 +1,291 @@
+/********************************************************************
+ * This file includes functions to map files to memory and to write/read
+ * the binary caches of parsed input files
+ *******************************************************************/
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <cstdio>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <iterator>
+
+/* Headers from vtrutil library */
+#include "vtr_log.h"
+
+/* Headers from openfpgautil library */
+#include "openfpga_bin_stream.h"
+#include "openfpga_digest.h"
+#include "openfpga_file_cache.h"
+
+/* namespace openfpga begins */
+namespace openfpga {
+
+/************************************************************************
+ * Member functions for class MappedFile
+ ***********************************************************************/
+MappedFile::MappedFile() : data_(nullptr), size_(0), mapped_(false) {}
+
+MappedFile::~MappedFile() { close(); }
+
+bool MappedFile::is_open() const { return nullptr != data_; }
+
+const char* MappedFile::data() const { return data_; }
+
+size_t MappedFile::size() const { return size_; }
+
+bool MappedFile::open(const std::string& fname) {
+  close();
+
+#ifndef _WIN32
+  int fd = ::open(fname.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return false;
+  }
+  struct stat file_stat;
+  if (0 == fstat(fd, &file_stat) && 0 < file_stat.st_size) {
+    void* addr = mmap(nullptr, size_t(file_stat.st_size), PROT_READ,
+                      MAP_PRIVATE, fd, 0);
+    if (MAP_FAILED != addr) {
+      /* Files are always read from the beginning to the end */
+      madvise(addr, size_t(file_stat.st_size), MADV_SEQUENTIAL);
+      data_ = static_cast<const char*>(addr);
+      size_ = size_t(file_stat.st_size);
+      mapped_ = true;
+    }
+  }
+  ::close(fd);
+  if (mapped_) {
+    return true;
+  }
+#endif
+
+  /* Read the whole file when it cannot be mapped, e.g., an empty file */
+  std::ifstream fp(fname, std::ifstream::binary);
+  if (!fp.is_open()) {
+    return false;
+  }
+  buffer_.assign(std::istreambuf_iterator<char>(fp),
+                 std::istreambuf_iterator<char>());
+  if (fp.bad()) {
+    buffer_.clear();
+    return false;
+  }
+  /* Empty files are valid, whose data is an empty string */
+  buffer_.push_back('\0');
+  data_ = buffer_.data();
+  size_ = buffer_.size() - 1;
+  return true;
+}
+
+void MappedFile::close() {
+#ifndef _WIN32
+  if (mapped_) {
+    munmap(const_cast<char*>(data_), size_);
+  }
+#endif
+  data_ = nullptr;
+  size_ = 0;
+  mapped_ = false;
+  buffer_.clear();
+  buffer_.shrink_to_fit();
+}
+
+/************************************************************************
+ * Member functions for classes MemoryStreamBuf and MemoryInputStream
+ ***********************************************************************/
+MemoryStreamBuf::MemoryStreamBuf(const char* data, const size_t& size) {
+  /* The data is never written through the stream buffer */
+  char* begin = const_cast<char*>(data);
+  setg(begin, begin, begin + size);
+}
+
+MemoryInputStream::MemoryInputStream(const char* data, const size_t& size)
+  : std::istream(nullptr), buffer_(data, size) {
+  rdbuf(&buffer_);
+}
+
+/************************************************************************
+ * Digest of a block of data, which follows the xxHash64 algorithm with a
+ * zero seed. It runs at the speed of memory, so that checking a cache is
+ * much cheaper than parsing its input file
+ ***********************************************************************/
+static constexpr uint64_t DIGEST_PRIME1 = 11400714785074694791ULL;
+static constexpr uint64_t DIGEST_PRIME2 = 14029467366897019727ULL;
+static constexpr uint64_t DIGEST_PRIME3 = 1609587929392839161ULL;
+static constexpr uint64_t DIGEST_PRIME4 = 9650029242287828579ULL;
+static constexpr uint64_t DIGEST_PRIME5 = 2870177450012600261ULL;
+
+static uint64_t digest_rotl(const uint64_t& x, const int& r) {
+  return (x << r) | (x >> (64 - r));
+}
+
+static uint64_t digest_read64(const char* data) {
+  uint64_t word;
+  std::memcpy(&word, data, sizeof(word));
+  return word;
+}
+
+static uint32_t digest_read32(const char* data) {
+  uint32_t word;
+  std::memcpy(&word, data, sizeof(word));
+  return word;
+}
+
+static uint64_t digest_round(uint64_t acc, const uint64_t& input) {
+  acc += input * DIGEST_PRIME2;
+  acc = digest_rotl(acc, 31);
+  return acc * DIGEST_PRIME1;
+}
+
+static uint64_t digest_merge(uint64_t acc, const uint64_t& val) {
+  acc ^= digest_round(0, val);
+  return acc * DIGEST_PRIME1 + DIGEST_PRIME4;
+}
+
+uint64_t file_digest(const char* data, const size_t& size) {
+  const char* curr = data;
+  const char* end = data + size;
+  uint64_t hash = 0;
+
+  if (size >= 32) {
+    /* Four independent lanes on each stripe of 32 bytes */
+    uint64_t v1 = DIGEST_PRIME1 + DIGEST_PRIME2;
+    uint64_t v2 = DIGEST_PRIME2;
+    uint64_t v3 = 0;
+    uint64_t v4 = 0 - DIGEST_PRIME1;
+    const char* limit = end - 32;
+    do {
+      v1 = digest_round(v1, digest_read64(curr));
+      v2 = digest_round(v2, digest_read64(curr + 8));
+      v3 = digest_round(v3, digest_read64(curr + 16));
+      v4 = digest_round(v4, digest_read64(curr + 24));
+      curr += 32;
+    } while (curr <= limit);
+    hash = digest_rotl(v1, 1) + digest_rotl(v2, 7) + digest_rotl(v3, 12) +
+           digest_rotl(v4, 18);
+    hash = digest_merge(hash, v1);
+    hash = digest_merge(hash, v2);
+    hash = digest_merge(hash, v3);
+    hash = digest_merge(hash, v4);
+  } else {
+    hash = DIGEST_PRIME5;
+  }
+  hash += uint64_t(size);
+
+  /* Remaining bytes which are less than a stripe */
+  for (; curr + 8 <= end; curr += 8) {
+    hash ^= digest_round(0, digest_read64(curr));
+    hash = digest_rotl(hash, 27) * DIGEST_PRIME1 + DIGEST_PRIME4;
+  }
+  if (curr + 4 <= end) {
+    hash ^= uint64_t(digest_read32(curr)) * DIGEST_PRIME1;
+    hash = digest_rotl(hash, 23) * DIGEST_PRIME2 + DIGEST_PRIME3;
+    curr += 4;
+  }
+  for (; curr < end; ++curr) {
+    hash ^= uint64_t(static_cast<unsigned char>(*curr)) * DIGEST_PRIME5;
+    hash = digest_rotl(hash, 11) * DIGEST_PRIME1;
+  }
+
+  /* Avalanche */
+  hash ^= hash >> 33;
+  hash *= DIGEST_PRIME2;
+  hash ^= hash >> 29;
+  hash *= DIGEST_PRIME3;
+  hash ^= hash >> 32;
+  return hash;
+}
+
+/************************************************************************
+ * Cache files
+ ***********************************************************************/
+bool read_file_cache(const std::string& cache_fname, const char* magic,
+                     const size_t& version, const uint64_t& digest,
+                     const std::function<void(std::istream&)>& read_data) {
+  MappedFile cache;
+  if (!cache.open(cache_fname)) {
+    return false;
+  }
+  MemoryInputStream fp(cache.data(), cache.size());
+
+  /* Check the length of the magic string before reading it, as any file may
+   * be given as a cache */
+  size_t magic_size = 0;
+  read_bin(fp, magic_size);
+  if (!fp.good() || magic_size != std::strlen(magic)) {
+    VTR_LOG_WARN("File '%s' is not a cache, which will be overwritten\n",
+                 cache_fname.c_str());
+    return false;
+  }
+  std::string cache_magic(magic_size, '\0');
+  fp.read(&cache_magic[0], magic_size);
+  if (!fp.good() || cache_magic != std::string(magic)) {
+    VTR_LOG_WARN("File '%s' is not a cache, which will be overwritten\n",
+                 cache_fname.c_str());
+    return false;
+  }
+
+  size_t cache_version = 0;
+  uint64_t cache_digest = 0;
+  read_bin(fp, cache_version);
+  read_bin(fp, cache_digest);
+  if (!fp.good() || cache_version != version) {
+    VTR_LOG("Cache '%s' has a version '%lu' while version '%lu' is expected\n",
+            cache_fname.c_str(), cache_version, version);
+    return false;
+  }
+  if (cache_digest != digest) {
+    VTR_LOG("Cache '%s' is outdated as its input file has been changed\n",
+            cache_fname.c_str());
+    return false;
+  }
+
+  try {
+    read_data(fp);
+  } catch (const std::exception&) {
+    fp.setstate(std::ios_base::failbit);
+  }
+  /* All the data should be consumed */
+  if (!fp.good() || std::char_traits<char>::eof() != fp.peek()) {
+    VTR_LOG_WARN("Cache '%s' is corrupted, which will be overwritten\n",
+                 cache_fname.c_str());
+    return false;
+  }
+  return true;
+}
+
+bool write_file_cache(const std::string& cache_fname, const char* magic,
+                      const size_t& version, const uint64_t& digest,
+                      const std::function<void(std::ostream&)>& write_data) {
+  std::string temp_fname = cache_fname + std::string(".tmp");
+
+  std::fstream fp;
+  fp.open(temp_fname,
+          std::fstream::out | std::fstream::trunc | std::fstream::binary);
+  if (!valid_file_stream(fp)) {
+    VTR_LOG_WARN("Unable to write cache '%s'!\n", cache_fname.c_str());
+    return false;
+  }
+
+  write_bin(fp, std::string(magic));
+  write_bin(fp, version);
+  write_bin(fp, digest);
+  write_data(fp);
+
+  bool status = fp.good();
+  fp.close();
+  if (!status || 0 != std::rename(temp_fname.c_str(), cache_fname.c_str())) {
+    std::remove(temp_fname.c_str());
+    VTR_LOG_WARN("Unable to write cache '%s'!\n", cache_fname.c_str());
+    return false;
+  }
+  return true;
+}
+
+}  // namespace openfpga
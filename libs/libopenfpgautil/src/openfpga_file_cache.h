@@ -0,0 +1,101 @@
+#ifndef OPENFPGA_FILE_CACHE_H
+#define OPENFPGA_FILE_CACHE_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include <cstdint>
+#include <functional>
+#include <istream>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+/********************************************************************
+ * Utilities to cache the data parsed from a large input file, e.g., a
+ * fabric key, to a binary file, which can be loaded much faster than
+ * parsing the input file again.
+ *
+ * Typical usage:
+ *   MappedFile src;
+ *   src.open(fname);
+ *   uint64_t digest = file_digest(src.data(), src.size());
+ *   if (read_file_cache(cache_fname, MAGIC, VERSION, digest, read_func)) {
+ *     // Done, the input file is not changed since the cache is written
+ *   }
+ *   // Parse src.data() and then
+ *   write_file_cache(cache_fname, MAGIC, VERSION, digest, write_func);
+ *
+ * A cache file starts with a magic string, a version number and the
+ * digest of its input file. A cache is rejected (and can be overwritten)
+ * when any of them does not match, or when its data is incomplete.
+ * Like the other binary files, caches are not portable across machines
+ * with different endianness.
+ *******************************************************************/
+
+/* namespace openfpga begins */
+namespace openfpga {
+
+/* A read-only file which is mapped to memory when possible. Otherwise,
+ * the whole file is read to a buffer */
+class MappedFile {
+ public: /* Constructors */
+  MappedFile();
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+  ~MappedFile();
+
+ public: /* Public accessors */
+  bool is_open() const;
+  const char* data() const;
+  size_t size() const;
+
+ public: /* Public mutators */
+  /* Return false if the file cannot be opened */
+  bool open(const std::string& fname);
+  void close();
+
+ private: /* Internal data */
+  const char* data_;
+  size_t size_;
+  bool mapped_;
+  std::vector<char> buffer_;
+};
+
+/* An input stream on a block of memory, e.g., a mapped file, so that the
+ * readers of binary streams can be used without copying the data */
+class MemoryStreamBuf : public std::streambuf {
+ public: /* Constructors */
+  MemoryStreamBuf(const char* data, const size_t& size);
+};
+
+class MemoryInputStream : public std::istream {
+ public: /* Constructors */
+  MemoryInputStream(const char* data, const size_t& size);
+
+ private: /* Internal data */
+  MemoryStreamBuf buffer_;
+};
+
+/* 64-bit hash (xxHash64) of a block of data */
+uint64_t file_digest(const char* data, const size_t& size);
+
+/* Load a cache file by a given function. Return false if the cache does not
+ * exist, does not match the magic string, the version or the digest of its
+ * input file, or is corrupted. The data may be partially loaded in the
+ * last case, which should be cleared by the caller */
+bool read_file_cache(const std::string& cache_fname, const char* magic,
+                     const size_t& version, const uint64_t& digest,
+                     const std::function<void(std::istream&)>& read_data);
+
+/* Write a cache file by a given function. The file is written to a
+ * temporary file and then renamed, so that a cache is always complete.
+ * Return false if the cache cannot be written */
+bool write_file_cache(const std::string& cache_fname, const char* magic,
+                      const size_t& version, const uint64_t& digest,
+                      const std::function<void(std::ostream&)>& write_data);
+
+}  // namespace openfpga
+
+#endif
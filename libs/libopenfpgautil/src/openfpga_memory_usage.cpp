@@ -0,0 +1,117 @@
+/********************************************************************
+ * This file includes member functions of the MemoryUsage class, and
+ * functions to query the memory of the current process
+ *******************************************************************/
+#include <sys/resource.h>
+
+#include <fstream>
+#include <sstream>
+
+/* Headers from openfpgautil library */
+#include "openfpga_memory_usage.h"
+
+/* namespace openfpga begins */
+namespace openfpga {
+
+/************************************************************************
+ * Member functions for class MemoryUsage
+ ***********************************************************************/
+MemoryUsage::MemoryUsage() { bytes_.fill(0); }
+
+size_t MemoryUsage::bytes(const e_category& category) const {
+  return bytes_[category];
+}
+
+size_t MemoryUsage::total_bytes() const {
+  size_t total = 0;
+  for (const size_t& bytes : bytes_) {
+    total += bytes;
+  }
+  return total;
+}
+
+void MemoryUsage::add_bytes(const e_category& category, const size_t& bytes) {
+  bytes_[category] += bytes;
+}
+
+void MemoryUsage::add(const MemoryUsage& other) {
+  for (size_t icat = 0; icat < NUM_CATEGORIES; ++icat) {
+    bytes_[icat] += other.bytes_[icat];
+  }
+}
+
+void MemoryUsage::add_heap(const std::string& str,
+                           const e_category& category) {
+  /* Short strings are stored inside the string object itself */
+  const char* data = str.data();
+  const char* object = reinterpret_cast<const char*>(&str);
+  if ((data >= object) && (data < object + sizeof(str))) {
+    return;
+  }
+  add_bytes(LOOKUP == category ? LOOKUP : STRING, str.capacity() + 1);
+}
+
+/* A node of a red-black tree stores the value, 3 links and a color */
+size_t MemoryUsage::tree_node_bytes(const size_t& value_bytes) {
+  return value_bytes + 4 * sizeof(void*);
+}
+
+/* A node of a hash table stores the value, a link and a cached hash */
+size_t MemoryUsage::hash_table_bytes(const size_t& num_buckets,
+                                     const size_t& num_elements,
+                                     const size_t& value_bytes) {
+  return num_buckets * sizeof(void*) +
+         num_elements * (value_bytes + sizeof(void*) + sizeof(size_t));
+}
+
+/************************************************************************
+ * Memory of the current process
+ ***********************************************************************/
+/* Find a field in kB from the status of the current process, e.g., VmRSS */
+static size_t read_proc_status_kb(const std::string& key) {
+  std::ifstream fp("/proc/self/status");
+  std::string line;
+  while (std::getline(fp, line)) {
+    if (0 != line.compare(0, key.size() + 1, key + ":")) {
+      continue;
+    }
+    std::istringstream value(line.substr(key.size() + 1));
+    size_t kb = 0;
+    value >> kb;
+    return kb;
+  }
+  return 0;
+}
+
+size_t get_current_rss_kb() { return read_proc_status_kb("VmRSS"); }
+
+size_t get_peak_rss_kb() {
+  size_t peak_kb = read_proc_status_kb("VmHWM");
+  if (0 < peak_kb) {
+    return peak_kb;
+  }
+  /* Fall back to the resource usage when /proc is not available */
+  struct rusage usage;
+  if (0 != getrusage(RUSAGE_SELF, &usage)) {
+    return 0;
+  }
+#ifdef __APPLE__
+  /* The peak is in bytes on macOS */
+  return size_t(usage.ru_maxrss) / 1024;
+#else
+  return size_t(usage.ru_maxrss);
+#endif
+}
+
+bool reset_peak_rss() {
+  /* Supported by Linux since 4.0 */
+  std::ofstream fp("/proc/self/clear_refs");
+  if (!fp.is_open()) {
+    return false;
+  }
+  fp << "5";
+  fp.close();
+  return !fp.fail();
+}
+
+}  // namespace openfpga
@@ -0,0 +1,192 @@
+#ifndef OPENFPGA_MEMORY_USAGE_H
+#define OPENFPGA_MEMORY_USAGE_H
+
+/********************************************************************
+ * Include header files that are required by data structure declaration
+ *******************************************************************/
+#include <array>
+#include <cstddef>
+#include <map>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+/* Headers from vtrutil library */
+#include "vtr_vector.h"
+
+/********************************************************************
+ * Account the heap memory owned by a data structure, split into
+ * - containers: storage of vectors and other sequential containers
+ * - strings: characters of strings which are not stored inline
+ * - lookups: fast look-ups, e.g., maps, sets and their keys, which
+ *   can be rebuilt from the other data
+ *
+ * Data structures walk through their members, e.g.,
+ *   usage.add_container(ports_);
+ *   usage.add_lookup(name_id_map_);
+ * Elements of containers are walked as well. An element which has a member
+ * function memory_usage(MemoryUsage&) accounts its own memory.
+ * The size of allocated blocks is estimated from the size of elements and
+ * the capacity of containers, without overheads of the memory allocator.
+ * Strings inside containers are counted as strings, while everything
+ * inside a look-up is counted as the look-up.
+ *******************************************************************/
+
+/* namespace openfpga begins */
+namespace openfpga {
+
+class MemoryUsage {
+ public: /* Types */
+  enum e_category { CONTAINER, STRING, LOOKUP, NUM_CATEGORIES };
+
+ public: /* Constructors */
+  MemoryUsage();
+
+ public: /* Accessors */
+  size_t bytes(const e_category& category) const;
+  size_t total_bytes() const;
+
+ public: /* Mutators */
+  void add_bytes(const e_category& category, const size_t& bytes);
+  void add(const MemoryUsage& other);
+
+  template <class T>
+  void add_container(const T& data) {
+    add_heap(data, CONTAINER);
+  }
+
+  template <class T>
+  void add_lookup(const T& data) {
+    add_heap(data, LOOKUP);
+  }
+
+  void add_string(const std::string& str) { add_heap(str, STRING); }
+
+ private: /* Internal walkers, one for each kind of data */
+  template <class T>
+  void add_heap(const T& data, const e_category&) {
+    add_object(data, 0);
+  }
+
+  /* Data structures which account their own memory by a member function
+   * memory_usage(MemoryUsage&) */
+  template <class T>
+  auto add_object(const T& data, int) -> decltype(data.memory_usage(*this)) {
+    data.memory_usage(*this);
+  }
+
+  /* Data without any heap memory, e.g., numbers, ids and symbols */
+  template <class T>
+  void add_object(const T&, long) {}
+
+  void add_heap(const std::string& str, const e_category& category);
+
+  template <class T1, class T2>
+  void add_heap(const std::pair<T1, T2>& data, const e_category& category) {
+    add_heap(data.first, category);
+    add_heap(data.second, category);
+  }
+
+  template <class T, size_t N>
+  void add_heap(const std::array<T, N>& data, const e_category& category) {
+    add_elements(data, category);
+  }
+
+  template <class T, class A>
+  void add_heap(const std::vector<T, A>& data, const e_category& category) {
+    add_bytes(category, data.capacity() * sizeof(T));
+    add_elements(data, category);
+  }
+
+  template <class A>
+  void add_heap(const std::vector<bool, A>& data, const e_category& category) {
+    add_bytes(category, data.capacity() / 8);
+  }
+
+  template <class K, class V>
+  void add_heap(const vtr::vector<K, V>& data, const e_category& category) {
+    add_bytes(category, data.capacity() * sizeof(V));
+    add_elements(data, category);
+  }
+
+  template <class K>
+  void add_heap(const vtr::vector<K, bool>& data, const e_category& category) {
+    add_bytes(category, data.capacity() / 8);
+  }
+
+  template <class K, class V, class C, class A>
+  void add_heap(const std::map<K, V, C, A>& data, const e_category& category) {
+    typedef typename std::map<K, V, C, A>::value_type value_type;
+    add_bytes(category, data.size() * tree_node_bytes(sizeof(value_type)));
+    add_elements(data, category);
+  }
+
+  template <class K, class C, class A>
+  void add_heap(const std::set<K, C, A>& data, const e_category& category) {
+    add_bytes(category, data.size() * tree_node_bytes(sizeof(K)));
+    add_elements(data, category);
+  }
+
+  template <class K, class V, class H, class E, class A>
+  void add_heap(const std::unordered_map<K, V, H, E, A>& data,
+                const e_category& category) {
+    typedef typename std::unordered_map<K, V, H, E, A>::value_type value_type;
+    add_bytes(category, hash_table_bytes(data.bucket_count(), data.size(),
+                                         sizeof(value_type)));
+    add_elements(data, category);
+  }
+
+  template <class K, class V, class H, class E, class A>
+  void add_heap(const std::unordered_multimap<K, V, H, E, A>& data,
+                const e_category& category) {
+    typedef
+      typename std::unordered_multimap<K, V, H, E, A>::value_type value_type;
+    add_bytes(category, hash_table_bytes(data.bucket_count(), data.size(),
+                                         sizeof(value_type)));
+    add_elements(data, category);
+  }
+
+  template <class K, class H, class E, class A>
+  void add_heap(const std::unordered_set<K, H, E, A>& data,
+                const e_category& category) {
+    add_bytes(category,
+              hash_table_bytes(data.bucket_count(), data.size(), sizeof(K)));
+    add_elements(data, category);
+  }
+
+  template <class C>
+  void add_elements(const C& data, const e_category& category) {
+    for (const auto& element : data) {
+      add_heap(element, category);
+    }
+  }
+
+  static size_t tree_node_bytes(const size_t& value_bytes);
+  static size_t hash_table_bytes(const size_t& num_buckets,
+                                 const size_t& num_elements,
+                                 const size_t& value_bytes);
+
+ private: /* Internal data */
+  std::array<size_t, NUM_CATEGORIES> bytes_;
+};
+
+/********************************************************************
+ * Memory of the current process, as reported by the operating system
+ *******************************************************************/
+/* Resident memory in kB. Return 0 if it is not available */
+size_t get_current_rss_kb();
+
+/* Peak resident memory in kB since the process starts or since the last
+ * reset. Return 0 if it is not available */
+size_t get_peak_rss_kb();
+
+/* Reset the peak resident memory to the current resident memory, so that the
+ * peak of a period can be measured. Return false if it is not supported */
+bool reset_peak_rss();
+
+}  // namespace openfpga
+
+#endif
@@ -0,0 +1,65 @@
+/********************************************************************
+ * This file includes functions to run independent tasks on multiple
+ * threads
+ *******************************************************************/
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+/* Headers from openfpgautil library */
+#include "openfpga_parallel.h"
+
+namespace openfpga {
+
+/********************************************************************
+ * Return the number of threads which can run concurrently on the host,
+ * which is at least 1
+ *******************************************************************/
+size_t num_hardware_threads() {
+  return std::max(size_t(1), size_t(std::thread::hardware_concurrency()));
+}
+
+/********************************************************************
+ * Call task_func(itask) for each task in [0, num_tasks) with up to
+ * num_threads threads. Tasks are picked up by idle threads one by one,
+ * so that a few large tasks do not leave the other threads waiting.
+ * The function returns when all the tasks are finished.
+ *
+ * Note:
+ * - The tasks are executed in any order. A task should only modify the
+ *   data owned by itself, e.g., a slot indexed by the task id in a vector
+ *   which is sized before the call.
+ * - When only 1 thread is required, the tasks are executed in order in the
+ *   calling thread.
+ *******************************************************************/
+void parallel_for(const size_t& num_tasks, const size_t& num_threads,
+                  const std::function<void(const size_t&)>& task_func) {
+  size_t num_workers = std::min(num_threads, num_tasks);
+  if (num_workers <= 1) {
+    for (size_t itask = 0; itask < num_tasks; ++itask) {
+      task_func(itask);
+    }
+    return;
+  }
+
+  std::atomic<size_t> next_task(0);
+  auto worker = [&]() {
+    for (size_t itask = next_task++; itask < num_tasks; itask = next_task++) {
+      task_func(itask);
+    }
+  };
+
+  /* The calling thread is also a worker */
+  std::vector<std::thread> threads;
+  threads.reserve(num_workers - 1);
+  for (size_t ithread = 1; ithread < num_workers; ++ithread) {
+    threads.emplace_back(worker);
+  }
+  worker();
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+}
+
+}  // namespace openfpga
@@ -0,0 +1,23 @@
+#ifndef OPENFPGA_PARALLEL_H
+#define OPENFPGA_PARALLEL_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include <cstddef>
+#include <functional>
+
+/********************************************************************
+ * Function declaration
+ *******************************************************************/
+/* namespace openfpga begins */
+namespace openfpga {
+
+size_t num_hardware_threads();
+
+void parallel_for(const size_t& num_tasks, const size_t& num_threads,
+                  const std::function<void(const size_t&)>& task_func);
+
+}  // namespace openfpga
+
+#endif
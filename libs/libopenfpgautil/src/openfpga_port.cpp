@@ -69,7 +69,7 @@ size_t BasicPort::get_msb() const { return msb_; }
 size_t BasicPort::get_lsb() const { return lsb_; }
 
 /* get the name */
-std::string BasicPort::get_name() const { return name_; }
+const std::string& BasicPort::get_name() const { return name_; }
 
 /* Make a range of the pin indices */
 std::vector<size_t> BasicPort::pins() const {
@@ -92,7 +92,7 @@ std::vector<size_t> BasicPort::pins() const {
 /* Check if a port can be merged with this port: their name should be the same
  */
 bool BasicPort::mergeable(const BasicPort& portA) const {
-  return (0 == this->get_name().compare(portA.get_name()));
+  return name_ == portA.get_name();
 }
 
 /* Check if a port is contained by this port:
@@ -139,7 +139,7 @@ size_t BasicPort::find_ipin(const BasicPort& ref_port) const {
  * 3. MSBs are the same
  */
 bool BasicPort::operator==(const BasicPort& portA) const {
-  if ((0 == this->get_name().compare(portA.get_name())) &&
+  if ((name_ == portA.get_name()) &&
       (this->get_lsb() == portA.get_lsb()) &&
       (this->get_msb() == portA.get_msb())) {
     return true;
@@ -148,7 +148,7 @@ bool BasicPort::operator==(const BasicPort& portA) const {
 }
 
 bool BasicPort::operator<(const BasicPort& portA) const {
-  if ((0 == this->get_name().compare(portA.get_name())) &&
+  if ((name_ == portA.get_name()) &&
       (this->get_lsb() < portA.get_lsb()) &&
       (this->get_msb() < portA.get_msb())) {
     return true;
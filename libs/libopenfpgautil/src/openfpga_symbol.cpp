@@ -0,0 +1,128 @@
+/********************************************************************
+ * This file includes member functions of the Symbol class and the
+ * process-wide symbol table behind it
+ *******************************************************************/
+#include <array>
+#include <functional>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_set>
+
+/* Headers from vtrutil library */
+#include "vtr_assert.h"
+
+/* Headers from openfpgautil library */
+#include "openfpga_memory_usage.h"
+#include "openfpga_symbol.h"
+
+/* namespace openfpga begins */
+namespace openfpga {
+
+/********************************************************************
+ * The symbol table. Elements of an unordered_set are never moved when
+ * the set grows, so their addresses can be used as handles.
+ * The table is created on first use and intentionally never destroyed,
+ * so that symbols held by static objects remain valid at exit.
+ *
+ * Strings are distributed to shards by their hash values, so that threads
+ * creating symbols rarely contend for the same lock. Each shard is guarded
+ * by a reader-writer lock: most of the instance names are shared by many
+ * modules, and these are found under a shared lock. An exclusive lock is
+ * only taken to add a new string.
+ *******************************************************************/
+namespace {
+
+constexpr size_t NUM_SYMBOL_TABLE_SHARDS = 64;
+
+struct SymbolTableShard {
+  std::shared_mutex mutex;
+  std::unordered_set<std::string> strings;
+};
+
+struct SymbolTable {
+  std::array<SymbolTableShard, NUM_SYMBOL_TABLE_SHARDS> shards;
+};
+
+SymbolTable& symbol_table() {
+  static SymbolTable* table = new SymbolTable();
+  return *table;
+}
+
+SymbolTableShard& symbol_table_shard(const std::string& str) {
+  /* Use the upper bits of the hash value, as the lower bits select the
+   * buckets inside a shard */
+  size_t hash = std::hash<std::string>()(str);
+  return symbol_table().shards[(hash >> 24) % NUM_SYMBOL_TABLE_SHARDS];
+}
+
+/* Find a string in the symbol table. Return nullptr if not found */
+const std::string* find_string(SymbolTableShard& shard,
+                               const std::string& str) {
+  std::shared_lock<std::shared_mutex> lock(shard.mutex);
+  auto result = shard.strings.find(str);
+  return (result == shard.strings.end()) ? nullptr : &(*result);
+}
+
+const std::string* intern_string(const std::string& str) {
+  SymbolTableShard& shard = symbol_table_shard(str);
+  const std::string* interned = find_string(shard, str);
+  if (nullptr != interned) {
+    return interned;
+  }
+  /* Another thread may have added the string in the meantime, which is
+   * handled by insert() */
+  std::unique_lock<std::shared_mutex> lock(shard.mutex);
+  return &(*shard.strings.insert(str).first);
+}
+
+}  // namespace
+
+/************************************************************************
+ * Constructors
+ ***********************************************************************/
+Symbol::Symbol() {
+  /* The empty string is shared by all the default symbols */
+  static const std::string* empty_str = intern_string(std::string());
+  str_ = empty_str;
+}
+
+Symbol::Symbol(const std::string& str) { str_ = intern_string(str); }
+
+Symbol::Symbol(const char* str) { str_ = intern_string(std::string(str)); }
+
+/************************************************************************
+ * Accessors
+ ***********************************************************************/
+const std::string& Symbol::str() const {
+  VTR_ASSERT(is_valid());
+  return *str_;
+}
+
+bool Symbol::empty() const { return str().empty(); }
+
+/************************************************************************
+ * Symbol table queries
+ ***********************************************************************/
+Symbol Symbol::find(const std::string& str) {
+  Symbol symbol;
+  symbol.str_ = find_string(symbol_table_shard(str), str);
+  return symbol;
+}
+
+size_t Symbol::num_symbols() {
+  size_t num_symbols = 0;
+  for (SymbolTableShard& shard : symbol_table().shards) {
+    std::shared_lock<std::shared_mutex> lock(shard.mutex);
+    num_symbols += shard.strings.size();
+  }
+  return num_symbols;
+}
+
+void Symbol::table_memory_usage(MemoryUsage& usage) {
+  for (SymbolTableShard& shard : symbol_table().shards) {
+    std::shared_lock<std::shared_mutex> lock(shard.mutex);
+    usage.add_container(shard.strings);
+  }
+}
+
+}  // namespace openfpga
@@ -0,0 +1,81 @@
+#ifndef OPENFPGA_SYMBOL_H
+#define OPENFPGA_SYMBOL_H
+
+/********************************************************************
+ * Include header files that are required by data structure declaration
+ *******************************************************************/
+#include <cstddef>
+#include <functional>
+#include <string>
+
+/* namespace openfpga begins */
+namespace openfpga {
+
+class MemoryUsage;
+
+/********************************************************************
+ * A handle to a string in a process-wide symbol table.
+ * Each distinct string is stored only once in the table, and lives until
+ * the end of the process. As a result,
+ * - copying a symbol is as cheap as copying a pointer
+ * - two symbols are equal if and only if their handles are equal
+ * - the string of a symbol can be referred to at any time without copy
+ *
+ * As the table is never freed, only names of the fabric, e.g., child
+ * instance names of modules and block names of the bitstream, should be
+ * interned. They are shared by all the designs implemented on a fabric,
+ * so the table does not grow from one design to another. Names which are
+ * created for each design, or only used temporarily (e.g., ports being
+ * parsed), should be kept as strings.
+ *
+ * The symbol table is thread-safe, so symbols can be created by parallel
+ * tasks. It is sharded, and an existing string is found under a shared
+ * lock, so that parallel tasks creating the same symbols do not serialize.
+ * Convert symbols to strings only when they are written to files or
+ * compared with strings coming from outside.
+ *******************************************************************/
+class Symbol {
+ public: /* Constructors */
+  /* An empty string */
+  Symbol();
+  /* Find or add a string to the symbol table */
+  explicit Symbol(const std::string& str);
+  explicit Symbol(const char* str);
+
+ public: /* Overloaded operators */
+  bool operator==(const Symbol& other) const { return str_ == other.str_; }
+  bool operator!=(const Symbol& other) const { return str_ != other.str_; }
+
+ public: /* Accessors */
+  const std::string& str() const;
+  bool empty() const;
+  /* A symbol is invalid only when it is returned by find() */
+  bool is_valid() const { return nullptr != str_; }
+  size_t hash() const { return std::hash<const std::string*>()(str_); }
+
+ public: /* Symbol table queries */
+  /* Find the symbol of a string without adding it to the symbol table. Return
+   * an invalid symbol if the string has never been added */
+  static Symbol find(const std::string& str);
+  /* Number of distinct strings in the symbol table */
+  static size_t num_symbols();
+  /* Accumulate the heap memory used by the symbol table */
+  static void table_memory_usage(MemoryUsage& usage);
+
+ private: /* Internal data */
+  const std::string* str_;
+};
+
+}  // namespace openfpga
+
+/* Allow symbols to be used as keys in std::unordered_map */
+namespace std {
+template <>
+struct hash<openfpga::Symbol> {
+  size_t operator()(const openfpga::Symbol& symbol) const {
+    return symbol.hash();
+  }
+};
+}  // namespace std
+
+#endif
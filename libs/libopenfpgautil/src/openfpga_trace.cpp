@@ -0,0 +1,226 @@
+/********************************************************************
+ * This file includes functions to record a trace of nested scopes and
+ * counters, and to write it in the Chrome trace format
+ *******************************************************************/
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/* Headers from vtrutil library */
+#include "vtr_log.h"
+
+/* Headers from openfpgautil library */
+#include "openfpga_digest.h"
+#include "openfpga_symbol.h"
+#include "openfpga_trace.h"
+
+namespace openfpga {
+
+std::atomic<bool> trace_enabled_flag(false);
+
+/* An event is either a complete scope or a counter sample */
+struct TraceEvent {
+  const char* name;
+  std::string detail;
+  bool is_counter;
+  int64_t start_ns;
+  int64_t duration_ns;
+  double value;
+};
+
+/* Events of a thread, which are only appended by the thread itself */
+struct ThreadTrace {
+  size_t tid;
+  std::vector<TraceEvent> events;
+};
+
+struct TraceRecorder {
+  std::mutex mutex;
+  std::string fname;
+  bool exit_handler_registered = false;
+  std::chrono::steady_clock::time_point origin;
+  std::vector<std::unique_ptr<ThreadTrace>> threads;
+};
+
+/* The recorder is never destroyed, so that it outlives any thread and the
+ * handler writing the trace when the process exits */
+static TraceRecorder& trace_recorder() {
+  static TraceRecorder* recorder = new TraceRecorder();
+  return *recorder;
+}
+
+static thread_local ThreadTrace* this_thread_trace = nullptr;
+
+static ThreadTrace& find_this_thread_trace() {
+  if (nullptr == this_thread_trace) {
+    TraceRecorder& recorder = trace_recorder();
+    std::lock_guard<std::mutex> lock(recorder.mutex);
+    recorder.threads.emplace_back(new ThreadTrace());
+    recorder.threads.back()->tid = recorder.threads.size() - 1;
+    this_thread_trace = recorder.threads.back().get();
+  }
+  return *this_thread_trace;
+}
+
+static int64_t trace_now_ns() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+           std::chrono::steady_clock::now() - trace_recorder().origin)
+    .count();
+}
+
+/* Escape a string to be a JSON string literal */
+static std::string trace_json_string(const std::string& str) {
+  std::string escaped("\"");
+  for (const char& c : str) {
+    switch (c) {
+      case '"':
+        escaped += "\\\"";
+        break;
+      case '\\':
+        escaped += "\\\\";
+        break;
+      case '\n':
+        escaped += "\\n";
+        break;
+      case '\t':
+        escaped += "\\t";
+        break;
+      default:
+        escaped += c;
+    }
+  }
+  escaped += "\"";
+  return escaped;
+}
+
+static void stop_trace_at_exit() { stop_trace(); }
+
+/********************************************************************
+ * Public functions
+ *******************************************************************/
+bool start_trace(const std::string& fname) {
+#ifdef OPENFPGA_DISABLE_TRACE
+  VTR_LOG_ERROR(
+    "Unable to trace to '%s' as tracing is disabled in this build!\n",
+    fname.c_str());
+  return false;
+#else
+  TraceRecorder& recorder = trace_recorder();
+  {
+    std::lock_guard<std::mutex> lock(recorder.mutex);
+    recorder.fname = fname;
+    recorder.origin = std::chrono::steady_clock::now();
+    if (!recorder.exit_handler_registered) {
+      std::atexit(stop_trace_at_exit);
+      recorder.exit_handler_registered = true;
+    }
+  }
+  /* The first thread is the one starting the trace */
+  find_this_thread_trace();
+  VTR_LOG("Tracing to '%s'\n", fname.c_str());
+  trace_enabled_flag.store(true);
+  return true;
+#endif
+}
+
+int stop_trace() {
+  if (!trace_enabled_flag.exchange(false)) {
+    return 0;
+  }
+  TraceRecorder& recorder = trace_recorder();
+  std::lock_guard<std::mutex> lock(recorder.mutex);
+
+  std::fstream fp;
+  fp.open(recorder.fname, std::fstream::out | std::fstream::trunc);
+  if (false == valid_file_stream(fp)) {
+    return 1;
+  }
+
+  /* Timestamps are in microseconds with a nanosecond resolution */
+  fp << std::fixed << std::setprecision(3);
+  size_t num_events = 0;
+  fp << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+  fp << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,"
+     << "\"args\":{\"name\":\"OpenFPGA\"}}";
+  for (const std::unique_ptr<ThreadTrace>& thread : recorder.threads) {
+    std::string thread_name = (0 == thread->tid)
+                                ? std::string("main")
+                                : "worker " + std::to_string(thread->tid);
+    fp << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":"
+       << thread->tid
+       << ",\"args\":{\"name\":" << trace_json_string(thread_name) << "}}";
+    for (const TraceEvent& event : thread->events) {
+      fp << ",\n{\"name\":" << trace_json_string(event.name)
+         << ",\"cat\":\"openfpga\",\"pid\":1,\"tid\":" << thread->tid
+         << ",\"ts\":" << double(event.start_ns) / 1000.;
+      if (event.is_counter) {
+        fp << ",\"ph\":\"C\",\"args\":{\"value\":" << event.value << "}}";
+      } else {
+        fp << ",\"ph\":\"X\",\"dur\":" << double(event.duration_ns) / 1000.;
+        if (!event.detail.empty()) {
+          fp << ",\"args\":{\"detail\":" << trace_json_string(event.detail)
+             << "}";
+        }
+        fp << "}";
+      }
+      num_events++;
+    }
+  }
+  fp << "\n]}\n";
+  fp.close();
+
+  VTR_LOG("Wrote %lu trace events of %lu threads to '%s'\n", num_events,
+          recorder.threads.size(), recorder.fname.c_str());
+  return 0;
+}
+
+void trace_counter(const char* name, const double& value) {
+  if (!trace_enabled()) {
+    return;
+  }
+  find_this_thread_trace().events.push_back(
+    {name, std::string(), true, trace_now_ns(), 0, value});
+}
+
+/************************************************************************
+ * Member functions for class TraceScope
+ ***********************************************************************/
+TraceScope::TraceScope(const char* name) : name_(name), start_ns_(-1) {
+  if (trace_enabled()) {
+    start_ns_ = trace_now_ns();
+  }
+}
+
+TraceScope::TraceScope(const char* name, const std::string& detail)
+  : name_(name), detail_(detail), start_ns_(-1) {
+  if (trace_enabled()) {
+    start_ns_ = trace_now_ns();
+  }
+}
+
+TraceScope::TraceScope(const std::string& name)
+  : TraceScope(name, std::string()) {}
+
+TraceScope::TraceScope(const std::string& name, const std::string& detail)
+  : name_(nullptr), detail_(detail), start_ns_(-1) {
+  if (trace_enabled()) {
+    /* Interned strings live until the end of the process */
+    name_ = Symbol(name).str().c_str();
+    start_ns_ = trace_now_ns();
+  }
+}
+
+TraceScope::~TraceScope() {
+  if ((start_ns_ < 0) || !trace_enabled()) {
+    return;
+  }
+  int64_t end_ns = trace_now_ns();
+  find_this_thread_trace().events.push_back(
+    {name_, std::move(detail_), false, start_ns_, end_ns - start_ns_, 0.});
+}
+
+}  // namespace openfpga
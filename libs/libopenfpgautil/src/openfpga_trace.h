@@ -0,0 +1,97 @@
+#ifndef OPENFPGA_TRACE_H
+#define OPENFPGA_TRACE_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+/********************************************************************
+ * A lightweight tracer which records nested scopes and counters of
+ * OpenFPGA engines on any thread, and writes them to a file in the
+ * Chrome trace format, which can be viewed by chrome://tracing or
+ * https://ui.perfetto.dev
+ *
+ * Engines are instrumented by the macros below, e.g.,
+ *   OPENFPGA_TRACE_SCOPE("build_top_module");
+ *   OPENFPGA_TRACE_SCOPE_DETAIL("build_sb_module", "x=1 y=2");
+ *   OPENFPGA_TRACE_COUNTER("num_config_bits", num_bits);
+ * A scope starts where the macro is declared and ends at the end of the
+ * enclosing block.
+ *
+ * Tracing is off until start_trace() is called, which costs a single
+ * atomic load per scope. The detail of a scope is only evaluated when
+ * tracing is on. When the macro OPENFPGA_DISABLE_TRACE is defined, all
+ * the macros are removed at compile time.
+ *******************************************************************/
+
+/* namespace openfpga begins */
+namespace openfpga {
+
+extern std::atomic<bool> trace_enabled_flag;
+
+inline bool trace_enabled() {
+  return trace_enabled_flag.load(std::memory_order_relaxed);
+}
+
+/* Start recording and write the trace to the file when the process exits.
+ * Return false if the trace cannot be started */
+bool start_trace(const std::string& fname);
+
+/* Stop recording and write the trace to the file given to start_trace() */
+int stop_trace();
+
+void trace_counter(const char* name, const double& value);
+
+class TraceScope {
+ public: /* Constructors */
+  /* The name must be a string literal */
+  explicit TraceScope(const char* name);
+  TraceScope(const char* name, const std::string& detail);
+  /* The name is interned, so it can be built at runtime */
+  explicit TraceScope(const std::string& name);
+  TraceScope(const std::string& name, const std::string& detail);
+  TraceScope(const TraceScope&) = delete;
+  TraceScope& operator=(const TraceScope&) = delete;
+  ~TraceScope();
+
+ private: /* Internal data */
+  const char* name_;
+  std::string detail_;
+  /* Negative when tracing is off at the start of the scope */
+  int64_t start_ns_;
+};
+
+}  // namespace openfpga
+
+#ifndef OPENFPGA_DISABLE_TRACE
+#define OPENFPGA_TRACE_CONCAT_IMPL(a, b) a##b
+#define OPENFPGA_TRACE_CONCAT(a, b) OPENFPGA_TRACE_CONCAT_IMPL(a, b)
+#define OPENFPGA_TRACE_SCOPE(name)                                  \
+  openfpga::TraceScope OPENFPGA_TRACE_CONCAT(openfpga_trace_scope_, \
+                                             __LINE__)(name)
+#define OPENFPGA_TRACE_SCOPE_DETAIL(name, detail)                   \
+  openfpga::TraceScope OPENFPGA_TRACE_CONCAT(openfpga_trace_scope_, \
+                                             __LINE__)(             \
+    name, openfpga::trace_enabled() ? std::string(detail) : std::string())
+#define OPENFPGA_TRACE_COUNTER(name, value)   \
+  do {                                        \
+    if (openfpga::trace_enabled()) {          \
+      openfpga::trace_counter(name, (value)); \
+    }                                         \
+  } while (0)
+#else
+#define OPENFPGA_TRACE_SCOPE(name) \
+  do {                             \
+  } while (0)
+#define OPENFPGA_TRACE_SCOPE_DETAIL(name, detail) \
+  do {                                            \
+  } while (0)
+#define OPENFPGA_TRACE_COUNTER(name, value) \
+  do {                                      \
+  } while (0)
+#endif
+
+#endif
@@ -0,0 +1,454 @@
+/********************************************************************
+ * This file includes a streaming XML parser and the accessors of the
+ * elements which are reported to a handler
+ *******************************************************************/
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+/* Headers from openfpgautil library */
+#include "openfpga_xml_stream.h"
+
+/* namespace openfpga begins */
+namespace openfpga {
+
+/************************************************************************
+ * Member functions for class XmlStreamError
+ ***********************************************************************/
+XmlStreamError::XmlStreamError(const std::string& msg, const size_t& line)
+  : std::runtime_error(msg), line_(line) {}
+
+size_t XmlStreamError::line() const { return line_; }
+
+/************************************************************************
+ * Member functions for class XmlStreamElement
+ ***********************************************************************/
+XmlStreamElement::XmlStreamElement()
+  : line_(0), depth_(0), num_attributes_(0) {}
+
+const std::string& XmlStreamElement::name() const { return name_; }
+
+size_t XmlStreamElement::line() const { return line_; }
+
+size_t XmlStreamElement::depth() const { return depth_; }
+
+const char* XmlStreamElement::find_attribute(const char* name) const {
+  for (size_t iattr = 0; iattr < num_attributes_; ++iattr) {
+    if (attributes_[iattr].first == name) {
+      return attributes_[iattr].second.c_str();
+    }
+  }
+  return nullptr;
+}
+
+std::string XmlStreamElement::get_attribute(const char* name) const {
+  const char* value = find_attribute(name);
+  if (nullptr == value) {
+    error(std::string("Expected attribute '") + name + "' on <" + name_ +
+          ">");
+  }
+  return std::string(value);
+}
+
+/* Convert a string to an integer in the same way as pugixml, where a
+ * hexadecimal number starts with '0x' and an invalid number is zero */
+static int xml_string_to_int(const char* value) {
+  const char* curr = value;
+  while (' ' == *curr || '\t' == *curr || '\n' == *curr || '\r' == *curr) {
+    ++curr;
+  }
+  bool negative = ('-' == *curr);
+  if ('-' == *curr || '+' == *curr) {
+    ++curr;
+  }
+  int base = 10;
+  if ('0' == curr[0] && ('x' == curr[1] || 'X' == curr[1])) {
+    base = 16;
+    curr += 2;
+  }
+  long long result = std::strtoll(curr, nullptr, base);
+  return int(negative ? -result : result);
+}
+
+int XmlStreamElement::get_int_attribute(const char* name) const {
+  const char* value = find_attribute(name);
+  if (nullptr == value) {
+    error(std::string("Expected attribute '") + name + "' on <" + name_ +
+          ">");
+  }
+  return xml_string_to_int(value);
+}
+
+std::string XmlStreamElement::get_optional_attribute(const char* name) const {
+  const char* value = find_attribute(name);
+  if (nullptr == value) {
+    return std::string();
+  }
+  return std::string(value);
+}
+
+int XmlStreamElement::get_optional_int_attribute(
+  const char* name, const int& default_value) const {
+  const char* value = find_attribute(name);
+  if (nullptr == value) {
+    return default_value;
+  }
+  return xml_string_to_int(value);
+}
+
+void XmlStreamElement::bad_tag(
+  const std::string& parent_name,
+  const std::vector<std::string>& expected_names) const {
+  std::string msg = "Unexpected tag <" + name_ + "> in section <" +
+                    parent_name + ">, expected one of: ";
+  for (size_t iname = 0; iname < expected_names.size(); ++iname) {
+    if (0 < iname) {
+      msg += ", ";
+    }
+    msg += "<" + expected_names[iname] + ">";
+  }
+  error(msg);
+}
+
+void XmlStreamElement::error(const std::string& msg) const {
+  throw XmlStreamError(msg, line_);
+}
+
+/************************************************************************
+ * The parser, which walks through the document once
+ ***********************************************************************/
+class XmlStreamParser {
+ public: /* Constructors */
+  XmlStreamParser(const char* data, const size_t& size,
+                  XmlStreamHandler& handler);
+
+ public: /* Public mutators */
+  void parse();
+
+ private: /* Internal parsers */
+  bool starts_with(const char* pattern) const;
+  /* Move the cursor forward and count the lines which are passed */
+  void advance_to(const char* pos);
+  void skip_spaces();
+  void skip_past(const char* pattern, const char* what);
+  void skip_doctype();
+  void check_text(const char* begin, const char* end) const;
+  void read_name(std::string& name);
+  void read_attribute_value(std::string& value);
+  void parse_start_tag();
+  void parse_end_tag();
+  [[noreturn]] void error(const std::string& msg) const;
+
+ private: /* Internal data */
+  const char* curr_;
+  const char* end_;
+  size_t line_;
+  XmlStreamHandler& handler_;
+  XmlStreamElement element_;
+  std::vector<std::string> open_elements_;
+  bool has_root_;
+};
+
+static bool is_xml_space(const char& c) {
+  return ' ' == c || '\t' == c || '\n' == c || '\r' == c;
+}
+
+static bool is_xml_name_end(const char& c) {
+  return is_xml_space(c) || '/' == c || '>' == c || '=' == c || '<' == c;
+}
+
+/* Encode a unicode code point in UTF-8 */
+static void append_utf8(std::string& str, const unsigned long& code) {
+  if (code < 0x80) {
+    str += char(code);
+  } else if (code < 0x800) {
+    str += char(0xC0 | (code >> 6));
+    str += char(0x80 | (code & 0x3F));
+  } else if (code < 0x10000) {
+    str += char(0xE0 | (code >> 12));
+    str += char(0x80 | ((code >> 6) & 0x3F));
+    str += char(0x80 | (code & 0x3F));
+  } else {
+    str += char(0xF0 | (code >> 18));
+    str += char(0x80 | ((code >> 12) & 0x3F));
+    str += char(0x80 | ((code >> 6) & 0x3F));
+    str += char(0x80 | (code & 0x3F));
+  }
+}
+
+XmlStreamParser::XmlStreamParser(const char* data, const size_t& size,
+                                 XmlStreamHandler& handler)
+  : curr_(data),
+    end_(data + size),
+    line_(1),
+    handler_(handler),
+    has_root_(false) {}
+
+void XmlStreamParser::parse() {
+  /* Skip the byte order mark of UTF-8 */
+  if (starts_with("\xEF\xBB\xBF")) {
+    curr_ += 3;
+  }
+
+  while (curr_ < end_) {
+    const char* tag =
+      static_cast<const char*>(std::memchr(curr_, '<', end_ - curr_));
+    if (nullptr == tag) {
+      tag = end_;
+    }
+    check_text(curr_, tag);
+    advance_to(tag);
+    if (curr_ == end_) {
+      break;
+    }
+
+    if (starts_with("<?")) {
+      skip_past("?>", "processing instruction");
+    } else if (starts_with("<!--")) {
+      skip_past("-->", "comment");
+    } else if (starts_with("<![CDATA[")) {
+      if (open_elements_.empty()) {
+        error("Unexpected CDATA section outside the root element");
+      }
+      skip_past("]]>", "CDATA section");
+    } else if (starts_with("<!")) {
+      skip_doctype();
+    } else if (starts_with("</")) {
+      parse_end_tag();
+    } else {
+      parse_start_tag();
+    }
+  }
+
+  if (!open_elements_.empty()) {
+    error("Unexpected end of file, <" + open_elements_.back() +
+          "> is not closed");
+  }
+  if (!has_root_) {
+    error("No root element is found");
+  }
+}
+
+bool XmlStreamParser::starts_with(const char* pattern) const {
+  size_t len = std::strlen(pattern);
+  return size_t(end_ - curr_) >= len && 0 == std::memcmp(curr_, pattern, len);
+}
+
+void XmlStreamParser::advance_to(const char* pos) {
+  line_ += std::count(curr_, pos, '\n');
+  curr_ = pos;
+}
+
+void XmlStreamParser::skip_spaces() {
+  while (curr_ < end_ && is_xml_space(*curr_)) {
+    if ('\n' == *curr_) {
+      ++line_;
+    }
+    ++curr_;
+  }
+}
+
+void XmlStreamParser::skip_past(const char* pattern, const char* what) {
+  const char* pattern_end = pattern + std::strlen(pattern);
+  const char* pos = std::search(curr_, end_, pattern, pattern_end);
+  if (pos == end_) {
+    error(std::string("Unterminated ") + what);
+  }
+  advance_to(pos + (pattern_end - pattern));
+}
+
+/* A document type declaration may contain an internal subset in brackets */
+void XmlStreamParser::skip_doctype() {
+  const char* pos = curr_ + 2;
+  size_t bracket_depth = 0;
+  char quote = '\0';
+  for (; pos < end_; ++pos) {
+    if ('\0' != quote) {
+      if (quote == *pos) {
+        quote = '\0';
+      }
+    } else if ('"' == *pos || '\'' == *pos) {
+      quote = *pos;
+    } else if ('[' == *pos) {
+      ++bracket_depth;
+    } else if (']' == *pos && 0 < bracket_depth) {
+      --bracket_depth;
+    } else if ('>' == *pos && 0 == bracket_depth) {
+      break;
+    }
+  }
+  if (pos == end_) {
+    error("Unterminated document type declaration");
+  }
+  advance_to(pos + 1);
+}
+
+/* Text is ignored, but it is not allowed outside the root element */
+void XmlStreamParser::check_text(const char* begin, const char* end) const {
+  if (!open_elements_.empty()) {
+    return;
+  }
+  if (end != std::find_if_not(begin, end, is_xml_space)) {
+    error("Unexpected text outside the root element");
+  }
+}
+
+void XmlStreamParser::read_name(std::string& name) {
+  const char* begin = curr_;
+  while (curr_ < end_ && !is_xml_name_end(*curr_)) {
+    ++curr_;
+  }
+  if (begin == curr_) {
+    error("Expected a name");
+  }
+  name.assign(begin, curr_);
+}
+
+/* Read a quoted value, where entities are decoded and whitespaces are
+ * normalized to spaces as pugixml does by default */
+void XmlStreamParser::read_attribute_value(std::string& value) {
+  if (curr_ == end_ || ('"' != *curr_ && '\'' != *curr_)) {
+    error("Expected a quoted attribute value");
+  }
+  const char quote = *curr_;
+  const char* begin = curr_ + 1;
+  const char* end =
+    static_cast<const char*>(std::memchr(begin, quote, end_ - begin));
+  if (nullptr == end) {
+    error("Unterminated attribute value");
+  }
+
+  /* Most values have nothing to be decoded */
+  const char* special = std::find_if(begin, end, [](const char& c) {
+    return '&' == c || '\t' == c || '\n' == c || '\r' == c;
+  });
+  value.assign(begin, special);
+  for (const char* pos = special; pos < end; ++pos) {
+    if ('\r' == *pos) {
+      /* A line break of '\r\n' is a single space */
+      if (pos + 1 < end && '\n' == pos[1]) {
+        ++pos;
+      }
+      value += ' ';
+    } else if ('\t' == *pos || '\n' == *pos) {
+      value += ' ';
+    } else if ('&' == *pos) {
+      const char* semicolon = std::find(pos, end, ';');
+      if (semicolon == end) {
+        advance_to(pos);
+        error("Unterminated entity in attribute value");
+      }
+      std::string entity(pos + 1, semicolon);
+      if ("lt" == entity) {
+        value += '<';
+      } else if ("gt" == entity) {
+        value += '>';
+      } else if ("amp" == entity) {
+        value += '&';
+      } else if ("quot" == entity) {
+        value += '"';
+      } else if ("apos" == entity) {
+        value += '\'';
+      } else if (1 < entity.size() && '#' == entity[0]) {
+        bool hex = ('x' == entity[1]);
+        append_utf8(value, std::strtoul(entity.c_str() + (hex ? 2 : 1),
+                                        nullptr, hex ? 16 : 10));
+      } else {
+        advance_to(pos);
+        error("Unknown entity '&" + entity + ";' in attribute value");
+      }
+      pos = semicolon;
+    } else {
+      value += *pos;
+    }
+  }
+  advance_to(end + 1);
+}
+
+void XmlStreamParser::parse_start_tag() {
+  if (open_elements_.empty() && has_root_) {
+    error("Unexpected element after the root element");
+  }
+  ++curr_;
+  element_.line_ = line_;
+  element_.depth_ = open_elements_.size();
+  element_.num_attributes_ = 0;
+  read_name(element_.name_);
+
+  bool self_closing = false;
+  while (true) {
+    skip_spaces();
+    if (curr_ == end_) {
+      error("Unexpected end of file in <" + element_.name_ + ">");
+    }
+    if ('>' == *curr_) {
+      ++curr_;
+      break;
+    }
+    if (starts_with("/>")) {
+      curr_ += 2;
+      self_closing = true;
+      break;
+    }
+    /* Reuse the storage of attributes */
+    if (element_.num_attributes_ == element_.attributes_.size()) {
+      element_.attributes_.emplace_back();
+    }
+    std::pair<std::string, std::string>& attribute =
+      element_.attributes_[element_.num_attributes_];
+    read_name(attribute.first);
+    skip_spaces();
+    if (curr_ == end_ || '=' != *curr_) {
+      error("Expected '=' after attribute '" + attribute.first + "'");
+    }
+    ++curr_;
+    skip_spaces();
+    read_attribute_value(attribute.second);
+    ++element_.num_attributes_;
+  }
+
+  has_root_ = true;
+  open_elements_.push_back(element_.name_);
+  handler_.start_element(element_);
+  if (self_closing) {
+    handler_.end_element(element_);
+    open_elements_.pop_back();
+  }
+}
+
+void XmlStreamParser::parse_end_tag() {
+  curr_ += 2;
+  element_.line_ = line_;
+  element_.num_attributes_ = 0;
+  read_name(element_.name_);
+  skip_spaces();
+  if (curr_ == end_ || '>' != *curr_) {
+    error("Expected '>' to close </" + element_.name_ + ">");
+  }
+  ++curr_;
+  if (open_elements_.empty()) {
+    error("Unexpected end tag </" + element_.name_ + ">");
+  }
+  if (open_elements_.back() != element_.name_) {
+    error("Mismatched end tag </" + element_.name_ + ">, expected </" +
+          open_elements_.back() + ">");
+  }
+  element_.depth_ = open_elements_.size() - 1;
+  handler_.end_element(element_);
+  open_elements_.pop_back();
+}
+
+void XmlStreamParser::error(const std::string& msg) const {
+  throw XmlStreamError(msg, line_);
+}
+
+/************************************************************************
+ * Public functions
+ ***********************************************************************/
+void parse_xml_stream(const char* data, const size_t& size,
+                      XmlStreamHandler& handler) {
+  XmlStreamParser parser(data, size, handler);
+  parser.parse();
+}
+
+}  // namespace openfpga
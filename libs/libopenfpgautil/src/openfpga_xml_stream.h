@@ -0,0 +1,114 @@
+#ifndef OPENFPGA_XML_STREAM_H
+#define OPENFPGA_XML_STREAM_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+/********************************************************************
+ * A streaming (SAX-style) XML parser, which reports each element to a
+ * handler as soon as its start/end tag is parsed. Unlike a DOM parser,
+ * no document tree is built, so that very large files, e.g., fabric keys
+ * of large devices, can be read within a small and constant memory.
+ *
+ * Only elements and their attributes are reported. Declarations,
+ * comments, DOCTYPE, CDATA sections and text are skipped. Entities in
+ * attribute values are decoded.
+ *
+ * Typical usage:
+ *   class MyHandler : public XmlStreamHandler {
+ *     void start_element(const XmlStreamElement& element) override {
+ *       if (1 == element.depth() && element.name() == "key") {
+ *         int id = element.get_int_attribute("id");
+ *       }
+ *     }
+ *     void end_element(const XmlStreamElement& element) override {}
+ *   };
+ *   MyHandler handler;
+ *   parse_xml_stream(data, size, handler);
+ *
+ * Any syntax error, as well as any error raised by the handler through the
+ * accessors of XmlStreamElement, is thrown as an XmlStreamError with the
+ * line number where it happens.
+ *******************************************************************/
+
+/* namespace openfpga begins */
+namespace openfpga {
+
+class XmlStreamError : public std::runtime_error {
+ public: /* Constructors */
+  XmlStreamError(const std::string& msg, const size_t& line);
+
+ public: /* Public accessors */
+  size_t line() const;
+
+ private: /* Internal data */
+  size_t line_;
+};
+
+/* An element under parsing. It is only valid inside the callbacks of a
+ * handler, as the storage is reused by the next element */
+class XmlStreamElement {
+  friend class XmlStreamParser;
+
+ public: /* Constructors */
+  XmlStreamElement();
+
+ public: /* Public accessors */
+  const std::string& name() const;
+  /* Line number of the start/end tag */
+  size_t line() const;
+  /* Depth of the element, where the root element is at depth 0 */
+  size_t depth() const;
+
+  /* Return nullptr if the attribute does not exist */
+  const char* find_attribute(const char* name) const;
+  /* Error out if a required attribute does not exist */
+  std::string get_attribute(const char* name) const;
+  int get_int_attribute(const char* name) const;
+  /* Return a default value if an optional attribute does not exist */
+  std::string get_optional_attribute(const char* name) const;
+  int get_optional_int_attribute(const char* name,
+                                 const int& default_value) const;
+
+  /* Error out for an element which is not expected under its parent */
+  [[noreturn]] void bad_tag(
+    const std::string& parent_name,
+    const std::vector<std::string>& expected_names) const;
+  /* Error out with a message at the line of the element */
+  [[noreturn]] void error(const std::string& msg) const;
+
+ private: /* Internal data */
+  std::string name_;
+  size_t line_;
+  size_t depth_;
+  /* Storage of attributes is reused, only the first num_attributes_ are
+   * valid */
+  std::vector<std::pair<std::string, std::string>> attributes_;
+  size_t num_attributes_;
+};
+
+class XmlStreamHandler {
+ public: /* Constructors */
+  virtual ~XmlStreamHandler() {}
+
+ public: /* Callbacks */
+  /* Called for each start tag, with all the attributes of the element */
+  virtual void start_element(const XmlStreamElement& element) = 0;
+  /* Called for each end tag, with no attributes. A self-closing tag is
+   * reported by both callbacks */
+  virtual void end_element(const XmlStreamElement& element) = 0;
+};
+
+/* Parse an XML document in memory, e.g., a mapped file */
+void parse_xml_stream(const char* data, const size_t& size,
+                      XmlStreamHandler& handler);
+
+}  // namespace openfpga
+
+#endif
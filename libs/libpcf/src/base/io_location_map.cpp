@@ -10,6 +10,7 @@
 
 /* Headers from openfpgautil library */
 #include "io_location_map.h"
+#include "openfpga_bin_stream.h"
 #include "openfpga_digest.h"
 
 /* begin namespace openfpga */
@@ -73,6 +74,10 @@ size_t IoLocationMap::io_z(const BasicPort& io_port) const {
   return size_t(-1);
 }
 
+void IoLocationMap::memory_usage(MemoryUsage& usage) const {
+  usage.add_lookup(io_indices_);
+}
+
 void IoLocationMap::set_io_index(const size_t& x, const size_t& y,
                                  const size_t& z,
                                  const std::string& io_port_name,
@@ -170,4 +175,28 @@ int IoLocationMap::write_to_xml_file(const std::string& fname,
   return err_code;
 }
 
+/* Coordinates are written one by one, followed by the I/Os on it */
+void IoLocationMap::write_to_bin_stream(std::ostream& fp) const {
+  write_bin(fp, io_indices_.size());
+  for (const auto& io_index : io_indices_) {
+    for (const size_t& coord : io_index.first) {
+      write_bin(fp, coord);
+    }
+    write_bin(fp, io_index.second);
+  }
+}
+
+void IoLocationMap::read_from_bin_stream(std::istream& fp) {
+  io_indices_.clear();
+  size_t num_coords = 0;
+  read_bin(fp, num_coords);
+  for (size_t icoord = 0; icoord < num_coords; ++icoord) {
+    std::array<size_t, 3> coord = {0, 0, 0};
+    for (size_t& index : coord) {
+      read_bin(fp, index);
+    }
+    read_bin(fp, io_indices_[coord]);
+  }
+}
+
 } /* end namespace openfpga */
@@ -7,10 +7,13 @@
 #include <stddef.h>
 
 #include <array>
+#include <istream>
 #include <map>
+#include <ostream>
 #include <string>
 #include <vector>
 
+#include "openfpga_memory_usage.h"
 #include "openfpga_port.h"
 
 /* Begin namespace openfpga */
@@ -39,6 +42,7 @@ class IoLocationMap {
   size_t io_x(const BasicPort& io_port) const;
   size_t io_y(const BasicPort& io_port) const;
   size_t io_z(const BasicPort& io_port) const;
+  void memory_usage(MemoryUsage& usage) const;
 
  public: /* Public mutators */
   void set_io_index(const size_t& x, const size_t& y, const size_t& z,
@@ -49,6 +53,14 @@ class IoLocationMap {
                         const bool& include_time_stamp,
                         const bool& verbose) const;
 
+ public: /* Public serializers */
+  /* Write all the internal data to a binary stream, which can be restored by
+   * read_from_bin_stream() without parsing the XML file again */
+  void write_to_bin_stream(std::ostream& fp) const;
+  /* Restore all the internal data from a binary stream. Any existing data will
+   * be overwritten */
+  void read_from_bin_stream(std::istream& fp);
+
  private: /* Internal Data */
   /* I/O index fast lookup by [x][y][z] location
    * Note that multiple I/Os may be assigned to the same coordinate!
@@ -5,49 +5,53 @@
  *******************************************************************/
 #include <string>
 
-/* Headers from pugi XML library */
-#include "pugixml.hpp"
-#include "pugixml_util.hpp"
-
 /* Headers from vtr util library */
 #include "vtr_assert.h"
+#include "vtr_log.h"
 #include "vtr_time.h"
 
 /* Headers from libopenfpga util library */
+#include "openfpga_file_cache.h"
 #include "openfpga_port_parser.h"
+#include "openfpga_xml_stream.h"
 
 /* Headers from libarchfpga */
 #include "arch_error.h"
 #include "read_xml_io_location_map.h"
-#include "read_xml_util.h"
 
 /* Begin namespace openfpga */
 namespace openfpga {
 
+/* Identifiers of the binary cache of I/O location maps. Increase the version
+ * whenever the layout of IoLocationMap::write_to_bin_stream() changes */
+constexpr const char* IO_LOCATION_MAP_CACHE_MAGIC =
+  "OPENFPGA_IO_LOCATION_MAP_CACHE";
+constexpr size_t IO_LOCATION_MAP_CACHE_VERSION = 1;
+
 /********************************************************************
- * Parse XML codes of a <set_io> to an object of PinConstraint
+ * Parse XML codes of a <io> to an object of IoLocationMap
  *******************************************************************/
-static void read_xml_one_io_location(pugi::xml_node& xml_io,
-                                     const pugiutil::loc_data& loc_data,
+static void read_xml_one_io_location(const char* fname,
+                                     const XmlStreamElement& xml_io,
                                      IoLocationMap& io_location_map) {
-  openfpga::PortParser port_parser(
-    get_attribute(xml_io, "pad", loc_data).as_string());
+  std::string pad_name = xml_io.get_attribute("pad");
+  openfpga::PortParser port_parser(pad_name);
 
-  int x_coord = get_attribute(xml_io, "x", loc_data).as_int();
-  int y_coord = get_attribute(xml_io, "y", loc_data).as_int();
-  int z_coord = get_attribute(xml_io, "z", loc_data).as_int();
+  int x_coord = xml_io.get_int_attribute("x");
+  int y_coord = xml_io.get_int_attribute("y");
+  int z_coord = xml_io.get_int_attribute("z");
 
   /* Sanity checks */
   if (x_coord < 0 || y_coord < 0 || z_coord < 0) {
-    archfpga_throw(loc_data.filename_c_str(), loc_data.line(xml_io),
+    archfpga_throw(fname, xml_io.line(),
                    "Invalid coordinate (x, y, z) = (%d, %d, %d)! Expect zero "
                    "or a positive integer!\n",
                    x_coord, y_coord, z_coord);
   }
   if (port_parser.port().get_width() != 1) {
-    archfpga_throw(loc_data.filename_c_str(), loc_data.line(xml_io),
+    archfpga_throw(fname, xml_io.line(),
                    "I/O (%s) does not have a port size of 1!\n",
-                   get_attribute(xml_io, "pad", loc_data).as_string());
+                   pad_name.c_str());
   }
   io_location_map.set_io_index(size_t(x_coord), size_t(y_coord),
                                size_t(z_coord), port_parser.port().get_name(),
@@ -55,37 +59,86 @@ static void read_xml_one_io_location(pugi::xml_node& xml_io,
 }
 
 /********************************************************************
- * Parse XML codes about <io_coordinates> to an object of PinConstraints
+ * Handler of the streaming parser, which parses each <io> as soon as
+ * it is read
  *******************************************************************/
-IoLocationMap read_xml_io_location_map(const char* fname) {
-  vtr::ScopedStartFinishTimer timer("Read I/O Location Map");
+class IoLocationMapXmlHandler : public XmlStreamHandler {
+ public: /* Constructors */
+  IoLocationMapXmlHandler(const char* fname, IoLocationMap& io_location_map)
+    : fname_(fname), io_location_map_(io_location_map) {}
+
+ public: /* Callbacks */
+  void start_element(const XmlStreamElement& element) override {
+    if (0 == element.depth()) {
+      if (element.name() != std::string("io_coordinates")) {
+        element.error("Expected root tag <io_coordinates>");
+      }
+    } else if (1 == element.depth()) {
+      /* Error out if the XML child has an invalid name! */
+      if (element.name() != std::string("io")) {
+        element.bad_tag("io_coordinates", {"io"});
+      }
+      read_xml_one_io_location(fname_, element, io_location_map_);
+    }
+  }
 
-  IoLocationMap io_location_map;
+  void end_element(const XmlStreamElement& /*element*/) override {}
 
-  /* Parse the file */
-  pugi::xml_document doc;
-  pugiutil::loc_data loc_data;
+ private: /* Internal data */
+  const char* fname_;
+  IoLocationMap& io_location_map_;
+};
 
+/********************************************************************
+ * Parse the whole XML file to an I/O location map
+ *******************************************************************/
+static IoLocationMap read_xml_io_location_map_stream(
+  const char* fname, const MappedFile& xml_file) {
+  IoLocationMap io_location_map;
+  IoLocationMapXmlHandler handler(fname, io_location_map);
   try {
-    loc_data = pugiutil::load_xml(doc, fname);
+    parse_xml_stream(xml_file.data(), xml_file.size(), handler);
+  } catch (XmlStreamError& e) {
+    archfpga_throw(fname, e.line(), "%s", e.what());
+  }
+  return io_location_map;
+}
 
-    pugi::xml_node xml_root = get_single_child(doc, "io_coordinates", loc_data);
+/********************************************************************
+ * Parse XML codes about <io_coordinates> to an object of IoLocationMap
+ * When a cache file is given, the map is loaded from the cache if
+ * the XML is not changed since the cache is written. Otherwise, the cache
+ * is (re)written after parsing the XML.
+ *******************************************************************/
+IoLocationMap read_xml_io_location_map(const char* fname,
+                                       const std::string& cache_fname) {
+  vtr::ScopedStartFinishTimer timer("Read I/O Location Map");
 
-    /*size_t num_children = std::distance(xml_root.children().begin(),
-     * xml_root.children().end());
-     * TODO: Reserve memory space for efficiency */
+  MappedFile xml_file;
+  if (!xml_file.open(fname)) {
+    archfpga_throw(fname, 0, "Unable to open I/O location map file!\n");
+  }
+  if (cache_fname.empty()) {
+    return read_xml_io_location_map_stream(fname, xml_file);
+  }
 
-    for (pugi::xml_node xml_io : xml_root.children()) {
-      /* Error out if the XML child has an invalid name! */
-      if (xml_io.name() != std::string("io")) {
-        bad_tag(xml_io, loc_data, xml_root, {"io"});
-      }
-      read_xml_one_io_location(xml_io, loc_data, io_location_map);
-    }
-  } catch (pugiutil::XmlError& e) {
-    archfpga_throw(fname, e.line(), "%s", e.what());
+  uint64_t digest = file_digest(xml_file.data(), xml_file.size());
+  IoLocationMap io_location_map;
+  if (read_file_cache(
+        cache_fname, IO_LOCATION_MAP_CACHE_MAGIC, IO_LOCATION_MAP_CACHE_VERSION,
+        digest,
+        [&](std::istream& fp) { io_location_map.read_from_bin_stream(fp); })) {
+    VTR_LOG("Loaded I/O location map from cache '%s'\n", cache_fname.c_str());
+    return io_location_map;
   }
 
+  io_location_map = read_xml_io_location_map_stream(fname, xml_file);
+  if (write_file_cache(
+        cache_fname, IO_LOCATION_MAP_CACHE_MAGIC, IO_LOCATION_MAP_CACHE_VERSION,
+        digest,
+        [&](std::ostream& fp) { io_location_map.write_to_bin_stream(fp); })) {
+    VTR_LOG("Wrote I/O location map to cache '%s'\n", cache_fname.c_str());
+  }
   return io_location_map;
 }
 
@@ -4,6 +4,8 @@
 /********************************************************************
  * Include header files that are required by function declaration
  *******************************************************************/
+#include <string>
+
 #include "io_location_map.h"
 
 /********************************************************************
@@ -13,7 +15,8 @@
 /* Begin namespace openfpga */
 namespace openfpga {
 
-IoLocationMap read_xml_io_location_map(const char* fname);
+IoLocationMap read_xml_io_location_map(const char* fname,
+                                       const std::string& cache_fname = "");
 
 } /* End namespace openfpga*/
 
@@ -0,0 +1,116 @@
+/********************************************************************
+ * This file includes macro-benchmarks, which run the OpenFPGA commands on an
+ * architecture and a benchmark, as a user would do in a script. Engines that
+ * depend on the device, e.g., the uniquification of GSBs, are timed in
+ * isolation once the architecture is linked.
+ *******************************************************************/
+#include "bench_flow.h"
+
+#include <string>
+#include <vector>
+
+/* Headers from vtrutil library */
+#include "vtr_log.h"
+
+/* Headers from openfpgashell library */
+#include "command_exit_codes.h"
+
+/* Headers from openfpgautil library */
+#include "openfpga_digest.h"
+
+/* Headers from openfpga library */
+#include "bench_micro.h"
+#include "globals.h"
+#include "openfpga_shell.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/********************************************************************
+ * Run a command in the shell and record its runtime, where the name of the
+ * benchmark is the name of the command.
+ * Commands are always executed, even if they are not selected by the
+ * filter, as the following commands depend on them
+ *******************************************************************/
+static int run_bench_command(BenchRunner& runner, OpenfpgaShell& shell,
+                             const std::string& cmd_line,
+                             const BenchParams& params) {
+  std::string cmd_name = cmd_line.substr(0, cmd_line.find(' '));
+
+  double start = bench_now();
+  int status = shell.run_command(cmd_line.c_str());
+  double runtime = bench_now() - start;
+  if (CMD_EXEC_FATAL_ERROR == status) {
+    VTR_LOG_ERROR("Command '%s' failed!\n", cmd_line.c_str());
+    return status;
+  }
+
+  runner.record("flow", "flow." + cmd_name, params, 1, runtime);
+  return CMD_EXEC_SUCCESS;
+}
+
+/********************************************************************
+ * Top-level function to run the commands of a typical bitstream generation
+ * flow on a fixed device
+ * Note that VPR keeps its data in global contexts, so only one device can
+ * be benchmarked in a process
+ *******************************************************************/
+int run_flow_benchmarks(BenchRunner& runner, const BenchFlowSetting& setting,
+                        const size_t& scale) {
+  OpenfpgaShell shell;
+  const BenchParams params = {
+    {"vpr_arch", find_path_file_name(setting.vpr_arch)},
+    {"openfpga_arch", find_path_file_name(setting.openfpga_arch)},
+    {"benchmark", find_path_file_name(setting.benchmark)},
+    {"device", setting.device}};
+
+  std::vector<std::string> setup_cmds = {
+    "vpr " + setting.vpr_arch + " " + setting.benchmark +
+      " --clock_modeling route --device " + setting.device,
+    "read_openfpga_arch -f " + setting.openfpga_arch};
+  if (!setting.sim_setting.empty()) {
+    setup_cmds.push_back("read_openfpga_simulation_setting -f " +
+                         setting.sim_setting);
+  }
+  std::string link_cmd = "link_openfpga_arch --sort_gsb_chan_node_in_edges";
+  if (!setting.activity.empty()) {
+    link_cmd += " --activity_file " + setting.activity;
+  }
+  setup_cmds.push_back(link_cmd);
+
+  for (const std::string& cmd_line : setup_cmds) {
+    if (CMD_EXEC_SUCCESS !=
+        run_bench_command(runner, shell, cmd_line, params)) {
+      return CMD_EXEC_FATAL_ERROR;
+    }
+  }
+
+  /* Engines which only depend on the architecture and the device */
+  const OpenfpgaContext& openfpga_ctx = shell.openfpga_context();
+  vtr::Point<size_t> gsb_range = openfpga_ctx.device_rr_gsb().get_gsb_range();
+  runner.run("flow", "device_rr_gsb.build_unique_module", params,
+             gsb_range.x() * gsb_range.y(), nullptr, [&]() {
+               shell.mutable_openfpga_context()
+                 .mutable_device_rr_gsb()
+                 .build_unique_module(g_vpr_ctx.device().rr_graph);
+             });
+  run_mux_graph_benchmarks(runner, openfpga_ctx.arch().circuit_lib,
+                           openfpga_ctx.mux_lib());
+  run_lut_bitstream_benchmarks(runner, openfpga_ctx.arch().circuit_lib,
+                               openfpga_ctx.mux_lib(), scale);
+
+  /* Build the fabric and its bitstream */
+  std::vector<std::string> fabric_cmds = {
+    "lut_truth_table_fixup", "build_fabric --compress_routing", "repack",
+    "build_architecture_bitstream", "build_fabric_bitstream"};
+  for (const std::string& cmd_line : fabric_cmds) {
+    if (CMD_EXEC_SUCCESS !=
+        run_bench_command(runner, shell, cmd_line, params)) {
+      return CMD_EXEC_FATAL_ERROR;
+    }
+  }
+
+  return CMD_EXEC_SUCCESS;
+}
+
+} /* end namespace openfpga */
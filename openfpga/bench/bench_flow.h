@@ -0,0 +1,35 @@
+#ifndef BENCH_FLOW_H
+#define BENCH_FLOW_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include <string>
+
+#include "bench_runner.h"
+
+/********************************************************************
+ * Function declaration
+ *******************************************************************/
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/* Input files and device to run the OpenFPGA commands */
+struct BenchFlowSetting {
+  std::string vpr_arch;
+  std::string openfpga_arch;
+  std::string sim_setting;
+  /* A packed-ready BLIF netlist and its activity file */
+  std::string benchmark;
+  std::string activity;
+  /* Name of a fixed layout in the VPR architecture, e.g., 4x4 */
+  std::string device;
+};
+
+int run_flow_benchmarks(BenchRunner& runner, const BenchFlowSetting& setting,
+                        const size_t& scale);
+
+} /* end namespace openfpga */
+
+#endif
@@ -0,0 +1,310 @@
+/********************************************************************
+ * This file includes micro-benchmarks on the core data structures and
+ * engines of OpenFPGA. Data structures are filled with synthetic contents
+ * whose size is controlled by a scale factor, so that results are
+ * repeatable and independent from any architecture
+ *******************************************************************/
+#include "bench_micro.h"
+
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+/* Headers from vtrutil library */
+#include "vtr_log.h"
+
+/* Headers from fpgabitstream library */
+#include "bitstream_manager.h"
+
+/* Headers from openfpga library */
+#include "lut_utils.h"
+#include "module_manager.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/* Width of the ports in the synthetic module graph */
+constexpr size_t BENCH_PORT_WIDTH = 4;
+/* Number of configuration bits per block in the synthetic bitstream */
+constexpr size_t BENCH_BLOCK_NUM_BITS = 16;
+/* Seed of the random generator, so that each run sees the same inputs */
+constexpr unsigned BENCH_RANDOM_SEED = 1;
+
+/********************************************************************
+ * Build a synthetic module graph, where a top-level module contains a
+ * number of ports and child instances, and each pin of the top-level
+ * ports drives an input pin of a child instance
+ *******************************************************************/
+static ModuleId build_bench_module_graph(ModuleManager& module_manager,
+                                         const size_t& scale) {
+  ModuleId leaf_module = module_manager.add_module("bench_leaf");
+  ModulePortId leaf_in_port = module_manager.add_port(
+    leaf_module, BasicPort("in", BENCH_PORT_WIDTH),
+    ModuleManager::MODULE_INPUT_PORT);
+  module_manager.add_port(leaf_module, BasicPort("out", BENCH_PORT_WIDTH),
+                          ModuleManager::MODULE_OUTPUT_PORT);
+
+  ModuleId top_module = module_manager.add_module("bench_top");
+  std::vector<ModulePortId> top_ports;
+  for (size_t iport = 0; iport < scale; ++iport) {
+    top_ports.push_back(module_manager.add_port(
+      top_module,
+      BasicPort("port_" + std::to_string(iport), BENCH_PORT_WIDTH),
+      ModuleManager::MODULE_INPUT_PORT));
+  }
+  for (size_t inst = 0; inst < scale; ++inst) {
+    module_manager.add_child_module(top_module, leaf_module, false);
+  }
+
+  module_manager.reserve_module_nets(top_module, scale * BENCH_PORT_WIDTH);
+  for (size_t inst = 0; inst < scale; ++inst) {
+    for (size_t ipin = 0; ipin < BENCH_PORT_WIDTH; ++ipin) {
+      ModuleNetId net = module_manager.create_module_net(top_module);
+      module_manager.add_module_net_source(top_module, net, top_module, 0,
+                                           top_ports[inst], ipin);
+      module_manager.add_module_net_sink(top_module, net, leaf_module, inst,
+                                         leaf_in_port, ipin);
+    }
+  }
+  return top_module;
+}
+
+/********************************************************************
+ * Benchmarks on the module manager
+ * - building a module graph, including ports, child instances and nets
+ * - finding ports by names
+ * - finding nets driving the pins of child instances
+ *******************************************************************/
+void run_module_manager_benchmarks(BenchRunner& runner, const size_t& scale) {
+  const BenchParams params = {{"scale", std::to_string(scale)}};
+  std::unique_ptr<ModuleManager> module_manager;
+
+  runner.run(
+    "micro", "module_manager.build", params, scale,
+    [&]() { module_manager.reset(new ModuleManager()); },
+    [&]() {
+      bench_consume(size_t(build_bench_module_graph(*module_manager, scale)));
+    });
+
+  module_manager.reset(new ModuleManager());
+  ModuleId top_module = build_bench_module_graph(*module_manager, scale);
+  ModuleId leaf_module = module_manager->find_module("bench_leaf");
+  ModulePortId leaf_in_port =
+    module_manager->find_module_port(leaf_module, "in");
+  std::vector<std::string> port_names;
+  for (size_t iport = 0; iport < scale; ++iport) {
+    port_names.push_back("port_" + std::to_string(iport));
+  }
+
+  runner.run("micro", "module_manager.find_module_port", params, scale,
+             nullptr, [&]() {
+               for (const std::string& port_name : port_names) {
+                 bench_consume(size_t(
+                   module_manager->find_module_port(top_module, port_name)));
+               }
+             });
+
+  runner.run(
+    "micro", "module_manager.module_instance_port_net", params,
+    scale * BENCH_PORT_WIDTH, nullptr, [&]() {
+      for (size_t inst = 0; inst < scale; ++inst) {
+        for (size_t ipin = 0; ipin < BENCH_PORT_WIDTH; ++ipin) {
+          bench_consume(size_t(module_manager->module_instance_port_net(
+            top_module, leaf_module, inst, leaf_in_port, ipin)));
+        }
+      }
+    });
+}
+
+/********************************************************************
+ * Build a synthetic bitstream with a top-level block containing a number of
+ * child blocks, each of which has a fixed number of configuration bits
+ *******************************************************************/
+static ConfigBlockId build_bench_bitstream(
+  BitstreamManager& bitstream_manager, const size_t& scale) {
+  bitstream_manager.reserve_blocks(scale + 1);
+  bitstream_manager.reserve_bits(scale * BENCH_BLOCK_NUM_BITS);
+  ConfigBlockId top_block = bitstream_manager.add_block("bench_top");
+  bitstream_manager.reserve_child_blocks(top_block, scale);
+  std::vector<bool> block_bits(BENCH_BLOCK_NUM_BITS, false);
+  for (size_t iblk = 0; iblk < scale; ++iblk) {
+    ConfigBlockId block =
+      bitstream_manager.add_block("blk_" + std::to_string(iblk));
+    bitstream_manager.add_child_block(top_block, block);
+    bitstream_manager.add_block_bits(block, block_bits);
+  }
+  return top_block;
+}
+
+/********************************************************************
+ * Benchmarks on the bitstream manager
+ * - building a bitstream, including blocks and bits
+ * - finding child blocks by names
+ * - overwriting bits by their paths in the hierarchy
+ *******************************************************************/
+void run_bitstream_manager_benchmarks(BenchRunner& runner,
+                                      const size_t& scale) {
+  const BenchParams params = {{"scale", std::to_string(scale)}};
+  std::unique_ptr<BitstreamManager> bitstream_manager;
+
+  runner.run(
+    "micro", "bitstream_manager.build", params, scale,
+    [&]() { bitstream_manager.reset(new BitstreamManager()); },
+    [&]() {
+      build_bench_bitstream(*bitstream_manager, scale);
+      bench_consume(bitstream_manager->num_bits());
+    });
+
+  bitstream_manager.reset(new BitstreamManager());
+  ConfigBlockId top_block = build_bench_bitstream(*bitstream_manager, scale);
+  std::vector<std::string> block_names;
+  for (size_t iblk = 0; iblk < scale; ++iblk) {
+    block_names.push_back("blk_" + std::to_string(iblk));
+  }
+
+  runner.run("micro", "bitstream_manager.find_child_block", params, scale,
+             nullptr, [&]() {
+               for (const std::string& block_name : block_names) {
+                 bench_consume(size_t(bitstream_manager->find_child_block(
+                   top_block, block_name)));
+               }
+             });
+
+  /* Overwrite a random bit of each block */
+  std::mt19937 rng(BENCH_RANDOM_SEED);
+  std::vector<std::string> bit_paths;
+  for (const std::string& block_name : block_names) {
+    bit_paths.push_back("bench_top." + block_name + "[" +
+                        std::to_string(rng() % BENCH_BLOCK_NUM_BITS) + "]");
+  }
+  runner.run("micro", "bitstream_manager.overwrite_bitstream", params, scale,
+             nullptr, [&]() {
+               for (const std::string& bit_path : bit_paths) {
+                 bitstream_manager->overwrite_bitstream(bit_path, true);
+               }
+             });
+}
+
+/********************************************************************
+ * Benchmarks on decoding the configuration bits of routing multiplexers,
+ * where each path of each multiplexer in the library is decoded.
+ * LUTs are skipped as their bits are decoded from truth tables
+ *******************************************************************/
+void run_mux_graph_benchmarks(BenchRunner& runner,
+                              const CircuitLibrary& circuit_lib,
+                              const MuxLibrary& mux_lib) {
+  std::vector<MuxId> muxes;
+  size_t num_paths = 0;
+  for (const MuxId& mux : mux_lib.muxes()) {
+    if (CIRCUIT_MODEL_MUX !=
+        circuit_lib.model_type(mux_lib.mux_circuit_model(mux))) {
+      continue;
+    }
+    muxes.push_back(mux);
+    num_paths += mux_lib.mux_graph(mux).num_inputs();
+  }
+  if (muxes.empty()) {
+    VTR_LOG_WARN("No routing multiplexer is found to benchmark!\n");
+    return;
+  }
+
+  const BenchParams params = {{"num_muxes", std::to_string(muxes.size())},
+                              {"max_mux_size",
+                               std::to_string(mux_lib.max_mux_size())}};
+  runner.run("micro", "mux_graph.decode_memory_bits", params, num_paths,
+             nullptr, [&]() {
+               for (const MuxId& mux : muxes) {
+                 const MuxGraph& mux_graph = mux_lib.mux_graph(mux);
+                 for (size_t ipath = 0; ipath < mux_graph.num_inputs();
+                      ++ipath) {
+                   bench_consume(mux_graph
+                                   .decode_memory_bits(MuxInputId(ipath),
+                                                       MuxOutputId(0))
+                                   .size());
+                 }
+               }
+             });
+}
+
+/********************************************************************
+ * Build a random truth table of a single-output LUT, which is given in
+ * on-set, i.e., each line ends with a logic '1'
+ *******************************************************************/
+static AtomNetlist::TruthTable build_bench_truth_table(const size_t& lut_size,
+                                                       std::mt19937& rng) {
+  AtomNetlist::TruthTable truth_table;
+  size_t num_lines = 1 + rng() % (size_t(1) << lut_size);
+  for (size_t iline = 0; iline < num_lines; ++iline) {
+    std::vector<vtr::LogicValue> tt_line;
+    for (size_t ipin = 0; ipin < lut_size; ++ipin) {
+      switch (rng() % 3) {
+        case 0:
+          tt_line.push_back(vtr::LogicValue::FALSE);
+          break;
+        case 1:
+          tt_line.push_back(vtr::LogicValue::TRUE);
+          break;
+        default:
+          tt_line.push_back(vtr::LogicValue::DONT_CARE);
+      }
+    }
+    tt_line.push_back(vtr::LogicValue::TRUE);
+    truth_table.push_back(tt_line);
+  }
+  return truth_table;
+}
+
+/********************************************************************
+ * Benchmarks on generating the configuration bits of LUTs from random truth
+ * tables. Each LUT in the library is considered as a single-output LUT,
+ * whose output covers all the configuration bits
+ *******************************************************************/
+void run_lut_bitstream_benchmarks(BenchRunner& runner,
+                                  const CircuitLibrary& circuit_lib,
+                                  const MuxLibrary& mux_lib,
+                                  const size_t& scale) {
+  /* A LUT output pin which is only used as the key of truth tables */
+  t_port lut_output_port;
+  lut_output_port.index = 0;
+  t_pb_graph_pin lut_output_pin;
+  lut_output_pin.port = &lut_output_port;
+  lut_output_pin.pin_number = 0;
+
+  std::mt19937 rng(BENCH_RANDOM_SEED);
+  for (const MuxId& mux : mux_lib.muxes()) {
+    if (CIRCUIT_MODEL_LUT !=
+        circuit_lib.model_type(mux_lib.mux_circuit_model(mux))) {
+      continue;
+    }
+    const MuxGraph& lut_mux_graph = mux_lib.mux_graph(mux);
+    size_t lut_size = lut_mux_graph.num_memory_bits();
+
+    std::vector<std::vector<LutOutputBitRange>> output_bit_ranges(1);
+    output_bit_ranges[0].push_back({0, lut_mux_graph.num_inputs()});
+
+    std::vector<std::map<const t_pb_graph_pin*, AtomNetlist::TruthTable>>
+      lut_truth_tables(scale);
+    for (auto& truth_tables : lut_truth_tables) {
+      truth_tables[&lut_output_pin] = build_bench_truth_table(lut_size, rng);
+    }
+
+    const BenchParams params = {
+      {"circuit_model",
+       circuit_lib.model_name(mux_lib.mux_circuit_model(mux))},
+      {"lut_size", std::to_string(lut_size)},
+      {"scale", std::to_string(scale)}};
+    runner.run("micro", "lut_utils.build_frac_lut_bitstream", params, scale,
+               nullptr, [&]() {
+                 for (const auto& truth_tables : lut_truth_tables) {
+                   bench_consume(build_frac_lut_bitstream(lut_mux_graph,
+                                                          output_bit_ranges,
+                                                          truth_tables, 0)
+                                   .size());
+                 }
+               });
+  }
+}
+
+} /* end namespace openfpga */
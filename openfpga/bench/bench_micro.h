@@ -0,0 +1,34 @@
+#ifndef BENCH_MICRO_H
+#define BENCH_MICRO_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include "bench_runner.h"
+#include "circuit_library.h"
+#include "mux_library.h"
+
+/********************************************************************
+ * Function declaration
+ *******************************************************************/
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+void run_module_manager_benchmarks(BenchRunner& runner, const size_t& scale);
+
+void run_bitstream_manager_benchmarks(BenchRunner& runner,
+                                      const size_t& scale);
+
+void run_mux_graph_benchmarks(BenchRunner& runner,
+                              const CircuitLibrary& circuit_lib,
+                              const MuxLibrary& mux_lib);
+
+void run_lut_bitstream_benchmarks(BenchRunner& runner,
+                                  const CircuitLibrary& circuit_lib,
+                                  const MuxLibrary& mux_lib,
+                                  const size_t& scale);
+
+} /* end namespace openfpga */
+
+#endif
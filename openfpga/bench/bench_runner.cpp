@@ -0,0 +1,227 @@
+/********************************************************************
+ * This file includes member functions of the benchmark runner
+ *******************************************************************/
+#include "bench_runner.h"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <numeric>
+#include <sstream>
+
+/* Headers from vtrutil library */
+#include "vtr_log.h"
+
+/* Headers from openfpgashell library */
+#include "command_exit_codes.h"
+
+/* Headers from openfpgautil library */
+#include "openfpga_digest.h"
+
+/* Begin namespace openfpga */
+namespace openfpga {
+
+/********************************************************************
+ * Local functions
+ *******************************************************************/
+static double find_min_sample(const std::vector<double>& samples) {
+  return *std::min_element(samples.begin(), samples.end());
+}
+
+static double find_max_sample(const std::vector<double>& samples) {
+  return *std::max_element(samples.begin(), samples.end());
+}
+
+static double find_mean_sample(const std::vector<double>& samples) {
+  return std::accumulate(samples.begin(), samples.end(), 0.) /
+         double(samples.size());
+}
+
+static double find_median_sample(const std::vector<double>& samples) {
+  std::vector<double> sorted_samples = samples;
+  std::sort(sorted_samples.begin(), sorted_samples.end());
+  size_t mid = sorted_samples.size() / 2;
+  if (0 == sorted_samples.size() % 2) {
+    return 0.5 * (sorted_samples[mid - 1] + sorted_samples[mid]);
+  }
+  return sorted_samples[mid];
+}
+
+/* Escape a string to be a JSON string literal */
+static std::string json_string(const std::string& str) {
+  std::string escaped("\"");
+  for (const char& c : str) {
+    switch (c) {
+      case '"':
+        escaped += "\\\"";
+        break;
+      case '\\':
+        escaped += "\\\\";
+        break;
+      case '\n':
+        escaped += "\\n";
+        break;
+      case '\t':
+        escaped += "\\t";
+        break;
+      default:
+        escaped += c;
+    }
+  }
+  escaped += "\"";
+  return escaped;
+}
+
+static std::string json_number(const double& value) {
+  std::ostringstream ss;
+  ss.precision(9);
+  ss << value;
+  return ss.str();
+}
+
+/* Print a benchmark result as a JSON object in a single line */
+static std::string bench_result_to_json(const BenchResult& result) {
+  std::string json("{");
+  json += "\"suite\":" + json_string(result.suite);
+  json += ",\"name\":" + json_string(result.name);
+  json += ",\"params\":{";
+  for (size_t iparam = 0; iparam < result.params.size(); ++iparam) {
+    if (0 < iparam) {
+      json += ",";
+    }
+    json += json_string(result.params[iparam].first) + ":" +
+            json_string(result.params[iparam].second);
+  }
+  json += "}";
+  json += ",\"num_items\":" + std::to_string(result.num_items);
+  json += ",\"num_samples\":" + std::to_string(result.samples.size());
+  json += ",\"min_s\":" + json_number(find_min_sample(result.samples));
+  json += ",\"median_s\":" + json_number(find_median_sample(result.samples));
+  json += ",\"mean_s\":" + json_number(find_mean_sample(result.samples));
+  json += ",\"max_s\":" + json_number(find_max_sample(result.samples));
+  json += ",\"samples_s\":[";
+  for (size_t isample = 0; isample < result.samples.size(); ++isample) {
+    if (0 < isample) {
+      json += ",";
+    }
+    json += json_number(result.samples[isample]);
+  }
+  json += "]}";
+  return json;
+}
+
+/************************************************************************
+ * Member functions for class BenchRunner
+ ***********************************************************************/
+BenchRunner::BenchRunner(const size_t& num_warmups, const size_t& num_repeats,
+                         const std::string& filter)
+  : num_warmups_(num_warmups),
+    num_repeats_(std::max(num_repeats, size_t(1))),
+    filter_(filter) {}
+
+size_t BenchRunner::num_repeats() const { return num_repeats_; }
+
+const std::vector<BenchResult>& BenchRunner::results() const {
+  return results_;
+}
+
+bool BenchRunner::is_selected(const std::string& name) const {
+  return filter_.empty() || (std::string::npos != name.find(filter_));
+}
+
+void BenchRunner::run(const std::string& suite, const std::string& name,
+                      const BenchParams& params, const size_t& num_items,
+                      const std::function<void()>& setup,
+                      const std::function<void()>& body) {
+  if (!is_selected(name)) {
+    return;
+  }
+
+  for (size_t iter = 0; iter < num_warmups_; ++iter) {
+    if (setup) {
+      setup();
+    }
+    body();
+  }
+
+  BenchResult result;
+  result.suite = suite;
+  result.name = name;
+  result.params = params;
+  result.num_items = num_items;
+  for (size_t iter = 0; iter < num_repeats_; ++iter) {
+    if (setup) {
+      setup();
+    }
+    double start = bench_now();
+    body();
+    result.samples.push_back(bench_now() - start);
+  }
+  results_.push_back(result);
+
+  VTR_LOG("[bench] %s: median %.6g s over %lu samples\n", name.c_str(),
+          find_median_sample(result.samples), result.samples.size());
+}
+
+void BenchRunner::record(const std::string& suite, const std::string& name,
+                         const BenchParams& params, const size_t& num_items,
+                         const double& runtime) {
+  if (!is_selected(name)) {
+    return;
+  }
+  BenchResult result;
+  result.suite = suite;
+  result.name = name;
+  result.params = params;
+  result.num_items = num_items;
+  result.samples.push_back(runtime);
+  results_.push_back(result);
+
+  VTR_LOG("[bench] %s: %.6g s\n", name.c_str(), runtime);
+}
+
+void BenchRunner::print_summary() const {
+  VTR_LOG("%-48s %12s %12s %12s %14s\n", "Benchmark", "Min (s)", "Median (s)",
+          "Max (s)", "Items/s");
+  for (const BenchResult& result : results_) {
+    double median = find_median_sample(result.samples);
+    double throughput = (0. < median) ? double(result.num_items) / median : 0.;
+    VTR_LOG("%-48s %12.6g %12.6g %12.6g %14.6g\n", result.name.c_str(),
+            find_min_sample(result.samples), median,
+            find_max_sample(result.samples), throughput);
+  }
+}
+
+int BenchRunner::write_json_lines(const std::string& fname,
+                                  const bool& append) const {
+  std::fstream fp;
+  fp.open(fname, std::fstream::out | (append ? std::fstream::app
+                                             : std::fstream::trunc));
+  if (false == valid_file_stream(fp)) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
+  for (const BenchResult& result : results_) {
+    fp << bench_result_to_json(result) << "\n";
+  }
+  fp.close();
+
+  VTR_LOG("Wrote %lu benchmark results to '%s'\n", results_.size(),
+          fname.c_str());
+  return CMD_EXEC_SUCCESS;
+}
+
+/********************************************************************
+ * Public functions
+ *******************************************************************/
+void bench_consume(const size_t& value) {
+  static volatile size_t sink = 0;
+  sink = sink + value;
+}
+
+double bench_now() {
+  return std::chrono::duration<double>(
+           std::chrono::steady_clock::now().time_since_epoch())
+    .count();
+}
+
+} /* End namespace openfpga*/
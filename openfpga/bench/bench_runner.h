@@ -0,0 +1,85 @@
+#ifndef BENCH_RUNNER_H
+#define BENCH_RUNNER_H
+
+/********************************************************************
+ * Include header files required by the data structure definition
+ *******************************************************************/
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+/* Begin namespace openfpga */
+namespace openfpga {
+
+/* Parameters of a benchmark, e.g., the number of ports or the device size,
+ * which are written along with the results so that runs can be compared */
+typedef std::vector<std::pair<std::string, std::string>> BenchParams;
+
+/********************************************************************
+ * Runtime samples of a benchmark
+ *******************************************************************/
+struct BenchResult {
+  std::string suite;
+  std::string name;
+  BenchParams params;
+  /* Number of operations in each sample, used to report the throughput */
+  size_t num_items;
+  /* Runtime of each sample in seconds */
+  std::vector<double> samples;
+};
+
+/********************************************************************
+ * A simple runner which times benchmarks and collects the results
+ * - Each benchmark is run for a number of warm-up iterations, which are not
+ *   recorded, and then for a number of timed iterations
+ * - A setup function can be provided to prepare the input data of each
+ *   iteration, which is not timed
+ * - Results are written in JSON lines, i.e., one JSON object per benchmark
+ *   per line, so that results of different runs can be concatenated and
+ *   compared by scripts
+ *******************************************************************/
+class BenchRunner {
+ public: /* Constructor */
+  BenchRunner(const size_t& num_warmups, const size_t& num_repeats,
+              const std::string& filter);
+
+ public: /* Public accessors */
+  size_t num_repeats() const;
+  const std::vector<BenchResult>& results() const;
+  /* A benchmark is selected when its name contains the filter */
+  bool is_selected(const std::string& name) const;
+
+ public: /* Public mutators */
+  void run(const std::string& suite, const std::string& name,
+           const BenchParams& params, const size_t& num_items,
+           const std::function<void()>& setup,
+           const std::function<void()>& body);
+  /* Record a runtime measured outside the runner, e.g., a command which can
+   * only run once in a session */
+  void record(const std::string& suite, const std::string& name,
+              const BenchParams& params, const size_t& num_items,
+              const double& runtime);
+
+ public: /* Writers */
+  void print_summary() const;
+  int write_json_lines(const std::string& fname, const bool& append) const;
+
+ private: /* Internal data */
+  size_t num_warmups_;
+  size_t num_repeats_;
+  std::string filter_;
+  std::vector<BenchResult> results_;
+};
+
+/* Make a value observable, so that the computation of the value is not
+ * optimized out by compilers */
+void bench_consume(const size_t& value);
+
+/* Current time in seconds from a monotonic clock, which is only meaningful
+ * when compared to another time point */
+double bench_now();
+
+} /* End namespace openfpga*/
+
+#endif
@@ -0,0 +1,197 @@
+/********************************************************************
+ * Benchmark harness of OpenFPGA engines
+ * - The micro suite times core data structures and engines on synthetic
+ *   data whose size is controlled by the option '--scale'
+ * - The flow suite times OpenFPGA commands on a given architecture,
+ *   benchmark and device, as well as the engines which require a device
+ * Results are written to a file in JSON lines, so that results of different
+ * runs can be compared by scripts
+ *******************************************************************/
+#include <algorithm>
+#include <cstdlib>
+#include <string>
+#include <utility>
+#include <vector>
+
+/* Headers from vtrutil library */
+#include "vtr_log.h"
+
+/* Headers from openfpgashell library */
+#include "command.h"
+#include "command_context.h"
+#include "command_echo.h"
+#include "command_exit_codes.h"
+#include "command_parser.h"
+
+/* Headers from openfpga bench */
+#include "bench_flow.h"
+#include "bench_micro.h"
+#include "bench_runner.h"
+
+/********************************************************************
+ * Read a positive integer from an option, or return the default value when
+ * the option is not specified. Return 0 when the value is invalid
+ *******************************************************************/
+static size_t read_positive_option(const openfpga::Command& cmd,
+                                   const openfpga::CommandContext& cmd_context,
+                                   const openfpga::CommandOptionId& opt,
+                                   const size_t& default_value) {
+  if (false == cmd_context.option_enable(cmd, opt)) {
+    return default_value;
+  }
+  int value = std::atoi(cmd_context.option_value(cmd, opt).c_str());
+  if (value < 1) {
+    VTR_LOG_ERROR("Invalid value '%d' for option '%s'! Expect a positive "
+                  "number.\n",
+                  value, cmd.option_name(opt).c_str());
+    return 0;
+  }
+  return size_t(value);
+}
+
+/********************************************************************
+ * Main function to start the benchmark harness
+ *******************************************************************/
+int main(int argc, char** argv) {
+  openfpga::Command bench_cmd("openfpga_bench");
+  openfpga::CommandOptionId opt_suite = bench_cmd.add_option(
+    "suite", false,
+    "Benchmark suites to run: micro, flow or all. Default: micro");
+  bench_cmd.set_option_require_value(opt_suite, openfpga::OPT_STRING);
+  openfpga::CommandOptionId opt_filter = bench_cmd.add_option(
+    "filter", false, "Only run benchmarks whose names contain the string");
+  bench_cmd.set_option_require_value(opt_filter, openfpga::OPT_STRING);
+  openfpga::CommandOptionId opt_scale = bench_cmd.add_option(
+    "scale", false,
+    "Number of ports, blocks or LUTs in micro-benchmarks. Default: 1000");
+  bench_cmd.set_option_require_value(opt_scale, openfpga::OPT_INT);
+  openfpga::CommandOptionId opt_repeat = bench_cmd.add_option(
+    "repeat", false, "Number of timed iterations per benchmark. Default: 5");
+  bench_cmd.set_option_require_value(opt_repeat, openfpga::OPT_INT);
+  openfpga::CommandOptionId opt_warmup = bench_cmd.add_option(
+    "warmup", false,
+    "Number of untimed iterations before the timed ones. Default: 1");
+  bench_cmd.set_option_require_value(opt_warmup, openfpga::OPT_INT);
+  openfpga::CommandOptionId opt_output = bench_cmd.add_option(
+    "output", false,
+    "File to write results in JSON lines. Default: openfpga_bench.jsonl");
+  bench_cmd.set_option_require_value(opt_output, openfpga::OPT_STRING);
+  openfpga::CommandOptionId opt_append = bench_cmd.add_option(
+    "append", false, "Append results to the output file instead of "
+                     "overwriting it");
+
+  /* Inputs of the flow suite */
+  openfpga::CommandOptionId opt_vpr_arch = bench_cmd.add_option(
+    "vpr_arch", false, "VPR architecture file of the flow suite");
+  bench_cmd.set_option_require_value(opt_vpr_arch, openfpga::OPT_STRING);
+  openfpga::CommandOptionId opt_openfpga_arch = bench_cmd.add_option(
+    "openfpga_arch", false, "OpenFPGA architecture file of the flow suite");
+  bench_cmd.set_option_require_value(opt_openfpga_arch, openfpga::OPT_STRING);
+  openfpga::CommandOptionId opt_sim_setting = bench_cmd.add_option(
+    "sim_setting", false, "OpenFPGA simulation setting file of the flow suite");
+  bench_cmd.set_option_require_value(opt_sim_setting, openfpga::OPT_STRING);
+  openfpga::CommandOptionId opt_benchmark = bench_cmd.add_option(
+    "benchmark", false, "BLIF netlist to implement in the flow suite");
+  bench_cmd.set_option_require_value(opt_benchmark, openfpga::OPT_STRING);
+  openfpga::CommandOptionId opt_activity = bench_cmd.add_option(
+    "activity_file", false, "Activity file of the BLIF netlist");
+  bench_cmd.set_option_require_value(opt_activity, openfpga::OPT_STRING);
+  openfpga::CommandOptionId opt_device = bench_cmd.add_option(
+    "device", false,
+    "Fixed layout in the VPR architecture to use in the flow suite, e.g., "
+    "4x4");
+  bench_cmd.set_option_require_value(opt_device, openfpga::OPT_STRING);
+
+  openfpga::CommandOptionId opt_help =
+    bench_cmd.add_option("help", false, "Help desk");
+  bench_cmd.set_option_short_name(opt_help, "h");
+
+  /* Parse the options, where the command name replaces argv[0] */
+  std::vector<std::string> cmd_opts;
+  cmd_opts.push_back(bench_cmd.name());
+  for (int iarg = 1; iarg < argc; ++iarg) {
+    cmd_opts.push_back(std::string(argv[iarg]));
+  }
+  openfpga::CommandContext cmd_context(bench_cmd);
+  if (false == parse_command(cmd_opts, bench_cmd, cmd_context)) {
+    openfpga::print_command_options(bench_cmd);
+    return openfpga::CMD_EXEC_FATAL_ERROR;
+  }
+  if (true == cmd_context.option_enable(bench_cmd, opt_help)) {
+    openfpga::print_command_options(bench_cmd);
+    return openfpga::CMD_EXEC_SUCCESS;
+  }
+
+  std::string suite("micro");
+  if (true == cmd_context.option_enable(bench_cmd, opt_suite)) {
+    suite = cmd_context.option_value(bench_cmd, opt_suite);
+  }
+  if ((suite != "micro") && (suite != "flow") && (suite != "all")) {
+    VTR_LOG_ERROR("Invalid suite '%s'! Expect [micro|flow|all].\n",
+                  suite.c_str());
+    return openfpga::CMD_EXEC_FATAL_ERROR;
+  }
+
+  size_t scale = read_positive_option(bench_cmd, cmd_context, opt_scale, 1000);
+  size_t num_repeats =
+    read_positive_option(bench_cmd, cmd_context, opt_repeat, 5);
+  /* Zero warm-up iteration is allowed */
+  size_t num_warmups = 1;
+  if (true == cmd_context.option_enable(bench_cmd, opt_warmup)) {
+    num_warmups = std::max(
+      0, std::atoi(cmd_context.option_value(bench_cmd, opt_warmup).c_str()));
+  }
+  if ((0 == scale) || (0 == num_repeats)) {
+    return openfpga::CMD_EXEC_FATAL_ERROR;
+  }
+
+  std::string filter;
+  if (true == cmd_context.option_enable(bench_cmd, opt_filter)) {
+    filter = cmd_context.option_value(bench_cmd, opt_filter);
+  }
+  std::string output_fname("openfpga_bench.jsonl");
+  if (true == cmd_context.option_enable(bench_cmd, opt_output)) {
+    output_fname = cmd_context.option_value(bench_cmd, opt_output);
+  }
+
+  openfpga::BenchRunner runner(num_warmups, num_repeats, filter);
+
+  if ((suite == "micro") || (suite == "all")) {
+    openfpga::run_module_manager_benchmarks(runner, scale);
+    openfpga::run_bitstream_manager_benchmarks(runner, scale);
+  }
+
+  if ((suite == "flow") || (suite == "all")) {
+    openfpga::BenchFlowSetting setting;
+    std::vector<std::pair<openfpga::CommandOptionId, std::string*>>
+      required_opts = {{opt_vpr_arch, &setting.vpr_arch},
+                       {opt_openfpga_arch, &setting.openfpga_arch},
+                       {opt_benchmark, &setting.benchmark},
+                       {opt_device, &setting.device}};
+    for (const auto& required_opt : required_opts) {
+      if (false == cmd_context.option_enable(bench_cmd, required_opt.first)) {
+        VTR_LOG_ERROR("Option '--%s' is required by the flow suite!\n",
+                      bench_cmd.option_name(required_opt.first).c_str());
+        return openfpga::CMD_EXEC_FATAL_ERROR;
+      }
+      *required_opt.second =
+        cmd_context.option_value(bench_cmd, required_opt.first);
+    }
+    if (true == cmd_context.option_enable(bench_cmd, opt_sim_setting)) {
+      setting.sim_setting =
+        cmd_context.option_value(bench_cmd, opt_sim_setting);
+    }
+    if (true == cmd_context.option_enable(bench_cmd, opt_activity)) {
+      setting.activity = cmd_context.option_value(bench_cmd, opt_activity);
+    }
+
+    if (openfpga::CMD_EXEC_SUCCESS !=
+        openfpga::run_flow_benchmarks(runner, setting, scale)) {
+      return openfpga::CMD_EXEC_FATAL_ERROR;
+    }
+  }
+
+  runner.print_summary();
+  return runner.write_json_lines(
+    output_fname, cmd_context.option_enable(bench_cmd, opt_append));
+}
@@ -3,6 +3,7 @@
  ***********************************************************************/
 #include "device_rr_gsb.h"
 
+#include "openfpga_side_manager.h"
 #include "rr_gsb_utils.h"
 #include "vtr_assert.h"
 #include "vtr_log.h"
@@ -235,6 +236,35 @@ const RRGSB& DeviceRRGSB::get_sb_unique_module(
   return get_sb_unique_module(get_sb_unique_module_index(coordinate));
 }
 
+/* The internal data of a GSB is defined by VPR, whose node lists are
+ * estimated by the number of nodes on each side */
+void DeviceRRGSB::memory_usage(MemoryUsage& usage) const {
+  usage.add_container(rr_gsb_);
+  for (const std::vector<RRGSB>& rr_gsb_column : rr_gsb_) {
+    for (const RRGSB& rr_gsb : rr_gsb_column) {
+      size_t num_nodes = 0;
+      for (size_t side = 0; side < rr_gsb.get_num_sides(); ++side) {
+        SideManager side_manager(side);
+        num_nodes += rr_gsb.get_chan_width(side_manager.get_side()) +
+                     rr_gsb.get_num_ipin_nodes(side_manager.get_side()) +
+                     rr_gsb.get_num_opin_nodes(side_manager.get_side());
+      }
+      usage.add_bytes(MemoryUsage::CONTAINER, num_nodes * sizeof(RRNodeId));
+    }
+  }
+
+  usage.add_container(gsb_unique_module_);
+  usage.add_container(sb_unique_module_);
+  usage.add_container(cbx_unique_module_);
+  usage.add_container(cby_unique_module_);
+
+  /* Mappings from GSBs to their unique mirrors */
+  usage.add_lookup(gsb_unique_module_id_);
+  usage.add_lookup(sb_unique_module_id_);
+  usage.add_lookup(cbx_unique_module_id_);
+  usage.add_lookup(cby_unique_module_id_);
+}
+
 /************************************************************************
  * Public mutators
  ***********************************************************************/
@@ -7,6 +7,9 @@
 /* Header files from vtrutil library */
 #include "vtr_geometry.h"
 
+/* Header files from openfpgautil library */
+#include "openfpga_memory_usage.h"
+
 /* Header files from vpr library */
 #include "rr_graph_view.h"
 #include "rr_gsb.h"
@@ -87,6 +90,8 @@ class DeviceRRGSB {
    * coordinate. Note: Do NOT use sb coordinate!!! */
   size_t get_cb_unique_module_index(const t_rr_type& cb_type,
                                     const vtr::Point<size_t>& coordinate) const;
+  /* Accumulate the heap memory used by the GSBs and their unique mirrors */
+  void memory_usage(MemoryUsage& usage) const;
 
  public: /* Mutators */
   bool is_compressed() const;
@@ -5,6 +5,7 @@
 
 #include "build_top_module_utils.h"
 #include "command_exit_codes.h"
+#include "openfpga_bin_stream.h"
 #include "vtr_assert.h"
 #include "vtr_log.h"
 
@@ -319,6 +320,23 @@ std::vector<FabricTileId> FabricTile::unique_tiles() const {
 
 bool FabricTile::empty() const { return ids_.empty(); }
 
+void FabricTile::memory_usage(MemoryUsage& usage) const {
+  usage.add_container(ids_);
+  usage.add_container(coords_);
+  usage.add_container(pb_coords_);
+  usage.add_container(pb_gsb_coords_);
+  usage.add_container(cbx_coords_);
+  usage.add_container(cby_coords_);
+  usage.add_container(sb_coords_);
+  usage.add_lookup(pb_coord2id_lookup_);
+  usage.add_lookup(cbx_coord2id_lookup_);
+  usage.add_lookup(cby_coord2id_lookup_);
+  usage.add_lookup(sb_coord2id_lookup_);
+  usage.add_lookup(tile_coord2id_lookup_);
+  usage.add_lookup(tile_coord2unique_tile_ids_);
+  usage.add_container(unique_tile_ids_);
+}
+
 FabricTileId FabricTile::create_tile(const vtr::Point<size_t>& coord) {
   FabricTileId tile_id = FabricTileId(ids_.size());
   ids_.push_back(tile_id);
@@ -619,6 +637,41 @@ void FabricTile::clear() {
   unique_tile_ids_.clear();
 }
 
+void FabricTile::write_to_bin_stream(std::ostream& fp) const {
+  write_bin(fp, ids_);
+  write_bin(fp, coords_);
+  write_bin(fp, pb_coords_);
+  write_bin(fp, pb_gsb_coords_);
+  write_bin(fp, cbx_coords_);
+  write_bin(fp, cby_coords_);
+  write_bin(fp, sb_coords_);
+  write_bin(fp, pb_coord2id_lookup_);
+  write_bin(fp, cbx_coord2id_lookup_);
+  write_bin(fp, cby_coord2id_lookup_);
+  write_bin(fp, sb_coord2id_lookup_);
+  write_bin(fp, tile_coord2id_lookup_);
+  write_bin(fp, tile_coord2unique_tile_ids_);
+  write_bin(fp, unique_tile_ids_);
+}
+
+void FabricTile::read_from_bin_stream(std::istream& fp) {
+  clear();
+  read_bin(fp, ids_);
+  read_bin(fp, coords_);
+  read_bin(fp, pb_coords_);
+  read_bin(fp, pb_gsb_coords_);
+  read_bin(fp, cbx_coords_);
+  read_bin(fp, cby_coords_);
+  read_bin(fp, sb_coords_);
+  read_bin(fp, pb_coord2id_lookup_);
+  read_bin(fp, cbx_coord2id_lookup_);
+  read_bin(fp, cby_coord2id_lookup_);
+  read_bin(fp, sb_coord2id_lookup_);
+  read_bin(fp, tile_coord2id_lookup_);
+  read_bin(fp, tile_coord2unique_tile_ids_);
+  read_bin(fp, unique_tile_ids_);
+}
+
 bool FabricTile::valid_tile_id(const FabricTileId& tile_id) const {
   return (size_t(tile_id) < ids_.size()) && (tile_id == ids_[tile_id]);
 }
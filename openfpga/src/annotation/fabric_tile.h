@@ -4,11 +4,14 @@
 /********************************************************************
  * Include header files required by the data structure definition
  *******************************************************************/
+#include <istream>
+#include <ostream>
 #include <vector>
 
 #include "device_grid.h"
 #include "device_rr_gsb.h"
 #include "fabric_tile_fwd.h"
+#include "openfpga_memory_usage.h"
 #include "vtr_geometry.h"
 #include "vtr_vector.h"
 
@@ -109,6 +112,8 @@ class FabricTile {
                   const vtr::Point<size_t>& coord) const;
   /** @brief Identify if the fabric tile is empty: no tiles are defined */
   bool empty() const;
+  /** @brief Accumulate the heap memory used by the tiles */
+  void memory_usage(MemoryUsage& usage) const;
 
  public: /* Mutators */
   FabricTileId create_tile(const vtr::Point<size_t>& coord);
@@ -136,6 +141,13 @@ class FabricTile {
   int build_unique_tiles(const DeviceGrid& grids,
                          const DeviceRRGSB& device_rr_gsb, const bool& verbose);
 
+ public: /* Serializers */
+  /** @brief Write all the internal data to a binary stream */
+  void write_to_bin_stream(std::ostream& fp) const;
+  /** @brief Restore all the internal data from a binary stream. Any existing
+   * data will be overwritten */
+  void read_from_bin_stream(std::istream& fp);
+
  public: /* Validators */
   bool valid_tile_id(const FabricTileId& tile_id) const;
 
@@ -0,0 +1,133 @@
+#ifndef POINTER_INDEX_TABLE_H
+#define POINTER_INDEX_TABLE_H
+
+/********************************************************************
+ * Include header files required by the data structure definition
+ *******************************************************************/
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/* Headers from openfpgautil library */
+#include "openfpga_memory_usage.h"
+
+/* Begin namespace openfpga */
+namespace openfpga {
+
+/********************************************************************
+ * A look-up table which assigns a dense index (0, 1, 2, ...) to each
+ * pointer being added, so that data bound to the pointers can be stored
+ * in flat vectors.
+ *
+ * The table uses open addressing with linear probing, where the keys and
+ * indices are stored in contiguous arrays. This is much more cache-friendly
+ * than a std::map on pointers, which is the purpose of the table.
+ *
+ * Note:
+ * - Pointers cannot be removed from the table, only cleared all at once
+ * - A nullptr cannot be added to the table
+ *******************************************************************/
+template <class T>
+class PointerIndexTable {
+ public: /* Constants */
+  static constexpr size_t INVALID_INDEX = size_t(-1);
+
+ public: /* Constructor */
+  PointerIndexTable() { clear(); }
+
+ public: /* Public accessors */
+  size_t size() const { return num_indices_; }
+
+  /* Return the index of a pointer, or INVALID_INDEX if not found */
+  size_t find(const T* ptr) const {
+    if (nullptr == ptr) {
+      return INVALID_INDEX;
+    }
+    for (size_t slot = hash_slot(ptr);; slot = (slot + 1) & slot_mask_) {
+      if (keys_[slot] == ptr) {
+        return indices_[slot];
+      }
+      if (nullptr == keys_[slot]) {
+        return INVALID_INDEX;
+      }
+    }
+  }
+
+  void memory_usage(MemoryUsage& usage) const {
+    usage.add_lookup(keys_);
+    usage.add_lookup(indices_);
+  }
+
+ public: /* Public mutators */
+  void clear() {
+    keys_.assign(MIN_NUM_SLOTS, nullptr);
+    indices_.assign(MIN_NUM_SLOTS, INVALID_INDEX);
+    slot_mask_ = MIN_NUM_SLOTS - 1;
+    num_indices_ = 0;
+  }
+
+  /* Add a pointer and return its index. If the pointer has been added,
+   * return the existing index */
+  size_t insert(const T* ptr) {
+    if (nullptr == ptr) {
+      return INVALID_INDEX;
+    }
+    size_t index = find(ptr);
+    if (INVALID_INDEX != index) {
+      return index;
+    }
+    /* Keep the load factor below 1/2 so that probing stays short */
+    if (2 * (num_indices_ + 1) > keys_.size()) {
+      rehash(2 * keys_.size());
+    }
+    size_t slot = hash_slot(ptr);
+    while (nullptr != keys_[slot]) {
+      slot = (slot + 1) & slot_mask_;
+    }
+    keys_[slot] = ptr;
+    indices_[slot] = num_indices_;
+    return num_indices_++;
+  }
+
+ private: /* Internal functions */
+  size_t hash_slot(const T* ptr) const {
+    /* Fibonacci hashing: the low bits of a pointer are always zero due to
+     * alignment, while the multiplication spreads the high bits */
+    uint64_t key = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(ptr));
+    return static_cast<size_t>((key * 0x9E3779B97F4A7C15ULL) >> 32) &
+           slot_mask_;
+  }
+
+  void rehash(const size_t& num_slots) {
+    std::vector<const T*> old_keys;
+    std::vector<size_t> old_indices;
+    old_keys.swap(keys_);
+    old_indices.swap(indices_);
+    keys_.assign(num_slots, nullptr);
+    indices_.assign(num_slots, INVALID_INDEX);
+    slot_mask_ = num_slots - 1;
+    for (size_t islot = 0; islot < old_keys.size(); ++islot) {
+      if (nullptr == old_keys[islot]) {
+        continue;
+      }
+      size_t slot = hash_slot(old_keys[islot]);
+      while (nullptr != keys_[slot]) {
+        slot = (slot + 1) & slot_mask_;
+      }
+      keys_[slot] = old_keys[islot];
+      indices_[slot] = old_indices[islot];
+    }
+  }
+
+ private: /* Internal data */
+  /* The number of slots must be a power of 2 */
+  static constexpr size_t MIN_NUM_SLOTS = 16;
+  std::vector<const T*> keys_;
+  std::vector<size_t> indices_;
+  size_t slot_mask_;
+  size_t num_indices_;
+};
+
+} /* End namespace openfpga*/
+
+#endif
@@ -118,6 +118,18 @@ ClockTreePinId VprBitstreamAnnotation::clock_tap_routing_pin(
   return ClockTreePinId::INVALID();
 }
 
+void VprBitstreamAnnotation::memory_usage(MemoryUsage& usage) const {
+  usage.add_lookup(bitstream_sources_);
+  usage.add_lookup(bitstream_contents_);
+  usage.add_lookup(bitstream_offsets_);
+  usage.add_lookup(default_mode_bits_);
+  usage.add_lookup(mode_select_bitstream_sources_);
+  usage.add_lookup(mode_select_bitstream_contents_);
+  usage.add_lookup(mode_select_bitstream_offsets_);
+  usage.add_lookup(interconnect_default_path_ids_);
+  usage.add_lookup(clock_tap_routing_pins_);
+}
+
 /************************************************************************
  * Public mutators
  ***********************************************************************/
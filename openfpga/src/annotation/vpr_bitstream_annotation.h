@@ -11,6 +11,9 @@
 #include "clock_network.h"
 #include "vpr_context.h"
 
+/* Header from openfpgautil library */
+#include "openfpga_memory_usage.h"
+
 /* Begin namespace openfpga */
 namespace openfpga {
 
@@ -45,6 +48,7 @@ class VprBitstreamAnnotation {
   size_t pb_type_mode_select_bitstream_offset(t_pb_type* pb_type) const;
   size_t interconnect_default_path_id(t_interconnect* interconnect) const;
   ClockTreePinId clock_tap_routing_pin(const ClockTreeId& tree_id) const;
+  void memory_usage(MemoryUsage& usage) const;
 
  public: /* Public mutators */
   void set_pb_type_bitstream_source(
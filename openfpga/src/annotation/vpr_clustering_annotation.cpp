@@ -20,17 +20,16 @@ VprClusteringAnnotation::VprClusteringAnnotation() { return; }
 bool VprClusteringAnnotation::is_net_renamed(const ClusterBlockId& block_id,
                                              const int& pin_index) const {
   /* Ensure that the block_id is in the list */
-  if (net_names_.end() == net_names_.find(block_id)) {
+  if (size_t(block_id) >= net_names_.size()) {
     return false;
   }
-  return (net_names_.at(block_id).end() !=
-          net_names_.at(block_id).find(pin_index));
+  return (net_names_[block_id].end() != net_names_[block_id].find(pin_index));
 }
 
 ClusterNetId VprClusteringAnnotation::net(const ClusterBlockId& block_id,
                                           const int& pin_index) const {
   VTR_ASSERT(true == is_net_renamed(block_id, pin_index));
-  return net_names_.at(block_id).at(pin_index);
+  return net_names_[block_id].at(pin_index);
 }
 
 bool VprClusteringAnnotation::is_truth_table_adapted(t_pb* pb) const {
@@ -43,13 +42,19 @@ AtomNetlist::TruthTable VprClusteringAnnotation::truth_table(t_pb* pb) const {
   return block_truth_tables_.at(pb);
 }
 
-PhysicalPb VprClusteringAnnotation::physical_pb(
+const PhysicalPb& VprClusteringAnnotation::physical_pb(
   const ClusterBlockId& block_id) const {
-  if (physical_pbs_.end() == physical_pbs_.find(block_id)) {
-    return PhysicalPb();
+  if (size_t(block_id) >= physical_pbs_.size()) {
+    return empty_physical_pb_;
   }
 
-  return physical_pbs_.at(block_id);
+  return physical_pbs_[block_id];
+}
+
+void VprClusteringAnnotation::memory_usage(MemoryUsage& usage) const {
+  usage.add_container(net_names_);
+  usage.add_container(block_truth_tables_);
+  usage.add_container(physical_pbs_);
 }
 
 /************************************************************************
@@ -58,10 +63,14 @@ PhysicalPb VprClusteringAnnotation::physical_pb(
 void VprClusteringAnnotation::rename_net(const ClusterBlockId& block_id,
                                          const int& pin_index,
                                          const ClusterNetId& net_id) {
+  VTR_ASSERT(ClusterBlockId::INVALID() != block_id);
+  /* Note that the storage should be reserved before renaming nets in parallel
+   */
+  if (size_t(block_id) >= net_names_.size()) {
+    net_names_.resize(size_t(block_id) + 1);
+  }
   /* Warn any override attempt */
-  if ((net_names_.end() != net_names_.find(block_id)) &&
-      (net_names_.at(block_id).end() !=
-       net_names_.at(block_id).find(pin_index))) {
+  if (net_names_[block_id].end() != net_names_[block_id].find(pin_index)) {
     VTR_LOG_WARN(
       "Override the net '%ld' for block '%ld' pin '%d' with in clustering "
       "context annotation!\n",
@@ -86,8 +95,13 @@ void VprClusteringAnnotation::adapt_truth_table(
 
 void VprClusteringAnnotation::add_physical_pb(const ClusterBlockId& block_id,
                                               const PhysicalPb& physical_pb) {
+  VTR_ASSERT(ClusterBlockId::INVALID() != block_id);
+  if (size_t(block_id) >= physical_pbs_.size()) {
+    physical_pbs_.resize(size_t(block_id) + 1);
+  }
+
   /* Warn any override attempt */
-  if (physical_pbs_.end() != physical_pbs_.find(block_id)) {
+  if (false == physical_pbs_[block_id].empty()) {
     VTR_LOG_WARN(
       "Override the physical pb for clustered block %lu in clustering context "
       "annotation!\n",
@@ -99,9 +113,23 @@ void VprClusteringAnnotation::add_physical_pb(const ClusterBlockId& block_id,
 
 PhysicalPb& VprClusteringAnnotation::mutable_physical_pb(
   const ClusterBlockId& block_id) {
-  VTR_ASSERT(physical_pbs_.end() != physical_pbs_.find(block_id));
+  VTR_ASSERT(size_t(block_id) < physical_pbs_.size());
+  VTR_ASSERT(false == physical_pbs_[block_id].empty());
 
-  return physical_pbs_.at(block_id);
+  return physical_pbs_[block_id];
+}
+
+void VprClusteringAnnotation::reserve_net_remapping(const size_t& num_blocks) {
+  if (num_blocks > net_names_.size()) {
+    net_names_.resize(num_blocks);
+  }
+}
+
+void VprClusteringAnnotation::adapt_truth_tables(
+  const std::vector<std::pair<t_pb*, AtomNetlist::TruthTable>>& pb_tts) {
+  for (const auto& pb_tt : pb_tts) {
+    adapt_truth_table(pb_tt.first, pb_tt.second);
+  }
 }
 
 void VprClusteringAnnotation::clear_net_remapping() { net_names_.clear(); }
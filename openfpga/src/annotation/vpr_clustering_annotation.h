@@ -5,6 +5,11 @@
  * Include header files required by the data structure definition
  *******************************************************************/
 #include <map>
+#include <utility>
+#include <vector>
+
+/* Header from vtrutil library */
+#include "vtr_vector.h"
 
 /* Header from vpr library */
 #include "clustered_netlist.h"
@@ -37,7 +42,8 @@ class VprClusteringAnnotation {
   ClusterNetId net(const ClusterBlockId& block_id, const int& pin_index) const;
   bool is_truth_table_adapted(t_pb* pb) const;
   AtomNetlist::TruthTable truth_table(t_pb* pb) const;
-  PhysicalPb physical_pb(const ClusterBlockId& block_id) const;
+  const PhysicalPb& physical_pb(const ClusterBlockId& block_id) const;
+  void memory_usage(MemoryUsage& usage) const;
 
  public: /* Public mutators */
   void rename_net(const ClusterBlockId& block_id, const int& pin_index,
@@ -46,17 +52,28 @@ class VprClusteringAnnotation {
   void add_physical_pb(const ClusterBlockId& block_id,
                        const PhysicalPb& physical_pb);
   PhysicalPb& mutable_physical_pb(const ClusterBlockId& block_id);
+  /* Allocate the net remapping storage for all the clustered blocks, so that
+   * nets of different blocks can be renamed by parallel tasks */
+  void reserve_net_remapping(const size_t& num_blocks);
+  /* Adapt the truth tables of a number of pbs, which are usually collected by
+   * parallel tasks */
+  void adapt_truth_tables(
+    const std::vector<std::pair<t_pb*, AtomNetlist::TruthTable>>& pb_tts);
 
  public: /* Clean-up */
   void clear_net_remapping();
 
  private: /* Internal data */
   /* Pair a regular pb_type to its physical pb_type */
-  std::map<ClusterBlockId, std::map<int, ClusterNetId>> net_names_;
+  /* Renamed nets of each clustered block, indexed by the dense block ids */
+  vtr::vector<ClusterBlockId, std::map<int, ClusterNetId>> net_names_;
   std::map<t_pb*, AtomNetlist::TruthTable> block_truth_tables_;
 
-  /* Link clustered blocks to physical pb (mapping results) */
-  std::map<ClusterBlockId, PhysicalPb> physical_pbs_;
+  /* Link clustered blocks to physical pb (mapping results)
+   * Clustered block ids are dense, so physical pbs are indexed by the ids
+   * directly. A block without mapping results has an empty physical pb */
+  vtr::vector<ClusterBlockId, PhysicalPb> physical_pbs_;
+  PhysicalPb empty_physical_pb_;
 };
 
 } /* End namespace openfpga*/
@@ -14,12 +14,17 @@ namespace openfpga {
 /************************************************************************
  * Constructors
  ***********************************************************************/
-VprDeviceAnnotation::VprDeviceAnnotation() { return; }
+VprDeviceAnnotation::VprDeviceAnnotation() { finalized_ = false; }
 
 /************************************************************************
  * Public accessors
  ***********************************************************************/
 bool VprDeviceAnnotation::is_physical_pb_type(t_pb_type* pb_type) const {
+  if (finalized_) {
+    size_t index = pb_type_indices_.find(pb_type);
+    return PointerIndexTable<t_pb_type>::INVALID_INDEX != index &&
+           pb_type == flat_physical_pb_types_[index];
+  }
   /* Ensure that the pb_type is in the list */
   std::map<t_pb_type*, t_pb_type*>::const_iterator it =
     physical_pb_types_.find(pb_type);
@@ -32,6 +37,13 @@ bool VprDeviceAnnotation::is_physical_pb_type(t_pb_type* pb_type) const {
 }
 
 t_mode* VprDeviceAnnotation::physical_mode(t_pb_type* pb_type) const {
+  if (finalized_) {
+    size_t index = pb_type_indices_.find(pb_type);
+    if (PointerIndexTable<t_pb_type>::INVALID_INDEX == index) {
+      return nullptr;
+    }
+    return flat_physical_pb_modes_[index];
+  }
   /* Ensure that the pb_type is in the list */
   std::map<t_pb_type*, t_mode*>::const_iterator it =
     physical_pb_modes_.find(pb_type);
@@ -42,6 +54,13 @@ t_mode* VprDeviceAnnotation::physical_mode(t_pb_type* pb_type) const {
 }
 
 t_pb_type* VprDeviceAnnotation::physical_pb_type(t_pb_type* pb_type) const {
+  if (finalized_) {
+    size_t index = pb_type_indices_.find(pb_type);
+    if (PointerIndexTable<t_pb_type>::INVALID_INDEX == index) {
+      return nullptr;
+    }
+    return flat_physical_pb_types_[index];
+  }
   /* Ensure that the pb_type is in the list */
   std::map<t_pb_type*, t_pb_type*>::const_iterator it =
     physical_pb_types_.find(pb_type);
@@ -83,6 +102,13 @@ BasicPort VprDeviceAnnotation::physical_pb_port_range(
 
 CircuitModelId VprDeviceAnnotation::pb_type_circuit_model(
   t_pb_type* physical_pb_type) const {
+  if (finalized_) {
+    size_t index = pb_type_indices_.find(physical_pb_type);
+    if (PointerIndexTable<t_pb_type>::INVALID_INDEX == index) {
+      return CircuitModelId::INVALID();
+    }
+    return flat_pb_type_circuit_models_[index];
+  }
   /* Ensure that the pb_type is in the list */
   std::map<t_pb_type*, CircuitModelId>::const_iterator it =
     pb_type_circuit_models_.find(physical_pb_type);
@@ -118,6 +144,13 @@ e_interconnect VprDeviceAnnotation::interconnect_physical_type(
 }
 
 CircuitPortId VprDeviceAnnotation::pb_circuit_port(t_port* pb_port) const {
+  if (finalized_) {
+    size_t index = pb_port_indices_.find(pb_port);
+    if (PointerIndexTable<t_port>::INVALID_INDEX == index) {
+      return CircuitPortId::INVALID();
+    }
+    return flat_pb_circuit_ports_[index];
+  }
   /* Ensure that the pb_type is in the list */
   std::map<t_port*, CircuitPortId>::const_iterator it =
     pb_circuit_ports_.find(pb_port);
@@ -151,6 +184,13 @@ std::string VprDeviceAnnotation::pb_type_mode_bits_to_string(
 
 PbGraphNodeId VprDeviceAnnotation::pb_graph_node_unique_index(
   t_pb_graph_node* pb_graph_node) const {
+  if (finalized_) {
+    size_t index = pb_graph_node_indices_.find(pb_graph_node);
+    if (PointerIndexTable<t_pb_graph_node>::INVALID_INDEX == index) {
+      return PbGraphNodeId::INVALID();
+    }
+    return flat_pb_graph_node_unique_indices_[index];
+  }
   /* Ensure that the pb_type is in the list */
   std::map<t_pb_type*, std::vector<t_pb_graph_node*>>::const_iterator it =
     pb_graph_node_unique_index_.find(pb_graph_node->pb_type);
@@ -197,6 +237,13 @@ t_pb_graph_node* VprDeviceAnnotation::pb_graph_node(
 
 t_pb_graph_node* VprDeviceAnnotation::physical_pb_graph_node(
   t_pb_graph_node* pb_graph_node) const {
+  if (finalized_) {
+    size_t index = pb_graph_node_indices_.find(pb_graph_node);
+    if (PointerIndexTable<t_pb_graph_node>::INVALID_INDEX == index) {
+      return nullptr;
+    }
+    return flat_physical_pb_graph_nodes_[index];
+  }
   /* Ensure that the pb_graph_node is in the list */
   std::map<t_pb_graph_node*, t_pb_graph_node*>::const_iterator it =
     physical_pb_graph_nodes_.find(pb_graph_node);
@@ -320,6 +367,13 @@ int VprDeviceAnnotation::physical_pb_port_offset(
 
 t_pb_graph_pin* VprDeviceAnnotation::physical_pb_graph_pin(
   const t_pb_graph_pin* pb_graph_pin) const {
+  if (finalized_) {
+    size_t index = pb_graph_pin_indices_.find(pb_graph_pin);
+    if (PointerIndexTable<t_pb_graph_pin>::INVALID_INDEX == index) {
+      return nullptr;
+    }
+    return flat_physical_pb_graph_pins_[index];
+  }
   /* Ensure that the pb_type is in the list */
   std::map<const t_pb_graph_pin*, t_pb_graph_pin*>::const_iterator it =
     physical_pb_graph_pins_.find(pb_graph_pin);
@@ -360,13 +414,15 @@ ArchDirectId VprDeviceAnnotation::direct_annotation(
   return direct_annotations_.at(direct);
 }
 
-LbRRGraph VprDeviceAnnotation::physical_lb_rr_graph(
+const LbRRGraph& VprDeviceAnnotation::physical_lb_rr_graph(
   t_pb_graph_node* pb_graph_head) const {
-  /* Ensure that the rr_switch is in the list */
-  if (0 == physical_lb_rr_graphs_.count(pb_graph_head)) {
-    return LbRRGraph();
+  /* There are only a few graphs (one per logical tile), so a map is good
+   * enough. Return a reference as copying a graph is expensive */
+  auto it = physical_lb_rr_graphs_.find(pb_graph_head);
+  if (it == physical_lb_rr_graphs_.end()) {
+    return empty_lb_rr_graph_;
   }
-  return physical_lb_rr_graphs_.at(pb_graph_head);
+  return it->second;
 }
 
 BasicPort VprDeviceAnnotation::physical_tile_pin_port_info(
@@ -455,9 +511,133 @@ int VprDeviceAnnotation::physical_tile_z_to_start_pin_index(
   return pin_search_result->second;
 }
 
+void VprDeviceAnnotation::memory_usage(MemoryUsage& usage) const {
+  usage.add_lookup(physical_pb_types_);
+  usage.add_lookup(physical_pb_type_index_factors_);
+  usage.add_lookup(physical_pb_type_index_offsets_);
+  usage.add_lookup(physical_pb_modes_);
+  usage.add_lookup(pb_type_circuit_models_);
+  usage.add_lookup(interconnect_circuit_models_);
+  usage.add_lookup(interconnect_physical_types_);
+  usage.add_lookup(pb_type_mode_bits_);
+  usage.add_lookup(physical_pb_ports_);
+  usage.add_lookup(physical_pb_pin_initial_offsets_);
+  usage.add_lookup(physical_pb_pin_rotate_offsets_);
+  usage.add_lookup(physical_pb_port_rotate_offsets_);
+  usage.add_lookup(physical_pb_port_offsets_);
+  usage.add_lookup(physical_pb_pin_offsets_);
+  usage.add_lookup(physical_pb_port_ranges_);
+  usage.add_lookup(pb_circuit_ports_);
+  usage.add_lookup(pb_graph_node_unique_index_);
+  usage.add_lookup(physical_pb_graph_nodes_);
+  usage.add_lookup(physical_pb_graph_pins_);
+  usage.add_lookup(rr_switch_circuit_models_);
+  usage.add_lookup(rr_segment_circuit_models_);
+  usage.add_lookup(direct_annotations_);
+  usage.add_lookup(physical_tile_pin2port_info_map_);
+  usage.add_lookup(physical_tile_pin_subtile_indices_);
+  usage.add_lookup(physical_tile_z_to_subtile_indices_);
+  usage.add_lookup(physical_tile_z_to_start_pin_indices_);
+
+  /* Graphs are accounted by themselves */
+  usage.add_lookup(physical_lb_rr_graphs_);
+
+  /* Dense indices and flat look-ups */
+  pb_type_indices_.memory_usage(usage);
+  pb_port_indices_.memory_usage(usage);
+  pb_graph_node_indices_.memory_usage(usage);
+  pb_graph_pin_indices_.memory_usage(usage);
+  usage.add_container(flat_physical_pb_types_);
+  usage.add_container(flat_physical_pb_modes_);
+  usage.add_container(flat_pb_type_circuit_models_);
+  usage.add_container(flat_pb_circuit_ports_);
+  usage.add_container(flat_pb_graph_node_unique_indices_);
+  usage.add_container(flat_physical_pb_graph_nodes_);
+  usage.add_container(flat_physical_pb_graph_pins_);
+}
+
 /************************************************************************
  * Public mutators
  ***********************************************************************/
+/************************************************************************
+ * Assign a dense index to each pb_type, port, pb_graph node and pin
+ * which is annotated, and copy the annotations to flat vectors
+ ***********************************************************************/
+void VprDeviceAnnotation::finalize() {
+  pb_type_indices_.clear();
+  for (const auto& kv : physical_pb_types_) {
+    pb_type_indices_.insert(kv.first);
+  }
+  for (const auto& kv : physical_pb_modes_) {
+    pb_type_indices_.insert(kv.first);
+  }
+  for (const auto& kv : pb_type_circuit_models_) {
+    pb_type_indices_.insert(kv.first);
+  }
+  flat_physical_pb_types_.assign(pb_type_indices_.size(), nullptr);
+  flat_physical_pb_modes_.assign(pb_type_indices_.size(), nullptr);
+  flat_pb_type_circuit_models_.assign(pb_type_indices_.size(),
+                                      CircuitModelId::INVALID());
+  for (const auto& kv : physical_pb_types_) {
+    flat_physical_pb_types_[pb_type_indices_.find(kv.first)] = kv.second;
+  }
+  for (const auto& kv : physical_pb_modes_) {
+    flat_physical_pb_modes_[pb_type_indices_.find(kv.first)] = kv.second;
+  }
+  for (const auto& kv : pb_type_circuit_models_) {
+    flat_pb_type_circuit_models_[pb_type_indices_.find(kv.first)] = kv.second;
+  }
+
+  pb_port_indices_.clear();
+  for (const auto& kv : pb_circuit_ports_) {
+    pb_port_indices_.insert(kv.first);
+  }
+  flat_pb_circuit_ports_.assign(pb_port_indices_.size(),
+                                CircuitPortId::INVALID());
+  for (const auto& kv : pb_circuit_ports_) {
+    flat_pb_circuit_ports_[pb_port_indices_.find(kv.first)] = kv.second;
+  }
+
+  pb_graph_node_indices_.clear();
+  for (const auto& kv : pb_graph_node_unique_index_) {
+    for (t_pb_graph_node* node : kv.second) {
+      pb_graph_node_indices_.insert(node);
+    }
+  }
+  for (const auto& kv : physical_pb_graph_nodes_) {
+    pb_graph_node_indices_.insert(kv.first);
+  }
+  flat_pb_graph_node_unique_indices_.assign(pb_graph_node_indices_.size(),
+                                            PbGraphNodeId::INVALID());
+  flat_physical_pb_graph_nodes_.assign(pb_graph_node_indices_.size(), nullptr);
+  for (const auto& kv : pb_graph_node_unique_index_) {
+    for (size_t inode = 0; inode < kv.second.size(); ++inode) {
+      /* Keep the first index if a node is added more than once */
+      PbGraphNodeId& unique_index = flat_pb_graph_node_unique_indices_
+        [pb_graph_node_indices_.find(kv.second[inode])];
+      if (!unique_index) {
+        unique_index = PbGraphNodeId(inode);
+      }
+    }
+  }
+  for (const auto& kv : physical_pb_graph_nodes_) {
+    flat_physical_pb_graph_nodes_[pb_graph_node_indices_.find(kv.first)] =
+      kv.second;
+  }
+
+  pb_graph_pin_indices_.clear();
+  for (const auto& kv : physical_pb_graph_pins_) {
+    pb_graph_pin_indices_.insert(kv.first);
+  }
+  flat_physical_pb_graph_pins_.assign(pb_graph_pin_indices_.size(), nullptr);
+  for (const auto& kv : physical_pb_graph_pins_) {
+    flat_physical_pb_graph_pins_[pb_graph_pin_indices_.find(kv.first)] =
+      kv.second;
+  }
+
+  finalized_ = true;
+}
+
 void VprDeviceAnnotation::add_pb_type_physical_mode(t_pb_type* pb_type,
                                                     t_mode* physical_mode) {
   /* Warn any override attempt */
@@ -470,6 +650,7 @@ void VprDeviceAnnotation::add_pb_type_physical_mode(t_pb_type* pb_type,
       pb_type->name, physical_mode->name);
   }
 
+  finalized_ = false;
   physical_pb_modes_[pb_type] = physical_mode;
 }
 
@@ -485,6 +666,7 @@ void VprDeviceAnnotation::add_physical_pb_type(t_pb_type* operating_pb_type,
       operating_pb_type->name, physical_pb_type->name);
   }
 
+  finalized_ = false;
   physical_pb_types_[operating_pb_type] = physical_pb_type;
 }
 
@@ -525,6 +707,7 @@ void VprDeviceAnnotation::add_pb_type_circuit_model(
                  physical_pb_type->name);
   }
 
+  finalized_ = false;
   pb_type_circuit_models_[physical_pb_type] = circuit_model;
 }
 
@@ -564,6 +747,7 @@ void VprDeviceAnnotation::add_pb_circuit_port(
                  pb_port->name);
   }
 
+  finalized_ = false;
   pb_circuit_ports_[pb_port] = circuit_port;
 }
 
@@ -583,6 +767,7 @@ void VprDeviceAnnotation::add_pb_type_mode_bits(
 
 void VprDeviceAnnotation::add_pb_graph_node_unique_index(
   t_pb_graph_node* pb_graph_node) {
+  finalized_ = false;
   pb_graph_node_unique_index_[pb_graph_node->pb_type].push_back(pb_graph_node);
 }
 
@@ -602,6 +787,7 @@ void VprDeviceAnnotation::add_physical_pb_graph_node(
       physical_pb_graph_node->placement_index);
   }
 
+  finalized_ = false;
   physical_pb_graph_nodes_[operating_pb_graph_node] = physical_pb_graph_node;
 }
 
@@ -711,6 +897,7 @@ void VprDeviceAnnotation::add_physical_pb_graph_pin(
       operating_pb_graph_pin->port->name, physical_pb_graph_pin->port->name);
   }
 
+  finalized_ = false;
   physical_pb_graph_pins_[operating_pb_graph_pin] = physical_pb_graph_pin;
 
   /* Update the accumulated offsets for the operating port
@@ -17,6 +17,7 @@
 #include "circuit_library.h"
 #include "lb_rr_graph.h"
 #include "openfpga_port.h"
+#include "pointer_index_table.h"
 
 /* Begin namespace openfpga */
 namespace openfpga {
@@ -34,6 +35,13 @@ typedef vtr::StrongId<pb_graph_node_id_tag> PbGraphNodeId;
  * 2. what is the circuit model id linked to a physical pb_type
  * 3. what is the physical pb_type for an operating pb_type
  * 4. what is the mode pointer that represents the physical mode for a pb_type
+ *
+ * Annotations are stored in maps keyed by the pointers of VPR data structures
+ * when they are being built. Once built, finalize() should be called, which
+ * assigns dense indices to the pb_types, ports, pb_graph nodes and pins,
+ * and copies the frequently used annotations to flat vectors. Accessors use
+ * the flat vectors when the annotation is finalized, and the maps otherwise.
+ * Any mutation on these annotations invalidates the finalization.
  *******************************************************************/
 class VprDeviceAnnotation {
  public: /* Constructor */
@@ -89,7 +97,7 @@ class VprDeviceAnnotation {
   CircuitModelId rr_switch_circuit_model(const RRSwitchId& rr_switch) const;
   CircuitModelId rr_segment_circuit_model(const RRSegmentId& rr_segment) const;
   ArchDirectId direct_annotation(const size_t& direct) const;
-  LbRRGraph physical_lb_rr_graph(t_pb_graph_node* pb_graph_head) const;
+  const LbRRGraph& physical_lb_rr_graph(t_pb_graph_node* pb_graph_head) const;
   BasicPort physical_tile_pin_port_info(t_physical_tile_type_ptr physical_tile,
                                         const int& pin_index) const;
   int physical_tile_pin_subtile_index(t_physical_tile_type_ptr physical_tile,
@@ -98,8 +106,11 @@ class VprDeviceAnnotation {
                                        const int& subtile_z) const;
   int physical_tile_z_to_start_pin_index(t_physical_tile_type_ptr physical_tile,
                                          const int& subtile_z) const;
+  void memory_usage(MemoryUsage& usage) const;
 
  public: /* Public mutators */
+  /* Build the dense indices and flat look-ups for the annotations */
+  void finalize();
   void add_pb_type_physical_mode(t_pb_type* pb_type, t_mode* physical_mode);
   void add_physical_pb_type(t_pb_type* operating_pb_type,
                             t_pb_type* physical_pb_type);
@@ -270,6 +281,24 @@ class VprDeviceAnnotation {
    */
   std::map<t_physical_tile_type_ptr, std::map<int, int>>
     physical_tile_z_to_start_pin_indices_;
+
+  /* Dense indices and flat look-ups built by finalize(). Each vector is
+   * indexed by the dense index of its key in the associated table */
+  bool finalized_;
+  PointerIndexTable<t_pb_type> pb_type_indices_;
+  PointerIndexTable<t_port> pb_port_indices_;
+  PointerIndexTable<t_pb_graph_node> pb_graph_node_indices_;
+  PointerIndexTable<t_pb_graph_pin> pb_graph_pin_indices_;
+  std::vector<t_pb_type*> flat_physical_pb_types_;
+  std::vector<t_mode*> flat_physical_pb_modes_;
+  std::vector<CircuitModelId> flat_pb_type_circuit_models_;
+  std::vector<CircuitPortId> flat_pb_circuit_ports_;
+  std::vector<PbGraphNodeId> flat_pb_graph_node_unique_indices_;
+  std::vector<t_pb_graph_node*> flat_physical_pb_graph_nodes_;
+  std::vector<t_pb_graph_pin*> flat_physical_pb_graph_pins_;
+
+  /* An empty graph returned when no graph is found */
+  LbRRGraph empty_lb_rr_graph_;
 };
 
 } /* End namespace openfpga*/
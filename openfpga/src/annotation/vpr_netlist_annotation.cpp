@@ -40,6 +40,11 @@ std::string VprNetlistAnnotation::net_name(const AtomNetId& net) const {
   return net_names_.at(net);
 }
 
+void VprNetlistAnnotation::memory_usage(MemoryUsage& usage) const {
+  usage.add_lookup(block_names_);
+  usage.add_lookup(net_names_);
+}
+
 /************************************************************************
  * Public mutators
  ***********************************************************************/
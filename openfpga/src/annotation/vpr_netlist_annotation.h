@@ -9,6 +9,9 @@
 /* Header from vpr library */
 #include "atom_netlist.h"
 
+/* Header from openfpgautil library */
+#include "openfpga_memory_usage.h"
+
 /* Begin namespace openfpga */
 namespace openfpga {
 
@@ -30,6 +33,7 @@ class VprNetlistAnnotation {
   std::string block_name(const AtomBlockId& block) const;
   bool is_net_renamed(const AtomNetId& net) const;
   std::string net_name(const AtomNetId& net) const;
+  void memory_usage(MemoryUsage& usage) const;
 
  public: /* Public mutators */
   void rename_block(const AtomBlockId& block, const std::string& name);
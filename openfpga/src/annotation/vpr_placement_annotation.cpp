@@ -21,6 +21,16 @@ std::vector<ClusterBlockId> VprPlacementAnnotation::grid_blocks(
   return blocks_[grid_coord.x()][grid_coord.y()];
 }
 
+void VprPlacementAnnotation::memory_usage(MemoryUsage& usage) const {
+  usage.add_bytes(MemoryUsage::CONTAINER,
+                  blocks_.size() * sizeof(std::vector<ClusterBlockId>));
+  for (size_t x = 0; x < blocks_.dim_size(0); ++x) {
+    for (size_t y = 0; y < blocks_.dim_size(1); ++y) {
+      usage.add_container(blocks_[x][y]);
+    }
+  }
+}
+
 /************************************************************************
  * Public mutators
  ***********************************************************************/
@@ -13,6 +13,9 @@
 #include "clustered_netlist.h"
 #include "device_grid.h"
 
+/* Header from openfpgautil library */
+#include "openfpga_memory_usage.h"
+
 /* Begin namespace openfpga */
 namespace openfpga {
 
@@ -24,6 +27,7 @@ class VprPlacementAnnotation {
  public: /* Public accessors */
   std::vector<ClusterBlockId> grid_blocks(
     const vtr::Point<size_t>& grid_coord) const;
+  void memory_usage(MemoryUsage& usage) const;
 
  public: /* Public mutators */
   void init_mapped_blocks(const DeviceGrid& grids);
@@ -30,6 +30,11 @@ RRNodeId VprRoutingAnnotation::rr_node_prev_node(
   return rr_node_prev_nodes_[rr_node];
 }
 
+void VprRoutingAnnotation::memory_usage(MemoryUsage& usage) const {
+  usage.add_container(rr_node_nets_);
+  usage.add_container(rr_node_prev_nodes_);
+}
+
 /************************************************************************
  * Public mutators
  ***********************************************************************/
@@ -11,6 +11,9 @@
 #include "rr_graph_view.h"
 #include "vtr_vector.h"
 
+/* Header from openfpgautil library */
+#include "openfpga_memory_usage.h"
+
 /* Begin namespace openfpga */
 namespace openfpga {
 
@@ -30,6 +33,7 @@ class VprRoutingAnnotation {
  public: /* Public accessors */
   ClusterNetId rr_node_net(const RRNodeId& rr_node) const;
   RRNodeId rr_node_prev_node(const RRNodeId& rr_node) const;
+  void memory_usage(MemoryUsage& usage) const;
 
  public: /* Public mutators */
   void init(const RRGraphView& rr_graph);
@@ -3,11 +3,13 @@
  * - exit
  * - version
  * - help
+ * - report_memory_usage
  *******************************************************************/
 #include "basic_command.h"
 
 #include "command_exit_codes.h"
 #include "openfpga_basic.h"
+#include "openfpga_design_batch.h"
 #include "openfpga_title.h"
 
 /* begin namespace openfpga */
@@ -80,6 +82,68 @@ static ShellCommandId add_openfpga_source_command(
   return shell_cmd_id;
 }
 
+/********************************************************************
+ * - Add a command to Shell environment: run_design_batch
+ * - Add associated options
+ * - Add command dependency
+ *******************************************************************/
+static ShellCommandId add_openfpga_run_design_batch_command(
+  openfpga::Shell<OpenfpgaContext>& shell,
+  const ShellCommandClassId& cmd_class_id,
+  const std::vector<ShellCommandId>& dependent_cmds) {
+  Command shell_cmd("run_design_batch");
+
+  /* Add an option '--manifest' */
+  CommandOptionId opt_manifest = shell_cmd.add_option(
+    "manifest", true,
+    "A file which lists the name, the circuit and the script of each design "
+    "to run");
+  shell_cmd.set_option_require_value(opt_manifest, openfpga::OPT_STRING);
+
+  /* Add command to the Shell */
+  ShellCommandId shell_cmd_id = shell.add_command(
+    shell_cmd,
+    "Run the script of each design in a manifest on the fabric built in "
+    "current session");
+  shell.set_command_class(shell_cmd_id, cmd_class_id);
+  shell.set_command_execute_function(shell_cmd_id, run_design_batch);
+
+  /* Add command dependency to the Shell */
+  shell.set_command_dependency(shell_cmd_id, dependent_cmds);
+
+  return shell_cmd_id;
+}
+
+/********************************************************************
+ * - Add a command to Shell environment: report_memory_usage
+ * - Add associated options
+ * - Add command dependency
+ *******************************************************************/
+static ShellCommandId add_openfpga_report_memory_usage_command(
+  openfpga::Shell<OpenfpgaContext>& shell,
+  const ShellCommandClassId& cmd_class_id,
+  const std::vector<ShellCommandId>& dependent_cmds) {
+  Command shell_cmd("report_memory_usage");
+
+  /* Add an option '--no_command_records' */
+  shell_cmd.add_option(
+    "no_command_records", false,
+    "Do not report the resident memory of each executed command");
+
+  /* Add command to the Shell */
+  ShellCommandId shell_cmd_id = shell.add_command(
+    shell_cmd,
+    "Report the memory used by each data structure and by each executed "
+    "command");
+  shell.set_command_class(shell_cmd_id, cmd_class_id);
+  shell.set_command_execute_function(shell_cmd_id, report_memory_usage);
+
+  /* Add command dependency to the Shell */
+  shell.set_command_dependency(shell_cmd_id, dependent_cmds);
+
+  return shell_cmd_id;
+}
+
 void add_basic_commands(openfpga::Shell<OpenfpgaContext>& shell) {
   /* Add a new class of commands */
   ShellCommandClassId basic_cmd_class = shell.add_command_class("Basic");
@@ -111,10 +175,27 @@ void add_basic_commands(openfpga::Shell<OpenfpgaContext>& shell) {
   add_openfpga_source_command(shell, basic_cmd_class,
                               std::vector<ShellCommandId>());
 
+  /* Add 'run_design_batch' command which can run a set of designs
+   * The results of each design are annotated on the device which
+   * 'link_openfpga_arch' annotates
+   */
+  std::vector<ShellCommandId> run_design_batch_dependent_cmds;
+  ShellCommandId link_arch_cmd_id =
+    shell.command(std::string("link_openfpga_arch"));
+  if (shell.valid_command_id(link_arch_cmd_id)) {
+    run_design_batch_dependent_cmds.push_back(link_arch_cmd_id);
+  }
+  add_openfpga_run_design_batch_command(shell, basic_cmd_class,
+                                        run_design_batch_dependent_cmds);
+
   /* Add 'exec_external command which can run system call */
   add_openfpga_ext_exec_command(shell, basic_cmd_class,
                                 std::vector<ShellCommandId>());
 
+  /* Add 'report_memory_usage' command which can profile the memory */
+  add_openfpga_report_memory_usage_command(shell, basic_cmd_class,
+                                           std::vector<ShellCommandId>());
+
   /* Note:
    * help MUST be the last to add because the linking to execute function will
    * do a snapshot on the shell
@@ -7,7 +7,10 @@
 #include "openfpga_basic.h"
 
 #include "command_exit_codes.h"
+#include "openfpga_memory_usage.h"
+#include "openfpga_symbol.h"
 #include "openfpga_title.h"
+#include "vtr_log.h"
 
 /* begin namespace openfpga */
 namespace openfpga {
@@ -84,4 +87,106 @@ int call_external_command(const Command& cmd,
   return CMD_EXEC_FATAL_ERROR;
 }
 
+static double bytes_to_mib(const size_t& bytes) {
+  return double(bytes) / (1024. * 1024.);
+}
+
+static double kb_to_mib(const size_t& kb) { return double(kb) / 1024.; }
+
+static void print_memory_usage(const std::string& name,
+                               const MemoryUsage& usage) {
+  VTR_LOG("  %-28s %12.2f %12.2f %12.2f %12.2f\n", name.c_str(),
+          bytes_to_mib(usage.bytes(MemoryUsage::CONTAINER)),
+          bytes_to_mib(usage.bytes(MemoryUsage::STRING)),
+          bytes_to_mib(usage.bytes(MemoryUsage::LOOKUP)),
+          bytes_to_mib(usage.total_bytes()));
+}
+
+/********************************************************************
+ * Report the heap memory used by the major data structures of the
+ * OpenFPGA context, and the resident memory of each executed command
+ *******************************************************************/
+int report_memory_usage(openfpga::Shell<OpenfpgaContext>* shell,
+                        OpenfpgaContext& openfpga_ctx, const Command& cmd,
+                        const CommandContext& cmd_context) {
+  CommandOptionId opt_no_command = cmd.option("no_command_records");
+
+  std::vector<std::pair<std::string, MemoryUsage>> usages;
+  usages.emplace_back("module_graph", MemoryUsage());
+  openfpga_ctx.module_graph().memory_usage(usages.back().second);
+  usages.emplace_back("module_name_map", MemoryUsage());
+  openfpga_ctx.module_name_map().memory_usage(usages.back().second);
+  usages.emplace_back("fabric_tile", MemoryUsage());
+  openfpga_ctx.fabric_tile().memory_usage(usages.back().second);
+  usages.emplace_back("io_location_map", MemoryUsage());
+  openfpga_ctx.io_location_map().memory_usage(usages.back().second);
+  usages.emplace_back("device_rr_gsb", MemoryUsage());
+  openfpga_ctx.device_rr_gsb().memory_usage(usages.back().second);
+  usages.emplace_back("bitstream_manager", MemoryUsage());
+  openfpga_ctx.bitstream_manager().memory_usage(usages.back().second);
+  usages.emplace_back("fabric_bitstream", MemoryUsage());
+  openfpga_ctx.fabric_bitstream().memory_usage(usages.back().second);
+  usages.emplace_back("vpr_device_annotation", MemoryUsage());
+  openfpga_ctx.vpr_device_annotation().memory_usage(usages.back().second);
+  usages.emplace_back("vpr_netlist_annotation", MemoryUsage());
+  openfpga_ctx.vpr_netlist_annotation().memory_usage(usages.back().second);
+  usages.emplace_back("vpr_clustering_annotation", MemoryUsage());
+  openfpga_ctx.vpr_clustering_annotation().memory_usage(usages.back().second);
+  usages.emplace_back("vpr_placement_annotation", MemoryUsage());
+  openfpga_ctx.vpr_placement_annotation().memory_usage(usages.back().second);
+  usages.emplace_back("vpr_routing_annotation", MemoryUsage());
+  openfpga_ctx.vpr_routing_annotation().memory_usage(usages.back().second);
+  usages.emplace_back("vpr_bitstream_annotation", MemoryUsage());
+  openfpga_ctx.vpr_bitstream_annotation().memory_usage(usages.back().second);
+  usages.emplace_back("symbol_table", MemoryUsage());
+  Symbol::table_memory_usage(usages.back().second);
+
+  VTR_LOG("Heap memory of data structures (MiB):\n");
+  VTR_LOG("  %-28s %12s %12s %12s %12s\n", "Data structure", "Containers",
+          "Strings", "Lookups", "Total");
+  MemoryUsage total_usage;
+  for (const auto& usage : usages) {
+    print_memory_usage(usage.first, usage.second);
+    total_usage.add(usage.second);
+  }
+  print_memory_usage("Total", total_usage);
+
+  VTR_LOG("Resident memory of the process: %.2f MiB (peak %.2f MiB)\n",
+          kb_to_mib(get_current_rss_kb()), kb_to_mib(get_peak_rss_kb()));
+
+  if (cmd_context.option_enable(cmd, opt_no_command)) {
+    return CMD_EXEC_SUCCESS;
+  }
+  if (!shell->record_memory()) {
+    VTR_LOG(
+      "Resident memory of executed commands is not recorded. Launch OpenFPGA "
+      "with '--record_memory' to record it\n");
+    return CMD_EXEC_SUCCESS;
+  }
+
+  /* The record of this command is not completed yet, skip it */
+  const std::vector<ShellCommandMemoryRecord>& records =
+    shell->command_memory_records();
+  VTR_LOG("Resident memory of executed commands (MiB):\n");
+  VTR_LOG("  %10s %10s %10s %10s  %s\n", "Before", "After", "Delta", "Peak",
+          "Command");
+  bool exact_peak = true;
+  for (size_t irecord = 0; irecord + 1 < records.size(); ++irecord) {
+    const ShellCommandMemoryRecord& record = records[irecord];
+    VTR_LOG("  %10.2f %10.2f %+10.2f %10.2f%c %*s%s\n",
+            kb_to_mib(record.rss_before_kb), kb_to_mib(record.rss_after_kb),
+            kb_to_mib(record.rss_after_kb) - kb_to_mib(record.rss_before_kb),
+            kb_to_mib(record.peak_rss_kb), record.exact_peak ? ' ' : '*',
+            int(2 * record.depth), "", record.cmd_line.c_str());
+    exact_peak = exact_peak && record.exact_peak;
+  }
+  if (!exact_peak) {
+    VTR_LOG(
+      "  *: the peak memory of the process cannot be reset on this system. "
+      "The peak is the one since the process starts\n");
+  }
+
+  return CMD_EXEC_SUCCESS;
+}
+
 } /* end namespace openfpga */
@@ -78,6 +78,17 @@ ShellCommandId add_build_arch_bitstream_command_template(
   shell_cmd.add_option("no_time_stamp", false,
                        "Do not print time stamp in output files");
 
+  /* Add an option '--incremental' */
+  shell_cmd.add_option("incremental", false,
+                       "Update the existing bitstream database only on the "
+                       "grids and routing blocks changed by the "
+                       "implementation");
+
+  /* Add an option '--verify' */
+  shell_cmd.add_option("verify", false,
+                       "Verify the incrementally updated bitstream database "
+                       "against a database built from scratch");
+
   /* Add an option '--verbose' */
   shell_cmd.add_option("verbose", false, "Enable verbose output");
 
@@ -136,6 +147,42 @@ ShellCommandId add_report_bitstream_distribution_command_template(
   return shell_cmd_id;
 }
 
+/********************************************************************
+ * - Add a command to Shell environment: report_configuration_time
+ * - Add associated options
+ * - Add command dependency
+ *******************************************************************/
+template <class T>
+ShellCommandId add_report_configuration_time_command_template(
+  openfpga::Shell<T>& shell, const ShellCommandClassId& cmd_class_id,
+  const std::vector<ShellCommandId>& dependent_cmds, const bool& hidden) {
+  Command shell_cmd("report_configuration_time");
+
+  /* Add an option '--file' */
+  CommandOptionId opt_file = shell_cmd.add_option(
+    "file", false, "file path to output the configuration time report");
+  shell_cmd.set_option_short_name(opt_file, "f");
+  shell_cmd.set_option_require_value(opt_file, openfpga::OPT_STRING);
+
+  /* Add an option '--verbose' */
+  shell_cmd.add_option("verbose", false, "Enable verbose output");
+
+  /* Add command 'report_configuration_time' to the Shell */
+  ShellCommandId shell_cmd_id = shell.add_command(
+    shell_cmd,
+    "Report the number of programming cycles per configuration region, with "
+    "and without fast configuration",
+    hidden);
+  shell.set_command_class(shell_cmd_id, cmd_class_id);
+  shell.set_command_const_execute_function(
+    shell_cmd_id, report_configuration_time_template<T>);
+
+  /* Add command dependency to the Shell */
+  shell.set_command_dependency(shell_cmd_id, dependent_cmds);
+
+  return shell_cmd_id;
+}
+
 /********************************************************************
  * - Add a command to Shell environment: build_fabric_bitstream
  * - Add associated options
@@ -147,6 +194,16 @@ ShellCommandId add_build_fabric_bitstream_command_template(
   const std::vector<ShellCommandId>& dependent_cmds, const bool& hidden) {
   Command shell_cmd("build_fabric_bitstream");
 
+  /* Add an option '--incremental' */
+  shell_cmd.add_option("incremental", false,
+                       "Update the existing fabric bitstream only on the bits "
+                       "changed in the architecture bitstream");
+
+  /* Add an option '--verify' */
+  shell_cmd.add_option("verify", false,
+                       "Verify the incrementally updated fabric bitstream "
+                       "against a fabric bitstream built from scratch");
+
   /* Add an option '--verbose' */
   shell_cmd.add_option("verbose", false, "Enable verbose output");
 
@@ -226,6 +283,12 @@ ShellCommandId add_write_fabric_bitstream_command_template(
     "wl_decremental_order", false,
     "Generate bitstream in WL decremental addressing order if supported");
 
+  /* Add an option '--hex' */
+  shell_cmd.add_option(
+    "hex", false,
+    "Output each line of bitstream in hexadecimal format, which can be loaded "
+    "by $readmemh. Only applicable to plain text file format. Default: off");
+
   /* Add an option '--no_time_stamp' */
   shell_cmd.add_option("no_time_stamp", false,
                        "Do not print time stamp in output files");
@@ -246,6 +309,88 @@ ShellCommandId add_write_fabric_bitstream_command_template(
   return shell_cmd_id;
 }
 
+/********************************************************************
+ * - Add a command to Shell environment: write_fabric_bitstream_diff
+ * - Add associated options
+ * - Add command dependency
+ *******************************************************************/
+template <class T>
+ShellCommandId add_write_fabric_bitstream_diff_command_template(
+  openfpga::Shell<T>& shell, const ShellCommandClassId& cmd_class_id,
+  const std::vector<ShellCommandId>& dependent_cmds, const bool& hidden) {
+  Command shell_cmd("write_fabric_bitstream_diff");
+
+  /* Add an option '--reference' */
+  CommandOptionId opt_reference = shell_cmd.add_option(
+    "reference", true,
+    "file path to the architecture bitstream (XML) to compare with");
+  shell_cmd.set_option_require_value(opt_reference, openfpga::OPT_STRING);
+
+  /* Add an option '--file' in short '-f'*/
+  CommandOptionId opt_file = shell_cmd.add_option(
+    "file", true, "file path to output the bitstream difference");
+  shell_cmd.set_option_short_name(opt_file, "f");
+  shell_cmd.set_option_require_value(opt_file, openfpga::OPT_STRING);
+
+  /* Add an option '--no_time_stamp' */
+  shell_cmd.add_option("no_time_stamp", false,
+                       "Do not print time stamp in output files");
+
+  /* Add an option '--verbose' */
+  shell_cmd.add_option("verbose", false, "Enable verbose output");
+
+  /* Add command to the Shell */
+  ShellCommandId shell_cmd_id = shell.add_command(
+    shell_cmd,
+    "Write the configuration bits which differ from a reference bitstream to "
+    "a file",
+    hidden);
+  shell.set_command_class(shell_cmd_id, cmd_class_id);
+  shell.set_command_const_execute_function(
+    shell_cmd_id, write_fabric_bitstream_diff_template<T>);
+
+  /* Add command dependency to the Shell */
+  shell.set_command_dependency(shell_cmd_id, dependent_cmds);
+
+  return shell_cmd_id;
+}
+
+/********************************************************************
+ * - Add a command to Shell environment: apply_fabric_bitstream_diff
+ * - Add associated options
+ * - Add command dependency
+ *******************************************************************/
+template <class T>
+ShellCommandId add_apply_fabric_bitstream_diff_command_template(
+  openfpga::Shell<T>& shell, const ShellCommandClassId& cmd_class_id,
+  const std::vector<ShellCommandId>& dependent_cmds, const bool& hidden) {
+  Command shell_cmd("apply_fabric_bitstream_diff");
+
+  /* Add an option '--file' in short '-f'*/
+  CommandOptionId opt_file = shell_cmd.add_option(
+    "file", true, "file path to the bitstream difference to apply");
+  shell_cmd.set_option_short_name(opt_file, "f");
+  shell_cmd.set_option_require_value(opt_file, openfpga::OPT_STRING);
+
+  /* Add an option '--verbose' */
+  shell_cmd.add_option("verbose", false, "Enable verbose output");
+
+  /* Add command to the Shell */
+  ShellCommandId shell_cmd_id = shell.add_command(
+    shell_cmd,
+    "Apply a bitstream difference to the architecture bitstream database in "
+    "memory (no bitstream file is modified)",
+    hidden);
+  shell.set_command_class(shell_cmd_id, cmd_class_id);
+  shell.set_command_execute_function(shell_cmd_id,
+                                     apply_fabric_bitstream_diff_template<T>);
+
+  /* Add command dependency to the Shell */
+  shell.set_command_dependency(shell_cmd_id, dependent_cmds);
+
+  return shell_cmd_id;
+}
+
 /********************************************************************
  * - Add a command to Shell environment: write_io_mapping
  * - Add associated options
@@ -289,10 +434,12 @@ ShellCommandId add_write_io_mapping_command_template(
 template <class T>
 void add_bitstream_command_templates(openfpga::Shell<T>& shell,
                                      const bool& hidden = false) {
-  /* Get the unique id of 'build_fabric' command which is to be used in creating
-   * the dependency graph */
+  /* Get the unique id of 'build_fabric' and 'link_openfpga_arch' commands
+   * which are to be used in creating the dependency graph */
   const ShellCommandId& shell_cmd_build_fabric_id =
     shell.command(std::string("build_fabric"));
+  const ShellCommandId& shell_cmd_link_arch_id =
+    shell.command(std::string("link_openfpga_arch"));
 
   /* Add a new class of commands */
   ShellCommandClassId openfpga_bitstream_cmd_class =
@@ -301,9 +448,11 @@ void add_bitstream_command_templates(openfpga::Shell<T>& shell,
   /********************************
    * Command 'repack'
    */
-  /* The 'repack' command should NOT be executed before 'build_fabric' */
+  /* The 'repack' command should NOT be executed before 'build_fabric' and
+   * 'link_openfpga_arch', which annotates the results of the design */
   std::vector<ShellCommandId> cmd_dependency_repack;
   cmd_dependency_repack.push_back(shell_cmd_build_fabric_id);
+  cmd_dependency_repack.push_back(shell_cmd_link_arch_id);
   ShellCommandId shell_cmd_repack_id = add_repack_command_template(
     shell, openfpga_bitstream_cmd_class, cmd_dependency_repack, hidden);
 
@@ -356,6 +505,42 @@ void add_bitstream_command_templates(openfpga::Shell<T>& shell,
     shell, openfpga_bitstream_cmd_class, cmd_dependency_write_fabric_bitstream,
     hidden);
 
+  /********************************
+   * Command 'write_fabric_bitstream_diff'
+   */
+  /* The 'write_fabric_bitstream_diff' command should NOT be executed before
+   * 'build_fabric_bitstream' */
+  std::vector<ShellCommandId> cmd_dependency_write_fabric_bitstream_diff;
+  cmd_dependency_write_fabric_bitstream_diff.push_back(
+    shell_cmd_build_fabric_bitstream_id);
+  add_write_fabric_bitstream_diff_command_template(
+    shell, openfpga_bitstream_cmd_class,
+    cmd_dependency_write_fabric_bitstream_diff, hidden);
+
+  /********************************
+   * Command 'report_configuration_time'
+   */
+  /* The 'report_configuration_time' command should NOT be executed before
+   * 'build_fabric_bitstream' */
+  std::vector<ShellCommandId> cmd_dependency_report_configuration_time;
+  cmd_dependency_report_configuration_time.push_back(
+    shell_cmd_build_fabric_bitstream_id);
+  add_report_configuration_time_command_template(
+    shell, openfpga_bitstream_cmd_class,
+    cmd_dependency_report_configuration_time, hidden);
+
+  /********************************
+   * Command 'apply_fabric_bitstream_diff'
+   */
+  /* The 'apply_fabric_bitstream_diff' command should NOT be executed before
+   * 'build_architecture_bitstream' */
+  std::vector<ShellCommandId> cmd_dependency_apply_fabric_bitstream_diff;
+  cmd_dependency_apply_fabric_bitstream_diff.push_back(
+    shell_cmd_build_arch_bitstream_id);
+  add_apply_fabric_bitstream_diff_command_template(
+    shell, openfpga_bitstream_cmd_class,
+    cmd_dependency_apply_fabric_bitstream_diff, hidden);
+
   /********************************
    * Command 'write_io_mapping'
    */
@@ -12,6 +12,7 @@
 #include "command_context.h"
 #include "command_exit_codes.h"
 #include "extract_device_non_fabric_bitstream.h"
+#include "fabric_bitstream_utils.h"
 #include "globals.h"
 #include "openfpga_digest.h"
 #include "openfpga_naming.h"
@@ -19,9 +20,13 @@
 #include "overwrite_bitstream.h"
 #include "read_xml_arch_bitstream.h"
 #include "report_bitstream_distribution.h"
+#include "report_configuration_time.h"
+#include "update_device_bitstream.h"
+#include "update_fabric_bitstream.h"
 #include "vtr_log.h"
 #include "vtr_time.h"
 #include "write_text_fabric_bitstream.h"
+#include "write_text_fabric_bitstream_diff.h"
 #include "write_xml_arch_bitstream.h"
 #include "write_xml_fabric_bitstream.h"
 #include "write_xml_io_mapping.h"
@@ -39,18 +44,69 @@ int fpga_bitstream_template(T& openfpga_ctx, const Command& cmd,
   CommandOptionId opt_no_time_stamp = cmd.option("no_time_stamp");
   CommandOptionId opt_write_file = cmd.option("write_file");
   CommandOptionId opt_read_file = cmd.option("read_file");
+  CommandOptionId opt_incremental = cmd.option("incremental");
+  CommandOptionId opt_verify = cmd.option("verify");
+
+  bool incremental = cmd_context.option_enable(cmd, opt_incremental);
+  DeviceBitstreamDigest& bitstream_digest =
+    openfpga_ctx.mutable_device_bitstream_digest();
 
   if (true == cmd_context.option_enable(cmd, opt_read_file)) {
     openfpga_ctx.mutable_bitstream_manager() = read_xml_architecture_bitstream(
       cmd_context.option_value(cmd, opt_read_file).c_str());
+    /* Nothing is known about the implementation of the bitstream */
+    bitstream_digest.clear();
+  } else if (incremental &&
+             bitstream_digest.valid(openfpga_ctx.bitstream_manager())) {
+    int status = update_device_bitstream(
+      openfpga_ctx.mutable_bitstream_manager(), bitstream_digest, g_vpr_ctx,
+      openfpga_ctx, cmd_context.option_enable(cmd, opt_verbose));
+    if (CMD_EXEC_SUCCESS != status) {
+      return status;
+    }
   } else {
+    if (incremental) {
+      VTR_LOG(
+        "No architecture bitstream can be updated incrementally. Build it "
+        "from scratch.\n");
+    }
     openfpga_ctx.mutable_bitstream_manager() = build_device_bitstream(
       g_vpr_ctx, openfpga_ctx, cmd_context.option_enable(cmd, opt_verbose));
+    bitstream_digest.clear();
+    /* Digests are only required by the incremental updates to come */
+    if (incremental) {
+      record_device_bitstream_digest(bitstream_digest,
+                                     openfpga_ctx.bitstream_manager(),
+                                     g_vpr_ctx, openfpga_ctx);
+    }
   }
 
-  overwrite_bitstream(openfpga_ctx.mutable_bitstream_manager(),
-                      openfpga_ctx.bitstream_setting(),
-                      cmd_context.option_enable(cmd, opt_verbose));
+  std::vector<std::pair<ConfigBitId, bool>> overwritten_bits =
+    overwrite_bitstream(openfpga_ctx.mutable_bitstream_manager(),
+                        openfpga_ctx.bitstream_setting(),
+                        cmd_context.option_enable(cmd, opt_verbose));
+  if (bitstream_digest.valid(openfpga_ctx.bitstream_manager())) {
+    for (const std::pair<ConfigBitId, bool>& overwritten_bit :
+         overwritten_bits) {
+      bitstream_digest.add_changed_bit(overwritten_bit.first);
+    }
+    bitstream_digest.set_overwritten_bits(overwritten_bits);
+  }
+
+  /* Compare against a full rebuild, even if the incremental update falls
+   * back to a full build */
+  if (incremental && cmd_context.option_enable(cmd, opt_verify)) {
+    BitstreamManager ref_bitstream_manager =
+      build_device_bitstream(g_vpr_ctx, openfpga_ctx, false);
+    overwrite_bitstream(ref_bitstream_manager,
+                        openfpga_ctx.bitstream_setting(), false);
+    int status = verify_device_bitstream(
+      openfpga_ctx.bitstream_manager(), ref_bitstream_manager,
+      cmd_context.option_enable(cmd, opt_verbose));
+    if (CMD_EXEC_SUCCESS != status) {
+      return status;
+    }
+  }
 
   if (true == cmd_context.option_enable(cmd, opt_write_file)) {
     std::string src_dir_path =
@@ -78,14 +134,56 @@ int fpga_bitstream_template(T& openfpga_ctx, const Command& cmd,
 template <class T>
 int build_fabric_bitstream_template(T& openfpga_ctx, const Command& cmd,
                                     const CommandContext& cmd_context) {
+  CommandOptionId opt_incremental = cmd.option("incremental");
+  CommandOptionId opt_verify = cmd.option("verify");
   CommandOptionId opt_verbose = cmd.option("verbose");
 
+  /* Patch the existing fabric bitstream when requested and possible */
+  bool updated = false;
+  if (cmd_context.option_enable(cmd, opt_incremental)) {
+    if (!openfpga_ctx.device_bitstream_digest().all_bits_changed() ||
+        fabric_bitstream_updatable(openfpga_ctx.fabric_bitstream(),
+                                   openfpga_ctx.bitstream_manager())) {
+      int status = update_fabric_bitstream(
+        openfpga_ctx.mutable_fabric_bitstream(),
+        openfpga_ctx.bitstream_manager(),
+        openfpga_ctx.device_bitstream_digest(),
+        cmd_context.option_enable(cmd, opt_verbose));
+      if (CMD_EXEC_SUCCESS != status) {
+        return status;
+      }
+      updated = true;
+    } else {
+      VTR_LOG(
+        "No fabric bitstream can be updated incrementally. Build it from "
+        "scratch.\n");
+    }
+  }
+
   /* Build fabric bitstream here */
-  openfpga_ctx.mutable_fabric_bitstream() = build_fabric_dependent_bitstream(
-    openfpga_ctx.bitstream_manager(), openfpga_ctx.module_graph(),
-    openfpga_ctx.module_name_map(), openfpga_ctx.arch().circuit_lib,
-    openfpga_ctx.arch().config_protocol,
-    cmd_context.option_enable(cmd, opt_verbose));
+  if (!updated) {
+    openfpga_ctx.mutable_fabric_bitstream() = build_fabric_dependent_bitstream(
+      openfpga_ctx.bitstream_manager(), openfpga_ctx.module_graph(),
+      openfpga_ctx.module_name_map(), openfpga_ctx.arch().circuit_lib,
+      openfpga_ctx.arch().config_protocol,
+      cmd_context.option_enable(cmd, opt_verbose));
+  }
+
+  /* The fabric bitstream is now in sync with the architecture bitstream */
+  openfpga_ctx.mutable_device_bitstream_digest().clear_changed_bits();
+
+  /* Compare against a full rebuild, even if the incremental update falls
+   * back to a full build */
+  if (cmd_context.option_enable(cmd, opt_incremental) &&
+      cmd_context.option_enable(cmd, opt_verify)) {
+    FabricBitstream ref_fabric_bitstream = build_fabric_dependent_bitstream(
+      openfpga_ctx.bitstream_manager(), openfpga_ctx.module_graph(),
+      openfpga_ctx.module_name_map(), openfpga_ctx.arch().circuit_lib,
+      openfpga_ctx.arch().config_protocol, false);
+    return verify_fabric_bitstream(openfpga_ctx.fabric_bitstream(),
+                                   ref_fabric_bitstream,
+                                   cmd_context.option_enable(cmd, opt_verbose));
+  }
 
   /* TODO: should identify the error code from internal function execution */
   return CMD_EXEC_SUCCESS;
@@ -103,6 +201,7 @@ int write_fabric_bitstream_template(const T& openfpga_ctx, const Command& cmd,
   CommandOptionId opt_fast_config = cmd.option("fast_configuration");
   CommandOptionId opt_keep_dont_care_bits = cmd.option("keep_dont_care_bits");
   CommandOptionId opt_wl_decremental_order = cmd.option("wl_decremental_order");
+  CommandOptionId opt_hex = cmd.option("hex");
   CommandOptionId opt_no_time_stamp = cmd.option("no_time_stamp");
   CommandOptionId opt_filter_value = cmd.option("filter_value");
   CommandOptionId opt_path_only = cmd.option("path_only");
@@ -147,6 +246,7 @@ int write_fabric_bitstream_template(const T& openfpga_ctx, const Command& cmd,
     cmd_context.option_enable(cmd, opt_keep_dont_care_bits));
   bitfile_writer_opt.set_wl_decremental_order(
     cmd_context.option_enable(cmd, opt_wl_decremental_order));
+  bitfile_writer_opt.set_hex(cmd_context.option_enable(cmd, opt_hex));
   if (cmd_context.option_enable(cmd, opt_filter_value)) {
     bitfile_writer_opt.set_filter_value(
       cmd_context.option_value(cmd, opt_filter_value));
@@ -156,6 +256,13 @@ int write_fabric_bitstream_template(const T& openfpga_ctx, const Command& cmd,
     return CMD_EXEC_FATAL_ERROR;
   }
 
+  /* Fast configuration and memory banks rely on the values recorded in the
+   * fabric bitstream */
+  if (!check_fabric_bitstream_in_sync(openfpga_ctx.bitstream_manager(),
+                                      openfpga_ctx.fabric_bitstream())) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
   if (bitfile_writer_opt.output_file_type() ==
       BitstreamWriterOption::e_bitfile_type::XML) {
     status = write_fabric_bitstream_to_xml_file(
@@ -175,6 +282,55 @@ int write_fabric_bitstream_template(const T& openfpga_ctx, const Command& cmd,
   return status;
 }
 
+/********************************************************************
+ * A wrapper function to compare the fabric bitstream with a reference
+ * architecture bitstream and write the difference to a file
+ *******************************************************************/
+template <class T>
+int write_fabric_bitstream_diff_template(const T& openfpga_ctx,
+                                         const Command& cmd,
+                                         const CommandContext& cmd_context) {
+  CommandOptionId opt_reference = cmd.option("reference");
+  CommandOptionId opt_file = cmd.option("file");
+  CommandOptionId opt_no_time_stamp = cmd.option("no_time_stamp");
+  CommandOptionId opt_verbose = cmd.option("verbose");
+
+  std::string ref_fname = cmd_context.option_value(cmd, opt_reference);
+  std::string fname = cmd_context.option_value(cmd, opt_file);
+
+  /* Create directories */
+  create_directory(find_path_dir_name(fname));
+
+  BitstreamManager ref_bitstream_manager =
+    read_xml_architecture_bitstream(ref_fname.c_str());
+
+  return write_fabric_bitstream_diff_to_text_file(
+    openfpga_ctx.bitstream_manager(), ref_bitstream_manager,
+    openfpga_ctx.fabric_bitstream(), openfpga_ctx.arch().config_protocol,
+    fname, ref_fname, !cmd_context.option_enable(cmd, opt_no_time_stamp),
+    cmd_context.option_enable(cmd, opt_verbose));
+}
+
+/********************************************************************
+ * A wrapper function to apply a fabric bitstream difference to the
+ * architecture bitstream
+ *******************************************************************/
+template <class T>
+int apply_fabric_bitstream_diff_template(T& openfpga_ctx, const Command& cmd,
+                                         const CommandContext& cmd_context) {
+  CommandOptionId opt_file = cmd.option("file");
+  CommandOptionId opt_verbose = cmd.option("verbose");
+
+  /* The bits no longer match the implementation, so that the architecture
+   * bitstream can not be updated incrementally anymore */
+  openfpga_ctx.mutable_device_bitstream_digest().clear();
+
+  return apply_fabric_bitstream_diff(
+    openfpga_ctx.mutable_bitstream_manager(),
+    cmd_context.option_value(cmd, opt_file),
+    cmd_context.option_enable(cmd, opt_verbose));
+}
+
 /********************************************************************
  * A wrapper function to call the write_io_mapping() in FPGA bitstream
  *******************************************************************/
@@ -264,6 +420,35 @@ int report_bitstream_distribution_template(const T& openfpga_ctx,
   return status;
 }
 
+/********************************************************************
+ * A wrapper function to call the report_configuration_time() in FPGA
+ *bitstream
+ *******************************************************************/
+template <class T>
+int report_configuration_time_template(const T& openfpga_ctx,
+                                       const Command& cmd,
+                                       const CommandContext& cmd_context) {
+  CommandOptionId opt_file = cmd.option("file");
+  CommandOptionId opt_verbose = cmd.option("verbose");
+
+  std::string fname;
+  if (true == cmd_context.option_enable(cmd, opt_file)) {
+    fname = cmd_context.option_value(cmd, opt_file);
+    /* Create directories */
+    create_directory(find_path_dir_name(fname));
+  }
+
+  if (!check_fabric_bitstream_in_sync(openfpga_ctx.bitstream_manager(),
+                                      openfpga_ctx.fabric_bitstream())) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  return report_configuration_time(
+    fname, openfpga_ctx.arch().config_protocol,
+    openfpga_ctx.fabric_global_port_info(), openfpga_ctx.fabric_bitstream(),
+    cmd_context.option_enable(cmd, opt_verbose));
+}
+
 } /* end namespace openfpga */
 
 #endif
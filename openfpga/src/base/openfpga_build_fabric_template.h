@@ -3,6 +3,8 @@
 /********************************************************************
  * This file includes functions to compress the hierachy of routing architecture
  *******************************************************************/
+#include <sstream>
+
 #include "build_device_module.h"
 #include "build_fabric_global_port_info.h"
 #include "build_fabric_io_location_map.h"
@@ -12,9 +14,12 @@
 #include "command_exit_codes.h"
 #include "device_rr_gsb.h"
 #include "device_rr_gsb_utils.h"
+#include "fabric_checkpoint.h"
 #include "fabric_hierarchy_writer.h"
 #include "fabric_key_writer.h"
 #include "globals.h"
+#include "openfpga_command_utils.h"
+#include "openfpga_file_cache.h"
 #include "openfpga_naming.h"
 #include "read_unique_blocks_bin.h"
 #include "read_unique_blocks_xml.h"
@@ -104,18 +109,26 @@ template <class T>
 int build_fabric_template(T& openfpga_ctx, const Command& cmd,
                           const CommandContext& cmd_context) {
   CommandOptionId opt_frame_view = cmd.option("frame_view");
+  CommandOptionId opt_bitstream_only = cmd.option("bitstream_only");
   CommandOptionId opt_compress_routing = cmd.option("compress_routing");
   CommandOptionId opt_duplicate_grid_pin = cmd.option("duplicate_grid_pin");
   CommandOptionId opt_gen_random_fabric_key =
     cmd.option("generate_random_fabric_key");
   CommandOptionId opt_write_fabric_key = cmd.option("write_fabric_key");
   CommandOptionId opt_load_fabric_key = cmd.option("load_fabric_key");
+  CommandOptionId opt_fabric_key_cache = cmd.option("fabric_key_cache");
   CommandOptionId opt_group_tile = cmd.option("group_tile");
   CommandOptionId opt_group_config_block = cmd.option("group_config_block");
   CommandOptionId opt_name_module_using_index =
     cmd.option("name_module_using_index");
   CommandOptionId opt_verbose = cmd.option("verbose");
 
+  size_t num_threads = 1;
+  if (CMD_EXEC_SUCCESS !=
+      read_num_threads_option(cmd, cmd_context, num_threads)) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
   /* Report conflicts with options:
    * - group tile does not support duplicate_grid_pin
    * - group tile requires compress_routing to be enabled
@@ -171,7 +184,12 @@ int build_fabric_template(T& openfpga_ctx, const Command& cmd,
   if (true == cmd_context.option_enable(cmd, opt_load_fabric_key)) {
     std::string fkey_fname = cmd_context.option_value(cmd, opt_load_fabric_key);
     VTR_ASSERT(false == fkey_fname.empty());
-    predefined_fabric_key = read_xml_fabric_key(fkey_fname.c_str());
+    std::string fkey_cache_fname;
+    if (true == cmd_context.option_enable(cmd, opt_fabric_key_cache)) {
+      fkey_cache_fname = cmd_context.option_value(cmd, opt_fabric_key_cache);
+    }
+    predefined_fabric_key =
+      read_xml_fabric_key(fkey_fname.c_str(), fkey_cache_fname);
   }
 
   VTR_LOG("\n");
@@ -201,14 +219,32 @@ int build_fabric_template(T& openfpga_ctx, const Command& cmd,
     openfpga_ctx.mutable_fabric_tile(), openfpga_ctx.mutable_module_name_map(),
     const_cast<const T&>(openfpga_ctx), g_vpr_ctx.device(),
     cmd_context.option_enable(cmd, opt_frame_view),
+    cmd_context.option_enable(cmd, opt_bitstream_only),
     openfpga_ctx.device_rr_gsb().is_compressed(),
     cmd_context.option_enable(cmd, opt_duplicate_grid_pin),
     predefined_fabric_key, tile_config,
     cmd_context.option_enable(cmd, opt_group_config_block),
     cmd_context.option_enable(cmd, opt_name_module_using_index),
-    cmd_context.option_enable(cmd, opt_gen_random_fabric_key),
+    cmd_context.option_enable(cmd, opt_gen_random_fabric_key), num_threads,
     cmd_context.option_enable(cmd, opt_verbose));
 
+  /* Keep the options, which are checked by downstream commands */
+  FabricBuildOptions build_options;
+  build_options.frame_view = cmd_context.option_enable(cmd, opt_frame_view);
+  build_options.bitstream_only =
+    cmd_context.option_enable(cmd, opt_bitstream_only);
+  build_options.duplicate_grid_pin =
+    cmd_context.option_enable(cmd, opt_duplicate_grid_pin);
+  build_options.group_config_block =
+    cmd_context.option_enable(cmd, opt_group_config_block);
+  build_options.name_module_using_index =
+    cmd_context.option_enable(cmd, opt_name_module_using_index);
+  openfpga_ctx.mutable_flow_manager().mutable_fabric_build_options() =
+    build_options;
+
+  /* A bitstream built for the previous fabric can not be updated */
+  openfpga_ctx.mutable_device_bitstream_digest().clear();
+
   /* If there is any error, final status cannot be overwritten by a success flag
    */
   if (CMD_EXEC_SUCCESS != curr_status) {
@@ -246,6 +282,26 @@ int build_fabric_template(T& openfpga_ctx, const Command& cmd,
   return final_status;
 }
 
+/********************************************************************
+ * Netlist writers require the nets of datapath ports, which are not built
+ * when the module graph is built for bitstream generation only.
+ * Error out in such case rather than writing incomplete netlists
+ *******************************************************************/
+template <class T>
+int check_complete_fabric_module_graph_template(const T& openfpga_ctx,
+                                                const Command& cmd) {
+  if (true ==
+      openfpga_ctx.flow_manager().fabric_build_options().bitstream_only) {
+    VTR_LOG_ERROR(
+      "Command '%s' requires the nets of datapath ports, which are not built "
+      "by 'build_fabric --bitstream_only'! Please run 'build_fabric' without "
+      "the option '--bitstream_only'.\n",
+      cmd.name().c_str());
+    return CMD_EXEC_FATAL_ERROR;
+  }
+  return CMD_EXEC_SUCCESS;
+}
+
 /********************************************************************
  * Write fabric key of the module graph for FPGA device to a file
  *******************************************************************/
@@ -375,6 +431,9 @@ int add_fpga_core_to_fabric_template(T& openfpga_ctx, const Command& cmd,
                          openfpga_ctx.mutable_io_name_map());
   }
 
+  /* A bitstream built for the previous fabric can not be updated */
+  openfpga_ctx.mutable_device_bitstream_digest().clear();
+
   return add_fpga_core_to_device_module_graph(
     openfpga_ctx.mutable_module_graph(), openfpga_ctx.mutable_module_name_map(),
     openfpga_ctx.io_name_map(), core_inst_name, frame_view, verbose_output);
@@ -398,13 +457,23 @@ int rename_modules_template(T& openfpga_ctx, const Command& cmd,
 
   std::string file_name = cmd_context.option_value(cmd, opt_file);
 
+  CommandOptionId opt_cache = cmd.option("cache");
+  std::string cache_fname;
+  if (true == cmd_context.option_enable(cmd, opt_cache)) {
+    cache_fname = cmd_context.option_value(cmd, opt_cache);
+  }
+
   int status = CMD_EXEC_SUCCESS;
   ModuleNameMap user_module_name_map;
-  status = read_xml_module_name_map(file_name.c_str(), user_module_name_map);
+  status = read_xml_module_name_map(file_name.c_str(), user_module_name_map,
+                                    cache_fname);
   if (status != CMD_EXEC_SUCCESS) {
     return CMD_EXEC_FATAL_ERROR;
   }
 
+  /* A bitstream built for the previous fabric can not be updated */
+  openfpga_ctx.mutable_device_bitstream_digest().clear();
+
   /* Apply renaming on the user version */
   status = partial_rename_fabric_modules(
     openfpga_ctx.mutable_module_graph(), user_module_name_map,
@@ -544,6 +613,117 @@ int write_unique_blocks_template(T& openfpga_ctx, const Command& cmd,
   }
 }
 
+/********************************************************************
+ * Digest of the architectures and the routing resource graph that the
+ * fabric is built for, which identifies the fabric in a checkpoint
+ *******************************************************************/
+template <class T>
+uint64_t fabric_checkpoint_arch_digest(const T& openfpga_ctx) {
+  std::ostringstream arch_id;
+  arch_id << g_vpr_ctx.device().arch->architecture_id << ':'
+          << openfpga_ctx.flow_manager().arch_digest() << ':'
+          << g_vpr_ctx.device().rr_graph.num_nodes();
+  std::string arch_id_str = arch_id.str();
+  return file_digest(arch_id_str.data(), arch_id_str.size());
+}
+
+/********************************************************************
+ * Write the data structures built by 'build_fabric' to a checkpoint file,
+ * which can be restored by 'read_fabric_checkpoint' in another run
+ *******************************************************************/
+template <class T>
+int write_fabric_checkpoint_template(const T& openfpga_ctx, const Command& cmd,
+                                     const CommandContext& cmd_context) {
+  CommandOptionId opt_file = cmd.option("file");
+  CommandOptionId opt_verbose = cmd.option("verbose");
+
+  /* Check the option '--file' is enabled or not
+   * Actually, it must be enabled as the shell interface will check
+   * before reaching this fuction
+   */
+  VTR_ASSERT(true == cmd_context.option_enable(cmd, opt_file));
+  VTR_ASSERT(false == cmd_context.option_value(cmd, opt_file).empty());
+
+  /* A checkpoint is always restored as a complete module graph */
+  int status =
+    check_complete_fabric_module_graph_template<T>(openfpga_ctx, cmd);
+  if (CMD_EXEC_SUCCESS != status) {
+    return status;
+  }
+
+  const FabricBuildOptions& build_options =
+    openfpga_ctx.flow_manager().fabric_build_options();
+  FabricCheckpointHeader header;
+  header.arch_digest = fabric_checkpoint_arch_digest<T>(openfpga_ctx);
+  header.frame_view = build_options.frame_view;
+  header.duplicate_grid_pin = build_options.duplicate_grid_pin;
+  header.group_config_block = build_options.group_config_block;
+  header.name_module_using_index = build_options.name_module_using_index;
+
+  return write_fabric_checkpoint(
+    cmd_context.option_value(cmd, opt_file), g_vpr_ctx.device().grid, header,
+    openfpga_ctx.device_rr_gsb(), openfpga_ctx.module_graph(),
+    openfpga_ctx.decoder_lib(), openfpga_ctx.blwl_shift_register_banks(),
+    openfpga_ctx.fabric_tile(), openfpga_ctx.module_name_map(),
+    cmd_context.option_enable(cmd, opt_verbose));
+}
+
+/********************************************************************
+ * Restore the data structures of 'build_fabric' from a checkpoint file
+ * Data structures which are derived from the module graph are rebuilt in
+ * the same way as 'build_fabric' does
+ *******************************************************************/
+template <class T>
+int read_fabric_checkpoint_template(T& openfpga_ctx, const Command& cmd,
+                                    const CommandContext& cmd_context) {
+  CommandOptionId opt_file = cmd.option("file");
+  CommandOptionId opt_verbose = cmd.option("verbose");
+
+  VTR_ASSERT(true == cmd_context.option_enable(cmd, opt_file));
+  VTR_ASSERT(false == cmd_context.option_value(cmd, opt_file).empty());
+
+  FabricCheckpointHeader header;
+  header.arch_digest = fabric_checkpoint_arch_digest<T>(openfpga_ctx);
+  int status = read_fabric_checkpoint(
+    cmd_context.option_value(cmd, opt_file), g_vpr_ctx.device().grid, header,
+    openfpga_ctx.mutable_device_rr_gsb(), openfpga_ctx.mutable_module_graph(),
+    openfpga_ctx.mutable_decoder_lib(),
+    openfpga_ctx.mutable_blwl_shift_register_banks(),
+    openfpga_ctx.mutable_fabric_tile(), openfpga_ctx.mutable_module_name_map(),
+    cmd_context.option_enable(cmd, opt_verbose));
+  if (CMD_EXEC_SUCCESS != status) {
+    return status;
+  }
+
+  if (true == openfpga_ctx.device_rr_gsb().is_compressed()) {
+    openfpga_ctx.mutable_flow_manager().set_compress_routing(true);
+  }
+  /* A checkpoint always contains a complete module graph */
+  FabricBuildOptions build_options;
+  build_options.frame_view = header.frame_view;
+  build_options.duplicate_grid_pin = header.duplicate_grid_pin;
+  build_options.group_config_block = header.group_config_block;
+  build_options.name_module_using_index = header.name_module_using_index;
+  openfpga_ctx.mutable_flow_manager().mutable_fabric_build_options() =
+    build_options;
+
+  /* A bitstream built for the previous fabric can not be updated */
+  openfpga_ctx.mutable_device_bitstream_digest().clear();
+
+  /* Build I/O location map. Fabric tiles exist only when tiles are grouped */
+  openfpga_ctx.mutable_io_location_map() = build_fabric_io_location_map(
+    openfpga_ctx.module_graph(), g_vpr_ctx.device().grid,
+    !openfpga_ctx.fabric_tile().empty());
+
+  /* Build fabric global port information */
+  openfpga_ctx.mutable_fabric_global_port_info() =
+    build_fabric_global_port_info(
+      openfpga_ctx.module_graph(), openfpga_ctx.arch().config_protocol,
+      openfpga_ctx.arch().tile_annotations, openfpga_ctx.arch().circuit_lib);
+
+  return CMD_EXEC_SUCCESS;
+}
+
 /********************************************************************
  *  Report reference to a file
  *******************************************************************/
@@ -0,0 +1,42 @@
+/********************************************************************
+ * This file includes functions to parse the options which are shared
+ * by several commands of the OpenFPGA shell
+ *******************************************************************/
+#include "openfpga_command_utils.h"
+
+#include <cstdlib>
+
+#include "command_exit_codes.h"
+#include "vtr_log.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/********************************************************************
+ * Parse the option '--threads' of a command.
+ * The number of threads is left unchanged when the option is not enabled,
+ * so that the caller can decide the default value.
+ * Error out if the number of threads is not a positive number
+ *******************************************************************/
+int read_num_threads_option(const Command& cmd,
+                            const CommandContext& cmd_context,
+                            size_t& num_threads) {
+  CommandOptionId opt_threads = cmd.option("threads");
+  if (false == cmd_context.option_enable(cmd, opt_threads)) {
+    return CMD_EXEC_SUCCESS;
+  }
+
+  int num_threads_value =
+    std::atoi(cmd_context.option_value(cmd, opt_threads).c_str());
+  if (num_threads_value < 1) {
+    VTR_LOG_ERROR(
+      "Invalid number of threads '%d'! Expect a positive number.\n",
+      num_threads_value);
+    return CMD_EXEC_FATAL_ERROR;
+  }
+  num_threads = num_threads_value;
+
+  return CMD_EXEC_SUCCESS;
+}
+
+} /* end namespace openfpga */
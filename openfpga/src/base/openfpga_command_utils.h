@@ -0,0 +1,25 @@
+#ifndef OPENFPGA_COMMAND_UTILS_H
+#define OPENFPGA_COMMAND_UTILS_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include <cstddef>
+
+#include "command.h"
+#include "command_context.h"
+
+/********************************************************************
+ * Function declaration
+ *******************************************************************/
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+int read_num_threads_option(const Command& cmd,
+                            const CommandContext& cmd_context,
+                            size_t& num_threads);
+
+} /* end namespace openfpga */
+
+#endif
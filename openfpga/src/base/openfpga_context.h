@@ -7,6 +7,7 @@
 #include "bitstream_setting.h"
 #include "clock_network.h"
 #include "decoder_library.h"
+#include "device_bitstream_digest.h"
 #include "device_rr_gsb.h"
 #include "fabric_bitstream.h"
 #include "fabric_global_port_info.h"
@@ -104,6 +105,9 @@ class OpenfpgaContext : public Context {
   const openfpga::FabricBitstream& fabric_bitstream() const {
     return fabric_bitstream_;
   }
+  const openfpga::DeviceBitstreamDigest& device_bitstream_digest() const {
+    return device_bitstream_digest_;
+  }
   const openfpga::IoLocationMap& io_location_map() const {
     return io_location_map_;
   }
@@ -167,6 +171,9 @@ class OpenfpgaContext : public Context {
   openfpga::FabricBitstream& mutable_fabric_bitstream() {
     return fabric_bitstream_;
   }
+  openfpga::DeviceBitstreamDigest& mutable_device_bitstream_digest() {
+    return device_bitstream_digest_;
+  }
   openfpga::IoLocationMap& mutable_io_location_map() {
     return io_location_map_;
   }
@@ -237,6 +244,9 @@ class OpenfpgaContext : public Context {
   /* Bitstream database */
   openfpga::BitstreamManager bitstream_manager_;
   openfpga::FabricBitstream fabric_bitstream_;
+  /* Digests of the implementation which the bitstream is built from, used
+   * to update the bitstream incrementally */
+  openfpga::DeviceBitstreamDigest device_bitstream_digest_;
 
   /* Netlist database
    * TODO: Each format should have an independent entry
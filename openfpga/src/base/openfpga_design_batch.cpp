@@ -0,0 +1,201 @@
+/********************************************************************
+ * This file includes functions to run a batch of designs on the same
+ * fabric in one shell session.
+ *
+ * The architecture, the device and the fabric (module graph, etc.) are
+ * built once by the commands executed before the batch. For each design
+ * listed in a manifest
+ * - the design-dependent data of OpenFPGA context is reset
+ * - the packing/placement/routing results of the design are loaded on the
+ *   device built by 'vpr', and annotated in the same way as
+ *   'link_openfpga_arch' does
+ * - a design-specific script is executed, which typically runs 'repack',
+ *   'build_architecture_bitstream', 'build_fabric_bitstream' and writes the
+ *   bitstream
+ * The status of the commands using the results of a design is reset as
+ * well, so that a script which misses any of them fails on the dependency
+ * checks of the shell.
+ *
+ * Designs are run one by one, as VPR keeps the results of a design in its
+ * global context.
+ *******************************************************************/
+#include "openfpga_design_batch.h"
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "command_exit_codes.h"
+#include "openfpga_link_arch_template.h"
+#include "openfpga_tokenizer.h"
+#include "vpr_main.h"
+#include "vtr_log.h"
+#include "vtr_time.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/* A design to run in the batch: a name for reporting, the circuit which VPR
+ * implements and the script */
+struct BatchDesign {
+  std::string name;
+  std::string circuit;
+  std::string script;
+};
+
+/********************************************************************
+ * Read the manifest of a batch. Each line includes the name of a design,
+ * the path to its circuit and the path to its script, e.g.,
+ *   and2 ./and2/and2.blif ./and2/openfpga_bitstream.openfpga
+ * Empty lines and lines starting with '#' are skipped.
+ *******************************************************************/
+static int read_design_batch_manifest(const std::string& fname,
+                                      std::vector<BatchDesign>& designs) {
+  std::ifstream fp(fname);
+  if (!fp.is_open()) {
+    VTR_LOG_ERROR("Fail to open the manifest file: %s!\n", fname.c_str());
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  std::string line;
+  size_t line_num = 0;
+  while (getline(fp, line)) {
+    line_num++;
+    StringToken line_tokenizer(line);
+    std::vector<std::string> tokens = line_tokenizer.split(" \t\r");
+    if (tokens.empty() || '#' == tokens[0].front()) {
+      continue;
+    }
+    if (3 != tokens.size()) {
+      VTR_LOG_ERROR(
+        "Invalid line %lu in manifest file '%s'! Expect '<design_name> "
+        "<circuit_file> <script_file>'.\n",
+        line_num, fname.c_str());
+      return CMD_EXEC_FATAL_ERROR;
+    }
+    designs.push_back({tokens[0], tokens[1], tokens[2]});
+  }
+  fp.close();
+
+  return CMD_EXEC_SUCCESS;
+}
+
+/********************************************************************
+ * Reset the data in OpenFPGA context which depend on the design
+ * implemented on the fabric. The architecture, the device annotations and
+ * the fabric are kept, as they depend only on the architecture and device
+ * which are not loaded again.
+ * Note that the simulation settings annotated by 'link_openfpga_arch' are
+ * kept as well, as they are not used by bitstream generation.
+ * The bitstream databases are kept too, so that a design script can update
+ * them incrementally with the option '--incremental' of the bitstream
+ * commands. They can not be written before being rebuilt or updated, as
+ * the bitstream commands depend on 'repack', which is reset
+ *******************************************************************/
+void reset_design_dependent_context(OpenfpgaContext& openfpga_ctx) {
+  openfpga_ctx.mutable_vpr_netlist_annotation() = VprNetlistAnnotation();
+  openfpga_ctx.mutable_vpr_clustering_annotation() = VprClusteringAnnotation();
+  openfpga_ctx.mutable_vpr_placement_annotation() = VprPlacementAnnotation();
+  openfpga_ctx.mutable_vpr_routing_annotation() = VprRoutingAnnotation();
+  openfpga_ctx.mutable_verilog_netlists() = NetlistManager();
+  openfpga_ctx.mutable_spice_netlists() = NetlistManager();
+}
+
+/********************************************************************
+ * Mark the commands which use the results of the previous design as never
+ * executed, so that the dependency checks of the shell force the design
+ * script to run them again.
+ * - Commands which modify the results of a design are reset alone
+ * - Commands which build data from the results of a design are reset
+ *   together with all the commands depending on them
+ *******************************************************************/
+static void reset_design_dependent_commands(
+  openfpga::Shell<OpenfpgaContext>* shell) {
+  for (const char* cmd_name :
+       {"route_clock_rr_graph", "pb_pin_fixup", "lut_truth_table_fixup"}) {
+    ShellCommandId cmd_id = shell->command(std::string(cmd_name));
+    if (shell->valid_command_id(cmd_id)) {
+      shell->reset_command_status(cmd_id);
+    }
+  }
+  for (const char* cmd_name : {"repack"}) {
+    ShellCommandId cmd_id = shell->command(std::string(cmd_name));
+    if (shell->valid_command_id(cmd_id)) {
+      shell->reset_command_status(cmd_id, true);
+    }
+  }
+}
+
+/********************************************************************
+ * Run a single design of the batch. The packing, placement and routing
+ * results are read from the files which VPR writes by default, i.e., the
+ * circuit file with its extension replaced by '.net', '.place' and '.route'
+ *******************************************************************/
+static int run_batch_design(openfpga::Shell<OpenfpgaContext>* shell,
+                            OpenfpgaContext& openfpga_ctx,
+                            const BatchDesign& design) {
+  vtr::ScopedStartFinishTimer timer("Run design '" + design.name + "'");
+
+  reset_design_dependent_context(openfpga_ctx);
+  reset_design_dependent_commands(shell);
+
+  std::string result_prefix = design.circuit;
+  size_t ext_pos = result_prefix.find_last_of('.');
+  size_t dir_pos = result_prefix.find_last_of('/');
+  if (std::string::npos != ext_pos &&
+      (std::string::npos == dir_pos || ext_pos > dir_pos)) {
+    result_prefix.erase(ext_pos);
+  }
+
+  if (CMD_EXEC_SUCCESS !=
+      vpr::vpr_load_results(design.circuit, result_prefix + ".net",
+                            result_prefix + ".place",
+                            result_prefix + ".route")) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  if (CMD_EXEC_SUCCESS !=
+      annotate_vpr_results_template<OpenfpgaContext>(openfpga_ctx, false)) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  return shell->execute_script(design.script.c_str(), openfpga_ctx);
+}
+
+/********************************************************************
+ * Top-level function of the command 'run_design_batch'
+ *******************************************************************/
+int run_design_batch(openfpga::Shell<OpenfpgaContext>* shell,
+                     OpenfpgaContext& openfpga_ctx, const Command& cmd,
+                     const CommandContext& cmd_context) {
+  CommandOptionId opt_manifest = cmd.option("manifest");
+
+  vtr::ScopedStartFinishTimer timer("Run a batch of designs");
+
+  std::vector<BatchDesign> designs;
+  if (CMD_EXEC_SUCCESS !=
+      read_design_batch_manifest(cmd_context.option_value(cmd, opt_manifest),
+                                 designs)) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  VTR_LOG("Run %lu designs\n", designs.size());
+
+  size_t num_failed = 0;
+  for (const BatchDesign& design : designs) {
+    if (CMD_EXEC_FATAL_ERROR == run_batch_design(shell, openfpga_ctx, design)) {
+      VTR_LOG_ERROR("Design '%s' failed!\n", design.name.c_str());
+      num_failed++;
+    }
+  }
+
+  VTR_LOG("%lu of %lu designs succeeded\n", designs.size() - num_failed,
+          designs.size());
+
+  if (0 < num_failed) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
+  return CMD_EXEC_SUCCESS;
+}
+
+} /* end namespace openfpga */
@@ -0,0 +1,27 @@
+#ifndef OPENFPGA_DESIGN_BATCH_H
+#define OPENFPGA_DESIGN_BATCH_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include "command.h"
+#include "command_context.h"
+#include "openfpga_context.h"
+#include "shell.h"
+
+/********************************************************************
+ * Function declaration
+ *******************************************************************/
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+void reset_design_dependent_context(OpenfpgaContext& openfpga_ctx);
+
+int run_design_batch(openfpga::Shell<OpenfpgaContext>* shell,
+                     OpenfpgaContext& openfpga_ctx, const Command& cmd,
+                     const CommandContext& cmd_context);
+
+} /* end namespace openfpga */
+
+#endif
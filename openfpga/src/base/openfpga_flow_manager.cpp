@@ -14,6 +14,7 @@ namespace openfpga {
 FlowManager::FlowManager() {
   /* Turn off compress_routing as default */
   compress_routing_ = false;
+  arch_digest_ = 0;
 }
 
 /**************************************************
@@ -21,6 +22,12 @@ FlowManager::FlowManager() {
  *************************************************/
 bool FlowManager::compress_routing() const { return compress_routing_; }
 
+const FabricBuildOptions& FlowManager::fabric_build_options() const {
+  return fabric_build_options_;
+}
+
+uint64_t FlowManager::arch_digest() const { return arch_digest_; }
+
 /******************************************************************************
  * Private Mutators
  ******************************************************************************/
@@ -28,4 +35,12 @@ void FlowManager::set_compress_routing(const bool& enabled) {
   compress_routing_ = enabled;
 }
 
+FabricBuildOptions& FlowManager::mutable_fabric_build_options() {
+  return fabric_build_options_;
+}
+
+void FlowManager::set_arch_digest(const uint64_t& digest) {
+  arch_digest_ = digest;
+}
+
 } /* end namespace openfpga */
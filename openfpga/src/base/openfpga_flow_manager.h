@@ -4,9 +4,24 @@
 /********************************************************************
  * Include header files required by the data structure definition
  *******************************************************************/
+#include <cstdint>
+
 /* Begin namespace openfpga */
 namespace openfpga {
 
+/********************************************************************
+ * Options which the module graph of the fabric is built with.
+ * They are kept so that downstream commands can check if the module graph
+ * is applicable, e.g., netlists cannot be written in a bitstream-only view
+ *******************************************************************/
+struct FabricBuildOptions {
+  bool frame_view = false;
+  bool bitstream_only = false;
+  bool duplicate_grid_pin = false;
+  bool group_config_block = false;
+  bool name_module_using_index = false;
+};
+
 /********************************************************************
  * FlowManager aims to resolve the dependency between OpenFPGA functional
  * code blocks
@@ -20,12 +35,20 @@ class FlowManager {
 
  public: /* Public accessors */
   bool compress_routing() const;
+  const FabricBuildOptions& fabric_build_options() const;
+  /* Digest of the OpenFPGA architecture file, which identifies the
+   * architecture that a fabric is built for */
+  uint64_t arch_digest() const;
 
  public: /* Public mutators */
   void set_compress_routing(const bool& enabled);
+  FabricBuildOptions& mutable_fabric_build_options();
+  void set_arch_digest(const uint64_t& digest);
 
  private: /* Internal Data */
   bool compress_routing_;
+  FabricBuildOptions fabric_build_options_;
+  uint64_t arch_digest_;
 };
 
 } /* End namespace openfpga*/
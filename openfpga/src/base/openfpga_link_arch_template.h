@@ -33,6 +33,45 @@
 /* begin namespace openfpga */
 namespace openfpga {
 
+/********************************************************************
+ * Annotate the packing, placement and routing results of the design
+ * implemented by VPR. These are the only annotations which depend on the
+ * design rather than the architecture and the device, so that they can be
+ * built again when the results of another design are loaded
+ *******************************************************************/
+template <class T>
+int annotate_vpr_results_template(T& openfpga_ctx, const bool& verbose) {
+  /* Annotate routing results:
+   * - net mapping to each rr_node
+   * - previous nodes driving each rr_node
+   */
+  openfpga_ctx.mutable_vpr_routing_annotation().init(
+    g_vpr_ctx.device().rr_graph);
+
+  annotate_vpr_rr_node_nets(g_vpr_ctx.device(), g_vpr_ctx.clustering(),
+                            openfpga_ctx.mutable_vpr_routing_annotation(),
+                            verbose);
+
+  annotate_rr_node_previous_nodes(g_vpr_ctx.device(), g_vpr_ctx.clustering(),
+                                  openfpga_ctx.mutable_vpr_routing_annotation(),
+                                  verbose);
+
+  /* Annotate clustering results */
+  if (CMD_EXEC_FATAL_ERROR ==
+      annotate_post_routing_cluster_sync_results(
+        g_vpr_ctx.clustering(),
+        openfpga_ctx.mutable_vpr_clustering_annotation())) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  /* Annotate placement results */
+  annotate_mapped_blocks(g_vpr_ctx.device(), g_vpr_ctx.clustering(),
+                         g_vpr_ctx.placement(),
+                         openfpga_ctx.mutable_vpr_placement_annotation());
+
+  return CMD_EXEC_SUCCESS;
+}
+
 /********************************************************************
  * Top-level function to link openfpga architecture to VPR, including:
  * - physical pb_type
@@ -74,28 +113,18 @@ int link_arch_template(T& openfpga_ctx, const Command& cmd,
                     openfpga_ctx.mutable_vpr_device_annotation(),
                     cmd_context.option_enable(cmd, opt_verbose));
 
+  /* Build dense look-ups for pb_type and pb_graph annotations, which are
+   * frequently queried by repack, bitstream generator and fabric builder */
+  openfpga_ctx.mutable_vpr_device_annotation().finalize();
+
   /* Annotate routing architecture to circuit library */
   annotate_rr_graph_circuit_models(g_vpr_ctx.device(), openfpga_ctx.arch(),
                                    openfpga_ctx.mutable_vpr_device_annotation(),
                                    cmd_context.option_enable(cmd, opt_verbose));
 
-  /* Annotate routing results:
-   * - net mapping to each rr_node
-   * - previous nodes driving each rr_node
-   */
-  openfpga_ctx.mutable_vpr_routing_annotation().init(
-    g_vpr_ctx.device().rr_graph);
-
   // Incase the incoming edges are not built. This may happen when loading
   // rr_graph from an external file
   g_vpr_ctx.mutable_device().rr_graph_builder.build_in_edges();
-  annotate_vpr_rr_node_nets(g_vpr_ctx.device(), g_vpr_ctx.clustering(),
-                            openfpga_ctx.mutable_vpr_routing_annotation(),
-                            cmd_context.option_enable(cmd, opt_verbose));
-
-  annotate_rr_node_previous_nodes(g_vpr_ctx.device(), g_vpr_ctx.clustering(),
-                                  openfpga_ctx.mutable_vpr_routing_annotation(),
-                                  cmd_context.option_enable(cmd, opt_verbose));
 
   /* Build the routing graph annotation
    * - RRGSB
@@ -132,19 +161,13 @@ int link_arch_template(T& openfpga_ctx, const Command& cmd,
     g_vpr_ctx.device(), openfpga_ctx.arch().arch_direct,
     cmd_context.option_enable(cmd, opt_verbose));
 
-  /* Annotate clustering results */
+  /* Annotate routing, clustering and placement results */
   if (CMD_EXEC_FATAL_ERROR ==
-      annotate_post_routing_cluster_sync_results(
-        g_vpr_ctx.clustering(),
-        openfpga_ctx.mutable_vpr_clustering_annotation())) {
+      annotate_vpr_results_template(
+        openfpga_ctx, cmd_context.option_enable(cmd, opt_verbose))) {
     return CMD_EXEC_FATAL_ERROR;
   }
 
-  /* Annotate placement results */
-  annotate_mapped_blocks(g_vpr_ctx.device(), g_vpr_ctx.clustering(),
-                         g_vpr_ctx.placement(),
-                         openfpga_ctx.mutable_vpr_placement_annotation());
-
   /* Read activity file is manadatory in the following flow-run settings
    * - When users specify that number of clock cycles
    *   should be inferred from FPGA implmentation
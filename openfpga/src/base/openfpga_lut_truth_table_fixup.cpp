@@ -10,6 +10,7 @@
 /* Headers from vpr library */
 #include "lut_utils.h"
 #include "openfpga_lut_truth_table_fixup.h"
+#include "openfpga_parallel.h"
 #include "pb_type_utils.h"
 #include "vpr_utils.h"
 
@@ -28,7 +29,8 @@ namespace openfpga {
  *******************************************************************/
 static void fix_up_lut_atom_block_truth_table(
   const AtomContext& atom_ctx, t_pb* pb, const t_pb_routes& pb_route,
-  VprClusteringAnnotation& vpr_clustering_annotation, const bool& verbose) {
+  std::vector<std::pair<t_pb*, AtomNetlist::TruthTable>>& adapt_tts,
+  const bool& verbose) {
   t_pb_graph_node* pb_graph_node = pb->pb_graph_node;
   t_pb_type* pb_type = pb->pb_graph_node->pb_type;
 
@@ -88,9 +90,9 @@ static void fix_up_lut_atom_block_truth_table(
      */
     const AtomNetlist::TruthTable& orig_tt =
       atom_ctx.nlist.block_truth_table(atom_blk);
-    const AtomNetlist::TruthTable& adapt_tt =
-      lut_truth_table_adaption(orig_tt, rotated_pin_map);
-    vpr_clustering_annotation.adapt_truth_table(pb, adapt_tt);
+    adapt_tts.emplace_back(pb,
+                           lut_truth_table_adaption(orig_tt, rotated_pin_map));
+    const AtomNetlist::TruthTable& adapt_tt = adapt_tts.back().second;
 
     /* Print info is in the verbose mode */
     VTR_LOGV(verbose, "Original truth table\n");
@@ -134,7 +136,8 @@ static void fix_up_lut_atom_block_truth_table(
  *******************************************************************/
 static void rec_adapt_lut_pb_tt(
   const AtomContext& atom_ctx, t_pb* pb, const t_pb_routes& pb_route,
-  VprClusteringAnnotation& vpr_clustering_annotation, const bool& verbose) {
+  std::vector<std::pair<t_pb*, AtomNetlist::TruthTable>>& adapt_tts,
+  const bool& verbose) {
   t_pb_graph_node* pb_graph_node = pb->pb_graph_node;
 
   /* If we reach a primitive pb_graph node, we return */
@@ -148,7 +151,7 @@ static void rec_adapt_lut_pb_tt(
        */
       if (1 == pb->mode) {
         fix_up_lut_atom_block_truth_table(atom_ctx, pb->child_pbs[0], pb_route,
-                                          vpr_clustering_annotation, verbose);
+                                          adapt_tts, verbose);
       }
     }
     return;
@@ -163,7 +166,7 @@ static void rec_adapt_lut_pb_tt(
       if ((pb->child_pbs[ipb] != nullptr) &&
           (pb->child_pbs[ipb][jpb].name != nullptr)) {
         rec_adapt_lut_pb_tt(atom_ctx, &(pb->child_pbs[ipb][jpb]), pb_route,
-                            vpr_clustering_annotation, verbose);
+                            adapt_tts, verbose);
       }
     }
   }
@@ -172,14 +175,30 @@ static void rec_adapt_lut_pb_tt(
 /********************************************************************
  * Main function to fix up truth table for each LUT used in FPGA
  * This function will walk through each clustered block
+ *
+ * The clustered blocks are independent, so they are visited by a number of
+ * threads. Each block collects its adapted truth tables in a dedicated slot,
+ * which are added to the annotation in the sequence of blocks afterwards.
  *******************************************************************/
 void update_lut_tt_with_post_packing_results(
   const AtomContext& atom_ctx, const ClusteringContext& clustering_ctx,
-  VprClusteringAnnotation& vpr_clustering_annotation, const bool& verbose) {
+  VprClusteringAnnotation& vpr_clustering_annotation, const size_t& num_threads,
+  const bool& verbose) {
+  std::vector<ClusterBlockId> blocks;
   for (auto blk_id : clustering_ctx.clb_nlist.blocks()) {
-    rec_adapt_lut_pb_tt(atom_ctx, clustering_ctx.clb_nlist.block_pb(blk_id),
-                        clustering_ctx.clb_nlist.block_pb(blk_id)->pb_route,
-                        vpr_clustering_annotation, verbose);
+    blocks.push_back(blk_id);
+  }
+
+  std::vector<std::vector<std::pair<t_pb*, AtomNetlist::TruthTable>>>
+    block_adapt_tts(blocks.size());
+  parallel_for(blocks.size(), num_threads, [&](const size_t& iblk) {
+    t_pb* pb = clustering_ctx.clb_nlist.block_pb(blocks[iblk]);
+    rec_adapt_lut_pb_tt(atom_ctx, pb, pb->pb_route, block_adapt_tts[iblk],
+                        verbose);
+  });
+
+  for (const auto& adapt_tts : block_adapt_tts) {
+    vpr_clustering_annotation.adapt_truth_tables(adapt_tts);
   }
 }
 
@@ -7,8 +7,10 @@
 #include "command.h"
 #include "command_context.h"
 #include "command_exit_codes.h"
+#include "openfpga_command_utils.h"
 #include "openfpga_context.h"
 #include "openfpga_lut_truth_table_fixup.h"
+#include "vtr_log.h"
 #include "vtr_time.h"
 
 /********************************************************************
@@ -37,10 +39,16 @@ int lut_truth_table_fixup_template(T& openfpga_context, const Command& cmd,
 
   CommandOptionId opt_verbose = cmd.option("verbose");
 
+  size_t num_threads = 1;
+  if (CMD_EXEC_SUCCESS !=
+      read_num_threads_option(cmd, cmd_context, num_threads)) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
   /* Apply fix-up to each packed block */
   update_lut_tt_with_post_packing_results(
     g_vpr_ctx.atom(), g_vpr_ctx.clustering(),
-    openfpga_context.mutable_vpr_clustering_annotation(),
+    openfpga_context.mutable_vpr_clustering_annotation(), num_threads,
     cmd_context.option_enable(cmd, opt_verbose));
 
   /* TODO: should identify the error code from internal function execution */
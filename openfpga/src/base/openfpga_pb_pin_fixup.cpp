@@ -2,6 +2,8 @@
  * This file includes functions to fix up the pb pin mapping results
  * after routing optimization
  *******************************************************************/
+#include <numeric>
+
 /* Headers from vtrutil library */
 #include "vtr_assert.h"
 #include "vtr_log.h"
@@ -15,6 +17,7 @@
 
 /* Headers from openfpgautil library */
 #include "openfpga_device_grid_utils.h"
+#include "openfpga_parallel.h"
 #include "openfpga_pb_pin_fixup.h"
 #include "openfpga_physical_tile_utils.h"
 #include "openfpga_side_manager.h"
@@ -345,25 +348,40 @@ static int update_cluster_pin_with_post_routing_results(
   return status;
 }
 
+/********************************************************************
+ * A clustered block to be fixed up, and where it is placed
+ *******************************************************************/
+struct PbPinFixupTask {
+  vtr::Point<size_t> grid_coord;
+  ClusterBlockId blk_id;
+  e_side border_side;
+};
+
 /********************************************************************
  * Main function to fix up the pb pin mapping results
  * This function will walk through each grid
+ *
+ * The fix-up of a clustered block only modifies the net remapping of the
+ * block itself. Therefore, the blocks are collected first and then fixed up
+ * by a number of threads, where the storage of net remapping is allocated
+ * for all the blocks in advance.
  *******************************************************************/
 int update_pb_pin_with_post_routing_results(
   const DeviceContext& device_ctx, const ClusteringContext& clustering_ctx,
   const PlacementContext& placement_ctx,
   const VprRoutingAnnotation& vpr_routing_annotation,
   VprClusteringAnnotation& vpr_clustering_annotation, const bool& perimeter_cb,
-  const bool& map_gnet2msb, const bool& verbose) {
-  int status = CMD_EXEC_SUCCESS;
-  size_t num_fixup = 0;
+  const bool& map_gnet2msb, const size_t& num_threads, const bool& verbose) {
   /* Confirm options */
   VTR_LOGV(verbose && map_gnet2msb,
            "User choose to map global net to the best fit MSB of input port\n");
   /* Ensure a clean start: remove all the remapping results from VTR's
    * post-routing clustering result sync-up */
   vpr_clustering_annotation.clear_net_remapping();
+  vpr_clustering_annotation.reserve_net_remapping(
+    clustering_ctx.clb_nlist.blocks().size());
 
+  std::vector<PbPinFixupTask> tasks;
   size_t layer = 0;
   /* Update the core logic (center blocks of the FPGA) */
   for (size_t x = 1; x < device_ctx.grid.width() - 1; ++x) {
@@ -385,15 +403,8 @@ int update_pb_pin_with_post_routing_results(
         }
         /* We know the entrance to grid info and mapping results, do the fix-up
          * for this block */
-        vtr::Point<size_t> grid_coord(x, y);
-        status = update_cluster_pin_with_post_routing_results(
-          device_ctx, clustering_ctx, vpr_routing_annotation,
-          vpr_clustering_annotation, layer, grid_coord, cluster_blk_id,
-          NUM_2D_SIDES, placement_ctx.block_locs()[cluster_blk_id].loc.sub_tile,
-          perimeter_cb, map_gnet2msb, num_fixup, verbose);
-        if (status != CMD_EXEC_SUCCESS) {
-          return CMD_EXEC_FATAL_ERROR;
-        }
+        tasks.push_back(
+          {vtr::Point<size_t>(x, y), cluster_blk_id, NUM_2D_SIDES});
       }
     }
   }
@@ -421,19 +432,32 @@ int update_pb_pin_with_post_routing_results(
           continue;
         }
         /* Update on I/O grid */
-        status = update_cluster_pin_with_post_routing_results(
-          device_ctx, clustering_ctx, vpr_routing_annotation,
-          vpr_clustering_annotation, layer, io_coord, cluster_blk_id, io_side,
-          placement_ctx.block_locs()[cluster_blk_id].loc.sub_tile, perimeter_cb,
-          map_gnet2msb, num_fixup, verbose);
-        if (status != CMD_EXEC_SUCCESS) {
-          return CMD_EXEC_FATAL_ERROR;
-        }
+        tasks.push_back({io_coord, cluster_blk_id, io_side});
       }
     }
   }
+
+  /* Each task owns its status and counter, which are merged in the end */
+  std::vector<int> task_status(tasks.size(), CMD_EXEC_SUCCESS);
+  std::vector<size_t> task_num_fixup(tasks.size(), 0);
+  parallel_for(tasks.size(), num_threads, [&](const size_t& itask) {
+    const PbPinFixupTask& task = tasks[itask];
+    task_status[itask] = update_cluster_pin_with_post_routing_results(
+      device_ctx, clustering_ctx, vpr_routing_annotation,
+      vpr_clustering_annotation, layer, task.grid_coord, task.blk_id,
+      task.border_side, placement_ctx.block_locs()[task.blk_id].loc.sub_tile,
+      perimeter_cb, map_gnet2msb, task_num_fixup[itask], verbose);
+  });
+
+  for (const int& status : task_status) {
+    if (status != CMD_EXEC_SUCCESS) {
+      return CMD_EXEC_FATAL_ERROR;
+    }
+  }
+  size_t num_fixup =
+    std::accumulate(task_num_fixup.begin(), task_num_fixup.end(), size_t(0));
   VTR_LOG("In total %lu fixup have been applied\n", num_fixup);
-  return status;
+  return CMD_EXEC_SUCCESS;
 }
 
 } /* end namespace openfpga */
@@ -8,7 +8,9 @@
 #include "command_context.h"
 #include "command_exit_codes.h"
 #include "globals.h"
+#include "openfpga_command_utils.h"
 #include "openfpga_pb_pin_fixup.h"
+#include "vtr_log.h"
 #include "vtr_time.h"
 
 /********************************************************************
@@ -38,13 +40,19 @@ int pb_pin_fixup_template(T& openfpga_context, const Command& cmd,
   CommandOptionId opt_map_gnet2msb = cmd.option("map_global_net_to_msb");
   CommandOptionId opt_verbose = cmd.option("verbose");
 
+  size_t num_threads = 1;
+  if (CMD_EXEC_SUCCESS !=
+      read_num_threads_option(cmd, cmd_context, num_threads)) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
   /* Apply fix-up to each grid */
   return update_pb_pin_with_post_routing_results(
     g_vpr_ctx.device(), g_vpr_ctx.clustering(), g_vpr_ctx.placement(),
     openfpga_context.vpr_routing_annotation(),
     openfpga_context.mutable_vpr_clustering_annotation(),
     g_vpr_ctx.device().arch->perimeter_cb,
-    cmd_context.option_enable(cmd, opt_map_gnet2msb),
+    cmd_context.option_enable(cmd, opt_map_gnet2msb), num_threads,
     cmd_context.option_enable(cmd, opt_verbose));
 }
 
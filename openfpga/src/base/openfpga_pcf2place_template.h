@@ -30,6 +30,7 @@ int pcf2place_wrapper_template(const Command& cmd,
   CommandOptionId opt_pcf = cmd.option("pcf");
   CommandOptionId opt_blif = cmd.option("blif");
   CommandOptionId opt_fpga_io_map = cmd.option("fpga_io_map");
+  CommandOptionId opt_fpga_io_map_cache = cmd.option("fpga_io_map_cache");
   CommandOptionId opt_pin_table = cmd.option("pin_table");
   CommandOptionId opt_fpga_fix_pins = cmd.option("fpga_fix_pins");
   CommandOptionId opt_no_time_stamp = cmd.option("no_time_stamp");
@@ -87,8 +88,13 @@ int pcf2place_wrapper_template(const Command& cmd,
     return CMD_EXEC_FATAL_ERROR;
   }
 
-  IoLocationMap io_location_map =
-    read_xml_io_location_map(fpga_io_map_fname.c_str());
+  std::string fpga_io_map_cache_fname;
+  if (true == cmd_context.option_enable(cmd, opt_fpga_io_map_cache)) {
+    fpga_io_map_cache_fname =
+      cmd_context.option_value(cmd, opt_fpga_io_map_cache);
+  }
+  IoLocationMap io_location_map = read_xml_io_location_map(
+    fpga_io_map_fname.c_str(), fpga_io_map_cache_fname);
   VTR_LOG("Read the I/O location map from an XML file: %s.\n",
           fpga_io_map_fname.c_str());
 
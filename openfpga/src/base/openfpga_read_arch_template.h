@@ -13,6 +13,7 @@
 #include "command_context.h"
 #include "command_exit_codes.h"
 #include "globals.h"
+#include "openfpga_file_cache.h"
 #include "read_xml_clock_network.h"
 #include "read_xml_openfpga_arch.h"
 #include "vtr_log.h"
@@ -46,6 +47,14 @@ int read_openfpga_arch_template(T& openfpga_context, const Command& cmd,
   openfpga_context.mutable_arch() =
     read_xml_openfpga_arch(arch_file_name.c_str());
 
+  /* Identify the architecture by its content, so that any data built for it,
+   * e.g., a fabric checkpoint, can be validated against it */
+  MappedFile arch_file;
+  if (arch_file.open(arch_file_name)) {
+    openfpga_context.mutable_flow_manager().set_arch_digest(
+      file_digest(arch_file.data(), arch_file.size()));
+  }
+
   /* Check the architecture:
    * 1. Circuit library
    * 2. Tile annotation
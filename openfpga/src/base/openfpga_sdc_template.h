@@ -11,6 +11,7 @@
 #include "configuration_chain_sdc_writer.h"
 #include "configure_port_sdc_writer.h"
 #include "globals.h"
+#include "openfpga_build_fabric_template.h"
 #include "openfpga_digest.h"
 #include "openfpga_scale.h"
 #include "pnr_sdc_writer.h"
@@ -195,6 +196,13 @@ int write_analysis_sdc_template(const T& openfpga_ctx, const Command& cmd,
   CommandOptionId opt_time_unit = cmd.option("time_unit");
   CommandOptionId opt_no_time_stamp = cmd.option("no_time_stamp");
 
+  /* Nets of datapath are required to trace the mapped nets */
+  int status =
+    check_complete_fabric_module_graph_template<T>(openfpga_ctx, cmd);
+  if (CMD_EXEC_SUCCESS != status) {
+    return status;
+  }
+
   /* This is an intermediate data structure which is designed to modularize the
    * FPGA-SDC Keep it independent from any other outside data structures
    */
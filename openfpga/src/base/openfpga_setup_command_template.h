@@ -331,6 +331,12 @@ ShellCommandId add_pb_pin_fixup_command_template(
     "to a best-fit Most Significant Bit (MSB) of input ports of programmable "
     "blocks. If not specified, a best-fit Least Significant Bit (LSB) will be "
     "the default choice");
+  /* Add an option '--threads' */
+  CommandOptionId threads_opt = shell_cmd.add_option(
+    "threads", false,
+    "Specify the number of threads to fix up independent grids in parallel. "
+    "Default: 1");
+  shell_cmd.set_option_require_value(threads_opt, openfpga::OPT_INT);
   /* Add an option '--verbose' */
   shell_cmd.add_option("verbose", false, "Show verbose outputs");
 
@@ -358,6 +364,12 @@ ShellCommandId add_lut_truth_table_fixup_command_template(
   openfpga::Shell<T>& shell, const ShellCommandClassId& cmd_class_id,
   const std::vector<ShellCommandId>& dependent_cmds, const bool& hidden) {
   Command shell_cmd("lut_truth_table_fixup");
+  /* Add an option '--threads' */
+  CommandOptionId threads_opt = shell_cmd.add_option(
+    "threads", false,
+    "Specify the number of threads to fix up independent clustered blocks in "
+    "parallel. Default: 1");
+  shell_cmd.set_option_require_value(threads_opt, openfpga::OPT_INT);
   /* Add an option '--verbose' */
   shell_cmd.add_option("verbose", false, "Show verbose outputs");
 
@@ -393,6 +405,12 @@ ShellCommandId add_build_fabric_command_template(
     "frame_view", false,
     "Build only frame view of the fabric (nets are skipped)");
 
+  /* Add an option '--bitstream_only' */
+  shell_cmd.add_option("bitstream_only", false,
+                       "Build only the configuration hierarchy of the fabric "
+                       "(nets of datapath are skipped and netlists cannot be "
+                       "written)");
+
   /* Add an option '--compress_routing' */
   shell_cmd.add_option("compress_routing", false,
                        "Compress the number of unique routing modules by "
@@ -412,6 +430,13 @@ ShellCommandId add_build_fabric_command_template(
     "load_fabric_key", false, "load the fabric key from the given file");
   shell_cmd.set_option_require_value(opt_load_fkey, openfpga::OPT_STRING);
 
+  /* Add an option '--fabric_key_cache' */
+  CommandOptionId opt_fkey_cache = shell_cmd.add_option(
+    "fabric_key_cache", false,
+    "load the fabric key from the given binary cache when the fabric key file "
+    "is not changed. Otherwise, the cache is rewritten");
+  shell_cmd.set_option_require_value(opt_fkey_cache, openfpga::OPT_STRING);
+
   /* Add an option '--write_fabric_key' */
   CommandOptionId opt_write_fkey = shell_cmd.add_option(
     "write_fabric_key", false, "output current fabric key to a file");
@@ -436,6 +461,13 @@ ShellCommandId add_build_fabric_command_template(
                        "Create a random fabric key which will shuffle the "
                        "memory address for encryption purpose");
 
+  /* Add an option '--threads' */
+  CommandOptionId threads_opt = shell_cmd.add_option(
+    "threads", false,
+    "Specify the number of threads to build unique routing and grid modules "
+    "in parallel. Default: 1");
+  shell_cmd.set_option_require_value(threads_opt, openfpga::OPT_INT);
+
   /* Add an option '--verbose' */
   shell_cmd.add_option("verbose", false, "Show verbose outputs");
 
@@ -575,6 +607,14 @@ ShellCommandId add_pcf2place_command_template(
   shell_cmd.set_option_require_value(opt_fpga_io_map_file,
                                      openfpga::OPT_STRING);
 
+  /* Add an option '--fpga_io_map_cache'*/
+  CommandOptionId opt_fpga_io_map_cache = shell_cmd.add_option(
+    "fpga_io_map_cache", false,
+    "file path to a binary cache of the FPGA I/O location map, which is "
+    "loaded when the map is not changed. Otherwise, the cache is rewritten");
+  shell_cmd.set_option_require_value(opt_fpga_io_map_cache,
+                                     openfpga::OPT_STRING);
+
   /* Add an option '--pin_table'*/
   CommandOptionId opt_pin_table_file = shell_cmd.add_option(
     "pin_table", true, "file path to the pin table (.csv)");
@@ -842,6 +882,13 @@ ShellCommandId add_rename_modules_command_template(
   shell_cmd.set_option_short_name(opt_file, "f");
   shell_cmd.set_option_require_value(opt_file, openfpga::OPT_STRING);
 
+  /* Add an option '--cache' */
+  CommandOptionId opt_cache = shell_cmd.add_option(
+    "cache", false,
+    "file path to a binary cache of the renaming rules, which is loaded when "
+    "the XML file is not changed. Otherwise, the cache is rewritten");
+  shell_cmd.set_option_require_value(opt_cache, openfpga::OPT_STRING);
+
   shell_cmd.add_option("verbose", false, "Show verbose outputs");
 
   /* Add command to the Shell */
@@ -1020,6 +1067,75 @@ ShellCommandId add_write_unique_blocks_command_template(
   return shell_cmd_id;
 }
 
+/********************************************************************
+ * - Add a command to Shell environment: write_fabric_checkpoint
+ * - Add associated options
+ * - Add command dependency
+ *******************************************************************/
+template <class T>
+ShellCommandId add_write_fabric_checkpoint_command_template(
+  openfpga::Shell<T>& shell, const ShellCommandClassId& cmd_class_id,
+  const std::vector<ShellCommandId>& dependent_cmds, const bool& hidden) {
+  Command shell_cmd("write_fabric_checkpoint");
+
+  /* Add an option '--file' in short '-f'*/
+  CommandOptionId opt_file = shell_cmd.add_option(
+    "file", true, "specify the file which the checkpoint is written to");
+  shell_cmd.set_option_short_name(opt_file, "f");
+  shell_cmd.set_option_require_value(opt_file, openfpga::OPT_STRING);
+
+  /* Add an option '--verbose' */
+  shell_cmd.add_option("verbose", false, "Show verbose outputs");
+
+  /* Add command to the Shell */
+  ShellCommandId shell_cmd_id = shell.add_command(
+    shell_cmd, "Write the fabric built by build_fabric to a checkpoint file",
+    hidden);
+  shell.set_command_class(shell_cmd_id, cmd_class_id);
+  shell.set_command_const_execute_function(
+    shell_cmd_id, write_fabric_checkpoint_template<T>);
+
+  /* Add command dependency to the Shell */
+  shell.set_command_dependency(shell_cmd_id, dependent_cmds);
+
+  return shell_cmd_id;
+}
+
+/********************************************************************
+ * - Add a command to Shell environment: read_fabric_checkpoint
+ * - Add associated options
+ * - Add command dependency
+ *******************************************************************/
+template <class T>
+ShellCommandId add_read_fabric_checkpoint_command_template(
+  openfpga::Shell<T>& shell, const ShellCommandClassId& cmd_class_id,
+  const std::vector<ShellCommandId>& dependent_cmds, const bool& hidden) {
+  Command shell_cmd("read_fabric_checkpoint");
+
+  /* Add an option '--file' in short '-f'*/
+  CommandOptionId opt_file = shell_cmd.add_option(
+    "file", true, "specify the checkpoint file to be read");
+  shell_cmd.set_option_short_name(opt_file, "f");
+  shell_cmd.set_option_require_value(opt_file, openfpga::OPT_STRING);
+
+  /* Add an option '--verbose' */
+  shell_cmd.add_option("verbose", false, "Show verbose outputs");
+
+  /* Add command to the Shell */
+  ShellCommandId shell_cmd_id = shell.add_command(
+    shell_cmd,
+    "Restore the fabric from a checkpoint file in place of build_fabric",
+    hidden);
+  shell.set_command_class(shell_cmd_id, cmd_class_id);
+  shell.set_command_execute_function(shell_cmd_id,
+                                     read_fabric_checkpoint_template<T>);
+
+  /* Add command dependency to the Shell */
+  shell.set_command_dependency(shell_cmd_id, dependent_cmds);
+
+  return shell_cmd_id;
+}
+
 /******************************************************************
  * - Add a command to Shell environment: report_reference
  * - Add associated options
@@ -1242,6 +1358,30 @@ void add_setup_command_templates(openfpga::Shell<T>& shell,
   ShellCommandId build_fabric_cmd_id = add_build_fabric_command_template<T>(
     shell, openfpga_setup_cmd_class, build_fabric_dependent_cmds, hidden);
 
+  /********************************
+   * Command 'write_fabric_checkpoint'
+   */
+  /* The command should NOT be executed before 'build_fabric' */
+  std::vector<ShellCommandId> cmd_dependency_write_fabric_checkpoint;
+  cmd_dependency_write_fabric_checkpoint.push_back(build_fabric_cmd_id);
+  add_write_fabric_checkpoint_command_template<T>(
+    shell, openfpga_setup_cmd_class, cmd_dependency_write_fabric_checkpoint,
+    hidden);
+
+  /********************************
+   * Command 'read_fabric_checkpoint'
+   */
+  /* The command should NOT be executed before 'link_openfpga_arch'.
+   * Once succeeded, it satisfies any dependency on 'build_fabric' */
+  std::vector<ShellCommandId> cmd_dependency_read_fabric_checkpoint;
+  cmd_dependency_read_fabric_checkpoint.push_back(link_arch_cmd_id);
+  ShellCommandId read_fabric_checkpoint_cmd_id =
+    add_read_fabric_checkpoint_command_template<T>(
+      shell, openfpga_setup_cmd_class, cmd_dependency_read_fabric_checkpoint,
+      hidden);
+  shell.add_command_alternative(build_fabric_cmd_id,
+                                read_fabric_checkpoint_cmd_id);
+
   /********************************
    * Command 'add_fpga_core_to_fabric'
    */
@@ -9,6 +9,7 @@
 #include "openfpga_setup_command.h"
 #include "openfpga_spice_command.h"
 #include "openfpga_title.h"
+#include "openfpga_trace.h"
 #include "openfpga_verilog_command.h"
 #include "vpr_command.h"
 
@@ -41,6 +42,10 @@ OpenfpgaShell::OpenfpgaShell() {
   openfpga::add_basic_commands(shell_);
 }
 
+const OpenfpgaContext& OpenfpgaShell::openfpga_context() const {
+  return openfpga_ctx_;
+}
+
 int OpenfpgaShell::run_command(const char* cmd_line) {
   return shell_.execute_command(cmd_line, openfpga_ctx_);
 }
@@ -50,6 +55,10 @@ void OpenfpgaShell::reset() {
   /* TODO: reset the data storage */
 }
 
+OpenfpgaContext& OpenfpgaShell::mutable_openfpga_context() {
+  return openfpga_ctx_;
+}
+
 int OpenfpgaShell::start(int argc, char** argv) {
   reset();
 
@@ -75,6 +84,16 @@ int OpenfpgaShell::start(int argc, char** argv) {
                          "Launch OpenFPGA in batch  mode when running scripts");
   start_cmd.set_option_short_name(opt_batch_exec, "batch");
 
+  /* '--trace': record a trace of the engines and write it to a file */
+  openfpga::CommandOptionId opt_trace = start_cmd.add_option(
+    "trace", false, "Write a trace of OpenFPGA engines in Chrome trace format");
+  start_cmd.set_option_require_value(opt_trace, openfpga::OPT_STRING);
+
+  /* '--record_memory': record the memory of each command */
+  openfpga::CommandOptionId opt_record_memory = start_cmd.add_option(
+    "record_memory", false,
+    "Record the resident memory of each command for report_memory_usage");
+
   /* '--version', -v': print version information */
   openfpga::CommandOptionId opt_version =
     start_cmd.add_option("version", false, "Show OpenFPGA version");
@@ -104,6 +123,16 @@ int OpenfpgaShell::start(int argc, char** argv) {
       print_openfpga_version_info();
       return 0;
     }
+    /* Start tracing before any command is executed */
+    if (true == start_cmd_context.option_enable(start_cmd, opt_trace)) {
+      if (false ==
+          openfpga::start_trace(
+            start_cmd_context.option_value(start_cmd, opt_trace))) {
+        return 1;
+      }
+    }
+    shell_.set_record_memory(
+      start_cmd_context.option_enable(start_cmd, opt_record_memory));
     /* Start a shell */
     if (true == start_cmd_context.option_enable(start_cmd, opt_interactive)) {
       shell_.run_interactive_mode(openfpga_ctx_);
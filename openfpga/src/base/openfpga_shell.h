@@ -16,6 +16,11 @@ class OpenfpgaShell {
  public: /* Contructors */
   OpenfpgaShell();
 
+ public: /* Accessors */
+  /* The data storage shared by all the commands, which reflects the results
+   * of the commands that have been run */
+  const OpenfpgaContext& openfpga_context() const;
+
  public: /* Mutators */
   /* Execute a specific command with options in a line, which is available in
    * the shell Note that running a command will be based on the current status
@@ -39,6 +44,10 @@ class OpenfpgaShell {
   /* Reset the data storage and shell status, to ensure a clean start */
   void reset();
 
+  /* Access the data storage directly, e.g., to run an engine outside the
+   * commands. Note that the modification will impact the following commands */
+  OpenfpgaContext& mutable_openfpga_context();
+
  private: /* Internal data */
   openfpga::Shell<OpenfpgaContext> shell_;
   OpenfpgaContext openfpga_ctx_;
@@ -51,6 +51,13 @@ ShellCommandId add_write_fabric_spice_command_template(
   shell_cmd.add_option("explicit_port_mapping", false,
                        "Use explicit port mapping in Verilog netlists");
 
+  /* Add an option '--threads' */
+  CommandOptionId threads_opt = shell_cmd.add_option(
+    "threads", false,
+    "Specify the number of threads to write independent netlists in "
+    "parallel. Default: 1");
+  shell_cmd.set_option_require_value(threads_opt, openfpga::OPT_INT);
+
   /* Add an option '--verbose' */
   shell_cmd.add_option("verbose", false, "Enable verbose output");
 
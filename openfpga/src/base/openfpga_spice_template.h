@@ -5,6 +5,8 @@
 #include "command_context.h"
 #include "command_exit_codes.h"
 #include "globals.h"
+#include "openfpga_build_fabric_template.h"
+#include "openfpga_command_utils.h"
 #include "spice_api.h"
 #include "vtr_log.h"
 #include "vtr_time.h"
@@ -23,6 +25,13 @@ int write_fabric_spice_template(T& openfpga_ctx, const Command& cmd,
     cmd.option("explicit_port_mapping");
   CommandOptionId opt_verbose = cmd.option("verbose");
 
+  /* Nets of datapath are required by netlists */
+  int status =
+    check_complete_fabric_module_graph_template<T>(openfpga_ctx, cmd);
+  if (CMD_EXEC_SUCCESS != status) {
+    return status;
+  }
+
   /* This is an intermediate data structure which is designed to modularize the
    * FPGA-SPICE Keep it independent from any other outside data structures
    */
@@ -32,8 +41,13 @@ int write_fabric_spice_template(T& openfpga_ctx, const Command& cmd,
     cmd_context.option_enable(cmd, opt_explicit_port_mapping));
   options.set_verbose_output(cmd_context.option_enable(cmd, opt_verbose));
   options.set_compress_routing(openfpga_ctx.flow_manager().compress_routing());
+  size_t num_threads = options.num_threads();
+  if (CMD_EXEC_SUCCESS !=
+      read_num_threads_option(cmd, cmd_context, num_threads)) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
+  options.set_num_threads(num_threads);
 
-  int status = CMD_EXEC_SUCCESS;
   status = fpga_fabric_spice(
     openfpga_ctx.module_graph(), openfpga_ctx.mutable_spice_netlists(),
     openfpga_ctx.arch(), openfpga_ctx.mux_lib(), g_vpr_ctx.device(),
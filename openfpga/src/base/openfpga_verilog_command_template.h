@@ -113,6 +113,11 @@ ShellCommandId add_write_full_testbench_command_template(
     "bitstream", true, "specify the bitstream to be loaded in the testbench");
   shell_cmd.set_option_require_value(bitstream_opt, openfpga::OPT_STRING);
 
+  /* add an option '--hex_bitstream'*/
+  shell_cmd.add_option("hex_bitstream", false,
+                       "load the bitstream file in hexadecimal format (written "
+                       "by 'write_fabric_bitstream --hex')");
+
   /* add an option '--simulator'*/
   CommandOptionId sim_opt = shell_cmd.add_option(
     "simulator", false, "specify the simulator to be used for the testbench");
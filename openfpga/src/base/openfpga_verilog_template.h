@@ -7,7 +7,9 @@
 #include "command.h"
 #include "command_context.h"
 #include "command_exit_codes.h"
+#include "fabric_bitstream_utils.h"
 #include "globals.h"
+#include "openfpga_build_fabric_template.h"
 #include "openfpga_scale.h"
 #include "read_xml_bus_group.h"
 #include "read_xml_pin_constraints.h"
@@ -38,6 +40,13 @@ int write_fabric_verilog_template(T& openfpga_ctx, const Command& cmd,
   CommandOptionId opt_use_relative_path = cmd.option("use_relative_path");
   CommandOptionId opt_verbose = cmd.option("verbose");
 
+  /* Nets of datapath are required by netlists */
+  int status =
+    check_complete_fabric_module_graph_template<T>(openfpga_ctx, cmd);
+  if (CMD_EXEC_SUCCESS != status) {
+    return status;
+  }
+
   /* This is an intermediate data structure which is designed to modularize the
    * FPGA-Verilog Keep it independent from any other outside data structures
    */
@@ -92,6 +101,7 @@ int write_full_testbench_template(const T& openfpga_ctx, const Command& cmd,
                                   const CommandContext& cmd_context) {
   CommandOptionId opt_output_dir = cmd.option("file");
   CommandOptionId opt_bitstream = cmd.option("bitstream");
+  CommandOptionId opt_hex_bitstream = cmd.option("hex_bitstream");
   CommandOptionId opt_sim = cmd.option("simulator");
   CommandOptionId opt_dut_module = cmd.option("dut_module");
   CommandOptionId opt_fabric_netlist = cmd.option("fabric_netlist_file_path");
@@ -119,6 +129,7 @@ int write_full_testbench_template(const T& openfpga_ctx, const Command& cmd,
     cmd_context.option_value(cmd, opt_reference_benchmark));
   options.set_fast_configuration(
     cmd_context.option_enable(cmd, opt_fast_configuration));
+  options.set_hex_bitstream(cmd_context.option_enable(cmd, opt_hex_bitstream));
   options.set_explicit_port_mapping(
     cmd_context.option_enable(cmd, opt_explicit_port_mapping));
   options.set_verbose_output(cmd_context.option_enable(cmd, opt_verbose));
@@ -156,6 +167,12 @@ int write_full_testbench_template(const T& openfpga_ctx, const Command& cmd,
     options.set_simulator_type(cmd_context.option_value(cmd, opt_sim));
   }
 
+  /* The testbench relies on the values recorded in the fabric bitstream */
+  if (!check_fabric_bitstream_in_sync(openfpga_ctx.bitstream_manager(),
+                                      openfpga_ctx.fabric_bitstream())) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
   return fpga_verilog_full_testbench(
     openfpga_ctx.module_graph(), openfpga_ctx.bitstream_manager(),
     openfpga_ctx.fabric_bitstream(), openfpga_ctx.blwl_shift_register_banks(),
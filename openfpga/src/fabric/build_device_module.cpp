@@ -31,20 +31,30 @@ namespace openfpga {
 /********************************************************************
  * The main function to be called for building module graphs
  * for a FPGA fabric
+ *
+ * When bitstream_only is enabled, only the configuration hierarchy is built,
+ * i.e., all the modules, instances, configurable children, configurable
+ * regions and the nets of configuration ports. The nets of datapath ports are
+ * skipped, so the module graph can be used to generate bitstreams but not
+ * netlists
  *******************************************************************/
 int build_device_module_graph(
   ModuleManager& module_manager, DecoderLibrary& decoder_lib,
   MemoryBankShiftRegisterBanks& blwl_sr_banks, FabricTile& fabric_tile,
   ModuleNameMap& module_name_map, const OpenfpgaContext& openfpga_ctx,
   const DeviceContext& vpr_device_ctx, const bool& frame_view,
-  const bool& compress_routing, const bool& duplicate_grid_pin,
-  const FabricKey& fabric_key, const TileConfig& tile_config,
-  const bool& group_config_block, const bool& name_module_using_index,
-  const bool& generate_random_fabric_key, const bool& verbose) {
+  const bool& bitstream_only, const bool& compress_routing,
+  const bool& duplicate_grid_pin, const FabricKey& fabric_key,
+  const TileConfig& tile_config, const bool& group_config_block,
+  const bool& name_module_using_index, const bool& generate_random_fabric_key,
+  const size_t& num_threads, const bool& verbose) {
   vtr::ScopedStartFinishTimer timer("Build fabric module graph");
 
   int status = CMD_EXEC_SUCCESS;
 
+  /* Nets of datapath ports are not required by a bitstream-only view */
+  bool skip_datapath_nets = frame_view || bitstream_only;
+
   CircuitModelId sram_model =
     openfpga_ctx.arch().config_protocol.memory_model();
   VTR_ASSERT(true ==
@@ -90,7 +100,8 @@ int build_device_module_graph(
     openfpga_ctx.mux_lib(), openfpga_ctx.arch().tile_annotations,
     openfpga_ctx.arch().config_protocol.type(), sram_model,
     openfpga_ctx.arch().config_protocol.ql_memory_bank_config_setting(),
-    duplicate_grid_pin, group_config_block, verbose);
+    duplicate_grid_pin, group_config_block, skip_datapath_nets, num_threads,
+    verbose);
   if (CMD_EXEC_FATAL_ERROR == status) {
     return status;
   }
@@ -101,7 +112,8 @@ int build_device_module_graph(
                                  openfpga_ctx.device_rr_gsb(),
                                  openfpga_ctx.arch().circuit_lib,
                                  openfpga_ctx.arch().config_protocol.type(),
-                                 sram_model, group_config_block, verbose);
+                                 sram_model, group_config_block,
+                                 skip_datapath_nets, num_threads, verbose);
   } else {
     VTR_ASSERT_SAFE(false == compress_routing);
     build_flatten_routing_modules(module_manager, decoder_lib, vpr_device_ctx,
@@ -109,7 +121,8 @@ int build_device_module_graph(
                                   openfpga_ctx.device_rr_gsb(),
                                   openfpga_ctx.arch().circuit_lib,
                                   openfpga_ctx.arch().config_protocol.type(),
-                                  sram_model, group_config_block, verbose);
+                                  sram_model, group_config_block,
+                                  skip_datapath_nets, num_threads, verbose);
   }
 
   /* Build tile modules if defined */
@@ -128,8 +141,8 @@ int build_device_module_graph(
       openfpga_ctx.device_rr_gsb(), vpr_device_ctx.rr_graph,
       openfpga_ctx.arch().tile_annotations, openfpga_ctx.arch().circuit_lib,
       sram_model, openfpga_ctx.arch().config_protocol.type(),
-      name_module_using_index, vpr_device_ctx.arch->perimeter_cb, frame_view,
-      verbose);
+      name_module_using_index, vpr_device_ctx.arch->perimeter_cb,
+      skip_datapath_nets, verbose);
   }
 
   /* Build FPGA fabric top-level module */
@@ -141,7 +154,7 @@ int build_device_module_graph(
     openfpga_ctx.device_rr_gsb(), openfpga_ctx.tile_direct(),
     openfpga_ctx.arch().arch_direct, openfpga_ctx.arch().config_protocol,
     sram_model, fabric_tile, name_module_using_index, frame_view,
-    compress_routing, duplicate_grid_pin, fabric_key,
+    bitstream_only, compress_routing, duplicate_grid_pin, fabric_key,
     generate_random_fabric_key, group_config_block,
     vpr_device_ctx.arch->perimeter_cb, verbose);
 
@@ -21,8 +21,10 @@
 #include "module_manager_utils.h"
 #include "openfpga_interconnect_types.h"
 #include "openfpga_naming.h"
+#include "openfpga_parallel.h"
 #include "openfpga_physical_tile_utils.h"
 #include "openfpga_reserved_words.h"
+#include "openfpga_trace.h"
 #include "pb_graph_utils.h"
 #include "pb_type_utils.h"
 #include "vpr_utils.h"
@@ -548,7 +550,8 @@ static void add_module_pb_graph_pin_interc(
   std::vector<ModuleId>& memory_modules, std::vector<size_t>& memory_instances,
   const VprDeviceAnnotation& device_annotation,
   const CircuitLibrary& circuit_lib, t_pb_graph_pin* des_pb_graph_pin,
-  t_mode* physical_mode, const bool& group_config_block, const bool& verbose) {
+  t_mode* physical_mode, const bool& group_config_block,
+  const bool& frame_view, const bool& verbose) {
   /* Find the number of fan-in and detailed interconnection information
    * related to the destination pb_graph_pin
    */
@@ -626,22 +629,24 @@ static void add_module_pb_graph_pin_interc(
       VTR_ASSERT(1 == circuit_lib.port_size(interc_model_inputs[0]));
       VTR_ASSERT(1 == circuit_lib.port_size(interc_model_outputs[0]));
 
-      /* Add nets to connect the wires to ports of pb_module */
-      /* First net is to connect input of src_pb_graph_node to input of the wire
-       * module */
-      add_module_pb_graph_pin2pin_net(
-        module_manager, pb_module, wire_module, wire_instance,
-        circuit_lib.port_prefix(interc_model_inputs[0]),
-        0, /* wire input port has only 1 pin */
-        src_pb_graph_pin, INPUT2INPUT_INTERC);
-
-      /* Second net is to connect output of the wire module to output of
-       * des_pb_graph_pin */
-      add_module_pb_graph_pin2pin_net(
-        module_manager, pb_module, wire_module, wire_instance,
-        circuit_lib.port_prefix(interc_model_outputs[0]),
-        0, /* wire output port has only 1 pin */
-        des_pb_graph_pin, OUTPUT2OUTPUT_INTERC);
+      if (!frame_view) {
+        /* Add nets to connect the wires to ports of pb_module */
+        /* First net is to connect input of src_pb_graph_node to input of the
+         * wire module */
+        add_module_pb_graph_pin2pin_net(
+          module_manager, pb_module, wire_module, wire_instance,
+          circuit_lib.port_prefix(interc_model_inputs[0]),
+          0, /* wire input port has only 1 pin */
+          src_pb_graph_pin, INPUT2INPUT_INTERC);
+
+        /* Second net is to connect output of the wire module to output of
+         * des_pb_graph_pin */
+        add_module_pb_graph_pin2pin_net(
+          module_manager, pb_module, wire_module, wire_instance,
+          circuit_lib.port_prefix(interc_model_outputs[0]),
+          0, /* wire output port has only 1 pin */
+          des_pb_graph_pin, OUTPUT2OUTPUT_INTERC);
+      }
       break;
     }
     case COMPLETE_INTERC:
@@ -720,11 +725,13 @@ static void add_module_pb_graph_pin_interc(
                  phy_mem_module_name.c_str());
       }
 
-      /* Add nets to connect SRAM ports of the MUX to the SRAM port of memory
-       * module */
-      add_module_nets_between_logic_and_memory_sram_bus(
-        module_manager, pb_module, mux_module, mux_instance, mux_mem_module,
-        mux_mem_instance, circuit_lib, interc_circuit_model);
+      if (!frame_view) {
+        /* Add nets to connect SRAM ports of the MUX to the SRAM port of memory
+         * module */
+        add_module_nets_between_logic_and_memory_sram_bus(
+          module_manager, pb_module, mux_module, mux_instance, mux_mem_module,
+          mux_mem_instance, circuit_lib, interc_circuit_model);
+      }
 
       /* Update memory modules and memory instance list */
       memory_modules.push_back(mux_mem_module);
@@ -736,31 +743,34 @@ static void add_module_pb_graph_pin_interc(
        */
       VTR_ASSERT(1 == circuit_lib.port_size(interc_model_outputs[0]));
 
-      /* Create nets to wire between the MUX and PB module */
-      /* Add a net to wire the inputs of the multiplexer to its source
-       * pb_graph_pin inside pb_module Here is a tricky part. Not every input
-       * edges from the destination pb_graph_pin is used in the physical_model
-       * of pb_type So, we will skip these input edges when building nets
-       */
-      size_t mux_input_pin_id = 0;
-      for (t_pb_graph_pin* src_pb_graph_pin :
-           pb_graph_pin_inputs(des_pb_graph_pin, cur_interc)) {
-        /* Add a net, set its source and sink */
+      if (!frame_view) {
+        /* Create nets to wire between the MUX and PB module */
+        /* Add a net to wire the inputs of the multiplexer to its source
+         * pb_graph_pin inside pb_module Here is a tricky part. Not every input
+         * edges from the destination pb_graph_pin is used in the physical_model
+         * of pb_type So, we will skip these input edges when building nets
+         */
+        size_t mux_input_pin_id = 0;
+        for (t_pb_graph_pin* src_pb_graph_pin :
+             pb_graph_pin_inputs(des_pb_graph_pin, cur_interc)) {
+          /* Add a net, set its source and sink */
+          add_module_pb_graph_pin2pin_net(
+            module_manager, pb_module, mux_module, mux_instance,
+            circuit_lib.port_prefix(interc_model_inputs[0]), mux_input_pin_id,
+            src_pb_graph_pin, INPUT2INPUT_INTERC);
+          mux_input_pin_id++;
+        }
+        /* Ensure all the fan_in has been covered */
+        VTR_ASSERT(mux_input_pin_id == fan_in);
+
+        /* Add a net to wire the output of the multiplexer to
+         * des_pb_graph_pin */
         add_module_pb_graph_pin2pin_net(
           module_manager, pb_module, mux_module, mux_instance,
-          circuit_lib.port_prefix(interc_model_inputs[0]), mux_input_pin_id,
-          src_pb_graph_pin, INPUT2INPUT_INTERC);
-        mux_input_pin_id++;
+          circuit_lib.port_prefix(interc_model_outputs[0]),
+          0, /* MUX should have only 1 pin in its output port */
+          des_pb_graph_pin, OUTPUT2OUTPUT_INTERC);
       }
-      /* Ensure all the fan_in has been covered */
-      VTR_ASSERT(mux_input_pin_id == fan_in);
-
-      /* Add a net to wire the output of the multiplexer to des_pb_graph_pin */
-      add_module_pb_graph_pin2pin_net(
-        module_manager, pb_module, mux_module, mux_instance,
-        circuit_lib.port_prefix(interc_model_outputs[0]),
-        0, /* MUX should have only 1 pin in its output port */
-        des_pb_graph_pin, OUTPUT2OUTPUT_INTERC);
       break;
     }
     default:
@@ -808,7 +818,8 @@ static void add_module_pb_graph_port_interc(
   const VprDeviceAnnotation& device_annotation,
   const CircuitLibrary& circuit_lib, t_pb_graph_node* des_pb_graph_node,
   const e_circuit_pb_port_type& pb_port_type, t_mode* physical_mode,
-  const bool& group_config_block, const bool& verbose) {
+  const bool& group_config_block, const bool& frame_view,
+  const bool& verbose) {
   switch (pb_port_type) {
     case CIRCUIT_PB_PORT_INPUT: {
       for (int iport = 0; iport < des_pb_graph_node->num_input_ports; ++iport) {
@@ -819,7 +830,7 @@ static void add_module_pb_graph_port_interc(
             module_manager, pb_module, memory_modules, memory_instances,
             device_annotation, circuit_lib,
             &(des_pb_graph_node->input_pins[iport][ipin]), physical_mode,
-            group_config_block, verbose);
+            group_config_block, frame_view, verbose);
         }
       }
       break;
@@ -833,7 +844,7 @@ static void add_module_pb_graph_port_interc(
             module_manager, pb_module, memory_modules, memory_instances,
             device_annotation, circuit_lib,
             &(des_pb_graph_node->output_pins[iport][ipin]), physical_mode,
-            group_config_block, verbose);
+            group_config_block, frame_view, verbose);
         }
       }
       break;
@@ -846,7 +857,7 @@ static void add_module_pb_graph_port_interc(
             module_manager, pb_module, memory_modules, memory_instances,
             device_annotation, circuit_lib,
             &(des_pb_graph_node->clock_pins[iport][ipin]), physical_mode,
-            group_config_block, verbose);
+            group_config_block, frame_view, verbose);
         }
       }
       break;
@@ -894,7 +905,7 @@ static void add_module_pb_graph_interc(
   const VprDeviceAnnotation& device_annotation,
   const CircuitLibrary& circuit_lib, t_pb_graph_node* physical_pb_graph_node,
   const int& physical_mode_index, const bool& group_config_block,
-  const bool& verbose) {
+  const bool& frame_view, const bool& verbose) {
   /* Check cur_pb_graph_node*/
   VTR_ASSERT(nullptr != physical_pb_graph_node);
 
@@ -913,7 +924,8 @@ static void add_module_pb_graph_interc(
   add_module_pb_graph_port_interc(
     module_manager, pb_module, memory_modules, memory_instances,
     device_annotation, circuit_lib, physical_pb_graph_node,
-    CIRCUIT_PB_PORT_OUTPUT, physical_mode, group_config_block, verbose);
+    CIRCUIT_PB_PORT_OUTPUT, physical_mode, group_config_block, frame_view,
+    verbose);
 
   /* We check input_pins of child_pb_graph_node and its the input_edges
    * Built the interconnections between inputs of cur_pb_graph_node and inputs
@@ -939,13 +951,15 @@ static void add_module_pb_graph_interc(
       add_module_pb_graph_port_interc(
         module_manager, pb_module, memory_modules, memory_instances,
         device_annotation, circuit_lib, child_pb_graph_node,
-        CIRCUIT_PB_PORT_INPUT, physical_mode, group_config_block, verbose);
+        CIRCUIT_PB_PORT_INPUT, physical_mode, group_config_block, frame_view,
+        verbose);
 
       /* For each child_pb_graph_node clock pins*/
       add_module_pb_graph_port_interc(
         module_manager, pb_module, memory_modules, memory_instances,
         device_annotation, circuit_lib, child_pb_graph_node,
-        CIRCUIT_PB_PORT_CLOCK, physical_mode, group_config_block, verbose);
+        CIRCUIT_PB_PORT_CLOCK, physical_mode, group_config_block, frame_view,
+        verbose);
     }
   }
 }
@@ -972,7 +986,7 @@ static void rec_build_logical_tile_modules(
   const CircuitLibrary& circuit_lib, const MuxLibrary& mux_lib,
   const e_config_protocol_type& sram_orgz_type,
   const CircuitModelId& sram_model, t_pb_graph_node* physical_pb_graph_node,
-  const bool& group_config_block, const bool& verbose) {
+  const bool& group_config_block, const bool& frame_view, const bool& verbose) {
   /* Check cur_pb_graph_node*/
   VTR_ASSERT(nullptr != physical_pb_graph_node);
 
@@ -993,7 +1007,7 @@ static void rec_build_logical_tile_modules(
         sram_orgz_type, sram_model,
         &(physical_pb_graph_node
             ->child_pb_graph_nodes[physical_mode->index][ipb][0]),
-        group_config_block, verbose);
+        group_config_block, frame_view, verbose);
     }
   }
 
@@ -1094,7 +1108,7 @@ static void rec_build_logical_tile_modules(
   add_module_pb_graph_interc(module_manager, pb_module, memory_modules,
                              memory_instances, device_annotation, circuit_lib,
                              physical_pb_graph_node, physical_mode->index,
-                             group_config_block, verbose);
+                             group_config_block, frame_view, verbose);
 
   /* Add global ports to the pb_module:
    * This is a much easier job after adding sub modules (instances),
@@ -1154,8 +1168,19 @@ static void rec_build_logical_tile_modules(
 }
 
 /*****************************************************************************
- * This function will create a Verilog file and print out a Verilog netlist
- * for a type of physical block
+ * A physical tile whose module is to be built. For IO blocks, the
+ * 'border_side' specifies which side of fabric the I/O block locates at
+ *****************************************************************************/
+struct PhysicalTileModuleTask {
+  t_physical_tile_type_ptr phy_block_type;
+  e_side border_side;
+  ModuleId module;
+};
+
+/*****************************************************************************
+ * This function will create a module for a type of physical block and add
+ * the logical tile modules as its children, as well as the physical memory
+ * block if required
  *
  * For IO blocks:
  * The param 'border_side' is required, which is specify which side of fabric
@@ -1163,24 +1188,22 @@ static void rec_build_logical_tile_modules(
  *****************************************************************************/
 static int build_physical_tile_module(
   ModuleManager& module_manager, DecoderLibrary& decoder_lib,
-  const VprDeviceAnnotation& vpr_device_annotation,
   const CircuitLibrary& circuit_lib,
   const e_config_protocol_type& sram_orgz_type,
-  const CircuitModelId& sram_model, t_physical_tile_type_ptr phy_block_type,
-  const TileAnnotation& tile_annotation, const e_side& border_side,
-  const QLMemoryBankConfigSetting* ql_memory_bank_config_setting,
-  const bool& duplicate_grid_pin, const bool& group_config_block,
-  const bool& perimeter_cb, const bool& verbose) {
+  const CircuitModelId& sram_model, PhysicalTileModuleTask& task,
+  const bool& group_config_block, const bool& verbose) {
   int status = CMD_EXEC_SUCCESS;
+  t_physical_tile_type_ptr phy_block_type = task.phy_block_type;
   /* Create a Module for the top-level physical block, and add to module manager
    */
   std::string grid_module_name = generate_grid_block_module_name(
     std::string(GRID_MODULE_NAME_PREFIX), std::string(phy_block_type->name),
-    is_io_type(phy_block_type), border_side);
+    is_io_type(phy_block_type), task.border_side);
   VTR_LOGV(verbose, "Building physical tile '%s'...", grid_module_name.c_str());
 
   ModuleId grid_module = module_manager.add_module(grid_module_name);
   VTR_ASSERT(true == module_manager.valid_module_id(grid_module));
+  task.module = grid_module;
 
   /* Now each physical tile may have a number of logical blocks
    * OpenFPGA only considers the physical implementation of the tiles.
@@ -1244,30 +1267,49 @@ static int build_physical_tile_module(
     }
   }
 
+  VTR_LOGV(verbose, "Done\n");
+
+  return status;
+}
+
+/*****************************************************************************
+ * Add the ports of a physical tile module and the nets to its logical tile
+ * modules. Only the physical tile module is modified, so that the ports of
+ * physical tiles can be built in parallel
+ *****************************************************************************/
+static void build_physical_tile_module_ports(
+  ModuleManager& module_manager, const ModuleId& grid_module,
+  const VprDeviceAnnotation& vpr_device_annotation,
+  t_physical_tile_type_ptr phy_block_type,
+  const TileAnnotation& tile_annotation, const e_side& border_side,
+  const bool& duplicate_grid_pin, const bool& perimeter_cb,
+  const bool& frame_view) {
   /* Add grid ports(pins) to the module */
   if (false == duplicate_grid_pin) {
     /* Default way to add these ports by following the definition in pb_types */
     add_grid_module_pb_type_ports(module_manager, grid_module,
                                   vpr_device_annotation, phy_block_type,
                                   tile_annotation, border_side, perimeter_cb);
-    /* Add module nets to connect the pb_type ports to sub modules */
-    for (const t_sub_tile& sub_tile : phy_block_type->sub_tiles) {
-      VTR_ASSERT(sub_tile.equivalent_sites.size() == 1);
-      t_logical_block_type_ptr lb_type = sub_tile.equivalent_sites[0];
-      /* Bypass empty pb_graph */
-      if (nullptr == lb_type->pb_graph_head) {
-        continue;
-      }
-      std::string pb_module_name =
-        generate_physical_block_module_name(lb_type->pb_graph_head->pb_type);
-      ModuleId pb_module = module_manager.find_module(pb_module_name);
-      VTR_ASSERT(true == module_manager.valid_module_id(pb_module));
-      for (const size_t& child_instance :
-           module_manager.child_module_instances(grid_module, pb_module)) {
-        add_grid_module_nets_connect_pb_type_ports(
-          module_manager, grid_module, pb_module, child_instance, sub_tile,
-          vpr_device_annotation, phy_block_type, tile_annotation, border_side,
-          perimeter_cb);
+    if (!frame_view) {
+      /* Add module nets to connect the pb_type ports to sub modules */
+      for (const t_sub_tile& sub_tile : phy_block_type->sub_tiles) {
+        VTR_ASSERT(sub_tile.equivalent_sites.size() == 1);
+        t_logical_block_type_ptr lb_type = sub_tile.equivalent_sites[0];
+        /* Bypass empty pb_graph */
+        if (nullptr == lb_type->pb_graph_head) {
+          continue;
+        }
+        std::string pb_module_name =
+          generate_physical_block_module_name(lb_type->pb_graph_head->pb_type);
+        ModuleId pb_module = module_manager.find_module(pb_module_name);
+        VTR_ASSERT(true == module_manager.valid_module_id(pb_module));
+        for (const size_t& child_instance :
+             module_manager.child_module_instances(grid_module, pb_module)) {
+          add_grid_module_nets_connect_pb_type_ports(
+            module_manager, grid_module, pb_module, child_instance, sub_tile,
+            vpr_device_annotation, phy_block_type, tile_annotation, border_side,
+            perimeter_cb);
+        }
       }
     }
   } else {
@@ -1277,28 +1319,45 @@ static int build_physical_tile_module(
       module_manager, grid_module, vpr_device_annotation, phy_block_type,
       tile_annotation, border_side, perimeter_cb);
 
-    /* Add module nets to connect the duplicated pb_type ports to sub modules */
-    for (const t_sub_tile& sub_tile : phy_block_type->sub_tiles) {
-      VTR_ASSERT(sub_tile.equivalent_sites.size() == 1);
-      t_logical_block_type_ptr lb_type = sub_tile.equivalent_sites[0];
-      /* Bypass empty pb_graph */
-      if (nullptr == lb_type->pb_graph_head) {
-        continue;
-      }
-      std::string pb_module_name =
-        generate_physical_block_module_name(lb_type->pb_graph_head->pb_type);
-      ModuleId pb_module = module_manager.find_module(pb_module_name);
-      VTR_ASSERT(true == module_manager.valid_module_id(pb_module));
-      for (const size_t& child_instance :
-           module_manager.child_module_instances(grid_module, pb_module)) {
-        add_grid_module_nets_connect_duplicated_pb_type_ports(
-          module_manager, grid_module, pb_module, child_instance, sub_tile,
-          vpr_device_annotation, phy_block_type, tile_annotation, border_side,
-          perimeter_cb);
+    if (!frame_view) {
+      /* Add module nets to connect the duplicated pb_type ports to sub
+       * modules */
+      for (const t_sub_tile& sub_tile : phy_block_type->sub_tiles) {
+        VTR_ASSERT(sub_tile.equivalent_sites.size() == 1);
+        t_logical_block_type_ptr lb_type = sub_tile.equivalent_sites[0];
+        /* Bypass empty pb_graph */
+        if (nullptr == lb_type->pb_graph_head) {
+          continue;
+        }
+        std::string pb_module_name =
+          generate_physical_block_module_name(lb_type->pb_graph_head->pb_type);
+        ModuleId pb_module = module_manager.find_module(pb_module_name);
+        VTR_ASSERT(true == module_manager.valid_module_id(pb_module));
+        for (const size_t& child_instance :
+             module_manager.child_module_instances(grid_module, pb_module)) {
+          add_grid_module_nets_connect_duplicated_pb_type_ports(
+            module_manager, grid_module, pb_module, child_instance, sub_tile,
+            vpr_device_annotation, phy_block_type, tile_annotation, border_side,
+            perimeter_cb);
+        }
       }
     }
   }
+}
 
+/*****************************************************************************
+ * Add the configuration ports and nets of a physical tile module, after all
+ * the child modules have been added.
+ * Note that this may add modules, e.g., decoders, so that it cannot be run
+ * in parallel
+ *****************************************************************************/
+static void add_physical_tile_module_configuration(
+  ModuleManager& module_manager, DecoderLibrary& decoder_lib,
+  const ModuleId& grid_module, const CircuitLibrary& circuit_lib,
+  const e_config_protocol_type& sram_orgz_type,
+  const CircuitModelId& sram_model, t_physical_tile_type_ptr phy_block_type,
+  const QLMemoryBankConfigSetting* ql_memory_bank_config_setting,
+  const bool& group_config_block) {
   /* Add global ports to the pb_module:
    * This is a much easier job after adding sub modules (instances),
    * we just need to find all the global ports from the child modules and build
@@ -1355,10 +1414,6 @@ static int build_physical_tile_module(
       module_manager, decoder_lib, grid_module, sram_orgz_type,
       circuit_lib.design_tech_type(sram_model), config_child_type);
   }
-
-  VTR_LOGV(verbose, "Done\n");
-
-  return status;
 }
 
 /*****************************************************************************
@@ -1383,9 +1438,10 @@ int build_grid_modules(
   const CircuitModelId& sram_model,
   const QLMemoryBankConfigSetting* ql_memory_bank_config_setting,
   const bool& duplicate_grid_pin, const bool& group_config_block,
-  const bool& verbose) {
+  const bool& frame_view, const size_t& num_threads, const bool& verbose) {
   /* Start time count */
   vtr::ScopedStartFinishTimer timer("Build grid modules");
+  OPENFPGA_TRACE_SCOPE("build_grid_modules");
 
   int status = CMD_EXEC_SUCCESS;
 
@@ -1409,7 +1465,7 @@ int build_grid_modules(
     rec_build_logical_tile_modules(
       module_manager, decoder_lib, device_annotation, circuit_lib, mux_lib,
       sram_orgz_type, sram_model, logical_tile.pb_graph_head,
-      group_config_block, verbose);
+      group_config_block, frame_view, verbose);
   }
   VTR_LOG("Done\n");
 
@@ -1418,6 +1474,7 @@ int build_grid_modules(
    */
   VTR_LOG("Building physical tiles...");
   VTR_LOGV(verbose, "\n");
+  std::vector<PhysicalTileModuleTask> tasks;
   for (const t_physical_tile_type& physical_tile :
        device_ctx.physical_tile_types) {
     /* Bypass empty type or nullptr */
@@ -1436,27 +1493,50 @@ int build_grid_modules(
       std::set<e_side> io_type_sides =
         find_physical_io_tile_located_sides(device_ctx.grid, &physical_tile);
       for (const e_side& io_type_side : io_type_sides) {
-        status = build_physical_tile_module(
-          module_manager, decoder_lib, device_annotation, circuit_lib,
-          sram_orgz_type, sram_model, &physical_tile, tile_annotation,
-          io_type_side, ql_memory_bank_config_setting, duplicate_grid_pin,
-          group_config_block, device_ctx.arch->perimeter_cb, verbose);
-        if (status != CMD_EXEC_SUCCESS) {
-          return CMD_EXEC_FATAL_ERROR;
-        }
+        tasks.push_back({&physical_tile, io_type_side, ModuleId::INVALID()});
       }
     } else {
       /* For CLB and heterogenenous blocks */
-      status = build_physical_tile_module(
-        module_manager, decoder_lib, device_annotation, circuit_lib,
-        sram_orgz_type, sram_model, &physical_tile, tile_annotation,
-        NUM_2D_SIDES, ql_memory_bank_config_setting, duplicate_grid_pin,
-        group_config_block, device_ctx.arch->perimeter_cb, verbose);
-      if (status != CMD_EXEC_SUCCESS) {
-        return CMD_EXEC_FATAL_ERROR;
-      }
+      tasks.push_back({&physical_tile, NUM_2D_SIDES, ModuleId::INVALID()});
     }
   }
+
+  /* Physical tiles are built in three steps:
+   * 1. Add the modules with their children in the order of the list, so that
+   *    module ids are the same regardless of the number of threads
+   * 2. Add the ports and nets of each module in parallel, where updates on
+   *    data shared by modules are staged by the module manager and committed
+   *    in the order of the list
+   * 3. Add the configuration ports and nets of each module in the order of
+   *    the list
+   */
+  std::vector<ModuleId> tile_modules;
+  for (PhysicalTileModuleTask& task : tasks) {
+    status = build_physical_tile_module(module_manager, decoder_lib,
+                                        circuit_lib, sram_orgz_type, sram_model,
+                                        task, group_config_block, verbose);
+    if (status != CMD_EXEC_SUCCESS) {
+      return CMD_EXEC_FATAL_ERROR;
+    }
+    tile_modules.push_back(task.module);
+  }
+
+  module_manager.stage_modules(tile_modules);
+  parallel_for(tasks.size(), num_threads, [&](const size_t& itask) {
+    const PhysicalTileModuleTask& task = tasks[itask];
+    build_physical_tile_module_ports(
+      module_manager, task.module, device_annotation, task.phy_block_type,
+      tile_annotation, task.border_side, duplicate_grid_pin,
+      device_ctx.arch->perimeter_cb, frame_view);
+  });
+  module_manager.commit_staged_modules();
+
+  for (const PhysicalTileModuleTask& task : tasks) {
+    add_physical_tile_module_configuration(
+      module_manager, decoder_lib, task.module, circuit_lib, sram_orgz_type,
+      sram_model, task.phy_block_type, ql_memory_bank_config_setting,
+      group_config_block);
+  }
   VTR_LOG("Done\n");
 
   return status;
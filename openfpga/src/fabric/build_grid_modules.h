@@ -28,7 +28,7 @@ int build_grid_modules(
   const CircuitModelId& sram_model,
   const QLMemoryBankConfigSetting* ql_memory_bank_config_setting,
   const bool& duplicate_grid_pin, const bool& group_config_block,
-  const bool& verbose);
+  const bool& frame_view, const size_t& num_threads, const bool& verbose);
 
 } /* end namespace openfpga */
 
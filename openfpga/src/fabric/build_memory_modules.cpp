@@ -21,6 +21,7 @@
 #include "mux_utils.h"
 #include "openfpga_naming.h"
 #include "openfpga_reserved_words.h"
+#include "openfpga_trace.h"
 #include "vtr_assert.h"
 #include "vtr_log.h"
 #include "vtr_time.h"
@@ -1181,6 +1182,7 @@ int build_memory_modules(ModuleManager& module_manager,
                          const bool& verbose) {
   int status = CMD_EXEC_SUCCESS;
   vtr::ScopedStartFinishTimer timer("Build memory modules");
+  OPENFPGA_TRACE_SCOPE("build_memory_modules");
 
   /* Create the memory circuits for the multiplexer */
   for (auto mux : mux_lib.muxes()) {
@@ -19,6 +19,7 @@
 #include "mux_utils.h"
 #include "openfpga_naming.h"
 #include "openfpga_reserved_words.h"
+#include "openfpga_trace.h"
 #include "vtr_assert.h"
 #include "vtr_log.h"
 #include "vtr_time.h"
@@ -1773,6 +1774,7 @@ static void build_mux_module(ModuleManager& module_manager,
 void build_mux_modules(ModuleManager& module_manager, const MuxLibrary& mux_lib,
                        const CircuitLibrary& circuit_lib) {
   vtr::ScopedStartFinishTimer timer("Building multiplexer modules");
+  OPENFPGA_TRACE_SCOPE("build_mux_modules");
 
   /* Generate basis sub-circuit for unique branches shared by the multiplexers
    */
@@ -20,9 +20,11 @@
 #include "build_routing_modules.h"
 #include "module_manager_utils.h"
 #include "openfpga_naming.h"
+#include "openfpga_parallel.h"
 #include "openfpga_reserved_words.h"
 #include "openfpga_rr_graph_utils.h"
 #include "openfpga_side_manager.h"
+#include "openfpga_trace.h"
 #include "rr_gsb_utils.h"
 
 /* begin namespace openfpga */
@@ -110,7 +112,7 @@ static void build_switch_block_mux_module(
   const size_t& chan_node_id, const RRNodeId& cur_rr_node,
   const std::vector<RRNodeId>& driver_rr_nodes, const RRSwitchId& switch_index,
   const std::map<ModulePinInfo, ModuleNetId>& input_port_to_module_nets,
-  const bool& group_config_block) {
+  const bool& group_config_block, const bool& frame_view) {
   /* Check current rr_node is CHANX or CHANY*/
   VTR_ASSERT((CHANX == rr_graph.node_type(cur_rr_node)) ||
              (CHANY == rr_graph.node_type(cur_rr_node)));
@@ -142,73 +144,77 @@ static void build_switch_block_mux_module(
   module_manager.set_child_instance_name(sb_module, mux_module, mux_instance_id,
                                          mux_instance_name);
 
-  /* Generate input ports that are wired to the input bus of the routing
-   * multiplexer */
-  std::vector<ModulePinInfo> sb_input_port_ids =
-    find_switch_block_module_input_ports(module_manager, sb_module, grids,
-                                         device_annotation, rr_graph, rr_gsb,
-                                         driver_rr_nodes);
-
-  /* Link input bus port to Switch Block inputs */
-  std::vector<CircuitPortId> mux_model_input_ports =
-    circuit_lib.model_ports_by_type(mux_model, CIRCUIT_MODEL_PORT_INPUT, true);
-  VTR_ASSERT(1 == mux_model_input_ports.size());
-  /* Find the module port id of the input port */
-  ModulePortId mux_input_port_id = module_manager.find_module_port(
-    mux_module, circuit_lib.port_prefix(mux_model_input_ports[0]));
-  VTR_ASSERT(
-    true == module_manager.valid_module_port_id(mux_module, mux_input_port_id));
-  BasicPort mux_input_port =
-    module_manager.module_port(mux_module, mux_input_port_id);
-
-  /* Check port size should match */
-  VTR_ASSERT(mux_input_port.get_width() == sb_input_port_ids.size());
-  for (size_t pin_id = 0; pin_id < sb_input_port_ids.size(); ++pin_id) {
-    /* Use the exising net */
-    ModuleNetId net = input_port_to_module_nets.at(sb_input_port_ids[pin_id]);
-    /* Configure the net source only if it is not yet in the source list */
-    if (false ==
-        module_manager.net_source_exist(sb_module, net, sb_module, 0,
-                                        sb_input_port_ids[pin_id].first,
-                                        sb_input_port_ids[pin_id].second)) {
-      module_manager.add_module_net_source(sb_module, net, sb_module, 0,
-                                           sb_input_port_ids[pin_id].first,
-                                           sb_input_port_ids[pin_id].second);
+  if (!frame_view) {
+    /* Generate input ports that are wired to the input bus of the routing
+     * multiplexer */
+    std::vector<ModulePinInfo> sb_input_port_ids =
+      find_switch_block_module_input_ports(module_manager, sb_module, grids,
+                                           device_annotation, rr_graph, rr_gsb,
+                                           driver_rr_nodes);
+
+    /* Link input bus port to Switch Block inputs */
+    std::vector<CircuitPortId> mux_model_input_ports =
+      circuit_lib.model_ports_by_type(mux_model, CIRCUIT_MODEL_PORT_INPUT,
+                                      true);
+    VTR_ASSERT(1 == mux_model_input_ports.size());
+    /* Find the module port id of the input port */
+    ModulePortId mux_input_port_id = module_manager.find_module_port(
+      mux_module, circuit_lib.port_prefix(mux_model_input_ports[0]));
+    VTR_ASSERT(true == module_manager.valid_module_port_id(mux_module,
+                                                           mux_input_port_id));
+    BasicPort mux_input_port =
+      module_manager.module_port(mux_module, mux_input_port_id);
+
+    /* Check port size should match */
+    VTR_ASSERT(mux_input_port.get_width() == sb_input_port_ids.size());
+    for (size_t pin_id = 0; pin_id < sb_input_port_ids.size(); ++pin_id) {
+      /* Use the exising net */
+      ModuleNetId net = input_port_to_module_nets.at(sb_input_port_ids[pin_id]);
+      /* Configure the net source only if it is not yet in the source list */
+      if (false ==
+          module_manager.net_source_exist(sb_module, net, sb_module, 0,
+                                          sb_input_port_ids[pin_id].first,
+                                          sb_input_port_ids[pin_id].second)) {
+        module_manager.add_module_net_source(sb_module, net, sb_module, 0,
+                                             sb_input_port_ids[pin_id].first,
+                                             sb_input_port_ids[pin_id].second);
+      }
+      /* Configure the net sink */
+      module_manager.add_module_net_sink(sb_module, net, mux_module,
+                                         mux_instance_id, mux_input_port_id,
+                                         mux_input_port.pins()[pin_id]);
     }
-    /* Configure the net sink */
-    module_manager.add_module_net_sink(sb_module, net, mux_module,
-                                       mux_instance_id, mux_input_port_id,
-                                       mux_input_port.pins()[pin_id]);
-  }
 
-  /* Link output port to Switch Block outputs */
-  std::vector<CircuitPortId> mux_model_output_ports =
-    circuit_lib.model_ports_by_type(mux_model, CIRCUIT_MODEL_PORT_OUTPUT, true);
-  VTR_ASSERT(1 == mux_model_output_ports.size());
-  /* Use the port name convention in the circuit library */
-  ModulePortId mux_output_port_id = module_manager.find_module_port(
-    mux_module, circuit_lib.port_prefix(mux_model_output_ports[0]));
-  VTR_ASSERT(true == module_manager.valid_module_port_id(mux_module,
-                                                         mux_output_port_id));
-  BasicPort mux_output_port =
-    module_manager.module_port(mux_module, mux_output_port_id);
-  ModulePinInfo sb_output_port_id = find_switch_block_module_chan_port(
-    module_manager, sb_module, rr_graph, rr_gsb, chan_side, cur_rr_node,
-    OUT_PORT);
-  BasicPort sb_output_port =
-    module_manager.module_port(sb_module, sb_output_port_id.first);
-
-  /* Check port size should match */
-  VTR_ASSERT(1 == mux_output_port.get_width());
-  for (size_t pin_id = 0; pin_id < mux_output_port.pins().size(); ++pin_id) {
-    /* Configuring the net source */
-    ModuleNetId net = create_module_source_pin_net(
-      module_manager, sb_module, mux_module, mux_instance_id,
-      mux_output_port_id, mux_output_port.pins()[pin_id]);
-    /* Configure the net sink */
-    module_manager.add_module_net_sink(sb_module, net, sb_module, 0,
-                                       sb_output_port_id.first,
-                                       sb_output_port_id.second);
+    /* Link output port to Switch Block outputs */
+    std::vector<CircuitPortId> mux_model_output_ports =
+      circuit_lib.model_ports_by_type(mux_model, CIRCUIT_MODEL_PORT_OUTPUT,
+                                      true);
+    VTR_ASSERT(1 == mux_model_output_ports.size());
+    /* Use the port name convention in the circuit library */
+    ModulePortId mux_output_port_id = module_manager.find_module_port(
+      mux_module, circuit_lib.port_prefix(mux_model_output_ports[0]));
+    VTR_ASSERT(true == module_manager.valid_module_port_id(mux_module,
+                                                           mux_output_port_id));
+    BasicPort mux_output_port =
+      module_manager.module_port(mux_module, mux_output_port_id);
+    ModulePinInfo sb_output_port_id = find_switch_block_module_chan_port(
+      module_manager, sb_module, rr_graph, rr_gsb, chan_side, cur_rr_node,
+      OUT_PORT);
+    BasicPort sb_output_port =
+      module_manager.module_port(sb_module, sb_output_port_id.first);
+
+    /* Check port size should match */
+    VTR_ASSERT(1 == mux_output_port.get_width());
+    for (size_t pin_id = 0; pin_id < mux_output_port.pins().size(); ++pin_id) {
+      /* Configuring the net source */
+      ModuleNetId net = create_module_source_pin_net(
+        module_manager, sb_module, mux_module, mux_instance_id,
+        mux_output_port_id, mux_output_port.pins()[pin_id]);
+      /* Configure the net sink */
+      module_manager.add_module_net_sink(sb_module, net, sb_module, 0,
+                                         sb_output_port_id.first,
+                                         sb_output_port_id.second);
+    }
   }
 
   /* Instanciate memory modules */
@@ -236,11 +242,13 @@ static void build_switch_block_mux_module(
   module_manager.set_child_instance_name(sb_module, mem_module, mem_instance_id,
                                          mem_instance_name);
 
-  /* Add nets to connect regular and mode-select SRAM ports to the SRAM port of
-   * memory module */
-  add_module_nets_between_logic_and_memory_sram_bus(
-    module_manager, sb_module, mux_module, mux_instance_id, mem_module,
-    mem_instance_id, circuit_lib, mux_model);
+  if (!frame_view) {
+    /* Add nets to connect regular and mode-select SRAM ports to the SRAM port
+     * of memory module */
+    add_module_nets_between_logic_and_memory_sram_bus(
+      module_manager, sb_module, mux_module, mux_instance_id, mem_module,
+      mem_instance_id, circuit_lib, mux_model);
+  }
   /* Update memory and instance list */
   size_t config_child_id = module_manager.num_configurable_children(
     sb_module, ModuleManager::e_config_child_type::LOGICAL);
@@ -278,7 +286,7 @@ static void build_switch_block_interc_modules(
   const CircuitLibrary& circuit_lib, const e_side& chan_side,
   const size_t& chan_node_id,
   const std::map<ModulePinInfo, ModuleNetId>& input_port_to_module_nets,
-  const bool& group_config_block) {
+  const bool& group_config_block, const bool& frame_view) {
   std::vector<RRNodeId> driver_rr_nodes;
 
   /* Get the node */
@@ -296,6 +304,11 @@ static void build_switch_block_interc_modules(
     }
   }
 
+  /* Direct connections are only nets, which are skipped in a frame view */
+  if ((1 >= driver_rr_nodes.size()) && (frame_view)) {
+    return;
+  }
+
   if (0 == driver_rr_nodes.size()) {
     /* Print a special direct connection*/
     build_switch_block_module_short_interc(
@@ -314,7 +327,8 @@ static void build_switch_block_interc_modules(
     build_switch_block_mux_module(
       module_manager, sb_module, device_annotation, grids, rr_graph, rr_gsb,
       circuit_lib, chan_side, chan_node_id, cur_rr_node, driver_rr_nodes,
-      driver_switches[0], input_port_to_module_nets, group_config_block);
+      driver_switches[0], input_port_to_module_nets, group_config_block,
+      frame_view);
   } /*Nothing should be done else*/
 }
 
@@ -377,25 +391,19 @@ static void build_switch_block_interc_modules(
  *                       Grid[x][y]     ChanY[x][y]      Grid[x+1][y]
  *                       right_pins    inputs/outputs      left_pins
  *
+ * The module has been added to the module manager. Only its ports,
+ * routing multiplexers and nets are built here, while its configuration
+ * ports are added by add_routing_module_configuration()
  *
  ********************************************************************/
 static void build_switch_block_module(
-  ModuleManager& module_manager, DecoderLibrary& decoder_lib,
+  ModuleManager& module_manager, const ModuleId& sb_module,
   const VprDeviceAnnotation& device_annotation, const DeviceGrid& grids,
   const RRGraphView& rr_graph, const CircuitLibrary& circuit_lib,
-  const e_config_protocol_type& sram_orgz_type,
-  const CircuitModelId& sram_model, const DeviceRRGSB& device_rr_gsb,
-  const RRGSB& rr_gsb, const bool& group_config_block, const bool& verbose) {
-  /* Create a Module of Switch Block and add to module manager */
-  vtr::Point<size_t> gsb_coordinate(rr_gsb.get_sb_x(), rr_gsb.get_sb_y());
-  ModuleId sb_module = module_manager.add_module(
-    generate_switch_block_module_name(gsb_coordinate));
-
-  /* Label module usage */
-  module_manager.set_module_usage(sb_module, ModuleManager::MODULE_SB);
-
-  VTR_LOGV(verbose, "Building module '%s'...",
-           generate_switch_block_module_name(gsb_coordinate).c_str());
+  const RRGSB& rr_gsb, const bool& group_config_block,
+  const bool& frame_view) {
+  OPENFPGA_TRACE_SCOPE_DETAIL("build_sb_module",
+                              module_manager.module_name(sb_module));
 
   /* Create a cache (fast look up) for module nets whose source are input ports
    */
@@ -439,11 +447,14 @@ static void build_switch_block_module(
       module_manager.set_port_side(sb_module, chan_input_port_id,
                                    side_manager.get_side());
 
-      /* Cache the input net */
-      for (const size_t& pin : chan_input_port.pins()) {
-        ModuleNetId net = create_module_source_pin_net(
-          module_manager, sb_module, sb_module, 0, chan_input_port_id, pin);
-        input_port_to_module_nets[ModulePinInfo(chan_input_port_id, pin)] = net;
+      if (!frame_view) {
+        /* Cache the input net */
+        for (const size_t& pin : chan_input_port.pins()) {
+          ModuleNetId net = create_module_source_pin_net(
+            module_manager, sb_module, sb_module, 0, chan_input_port_id, pin);
+          input_port_to_module_nets[ModulePinInfo(chan_input_port_id, pin)] =
+            net;
+        }
       }
 
       std::string chan_output_port_name = generate_sb_module_track_port_name(
@@ -479,9 +490,11 @@ static void build_switch_block_module(
                                    side_manager.get_side());
 
       /* Cache the input net */
-      ModuleNetId net = create_module_source_pin_net(
-        module_manager, sb_module, sb_module, 0, input_port_id, 0);
-      input_port_to_module_nets[ModulePinInfo(input_port_id, 0)] = net;
+      if (!frame_view) {
+        ModuleNetId net = create_module_source_pin_net(
+          module_manager, sb_module, sb_module, 0, input_port_id, 0);
+        input_port_to_module_nets[ModulePinInfo(input_port_id, 0)] = net;
+      }
     }
   }
 
@@ -496,71 +509,10 @@ static void build_switch_block_module(
         build_switch_block_interc_modules(
           module_manager, sb_module, device_annotation, grids, rr_graph, rr_gsb,
           circuit_lib, side_manager.get_side(), itrack,
-          input_port_to_module_nets, group_config_block);
+          input_port_to_module_nets, group_config_block, frame_view);
       }
     }
   }
-
-  /* Build a physical memory block */
-  if (group_config_block) {
-    std::string mem_module_name_prefix =
-      generate_switch_block_module_name_using_index(
-        device_rr_gsb.get_sb_unique_module_index(gsb_coordinate));
-    add_physical_memory_module(module_manager, decoder_lib, sb_module,
-                               mem_module_name_prefix, circuit_lib,
-                               sram_orgz_type, sram_model, verbose);
-  }
-
-  /* Add global ports to the pb_module:
-   * This is a much easier job after adding sub modules (instances),
-   * we just need to find all the global ports from the child modules and build
-   * a list of it
-   */
-  add_module_global_ports_from_child_modules(module_manager, sb_module);
-
-  /* Count shared SRAM ports from the sub-modules under this Verilog module
-   * This is a much easier job after adding sub modules (instances),
-   * we just need to find all the I/O ports from the child modules and build a
-   * list of it
-   */
-  size_t module_num_shared_config_bits =
-    find_module_num_shared_config_bits_from_child_modules(module_manager,
-                                                          sb_module);
-  if (0 < module_num_shared_config_bits) {
-    add_reserved_sram_ports_to_module_manager(module_manager, sb_module,
-                                              module_num_shared_config_bits);
-  }
-
-  /* Count SRAM ports from the sub-modules under this Verilog module
-   * This is a much easier job after adding sub modules (instances),
-   * we just need to find all the I/O ports from the child modules and build a
-   * list of it
-   */
-  ModuleManager::e_config_child_type config_child_type =
-    group_config_block ? ModuleManager::e_config_child_type::PHYSICAL
-                       : ModuleManager::e_config_child_type::LOGICAL;
-  size_t module_num_config_bits =
-    find_module_num_config_bits_from_child_modules(
-      module_manager, sb_module, circuit_lib, sram_model, sram_orgz_type,
-      config_child_type);
-  if (0 < module_num_config_bits) {
-    add_pb_sram_ports_to_module_manager(module_manager, sb_module, circuit_lib,
-                                        sram_model, sram_orgz_type,
-                                        module_num_config_bits);
-  }
-
-  /* Add all the nets to connect configuration ports from memory module to
-   * primitive modules This is a one-shot addition that covers all the memory
-   * modules in this primitive module!
-   */
-  if (0 <
-      module_manager.num_configurable_children(sb_module, config_child_type)) {
-    add_pb_module_nets_memory_config_bus(
-      module_manager, decoder_lib, sb_module, sram_orgz_type,
-      circuit_lib.design_tech_type(sram_model), config_child_type);
-  }
-
-  VTR_LOGV(verbose, "Done\n");
 }
 
 /*********************************************************************
@@ -642,7 +594,7 @@ static void build_connection_block_mux_module(
   const CircuitLibrary& circuit_lib, const e_side& cb_ipin_side,
   const size_t& ipin_index,
   const std::map<ModulePinInfo, ModuleNetId>& input_port_to_module_nets,
-  const bool& group_config_block) {
+  const bool& group_config_block, const bool& frame_view) {
   const RRNodeId& cur_rr_node = rr_gsb.get_ipin_node(cb_ipin_side, ipin_index);
   /* Check current rr_node is an input pin of a CLB */
   VTR_ASSERT(IPIN == rr_graph.node_type(cur_rr_node));
@@ -688,65 +640,69 @@ static void build_connection_block_mux_module(
   module_manager.set_child_instance_name(cb_module, mux_module, mux_instance_id,
                                          mux_instance_name);
 
-  /* TODO: Generate input ports that are wired to the input bus of the routing
-   * multiplexer */
-  std::vector<ModulePinInfo> cb_input_port_ids =
-    find_connection_block_module_input_ports(module_manager, cb_module, grids,
-                                             device_annotation, rr_graph,
-                                             rr_gsb, cb_type, driver_rr_nodes);
-
-  /* Link input bus port to Switch Block inputs */
-  std::vector<CircuitPortId> mux_model_input_ports =
-    circuit_lib.model_ports_by_type(mux_model, CIRCUIT_MODEL_PORT_INPUT, true);
-  VTR_ASSERT(1 == mux_model_input_ports.size());
-  /* Find the module port id of the input port */
-  ModulePortId mux_input_port_id = module_manager.find_module_port(
-    mux_module, circuit_lib.port_prefix(mux_model_input_ports[0]));
-  VTR_ASSERT(
-    true == module_manager.valid_module_port_id(mux_module, mux_input_port_id));
-  BasicPort mux_input_port =
-    module_manager.module_port(mux_module, mux_input_port_id);
-
-  /* Check port size should match */
-  VTR_ASSERT(mux_input_port.get_width() == cb_input_port_ids.size());
-  for (size_t pin_id = 0; pin_id < cb_input_port_ids.size(); ++pin_id) {
-    /* Use the exising net */
-    ModuleNetId net = input_port_to_module_nets.at(cb_input_port_ids[pin_id]);
-    /* No need to configure the net source since it is already done before */
-    /* Configure the net sink */
-    module_manager.add_module_net_sink(cb_module, net, mux_module,
-                                       mux_instance_id, mux_input_port_id,
-                                       mux_input_port.pins()[pin_id]);
-  }
+  if (!frame_view) {
+    /* TODO: Generate input ports that are wired to the input bus of the routing
+     * multiplexer */
+    std::vector<ModulePinInfo> cb_input_port_ids =
+      find_connection_block_module_input_ports(
+        module_manager, cb_module, grids, device_annotation, rr_graph, rr_gsb,
+        cb_type, driver_rr_nodes);
+
+    /* Link input bus port to Switch Block inputs */
+    std::vector<CircuitPortId> mux_model_input_ports =
+      circuit_lib.model_ports_by_type(mux_model, CIRCUIT_MODEL_PORT_INPUT,
+                                      true);
+    VTR_ASSERT(1 == mux_model_input_ports.size());
+    /* Find the module port id of the input port */
+    ModulePortId mux_input_port_id = module_manager.find_module_port(
+      mux_module, circuit_lib.port_prefix(mux_model_input_ports[0]));
+    VTR_ASSERT(true == module_manager.valid_module_port_id(mux_module,
+                                                           mux_input_port_id));
+    BasicPort mux_input_port =
+      module_manager.module_port(mux_module, mux_input_port_id);
+
+    /* Check port size should match */
+    VTR_ASSERT(mux_input_port.get_width() == cb_input_port_ids.size());
+    for (size_t pin_id = 0; pin_id < cb_input_port_ids.size(); ++pin_id) {
+      /* Use the exising net */
+      ModuleNetId net = input_port_to_module_nets.at(cb_input_port_ids[pin_id]);
+      /* No need to configure the net source since it is already done before */
+      /* Configure the net sink */
+      module_manager.add_module_net_sink(cb_module, net, mux_module,
+                                         mux_instance_id, mux_input_port_id,
+                                         mux_input_port.pins()[pin_id]);
+    }
 
-  /* Link output port to Switch Block outputs */
-  std::vector<CircuitPortId> mux_model_output_ports =
-    circuit_lib.model_ports_by_type(mux_model, CIRCUIT_MODEL_PORT_OUTPUT, true);
-  VTR_ASSERT(1 == mux_model_output_ports.size());
-  /* Use the port name convention in the circuit library */
-  ModulePortId mux_output_port_id = module_manager.find_module_port(
-    mux_module, circuit_lib.port_prefix(mux_model_output_ports[0]));
-  VTR_ASSERT(true == module_manager.valid_module_port_id(mux_module,
-                                                         mux_output_port_id));
-  BasicPort mux_output_port =
-    module_manager.module_port(mux_module, mux_output_port_id);
-  ModulePortId cb_output_port_id = find_connection_block_module_ipin_port(
-    module_manager, cb_module, grids, device_annotation, rr_graph, rr_gsb,
-    cur_rr_node);
-  BasicPort cb_output_port =
-    module_manager.module_port(cb_module, cb_output_port_id);
-
-  /* Check port size should match */
-  VTR_ASSERT(cb_output_port.get_width() == mux_output_port.get_width());
-  for (size_t pin_id = 0; pin_id < mux_output_port.pins().size(); ++pin_id) {
-    /* Configuring the net source */
-    ModuleNetId net = create_module_source_pin_net(
-      module_manager, cb_module, mux_module, mux_instance_id,
-      mux_output_port_id, mux_output_port.pins()[pin_id]);
-    /* Configure the net sink */
-    module_manager.add_module_net_sink(cb_module, net, cb_module, 0,
-                                       cb_output_port_id,
-                                       cb_output_port.pins()[pin_id]);
+    /* Link output port to Switch Block outputs */
+    std::vector<CircuitPortId> mux_model_output_ports =
+      circuit_lib.model_ports_by_type(mux_model, CIRCUIT_MODEL_PORT_OUTPUT,
+                                      true);
+    VTR_ASSERT(1 == mux_model_output_ports.size());
+    /* Use the port name convention in the circuit library */
+    ModulePortId mux_output_port_id = module_manager.find_module_port(
+      mux_module, circuit_lib.port_prefix(mux_model_output_ports[0]));
+    VTR_ASSERT(true == module_manager.valid_module_port_id(mux_module,
+                                                           mux_output_port_id));
+    BasicPort mux_output_port =
+      module_manager.module_port(mux_module, mux_output_port_id);
+    ModulePortId cb_output_port_id = find_connection_block_module_ipin_port(
+      module_manager, cb_module, grids, device_annotation, rr_graph, rr_gsb,
+      cur_rr_node);
+    BasicPort cb_output_port =
+      module_manager.module_port(cb_module, cb_output_port_id);
+
+    /* Check port size should match */
+    VTR_ASSERT(cb_output_port.get_width() == mux_output_port.get_width());
+    for (size_t pin_id = 0; pin_id < mux_output_port.pins().size(); ++pin_id) {
+      /* Configuring the net source */
+      ModuleNetId net = create_module_source_pin_net(
+        module_manager, cb_module, mux_module, mux_instance_id,
+        mux_output_port_id, mux_output_port.pins()[pin_id]);
+      /* Configure the net sink */
+      module_manager.add_module_net_sink(cb_module, net, cb_module, 0,
+                                         cb_output_port_id,
+                                         cb_output_port.pins()[pin_id]);
+    }
   }
 
   /* Instanciate memory modules */
@@ -777,11 +733,13 @@ static void build_connection_block_mux_module(
   module_manager.set_child_instance_name(cb_module, mem_module, mem_instance_id,
                                          mem_instance_name);
 
-  /* Add nets to connect regular and mode-select SRAM ports to the SRAM port of
-   * memory module */
-  add_module_nets_between_logic_and_memory_sram_bus(
-    module_manager, cb_module, mux_module, mux_instance_id, mem_module,
-    mem_instance_id, circuit_lib, mux_model);
+  if (!frame_view) {
+    /* Add nets to connect regular and mode-select SRAM ports to the SRAM port
+     * of memory module */
+    add_module_nets_between_logic_and_memory_sram_bus(
+      module_manager, cb_module, mux_module, mux_instance_id, mem_module,
+      mem_instance_id, circuit_lib, mux_model);
+  }
   /* Update memory and instance list */
   size_t config_child_id = module_manager.num_configurable_children(
     cb_module, ModuleManager::e_config_child_type::LOGICAL);
@@ -823,14 +781,17 @@ static void build_connection_block_interc_modules(
   const CircuitLibrary& circuit_lib, const e_side& cb_ipin_side,
   const size_t& ipin_index,
   const std::map<ModulePinInfo, ModuleNetId>& input_port_to_module_nets,
-  const bool& group_config_block) {
+  const bool& group_config_block, const bool& frame_view) {
   std::vector<RREdgeId> driver_rr_edges =
     rr_gsb.get_ipin_node_in_edges(rr_graph, cb_ipin_side, ipin_index);
 
   if (1 > driver_rr_edges.size()) {
     return; /* This port has no driver, skip it */
   } else if (1 == driver_rr_edges.size()) {
-    /* Print a direct connection */
+    /* Print a direct connection, which is only a net */
+    if (frame_view) {
+      return;
+    }
     build_connection_block_module_short_interc(
       module_manager, cb_module, device_annotation, grids, rr_graph, rr_gsb,
       cb_type, cb_ipin_side, ipin_index, input_port_to_module_nets);
@@ -840,7 +801,7 @@ static void build_connection_block_interc_modules(
     build_connection_block_mux_module(
       module_manager, cb_module, device_annotation, grids, rr_graph, rr_gsb,
       cb_type, circuit_lib, cb_ipin_side, ipin_index, input_port_to_module_nets,
-      group_config_block);
+      group_config_block, frame_view);
   } /*Nothing should be done else*/
 }
 
@@ -898,30 +859,19 @@ static void build_connection_block_interc_modules(
  *
  *  W: routing channel width
  *
+ * The module has been added to the module manager. Only its ports,
+ * routing multiplexers and nets are built here, while its configuration
+ * ports are added by add_routing_module_configuration()
+ *
  ********************************************************************/
 static void build_connection_block_module(
-  ModuleManager& module_manager, DecoderLibrary& decoder_lib,
+  ModuleManager& module_manager, const ModuleId& cb_module,
   const VprDeviceAnnotation& device_annotation, const DeviceGrid& grids,
   const RRGraphView& rr_graph, const CircuitLibrary& circuit_lib,
-  const e_config_protocol_type& sram_orgz_type,
-  const CircuitModelId& sram_model, const DeviceRRGSB& device_rr_gsb,
   const RRGSB& rr_gsb, const t_rr_type& cb_type, const bool& group_config_block,
-  const bool& verbose) {
-  /* Create the netlist */
-  vtr::Point<size_t> gsb_coordinate(rr_gsb.get_cb_x(cb_type),
-                                    rr_gsb.get_cb_y(cb_type));
-
-  /* Create a Verilog Module based on the circuit model, and add to module
-   * manager */
-  ModuleId cb_module = module_manager.add_module(
-    generate_connection_block_module_name(cb_type, gsb_coordinate));
-
-  /* Label module usage */
-  module_manager.set_module_usage(cb_module, ModuleManager::MODULE_CB);
-
-  VTR_LOGV(
-    verbose, "Building module '%s'...",
-    generate_connection_block_module_name(cb_type, gsb_coordinate).c_str());
+  const bool& frame_view) {
+  OPENFPGA_TRACE_SCOPE_DETAIL("build_cb_module",
+                              module_manager.module_name(cb_module));
 
   /* Add the input and output ports of routing tracks in the channel
    * Routing tracks pass through the connection blocks
@@ -1025,42 +975,44 @@ static void build_connection_block_module(
    *   upper_in[i] ----------> lower_out[i]
    *   lower_in[i] <---------- upper_out[i]
    */
-  /* Create short-wires: input port ---> output port */
-  VTR_ASSERT(chan_upper_input_port.get_width() ==
-             chan_lower_output_port.get_width());
-  for (size_t pin_id = 0; pin_id < chan_upper_input_port.pins().size();
-       ++pin_id) {
-    ModuleNetId net = create_module_source_pin_net(
-      module_manager, cb_module, cb_module, 0, chan_upper_input_port_id,
-      chan_upper_input_port.pins()[pin_id]);
-    module_manager.add_module_net_sink(cb_module, net, cb_module, 0,
-                                       chan_lower_output_port_id,
-                                       chan_lower_output_port.pins()[pin_id]);
-    /* Cache the module net */
-    input_port_to_module_nets[ModulePinInfo(
-      chan_upper_input_port_id, chan_upper_input_port.pins()[pin_id])] = net;
-  }
+  if (!frame_view) {
+    /* Create short-wires: input port ---> output port */
+    VTR_ASSERT(chan_upper_input_port.get_width() ==
+               chan_lower_output_port.get_width());
+    for (size_t pin_id = 0; pin_id < chan_upper_input_port.pins().size();
+         ++pin_id) {
+      ModuleNetId net = create_module_source_pin_net(
+        module_manager, cb_module, cb_module, 0, chan_upper_input_port_id,
+        chan_upper_input_port.pins()[pin_id]);
+      module_manager.add_module_net_sink(cb_module, net, cb_module, 0,
+                                         chan_lower_output_port_id,
+                                         chan_lower_output_port.pins()[pin_id]);
+      /* Cache the module net */
+      input_port_to_module_nets[ModulePinInfo(
+        chan_upper_input_port_id, chan_upper_input_port.pins()[pin_id])] = net;
+    }
 
-  VTR_ASSERT(chan_lower_input_port.get_width() ==
-             chan_upper_output_port.get_width());
-  for (size_t pin_id = 0; pin_id < chan_lower_input_port.pins().size();
-       ++pin_id) {
-    ModuleNetId net = create_module_source_pin_net(
-      module_manager, cb_module, cb_module, 0, chan_lower_input_port_id,
-      chan_lower_input_port.pins()[pin_id]);
-    module_manager.add_module_net_sink(cb_module, net, cb_module, 0,
-                                       chan_upper_output_port_id,
-                                       chan_upper_output_port.pins()[pin_id]);
-    /* Cache the module net */
-    input_port_to_module_nets[ModulePinInfo(
-      chan_lower_input_port_id, chan_lower_input_port.pins()[pin_id])] = net;
-  }
+    VTR_ASSERT(chan_lower_input_port.get_width() ==
+               chan_upper_output_port.get_width());
+    for (size_t pin_id = 0; pin_id < chan_lower_input_port.pins().size();
+         ++pin_id) {
+      ModuleNetId net = create_module_source_pin_net(
+        module_manager, cb_module, cb_module, 0, chan_lower_input_port_id,
+        chan_lower_input_port.pins()[pin_id]);
+      module_manager.add_module_net_sink(cb_module, net, cb_module, 0,
+                                         chan_upper_output_port_id,
+                                         chan_upper_output_port.pins()[pin_id]);
+      /* Cache the module net */
+      input_port_to_module_nets[ModulePinInfo(
+        chan_lower_input_port_id, chan_lower_input_port.pins()[pin_id])] = net;
+    }
 
-  for (ModulePortId opin_module_port_id : opin_module_port_ids) {
-    ModuleNetId net = create_module_source_pin_net(
-      module_manager, cb_module, cb_module, 0, opin_module_port_id, 0);
-    /* Cache the module net */
-    input_port_to_module_nets[ModulePinInfo(opin_module_port_id, 0)] = net;
+    for (ModulePortId opin_module_port_id : opin_module_port_ids) {
+      ModuleNetId net = create_module_source_pin_net(
+        module_manager, cb_module, cb_module, 0, opin_module_port_id, 0);
+      /* Cache the module net */
+      input_port_to_module_nets[ModulePinInfo(opin_module_port_id, 0)] = net;
+    }
   }
 
   /* Add sub modules of routing multiplexers or direct interconnect*/
@@ -1071,17 +1023,27 @@ static void build_connection_block_module(
       build_connection_block_interc_modules(
         module_manager, cb_module, device_annotation, grids, rr_graph, rr_gsb,
         cb_type, circuit_lib, cb_ipin_side, inode, input_port_to_module_nets,
-        group_config_block);
+        group_config_block, frame_view);
     }
   }
+}
 
+/********************************************************************
+ * Add the configuration ports and nets of a routing module, after all
+ * the child modules have been added.
+ * Note that this may add modules, e.g., physical memory modules and
+ * decoders, so that it cannot be run in parallel
+ *******************************************************************/
+static void add_routing_module_configuration(
+  ModuleManager& module_manager, DecoderLibrary& decoder_lib,
+  const ModuleId& routing_module, const std::string& mem_module_name_prefix,
+  const CircuitLibrary& circuit_lib,
+  const e_config_protocol_type& sram_orgz_type,
+  const CircuitModelId& sram_model, const bool& group_config_block,
+  const bool& verbose) {
   /* Build a physical memory block */
   if (group_config_block) {
-    std::string mem_module_name_prefix =
-      generate_connection_block_module_name_using_index(
-        cb_type,
-        device_rr_gsb.get_cb_unique_module_index(cb_type, gsb_coordinate));
-    add_physical_memory_module(module_manager, decoder_lib, cb_module,
+    add_physical_memory_module(module_manager, decoder_lib, routing_module,
                                mem_module_name_prefix, circuit_lib,
                                sram_orgz_type, sram_model, verbose);
   }
@@ -1091,7 +1053,7 @@ static void build_connection_block_module(
    * we just need to find all the global ports from the child modules and build
    * a list of it
    */
-  add_module_global_ports_from_child_modules(module_manager, cb_module);
+  add_module_global_ports_from_child_modules(module_manager, routing_module);
 
   /* Count shared SRAM ports from the sub-modules under this Verilog module
    * This is a much easier job after adding sub modules (instances),
@@ -1100,9 +1062,9 @@ static void build_connection_block_module(
    */
   size_t module_num_shared_config_bits =
     find_module_num_shared_config_bits_from_child_modules(module_manager,
-                                                          cb_module);
+                                                          routing_module);
   if (0 < module_num_shared_config_bits) {
-    add_reserved_sram_ports_to_module_manager(module_manager, cb_module,
+    add_reserved_sram_ports_to_module_manager(module_manager, routing_module,
                                               module_num_shared_config_bits);
   }
 
@@ -1116,11 +1078,11 @@ static void build_connection_block_module(
                        : ModuleManager::e_config_child_type::LOGICAL;
   size_t module_num_config_bits =
     find_module_num_config_bits_from_child_modules(
-      module_manager, cb_module, circuit_lib, sram_model, sram_orgz_type,
+      module_manager, routing_module, circuit_lib, sram_model, sram_orgz_type,
       config_child_type);
   if (0 < module_num_config_bits) {
-    add_pb_sram_ports_to_module_manager(module_manager, cb_module, circuit_lib,
-                                        sram_model, sram_orgz_type,
+    add_pb_sram_ports_to_module_manager(module_manager, routing_module,
+                                        circuit_lib, sram_model, sram_orgz_type,
                                         module_num_config_bits);
   }
 
@@ -1128,27 +1090,116 @@ static void build_connection_block_module(
    * primitive modules This is a one-shot addition that covers all the memory
    * modules in this primitive module!
    */
-  if (0 <
-      module_manager.num_configurable_children(cb_module, config_child_type)) {
+  if (0 < module_manager.num_configurable_children(routing_module,
+                                                   config_child_type)) {
     add_pb_module_nets_memory_config_bus(
-      module_manager, decoder_lib, cb_module, sram_orgz_type,
+      module_manager, decoder_lib, routing_module, sram_orgz_type,
       circuit_lib.design_tech_type(sram_model), config_child_type);
   }
-
-  VTR_LOGV(verbose, "Done\n");
 }
 
 /********************************************************************
- * Iterate over all the connection blocks in a device
- * and build a module for each of them
+ * A routing block whose module is to be built: either the switch block
+ * or a connection block of a GSB
+ *******************************************************************/
+struct RoutingModuleTask {
+  const RRGSB* rr_gsb;
+  bool is_sb;
+  t_rr_type cb_type;
+  ModuleId module;
+};
+
+/********************************************************************
+ * Build the modules of a list of routing blocks in three steps:
+ * 1. Add all the modules in the order of the list, so that module ids
+ *    are the same regardless of the number of threads
+ * 2. Build the ports, routing multiplexers and nets of each module in
+ *    parallel. A routing module only modifies itself, while the modules
+ *    of its children are already built. Its updates on data shared by
+ *    modules are staged by the module manager and committed in the order
+ *    of the list
+ * 3. Add the configuration ports and nets of each module in the order of
+ *    the list, which may add memory and decoder modules
  *******************************************************************/
-static void build_flatten_connection_block_modules(
+static void build_routing_module_tasks(
   ModuleManager& module_manager, DecoderLibrary& decoder_lib,
   const DeviceContext& device_ctx, const VprDeviceAnnotation& device_annotation,
   const DeviceRRGSB& device_rr_gsb, const CircuitLibrary& circuit_lib,
   const e_config_protocol_type& sram_orgz_type,
-  const CircuitModelId& sram_model, const t_rr_type& cb_type,
-  const bool& group_config_block, const bool& verbose) {
+  const CircuitModelId& sram_model, std::vector<RoutingModuleTask>& tasks,
+  const bool& group_config_block, const bool& frame_view,
+  const size_t& num_threads, const bool& verbose) {
+  /* Create the modules of routing blocks and add to module manager */
+  std::vector<ModuleId> modules;
+  modules.reserve(tasks.size());
+  for (RoutingModuleTask& task : tasks) {
+    if (task.is_sb) {
+      vtr::Point<size_t> gsb_coordinate(task.rr_gsb->get_sb_x(),
+                                        task.rr_gsb->get_sb_y());
+      task.module = module_manager.add_module(
+        generate_switch_block_module_name(gsb_coordinate));
+      module_manager.set_module_usage(task.module, ModuleManager::MODULE_SB);
+    } else {
+      vtr::Point<size_t> gsb_coordinate(task.rr_gsb->get_cb_x(task.cb_type),
+                                        task.rr_gsb->get_cb_y(task.cb_type));
+      task.module = module_manager.add_module(
+        generate_connection_block_module_name(task.cb_type, gsb_coordinate));
+      module_manager.set_module_usage(task.module, ModuleManager::MODULE_CB);
+    }
+    VTR_ASSERT(true == module_manager.valid_module_id(task.module));
+    modules.push_back(task.module);
+  }
+
+  module_manager.stage_modules(modules);
+  parallel_for(tasks.size(), num_threads, [&](const size_t& itask) {
+    const RoutingModuleTask& task = tasks[itask];
+    if (task.is_sb) {
+      build_switch_block_module(module_manager, task.module, device_annotation,
+                                device_ctx.grid, device_ctx.rr_graph,
+                                circuit_lib, *task.rr_gsb, group_config_block,
+                                frame_view);
+    } else {
+      build_connection_block_module(
+        module_manager, task.module, device_annotation, device_ctx.grid,
+        device_ctx.rr_graph, circuit_lib, *task.rr_gsb, task.cb_type,
+        group_config_block, frame_view);
+    }
+  });
+  module_manager.commit_staged_modules();
+
+  for (const RoutingModuleTask& task : tasks) {
+    VTR_LOGV(verbose, "Building module '%s'...",
+             module_manager.module_name(task.module).c_str());
+
+    std::string mem_module_name_prefix;
+    if (task.is_sb) {
+      vtr::Point<size_t> gsb_coordinate(task.rr_gsb->get_sb_x(),
+                                        task.rr_gsb->get_sb_y());
+      mem_module_name_prefix = generate_switch_block_module_name_using_index(
+        device_rr_gsb.get_sb_unique_module_index(gsb_coordinate));
+    } else {
+      vtr::Point<size_t> gsb_coordinate(task.rr_gsb->get_cb_x(task.cb_type),
+                                        task.rr_gsb->get_cb_y(task.cb_type));
+      mem_module_name_prefix =
+        generate_connection_block_module_name_using_index(
+          task.cb_type, device_rr_gsb.get_cb_unique_module_index(
+                          task.cb_type, gsb_coordinate));
+    }
+    add_routing_module_configuration(
+      module_manager, decoder_lib, task.module, mem_module_name_prefix,
+      circuit_lib, sram_orgz_type, sram_model, group_config_block, verbose);
+
+    VTR_LOGV(verbose, "Done\n");
+  }
+}
+
+/********************************************************************
+ * Iterate over all the connection blocks in a device
+ * and collect a module to build for each of them
+ *******************************************************************/
+static void collect_flatten_connection_block_tasks(
+  std::vector<RoutingModuleTask>& tasks, const DeviceRRGSB& device_rr_gsb,
+  const t_rr_type& cb_type) {
   /* Build unique X-direction connection block modules */
   vtr::Point<size_t> cb_range = device_rr_gsb.get_gsb_range();
 
@@ -1162,10 +1213,7 @@ static void build_flatten_connection_block_modules(
       if (false == rr_gsb.is_cb_exist(cb_type)) {
         continue;
       }
-      build_connection_block_module(
-        module_manager, decoder_lib, device_annotation, device_ctx.grid,
-        device_ctx.rr_graph, circuit_lib, sram_orgz_type, sram_model,
-        device_rr_gsb, rr_gsb, cb_type, group_config_block, verbose);
+      tasks.push_back({&rr_gsb, false, cb_type, ModuleId::INVALID()});
     }
   }
 }
@@ -1185,8 +1233,11 @@ void build_flatten_routing_modules(
   const DeviceRRGSB& device_rr_gsb, const CircuitLibrary& circuit_lib,
   const e_config_protocol_type& sram_orgz_type,
   const CircuitModelId& sram_model, const bool& group_config_block,
-  const bool& verbose) {
+  const bool& frame_view, const size_t& num_threads, const bool& verbose) {
   vtr::ScopedStartFinishTimer timer("Build routing modules...");
+  OPENFPGA_TRACE_SCOPE("build_flatten_routing_modules");
+
+  std::vector<RoutingModuleTask> tasks;
 
   vtr::Point<size_t> sb_range = device_rr_gsb.get_gsb_range();
 
@@ -1197,22 +1248,19 @@ void build_flatten_routing_modules(
       if (false == rr_gsb.is_sb_exist(device_ctx.rr_graph)) {
         continue;
       }
-      build_switch_block_module(
-        module_manager, decoder_lib, device_annotation, device_ctx.grid,
-        device_ctx.rr_graph, circuit_lib, sram_orgz_type, sram_model,
-        device_rr_gsb, rr_gsb, group_config_block, verbose);
+      tasks.push_back({&rr_gsb, true, NUM_RR_TYPES, ModuleId::INVALID()});
     }
   }
 
-  build_flatten_connection_block_modules(
-    module_manager, decoder_lib, device_ctx, device_annotation, device_rr_gsb,
-    circuit_lib, sram_orgz_type, sram_model, CHANX, group_config_block,
-    verbose);
+  collect_flatten_connection_block_tasks(tasks, device_rr_gsb, CHANX);
 
-  build_flatten_connection_block_modules(
-    module_manager, decoder_lib, device_ctx, device_annotation, device_rr_gsb,
-    circuit_lib, sram_orgz_type, sram_model, CHANY, group_config_block,
-    verbose);
+  collect_flatten_connection_block_tasks(tasks, device_rr_gsb, CHANY);
+
+  build_routing_module_tasks(module_manager, decoder_lib, device_ctx,
+                             device_annotation, device_rr_gsb, circuit_lib,
+                             sram_orgz_type, sram_model, tasks,
+                             group_config_block, frame_view, num_threads,
+                             verbose);
 }
 
 /********************************************************************
@@ -1232,39 +1280,37 @@ void build_unique_routing_modules(
   const DeviceRRGSB& device_rr_gsb, const CircuitLibrary& circuit_lib,
   const e_config_protocol_type& sram_orgz_type,
   const CircuitModelId& sram_model, const bool& group_config_block,
-  const bool& verbose) {
+  const bool& frame_view, const size_t& num_threads, const bool& verbose) {
   vtr::ScopedStartFinishTimer timer("Build unique routing modules...");
+  OPENFPGA_TRACE_SCOPE("build_unique_routing_modules");
+
+  std::vector<RoutingModuleTask> tasks;
 
   /* Build unique switch block modules */
   for (size_t isb = 0; isb < device_rr_gsb.get_num_sb_unique_module(); ++isb) {
     const RRGSB& unique_mirror = device_rr_gsb.get_sb_unique_module(isb);
-    build_switch_block_module(module_manager, decoder_lib, device_annotation,
-                              device_ctx.grid, device_ctx.rr_graph, circuit_lib,
-                              sram_orgz_type, sram_model, device_rr_gsb,
-                              unique_mirror, group_config_block, verbose);
+    tasks.push_back({&unique_mirror, true, NUM_RR_TYPES, ModuleId::INVALID()});
   }
 
   /* Build unique X-direction connection block modules */
   for (size_t icb = 0; icb < device_rr_gsb.get_num_cb_unique_module(CHANX);
        ++icb) {
     const RRGSB& unique_mirror = device_rr_gsb.get_cb_unique_module(CHANX, icb);
-
-    build_connection_block_module(
-      module_manager, decoder_lib, device_annotation, device_ctx.grid,
-      device_ctx.rr_graph, circuit_lib, sram_orgz_type, sram_model,
-      device_rr_gsb, unique_mirror, CHANX, group_config_block, verbose);
+    tasks.push_back({&unique_mirror, false, CHANX, ModuleId::INVALID()});
   }
 
   /* Build unique X-direction connection block modules */
   for (size_t icb = 0; icb < device_rr_gsb.get_num_cb_unique_module(CHANY);
        ++icb) {
     const RRGSB& unique_mirror = device_rr_gsb.get_cb_unique_module(CHANY, icb);
-
-    build_connection_block_module(
-      module_manager, decoder_lib, device_annotation, device_ctx.grid,
-      device_ctx.rr_graph, circuit_lib, sram_orgz_type, sram_model,
-      device_rr_gsb, unique_mirror, CHANY, group_config_block, verbose);
+    tasks.push_back({&unique_mirror, false, CHANY, ModuleId::INVALID()});
   }
+
+  build_routing_module_tasks(module_manager, decoder_lib, device_ctx,
+                             device_annotation, device_rr_gsb, circuit_lib,
+                             sram_orgz_type, sram_model, tasks,
+                             group_config_block, frame_view, num_threads,
+                             verbose);
 }
 
 } /* end namespace openfpga */
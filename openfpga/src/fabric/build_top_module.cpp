@@ -29,6 +29,7 @@
 #include "openfpga_device_grid_utils.h"
 #include "openfpga_naming.h"
 #include "openfpga_reserved_words.h"
+#include "openfpga_trace.h"
 #include "rr_gsb_utils.h"
 
 /* begin namespace openfpga */
@@ -44,6 +45,12 @@ namespace openfpga {
  * 3. Add the submodules to the top-level graph
  * 4. Add module nets to connect datapath ports
  * 5. Add module nets/submodules to connect configuration ports
+ *
+ * Note:
+ *   - In a frame view, all the module nets are skipped
+ *   - In a bitstream-only view, only the module nets of datapath ports are
+ *     skipped. The configuration ports and their nets are kept, as they may
+ *     add decoders to the configurable children
  *******************************************************************/
 int build_top_module(
   ModuleManager& module_manager, DecoderLibrary& decoder_lib,
@@ -56,11 +63,12 @@ int build_top_module(
   const ArchDirect& arch_direct, const ConfigProtocol& config_protocol,
   const CircuitModelId& sram_model, const FabricTile& fabric_tile,
   const bool& name_module_using_index, const bool& frame_view,
-  const bool& compact_routing_hierarchy, const bool& duplicate_grid_pin,
-  const FabricKey& fabric_key, const bool& generate_random_fabric_key,
-  const bool& group_config_block, const bool& perimeter_cb,
-  const bool& verbose) {
+  const bool& bitstream_only, const bool& compact_routing_hierarchy,
+  const bool& duplicate_grid_pin, const FabricKey& fabric_key,
+  const bool& generate_random_fabric_key, const bool& group_config_block,
+  const bool& perimeter_cb, const bool& verbose) {
   vtr::ScopedStartFinishTimer timer("Build FPGA fabric module");
+  OPENFPGA_TRACE_SCOPE("build_top_module");
 
   int status = CMD_EXEC_SUCCESS;
 
@@ -79,8 +87,9 @@ int build_top_module(
       module_manager, top_module, blwl_sr_banks, circuit_lib, clk_ntwk,
       rr_clock_lookup, vpr_device_annotation, grids, layer, tile_annotation,
       rr_graph, device_rr_gsb, tile_direct, arch_direct, config_protocol,
-      sram_model, frame_view, compact_routing_hierarchy, duplicate_grid_pin,
-      fabric_key, group_config_block, perimeter_cb, verbose);
+      sram_model, frame_view || bitstream_only, compact_routing_hierarchy,
+      duplicate_grid_pin, fabric_key, group_config_block, perimeter_cb,
+      verbose);
   } else {
     /* Build the tile instances under the top module */
     status = build_top_module_tile_child_instances(
@@ -88,7 +97,8 @@ int build_top_module(
       rr_clock_lookup, vpr_device_annotation, grids, layer, tile_annotation,
       rr_graph, device_rr_gsb, tile_direct, arch_direct, fabric_tile,
       config_protocol, sram_model, fabric_key, group_config_block,
-      name_module_using_index, perimeter_cb, frame_view, verbose);
+      name_module_using_index, perimeter_cb, frame_view || bitstream_only,
+      verbose);
   }
 
   if (status != CMD_EXEC_SUCCESS) {
@@ -97,8 +107,8 @@ int build_top_module(
 
   /* Shuffle the configurable children in a random sequence */
   if (true == generate_random_fabric_key) {
-    shuffle_top_module_configurable_children(module_manager, top_module,
-                                             config_protocol);
+    shuffle_top_module_configurable_children(
+      module_manager, top_module, circuit_lib, sram_model, config_protocol);
   }
 
   /* Build shift register bank detailed connections */
@@ -27,6 +27,7 @@
 #include "openfpga_device_grid_utils.h"
 #include "openfpga_naming.h"
 #include "openfpga_reserved_words.h"
+#include "openfpga_trace.h"
 #include "rr_gsb_utils.h"
 
 /* begin namespace openfpga */
@@ -97,6 +98,7 @@ static vtr::Matrix<size_t> add_top_module_grid_instances(
   ModuleManager& module_manager, const ModuleId& top_module,
   const DeviceGrid& grids, const size_t& layer) {
   vtr::ScopedStartFinishTimer timer("Add grid instances to top module");
+  OPENFPGA_TRACE_SCOPE("add_top_module_grid_instances");
 
   /* Reserve an array for the instance ids */
   vtr::Matrix<size_t> grid_instance_ids({grids.width(), grids.height()});
@@ -190,6 +192,7 @@ static vtr::Matrix<size_t> add_top_module_switch_block_instances(
   const RRGraphView& rr_graph, const DeviceRRGSB& device_rr_gsb,
   const bool& compact_routing_hierarchy) {
   vtr::ScopedStartFinishTimer timer("Add switch block instances to top module");
+  OPENFPGA_TRACE_SCOPE("add_top_module_switch_block_instances");
 
   vtr::Point<size_t> sb_range = device_rr_gsb.get_gsb_range();
 
@@ -247,6 +250,7 @@ static vtr::Matrix<size_t> add_top_module_connection_block_instances(
   const bool& compact_routing_hierarchy, const bool& verbose) {
   vtr::ScopedStartFinishTimer timer(
     "Add connection block instances to top module");
+  OPENFPGA_TRACE_SCOPE("add_top_module_connection_block_instances");
 
   vtr::Point<size_t> cb_range = device_rr_gsb.get_gsb_range();
 
@@ -30,6 +30,7 @@
 #include "openfpga_physical_tile_utils.h"
 #include "openfpga_reserved_words.h"
 #include "openfpga_rr_graph_utils.h"
+#include "openfpga_trace.h"
 #include "rr_gsb_utils.h"
 
 /* begin namespace openfpga */
@@ -97,6 +98,7 @@ static int add_top_module_tile_instances(ModuleManager& module_manager,
                                          const DeviceGrid& grids,
                                          const FabricTile& fabric_tile) {
   vtr::ScopedStartFinishTimer timer("Add tile instances to top module");
+  OPENFPGA_TRACE_SCOPE("add_top_module_tile_instances");
   int status = CMD_EXEC_SUCCESS;
 
   /* Reserve an array for the instance ids */
@@ -1058,6 +1060,7 @@ static int add_top_module_nets_connect_tiles(
   const DeviceRRGSB& device_rr_gsb, const FabricTile& fabric_tile,
   const bool& name_module_using_index, const bool& verbose) {
   vtr::ScopedStartFinishTimer timer("Add module nets between tiles");
+  OPENFPGA_TRACE_SCOPE("add_top_module_nets_connect_tiles");
   int status = CMD_EXEC_SUCCESS;
 
   for (size_t ix = 0; ix < grids.width(); ++ix) {
@@ -1147,8 +1150,8 @@ static void organize_top_module_tile_based_memory_modules(
   }
 
   /* Split memory modules into different regions */
-  build_top_module_configurable_regions(module_manager, top_module,
-                                        config_protocol);
+  build_top_module_configurable_regions(module_manager, top_module, circuit_lib,
+                                        sram_model, config_protocol);
 }
 
 /*********************************************************************
@@ -1898,6 +1901,7 @@ static void add_top_module_nets_connect_tile_direct_connections(
   const ArchDirect& arch_direct) {
   vtr::ScopedStartFinishTimer timer(
     "Add module nets for inter-tile connections");
+  OPENFPGA_TRACE_SCOPE("add_top_module_nets_connect_tile_direct_connections");
 
   for (const TileDirectId& tile_direct_id : tile_direct.directs()) {
     add_module_nets_connect_tile_direct_connection(
@@ -22,6 +22,7 @@
 #include "openfpga_physical_tile_utils.h"
 #include "openfpga_reserved_words.h"
 #include "openfpga_rr_graph_utils.h"
+#include "openfpga_trace.h"
 #include "pb_type_utils.h"
 #include "rr_gsb_utils.h"
 #include "vpr_utils.h"
@@ -906,6 +907,7 @@ void add_top_module_nets_connect_grids_and_gsbs(
   const std::map<t_rr_type, vtr::Matrix<size_t>>& cb_instance_ids,
   const bool& compact_routing_hierarchy, const bool& duplicate_grid_pin) {
   vtr::ScopedStartFinishTimer timer("Add module nets between grids and GSBs");
+  OPENFPGA_TRACE_SCOPE("add_top_module_nets_connect_grids_and_gsbs");
 
   vtr::Point<size_t> gsb_range = device_rr_gsb.get_gsb_range();
 
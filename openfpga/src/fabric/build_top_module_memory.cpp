@@ -2,7 +2,9 @@
  * This file includes functions that are used to organize memories
  * in the top module of FPGA fabric
  *******************************************************************/
+#include <algorithm>
 #include <cmath>
+#include <map>
 
 /* Headers from vtrutil library */
 #include "vtr_assert.h"
@@ -23,6 +25,7 @@
 #include "module_manager_utils.h"
 #include "openfpga_naming.h"
 #include "openfpga_reserved_words.h"
+#include "openfpga_trace.h"
 #include "rr_gsb_utils.h"
 
 /* begin namespace openfpga */
@@ -226,6 +229,175 @@ static void organize_top_module_tile_memory_modules(
   }
 }
 
+/********************************************************************
+ * Find the minimum number of configuration bits that a region must be able
+ * to hold, so that the configurable children can be split into a given
+ * number of regions, each of which consists of consecutive children.
+ * This is a linear partitioning problem, which is solved by a binary search
+ * on the capacity of a region, where each capacity is checked by a greedy
+ * assignment
+ *******************************************************************/
+static size_t find_min_configurable_region_capacity(
+  const std::vector<size_t>& child_num_config_bits,
+  const size_t& num_regions) {
+  size_t total_num_config_bits = 0;
+  size_t max_child_num_config_bits = 0;
+  for (const size_t& num_config_bits : child_num_config_bits) {
+    total_num_config_bits += num_config_bits;
+    max_child_num_config_bits =
+      std::max(max_child_num_config_bits, num_config_bits);
+  }
+
+  size_t min_capacity =
+    std::max(max_child_num_config_bits,
+             (total_num_config_bits + num_regions - 1) / num_regions);
+  size_t max_capacity = total_num_config_bits;
+  while (min_capacity < max_capacity) {
+    size_t capacity = min_capacity + (max_capacity - min_capacity) / 2;
+    /* Count the number of regions required when each region is filled up to
+     * the capacity */
+    size_t num_required_regions = 1;
+    size_t region_num_config_bits = 0;
+    for (const size_t& num_config_bits : child_num_config_bits) {
+      if (region_num_config_bits + num_config_bits > capacity) {
+        num_required_regions++;
+        region_num_config_bits = 0;
+      }
+      region_num_config_bits += num_config_bits;
+    }
+    if (num_required_regions <= num_regions) {
+      max_capacity = capacity;
+    } else {
+      min_capacity = capacity + 1;
+    }
+  }
+  return min_capacity;
+}
+
+/********************************************************************
+ * Report the number of configuration bits and the predicted number of
+ * configuration cycles for each configurable region.
+ * Regions are programmed in parallel, so that the configuration time is
+ * set by the region requiring the most cycles:
+ * - For configuration chains, a bit is shifted in each cycle
+ * - For QL memory banks, a word line is written in each cycle
+ * - For the other protocols, a bit is written in each cycle
+ *******************************************************************/
+static void report_top_module_configurable_regions(
+  const ModuleManager& module_manager, const ModuleId& top_module,
+  const CircuitLibrary& circuit_lib, const CircuitModelId& sram_model,
+  const ConfigProtocol& config_protocol,
+  const vtr::vector<ConfigRegionId, size_t>& region_num_config_bits) {
+  TopModuleNumConfigBits top_module_num_config_bits;
+  if (CONFIG_MEM_QL_MEMORY_BANK == config_protocol.type()) {
+    top_module_num_config_bits = find_top_module_regional_num_config_bit(
+      module_manager, top_module, circuit_lib, sram_model,
+      config_protocol.type());
+  }
+
+  ConfigRegionId slowest_region = ConfigRegionId::INVALID();
+  size_t max_num_cycles = 0;
+  for (const ConfigRegionId& config_region :
+       module_manager.regions(top_module)) {
+    size_t num_cycles = region_num_config_bits[config_region];
+    if (CONFIG_MEM_QL_MEMORY_BANK == config_protocol.type()) {
+      num_cycles = top_module_num_config_bits[config_region].second;
+    }
+    VTR_LOG(
+      "Configurable region %lu: %lu configurable children, %lu configuration "
+      "bits, %lu predicted configuration cycles\n",
+      size_t(config_region),
+      module_manager.region_configurable_children(top_module, config_region)
+        .size(),
+      region_num_config_bits[config_region], num_cycles);
+    if (!slowest_region || num_cycles > max_num_cycles) {
+      slowest_region = config_region;
+      max_num_cycles = num_cycles;
+    }
+  }
+  VTR_LOG(
+    "Configuration time is set by region %lu: %lu predicted configuration "
+    "cycles\n",
+    size_t(slowest_region), max_num_cycles);
+}
+
+/********************************************************************
+ * Split memory modules into configurable regions, where each region
+ * includes a similar number of configuration bits rather than a similar
+ * number of configurable children. This minimizes the largest region,
+ * which sets the configuration time when regions are programmed in
+ * parallel.
+ * The sequence of configurable children is kept, so that each region
+ * still consists of neighbouring children.
+ *******************************************************************/
+static void build_top_module_balanced_configurable_regions(
+  ModuleManager& module_manager, const ModuleId& top_module,
+  const CircuitLibrary& circuit_lib, const CircuitModelId& sram_model,
+  const ConfigProtocol& config_protocol) {
+  std::vector<ModuleId> configurable_children =
+    module_manager.configurable_children(
+      top_module, ModuleManager::e_config_child_type::PHYSICAL);
+  std::vector<size_t> configurable_child_instances =
+    module_manager.configurable_child_instances(
+      top_module, ModuleManager::e_config_child_type::PHYSICAL);
+
+  /* Count the configuration bits of each child. Many children are instances
+   * of the same module, so cache the number per module */
+  std::map<ModuleId, size_t> module_num_config_bits;
+  std::vector<size_t> child_num_config_bits;
+  child_num_config_bits.reserve(configurable_children.size());
+  for (const ModuleId& child_module : configurable_children) {
+    auto result = module_num_config_bits.find(child_module);
+    if (result == module_num_config_bits.end()) {
+      result = module_num_config_bits
+                 .emplace(child_module,
+                          find_module_num_config_bits(
+                            module_manager, child_module, circuit_lib,
+                            sram_model, config_protocol.type()))
+                 .first;
+    }
+    child_num_config_bits.push_back(result->second);
+  }
+
+  size_t num_regions = config_protocol.num_regions();
+  size_t region_capacity =
+    find_min_configurable_region_capacity(child_num_config_bits, num_regions);
+
+  /* Fill each region up to the capacity. Leave at least one child for each
+   * of the remaining regions */
+  vtr::vector<ConfigRegionId, size_t> region_num_config_bits;
+  ConfigRegionId curr_region = module_manager.add_config_region(top_module);
+  region_num_config_bits.push_back(0);
+  size_t region_num_children = 0;
+  for (size_t ichild = 0; ichild < configurable_children.size(); ++ichild) {
+    size_t num_remaining_children = configurable_children.size() - ichild;
+    size_t num_remaining_regions = num_regions - size_t(curr_region) - 1;
+    if ((0 < region_num_children) && (0 < num_remaining_regions) &&
+        ((region_num_config_bits[curr_region] + child_num_config_bits[ichild] >
+          region_capacity) ||
+         (num_remaining_children <= num_remaining_regions))) {
+      curr_region = module_manager.add_config_region(top_module);
+      region_num_config_bits.push_back(0);
+      region_num_children = 0;
+    }
+
+    module_manager.add_configurable_child_to_region(
+      top_module, curr_region, configurable_children[ichild],
+      configurable_child_instances[ichild], ichild);
+    region_num_config_bits[curr_region] += child_num_config_bits[ichild];
+    region_num_children++;
+  }
+
+  /* Ensure that the number of configurable regions created matches the
+   * definition */
+  VTR_ASSERT(num_regions == module_manager.regions(top_module).size());
+
+  report_top_module_configurable_regions(module_manager, top_module,
+                                         circuit_lib, sram_model,
+                                         config_protocol,
+                                         region_num_config_bits);
+}
+
 /********************************************************************
  * Split memory modules into different configurable regions
  * This function will create regions based on the definition
@@ -267,9 +439,11 @@ static void organize_top_module_tile_memory_modules(
  *******************************************************************/
 void build_top_module_configurable_regions(
   ModuleManager& module_manager, const ModuleId& top_module,
+  const CircuitLibrary& circuit_lib, const CircuitModelId& sram_model,
   const ConfigProtocol& config_protocol) {
   vtr::ScopedStartFinishTimer timer(
     "Build configurable regions for the top module");
+  OPENFPGA_TRACE_SCOPE("build_top_module_configurable_regions");
 
   /* Ensure we have valid configurable children */
   VTR_ASSERT(false ==
@@ -281,6 +455,12 @@ void build_top_module_configurable_regions(
   /* Ensure that our region definition is valid */
   VTR_ASSERT(1 <= config_protocol.num_regions());
 
+  if (true == config_protocol.balance_regions()) {
+    build_top_module_balanced_configurable_regions(
+      module_manager, top_module, circuit_lib, sram_model, config_protocol);
+    return;
+  }
+
   /* Exclude decoders from the list */
   size_t num_configurable_children =
     module_manager
@@ -533,8 +713,8 @@ void organize_top_module_memory_modules(
   }
 
   /* Split memory modules into different regions */
-  build_top_module_configurable_regions(module_manager, top_module,
-                                        config_protocol);
+  build_top_module_configurable_regions(module_manager, top_module, circuit_lib,
+                                        sram_model, config_protocol);
 }
 
 /********************************************************************
@@ -552,6 +732,7 @@ void organize_top_module_memory_modules(
  ********************************************************************/
 void shuffle_top_module_configurable_children(
   ModuleManager& module_manager, const ModuleId& top_module,
+  const CircuitLibrary& circuit_lib, const CircuitModelId& sram_model,
   const ConfigProtocol& config_protocol) {
   size_t num_keys =
     module_manager
@@ -590,8 +771,8 @@ void shuffle_top_module_configurable_children(
 
   /* Reset configurable regions */
   module_manager.clear_config_region(top_module);
-  build_top_module_configurable_regions(module_manager, top_module,
-                                        config_protocol);
+  build_top_module_configurable_regions(module_manager, top_module, circuit_lib,
+                                        sram_model, config_protocol);
 }
 
 /********************************************************************
@@ -2042,6 +2223,7 @@ void add_top_module_nets_memory_config_bus(
   const e_circuit_model_design_tech& mem_tech,
   const TopModuleNumConfigBits& num_config_bits) {
   vtr::ScopedStartFinishTimer timer("Add module nets for configuration buses");
+  OPENFPGA_TRACE_SCOPE("add_top_module_nets_memory_config_bus");
 
   switch (mem_tech) {
     case CIRCUIT_MODEL_DESIGN_CMOS:
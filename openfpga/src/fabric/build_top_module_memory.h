@@ -41,10 +41,12 @@ void organize_top_module_memory_modules(
 
 void build_top_module_configurable_regions(
   ModuleManager& module_manager, const ModuleId& top_module,
+  const CircuitLibrary& circuit_lib, const CircuitModelId& sram_model,
   const ConfigProtocol& config_protocol);
 
 void shuffle_top_module_configurable_children(
   ModuleManager& module_manager, const ModuleId& top_module,
+  const CircuitLibrary& circuit_lib, const CircuitModelId& sram_model,
   const ConfigProtocol& config_protocol);
 
 int load_top_module_memory_modules_from_fabric_key(
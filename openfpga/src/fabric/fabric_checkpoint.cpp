@@ -0,0 +1,346 @@
+/***************************************************************************************
+ * Write/read a checkpoint of the fabric-related data structures, which are
+ * built by the command 'build_fabric', to/from a binary file.
+ * The data structures depend only on the architecture, so that a checkpoint
+ * can be reused by any design which is implemented on the same architecture
+ * (and the same device layout).
+ *
+ * File organization:
+ * - Header: magic string, version number, width and height of device grid,
+ *   digest of the architectures and options of build_fabric
+ * - Unique blocks of routing (only applicable when routing is compressed)
+ * - Module graph
+ * - Decoder library
+ * - Shift register banks for BL/WLs
+ * - Fabric tiles
+ * - Module name map
+ ***************************************************************************************/
+#include <fstream>
+#include <utility>
+#include <vector>
+
+/* Headers from vtrutil library */
+#include "vtr_assert.h"
+#include "vtr_log.h"
+#include "vtr_time.h"
+
+/* Headers from openfpgautil library */
+#include "command_exit_codes.h"
+#include "openfpga_bin_stream.h"
+#include "openfpga_digest.h"
+
+#include "fabric_checkpoint.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/* Any change on the file organization should increase the version number */
+constexpr const char* FABRIC_CHECKPOINT_MAGIC = "OPENFPGA_FABRIC_CHECKPOINT";
+constexpr size_t FABRIC_CHECKPOINT_VERSION = 2;
+
+/***************************************************************************************
+ * Write the unique blocks of a given type: the coordinate of each unique
+ * block and the coordinates of its mirror instances
+ ***************************************************************************************/
+static void write_checkpoint_unique_blocks(std::ostream& fp,
+                                           const DeviceRRGSB& device_rr_gsb) {
+  write_bin(fp, device_rr_gsb.is_compressed());
+  if (!device_rr_gsb.is_compressed()) {
+    return;
+  }
+
+  write_bin(fp, device_rr_gsb.get_num_sb_unique_module());
+  for (size_t id = 0; id < device_rr_gsb.get_num_sb_unique_module(); ++id) {
+    vtr::Point<size_t> coord = device_rr_gsb.get_sb_unique_block_coord(id);
+    write_bin(fp, coord);
+    write_bin(fp, device_rr_gsb.get_sb_unique_block_instance_coord(coord));
+  }
+
+  write_bin(fp, device_rr_gsb.get_num_cb_unique_module(CHANX));
+  for (size_t id = 0; id < device_rr_gsb.get_num_cb_unique_module(CHANX);
+       ++id) {
+    vtr::Point<size_t> coord = device_rr_gsb.get_cbx_unique_block_coord(id);
+    write_bin(fp, coord);
+    write_bin(fp, device_rr_gsb.get_cbx_unique_block_instance_coord(coord));
+  }
+
+  write_bin(fp, device_rr_gsb.get_num_cb_unique_module(CHANY));
+  for (size_t id = 0; id < device_rr_gsb.get_num_cb_unique_module(CHANY);
+       ++id) {
+    vtr::Point<size_t> coord = device_rr_gsb.get_cby_unique_block_coord(id);
+    write_bin(fp, coord);
+    write_bin(fp, device_rr_gsb.get_cby_unique_block_instance_coord(coord));
+  }
+}
+
+/***************************************************************************************
+ * Unique blocks read from a checkpoint: the coordinate of each unique block
+ * and the coordinates of its mirror instances. They are kept aside until the
+ * whole checkpoint is read, as device_rr_gsb is only updated in place
+ ***************************************************************************************/
+struct CheckpointUniqueBlocks {
+  bool is_compressed = false;
+  std::vector<std::pair<vtr::Point<size_t>, std::vector<vtr::Point<size_t>>>>
+    sb_blocks;
+  std::vector<std::pair<vtr::Point<size_t>, std::vector<vtr::Point<size_t>>>>
+    cbx_blocks;
+  std::vector<std::pair<vtr::Point<size_t>, std::vector<vtr::Point<size_t>>>>
+    cby_blocks;
+};
+
+static void read_checkpoint_unique_blocks(
+  std::istream& fp, CheckpointUniqueBlocks& unique_blocks) {
+  read_bin(fp, unique_blocks.is_compressed);
+  if (!unique_blocks.is_compressed) {
+    return;
+  }
+  read_bin(fp, unique_blocks.sb_blocks);
+  read_bin(fp, unique_blocks.cbx_blocks);
+  read_bin(fp, unique_blocks.cby_blocks);
+}
+
+/***************************************************************************************
+ * Rebuild the look-ups of unique blocks in device_rr_gsb
+ ***************************************************************************************/
+static void load_checkpoint_unique_blocks(
+  const CheckpointUniqueBlocks& unique_blocks, DeviceRRGSB& device_rr_gsb) {
+  if (!unique_blocks.is_compressed) {
+    return;
+  }
+
+  device_rr_gsb.clear_unique_modules();
+  device_rr_gsb.reserve_unique_modules();
+
+  for (const auto& block : unique_blocks.sb_blocks) {
+    device_rr_gsb.preload_unique_sb_module(block.first, block.second);
+  }
+  for (const auto& block : unique_blocks.cbx_blocks) {
+    device_rr_gsb.preload_unique_cbx_module(block.first, block.second);
+  }
+  for (const auto& block : unique_blocks.cby_blocks) {
+    device_rr_gsb.preload_unique_cby_module(block.first, block.second);
+  }
+
+  device_rr_gsb.build_gsb_unique_module();
+}
+
+/***************************************************************************************
+ * Decoder library and module name map are small, which are written through
+ * their public APIs
+ ***************************************************************************************/
+static void write_checkpoint_decoder_library(
+  std::ostream& fp, const DecoderLibrary& decoder_lib) {
+  write_bin(fp, size_t(decoder_lib.decoders().size()));
+  for (const DecoderId& decoder : decoder_lib.decoders()) {
+    write_bin(fp, decoder_lib.addr_size(decoder));
+    write_bin(fp, decoder_lib.data_size(decoder));
+    write_bin(fp, decoder_lib.use_enable(decoder));
+    write_bin(fp, decoder_lib.use_data_in(decoder));
+    write_bin(fp, decoder_lib.use_data_inv_port(decoder));
+    write_bin(fp, decoder_lib.use_readback(decoder));
+  }
+}
+
+static void read_checkpoint_decoder_library(std::istream& fp,
+                                            DecoderLibrary& decoder_lib) {
+  size_t num_decoders = read_bin_size(fp);
+  for (size_t idec = 0; idec < num_decoders; ++idec) {
+    size_t addr_size = 0;
+    size_t data_size = 0;
+    bool use_enable = false;
+    bool use_data_in = false;
+    bool use_data_inv_port = false;
+    bool use_readback = false;
+    read_bin(fp, addr_size);
+    read_bin(fp, data_size);
+    read_bin(fp, use_enable);
+    read_bin(fp, use_data_in);
+    read_bin(fp, use_data_inv_port);
+    read_bin(fp, use_readback);
+    decoder_lib.add_decoder(addr_size, data_size, use_enable, use_data_in,
+                            use_data_inv_port, use_readback);
+  }
+}
+
+static void write_checkpoint_module_name_map(
+  std::ostream& fp, const ModuleNameMap& module_name_map) {
+  std::vector<std::string> tags = module_name_map.tags();
+  write_bin(fp, tags.size());
+  for (const std::string& tag : tags) {
+    write_bin(fp, tag);
+    write_bin(fp, module_name_map.name(tag));
+  }
+}
+
+static int read_checkpoint_module_name_map(std::istream& fp,
+                                           ModuleNameMap& module_name_map) {
+  size_t num_tags = read_bin_size(fp);
+  for (size_t itag = 0; itag < num_tags; ++itag) {
+    std::string tag;
+    std::string name;
+    read_bin(fp, tag);
+    read_bin(fp, name);
+    if (CMD_EXEC_SUCCESS != module_name_map.set_tag_to_name_pair(tag, name)) {
+      return CMD_EXEC_FATAL_ERROR;
+    }
+  }
+  return CMD_EXEC_SUCCESS;
+}
+
+/***************************************************************************************
+ * Top-level function to write a fabric checkpoint
+ ***************************************************************************************/
+int write_fabric_checkpoint(const std::string& fname, const DeviceGrid& grids,
+                            const FabricCheckpointHeader& header,
+                            const DeviceRRGSB& device_rr_gsb,
+                            const ModuleManager& module_manager,
+                            const DecoderLibrary& decoder_lib,
+                            const MemoryBankShiftRegisterBanks& blwl_sr_banks,
+                            const FabricTile& fabric_tile,
+                            const ModuleNameMap& module_name_map,
+                            const bool& verbose) {
+  std::string timer_message =
+    std::string("Write fabric checkpoint to file '") + fname + std::string("'");
+  vtr::ScopedStartFinishTimer timer(timer_message);
+
+  std::fstream fp;
+  fp.open(fname,
+          std::fstream::out | std::fstream::trunc | std::fstream::binary);
+  check_file_stream(fname.c_str(), fp);
+
+  write_bin(fp, std::string(FABRIC_CHECKPOINT_MAGIC));
+  write_bin(fp, FABRIC_CHECKPOINT_VERSION);
+  write_bin(fp, grids.width());
+  write_bin(fp, grids.height());
+  write_bin(fp, header.arch_digest);
+  write_bin(fp, header.frame_view);
+  write_bin(fp, header.duplicate_grid_pin);
+  write_bin(fp, header.group_config_block);
+  write_bin(fp, header.name_module_using_index);
+
+  write_checkpoint_unique_blocks(fp, device_rr_gsb);
+  module_manager.write_to_bin_stream(fp);
+  write_checkpoint_decoder_library(fp, decoder_lib);
+  blwl_sr_banks.write_to_bin_stream(fp);
+  fabric_tile.write_to_bin_stream(fp);
+  write_checkpoint_module_name_map(fp, module_name_map);
+
+  if (!fp.good()) {
+    VTR_LOG_ERROR("Failed to write fabric checkpoint to file '%s'!\n",
+                  fname.c_str());
+    fp.close();
+    return CMD_EXEC_FATAL_ERROR;
+  }
+  fp.close();
+
+  VTR_LOGV(verbose, "Written %lu modules to fabric checkpoint\n",
+           module_manager.modules().size());
+
+  return CMD_EXEC_SUCCESS;
+}
+
+/***************************************************************************************
+ * Top-level function to read a fabric checkpoint
+ * The checkpoint is rejected if it is created by another version of the
+ * writer, for a device grid in a different size or for another architecture,
+ * whose digest is given in the header. The options of build_fabric are
+ * restored to the header
+ ***************************************************************************************/
+int read_fabric_checkpoint(const std::string& fname, const DeviceGrid& grids,
+                           FabricCheckpointHeader& header,
+                           DeviceRRGSB& device_rr_gsb,
+                           ModuleManager& module_manager,
+                           DecoderLibrary& decoder_lib,
+                           MemoryBankShiftRegisterBanks& blwl_sr_banks,
+                           FabricTile& fabric_tile,
+                           ModuleNameMap& module_name_map,
+                           const bool& verbose) {
+  std::string timer_message =
+    std::string("Read fabric checkpoint from file '") + fname +
+    std::string("'");
+  vtr::ScopedStartFinishTimer timer(timer_message);
+
+  std::fstream fp;
+  fp.open(fname, std::fstream::in | std::fstream::binary);
+  if (!valid_file_stream(fp)) {
+    VTR_LOG_ERROR("Unable to open fabric checkpoint '%s'!\n", fname.c_str());
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  std::string magic;
+  size_t version = 0;
+  size_t width = 0;
+  size_t height = 0;
+  read_bin(fp, magic);
+  read_bin(fp, version);
+  if (!fp.good() || magic != std::string(FABRIC_CHECKPOINT_MAGIC)) {
+    VTR_LOG_ERROR("File '%s' is not a fabric checkpoint!\n", fname.c_str());
+    return CMD_EXEC_FATAL_ERROR;
+  }
+  if (version != FABRIC_CHECKPOINT_VERSION) {
+    VTR_LOG_ERROR(
+      "Fabric checkpoint '%s' has a version '%lu' while version '%lu' is "
+      "expected! Please regenerate the checkpoint.\n",
+      fname.c_str(), version, FABRIC_CHECKPOINT_VERSION);
+    return CMD_EXEC_FATAL_ERROR;
+  }
+  read_bin(fp, width);
+  read_bin(fp, height);
+  if (width != grids.width() || height != grids.height()) {
+    VTR_LOG_ERROR(
+      "Fabric checkpoint '%s' is created for a device grid of %lux%lu, which "
+      "does not match the current device grid of %lux%lu!\n",
+      fname.c_str(), width, height, grids.width(), grids.height());
+    return CMD_EXEC_FATAL_ERROR;
+  }
+  uint64_t arch_digest = 0;
+  read_bin(fp, arch_digest);
+  if (!fp.good() || arch_digest != header.arch_digest) {
+    VTR_LOG_ERROR(
+      "Fabric checkpoint '%s' is created for another architecture or routing "
+      "resource graph! Please regenerate the checkpoint.\n",
+      fname.c_str());
+    return CMD_EXEC_FATAL_ERROR;
+  }
+  FabricCheckpointHeader ckpt_header = header;
+  read_bin(fp, ckpt_header.frame_view);
+  read_bin(fp, ckpt_header.duplicate_grid_pin);
+  read_bin(fp, ckpt_header.group_config_block);
+  read_bin(fp, ckpt_header.name_module_using_index);
+
+  /* Read into temporary data structures, so that the current fabric is kept
+   * as it is when the checkpoint is corrupted */
+  CheckpointUniqueBlocks ckpt_unique_blocks;
+  ModuleManager ckpt_module_manager;
+  DecoderLibrary ckpt_decoder_lib;
+  MemoryBankShiftRegisterBanks ckpt_blwl_sr_banks;
+  FabricTile ckpt_fabric_tile;
+  ModuleNameMap ckpt_module_name_map;
+  read_checkpoint_unique_blocks(fp, ckpt_unique_blocks);
+  ckpt_module_manager.read_from_bin_stream(fp);
+  read_checkpoint_decoder_library(fp, ckpt_decoder_lib);
+  ckpt_blwl_sr_banks.read_from_bin_stream(fp);
+  ckpt_fabric_tile.read_from_bin_stream(fp);
+  int status = read_checkpoint_module_name_map(fp, ckpt_module_name_map);
+
+  if (!fp.good() || CMD_EXEC_SUCCESS != status) {
+    VTR_LOG_ERROR("Fabric checkpoint '%s' is corrupted!\n", fname.c_str());
+    return CMD_EXEC_FATAL_ERROR;
+  }
+  fp.close();
+
+  header = ckpt_header;
+  load_checkpoint_unique_blocks(ckpt_unique_blocks, device_rr_gsb);
+  module_manager = std::move(ckpt_module_manager);
+  decoder_lib = std::move(ckpt_decoder_lib);
+  blwl_sr_banks = std::move(ckpt_blwl_sr_banks);
+  fabric_tile = std::move(ckpt_fabric_tile);
+  module_name_map = std::move(ckpt_module_name_map);
+
+  VTR_LOGV(verbose, "Read %lu modules from fabric checkpoint\n",
+           module_manager.modules().size());
+
+  return CMD_EXEC_SUCCESS;
+}
+
+} /* end namespace openfpga */
@@ -0,0 +1,60 @@
+#ifndef FABRIC_CHECKPOINT_H
+#define FABRIC_CHECKPOINT_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include <cstdint>
+#include <string>
+
+#include "decoder_library.h"
+#include "device_grid.h"
+#include "device_rr_gsb.h"
+#include "fabric_tile.h"
+#include "memory_bank_shift_register_banks.h"
+#include "module_manager.h"
+#include "module_name_map.h"
+
+/********************************************************************
+ * Function declaration
+ *******************************************************************/
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/* Identification of the fabric in a checkpoint header. A checkpoint is
+ * rejected when it is read for another architecture */
+struct FabricCheckpointHeader {
+  /* Digest of the VPR and OpenFPGA architectures and the routing resource
+   * graph, which the fabric is built for */
+  uint64_t arch_digest = 0;
+  /* Options of 'build_fabric', which are restored with the fabric */
+  bool frame_view = false;
+  bool duplicate_grid_pin = false;
+  bool group_config_block = false;
+  bool name_module_using_index = false;
+};
+
+int write_fabric_checkpoint(const std::string& fname, const DeviceGrid& grids,
+                            const FabricCheckpointHeader& header,
+                            const DeviceRRGSB& device_rr_gsb,
+                            const ModuleManager& module_manager,
+                            const DecoderLibrary& decoder_lib,
+                            const MemoryBankShiftRegisterBanks& blwl_sr_banks,
+                            const FabricTile& fabric_tile,
+                            const ModuleNameMap& module_name_map,
+                            const bool& verbose);
+
+int read_fabric_checkpoint(const std::string& fname, const DeviceGrid& grids,
+                           FabricCheckpointHeader& header,
+                           DeviceRRGSB& device_rr_gsb,
+                           ModuleManager& module_manager,
+                           DecoderLibrary& decoder_lib,
+                           MemoryBankShiftRegisterBanks& blwl_sr_banks,
+                           FabricTile& fabric_tile,
+                           ModuleNameMap& module_name_map,
+                           const bool& verbose);
+
+} /* end namespace openfpga */
+
+#endif
@@ -2,6 +2,7 @@
 
 #include <algorithm>
 
+#include "openfpga_bin_stream.h"
 #include "openfpga_reserved_words.h"
 #include "vtr_assert.h"
 
@@ -493,6 +494,45 @@ bool MemoryBankShiftRegisterBanks::empty() const {
   return bl_bank_ids_.empty() && wl_bank_ids_.empty();
 }
 
+void MemoryBankShiftRegisterBanks::write_to_bin_stream(std::ostream& fp) const {
+  write_bin(fp, config_region_ids_);
+  write_bin(fp, bl_bank_ids_);
+  write_bin(fp, bl_bank_data_ports_);
+  write_bin(fp, bl_bank_modules_);
+  write_bin(fp, bl_bank_instances_);
+  write_bin(fp, bl_bank_sink_child_ids_);
+  write_bin(fp, bl_bank_sink_child_pin_ids_);
+  write_bin(fp, wl_bank_ids_);
+  write_bin(fp, wl_bank_data_ports_);
+  write_bin(fp, wl_bank_modules_);
+  write_bin(fp, wl_bank_instances_);
+  write_bin(fp, wl_bank_sink_child_ids_);
+  write_bin(fp, wl_bank_sink_child_pin_ids_);
+}
+
+void MemoryBankShiftRegisterBanks::read_from_bin_stream(std::istream& fp) {
+  read_bin(fp, config_region_ids_);
+  read_bin(fp, bl_bank_ids_);
+  read_bin(fp, bl_bank_data_ports_);
+  read_bin(fp, bl_bank_modules_);
+  read_bin(fp, bl_bank_instances_);
+  read_bin(fp, bl_bank_sink_child_ids_);
+  read_bin(fp, bl_bank_sink_child_pin_ids_);
+  read_bin(fp, wl_bank_ids_);
+  read_bin(fp, wl_bank_data_ports_);
+  read_bin(fp, wl_bank_modules_);
+  read_bin(fp, wl_bank_instances_);
+  read_bin(fp, wl_bank_sink_child_ids_);
+  read_bin(fp, wl_bank_sink_child_pin_ids_);
+  /* Fast look-ups will be rebuilt when required */
+  bl_ports_to_sr_bank_ids_.clear();
+  bl_ports_to_sr_bank_ports_.clear();
+  wl_ports_to_sr_bank_ids_.clear();
+  wl_ports_to_sr_bank_ports_.clear();
+  is_bl_bank_dirty_ = true;
+  is_wl_bank_dirty_ = true;
+}
+
 void MemoryBankShiftRegisterBanks::build_bl_port_fast_lookup() const {
   bl_ports_to_sr_bank_ids_.resize(bl_bank_data_ports_.size());
   bl_ports_to_sr_bank_ports_.resize(bl_bank_data_ports_.size());
@@ -1,7 +1,9 @@
 #ifndef MEMORY_BANK_SHIFT_REGISTER_BANKS_H
 #define MEMORY_BANK_SHIFT_REGISTER_BANKS_H
 
+#include <istream>
 #include <map>
+#include <ostream>
 #include <vector>
 
 #include "fabric_key.h"
@@ -230,6 +232,14 @@ class MemoryBankShiftRegisterBanks {
                                             const size_t& sink_child_id,
                                             const size_t& sink_child_pin_id);
 
+ public: /* Serializers */
+  /* @brief Write all the general information to a binary stream. Fast look-ups
+   * are not written, as they can be rebuilt on demand */
+  void write_to_bin_stream(std::ostream& fp) const;
+  /* @brief Restore the general information from a binary stream. Any existing
+   * data will be overwritten */
+  void read_from_bin_stream(std::istream& fp);
+
  public: /* Validators */
   bool valid_region_id(const ConfigRegionId& region) const;
   bool valid_bl_bank_id(const ConfigRegionId& region_id,
@@ -4,10 +4,12 @@
 #include "module_manager.h"
 
 #include <algorithm>
+#include <iterator>
 #include <numeric>
 #include <string>
 
 #include "circuit_library.h"
+#include "openfpga_bin_stream.h"
 #include "vtr_assert.h"
 #include "vtr_log.h"
 
@@ -336,7 +338,7 @@ ModulePortId ModuleManager::find_module_port(
 
   /* Iterate over the ports of the module */
   for (const auto& port : port_ids_[module_id]) {
-    if (0 == port_name.compare(ports_[module_id][port].get_name())) {
+    if (port_name == ports_[module_id][port].get_name()) {
       /* Find it, return the id */
       return port;
     }
@@ -377,9 +379,9 @@ size_t ModuleManager::num_instance(const ModuleId& parent_module,
 }
 
 /* Find the instance name of a child module */
-std::string ModuleManager::instance_name(const ModuleId& parent_module,
-                                         const ModuleId& child_module,
-                                         const size_t& instance_id) const {
+const std::string& ModuleManager::instance_name(
+  const ModuleId& parent_module, const ModuleId& child_module,
+  const size_t& instance_id) const {
   /* Validate the id of both parent and child modules */
   VTR_ASSERT(valid_module_id(parent_module));
   VTR_ASSERT(valid_module_id(child_module));
@@ -390,7 +392,7 @@ std::string ModuleManager::instance_name(const ModuleId& parent_module,
   VTR_ASSERT(child_index < children_[parent_module].size());
   /* Ensure that instance id is valid */
   VTR_ASSERT(instance_id < num_instance(parent_module, child_module));
-  return child_instance_names_[parent_module][child_index][instance_id];
+  return child_instance_names_[parent_module][child_index][instance_id].str();
 }
 
 /* Find the instance id of a given instance name */
@@ -406,13 +408,31 @@ size_t ModuleManager::instance_id(const ModuleId& parent_module,
     find_child_module_index_in_parent_module(parent_module, child_module);
   VTR_ASSERT(child_index < children_[parent_module].size());
 
+  /* A name which is not in the symbol table cannot be an instance name */
+  Symbol inst_symbol = Symbol::find(instance_name);
+  if (!inst_symbol.is_valid()) {
+    return size_t(-1);
+  }
+
+  /* Use the fast look-up first, which covers all the named instances. When
+   * a name is duplicated, the first instance is returned */
+  size_t inst_id = size_t(-1);
+  auto range = instance_name_lookup_[parent_module].equal_range(inst_symbol);
+  for (auto it = range.first; it != range.second; ++it) {
+    if (child_module == it->second.first) {
+      inst_id = std::min(inst_id, it->second.second);
+    }
+  }
+  if (size_t(-1) != inst_id) {
+    return inst_id;
+  }
+
   /* Search the instance name list and try to find a match */
   for (size_t name_id = 0;
        name_id < child_instance_names_[parent_module][child_index].size();
        ++name_id) {
-    const std::string& name =
-      child_instance_names_[parent_module][child_index][name_id];
-    if (0 == name.compare(instance_name)) {
+    if (inst_symbol ==
+        child_instance_names_[parent_module][child_index][name_id]) {
       return name_id;
     }
   }
@@ -421,6 +441,36 @@ size_t ModuleManager::instance_id(const ModuleId& parent_module,
   return size_t(-1);
 }
 
+/* Find the child module and instance id of a given instance name */
+std::pair<ModuleId, size_t> ModuleManager::find_child_instance(
+  const ModuleId& parent_module, const std::string& instance_name) const {
+  VTR_ASSERT(valid_module_id(parent_module));
+
+  Symbol inst_symbol = Symbol::find(instance_name);
+  if (!inst_symbol.is_valid()) {
+    return std::make_pair(ModuleId::INVALID(), 0);
+  }
+  auto range = instance_name_lookup_[parent_module].equal_range(inst_symbol);
+  if (range.first == range.second) {
+    return std::make_pair(ModuleId::INVALID(), 0);
+  }
+  /* When a name is duplicated, return the first instance in the order of
+   * child modules and then instances */
+  std::pair<ModuleId, size_t> result = range.first->second;
+  size_t result_child_index =
+    find_child_module_index_in_parent_module(parent_module, result.first);
+  for (auto it = std::next(range.first); it != range.second; ++it) {
+    size_t child_index =
+      find_child_module_index_in_parent_module(parent_module, it->second.first);
+    if (std::make_pair(child_index, it->second.second) <
+        std::make_pair(result_child_index, result.second)) {
+      result = it->second;
+      result_child_index = child_index;
+    }
+  }
+  return result;
+}
+
 size_t ModuleManager::num_configurable_children(
   const ModuleId& parent_module, const e_config_child_type& type) const {
   VTR_ASSERT(valid_module_id(parent_module));
@@ -517,7 +567,7 @@ vtr::vector<ModuleNetSrcId, ModuleId> ModuleManager::net_source_modules(
   vtr::vector<ModuleNetSrcId, ModuleId> src_modules;
   src_modules.reserve(net_src_terminal_ids_[module][net].size());
   for (const size_t& id : net_src_terminal_ids_[module][net]) {
-    src_modules.push_back(net_terminal_storage_[id].first);
+    src_modules.push_back(net_terminal(module, id).first);
   }
 
   return src_modules;
@@ -541,7 +591,7 @@ vtr::vector<ModuleNetSrcId, ModulePortId> ModuleManager::net_source_ports(
   vtr::vector<ModuleNetSrcId, ModulePortId> src_ports;
   src_ports.reserve(net_src_terminal_ids_[module][net].size());
   for (const size_t& id : net_src_terminal_ids_[module][net]) {
-    src_ports.push_back(net_terminal_storage_[id].second);
+    src_ports.push_back(net_terminal(module, id).second);
   }
 
   return src_ports;
@@ -573,11 +623,11 @@ bool ModuleManager::net_source_exist(const ModuleId& module,
    */
   for (const ModuleNetSrcId& net_src : module_net_sources(module, net)) {
     if ((src_module ==
-         net_terminal_storage_[net_src_terminal_ids_[module][net][net_src]]
+         net_terminal(module, net_src_terminal_ids_[module][net][net_src])
            .first) &&
         (instance_id == net_source_instances(module, net)[net_src]) &&
         (src_port ==
-         net_terminal_storage_[net_src_terminal_ids_[module][net][net_src]]
+         net_terminal(module, net_src_terminal_ids_[module][net][net_src])
            .second) &&
         (src_pin == net_source_pins(module, net)[net_src])) {
       return true;
@@ -597,7 +647,7 @@ vtr::vector<ModuleNetSinkId, ModuleId> ModuleManager::net_sink_modules(
   vtr::vector<ModuleNetSinkId, ModuleId> sink_modules;
   sink_modules.reserve(net_sink_terminal_ids_[module][net].size());
   for (const size_t& id : net_sink_terminal_ids_[module][net]) {
-    sink_modules.push_back(net_terminal_storage_[id].first);
+    sink_modules.push_back(net_terminal(module, id).first);
   }
 
   return sink_modules;
@@ -621,7 +671,7 @@ vtr::vector<ModuleNetSinkId, ModulePortId> ModuleManager::net_sink_ports(
   vtr::vector<ModuleNetSinkId, ModulePortId> sink_ports;
   sink_ports.reserve(net_sink_terminal_ids_[module][net].size());
   for (const size_t& id : net_sink_terminal_ids_[module][net]) {
-    sink_ports.push_back(net_terminal_storage_[id].second);
+    sink_ports.push_back(net_terminal(module, id).second);
   }
 
   return sink_ports;
@@ -652,11 +702,11 @@ bool ModuleManager::net_sink_exist(const ModuleId& module,
    */
   for (const ModuleNetSinkId& net_sink : module_net_sinks(module, net)) {
     if ((sink_module ==
-         net_terminal_storage_[net_sink_terminal_ids_[module][net][net_sink]]
+         net_terminal(module, net_sink_terminal_ids_[module][net][net_sink])
            .first) &&
         (instance_id == net_sink_instances(module, net)[net_sink]) &&
         (sink_port ==
-         net_terminal_storage_[net_sink_terminal_ids_[module][net][net_sink]]
+         net_terminal(module, net_sink_terminal_ids_[module][net][net_sink])
            .second) &&
         (sink_pin == net_sink_pins(module, net)[net_sink])) {
       return true;
@@ -687,6 +737,63 @@ bool ModuleManager::unified_configurable_children(
   return true;
 }
 
+void ModuleManager::memory_usage(MemoryUsage& usage) const {
+  /* Module-level data */
+  usage.add_container(ids_);
+  usage.add_container(names_);
+  usage.add_container(usages_);
+  usage.add_container(parents_);
+  usage.add_container(children_);
+  usage.add_container(num_child_instances_);
+  usage.add_container(child_instance_names_);
+  usage.add_container(logical_configurable_children_);
+  usage.add_container(logical_configurable_child_instances_);
+  usage.add_container(logical2physical_configurable_children_);
+  usage.add_container(logical2physical_configurable_child_instance_names_);
+  usage.add_container(physical_configurable_children_);
+  usage.add_container(physical_configurable_child_instances_);
+  usage.add_container(physical_configurable_child_regions_);
+  usage.add_container(physical_configurable_child_coordinates_);
+  usage.add_container(config_region_ids_);
+  usage.add_container(config_region_children_);
+  usage.add_container(io_children_);
+  usage.add_container(io_child_instances_);
+  usage.add_container(io_child_coordinates_);
+
+  /* Port-level data */
+  usage.add_container(port_ids_);
+  usage.add_container(ports_);
+  usage.add_container(port_types_);
+  usage.add_container(port_sides_);
+  usage.add_container(port_is_mappable_io_);
+  usage.add_container(port_is_wire_);
+  usage.add_container(port_is_register_);
+  usage.add_container(port_preproc_flags_);
+
+  /* Graph-level data */
+  usage.add_container(num_nets_);
+  usage.add_container(invalid_net_ids_);
+  usage.add_container(net_names_);
+  usage.add_container(net_src_ids_);
+  usage.add_container(net_src_terminal_ids_);
+  usage.add_container(net_src_instance_ids_);
+  usage.add_container(net_src_pin_ids_);
+  usage.add_container(net_sink_ids_);
+  usage.add_container(net_sink_terminal_ids_);
+  usage.add_container(net_sink_instance_ids_);
+  usage.add_container(net_sink_pin_ids_);
+  usage.add_container(net_terminal_storage_);
+  usage.add_container(staged_modules_);
+  usage.add_container(is_staged_);
+  usage.add_container(staged_net_terminals_);
+
+  /* Fast look-ups */
+  usage.add_lookup(name_id_map_);
+  usage.add_lookup(instance_name_lookup_);
+  usage.add_lookup(port_lookup_);
+  usage.add_lookup(net_lookup_);
+}
+
 /******************************************************************************
  * Private Accessors
  ******************************************************************************/
@@ -706,11 +813,79 @@ size_t ModuleManager::find_child_module_index_in_parent_module(
   return size_t(-1);
 }
 
+bool ModuleManager::module_staged(const ModuleId& module) const {
+  return (size_t(module) < is_staged_.size()) && is_staged_[module];
+}
+
+const std::pair<ModuleId, ModulePortId>& ModuleManager::net_terminal(
+  const ModuleId& module, const size_t& terminal_id) const {
+  if (module_staged(module)) {
+    return staged_net_terminals_[module][terminal_id];
+  }
+  return net_terminal_storage_[terminal_id];
+}
+
+/******************************************************************************
+ * Private Mutators
+ ******************************************************************************/
+void ModuleManager::build_instance_name_lookup() {
+  instance_name_lookup_.clear();
+  instance_name_lookup_.resize(ids_.size());
+  for (const ModuleId& parent_module : ids_) {
+    for (size_t child_index = 0; child_index < children_[parent_module].size();
+         ++child_index) {
+      const std::vector<Symbol>& inst_names =
+        child_instance_names_[parent_module][child_index];
+      for (size_t inst_id = 0; inst_id < inst_names.size(); ++inst_id) {
+        if (inst_names[inst_id].empty()) {
+          continue;
+        }
+        instance_name_lookup_[parent_module].emplace(
+          inst_names[inst_id],
+          std::make_pair(children_[parent_module][child_index], inst_id));
+      }
+    }
+  }
+}
+
+size_t ModuleManager::find_or_add_net_terminal(
+  const ModuleId& module, const std::pair<ModuleId, ModulePortId>& terminal) {
+  /* A staged module only searches its own terminals, which are merged into
+   * the shared storage when the module is committed */
+  std::vector<std::pair<ModuleId, ModulePortId>>& storage =
+    module_staged(module) ? staged_net_terminals_[module]
+                          : net_terminal_storage_;
+  /* Search in the storage. If found, use the existing pair
+   * Otherwise, add the pair
+   */
+  std::vector<std::pair<ModuleId, ModulePortId>>::iterator it =
+    std::find(storage.begin(), storage.end(), terminal);
+  if (it == storage.end()) {
+    storage.push_back(terminal);
+    return storage.size() - 1;
+  }
+  return std::distance(storage.begin(), it);
+}
+
+void ModuleManager::add_parent_module(const ModuleId& child_module,
+                                      const ModuleId& parent_module) {
+  std::vector<ModuleId>::iterator parent_it =
+    std::find(parents_[child_module].begin(), parents_[child_module].end(),
+              parent_module);
+  if (parent_it == parents_[child_module].end()) {
+    /* Update the parent module of child module */
+    parents_[child_module].push_back(parent_module);
+  }
+}
+
 /******************************************************************************
  * Public Mutators
  ******************************************************************************/
 /* Add a module */
 ModuleId ModuleManager::add_module(const std::string& name) {
+  /* Modules cannot be added when staged modules are being built */
+  VTR_ASSERT(staged_modules_.empty());
+
   /* Find if the name has been used. If used, return an invalid Id and report
    * error! */
   std::map<std::string, ModuleId>::iterator it = name_id_map_.find(name);
@@ -729,6 +904,7 @@ ModuleId ModuleManager::add_module(const std::string& name) {
   children_.emplace_back();
   num_child_instances_.emplace_back();
   child_instance_names_.emplace_back();
+  instance_name_lookup_.emplace_back();
   logical_configurable_children_.emplace_back();
   logical_configurable_child_instances_.emplace_back();
   physical_configurable_children_.emplace_back();
@@ -784,6 +960,75 @@ ModuleId ModuleManager::add_module(const std::string& name) {
   return module;
 }
 
+void ModuleManager::stage_modules(const std::vector<ModuleId>& modules) {
+  /* Staged modules must be committed before staging another group */
+  VTR_ASSERT(staged_modules_.empty());
+
+  is_staged_.clear();
+  is_staged_.resize(ids_.size(), false);
+  staged_net_terminals_.clear();
+  staged_net_terminals_.resize(ids_.size());
+  for (const ModuleId& module : modules) {
+    VTR_ASSERT(valid_module_id(module));
+    VTR_ASSERT(false == is_staged_[module]);
+    is_staged_[module] = true;
+    staged_modules_.push_back(module);
+
+    /* Nets which have been added refer to the shared storage. Copy their
+     * terminals to the staged storage */
+    for (vtr::vector<ModuleNetSrcId, size_t>& net_terminal_ids :
+         net_src_terminal_ids_[module]) {
+      for (size_t& terminal_id : net_terminal_ids) {
+        terminal_id = find_or_add_net_terminal(
+          module, net_terminal_storage_[terminal_id]);
+      }
+    }
+    for (vtr::vector<ModuleNetSinkId, size_t>& net_terminal_ids :
+         net_sink_terminal_ids_[module]) {
+      for (size_t& terminal_id : net_terminal_ids) {
+        terminal_id = find_or_add_net_terminal(
+          module, net_terminal_storage_[terminal_id]);
+      }
+    }
+  }
+}
+
+void ModuleManager::commit_staged_modules() {
+  for (const ModuleId& module : staged_modules_) {
+    /* Register the module as a parent of its children */
+    for (const ModuleId& child_module : children_[module]) {
+      add_parent_module(child_module, module);
+    }
+
+    /* Move the net terminals to the shared storage */
+    std::vector<size_t> terminal_ids;
+    terminal_ids.reserve(staged_net_terminals_[module].size());
+    /* Unstage the module first, so that terminals are added to the shared
+     * storage */
+    is_staged_[module] = false;
+    for (const std::pair<ModuleId, ModulePortId>& terminal :
+         staged_net_terminals_[module]) {
+      terminal_ids.push_back(find_or_add_net_terminal(module, terminal));
+    }
+    for (vtr::vector<ModuleNetSrcId, size_t>& net_terminal_ids :
+         net_src_terminal_ids_[module]) {
+      for (size_t& terminal_id : net_terminal_ids) {
+        terminal_id = terminal_ids[terminal_id];
+      }
+    }
+    for (vtr::vector<ModuleNetSinkId, size_t>& net_terminal_ids :
+         net_sink_terminal_ids_[module]) {
+      for (size_t& terminal_id : net_terminal_ids) {
+        terminal_id = terminal_ids[terminal_id];
+      }
+    }
+  }
+
+  staged_modules_.clear();
+  is_staged_.clear();
+  staged_net_terminals_.clear();
+}
+
 /* Add a port to a module */
 ModulePortId ModuleManager::add_port(const ModuleId& module,
                                      const BasicPort& port_info,
@@ -919,13 +1164,11 @@ void ModuleManager::add_child_module(const ModuleId& parent_module,
   VTR_ASSERT(valid_module_id(parent_module));
   VTR_ASSERT(valid_module_id(child_module));
 
-  /* Try to find if the parent module is already in the list */
-  std::vector<ModuleId>::iterator parent_it =
-    std::find(parents_[child_module].begin(), parents_[child_module].end(),
-              parent_module);
-  if (parent_it == parents_[child_module].end()) {
-    /* Update the parent module of child module */
-    parents_[child_module].push_back(parent_module);
+  /* Try to find if the parent module is already in the list
+   * A staged parent is added to the list when it is committed, as the child
+   * module may be shared by other staged modules */
+  if (false == module_staged(parent_module)) {
+    add_parent_module(child_module, parent_module);
   }
 
   std::vector<ModuleId>::iterator child_it =
@@ -982,9 +1225,24 @@ void ModuleManager::set_child_instance_name(const ModuleId& parent_module,
     find_child_module_index_in_parent_module(parent_module, child_module);
   /* We must find something! */
   VTR_ASSERT(size_t(-1) != child_index);
+  /* Update the fast look-up: drop the entry of this instance under its old
+   * name, while other instances with the same name are kept */
+  Symbol& curr_name =
+    child_instance_names_[parent_module][child_index][instance_id];
+  Symbol new_name(instance_name);
+  auto range = instance_name_lookup_[parent_module].equal_range(curr_name);
+  for (auto it = range.first; it != range.second; ++it) {
+    if (it->second == std::make_pair(child_module, instance_id)) {
+      instance_name_lookup_[parent_module].erase(it);
+      break;
+    }
+  }
+  if (!new_name.empty()) {
+    instance_name_lookup_[parent_module].emplace(
+      new_name, std::make_pair(child_module, instance_id));
+  }
   /* Set the name */
-  child_instance_names_[parent_module][child_index][instance_id] =
-    instance_name;
+  curr_name = new_name;
 }
 
 /* Add a configurable child module to module
@@ -1280,21 +1538,9 @@ ModuleNetSrcId ModuleManager::add_module_net_source(
   /* Validate the port exists in the src module */
   VTR_ASSERT(valid_module_port_id(src_module, src_port));
 
-  /* Create pair of module and port
-   * Search in the storage. If found, use the existing pair
-   * Otherwise, add the pair
-   */
-  std::pair<ModuleId, ModulePortId> terminal(src_module, src_port);
-  std::vector<std::pair<ModuleId, ModulePortId>>::iterator it = std::find(
-    net_terminal_storage_.begin(), net_terminal_storage_.end(), terminal);
-  if (it == net_terminal_storage_.end()) {
-    net_src_terminal_ids_[module][net].push_back(net_terminal_storage_.size());
-    net_terminal_storage_.push_back(terminal);
-  } else {
-    VTR_ASSERT_SAFE(it != net_terminal_storage_.end());
-    net_src_terminal_ids_[module][net].push_back(
-      std::distance(net_terminal_storage_.begin(), it));
-  }
+  /* Create pair of module and port, which is shared if already used */
+  net_src_terminal_ids_[module][net].push_back(find_or_add_net_terminal(
+    module, std::make_pair(src_module, src_port)));
 
   /* if it has the same id as module, our instance id will be by default 0 */
   size_t src_instance_id = instance_id;
@@ -1347,21 +1593,9 @@ ModuleNetSinkId ModuleManager::add_module_net_sink(
   /* Validate the port exists in the sink module */
   VTR_ASSERT(valid_module_port_id(sink_module, sink_port));
 
-  /* Create pair of module and port
-   * Search in the storage. If found, use the existing pair
-   * Otherwise, add the pair
-   */
-  std::pair<ModuleId, ModulePortId> terminal(sink_module, sink_port);
-  std::vector<std::pair<ModuleId, ModulePortId>>::iterator it = std::find(
-    net_terminal_storage_.begin(), net_terminal_storage_.end(), terminal);
-  if (it == net_terminal_storage_.end()) {
-    net_sink_terminal_ids_[module][net].push_back(net_terminal_storage_.size());
-    net_terminal_storage_.push_back(terminal);
-  } else {
-    VTR_ASSERT_SAFE(it != net_terminal_storage_.end());
-    net_sink_terminal_ids_[module][net].push_back(
-      std::distance(net_terminal_storage_.begin(), it));
-  }
+  /* Create pair of module and port, which is shared if already used */
+  net_sink_terminal_ids_[module][net].push_back(find_or_add_net_terminal(
+    module, std::make_pair(sink_module, sink_port)));
 
   /* if it has the same id as module, our instance id will be by default 0 */
   size_t sink_instance_id = instance_id;
@@ -1511,6 +1745,131 @@ void ModuleManager::clear_module_net_sinks(const ModuleId& parent_module,
   net_sink_pin_ids_[parent_module][net].clear();
 }
 
+/******************************************************************************
+ * Public serializers
+ ******************************************************************************/
+/* Dump all the internal data, including fast look-ups, to a binary stream.
+ * Note that the sequence of data must be the same as read_from_bin_stream()
+ */
+void ModuleManager::write_to_bin_stream(std::ostream& fp) const {
+  /* Staged modules are not complete until they are committed */
+  VTR_ASSERT(staged_modules_.empty());
+
+  /* Module-level data */
+  write_bin(fp, ids_);
+  write_bin(fp, names_);
+  write_bin(fp, usages_);
+  write_bin(fp, parents_);
+  write_bin(fp, children_);
+  write_bin(fp, num_child_instances_);
+  write_bin(fp, child_instance_names_);
+  write_bin(fp, logical_configurable_children_);
+  write_bin(fp, logical_configurable_child_instances_);
+  write_bin(fp, logical2physical_configurable_children_);
+  write_bin(fp, logical2physical_configurable_child_instance_names_);
+  write_bin(fp, physical_configurable_children_);
+  write_bin(fp, physical_configurable_child_instances_);
+  write_bin(fp, physical_configurable_child_regions_);
+  write_bin(fp, physical_configurable_child_coordinates_);
+  write_bin(fp, config_region_ids_);
+  write_bin(fp, config_region_children_);
+  write_bin(fp, io_children_);
+  write_bin(fp, io_child_instances_);
+  write_bin(fp, io_child_coordinates_);
+
+  /* Port-level data */
+  write_bin(fp, port_ids_);
+  write_bin(fp, ports_);
+  write_bin(fp, port_types_);
+  write_bin(fp, port_sides_);
+  write_bin(fp, port_is_mappable_io_);
+  write_bin(fp, port_is_wire_);
+  write_bin(fp, port_is_register_);
+  write_bin(fp, port_preproc_flags_);
+
+  /* Graph-level data */
+  write_bin(fp, num_nets_);
+  write_bin(fp, invalid_net_ids_);
+  write_bin(fp, net_names_);
+  write_bin(fp, net_src_ids_);
+  write_bin(fp, net_src_terminal_ids_);
+  write_bin(fp, net_src_instance_ids_);
+  write_bin(fp, net_src_pin_ids_);
+  write_bin(fp, net_sink_ids_);
+  write_bin(fp, net_sink_terminal_ids_);
+  write_bin(fp, net_sink_instance_ids_);
+  write_bin(fp, net_sink_pin_ids_);
+
+  /* Fast look-ups */
+  write_bin(fp, name_id_map_);
+  write_bin(fp, port_lookup_);
+  write_bin(fp, net_lookup_);
+  write_bin(fp, net_terminal_storage_);
+}
+
+/* Restore all the internal data from a binary stream, which is created by
+ * write_to_bin_stream(). Any existing data will be overwritten
+ */
+void ModuleManager::read_from_bin_stream(std::istream& fp) {
+  /* Module-level data */
+  read_bin(fp, ids_);
+  read_bin(fp, names_);
+  read_bin(fp, usages_);
+  read_bin(fp, parents_);
+  read_bin(fp, children_);
+  read_bin(fp, num_child_instances_);
+  read_bin(fp, child_instance_names_);
+  read_bin(fp, logical_configurable_children_);
+  read_bin(fp, logical_configurable_child_instances_);
+  read_bin(fp, logical2physical_configurable_children_);
+  read_bin(fp, logical2physical_configurable_child_instance_names_);
+  read_bin(fp, physical_configurable_children_);
+  read_bin(fp, physical_configurable_child_instances_);
+  read_bin(fp, physical_configurable_child_regions_);
+  read_bin(fp, physical_configurable_child_coordinates_);
+  read_bin(fp, config_region_ids_);
+  read_bin(fp, config_region_children_);
+  read_bin(fp, io_children_);
+  read_bin(fp, io_child_instances_);
+  read_bin(fp, io_child_coordinates_);
+
+  /* Port-level data */
+  read_bin(fp, port_ids_);
+  read_bin(fp, ports_);
+  read_bin(fp, port_types_);
+  read_bin(fp, port_sides_);
+  read_bin(fp, port_is_mappable_io_);
+  read_bin(fp, port_is_wire_);
+  read_bin(fp, port_is_register_);
+  read_bin(fp, port_preproc_flags_);
+
+  /* Graph-level data */
+  read_bin(fp, num_nets_);
+  read_bin(fp, invalid_net_ids_);
+  read_bin(fp, net_names_);
+  read_bin(fp, net_src_ids_);
+  read_bin(fp, net_src_terminal_ids_);
+  read_bin(fp, net_src_instance_ids_);
+  read_bin(fp, net_src_pin_ids_);
+  read_bin(fp, net_sink_ids_);
+  read_bin(fp, net_sink_terminal_ids_);
+  read_bin(fp, net_sink_instance_ids_);
+  read_bin(fp, net_sink_pin_ids_);
+
+  /* Fast look-ups */
+  read_bin(fp, name_id_map_);
+  read_bin(fp, port_lookup_);
+  read_bin(fp, net_lookup_);
+  read_bin(fp, net_terminal_storage_);
+
+  /* Instance names are already serialized, so rebuild rather than store */
+  build_instance_name_lookup();
+
+  staged_modules_.clear();
+  is_staged_.clear();
+  staged_net_terminals_.clear();
+}
+
 /******************************************************************************
  * Private validators/invalidators
  ******************************************************************************/
@@ -1,14 +1,18 @@
 #ifndef MODULE_MANAGER_H
 #define MODULE_MANAGER_H
 
+#include <istream>
 #include <map>
+#include <ostream>
 #include <string>
 #include <tuple>
 #include <unordered_map>
 #include <unordered_set>
 
 #include "module_manager_fwd.h"
+#include "openfpga_memory_usage.h"
 #include "openfpga_port.h"
+#include "openfpga_symbol.h"
 #include "physical_types.h"
 #include "vtr_geometry.h"
 #include "vtr_vector.h"
@@ -261,13 +265,18 @@ class ModuleManager {
   size_t num_instance(const ModuleId& parent_module,
                       const ModuleId& child_module) const;
   /* Find the instance name of a child module */
-  std::string instance_name(const ModuleId& parent_module,
-                            const ModuleId& child_module,
-                            const size_t& instance_id) const;
+  const std::string& instance_name(const ModuleId& parent_module,
+                                   const ModuleId& child_module,
+                                   const size_t& instance_id) const;
   /* Find the instance id of a given instance name */
   size_t instance_id(const ModuleId& parent_module,
                      const ModuleId& child_module,
                      const std::string& instance_name) const;
+  /* Find the child module and its instance id with a given instance name
+   * under a parent module, without knowing the child module. Return an invalid
+   * module id if not found */
+  std::pair<ModuleId, size_t> find_child_instance(
+    const ModuleId& parent_module, const std::string& instance_name) const;
   /** @brief Count the number of logical configurable children */
   size_t num_configurable_children(const ModuleId& parent_module,
                                    const e_config_child_type& type) const;
@@ -337,13 +346,48 @@ class ModuleManager {
    * same as the physical configurable children */
   bool unified_configurable_children(const ModuleId& curr_module) const;
 
+  /* Accumulate the heap memory used by the module graph */
+  void memory_usage(MemoryUsage& usage) const;
+
  private: /* Private accessors */
   size_t find_child_module_index_in_parent_module(
     const ModuleId& parent_module, const ModuleId& child_module) const;
+  /* Identify if a module is being built in the staged mode */
+  bool module_staged(const ModuleId& module) const;
+  /* Find the pair of a module and a port of a net terminal, which is stored
+   * either in the staged storage of a module or in the shared storage */
+  const std::pair<ModuleId, ModulePortId>& net_terminal(
+    const ModuleId& module, const size_t& terminal_id) const;
+
+ private: /* Private mutators */
+  /* Rebuild the fast look-up on instance names from child_instance_names_ */
+  void build_instance_name_lookup();
+  /* Find the id of a net terminal used by a module. Add it if not found */
+  size_t find_or_add_net_terminal(
+    const ModuleId& module, const std::pair<ModuleId, ModulePortId>& terminal);
+  /* Register a parent module of a child module if not registered */
+  void add_parent_module(const ModuleId& child_module,
+                         const ModuleId& parent_module);
 
  public: /* Public mutators */
   /* Add a module */
   ModuleId add_module(const std::string& name);
+
+  /** @brief Start building the contents of a group of modules concurrently.
+   * The modules must have been added, so that their ids are reserved, and
+   * may already have contents.
+   * Until commit_staged_modules() is called,
+   * - each staged module can be modified by only one thread, where ports,
+   *   children and nets can be added as usual
+   * - other modules are read-only and no module can be added
+   * Updates on data shared by modules, i.e., the parents of child modules and
+   * the storage of net terminals, are staged per module */
+  void stage_modules(const std::vector<ModuleId>& modules);
+
+  /** @brief Merge the staged data of modules into the shared data, in the
+   * order of modules given to stage_modules(). The result does not depend on
+   * the sequence in which the staged modules have been built */
+  void commit_staged_modules();
   /* Add a port to a module */
   ModulePortId add_port(const ModuleId& module, const BasicPort& port_info,
                         const enum e_module_port_type& port_type);
@@ -531,6 +575,14 @@ class ModuleManager {
   void clear_module_net_sinks(const ModuleId& parent_module,
                               const ModuleNetId& net);
 
+ public: /* Public serializers */
+  /* Write all the internal data to a binary stream, which can be restored by
+   * read_from_bin_stream() without rebuilding the module graph */
+  void write_to_bin_stream(std::ostream& fp) const;
+  /* Restore all the internal data from a binary stream. Any existing data will
+   * be overwritten */
+  void read_from_bin_stream(std::istream& fp);
+
  public: /* Public validators/invalidators */
   bool valid_module_id(const ModuleId& module) const;
   bool valid_module_port_id(const ModuleId& module,
@@ -560,7 +612,7 @@ class ModuleManager {
     children_; /* Child modules that this module contain */
   vtr::vector<ModuleId, std::vector<size_t>>
     num_child_instances_; /* Number of children instance in each child module */
-  vtr::vector<ModuleId, std::vector<std::vector<std::string>>>
+  vtr::vector<ModuleId, std::vector<std::vector<Symbol>>>
     child_instance_names_; /* Number of children instance in each child module
                             */
 
@@ -694,6 +746,11 @@ class ModuleManager {
 
   /* fast look-up for module */
   std::map<std::string, ModuleId> name_id_map_;
+  /* fast look-up for child instances by name, where all the instances are
+   * kept when a name is duplicated. Unnamed instances are not included */
+  vtr::vector<ModuleId,
+              std::unordered_multimap<Symbol, std::pair<ModuleId, size_t>>>
+    instance_name_lookup_; /* [parent_module][instance_name] */
   /* fast look-up for ports */
   typedef vtr::vector<ModuleId, std::vector<std::vector<ModulePortId>>>
     PortLookup;
@@ -712,6 +769,14 @@ class ModuleManager {
    * terminals (either source or sink)
    */
   std::vector<std::pair<ModuleId, ModulePortId>> net_terminal_storage_;
+
+  /* Modules being built concurrently, see stage_modules() */
+  std::vector<ModuleId> staged_modules_;
+  vtr::vector<ModuleId, bool> is_staged_;
+  /* Net terminals of each staged module, which are merged into
+   * net_terminal_storage_ when the modules are committed */
+  vtr::vector<ModuleId, std::vector<std::pair<ModuleId, ModulePortId>>>
+    staged_net_terminals_;
 };
 
 } /* end namespace openfpga */
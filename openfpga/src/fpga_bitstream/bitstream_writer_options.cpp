@@ -27,6 +27,7 @@ BitstreamWriterOption::BitstreamWriterOption() {
   fast_config_ = false;
   keep_dont_care_bits_ = false;
   wl_decremental_order_ = false;
+  hex_ = false;
 }
 
 /**************************************************
@@ -74,6 +75,7 @@ bool BitstreamWriterOption::keep_dont_care_bits() const {
 bool BitstreamWriterOption::wl_decremental_order() const {
   return wl_decremental_order_;
 }
+bool BitstreamWriterOption::hex() const { return hex_; }
 
 /******************************************************************************
  * Private Mutators
@@ -123,6 +125,8 @@ void BitstreamWriterOption::set_wl_decremental_order(const bool& enabled) {
   wl_decremental_order_ = enabled;
 }
 
+void BitstreamWriterOption::set_hex(const bool& enabled) { hex_ = enabled; }
+
 bool BitstreamWriterOption::validate(bool show_err_msg) const {
   /* Check file type */
   if (!valid_file_type(file_type_)) {
@@ -149,6 +153,15 @@ bool BitstreamWriterOption::validate(bool show_err_msg) const {
       return false;
     }
   }
+  if (file_type_ == BitstreamWriterOption::e_bitfile_type::TEXT) {
+    /* Don't care bits 'x' cannot be represented by a hexadecimal digit */
+    if (hex_ && keep_dont_care_bits_) {
+      VTR_LOGV_ERROR(show_err_msg,
+                     "Don't care bits cannot be kept in a bitstream in "
+                     "hexadecimal format!\n");
+      return false;
+    }
+  }
   return true;
 }
 
@@ -42,6 +42,8 @@ class BitstreamWriterOption {
   bool fast_configuration() const;
   bool keep_dont_care_bits() const;
   bool wl_decremental_order() const;
+  /* Check if the bits should be outputted in hexadecimal format */
+  bool hex() const;
 
  public: /* Public mutators */
   void set_output_file_type(const std::string& val);
@@ -54,6 +56,7 @@ class BitstreamWriterOption {
   void set_fast_configuration(const bool& enabled);
   void set_keep_dont_care_bits(const bool& enabled);
   void set_wl_decremental_order(const bool& enabled);
+  void set_hex(const bool& enabled);
 
   void set_filter_value(const std::string& val);
 
@@ -93,6 +96,7 @@ class BitstreamWriterOption {
   bool fast_config_;
   bool keep_dont_care_bits_;
   bool wl_decremental_order_;
+  bool hex_;
 
   /* Constants */
   std::array<const char*, size_t(e_bitfile_type::NUM_TYPES)>
@@ -14,6 +14,7 @@
 #include "memory_utils.h"
 #include "module_manager_utils.h"
 #include "openfpga_naming.h"
+#include "openfpga_trace.h"
 #include "vtr_assert.h"
 #include "vtr_log.h"
 #include "vtr_time.h"
@@ -210,26 +211,36 @@ BitstreamManager build_device_bitstream(const VprContext& vpr_ctx,
 
   /* Create bitstream from grids */
   VTR_LOGV(verbose, "Building grid bitstream...\n");
-  build_grid_bitstream(
-    bitstream_manager, top_block, openfpga_ctx.module_graph(),
-    openfpga_ctx.module_name_map(), openfpga_ctx.fabric_tile(),
-    openfpga_ctx.arch().circuit_lib, openfpga_ctx.mux_lib(),
-    vpr_ctx.device().grid, 0, vpr_ctx.atom(),
-    openfpga_ctx.vpr_device_annotation(),
-    openfpga_ctx.vpr_clustering_annotation(),
-    openfpga_ctx.vpr_placement_annotation(),
-    openfpga_ctx.vpr_bitstream_annotation(), verbose);
+  {
+    OPENFPGA_TRACE_SCOPE("build_grid_bitstreams");
+    build_grid_bitstream(
+      bitstream_manager, top_block, openfpga_ctx.module_graph(),
+      openfpga_ctx.module_name_map(), openfpga_ctx.fabric_tile(),
+      openfpga_ctx.arch().circuit_lib, openfpga_ctx.mux_lib(),
+      vpr_ctx.device().grid, 0, vpr_ctx.atom(),
+      openfpga_ctx.vpr_device_annotation(),
+      openfpga_ctx.vpr_clustering_annotation(),
+      openfpga_ctx.vpr_placement_annotation(),
+      openfpga_ctx.vpr_bitstream_annotation(), verbose);
+  }
+  OPENFPGA_TRACE_COUNTER("num_config_bits", bitstream_manager.num_bits());
   VTR_LOGV(verbose, "Done\n");
 
   /* Create bitstream from routing architectures */
   VTR_LOGV(verbose, "Building routing bitstream...\n");
-  build_routing_bitstream(
-    bitstream_manager, top_block, openfpga_ctx.module_graph(),
-    openfpga_ctx.module_name_map(), openfpga_ctx.fabric_tile(),
-    openfpga_ctx.arch().circuit_lib, openfpga_ctx.mux_lib(), vpr_ctx.atom(),
-    openfpga_ctx.vpr_device_annotation(), openfpga_ctx.vpr_routing_annotation(),
-    vpr_ctx.device().rr_graph, openfpga_ctx.device_rr_gsb(),
-    openfpga_ctx.flow_manager().compress_routing(), verbose);
+  {
+    OPENFPGA_TRACE_SCOPE("build_routing_bitstreams");
+    build_routing_bitstream(
+      bitstream_manager, top_block, openfpga_ctx.module_graph(),
+      openfpga_ctx.module_name_map(), openfpga_ctx.fabric_tile(),
+      openfpga_ctx.arch().circuit_lib, openfpga_ctx.mux_lib(), vpr_ctx.atom(),
+      openfpga_ctx.vpr_device_annotation(),
+      openfpga_ctx.vpr_routing_annotation(), vpr_ctx.device().rr_graph,
+      openfpga_ctx.device_rr_gsb(),
+      openfpga_ctx.flow_manager().compress_routing(), verbose);
+  }
+  OPENFPGA_TRACE_COUNTER("num_config_bits", bitstream_manager.num_bits());
+  OPENFPGA_TRACE_COUNTER("num_config_blocks", bitstream_manager.num_blocks());
 
   VTR_LOGV(verbose, "Done\n");
 
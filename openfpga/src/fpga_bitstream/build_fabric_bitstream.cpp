@@ -814,6 +814,16 @@ FabricBitstream build_fabric_dependent_bitstream(
     config_protocol, circuit_lib, bitstream_manager, top_block, module_manager,
     top_module, fabric_bitstream, verbose);
 
+  /* Record the value of each bit, so that the fabric bitstream can be updated
+   * incrementally when the architecture bitstream is rebuilt */
+  for (const FabricBitId& fabric_bit : fabric_bitstream.bits()) {
+    fabric_bitstream.set_bit_value(
+      fabric_bit,
+      bitstream_manager.bit_value(fabric_bitstream.config_bit(fabric_bit)));
+  }
+  fabric_bitstream.set_arch_bitstream_digest(
+    bitstream_manager_structure_digest(bitstream_manager));
+
   VTR_LOGV(verbose, "Built %lu configuration bits for fabric\n",
            fabric_bitstream.num_bits());
 
@@ -14,6 +14,7 @@
 #include "build_grid_bitstream.h"
 #include "build_mux_bitstream.h"
 #include "circuit_library_utils.h"
+#include "grid_bitstream_template.h"
 #include "lut_utils.h"
 #include "module_manager_utils.h"
 #include "mux_bitstream_constants.h"
@@ -22,6 +23,7 @@
 #include "openfpga_interconnect_types.h"
 #include "openfpga_naming.h"
 #include "openfpga_reserved_words.h"
+#include "openfpga_trace.h"
 #include "pb_graph_utils.h"
 #include "pb_type_utils.h"
 #include "vpr_utils.h"
@@ -45,6 +47,27 @@ static std::vector<bool> generate_mode_select_bitstream(
   return mode_select_bitstream;
 }
 
+/********************************************************************
+ * Find the name of a memory block in bitstream. When the memory instances
+ * are grouped by a feedthrough module, the instances of the same block name
+ * are indexed by the scoreboard
+ *******************************************************************/
+static std::string find_grouped_mem_block_name(
+  std::map<std::string, size_t>& grouped_mem_inst_scoreboard,
+  const std::string& mem_block_name, const bool& use_mem_scoreboard) {
+  if (!use_mem_scoreboard) {
+    return mem_block_name;
+  }
+  auto result = grouped_mem_inst_scoreboard.find(mem_block_name);
+  if (result == grouped_mem_inst_scoreboard.end()) {
+    /* Update scoreboard */
+    grouped_mem_inst_scoreboard[mem_block_name] = 0;
+    return mem_block_name;
+  }
+  result->second++;
+  return generate_instance_name(mem_block_name, result->second);
+}
+
 /********************************************************************
  * Generate bitstream for a primitive node and add it to bitstream manager
  *******************************************************************/
@@ -52,34 +75,11 @@ static void build_primitive_bitstream(
   BitstreamManager& bitstream_manager,
   std::map<std::string, size_t>& grouped_mem_inst_scoreboard,
   const ConfigBlockId& parent_configurable_block,
-  const ModuleManager& module_manager, const CircuitLibrary& circuit_lib,
-  const VprDeviceAnnotation& device_annotation, const PhysicalPb& physical_pb,
-  const PhysicalPbId& primitive_pb_id, t_pb_type* primitive_pb_type,
+  const PbTypeBitstreamTemplate& pb_type_template,
+  const PhysicalPb& physical_pb, const PhysicalPbId& primitive_pb_id,
   const bool& verbose) {
-  /* Ensure a valid physical pritimive pb */
-  if (nullptr == primitive_pb_type) {
-    VTR_LOGF_ERROR(__FILE__, __LINE__, "Invalid primitive_pb_type!\n");
-    exit(1);
-  }
-
-  CircuitModelId primitive_model =
-    device_annotation.pb_type_circuit_model(primitive_pb_type);
-  VTR_ASSERT(CircuitModelId::INVALID() != primitive_model);
-  VTR_ASSERT(
-    (CIRCUIT_MODEL_IOPAD == circuit_lib.model_type(primitive_model)) ||
-    (CIRCUIT_MODEL_HARDLOGIC == circuit_lib.model_type(primitive_model)) ||
-    (CIRCUIT_MODEL_FF == circuit_lib.model_type(primitive_model)));
-
-  /* Find SRAM ports for mode-selection */
-  std::vector<CircuitPortId> primitive_mode_select_ports =
-    find_circuit_mode_select_sram_ports(circuit_lib, primitive_model);
-
-  /* We may have a port for mode select or not. */
-  VTR_ASSERT((0 == primitive_mode_select_ports.size()) ||
-             (1 == primitive_mode_select_ports.size()));
-
   /* Generate bitstream for mode-select ports */
-  if (0 == primitive_mode_select_ports.size()) {
+  if (false == pb_type_template.has_memory) {
     return; /* Nothing to do, return directly */
   }
 
@@ -113,43 +113,16 @@ static void build_primitive_bitstream(
           ('1' == fixed_mode_select_bitstream[bit_index]);
       }
     }
+    /* Ensure the length of bitstream matches the side of memory circuits */
+    VTR_ASSERT(mode_select_bitstream.size() ==
+               pb_type_template.default_bits.size());
   } else { /* get default mode_bits */
-    mode_select_bitstream = generate_mode_select_bitstream(
-      device_annotation.pb_type_mode_bits(primitive_pb_type));
+    mode_select_bitstream = pb_type_template.default_bits;
   }
 
-  /* Ensure the length of bitstream matches the side of memory circuits */
-  std::vector<CircuitModelId> sram_models =
-    find_circuit_sram_models(circuit_lib, primitive_model);
-  VTR_ASSERT(1 == sram_models.size());
-  std::string mem_block_name =
-    generate_memory_module_name(circuit_lib, primitive_model, sram_models[0],
-                                std::string(MEMORY_MODULE_POSTFIX));
-  ModuleId mem_module = module_manager.find_module(mem_block_name);
-  VTR_ASSERT(true == module_manager.valid_module_id(mem_module));
-  ModulePortId mem_out_port_id = module_manager.find_module_port(
-    mem_module, generate_configurable_memory_data_out_name());
-  VTR_ASSERT(
-    mode_select_bitstream.size() ==
-    module_manager.module_port(mem_module, mem_out_port_id).get_width());
-
-  /* If there is a feedthrough module, we should consider the scoreboard */
-  std::string feedthru_mem_block_name =
-    generate_memory_module_name(circuit_lib, primitive_model, sram_models[0],
-                                std::string(MEMORY_MODULE_POSTFIX), true);
-  ModuleId feedthru_mem_module =
-    module_manager.find_module(feedthru_mem_block_name);
-  if (module_manager.valid_module_id(feedthru_mem_module)) {
-    auto result = grouped_mem_inst_scoreboard.find(mem_block_name);
-    if (result == grouped_mem_inst_scoreboard.end()) {
-      /* Update scoreboard */
-      grouped_mem_inst_scoreboard[mem_block_name] = 0;
-    } else {
-      grouped_mem_inst_scoreboard[mem_block_name]++;
-      mem_block_name = generate_instance_name(
-        mem_block_name, grouped_mem_inst_scoreboard[mem_block_name]);
-    }
-  }
+  std::string mem_block_name = find_grouped_mem_block_name(
+    grouped_mem_inst_scoreboard, pb_type_template.mem_block_name,
+    pb_type_template.use_mem_scoreboard);
 
   /* Create a block for the bitstream which corresponds to the memory module
    * associated to the LUT */
@@ -180,195 +153,124 @@ static void build_physical_block_pin_interc_bitstream(
   BitstreamManager& bitstream_manager,
   std::map<std::string, size_t>& grouped_mem_inst_scoreboard,
   const ConfigBlockId& parent_configurable_block,
-  const ModuleManager& module_manager, const ModuleNameMap& module_name_map,
-  const CircuitLibrary& circuit_lib, const MuxLibrary& mux_lib,
-  const AtomContext& atom_ctx, const VprDeviceAnnotation& device_annotation,
-  const VprBitstreamAnnotation& bitstream_annotation,
+  GridBitstreamTemplate& grid_bitstream_template,
+  LogicalTileBitstreamTemplate& tile_template, const AtomContext& atom_ctx,
   const PhysicalPb& physical_pb, t_pb_graph_pin* des_pb_graph_pin,
   t_mode* physical_mode, const bool& verbose) {
-  /* Identify the number of fan-in (Consider interconnection edges of only
-   * selected mode) */
-  t_interconnect* cur_interc =
-    pb_graph_pin_interc(des_pb_graph_pin, physical_mode);
-  size_t fan_in = pb_graph_pin_inputs(des_pb_graph_pin, cur_interc).size();
-
-  if ((nullptr == cur_interc) || (0 == fan_in)) {
-    /* No interconnection matched */
+  /* The interconnect, the multiplexer and its memory block are all
+   * design-independent, which are resolved once per logical tile */
+  const PbPinBitstreamTemplate& pin_template =
+    grid_bitstream_template.pin_template(tile_template, des_pb_graph_pin,
+                                         physical_mode);
+
+  /* Only routing multiplexers require bitstream */
+  if (false == pin_template.is_mux) {
     return;
   }
+  const std::vector<t_pb_graph_pin*>& src_pb_graph_pins = pin_template.inputs;
+  size_t fan_in = src_pb_graph_pins.size();
+
+  /* Cache input and output nets */
+  std::vector<AtomNetId> input_nets;
+  AtomNetId output_net = AtomNetId::INVALID();
+
+  /* Find the path id:
+   * - if des pb is not valid, this is an unmapped pb, we can set a default
+   * path_id
+   * - There is no net mapped to des_pb_graph_pin we use default path id
+   * - There is a net mapped to des_pin_graph_pin: we find the path id
+   */
+  const PhysicalPbId& des_pb_id =
+    physical_pb.find_pb(des_pb_graph_pin->parent_node);
+  size_t mux_input_pin_id = 0;
+  if (true != physical_pb.valid_pb_id(des_pb_id)) {
+    mux_input_pin_id = DEFAULT_PATH_ID;
+  } else if (AtomNetId::INVALID() ==
+             physical_pb.pb_graph_pin_atom_net(des_pb_id, des_pb_graph_pin)) {
+    mux_input_pin_id = DEFAULT_PATH_ID;
+  } else {
+    output_net = physical_pb.pb_graph_pin_atom_net(des_pb_id, des_pb_graph_pin);
 
-  /* Identify pin interconnection type */
-  enum e_interconnect interc_type =
-    device_annotation.interconnect_physical_type(cur_interc);
-  switch (interc_type) {
-    case DIRECT_INTERC:
-      /* Nothing to do, return */
-      break;
-    case COMPLETE_INTERC:
-    case MUX_INTERC: {
-      /* Find the circuit model id of the mux, we need its design technology
-       * which matters the bitstream generation */
-      CircuitModelId mux_model =
-        device_annotation.interconnect_circuit_model(cur_interc);
-      VTR_ASSERT(CIRCUIT_MODEL_MUX == circuit_lib.model_type(mux_model));
-
-      /* Find the input size of the implementation of a routing multiplexer */
-      size_t datapath_mux_size = fan_in;
-      VTR_ASSERT(true ==
-                 valid_mux_implementation_num_inputs(datapath_mux_size));
-
-      /* Cache input and output nets */
-      std::vector<AtomNetId> input_nets;
-      AtomNetId output_net = AtomNetId::INVALID();
-
-      /* Find the path id:
-       * - if des pb is not valid, this is an unmapped pb, we can set a default
-       * path_id
-       * - There is no net mapped to des_pb_graph_pin we use default path id
-       * - There is a net mapped to des_pin_graph_pin: we find the path id
-       */
-      const PhysicalPbId& des_pb_id =
-        physical_pb.find_pb(des_pb_graph_pin->parent_node);
-      size_t mux_input_pin_id = 0;
-      if (true != physical_pb.valid_pb_id(des_pb_id)) {
-        mux_input_pin_id = DEFAULT_PATH_ID;
-      } else if (AtomNetId::INVALID() == physical_pb.pb_graph_pin_atom_net(
-                                           des_pb_id, des_pb_graph_pin)) {
-        mux_input_pin_id = DEFAULT_PATH_ID;
-      } else {
-        output_net =
-          physical_pb.pb_graph_pin_atom_net(des_pb_id, des_pb_graph_pin);
-
-        for (t_pb_graph_pin* src_pb_graph_pin :
-             pb_graph_pin_inputs(des_pb_graph_pin, cur_interc)) {
-          const PhysicalPbId& src_pb_id =
-            physical_pb.find_pb(src_pb_graph_pin->parent_node);
-          input_nets.push_back(
-            physical_pb.pb_graph_pin_atom_net(src_pb_id, src_pb_graph_pin));
-        }
+    for (t_pb_graph_pin* src_pb_graph_pin : src_pb_graph_pins) {
+      const PhysicalPbId& src_pb_id =
+        physical_pb.find_pb(src_pb_graph_pin->parent_node);
+      input_nets.push_back(
+        physical_pb.pb_graph_pin_atom_net(src_pb_id, src_pb_graph_pin));
+    }
 
-        for (t_pb_graph_pin* src_pb_graph_pin :
-             pb_graph_pin_inputs(des_pb_graph_pin, cur_interc)) {
-          const PhysicalPbId& src_pb_id =
-            physical_pb.find_pb(src_pb_graph_pin->parent_node);
-          /* If the src pb id is not valid, we bypass it */
-          if ((true == physical_pb.valid_pb_id(src_pb_id)) &&
-              (AtomNetId::INVALID() != output_net) &&
-              (physical_pb.pb_graph_pin_atom_net(src_pb_id, src_pb_graph_pin) ==
-               output_net)) {
-            break;
-          }
-          mux_input_pin_id++;
-        }
-        VTR_ASSERT(mux_input_pin_id <= fan_in);
-        /* Unmapped pin, use default path id */
-        if (fan_in == mux_input_pin_id) {
-          mux_input_pin_id = DEFAULT_PATH_ID;
-        }
+    for (t_pb_graph_pin* src_pb_graph_pin : src_pb_graph_pins) {
+      const PhysicalPbId& src_pb_id =
+        physical_pb.find_pb(src_pb_graph_pin->parent_node);
+      /* If the src pb id is not valid, we bypass it */
+      if ((true == physical_pb.valid_pb_id(src_pb_id)) &&
+          (AtomNetId::INVALID() != output_net) &&
+          (physical_pb.pb_graph_pin_atom_net(src_pb_id, src_pb_graph_pin) ==
+           output_net)) {
+        break;
       }
+      mux_input_pin_id++;
+    }
+    VTR_ASSERT(mux_input_pin_id <= fan_in);
+    /* Unmapped pin, use default path id */
+    if (fan_in == mux_input_pin_id) {
+      mux_input_pin_id = DEFAULT_PATH_ID;
+    }
+  }
 
-      /* Overwrite the default path if defined in bitstream annotation */
-      if ((size_t(DEFAULT_PATH_ID) == mux_input_pin_id) &&
-          (mux_input_pin_id !=
-           bitstream_annotation.interconnect_default_path_id(cur_interc))) {
-        mux_input_pin_id =
-          bitstream_annotation.interconnect_default_path_id(cur_interc);
-      }
+  /* Overwrite the default path if defined in bitstream annotation */
+  if ((size_t(DEFAULT_PATH_ID) == mux_input_pin_id) &&
+      (mux_input_pin_id != pin_template.default_path_id)) {
+    mux_input_pin_id = pin_template.default_path_id;
+  }
 
-      /* Generate bitstream depend on both technology and structure of this MUX
-       */
-      std::vector<bool> mux_bitstream = build_mux_bitstream(
-        circuit_lib, mux_model, mux_lib, datapath_mux_size, mux_input_pin_id);
-
-      /* Create the block denoting the memory instances that drives this node in
-       * physical_block */
-      std::string mem_block_name = generate_pb_memory_instance_name(
-        GRID_MEM_INSTANCE_PREFIX, des_pb_graph_pin, std::string(""));
-
-      /* Find the module in module manager and ensure the bitstream size
-       * matches! */
-      std::string mem_module_name =
-        generate_mux_subckt_name(circuit_lib, mux_model, datapath_mux_size,
-                                 std::string(MEMORY_MODULE_POSTFIX));
-      mem_module_name = module_name_map.name(mem_module_name);
-      ModuleId mux_mem_module = module_manager.find_module(mem_module_name);
-      VTR_ASSERT(true == module_manager.valid_module_id(mux_mem_module));
-      ModulePortId mux_mem_out_port_id = module_manager.find_module_port(
-        mux_mem_module, generate_configurable_memory_data_out_name());
-      VTR_ASSERT(mux_bitstream.size() ==
-                 module_manager.module_port(mux_mem_module, mux_mem_out_port_id)
-                   .get_width());
-
-      /* If there is a feedthrough module, we should consider the scoreboard */
-      std::string feedthru_mem_block_name = generate_mux_subckt_name(
-        circuit_lib, mux_model, datapath_mux_size,
-        std::string(MEMORY_FEEDTHROUGH_MODULE_POSTFIX));
-      if (module_name_map.name_exist(feedthru_mem_block_name)) {
-        feedthru_mem_block_name = module_name_map.name(feedthru_mem_block_name);
-      }
-      ModuleId feedthru_mem_module =
-        module_manager.find_module(feedthru_mem_block_name);
-      if (module_manager.valid_module_id(feedthru_mem_module)) {
-        auto result = grouped_mem_inst_scoreboard.find(mem_block_name);
-        if (result == grouped_mem_inst_scoreboard.end()) {
-          /* Update scoreboard */
-          grouped_mem_inst_scoreboard[mem_block_name] = 0;
-        } else {
-          grouped_mem_inst_scoreboard[mem_block_name]++;
-          mem_block_name = generate_instance_name(
-            mem_block_name, grouped_mem_inst_scoreboard[mem_block_name]);
-        }
-      }
-      ConfigBlockId mux_mem_block = bitstream_manager.add_block(mem_block_name);
-      bitstream_manager.add_child_block(parent_configurable_block,
-                                        mux_mem_block);
-
-      VTR_LOGV(verbose, "Added %lu bits to '%s' under '%s'\n",
-               mux_bitstream.size(),
-               bitstream_manager.block_name(mux_mem_block).c_str(),
-               bitstream_manager.block_name(parent_configurable_block).c_str());
-
-      /* Add the bistream to the bitstream manager */
-      bitstream_manager.add_block_bits(mux_mem_block, mux_bitstream);
-      /* Record path ids, input and output nets */
-      bitstream_manager.add_path_id_to_block(mux_mem_block, mux_input_pin_id);
-
-      /* Add input nets */
-      std::string input_net_ids;
-
-      bool need_splitter = false;
-      for (const AtomNetId& input_net : input_nets) {
-        /* Add a space as a splitter*/
-        if (true == need_splitter) {
-          input_net_ids += std::string(" ");
-        }
-        if (true == atom_ctx.nlist.valid_net_id(input_net)) {
-          input_net_ids += atom_ctx.nlist.net_name(input_net);
-        } else {
-          input_net_ids += std::string("unmapped");
-        }
-        need_splitter = true;
-      }
-      bitstream_manager.add_input_net_id_to_block(mux_mem_block, input_net_ids);
+  /* Bitstream depends on both technology and structure of this MUX, which
+   * have been decoded for every path in the template */
+  const std::vector<bool>& mux_bitstream = grid_bitstream_template.mux_bits(
+    pin_template.decode_table, mux_input_pin_id);
+
+  /* Create the block denoting the memory instances that drives this node in
+   * physical_block */
+  std::string mem_block_name = find_grouped_mem_block_name(
+    grouped_mem_inst_scoreboard, pin_template.mem_block_name,
+    pin_template.use_mem_scoreboard);
+  ConfigBlockId mux_mem_block = bitstream_manager.add_block(mem_block_name);
+  bitstream_manager.add_child_block(parent_configurable_block, mux_mem_block);
+
+  VTR_LOGV(verbose, "Added %lu bits to '%s' under '%s'\n", mux_bitstream.size(),
+           bitstream_manager.block_name(mux_mem_block).c_str(),
+           bitstream_manager.block_name(parent_configurable_block).c_str());
 
-      /* Add output nets */
-      std::string output_net_ids;
-      if (true == atom_ctx.nlist.valid_net_id(output_net)) {
-        output_net_ids += atom_ctx.nlist.net_name(output_net);
-      } else {
-        output_net_ids += std::string("unmapped");
-      }
-      bitstream_manager.add_output_net_id_to_block(mux_mem_block,
-                                                   output_net_ids);
+  /* Add the bistream to the bitstream manager */
+  bitstream_manager.add_block_bits(mux_mem_block, mux_bitstream);
+  /* Record path ids, input and output nets */
+  bitstream_manager.add_path_id_to_block(mux_mem_block, mux_input_pin_id);
 
-      break;
+  /* Add input nets */
+  std::string input_net_ids;
+
+  bool need_splitter = false;
+  for (const AtomNetId& input_net : input_nets) {
+    /* Add a space as a splitter*/
+    if (true == need_splitter) {
+      input_net_ids += std::string(" ");
     }
-    default:
-      VTR_LOGF_ERROR(__FILE__, __LINE__,
-                     "Invalid interconnection type for %s (Arch[LINE%d])!\n",
-                     cur_interc->name, cur_interc->line_num);
-      exit(1);
+    if (true == atom_ctx.nlist.valid_net_id(input_net)) {
+      input_net_ids += atom_ctx.nlist.net_name(input_net);
+    } else {
+      input_net_ids += std::string("unmapped");
+    }
+    need_splitter = true;
+  }
+  bitstream_manager.add_input_net_id_to_block(mux_mem_block, input_net_ids);
+
+  /* Add output nets */
+  std::string output_net_ids;
+  if (true == atom_ctx.nlist.valid_net_id(output_net)) {
+    output_net_ids += atom_ctx.nlist.net_name(output_net);
+  } else {
+    output_net_ids += std::string("unmapped");
   }
+  bitstream_manager.add_output_net_id_to_block(mux_mem_block, output_net_ids);
 }
 
 /********************************************************************
@@ -379,10 +281,8 @@ static void build_physical_block_interc_port_bitstream(
   BitstreamManager& bitstream_manager,
   std::map<std::string, size_t>& grouped_mem_inst_scoreboard,
   const ConfigBlockId& parent_configurable_block,
-  const ModuleManager& module_manager, const ModuleNameMap& module_name_map,
-  const CircuitLibrary& circuit_lib, const MuxLibrary& mux_lib,
-  const AtomContext& atom_ctx, const VprDeviceAnnotation& device_annotation,
-  const VprBitstreamAnnotation& bitstream_annotation,
+  GridBitstreamTemplate& grid_bitstream_template,
+  LogicalTileBitstreamTemplate& tile_template, const AtomContext& atom_ctx,
   t_pb_graph_node* physical_pb_graph_node, const PhysicalPb& physical_pb,
   const e_circuit_pb_port_type& pb_port_type, t_mode* physical_mode,
   const bool& verbose) {
@@ -394,9 +294,8 @@ static void build_physical_block_interc_port_bitstream(
              ++ipin) {
           build_physical_block_pin_interc_bitstream(
             bitstream_manager, grouped_mem_inst_scoreboard,
-            parent_configurable_block, module_manager, module_name_map,
-            circuit_lib, mux_lib, atom_ctx, device_annotation,
-            bitstream_annotation, physical_pb,
+            parent_configurable_block, grid_bitstream_template, tile_template,
+            atom_ctx, physical_pb,
             &(physical_pb_graph_node->input_pins[iport][ipin]), physical_mode,
             verbose);
         }
@@ -409,9 +308,8 @@ static void build_physical_block_interc_port_bitstream(
              ipin < physical_pb_graph_node->num_output_pins[iport]; ++ipin) {
           build_physical_block_pin_interc_bitstream(
             bitstream_manager, grouped_mem_inst_scoreboard,
-            parent_configurable_block, module_manager, module_name_map,
-            circuit_lib, mux_lib, atom_ctx, device_annotation,
-            bitstream_annotation, physical_pb,
+            parent_configurable_block, grid_bitstream_template, tile_template,
+            atom_ctx, physical_pb,
             &(physical_pb_graph_node->output_pins[iport][ipin]), physical_mode,
             verbose);
         }
@@ -424,9 +322,8 @@ static void build_physical_block_interc_port_bitstream(
              ++ipin) {
           build_physical_block_pin_interc_bitstream(
             bitstream_manager, grouped_mem_inst_scoreboard,
-            parent_configurable_block, module_manager, module_name_map,
-            circuit_lib, mux_lib, atom_ctx, device_annotation,
-            bitstream_annotation, physical_pb,
+            parent_configurable_block, grid_bitstream_template, tile_template,
+            atom_ctx, physical_pb,
             &(physical_pb_graph_node->clock_pins[iport][ipin]), physical_mode,
             verbose);
         }
@@ -446,10 +343,8 @@ static void build_physical_block_interc_bitstream(
   BitstreamManager& bitstream_manager,
   std::map<std::string, size_t>& grouped_mem_inst_scoreboard,
   const ConfigBlockId& parent_configurable_block,
-  const ModuleManager& module_manager, const ModuleNameMap& module_name_map,
-  const CircuitLibrary& circuit_lib, const MuxLibrary& mux_lib,
-  const AtomContext& atom_ctx, const VprDeviceAnnotation& device_annotation,
-  const VprBitstreamAnnotation& bitstream_annotation,
+  GridBitstreamTemplate& grid_bitstream_template,
+  LogicalTileBitstreamTemplate& tile_template, const AtomContext& atom_ctx,
   t_pb_graph_node* physical_pb_graph_node, const PhysicalPb& physical_pb,
   t_mode* physical_mode, const bool& verbose) {
   /* Check if the pb_graph node is valid or not */
@@ -470,8 +365,7 @@ static void build_physical_block_interc_bitstream(
    */
   build_physical_block_interc_port_bitstream(
     bitstream_manager, grouped_mem_inst_scoreboard, parent_configurable_block,
-    module_manager, module_name_map, circuit_lib, mux_lib, atom_ctx,
-    device_annotation, bitstream_annotation, physical_pb_graph_node,
+    grid_bitstream_template, tile_template, atom_ctx, physical_pb_graph_node,
     physical_pb, CIRCUIT_PB_PORT_OUTPUT, physical_mode, verbose);
 
   /* We check input_pins of child_pb_graph_node and its the input_edges
@@ -493,17 +387,15 @@ static void build_physical_block_interc_bitstream(
       /* For each child_pb_graph_node input pins*/
       build_physical_block_interc_port_bitstream(
         bitstream_manager, grouped_mem_inst_scoreboard,
-        parent_configurable_block, module_manager, module_name_map, circuit_lib,
-        mux_lib, atom_ctx, device_annotation, bitstream_annotation,
-        child_pb_graph_node, physical_pb, CIRCUIT_PB_PORT_INPUT, physical_mode,
-        verbose);
+        parent_configurable_block, grid_bitstream_template, tile_template,
+        atom_ctx, child_pb_graph_node, physical_pb, CIRCUIT_PB_PORT_INPUT,
+        physical_mode, verbose);
       /* For clock pins, we should do the same work */
       build_physical_block_interc_port_bitstream(
         bitstream_manager, grouped_mem_inst_scoreboard,
-        parent_configurable_block, module_manager, module_name_map, circuit_lib,
-        mux_lib, atom_ctx, device_annotation, bitstream_annotation,
-        child_pb_graph_node, physical_pb, CIRCUIT_PB_PORT_CLOCK, physical_mode,
-        verbose);
+        parent_configurable_block, grid_bitstream_template, tile_template,
+        atom_ctx, child_pb_graph_node, physical_pb, CIRCUIT_PB_PORT_CLOCK,
+        physical_mode, verbose);
     }
   }
 }
@@ -515,70 +407,26 @@ static void build_physical_block_interc_bitstream(
 static void build_lut_bitstream(
   BitstreamManager& bitstream_manager,
   std::map<std::string, size_t>& grouped_mem_inst_scoreboard,
-  const ConfigBlockId& parent_configurable_block,
-  const VprDeviceAnnotation& device_annotation,
-  const ModuleManager& module_manager, const CircuitLibrary& circuit_lib,
-  const MuxLibrary& mux_lib, const PhysicalPb& physical_pb,
-  const PhysicalPbId& lut_pb_id, t_pb_type* lut_pb_type, const bool& verbose) {
-  /* Ensure a valid physical pritimive pb */
-  if (nullptr == lut_pb_type) {
-    VTR_LOGF_ERROR(__FILE__, __LINE__, "Invalid lut_pb_type!\n");
-    exit(1);
-  }
-
-  CircuitModelId lut_model =
-    device_annotation.pb_type_circuit_model(lut_pb_type);
-  VTR_ASSERT(CircuitModelId::INVALID() != lut_model);
-  VTR_ASSERT(CIRCUIT_MODEL_LUT == circuit_lib.model_type(lut_model));
-
-  /* Find the input ports for LUT size, this is used to decode the LUT memory
-   * bits! */
-  std::vector<CircuitPortId> model_input_ports =
-    find_lut_circuit_model_input_port(circuit_lib, lut_model, false);
-  VTR_ASSERT(1 == model_input_ports.size());
-  size_t lut_size = circuit_lib.port_size(model_input_ports[0]);
-
-  /* Find SRAM ports for truth tables and mode-selection */
-  std::vector<CircuitPortId> lut_regular_sram_ports =
-    find_circuit_regular_sram_ports(circuit_lib, lut_model);
-  std::vector<CircuitPortId> lut_mode_select_ports =
-    find_circuit_mode_select_sram_ports(circuit_lib, lut_model);
-  /* We should always 1 regular sram port, where truth table is loaded to */
-  VTR_ASSERT(1 == lut_regular_sram_ports.size());
-  /* We may have a port for mode select or not. This depends on if the LUT is
-   * fracturable or not */
-  VTR_ASSERT((0 == lut_mode_select_ports.size()) ||
-             (1 == lut_mode_select_ports.size()));
-
+  const ConfigBlockId& parent_configurable_block, const MuxLibrary& mux_lib,
+  const PbTypeBitstreamTemplate& pb_type_template,
+  const PhysicalPb& physical_pb, const PhysicalPbId& lut_pb_id,
+  const bool& verbose) {
   std::vector<bool> lut_bitstream;
   /* Generate bitstream for the LUT */
   if (false == physical_pb.valid_pb_id(lut_pb_id)) {
     /* An empty pb means that this is an unused LUT,
      * we give an empty truth table, which are full of default values (defined
-     * by users)
+     * by users), as well as the default mode bits
      */
-    for (size_t i = 0; i < circuit_lib.port_size(lut_regular_sram_ports[0]);
-         ++i) {
-      VTR_ASSERT(
-        (0 == circuit_lib.port_default_value(lut_regular_sram_ports[0])) ||
-        (1 == circuit_lib.port_default_value(lut_regular_sram_ports[0])));
-      lut_bitstream.push_back(
-        1 == circuit_lib.port_default_value(lut_regular_sram_ports[0]));
-    }
+    lut_bitstream = pb_type_template.default_bits;
   } else {
     VTR_ASSERT(true == physical_pb.valid_pb_id(lut_pb_id));
 
-    /* Find MUX graph correlated to the LUT */
-    MuxId lut_mux_id = mux_lib.mux_graph(lut_model, (size_t)pow(2., lut_size));
-    const MuxGraph& mux_graph = mux_lib.mux_graph(lut_mux_id);
-    /* Ensure the LUT MUX has the expected input and SRAM port sizes */
-    VTR_ASSERT(mux_graph.num_memory_bits() == lut_size);
-    VTR_ASSERT(mux_graph.num_inputs() == (size_t)pow(2., lut_size));
     /* Generate LUT bitstream */
     lut_bitstream = build_frac_lut_bitstream(
-      circuit_lib, mux_graph, device_annotation,
-      physical_pb.truth_tables(lut_pb_id),
-      circuit_lib.port_default_value(lut_regular_sram_ports[0]));
+      mux_lib.mux_graph(pb_type_template.lut_mux),
+      pb_type_template.lut_output_bit_ranges,
+      physical_pb.truth_tables(lut_pb_id), pb_type_template.lut_default_value);
     /* If the physical pb contains fixed bitstream, overload here */
     if (false == physical_pb.fixed_bitstream(lut_pb_id).empty()) {
       std::string fixed_bitstream = physical_pb.fixed_bitstream(lut_pb_id);
@@ -600,13 +448,10 @@ static void build_lut_bitstream(
           ('1' == fixed_bitstream[bit_index]);
       }
     }
-  }
 
-  /* Generate bitstream for mode-select ports */
-  if (0 != lut_mode_select_ports.size()) {
-    std::vector<bool> mode_select_bitstream;
-    if (true == physical_pb.valid_pb_id(lut_pb_id)) {
-      mode_select_bitstream =
+    /* Generate bitstream for mode-select ports */
+    if (true == pb_type_template.has_mode_select) {
+      std::vector<bool> mode_select_bitstream =
         generate_mode_select_bitstream(physical_pb.mode_bits(lut_pb_id));
 
       /* If the physical pb contains fixed mode-select bitstream, overload here
@@ -635,48 +480,19 @@ static void build_lut_bitstream(
             ('1' == fixed_mode_select_bitstream[bit_index]);
         }
       }
-    } else { /* get default mode_bits */
-      mode_select_bitstream = generate_mode_select_bitstream(
-        device_annotation.pb_type_mode_bits(lut_pb_type));
-    }
 
-    /* Conjunct the mode-select bitstream to the lut bitstream */
-    for (const bool& bit : mode_select_bitstream) {
-      lut_bitstream.push_back(bit);
+      /* Conjunct the mode-select bitstream to the lut bitstream */
+      for (const bool& bit : mode_select_bitstream) {
+        lut_bitstream.push_back(bit);
+      }
     }
+    /* Ensure the length of bitstream matches the side of memory circuits */
+    VTR_ASSERT(lut_bitstream.size() == pb_type_template.default_bits.size());
   }
 
-  /* Ensure the length of bitstream matches the side of memory circuits */
-  std::vector<CircuitModelId> sram_models =
-    find_circuit_sram_models(circuit_lib, lut_model);
-  VTR_ASSERT(1 == sram_models.size());
-  std::string mem_block_name = generate_memory_module_name(
-    circuit_lib, lut_model, sram_models[0], std::string(MEMORY_MODULE_POSTFIX));
-  ModuleId mem_module = module_manager.find_module(mem_block_name);
-  VTR_ASSERT(true == module_manager.valid_module_id(mem_module));
-  ModulePortId mem_out_port_id = module_manager.find_module_port(
-    mem_module, generate_configurable_memory_data_out_name());
-  VTR_ASSERT(
-    lut_bitstream.size() ==
-    module_manager.module_port(mem_module, mem_out_port_id).get_width());
-
-  /* If there is a feedthrough module, we should consider the scoreboard */
-  std::string feedthru_mem_block_name =
-    generate_memory_module_name(circuit_lib, lut_model, sram_models[0],
-                                std::string(MEMORY_MODULE_POSTFIX), true);
-  ModuleId feedthru_mem_module =
-    module_manager.find_module(feedthru_mem_block_name);
-  if (module_manager.valid_module_id(feedthru_mem_module)) {
-    auto result = grouped_mem_inst_scoreboard.find(mem_block_name);
-    if (result == grouped_mem_inst_scoreboard.end()) {
-      /* Update scoreboard */
-      grouped_mem_inst_scoreboard[mem_block_name] = 0;
-    } else {
-      grouped_mem_inst_scoreboard[mem_block_name]++;
-      mem_block_name = generate_instance_name(
-        mem_block_name, grouped_mem_inst_scoreboard[mem_block_name]);
-    }
-  }
+  std::string mem_block_name = find_grouped_mem_block_name(
+    grouped_mem_inst_scoreboard, pb_type_template.mem_block_name,
+    pb_type_template.use_mem_scoreboard);
 
   /* Create a block for the bitstream which corresponds to the memory module
    * associated to the LUT */
@@ -705,30 +521,24 @@ static void build_lut_bitstream(
 static void rec_build_physical_block_bitstream(
   BitstreamManager& bitstream_manager,
   std::map<std::string, size_t>& grouped_mem_inst_scoreboard,
-  const ConfigBlockId& parent_configurable_block,
-  const ModuleManager& module_manager, const ModuleNameMap& module_name_map,
-  const CircuitLibrary& circuit_lib, const MuxLibrary& mux_lib,
-  const AtomContext& atom_ctx, const VprDeviceAnnotation& device_annotation,
-  const VprBitstreamAnnotation& bitstream_annotation, const e_side& border_side,
-  const PhysicalPb& physical_pb, const PhysicalPbId& pb_id,
-  t_pb_graph_node* physical_pb_graph_node, const size_t& pb_graph_node_index,
-  const bool& verbose) {
+  const ConfigBlockId& parent_configurable_block, const MuxLibrary& mux_lib,
+  const AtomContext& atom_ctx, GridBitstreamTemplate& grid_bitstream_template,
+  LogicalTileBitstreamTemplate& tile_template, const PhysicalPb& physical_pb,
+  const PhysicalPbId& pb_id, t_pb_graph_node* physical_pb_graph_node,
+  const size_t& pb_graph_node_index, const bool& verbose) {
   /* Get the physical pb_type that is linked to the pb_graph node */
   t_pb_type* physical_pb_type = physical_pb_graph_node->pb_type;
 
-  /* Find the mode that define_idle_mode*/
-  t_mode* physical_mode = device_annotation.physical_mode(physical_pb_type);
+  /* The module of the pb_type, its physical mode and its memory blocks are
+   * resolved only once for all the grids */
+  const PbTypeBitstreamTemplate& pb_type_template =
+    grid_bitstream_template.pb_type_template(physical_pb_type);
 
-  /* Early exit if this parent module has no configurable child modules */
-  std::string pb_module_name =
-    generate_physical_block_module_name(physical_pb_type);
-  pb_module_name = module_name_map.name(pb_module_name);
-  ModuleId pb_module = module_manager.find_module(pb_module_name);
-  VTR_ASSERT(true == module_manager.valid_module_id(pb_module));
+  /* Find the mode that define_idle_mode*/
+  t_mode* physical_mode = pb_type_template.physical_mode;
 
   /* Skip module with no configurable children */
-  if (0 == module_manager.num_configurable_children(
-             pb_module, ModuleManager::e_config_child_type::LOGICAL)) {
+  if (false == pb_type_template.is_configurable) {
     return;
   }
 
@@ -739,17 +549,13 @@ static void rec_build_physical_block_bitstream(
   /* If there are no physical memory blocks under the current module, use the
    * previous module, which is the physical memory block */
   ConfigBlockId pb_configurable_block = parent_configurable_block;
-  if (0 < module_manager.num_configurable_children(
-            pb_module, ModuleManager::e_config_child_type::PHYSICAL)) {
+  if (true == pb_type_template.has_physical_memory) {
     pb_configurable_block = bitstream_manager.add_block(pb_block_name);
     bitstream_manager.add_child_block(parent_configurable_block,
                                       pb_configurable_block);
     /* Reserve child blocks for new created block */
     bitstream_manager.reserve_child_blocks(
-      parent_configurable_block,
-      count_module_manager_module_configurable_children(
-        module_manager, pb_module,
-        ModuleManager::e_config_child_type::PHYSICAL));
+      parent_configurable_block, pb_type_template.num_physical_children);
   }
 
   /* Recursively finish all the child pb_types*/
@@ -768,9 +574,8 @@ static void rec_build_physical_block_bitstream(
         /* Go recursively */
         rec_build_physical_block_bitstream(
           bitstream_manager, grouped_mem_inst_scoreboard, pb_configurable_block,
-          module_manager, module_name_map, circuit_lib, mux_lib, atom_ctx,
-          device_annotation, bitstream_annotation, border_side, physical_pb,
-          child_pb,
+          mux_lib, atom_ctx, grid_bitstream_template, tile_template,
+          physical_pb, child_pb,
           &(physical_pb_graph_node
               ->child_pb_graph_nodes[physical_mode->index][ipb][jpb]),
           jpb, verbose);
@@ -780,33 +585,18 @@ static void rec_build_physical_block_bitstream(
 
   /* Check if this has defined a circuit_model*/
   if (true == is_primitive_pb_type(physical_pb_type)) {
-    CircuitModelId primitive_circuit_model =
-      device_annotation.pb_type_circuit_model(physical_pb_type);
-    VTR_ASSERT(CircuitModelId::INVALID() != primitive_circuit_model);
-    switch (circuit_lib.model_type(primitive_circuit_model)) {
-      case CIRCUIT_MODEL_LUT:
-        /* Special case for LUT !!!
-         * Mapped logical block information is stored in child_pbs of this pb!!!
-         */
-        build_lut_bitstream(bitstream_manager, grouped_mem_inst_scoreboard,
-                            pb_configurable_block, device_annotation,
-                            module_manager, circuit_lib, mux_lib, physical_pb,
-                            pb_id, physical_pb_type, verbose);
-        break;
-      case CIRCUIT_MODEL_FF:
-      case CIRCUIT_MODEL_HARDLOGIC:
-      case CIRCUIT_MODEL_IOPAD:
-        /* For other types of blocks, we can apply a generic therapy */
-        build_primitive_bitstream(
-          bitstream_manager, grouped_mem_inst_scoreboard, pb_configurable_block,
-          module_manager, circuit_lib, device_annotation, physical_pb, pb_id,
-          physical_pb_type, verbose);
-        break;
-      default:
-        VTR_LOGF_ERROR(__FILE__, __LINE__,
-                       "Unknown circuit model type of pb_type '%s'!\n",
-                       physical_pb_type->name);
-        exit(1);
+    if (MuxId::INVALID() != pb_type_template.lut_mux) {
+      /* Special case for LUT !!!
+       * Mapped logical block information is stored in child_pbs of this pb!!!
+       */
+      build_lut_bitstream(bitstream_manager, grouped_mem_inst_scoreboard,
+                          pb_configurable_block, mux_lib, pb_type_template,
+                          physical_pb, pb_id, verbose);
+    } else {
+      /* For other types of blocks, we can apply a generic therapy */
+      build_primitive_bitstream(bitstream_manager, grouped_mem_inst_scoreboard,
+                                pb_configurable_block, pb_type_template,
+                                physical_pb, pb_id, verbose);
     }
     /* Finish for primitive node, return */
     return;
@@ -815,8 +605,7 @@ static void rec_build_physical_block_bitstream(
   /* Generate the bitstream for the interconnection in this physical block */
   build_physical_block_interc_bitstream(
     bitstream_manager, grouped_mem_inst_scoreboard, pb_configurable_block,
-    module_manager, module_name_map, circuit_lib, mux_lib, atom_ctx,
-    device_annotation, bitstream_annotation, physical_pb_graph_node,
+    grid_bitstream_template, tile_template, atom_ctx, physical_pb_graph_node,
     physical_pb, physical_mode, verbose);
 }
 
@@ -830,11 +619,11 @@ static void build_physical_block_bitstream(
   BitstreamManager& bitstream_manager, const ConfigBlockId& top_block,
   const ModuleManager& module_manager, const ModuleNameMap& module_name_map,
   const FabricTile& fabric_tile, const FabricTileId& curr_tile,
-  const CircuitLibrary& circuit_lib, const MuxLibrary& mux_lib,
-  const AtomContext& atom_ctx, const VprDeviceAnnotation& device_annotation,
+  const MuxLibrary& mux_lib, const AtomContext& atom_ctx,
+  const VprDeviceAnnotation& device_annotation,
   const VprClusteringAnnotation& cluster_annotation,
   const VprPlacementAnnotation& place_annotation,
-  const VprBitstreamAnnotation& bitstream_annotation, const DeviceGrid& grids,
+  GridBitstreamTemplate& grid_bitstream_template, const DeviceGrid& grids,
   const size_t& layer, const vtr::Point<size_t>& grid_coord,
   const e_side& border_side, const bool& verbose) {
   /* Create a block for the grid in bitstream manager */
@@ -866,6 +655,10 @@ static void build_physical_block_bitstream(
   std::string grid_block_name = generate_grid_block_instance_name(
     grid_module_name_prefix, std::string(grid_type->name),
     is_io_type(grid_type), border_side, grid_coord_in_unique_tile);
+  OPENFPGA_TRACE_SCOPE_DETAIL(
+    "build_grid_bitstream",
+    grid_block_name + " (" + std::to_string(grid_coord.x()) + "," +
+      std::to_string(grid_coord.y()) + ")");
 
   ConfigBlockId grid_configurable_block =
     bitstream_manager.add_block(grid_block_name);
@@ -923,14 +716,17 @@ static void build_physical_block_bitstream(
         continue;
       }
 
+      /* All the grids of the same logical tile share a template */
+      LogicalTileBitstreamTemplate& tile_template =
+        grid_bitstream_template.logical_tile_template(lb_type->pb_graph_head);
+
       if (ClusterBlockId::INVALID() ==
           place_annotation.grid_blocks(grid_coord)[z]) {
         /* Recursively traverse the pb_graph and generate bitstream */
         rec_build_physical_block_bitstream(
           bitstream_manager, grouped_mem_inst_scoreboard,
-          grid_configurable_block, module_manager, module_name_map, circuit_lib,
-          mux_lib, atom_ctx, device_annotation, bitstream_annotation,
-          border_side, PhysicalPb(), PhysicalPbId::INVALID(),
+          grid_configurable_block, mux_lib, atom_ctx, grid_bitstream_template,
+          tile_template, PhysicalPb(), PhysicalPbId::INVALID(),
           lb_type->pb_graph_head, z, verbose);
       } else {
         const PhysicalPb& phy_pb = cluster_annotation.physical_pb(
@@ -944,21 +740,21 @@ static void build_physical_block_bitstream(
         /* Recursively traverse the pb_graph and generate bitstream */
         rec_build_physical_block_bitstream(
           bitstream_manager, grouped_mem_inst_scoreboard,
-          grid_configurable_block, module_manager, module_name_map, circuit_lib,
-          mux_lib, atom_ctx, device_annotation, bitstream_annotation,
-          border_side, phy_pb, top_pb_id, pb_graph_head, z, verbose);
+          grid_configurable_block, mux_lib, atom_ctx, grid_bitstream_template,
+          tile_template, phy_pb, top_pb_id, pb_graph_head, z, verbose);
       }
     }
   }
 }
 
 /********************************************************************
- * Top-level function of this file:
- * Generate bitstreams for all the grids, including
+ * Generate bitstreams for the grids, including
  * 1. core grids that sit in the center of the fabric
  * 2. side grids (I/O grids) that sit in the borders for the fabric
+ * Only the grids at the given coordinates are considered, unless all the
+ * grids are required
  *******************************************************************/
-void build_grid_bitstream(
+static void build_grid_bitstream_on_coordinates(
   BitstreamManager& bitstream_manager, const ConfigBlockId& top_block,
   const ModuleManager& module_manager, const ModuleNameMap& module_name_map,
   const FabricTile& fabric_tile, const CircuitLibrary& circuit_lib,
@@ -966,7 +762,15 @@ void build_grid_bitstream(
   const AtomContext& atom_ctx, const VprDeviceAnnotation& device_annotation,
   const VprClusteringAnnotation& cluster_annotation,
   const VprPlacementAnnotation& place_annotation,
-  const VprBitstreamAnnotation& bitstream_annotation, const bool& verbose) {
+  const VprBitstreamAnnotation& bitstream_annotation,
+  const std::set<vtr::Point<size_t>>& grid_coords, const bool& all_grids,
+  const bool& verbose) {
+  /* Design-independent data are shared by all the grids of the same logical
+   * tile, which are built on demand */
+  GridBitstreamTemplate grid_bitstream_template(
+    module_manager, module_name_map, circuit_lib, mux_lib, device_annotation,
+    bitstream_annotation);
+
   VTR_LOGV(verbose, "Generating bitstream for core grids...");
 
   /* Generate bitstream for the core logic block one by one */
@@ -984,6 +788,9 @@ void build_grid_bitstream(
       }
       /* Add a grid module to top_module*/
       vtr::Point<size_t> grid_coord(ix, iy);
+      if (!all_grids && 0 == grid_coords.count(grid_coord)) {
+        continue;
+      }
       /* TODO: If the fabric tile is not empty, find the tile module and create
        * the block accordingly. Also to support future hierarchy changes, when
        * creating the blocks, trace backward until reach the current top block.
@@ -1005,9 +812,9 @@ void build_grid_bitstream(
 
       build_physical_block_bitstream(
         bitstream_manager, parent_block, module_manager, module_name_map,
-        fabric_tile, curr_tile, circuit_lib, mux_lib, atom_ctx,
-        device_annotation, cluster_annotation, place_annotation,
-        bitstream_annotation, grids, layer, grid_coord, NUM_2D_SIDES, verbose);
+        fabric_tile, curr_tile, mux_lib, atom_ctx, device_annotation,
+        cluster_annotation, place_annotation, grid_bitstream_template, grids,
+        layer, grid_coord, NUM_2D_SIDES, verbose);
     }
   }
   VTR_LOGV(verbose, "Done\n");
@@ -1032,6 +839,9 @@ void build_grid_bitstream(
           (0 < grids.get_height_offset(phy_tile_loc))) {
         continue;
       }
+      if (!all_grids && 0 == grid_coords.count(io_coordinate)) {
+        continue;
+      }
       /* TODO: If the fabric tile is not empty, find the tile module and create
        * the block accordingly. Also to support future hierarchy changes, when
        * creating the blocks, trace backward until reach the current top block.
@@ -1053,12 +863,59 @@ void build_grid_bitstream(
 
       build_physical_block_bitstream(
         bitstream_manager, parent_block, module_manager, module_name_map,
-        fabric_tile, curr_tile, circuit_lib, mux_lib, atom_ctx,
-        device_annotation, cluster_annotation, place_annotation,
-        bitstream_annotation, grids, layer, io_coordinate, io_side, verbose);
+        fabric_tile, curr_tile, mux_lib, atom_ctx, device_annotation,
+        cluster_annotation, place_annotation, grid_bitstream_template, grids,
+        layer, io_coordinate, io_side, verbose);
     }
   }
   VTR_LOGV(verbose, "Done\n");
+
+  VTR_LOGV(verbose,
+           "Built bitstream templates for %lu pb_types and %lu multiplexer "
+           "decode tables\n",
+           grid_bitstream_template.num_pb_type_templates(),
+           grid_bitstream_template.num_decode_tables());
+}
+
+/********************************************************************
+ * Top-level function of this file:
+ * Generate bitstreams for all the grids
+ *******************************************************************/
+void build_grid_bitstream(
+  BitstreamManager& bitstream_manager, const ConfigBlockId& top_block,
+  const ModuleManager& module_manager, const ModuleNameMap& module_name_map,
+  const FabricTile& fabric_tile, const CircuitLibrary& circuit_lib,
+  const MuxLibrary& mux_lib, const DeviceGrid& grids, const size_t& layer,
+  const AtomContext& atom_ctx, const VprDeviceAnnotation& device_annotation,
+  const VprClusteringAnnotation& cluster_annotation,
+  const VprPlacementAnnotation& place_annotation,
+  const VprBitstreamAnnotation& bitstream_annotation, const bool& verbose) {
+  build_grid_bitstream_on_coordinates(
+    bitstream_manager, top_block, module_manager, module_name_map, fabric_tile,
+    circuit_lib, mux_lib, grids, layer, atom_ctx, device_annotation,
+    cluster_annotation, place_annotation, bitstream_annotation,
+    std::set<vtr::Point<size_t>>(), true, verbose);
+}
+
+/********************************************************************
+ * Generate bitstreams only for the grids at the given coordinates, which
+ * is used to rebuild the grids changed by a new implementation
+ *******************************************************************/
+void build_grid_bitstream(
+  BitstreamManager& bitstream_manager, const ConfigBlockId& top_block,
+  const ModuleManager& module_manager, const ModuleNameMap& module_name_map,
+  const FabricTile& fabric_tile, const CircuitLibrary& circuit_lib,
+  const MuxLibrary& mux_lib, const DeviceGrid& grids, const size_t& layer,
+  const AtomContext& atom_ctx, const VprDeviceAnnotation& device_annotation,
+  const VprClusteringAnnotation& cluster_annotation,
+  const VprPlacementAnnotation& place_annotation,
+  const VprBitstreamAnnotation& bitstream_annotation,
+  const std::set<vtr::Point<size_t>>& grid_coords, const bool& verbose) {
+  build_grid_bitstream_on_coordinates(
+    bitstream_manager, top_block, module_manager, module_name_map, fabric_tile,
+    circuit_lib, mux_lib, grids, layer, atom_ctx, device_annotation,
+    cluster_annotation, place_annotation, bitstream_annotation, grid_coords,
+    false, verbose);
 }
 
 } /* end namespace openfpga */
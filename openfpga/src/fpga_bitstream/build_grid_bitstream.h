@@ -4,6 +4,7 @@
 /********************************************************************
  * Include header files that are required by function declaration
  *******************************************************************/
+#include <set>
 #include <vector>
 
 #include "bitstream_manager.h"
@@ -36,6 +37,17 @@ void build_grid_bitstream(
   const VprPlacementAnnotation& place_annotation,
   const VprBitstreamAnnotation& bitstream_annotation, const bool& verbose);
 
+void build_grid_bitstream(
+  BitstreamManager& bitstream_manager, const ConfigBlockId& top_block,
+  const ModuleManager& module_manager, const ModuleNameMap& module_name_map,
+  const FabricTile& fabric_tile, const CircuitLibrary& circuit_lib,
+  const MuxLibrary& mux_lib, const DeviceGrid& grids, const size_t& layer,
+  const AtomContext& atom_ctx, const VprDeviceAnnotation& device_annotation,
+  const VprClusteringAnnotation& cluster_annotation,
+  const VprPlacementAnnotation& place_annotation,
+  const VprBitstreamAnnotation& bitstream_annotation,
+  const std::set<vtr::Point<size_t>>& grid_coords, const bool& verbose);
+
 } /* end namespace openfpga */
 
 #endif
@@ -4,6 +4,7 @@
  * We decode the bitstream from configuration of routing multiplexers
  * which locate in global routing architecture
  *******************************************************************/
+#include <set>
 #include <vector>
 
 /* Headers from vtrutil library */
@@ -20,6 +21,7 @@
 #include "openfpga_reserved_words.h"
 #include "openfpga_rr_graph_utils.h"
 #include "openfpga_side_manager.h"
+#include "openfpga_trace.h"
 #include "rr_gsb_utils.h"
 
 /* begin namespace openfpga */
@@ -222,6 +224,9 @@ static void build_switch_block_bitstream(
   const AtomContext& atom_ctx, const VprDeviceAnnotation& device_annotation,
   const VprRoutingAnnotation& routing_annotation, const RRGraphView& rr_graph,
   const RRGSB& rr_gsb, const bool& verbose) {
+  OPENFPGA_TRACE_SCOPE_DETAIL(
+    "build_sb_bitstream",
+    bitstream_manager.block_name(sb_config_block));
   /* Iterate over all the multiplexers */
   for (size_t side = 0; side < rr_gsb.get_num_sides(); ++side) {
     SideManager side_manager(side);
@@ -409,7 +414,7 @@ static void build_connection_block_interc_bitstream(
     bitstream_manager.add_child_block(cb_configurable_block, mux_mem_block);
     VTR_LOGV(verbose, "Added '%s' under '%s'\n",
              bitstream_manager.block_name(mux_mem_block).c_str(),
-             bitstream_manager.block_name(cb_configurable_block).c_str());
+             bitstream_manager.block_name(cb_configurable_block));
     /* This is a routing multiplexer! Generate bitstream */
     build_connection_block_mux_bitstream(
       bitstream_manager, mux_mem_block, module_manager, module_name_map,
@@ -437,6 +442,9 @@ static void build_connection_block_bitstream(
   const AtomContext& atom_ctx, const VprDeviceAnnotation& device_annotation,
   const VprRoutingAnnotation& routing_annotation, const RRGraphView& rr_graph,
   const RRGSB& rr_gsb, const t_rr_type& cb_type, const bool& verbose) {
+  OPENFPGA_TRACE_SCOPE_DETAIL(
+    "build_cb_bitstream",
+    bitstream_manager.block_name(cb_configurable_block));
   /* Find routing multiplexers on the sides of a Connection block where IPIN
    * nodes locate */
   std::vector<enum e_side> cb_sides = rr_gsb.get_cb_ipin_sides(cb_type);
@@ -468,11 +476,15 @@ static void build_connection_block_bitstreams(
   const VprDeviceAnnotation& device_annotation,
   const VprRoutingAnnotation& routing_annotation, const RRGraphView& rr_graph,
   const DeviceRRGSB& device_rr_gsb, const bool& compact_routing_hierarchy,
-  const t_rr_type& cb_type, const bool& verbose) {
+  const t_rr_type& cb_type, const std::set<vtr::Point<size_t>>& gsb_coords,
+  const bool& all_gsbs, const bool& verbose) {
   vtr::Point<size_t> cb_range = device_rr_gsb.get_gsb_range();
 
   for (size_t ix = 0; ix < cb_range.x(); ++ix) {
     for (size_t iy = 0; iy < cb_range.y(); ++iy) {
+      if (!all_gsbs && 0 == gsb_coords.count(vtr::Point<size_t>(ix, iy))) {
+        continue;
+      }
       const RRGSB& rr_gsb = device_rr_gsb.get_gsb(ix, iy);
       /* Check if the connection block exists in the device!
        * Some of them do NOT exist due to heterogeneous blocks (height > 1)
@@ -585,7 +597,7 @@ static void build_connection_block_bitstreams(
                                           cb_grouped_config_block);
         VTR_LOGV(verbose, "Added '%s' as a child to '%s'\n",
                  bitstream_manager.block_name(cb_grouped_config_block).c_str(),
-                 bitstream_manager.block_name(cb_configurable_block).c_str());
+                 bitstream_manager.block_name(cb_configurable_block));
         cb_configurable_block = cb_grouped_config_block;
       }
 
@@ -600,12 +612,14 @@ static void build_connection_block_bitstreams(
 }
 
 /********************************************************************
- * Top-level function to create bitstream for global routing architecture
+ * Create bitstream for global routing architecture
  * Two major tasks:
  * 1. Generate bitstreams for Switch Blocks
  * 2. Generate bitstreams for both X-direction and Y-direction Connection Blocks
+ * Only the GSBs at the given coordinates are considered, unless all the
+ * GSBs are required
  *******************************************************************/
-void build_routing_bitstream(
+static void build_routing_bitstream_on_coordinates(
   BitstreamManager& bitstream_manager,
   const ConfigBlockId& top_configurable_block,
   const ModuleManager& module_manager, const ModuleNameMap& module_name_map,
@@ -614,6 +628,7 @@ void build_routing_bitstream(
   const VprDeviceAnnotation& device_annotation,
   const VprRoutingAnnotation& routing_annotation, const RRGraphView& rr_graph,
   const DeviceRRGSB& device_rr_gsb, const bool& compact_routing_hierarchy,
+  const std::set<vtr::Point<size_t>>& gsb_coords, const bool& all_gsbs,
   const bool& verbose) {
   /* Generate bitstream for each switch blocks
    * To organize the bitstream in blocks, we create a block for each switch
@@ -624,6 +639,9 @@ void build_routing_bitstream(
   vtr::Point<size_t> sb_range = device_rr_gsb.get_gsb_range();
   for (size_t ix = 0; ix < sb_range.x(); ++ix) {
     for (size_t iy = 0; iy < sb_range.y(); ++iy) {
+      if (!all_gsbs && 0 == gsb_coords.count(vtr::Point<size_t>(ix, iy))) {
+        continue;
+      }
       const RRGSB& rr_gsb = device_rr_gsb.get_gsb(ix, iy);
       /* Check if the switch block exists in the device!
        * Some of them do NOT exist due to heterogeneous blocks (width > 1)
@@ -742,7 +760,7 @@ void build_routing_bitstream(
     bitstream_manager, top_configurable_block, module_manager, module_name_map,
     fabric_tile, circuit_lib, mux_lib, atom_ctx, device_annotation,
     routing_annotation, rr_graph, device_rr_gsb, compact_routing_hierarchy,
-    CHANX, verbose);
+    CHANX, gsb_coords, all_gsbs, verbose);
   VTR_LOG("Done\n");
 
   VTR_LOG("Generating bitstream for Y-direction Connection blocks ...");
@@ -751,8 +769,50 @@ void build_routing_bitstream(
     bitstream_manager, top_configurable_block, module_manager, module_name_map,
     fabric_tile, circuit_lib, mux_lib, atom_ctx, device_annotation,
     routing_annotation, rr_graph, device_rr_gsb, compact_routing_hierarchy,
-    CHANY, verbose);
+    CHANY, gsb_coords, all_gsbs, verbose);
   VTR_LOG("Done\n");
 }
 
+/********************************************************************
+ * Top-level function to create bitstream for global routing architecture
+ *******************************************************************/
+void build_routing_bitstream(
+  BitstreamManager& bitstream_manager,
+  const ConfigBlockId& top_configurable_block,
+  const ModuleManager& module_manager, const ModuleNameMap& module_name_map,
+  const FabricTile& fabric_tile, const CircuitLibrary& circuit_lib,
+  const MuxLibrary& mux_lib, const AtomContext& atom_ctx,
+  const VprDeviceAnnotation& device_annotation,
+  const VprRoutingAnnotation& routing_annotation, const RRGraphView& rr_graph,
+  const DeviceRRGSB& device_rr_gsb, const bool& compact_routing_hierarchy,
+  const bool& verbose) {
+  build_routing_bitstream_on_coordinates(
+    bitstream_manager, top_configurable_block, module_manager, module_name_map,
+    fabric_tile, circuit_lib, mux_lib, atom_ctx, device_annotation,
+    routing_annotation, rr_graph, device_rr_gsb, compact_routing_hierarchy,
+    std::set<vtr::Point<size_t>>(), true, verbose);
+}
+
+/********************************************************************
+ * Create bitstream only for the routing blocks of the GSBs at the given
+ * coordinates, which is used to rebuild the GSBs changed by a new
+ * implementation
+ *******************************************************************/
+void build_routing_bitstream(
+  BitstreamManager& bitstream_manager,
+  const ConfigBlockId& top_configurable_block,
+  const ModuleManager& module_manager, const ModuleNameMap& module_name_map,
+  const FabricTile& fabric_tile, const CircuitLibrary& circuit_lib,
+  const MuxLibrary& mux_lib, const AtomContext& atom_ctx,
+  const VprDeviceAnnotation& device_annotation,
+  const VprRoutingAnnotation& routing_annotation, const RRGraphView& rr_graph,
+  const DeviceRRGSB& device_rr_gsb, const bool& compact_routing_hierarchy,
+  const std::set<vtr::Point<size_t>>& gsb_coords, const bool& verbose) {
+  build_routing_bitstream_on_coordinates(
+    bitstream_manager, top_configurable_block, module_manager, module_name_map,
+    fabric_tile, circuit_lib, mux_lib, atom_ctx, device_annotation,
+    routing_annotation, rr_graph, device_rr_gsb, compact_routing_hierarchy,
+    gsb_coords, false, verbose);
+}
+
 } /* end namespace openfpga */
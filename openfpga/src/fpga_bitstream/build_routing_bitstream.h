@@ -7,6 +7,7 @@
 /********************************************************************
  * Include header files that are required by function declaration
  *******************************************************************/
+#include <set>
 #include <vector>
 
 #include "bitstream_manager.h"
@@ -38,6 +39,17 @@ void build_routing_bitstream(
   const DeviceRRGSB& device_rr_gsb, const bool& compact_routing_hierarchy,
   const bool& verbose);
 
+void build_routing_bitstream(
+  BitstreamManager& bitstream_manager,
+  const ConfigBlockId& top_configurable_block,
+  const ModuleManager& module_manager, const ModuleNameMap& module_name_map,
+  const FabricTile& fabric_tile, const CircuitLibrary& circuit_lib,
+  const MuxLibrary& mux_lib, const AtomContext& atom_ctx,
+  const VprDeviceAnnotation& device_annotation,
+  const VprRoutingAnnotation& routing_annotation, const RRGraphView& rr_graph,
+  const DeviceRRGSB& device_rr_gsb, const bool& compact_routing_hierarchy,
+  const std::set<vtr::Point<size_t>>& gsb_coords, const bool& verbose);
+
 } /* end namespace openfpga */
 
 #endif
@@ -0,0 +1,87 @@
+/******************************************************************************
+ * Memember functions for data structure DeviceBitstreamDigest
+ ******************************************************************************/
+#include "device_bitstream_digest.h"
+
+#include "vtr_assert.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/**************************************************
+ * Public Constructors
+ *************************************************/
+DeviceBitstreamDigest::DeviceBitstreamDigest() { clear(); }
+
+/**************************************************
+ * Public Accessors
+ *************************************************/
+bool DeviceBitstreamDigest::valid(
+  const BitstreamManager& bitstream_manager) const {
+  return (0 < num_bits_) && (num_blocks_ == bitstream_manager.num_blocks()) &&
+         (num_bits_ == bitstream_manager.num_bits());
+}
+
+const vtr::Matrix<uint64_t>& DeviceBitstreamDigest::grid_digests() const {
+  return grid_digests_;
+}
+
+const vtr::Matrix<uint64_t>& DeviceBitstreamDigest::gsb_digests() const {
+  return gsb_digests_;
+}
+
+const std::vector<std::pair<ConfigBitId, bool>>&
+DeviceBitstreamDigest::overwritten_bits() const {
+  return overwritten_bits_;
+}
+
+bool DeviceBitstreamDigest::all_bits_changed() const {
+  return all_bits_changed_;
+}
+
+const std::vector<ConfigBitId>& DeviceBitstreamDigest::changed_bits() const {
+  return changed_bits_;
+}
+
+/**************************************************
+ * Public Mutators
+ *************************************************/
+void DeviceBitstreamDigest::set_digests(
+  const BitstreamManager& bitstream_manager,
+  const vtr::Matrix<uint64_t>& grid_digests,
+  const vtr::Matrix<uint64_t>& gsb_digests) {
+  num_blocks_ = bitstream_manager.num_blocks();
+  num_bits_ = bitstream_manager.num_bits();
+  grid_digests_ = grid_digests;
+  gsb_digests_ = gsb_digests;
+}
+
+void DeviceBitstreamDigest::set_overwritten_bits(
+  const std::vector<std::pair<ConfigBitId, bool>>& overwritten_bits) {
+  overwritten_bits_ = overwritten_bits;
+}
+
+void DeviceBitstreamDigest::add_changed_bit(const ConfigBitId& bit) {
+  /* No need to track any bit when all of them are changed */
+  if (all_bits_changed_) {
+    return;
+  }
+  changed_bits_.push_back(bit);
+}
+
+void DeviceBitstreamDigest::clear_changed_bits() {
+  all_bits_changed_ = false;
+  changed_bits_.clear();
+}
+
+void DeviceBitstreamDigest::clear() {
+  num_blocks_ = 0;
+  num_bits_ = 0;
+  grid_digests_.clear();
+  gsb_digests_.clear();
+  overwritten_bits_.clear();
+  all_bits_changed_ = true;
+  changed_bits_.clear();
+}
+
+} /* end namespace openfpga */
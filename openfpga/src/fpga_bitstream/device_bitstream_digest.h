@@ -0,0 +1,70 @@
+#ifndef DEVICE_BITSTREAM_DIGEST_H
+#define DEVICE_BITSTREAM_DIGEST_H
+
+/********************************************************************
+ * Include header files required by the data structure definition
+ *******************************************************************/
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "bitstream_manager.h"
+#include "vtr_geometry.h"
+#include "vtr_ndmatrix.h"
+
+/* Begin namespace openfpga */
+namespace openfpga {
+
+/********************************************************************
+ * A data structure to record what the architecture bitstream was built
+ * from, so that it can be updated incrementally for a new implementation
+ * on the same fabric:
+ * - a digest of the design data (placed clusters and physical pbs) of
+ *   each grid, and of the routing data of each GSB
+ * - the bits overwritten by the bitstream setting, with the values they
+ *   had before being overwritten
+ * - the bits changed since the fabric bitstream was last built, which
+ *   are the only bits that the fabric bitstream has to be patched on
+ *******************************************************************/
+class DeviceBitstreamDigest {
+ public: /* Public constructor */
+  DeviceBitstreamDigest();
+
+ public: /* Public accessors */
+  /* Check if the digest was recorded for a bitstream database of the
+   * given size */
+  bool valid(const BitstreamManager& bitstream_manager) const;
+  const vtr::Matrix<uint64_t>& grid_digests() const;
+  const vtr::Matrix<uint64_t>& gsb_digests() const;
+  const std::vector<std::pair<ConfigBitId, bool>>& overwritten_bits() const;
+  /* Check if every bit should be considered as changed, e.g., when the
+   * architecture bitstream is built from scratch */
+  bool all_bits_changed() const;
+  const std::vector<ConfigBitId>& changed_bits() const;
+
+ public: /* Public mutators */
+  void set_digests(const BitstreamManager& bitstream_manager,
+                   const vtr::Matrix<uint64_t>& grid_digests,
+                   const vtr::Matrix<uint64_t>& gsb_digests);
+  void set_overwritten_bits(
+    const std::vector<std::pair<ConfigBitId, bool>>& overwritten_bits);
+  void add_changed_bit(const ConfigBitId& bit);
+  /* Called when the fabric bitstream is in sync with the architecture
+   * bitstream */
+  void clear_changed_bits();
+  /* Forget the previous run, which is required when the fabric changes */
+  void clear();
+
+ private: /* Internal data */
+  size_t num_blocks_;
+  size_t num_bits_;
+  vtr::Matrix<uint64_t> grid_digests_;
+  vtr::Matrix<uint64_t> gsb_digests_;
+  std::vector<std::pair<ConfigBitId, bool>> overwritten_bits_;
+  bool all_bits_changed_;
+  std::vector<ConfigBitId> changed_bits_;
+};
+
+} /* End namespace openfpga*/
+
+#endif
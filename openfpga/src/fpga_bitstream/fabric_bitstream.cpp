@@ -4,6 +4,7 @@
 #include "fabric_bitstream.h"
 
 #include <algorithm>
+#include <bitset>
 
 #include "openfpga_decode.h"
 #include "vtr_assert.h"
@@ -11,6 +12,32 @@
 /* begin namespace openfpga */
 namespace openfpga {
 
+/**************************************************
+ * Count the leading run of a given value in a packed bit array, where
+ * bit i is stored in bit (i % 64) of word (i / 64). The unused bits of the
+ * last word must be zero
+ *************************************************/
+static size_t count_packed_leading_run(const std::vector<uint64_t>& words,
+                                       const size_t& num_bits,
+                                       const bool& value) {
+  const uint64_t run_word = value ? ~uint64_t(0) : uint64_t(0);
+  size_t num_run_bits = 0;
+  for (const uint64_t& word : words) {
+    if (word == run_word) {
+      num_run_bits += 64;
+      continue;
+    }
+    /* Count until the first bit which differs from the value */
+    uint64_t mismatch = word ^ run_word;
+    while (0 == (mismatch & 1)) {
+      mismatch >>= 1;
+      num_run_bits++;
+    }
+    break;
+  }
+  return std::min(num_run_bits, num_bits);
+}
+
 /**************************************************
  * FabricBitstreamMemoryBank
  *************************************************/
@@ -61,43 +88,76 @@ void FabricBitstreamMemoryBank::add_bit(const fabric_size_t& bit_id,
   }
   // Mark the mask to indicate we had used this bit
   masks[region_id][wl][bl >> 3] |= (1 << (bl & 7));
+  is_skip_analysis_valid = false;
+}
+
+void FabricBitstreamMemoryBank::set_bit(const fabric_size_t& bit_id,
+                                        const bool& bit) {
+  VTR_ASSERT((size_t)(bit_id) < fabric_bit_datas.size());
+  fabric_bit_data& bit_data = fabric_bit_datas[bit_id];
+  bit_data.bit = bit;
+  uint8_t& data = datas[bit_data.region][bit_data.wl][bit_data.bl >> 3];
+  if (bit) {
+    data |= (1 << (bit_data.bl & 7));
+  } else {
+    data &= ~(1 << (bit_data.bl & 7));
+  }
+  is_skip_analysis_valid = false;
 }
 
 void FabricBitstreamMemoryBank::fast_configuration(
   const bool& fast, const bool& bit_value_to_skip) {
-  for (auto& wls : wls_to_skip) {
-    wls.clear();
+  // Reuse the analysis done by a previous writer or testbench generator
+  if (is_skip_analysis_valid && skip_analysis_fast == fast &&
+      skip_analysis_bit_value == bit_value_to_skip) {
+    return;
   }
+  is_skip_analysis_valid = true;
+  skip_analysis_fast = fast;
+  skip_analysis_bit_value = bit_value_to_skip;
   wls_to_skip.clear();
+  num_wls_to_skip.clear();
+  wls_to_skip.resize(datas.size());
+  num_wls_to_skip.resize(datas.size(), 0);
   for (size_t region = 0; region < datas.size(); region++) {
-    wls_to_skip.emplace_back();
-    if (fast) {
-      for (fabric_size_t wl = 0; wl < blwl_lengths[region].wl; wl++) {
-        VTR_ASSERT((size_t)(wl) < datas[region].size());
-        bool skip_wl = true;
-        for (fabric_size_t bl = 0; bl < blwl_lengths[region].bl && skip_wl;
-             bl++) {
-          // Only check the bit that being used (marked in the mask),
-          // otherwise it is just a don't care, we can skip
-          if (masks[region][wl][bl >> 3] & (1 << (bl & 7))) {
-            if (datas[region][wl][bl >> 3] & (1 << (bl & 7))) {
-              // If bit_value_to_skip=true, and yet the din (recorded in
-              // datas) also 1, then we can skip
-              skip_wl = bit_value_to_skip;
-            } else {
-              skip_wl = !bit_value_to_skip;
-            }
-          }
-        }
-        if (skip_wl) {
-          // Record down that for this region, we will skip this WL
-          wls_to_skip[region].push_back(wl);
-        }
+    wls_to_skip[region].resize(datas[region].size(), false);
+    if (!fast) {
+      continue;
+    }
+    for (fabric_size_t wl = 0; wl < blwl_lengths[region].wl; wl++) {
+      VTR_ASSERT((size_t)(wl) < datas[region].size());
+      const std::vector<uint8_t>& data = datas[region][wl];
+      const std::vector<uint8_t>& mask = masks[region][wl];
+      // Compare a whole byte (8 BLs) at a time.
+      // Only the bits being used (marked in the mask) matter, others are
+      // don't care. The WL can be skipped when all the used bits are equal to
+      // bit_value_to_skip, i.e.,
+      //   - (data & mask) == mask when bit_value_to_skip=true
+      //   - (data & mask) == 0 when bit_value_to_skip=false
+      bool skip_wl = true;
+      for (size_t byte = 0; byte < mask.size() && skip_wl; byte++) {
+        uint8_t used_data = data[byte] & mask[byte];
+        skip_wl = bit_value_to_skip ? (used_data == mask[byte])
+                                    : (used_data == 0);
+      }
+      if (skip_wl) {
+        // Record down that for this region, we will skip this WL
+        wls_to_skip[region][wl] = true;
+        num_wls_to_skip[region]++;
       }
     }
   }
 }
 
+bool FabricBitstreamMemoryBank::is_wl_skipped(const fabric_size_t& region,
+                                              const fabric_size_t& wl) const {
+  VTR_ASSERT((size_t)(region) < wls_to_skip.size());
+  if ((size_t)(wl) >= wls_to_skip[region].size()) {
+    return false;
+  }
+  return wls_to_skip[region][wl];
+}
+
 fabric_size_t FabricBitstreamMemoryBank::get_longest_effective_wl_count()
   const {
   // This function check effective WL count
@@ -105,9 +165,9 @@ fabric_size_t FabricBitstreamMemoryBank::get_longest_effective_wl_count()
   // fast configuration from all the region, it return the longest
   fabric_size_t longest_wl = 0;
   for (size_t region = 0; region < datas.size(); region++) {
-    VTR_ASSERT((size_t)(region) < wls_to_skip.size());
+    VTR_ASSERT((size_t)(region) < num_wls_to_skip.size());
     fabric_size_t current_wl =
-      (fabric_size_t)(datas[region].size() - wls_to_skip[region].size());
+      (fabric_size_t)(datas[region].size() - num_wls_to_skip[region]);
     if (current_wl > longest_wl) {
       longest_wl = current_wl;
     }
@@ -147,6 +207,8 @@ FabricBitstream::FabricBitstream() {
 
   use_address_ = false;
   use_wl_address_ = false;
+
+  arch_bitstream_digest_ = 0;
 }
 
 /**************************************************
@@ -189,6 +251,25 @@ ConfigBitId FabricBitstream::config_bit(const FabricBitId& bit_id) const {
   return config_bit_ids_[bit_id];
 }
 
+FabricBitId FabricBitstream::find_fabric_bit(
+  const ConfigBitId& config_bit_id) const {
+  if (fabric_bit_lookup_.empty() && 0 < num_bits_) {
+    fabric_bit_lookup_.reserve(num_bits_);
+    for (const FabricBitId& bit : bits()) {
+      const ConfigBitId& config_bit = config_bit_ids_[bit];
+      if (size_t(config_bit) >= fabric_bit_lookup_.size()) {
+        fabric_bit_lookup_.resize(size_t(config_bit) + 1,
+                                  FabricBitId::INVALID());
+      }
+      fabric_bit_lookup_[config_bit] = bit;
+    }
+  }
+  if (size_t(config_bit_id) >= fabric_bit_lookup_.size()) {
+    return FabricBitId::INVALID();
+  }
+  return fabric_bit_lookup_[config_bit_id];
+}
+
 std::vector<char> FabricBitstream::bit_address(
   const FabricBitId& bit_id) const {
   /* Ensure a valid id */
@@ -247,6 +328,17 @@ char FabricBitstream::bit_din(const FabricBitId& bit_id) const {
   return bit_dins_[bit_id];
 }
 
+bool FabricBitstream::bit_value(const FabricBitId& bit_id) const {
+  /* Ensure a valid id */
+  VTR_ASSERT(true == valid_bit_id(bit_id));
+
+  return bit_values_[bit_id];
+}
+
+uint64_t FabricBitstream::arch_bitstream_digest() const {
+  return arch_bitstream_digest_;
+}
+
 bool FabricBitstream::use_address() const { return use_address_; }
 
 bool FabricBitstream::use_wl_address() const { return use_wl_address_; }
@@ -260,11 +352,44 @@ const FabricBitstreamMemoryBank& FabricBitstream::memory_bank_info(
   return memory_bank_data_;
 }
 
+const FabricBitstreamSkipInfo& FabricBitstream::skip_info() const {
+  if (is_skip_info_dirty_) {
+    build_skip_info();
+  }
+  return skip_info_;
+}
+
+void FabricBitstream::memory_usage(MemoryUsage& usage) const {
+  usage.add_container(invalid_region_ids_);
+  usage.add_container(region_bit_ids_);
+  usage.add_container(invalid_bit_ids_);
+  usage.add_container(config_bit_ids_);
+  usage.add_container(fabric_bit_lookup_);
+  usage.add_container(bit_values_);
+  usage.add_container(bit_address_1bits_);
+  usage.add_container(bit_address_xbits_);
+  usage.add_container(bit_wl_address_1bits_);
+  usage.add_container(bit_wl_address_xbits_);
+  usage.add_container(bit_dins_);
+
+  usage.add_container(memory_bank_data_.blwl_lengths);
+  usage.add_container(memory_bank_data_.fabric_bit_datas);
+  usage.add_container(memory_bank_data_.datas);
+  usage.add_container(memory_bank_data_.masks);
+  usage.add_container(memory_bank_data_.wls_to_skip);
+  usage.add_container(memory_bank_data_.num_wls_to_skip);
+
+  /* Cached statistics can be rebuilt at any time */
+  usage.add_lookup(skip_info_.region_leading_ones);
+  usage.add_lookup(skip_info_.region_leading_zeros);
+}
+
 /******************************************************************************
  * Public Mutators
  ******************************************************************************/
 void FabricBitstream::reserve_bits(const size_t& num_bits) {
   config_bit_ids_.reserve(num_bits);
+  bit_values_.reserve(num_bits);
 
   if (true == use_address_) {
     bit_address_1bits_.reserve(num_bits);
@@ -283,6 +408,9 @@ FabricBitId FabricBitstream::add_bit(const ConfigBitId& config_bit_id) {
   /* Add a new bit, and allocate associated data structures */
   num_bits_++;
   config_bit_ids_.push_back(config_bit_id);
+  bit_values_.push_back(false);
+  is_skip_info_dirty_ = true;
+  fabric_bit_lookup_.clear();
 
   if (true == use_address_) {
     bit_address_1bits_.emplace_back();
@@ -357,6 +485,20 @@ void FabricBitstream::set_bit_din(const FabricBitId& bit_id, const char& din) {
   bit_dins_[bit_id] = din;
 }
 
+void FabricBitstream::set_bit_value(const FabricBitId& bit_id,
+                                    const bool& value) {
+  VTR_ASSERT(true == valid_bit_id(bit_id));
+  bit_values_[bit_id] = value;
+  is_skip_info_dirty_ = true;
+  if (true == use_address_) {
+    bit_dins_[bit_id] = value;
+  }
+  /* Memory bank data is only available for some protocols */
+  if (size_t(bit_id) < memory_bank_data_.fabric_bit_datas.size()) {
+    memory_bank_data_.set_bit((fabric_size_t)(size_t)(bit_id), value);
+  }
+}
+
 void FabricBitstream::set_use_address(const bool& enable) {
   /* Add a lock, only can be modified when num bits are zero*/
   if (0 == num_bits_) {
@@ -408,6 +550,10 @@ void FabricBitstream::set_wl_address_length(const size_t& length) {
   }
 }
 
+void FabricBitstream::set_arch_bitstream_digest(const uint64_t& digest) {
+  arch_bitstream_digest_ = digest;
+}
+
 void FabricBitstream::reserve_regions(const size_t& num_regions) {
   region_bit_ids_.reserve(num_regions);
 }
@@ -417,6 +563,7 @@ FabricBitRegionId FabricBitstream::add_region() {
   /* Add a new bit, and allocate associated data structures */
   num_regions_++;
   region_bit_ids_.emplace_back();
+  is_skip_info_dirty_ = true;
 
   return region;
 }
@@ -427,10 +574,14 @@ void FabricBitstream::add_bit_to_region(const FabricBitRegionId& region_id,
   VTR_ASSERT(true == valid_bit_id(bit_id));
 
   region_bit_ids_[region_id].push_back(bit_id);
+  is_skip_info_dirty_ = true;
 }
 
 void FabricBitstream::reverse() {
   std::reverse(config_bit_ids_.begin(), config_bit_ids_.end());
+  std::reverse(bit_values_.begin(), bit_values_.end());
+  is_skip_info_dirty_ = true;
+  fabric_bit_lookup_.clear();
 
   if (true == use_address_) {
     std::reverse(bit_address_1bits_.begin(), bit_address_1bits_.end());
@@ -449,6 +600,7 @@ void FabricBitstream::reverse_region_bits(const FabricBitRegionId& region_id) {
 
   std::reverse(region_bit_ids_[region_id].begin(),
                region_bit_ids_[region_id].end());
+  is_skip_info_dirty_ = true;
 }
 
 /******************************************************************************
@@ -507,4 +659,56 @@ std::vector<char> FabricBitstream::decode_address_bits(
   return ret_vec;
 }
 
+/******************************************************************************
+ * Compute the statistics for fast configuration in a single pass.
+ * Each regional bitstream is packed into 64-bit words, so that the number of
+ * '1' and the leading runs are counted on a word rather than a bit basis
+ ******************************************************************************/
+void FabricBitstream::build_skip_info() const {
+  skip_info_ = FabricBitstreamSkipInfo();
+  skip_info_.region_leading_ones.reserve(num_regions_);
+  skip_info_.region_leading_zeros.reserve(num_regions_);
+
+  std::vector<uint64_t> words;
+  for (const FabricBitRegionId& region : regions()) {
+    const std::vector<FabricBitId>& region_bit_ids = region_bit_ids_[region];
+    words.assign((region_bit_ids.size() + 63) / 64, 0);
+    for (size_t ibit = 0; ibit < region_bit_ids.size(); ++ibit) {
+      if (bit_values_[region_bit_ids[ibit]]) {
+        words[ibit / 64] |= uint64_t(1) << (ibit % 64);
+      }
+    }
+    size_t num_ones = 0;
+    for (const uint64_t& word : words) {
+      num_ones += std::bitset<64>(word).count();
+    }
+    skip_info_.num_ones += num_ones;
+    skip_info_.num_zeros += region_bit_ids.size() - num_ones;
+    skip_info_.region_leading_ones.push_back(
+      count_packed_leading_run(words, region_bit_ids.size(), true));
+    skip_info_.region_leading_zeros.push_back(
+      count_packed_leading_run(words, region_bit_ids.size(), false));
+  }
+
+  /* The leading run of the whole bitstream ends at the first bit whose value
+   * differs from the first bit */
+  if (0 < num_bits_) {
+    bool first_value = bit_values_[FabricBitId(0)];
+    size_t num_leading_bits = 0;
+    for (const FabricBitId& bit_id : bits()) {
+      if (first_value != bit_values_[bit_id]) {
+        break;
+      }
+      num_leading_bits++;
+    }
+    if (first_value) {
+      skip_info_.num_leading_ones = num_leading_bits;
+    } else {
+      skip_info_.num_leading_zeros = num_leading_bits;
+    }
+  }
+
+  is_skip_info_dirty_ = false;
+}
+
 } /* end namespace openfpga */
@@ -37,6 +37,7 @@
 
 #include "bitstream_manager_fwd.h"
 #include "fabric_bitstream_fwd.h"
+#include "openfpga_memory_usage.h"
 #include "vtr_vector.h"
 
 /* begin namespace openfpga */
@@ -52,7 +53,8 @@ struct fabric_bit_data {
   const fabric_size_t region = 0;
   const fabric_size_t bl = 0;
   const fabric_size_t wl = 0;
-  const bool bit = false;
+  /* Bit value can be updated when the bitstream is patched */
+  bool bit = false;
 };
 struct fabric_blwl_length {
   fabric_blwl_length(fabric_size_t b, fabric_size_t w) : bl(b), wl(w) {}
@@ -68,7 +70,10 @@ struct FabricBitstreamMemoryBank {
                const fabric_size_t& bl, const fabric_size_t& wl,
                const fabric_size_t& bl_addr_size,
                const fabric_size_t& wl_addr_size, bool bit);
+  void set_bit(const fabric_size_t& bit_id, const bool& bit);
   void fast_configuration(const bool& fast, const bool& bit_value_to_skip);
+  bool is_wl_skipped(const fabric_size_t& region,
+                     const fabric_size_t& wl) const;
   fabric_size_t get_longest_effective_wl_count() const;
   fabric_size_t get_total_bl_addr_size() const;
   fabric_size_t get_total_wl_addr_size() const;
@@ -117,8 +122,43 @@ struct FabricBitstreamMemoryBank {
         c. Other BLs #1, 2, 3, 4, 5, 7 are don't care bit (not being used)
   */
   std::vector<std::vector<std::vector<uint8_t>>> masks;
-  // This track which WL to skip because of fast configuration
-  std::vector<std::vector<fabric_size_t>> wls_to_skip;
+  /*
+    This track which WL to skip because of fast configuration
+    It is a bitmap with the same structure as datas, where
+      wls_to_skip[region #0][wl #0] = true means WL #0 of region #0 is skipped
+    The number of WLs skipped in each region is cached in num_wls_to_skip
+    so that the effective WL count can be found without a scan
+  */
+  std::vector<std::vector<bool>> wls_to_skip;
+  std::vector<fabric_size_t> num_wls_to_skip;
+  /*
+    The settings under which wls_to_skip was last computed, so that the
+    skip analysis is not repeated by each writer or testbench generator.
+    Any change on the bits invalidates it
+  */
+  bool is_skip_analysis_valid = false;
+  bool skip_analysis_fast = false;
+  bool skip_analysis_bit_value = false;
+};
+
+/*
+  Statistics on the bits which can be skipped by fast configuration,
+  computed in a single pass on the bit values of the fabric bitstream
+  - The total numbers of '1' and '0' decide the value to be skipped for
+    protocols which can skip any bit, e.g., memory banks
+  - The leading runs decide the number of bits to be skipped for
+    configuration chains, which can only skip bits at the head of each
+    regional bitstream
+*/
+struct FabricBitstreamSkipInfo {
+  size_t num_ones = 0;
+  size_t num_zeros = 0;
+  /* Leading runs in the sequence of all the bits */
+  size_t num_leading_ones = 0;
+  size_t num_leading_zeros = 0;
+  /* Leading runs of each regional bitstream */
+  std::vector<size_t> region_leading_ones;
+  std::vector<size_t> region_leading_zeros;
 };
 
 class FabricBitstream {
@@ -212,6 +252,11 @@ class FabricBitstream {
   /* Find the configuration bit id in architecture bitstream database */
   ConfigBitId config_bit(const FabricBitId& bit_id) const;
 
+  /* Find the fabric bit which a configuration bit in architecture bitstream
+   * database is mapped to. The lookup is built on the first call and cached
+   * until any bit is added or reordered */
+  FabricBitId find_fabric_bit(const ConfigBitId& config_bit_id) const;
+
   /* Find the address of bitstream */
   std::vector<char> bit_address(const FabricBitId& bit_id) const;
   std::vector<char> bit_bl_address(const FabricBitId& bit_id) const;
@@ -220,6 +265,15 @@ class FabricBitstream {
   /* Find the data-in of bitstream */
   char bit_din(const FabricBitId& bit_id) const;
 
+  /* Find the value of a bit when it was last updated from the architecture
+   * bitstream database */
+  bool bit_value(const FabricBitId& bit_id) const;
+
+  /* Find the structure digest of the architecture bitstream database which
+   * the fabric bitstream is built from. See
+   * bitstream_manager_structure_digest() for details */
+  uint64_t arch_bitstream_digest() const;
+
   /* Check if address data is accessible or not*/
   bool use_address() const;
   bool use_wl_address() const;
@@ -227,6 +281,13 @@ class FabricBitstream {
   const FabricBitstreamMemoryBank& memory_bank_info(
     const bool& fast = false, const bool& bit_value_to_skip = false) const;
 
+  /* Statistics for fast configuration. They are computed on the first call
+   * and cached until any bit is changed */
+  const FabricBitstreamSkipInfo& skip_info() const;
+
+  /* Accumulate the heap memory used by the fabric bitstream */
+  void memory_usage(MemoryUsage& usage) const;
+
  public: /* Public Mutators */
   /* Reserve config bits */
   void reserve_bits(const size_t& num_bits);
@@ -248,6 +309,12 @@ class FabricBitstream {
 
   void set_bit_din(const FabricBitId& bit_id, const char& din);
 
+  /* Update the value of a bit, including its data-in and memory bank data
+   * when applicable. This is used to patch an existing fabric bitstream
+   * without rebuilding the addresses
+   */
+  void set_bit_value(const FabricBitId& bit_id, const bool& value);
+
   /* Reserve regions */
   void reserve_regions(const size_t& num_regions);
 
@@ -294,6 +361,8 @@ class FabricBitstream {
   void set_use_wl_address(const bool& enable);
   void set_wl_address_length(const size_t& length);
 
+  void set_arch_bitstream_digest(const uint64_t& digest);
+
  public: /* Public Validators */
   bool valid_bit_id(const FabricBitId& bit_id) const;
   bool valid_region_id(const FabricBitRegionId& bit_id) const;
@@ -303,6 +372,7 @@ class FabricBitstream {
   uint64_t encode_address_xbits(const std::vector<char>& address) const;
   std::vector<char> decode_address_bits(const size_t& bit1, const size_t& bitx,
                                         const size_t& addr_len) const;
+  void build_skip_info() const;
 
  private: /* Internal data */
   /* Unique id of a region in the Bitstream */
@@ -314,6 +384,11 @@ class FabricBitstream {
   size_t num_bits_;
   std::unordered_set<FabricBitId> invalid_bit_ids_;
   vtr::vector<FabricBitId, ConfigBitId> config_bit_ids_;
+  /* Value of each bit, which is used to find the changed bits when
+   * the architecture bitstream is rebuilt */
+  vtr::vector<FabricBitId, bool> bit_values_;
+  /* Structure of the architecture bitstream database being built from */
+  uint64_t arch_bitstream_digest_;
 
   /* Flags to indicate if the addresses and din should be enabled */
   bool use_address_;
@@ -348,6 +423,13 @@ class FabricBitstream {
 
   /* New way of dealing with memory bank protocol - fast and compact */
   FabricBitstreamMemoryBank memory_bank_data_;
+
+  /* Cached statistics for fast configuration */
+  mutable FabricBitstreamSkipInfo skip_info_;
+  mutable bool is_skip_info_dirty_ = true;
+
+  /* Cached lookup from configuration bits to fabric bits */
+  mutable vtr::vector<ConfigBitId, FabricBitId> fabric_bit_lookup_;
 };
 
 } /* end namespace openfpga */
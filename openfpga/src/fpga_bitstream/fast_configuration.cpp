@@ -46,7 +46,6 @@ bool is_fast_configuration_applicable(
 bool find_bit_value_to_skip_for_fast_configuration(
   const e_config_protocol_type& config_protocol_type,
   const FabricGlobalPortInfo& global_ports,
-  const BitstreamManager& bitstream_manager,
   const FabricBitstream& fabric_bitstream) {
   /* Preparation: find all the reset/set ports for programming usage */
   std::vector<FabricGlobalPortId> global_prog_reset_ports =
@@ -75,48 +74,26 @@ bool find_bit_value_to_skip_for_fast_configuration(
   size_t num_ones_to_skip = 0;
   size_t num_zeros_to_skip = 0;
 
+  /* The statistics are cached in the fabric bitstream, so that the analysis
+   * is done only once for all the writers and testbench generators */
+  const FabricBitstreamSkipInfo& skip_info = fabric_bitstream.skip_info();
+
   /* Branch on the type of configuration protocol */
   switch (config_protocol_type) {
     case CONFIG_MEM_STANDALONE:
       break;
     case CONFIG_MEM_SCAN_CHAIN: {
       /* We can only skip the ones/zeros at the beginning of the bitstream */
-      /* Count how many logic '1' bits we can skip */
-      for (const FabricBitId& bit_id : fabric_bitstream.bits()) {
-        if (false ==
-            bitstream_manager.bit_value(fabric_bitstream.config_bit(bit_id))) {
-          break;
-        }
-        VTR_ASSERT(true == bitstream_manager.bit_value(
-                             fabric_bitstream.config_bit(bit_id)));
-        num_ones_to_skip++;
-      }
-      /* Count how many logic '0' bits we can skip */
-      for (const FabricBitId& bit_id : fabric_bitstream.bits()) {
-        if (true ==
-            bitstream_manager.bit_value(fabric_bitstream.config_bit(bit_id))) {
-          break;
-        }
-        VTR_ASSERT(false == bitstream_manager.bit_value(
-                              fabric_bitstream.config_bit(bit_id)));
-        num_zeros_to_skip++;
-      }
+      num_ones_to_skip = skip_info.num_leading_ones;
+      num_zeros_to_skip = skip_info.num_leading_zeros;
       break;
     }
     case CONFIG_MEM_QL_MEMORY_BANK:
     case CONFIG_MEM_MEMORY_BANK:
     case CONFIG_MEM_FRAME_BASED: {
       /* Count how many logic '1' and logic '0' bits we can skip */
-      for (const FabricBitId& bit_id : fabric_bitstream.bits()) {
-        if (false ==
-            bitstream_manager.bit_value(fabric_bitstream.config_bit(bit_id))) {
-          num_zeros_to_skip++;
-        } else {
-          VTR_ASSERT(true == bitstream_manager.bit_value(
-                               fabric_bitstream.config_bit(bit_id)));
-          num_ones_to_skip++;
-        }
-      }
+      num_ones_to_skip = skip_info.num_ones;
+      num_zeros_to_skip = skip_info.num_zeros;
       break;
     }
     default:
@@ -7,7 +7,6 @@
 #include <string>
 #include <vector>
 
-#include "bitstream_manager.h"
 #include "config_protocol.h"
 #include "fabric_bitstream.h"
 #include "fabric_global_port_info.h"
@@ -24,7 +23,6 @@ bool is_fast_configuration_applicable(const FabricGlobalPortInfo& global_ports);
 bool find_bit_value_to_skip_for_fast_configuration(
   const e_config_protocol_type& config_protocol_type,
   const FabricGlobalPortInfo& global_ports,
-  const BitstreamManager& bitstream_manager,
   const FabricBitstream& fabric_bitstream);
 
 } /* end namespace openfpga */
@@ -0,0 +1,416 @@
+/******************************************************************************
+ * Memember functions for data structure GridBitstreamTemplate
+ ******************************************************************************/
+#include "grid_bitstream_template.h"
+
+#include <cmath>
+
+#include "build_mux_bitstream.h"
+#include "circuit_library_utils.h"
+#include "module_manager_utils.h"
+#include "mux_bitstream_constants.h"
+#include "mux_utils.h"
+#include "openfpga_naming.h"
+#include "openfpga_reserved_words.h"
+#include "pb_graph_utils.h"
+#include "pb_type_utils.h"
+#include "vtr_assert.h"
+#include "vtr_log.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/**************************************************
+ * Public Constructors
+ *************************************************/
+GridBitstreamTemplate::GridBitstreamTemplate(
+  const ModuleManager& module_manager, const ModuleNameMap& module_name_map,
+  const CircuitLibrary& circuit_lib, const MuxLibrary& mux_lib,
+  const VprDeviceAnnotation& device_annotation,
+  const VprBitstreamAnnotation& bitstream_annotation)
+  : module_manager_(module_manager),
+    module_name_map_(module_name_map),
+    circuit_lib_(circuit_lib),
+    mux_lib_(mux_lib),
+    device_annotation_(device_annotation),
+    bitstream_annotation_(bitstream_annotation) {}
+
+/**************************************************
+ * Public Accessors
+ *************************************************/
+size_t GridBitstreamTemplate::num_pb_type_templates() const {
+  return pb_type_templates_.size();
+}
+
+size_t GridBitstreamTemplate::num_decode_tables() const {
+  return decode_tables_.size();
+}
+
+const std::vector<bool>& GridBitstreamTemplate::mux_bits(
+  const size_t& decode_table, const size_t& path_id) const {
+  VTR_ASSERT(decode_table < decode_tables_.size());
+  const std::vector<std::vector<bool>>& table = decode_tables_[decode_table];
+  if (size_t(DEFAULT_PATH_ID) == path_id) {
+    return table.back();
+  }
+  VTR_ASSERT(path_id < table.size() - 1);
+  return table[path_id];
+}
+
+/**************************************************
+ * Public Mutators
+ *************************************************/
+const PbTypeBitstreamTemplate& GridBitstreamTemplate::pb_type_template(
+  t_pb_type* pb_type) {
+  size_t index = pb_type_indices_.find(pb_type);
+  if (PointerIndexTable<t_pb_type>::INVALID_INDEX == index) {
+    index = pb_type_indices_.insert(pb_type);
+    VTR_ASSERT(index == pb_type_templates_.size());
+    pb_type_templates_.emplace_back();
+    build_pb_type_template(pb_type_templates_.back(), pb_type);
+  }
+  return pb_type_templates_[index];
+}
+
+LogicalTileBitstreamTemplate& GridBitstreamTemplate::logical_tile_template(
+  t_pb_graph_node* pb_graph_head) {
+  size_t index = tile_indices_.find(pb_graph_head);
+  if (PointerIndexTable<t_pb_graph_node>::INVALID_INDEX == index) {
+    index = tile_indices_.insert(pb_graph_head);
+    VTR_ASSERT(index == tile_templates_.size());
+    tile_templates_.emplace_back();
+    /* Pins are built when they are visited */
+    tile_templates_.back().pins.resize(pb_graph_head->total_pb_pins);
+  }
+  return tile_templates_[index];
+}
+
+const PbPinBitstreamTemplate& GridBitstreamTemplate::pin_template(
+  LogicalTileBitstreamTemplate& tile_template, t_pb_graph_pin* pb_graph_pin,
+  t_mode* physical_mode) {
+  VTR_ASSERT(size_t(pb_graph_pin->pin_count_in_cluster) <
+             tile_template.pins.size());
+  PbPinBitstreamTemplate& pin_template =
+    tile_template.pins[pb_graph_pin->pin_count_in_cluster];
+  if (!pin_template.is_built) {
+    build_pin_template(pin_template, pb_graph_pin, physical_mode);
+    pin_template.is_built = true;
+  }
+  return pin_template;
+}
+
+/******************************************************************************
+ * Private builders
+ ******************************************************************************/
+/********************************************************************
+ * Find the module of a pb_type and how its configurable children are
+ * organized. Primitive-specific data are only required when the module
+ * contains any configurable child
+ *******************************************************************/
+void GridBitstreamTemplate::build_pb_type_template(
+  PbTypeBitstreamTemplate& pb_type_template, t_pb_type* pb_type) const {
+  pb_type_template.physical_mode = device_annotation_.physical_mode(pb_type);
+
+  std::string pb_module_name = generate_physical_block_module_name(pb_type);
+  pb_module_name = module_name_map_.name(pb_module_name);
+  ModuleId pb_module = module_manager_.find_module(pb_module_name);
+  VTR_ASSERT(true == module_manager_.valid_module_id(pb_module));
+
+  pb_type_template.is_configurable =
+    0 < module_manager_.num_configurable_children(
+          pb_module, ModuleManager::e_config_child_type::LOGICAL);
+  if (!pb_type_template.is_configurable) {
+    return;
+  }
+  pb_type_template.has_physical_memory =
+    0 < module_manager_.num_configurable_children(
+          pb_module, ModuleManager::e_config_child_type::PHYSICAL);
+  pb_type_template.num_physical_children =
+    count_module_manager_module_configurable_children(
+      module_manager_, pb_module, ModuleManager::e_config_child_type::PHYSICAL);
+
+  if (false == is_primitive_pb_type(pb_type)) {
+    return;
+  }
+
+  pb_type_template.circuit_model =
+    device_annotation_.pb_type_circuit_model(pb_type);
+  VTR_ASSERT(CircuitModelId::INVALID() != pb_type_template.circuit_model);
+  switch (circuit_lib_.model_type(pb_type_template.circuit_model)) {
+    case CIRCUIT_MODEL_LUT:
+      build_lut_template(pb_type_template, pb_type);
+      break;
+    case CIRCUIT_MODEL_FF:
+    case CIRCUIT_MODEL_HARDLOGIC:
+    case CIRCUIT_MODEL_IOPAD:
+      build_primitive_template(pb_type_template, pb_type);
+      break;
+    default:
+      VTR_LOGF_ERROR(__FILE__, __LINE__,
+                     "Unknown circuit model type of pb_type '%s'!\n",
+                     pb_type->name);
+      exit(1);
+  }
+}
+
+/********************************************************************
+ * Find the memory block of a primitive, whose configuration bits are
+ * mode-select bits only
+ *******************************************************************/
+void GridBitstreamTemplate::build_primitive_template(
+  PbTypeBitstreamTemplate& pb_type_template, t_pb_type* pb_type) const {
+  CircuitModelId primitive_model = pb_type_template.circuit_model;
+
+  /* Find SRAM ports for mode-selection */
+  std::vector<CircuitPortId> primitive_mode_select_ports =
+    find_circuit_mode_select_sram_ports(circuit_lib_, primitive_model);
+
+  /* We may have a port for mode select or not. */
+  VTR_ASSERT((0 == primitive_mode_select_ports.size()) ||
+             (1 == primitive_mode_select_ports.size()));
+
+  /* Nothing to do without mode-select ports */
+  if (0 == primitive_mode_select_ports.size()) {
+    return;
+  }
+  pb_type_template.has_memory = true;
+  pb_type_template.has_mode_select = true;
+
+  for (const size_t& mode_bit : device_annotation_.pb_type_mode_bits(pb_type)) {
+    VTR_ASSERT((0 == mode_bit) || (1 == mode_bit));
+    pb_type_template.default_mode_bits.push_back(1 == mode_bit);
+  }
+  pb_type_template.default_bits = pb_type_template.default_mode_bits;
+
+  /* Ensure the length of bitstream matches the side of memory circuits */
+  std::vector<CircuitModelId> sram_models =
+    find_circuit_sram_models(circuit_lib_, primitive_model);
+  VTR_ASSERT(1 == sram_models.size());
+  pb_type_template.mem_block_name =
+    generate_memory_module_name(circuit_lib_, primitive_model, sram_models[0],
+                                std::string(MEMORY_MODULE_POSTFIX));
+  ModuleId mem_module =
+    module_manager_.find_module(pb_type_template.mem_block_name);
+  VTR_ASSERT(true == module_manager_.valid_module_id(mem_module));
+  ModulePortId mem_out_port_id = module_manager_.find_module_port(
+    mem_module, generate_configurable_memory_data_out_name());
+  VTR_ASSERT(
+    pb_type_template.default_bits.size() ==
+    module_manager_.module_port(mem_module, mem_out_port_id).get_width());
+
+  /* If there is a feedthrough module, we should consider the scoreboard */
+  std::string feedthru_mem_block_name =
+    generate_memory_module_name(circuit_lib_, primitive_model, sram_models[0],
+                                std::string(MEMORY_MODULE_POSTFIX), true);
+  pb_type_template.use_mem_scoreboard = module_manager_.valid_module_id(
+    module_manager_.find_module(feedthru_mem_block_name));
+}
+
+/********************************************************************
+ * Find the memory block of a LUT, the multiplexer which decodes its truth
+ * tables and the configuration bits of each output pin
+ *******************************************************************/
+void GridBitstreamTemplate::build_lut_template(
+  PbTypeBitstreamTemplate& pb_type_template, t_pb_type* pb_type) const {
+  CircuitModelId lut_model = pb_type_template.circuit_model;
+  pb_type_template.has_memory = true;
+
+  /* Find the input ports for LUT size, this is used to decode the LUT memory
+   * bits! */
+  std::vector<CircuitPortId> model_input_ports =
+    find_lut_circuit_model_input_port(circuit_lib_, lut_model, false);
+  VTR_ASSERT(1 == model_input_ports.size());
+  size_t lut_size = circuit_lib_.port_size(model_input_ports[0]);
+
+  /* Find SRAM ports for truth tables and mode-selection */
+  std::vector<CircuitPortId> lut_regular_sram_ports =
+    find_circuit_regular_sram_ports(circuit_lib_, lut_model);
+  std::vector<CircuitPortId> lut_mode_select_ports =
+    find_circuit_mode_select_sram_ports(circuit_lib_, lut_model);
+  /* We should always 1 regular sram port, where truth table is loaded to */
+  VTR_ASSERT(1 == lut_regular_sram_ports.size());
+  /* We may have a port for mode select or not. This depends on if the LUT is
+   * fracturable or not */
+  VTR_ASSERT((0 == lut_mode_select_ports.size()) ||
+             (1 == lut_mode_select_ports.size()));
+  pb_type_template.has_mode_select = (1 == lut_mode_select_ports.size());
+
+  /* An unused LUT has an empty truth table, which are full of default values
+   * (defined by users) */
+  pb_type_template.lut_default_value =
+    circuit_lib_.port_default_value(lut_regular_sram_ports[0]);
+  VTR_ASSERT((0 == pb_type_template.lut_default_value) ||
+             (1 == pb_type_template.lut_default_value));
+  pb_type_template.default_bits.assign(
+    circuit_lib_.port_size(lut_regular_sram_ports[0]),
+    1 == pb_type_template.lut_default_value);
+  if (pb_type_template.has_mode_select) {
+    for (const size_t& mode_bit :
+         device_annotation_.pb_type_mode_bits(pb_type)) {
+      VTR_ASSERT((0 == mode_bit) || (1 == mode_bit));
+      pb_type_template.default_mode_bits.push_back(1 == mode_bit);
+    }
+    pb_type_template.default_bits.insert(
+      pb_type_template.default_bits.end(),
+      pb_type_template.default_mode_bits.begin(),
+      pb_type_template.default_mode_bits.end());
+  }
+
+  /* Find MUX graph correlated to the LUT */
+  pb_type_template.lut_mux =
+    mux_lib_.mux_graph(lut_model, (size_t)pow(2., lut_size));
+  const MuxGraph& mux_graph = mux_lib_.mux_graph(pb_type_template.lut_mux);
+  /* Ensure the LUT MUX has the expected input and SRAM port sizes */
+  VTR_ASSERT(mux_graph.num_memory_bits() == lut_size);
+  VTR_ASSERT(mux_graph.num_inputs() == (size_t)pow(2., lut_size));
+
+  /* Find the configuration bits of each output pin */
+  pb_type_template.lut_output_bit_ranges.resize(pb_type->num_ports);
+  for (int iport = 0; iport < pb_type->num_ports; ++iport) {
+    const t_port* port = &(pb_type->ports[iport]);
+    if (OUT_PORT != port->type) {
+      continue;
+    }
+    for (int ipin = 0; ipin < port->num_pins; ++ipin) {
+      pb_type_template.lut_output_bit_ranges[iport].push_back(
+        find_frac_lut_output_bit_range(circuit_lib_, mux_graph,
+                                       device_annotation_, port, ipin));
+    }
+  }
+
+  /* Ensure the length of bitstream matches the side of memory circuits */
+  std::vector<CircuitModelId> sram_models =
+    find_circuit_sram_models(circuit_lib_, lut_model);
+  VTR_ASSERT(1 == sram_models.size());
+  pb_type_template.mem_block_name =
+    generate_memory_module_name(circuit_lib_, lut_model, sram_models[0],
+                                std::string(MEMORY_MODULE_POSTFIX));
+  ModuleId mem_module =
+    module_manager_.find_module(pb_type_template.mem_block_name);
+  VTR_ASSERT(true == module_manager_.valid_module_id(mem_module));
+  ModulePortId mem_out_port_id = module_manager_.find_module_port(
+    mem_module, generate_configurable_memory_data_out_name());
+  VTR_ASSERT(
+    pb_type_template.default_bits.size() ==
+    module_manager_.module_port(mem_module, mem_out_port_id).get_width());
+
+  /* If there is a feedthrough module, we should consider the scoreboard */
+  std::string feedthru_mem_block_name =
+    generate_memory_module_name(circuit_lib_, lut_model, sram_models[0],
+                                std::string(MEMORY_MODULE_POSTFIX), true);
+  pb_type_template.use_mem_scoreboard = module_manager_.valid_module_id(
+    module_manager_.find_module(feedthru_mem_block_name));
+}
+
+/********************************************************************
+ * Find the interconnect which drives a pin in the physical mode and, when
+ * it is a multiplexer, the memory block and the decode table of the
+ * multiplexer
+ *******************************************************************/
+void GridBitstreamTemplate::build_pin_template(
+  PbPinBitstreamTemplate& pin_template, t_pb_graph_pin* pb_graph_pin,
+  t_mode* physical_mode) {
+  /* Identify the number of fan-in (Consider interconnection edges of only
+   * selected mode) */
+  pin_template.interc = pb_graph_pin_interc(pb_graph_pin, physical_mode);
+  pin_template.inputs = pb_graph_pin_inputs(pb_graph_pin, pin_template.interc);
+  size_t fan_in = pin_template.inputs.size();
+
+  if ((nullptr == pin_template.interc) || (0 == fan_in)) {
+    /* No interconnection matched */
+    return;
+  }
+
+  /* Identify pin interconnection type */
+  t_interconnect* cur_interc = pin_template.interc;
+  enum e_interconnect interc_type =
+    device_annotation_.interconnect_physical_type(cur_interc);
+  switch (interc_type) {
+    case DIRECT_INTERC:
+      /* Nothing to do, return */
+      break;
+    case COMPLETE_INTERC:
+    case MUX_INTERC: {
+      pin_template.is_mux = true;
+      /* Find the circuit model id of the mux, we need its design technology
+       * which matters the bitstream generation */
+      CircuitModelId mux_model =
+        device_annotation_.interconnect_circuit_model(cur_interc);
+      VTR_ASSERT(CIRCUIT_MODEL_MUX == circuit_lib_.model_type(mux_model));
+
+      /* Find the input size of the implementation of a routing multiplexer */
+      size_t datapath_mux_size = fan_in;
+      VTR_ASSERT(true ==
+                 valid_mux_implementation_num_inputs(datapath_mux_size));
+      pin_template.decode_table =
+        find_or_build_decode_table(mux_model, datapath_mux_size);
+      pin_template.default_path_id =
+        bitstream_annotation_.interconnect_default_path_id(cur_interc);
+
+      /* Create the block denoting the memory instances that drives this node in
+       * physical_block */
+      pin_template.mem_block_name = generate_pb_memory_instance_name(
+        GRID_MEM_INSTANCE_PREFIX, pb_graph_pin, std::string(""));
+
+      /* Find the module in module manager and ensure the bitstream size
+       * matches! */
+      std::string mem_module_name =
+        generate_mux_subckt_name(circuit_lib_, mux_model, datapath_mux_size,
+                                 std::string(MEMORY_MODULE_POSTFIX));
+      mem_module_name = module_name_map_.name(mem_module_name);
+      ModuleId mux_mem_module = module_manager_.find_module(mem_module_name);
+      VTR_ASSERT(true == module_manager_.valid_module_id(mux_mem_module));
+      ModulePortId mux_mem_out_port_id = module_manager_.find_module_port(
+        mux_mem_module, generate_configurable_memory_data_out_name());
+      VTR_ASSERT(
+        mux_bits(pin_template.decode_table, size_t(DEFAULT_PATH_ID)).size() ==
+        module_manager_.module_port(mux_mem_module, mux_mem_out_port_id)
+          .get_width());
+
+      /* If there is a feedthrough module, we should consider the scoreboard */
+      std::string feedthru_mem_block_name = generate_mux_subckt_name(
+        circuit_lib_, mux_model, datapath_mux_size,
+        std::string(MEMORY_FEEDTHROUGH_MODULE_POSTFIX));
+      if (module_name_map_.name_exist(feedthru_mem_block_name)) {
+        feedthru_mem_block_name =
+          module_name_map_.name(feedthru_mem_block_name);
+      }
+      pin_template.use_mem_scoreboard = module_manager_.valid_module_id(
+        module_manager_.find_module(feedthru_mem_block_name));
+      break;
+    }
+    default:
+      VTR_LOGF_ERROR(__FILE__, __LINE__,
+                     "Invalid interconnection type for %s (Arch[LINE%d])!\n",
+                     cur_interc->name, cur_interc->line_num);
+      exit(1);
+  }
+}
+
+/********************************************************************
+ * Decode all the path ids of a multiplexer, including the default path,
+ * to configuration bits
+ *******************************************************************/
+size_t GridBitstreamTemplate::find_or_build_decode_table(
+  const CircuitModelId& mux_model, const size_t& mux_size) {
+  auto result = decode_table_ids_.find(std::make_pair(mux_model, mux_size));
+  if (result != decode_table_ids_.end()) {
+    return result->second;
+  }
+
+  size_t table_id = decode_tables_.size();
+  decode_tables_.emplace_back();
+  std::vector<std::vector<bool>>& table = decode_tables_.back();
+  table.reserve(mux_size + 1);
+  for (size_t path_id = 0; path_id < mux_size; ++path_id) {
+    table.push_back(build_mux_bitstream(circuit_lib_, mux_model, mux_lib_,
+                                        mux_size, path_id));
+  }
+  table.push_back(build_mux_bitstream(circuit_lib_, mux_model, mux_lib_,
+                                      mux_size, DEFAULT_PATH_ID));
+  decode_table_ids_[std::make_pair(mux_model, mux_size)] = table_id;
+
+  return table_id;
+}
+
+} /* end namespace openfpga */
@@ -0,0 +1,160 @@
+#ifndef GRID_BITSTREAM_TEMPLATE_H
+#define GRID_BITSTREAM_TEMPLATE_H
+
+/********************************************************************
+ * Include header files required by the data structure definition
+ *******************************************************************/
+#include <deque>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "circuit_library.h"
+#include "lut_utils.h"
+#include "module_manager.h"
+#include "module_name_map.h"
+#include "mux_library.h"
+#include "physical_types.h"
+#include "pointer_index_table.h"
+#include "vpr_bitstream_annotation.h"
+#include "vpr_device_annotation.h"
+
+/* Begin namespace openfpga */
+namespace openfpga {
+
+/********************************************************************
+ * Design-independent data to build the bitstream of a pb_type
+ * - For any pb_type: how its module is organized in configurable children
+ * - For primitive pb_types: the memory block and its default bits, which are
+ *   used when the primitive is not mapped by any design
+ *******************************************************************/
+struct PbTypeBitstreamTemplate {
+  t_mode* physical_mode = nullptr;
+  /* If the module of the pb_type has any logical configurable child */
+  bool is_configurable = false;
+  /* If the module of the pb_type has any physical configurable child, where a
+   * block is created in bitstream */
+  bool has_physical_memory = false;
+  size_t num_physical_children = 0;
+
+  /* Primitive only */
+  CircuitModelId circuit_model = CircuitModelId::INVALID();
+  /* If there is any configuration bit for the primitive */
+  bool has_memory = false;
+  bool has_mode_select = false;
+  std::string mem_block_name;
+  /* Instances of the memory block are grouped by a feedthrough module */
+  bool use_mem_scoreboard = false;
+  std::vector<bool> default_mode_bits;
+  /* Bits of an unused primitive, including the mode-select bits */
+  std::vector<bool> default_bits;
+
+  /* LUT only */
+  MuxId lut_mux = MuxId::INVALID();
+  size_t lut_default_value = 0;
+  std::vector<std::vector<LutOutputBitRange>> lut_output_bit_ranges;
+};
+
+/********************************************************************
+ * Design-independent data to build the bitstream of the routing
+ * multiplexer, if any, which drives a pin of a pb_graph
+ *******************************************************************/
+struct PbPinBitstreamTemplate {
+  bool is_built = false;
+  /* Only multiplexers require configuration bits */
+  bool is_mux = false;
+  t_interconnect* interc = nullptr;
+  std::vector<t_pb_graph_pin*> inputs;
+  /* The table to decode path ids of the multiplexer to bits */
+  size_t decode_table = size_t(-1);
+  /* The path id to be used when the pin is not mapped */
+  size_t default_path_id = size_t(-1);
+  std::string mem_block_name;
+  /* Instances of the memory block are grouped by a feedthrough module */
+  bool use_mem_scoreboard = false;
+};
+
+/********************************************************************
+ * A bitstream template of a logical tile, which contains the
+ * design-independent data of all its pb_types and pb_graph pins.
+ * The pins are indexed by their 'pin_count_in_cluster'
+ *******************************************************************/
+struct LogicalTileBitstreamTemplate {
+  std::vector<PbPinBitstreamTemplate> pins;
+};
+
+/********************************************************************
+ * Bitstream templates of the logical tiles in a device, which are
+ * shared by all the grids of the same type. The templates avoid
+ * resolving modules, memory block names and multiplexer bits again and
+ * again for each grid, so that building the bitstream of a grid only has
+ * to fill the bits which depend on the design.
+ *
+ * Templates are built on demand, when a pb_type or a pin is visited for
+ * the first time.
+ *******************************************************************/
+class GridBitstreamTemplate {
+ public: /* Constructor */
+  GridBitstreamTemplate(const ModuleManager& module_manager,
+                        const ModuleNameMap& module_name_map,
+                        const CircuitLibrary& circuit_lib,
+                        const MuxLibrary& mux_lib,
+                        const VprDeviceAnnotation& device_annotation,
+                        const VprBitstreamAnnotation& bitstream_annotation);
+
+ public: /* Public accessors */
+  size_t num_pb_type_templates() const;
+  size_t num_decode_tables() const;
+  /* Bits of a multiplexer for a given path id, which can be DEFAULT_PATH_ID */
+  const std::vector<bool>& mux_bits(const size_t& decode_table,
+                                    const size_t& path_id) const;
+
+ public: /* Public mutators */
+  const PbTypeBitstreamTemplate& pb_type_template(t_pb_type* pb_type);
+  /* Find the template of a logical tile by its top-level pb_graph node */
+  LogicalTileBitstreamTemplate& logical_tile_template(
+    t_pb_graph_node* pb_graph_head);
+  /* The template of a pin, where the interconnect driving the pin is defined
+   * in the given physical mode */
+  const PbPinBitstreamTemplate& pin_template(
+    LogicalTileBitstreamTemplate& tile_template, t_pb_graph_pin* pb_graph_pin,
+    t_mode* physical_mode);
+
+ private: /* Internal builders */
+  void build_pb_type_template(PbTypeBitstreamTemplate& pb_type_template,
+                              t_pb_type* pb_type) const;
+  void build_primitive_template(PbTypeBitstreamTemplate& pb_type_template,
+                                t_pb_type* pb_type) const;
+  void build_lut_template(PbTypeBitstreamTemplate& pb_type_template,
+                          t_pb_type* pb_type) const;
+  void build_pin_template(PbPinBitstreamTemplate& pin_template,
+                          t_pb_graph_pin* pb_graph_pin, t_mode* physical_mode);
+  size_t find_or_build_decode_table(const CircuitModelId& mux_model,
+                                    const size_t& mux_size);
+
+ private: /* Internal data */
+  const ModuleManager& module_manager_;
+  const ModuleNameMap& module_name_map_;
+  const CircuitLibrary& circuit_lib_;
+  const MuxLibrary& mux_lib_;
+  const VprDeviceAnnotation& device_annotation_;
+  const VprBitstreamAnnotation& bitstream_annotation_;
+
+  /* Templates are stored in deques, so that a template remains at the same
+   * address when more templates are built */
+  PointerIndexTable<t_pb_type> pb_type_indices_;
+  std::deque<PbTypeBitstreamTemplate> pb_type_templates_;
+  /* Logical tiles are indexed by their top-level pb_graph nodes */
+  PointerIndexTable<t_pb_graph_node> tile_indices_;
+  std::deque<LogicalTileBitstreamTemplate> tile_templates_;
+
+  /* Bits of multiplexers indexed by [decode_table][path_id], where the last
+   * path id is the default path. Multiplexers in the same circuit model and
+   * size share a table */
+  std::map<std::pair<CircuitModelId, size_t>, size_t> decode_table_ids_;
+  std::deque<std::vector<std::vector<bool>>> decode_tables_;
+};
+
+} /* End namespace openfpga*/
+
+#endif
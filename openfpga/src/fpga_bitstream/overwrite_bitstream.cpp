@@ -19,20 +19,30 @@ namespace openfpga {
 /********************************************************************
  * Overwrite bitstream retrieve from bitstream annotation XML which stored in
  *BitstreamSetting
+ * Return the bits being overwritten with their values before, in the order
+ * they are overwritten, so that the bitstream setting can be undone
  *******************************************************************/
-void overwrite_bitstream(openfpga::BitstreamManager& bitstream_manager,
-                         const openfpga::BitstreamSetting& bitstream_setting,
-                         const bool& verbose) {
+std::vector<std::pair<ConfigBitId, bool>> overwrite_bitstream(
+  openfpga::BitstreamManager& bitstream_manager,
+  const openfpga::BitstreamSetting& bitstream_setting, const bool& verbose) {
   vtr::ScopedStartFinishTimer timer("\nOverwrite Bitstream\n");
 
+  std::vector<std::pair<ConfigBitId, bool>> overwritten_bits;
+
   /* Apply overwrite_bitstream bit's path and value */
   for (auto& id : bitstream_setting.overwrite_bitstreams()) {
     std::string path = bitstream_setting.overwrite_bitstream_path(id);
     bool value = bitstream_setting.overwrite_bitstream_value(id);
     VTR_LOGV(verbose, "Overwrite bitstream path='%s' to value='%d'\n",
              path.c_str(), value);
+    ConfigBitId bit = bitstream_manager.find_bit(path);
+    if (bitstream_manager.valid_bit_id(bit)) {
+      overwritten_bits.emplace_back(bit, bitstream_manager.bit_value(bit));
+    }
     bitstream_manager.overwrite_bitstream(path, value);
   }
+
+  return overwritten_bits;
 }
 
 } /* end namespace openfpga */
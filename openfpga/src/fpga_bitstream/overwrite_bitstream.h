@@ -4,6 +4,8 @@
 /********************************************************************
  * Include header files that are required by function declaration
  *******************************************************************/
+#include <utility>
+#include <vector>
 
 #include "openfpga_context.h"
 
@@ -14,9 +16,9 @@
 /* begin namespace openfpga */
 namespace openfpga {
 
-void overwrite_bitstream(openfpga::BitstreamManager& bitstream_manager,
-                         const openfpga::BitstreamSetting& bitstream_setting,
-                         const bool& verbose);
+std::vector<std::pair<ConfigBitId, bool>> overwrite_bitstream(
+  openfpga::BitstreamManager& bitstream_manager,
+  const openfpga::BitstreamSetting& bitstream_setting, const bool& verbose);
 
 } /* end namespace openfpga */
 
@@ -0,0 +1,372 @@
+/********************************************************************
+ * This file includes functions that estimate the number of programming
+ * cycles required to load a fabric bitstream, with and without fast
+ * configuration, and report them per configuration region.
+ *
+ * The estimation follows the same rules as the full testbench, where one
+ * additional cycle is spent on resetting the configuration memories.
+ *******************************************************************/
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+/* Headers from vtrutil library */
+#include "vtr_assert.h"
+#include "vtr_log.h"
+#include "vtr_time.h"
+
+/* Headers from openfpgautil library */
+#include "command_exit_codes.h"
+#include "fabric_bitstream_utils.h"
+#include "fast_configuration.h"
+#include "openfpga_digest.h"
+#include "report_configuration_time.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/********************************************************************
+ * Estimated programming cycles of a fabric bitstream
+ * - The regional numbers count only the cycles to load a region
+ * - The total numbers include the reset cycle. Since regions are programmed
+ *   in parallel, they are limited by the slowest region
+ * - The numbers of WLs are only available for QL memory banks using flatten
+ *   BL/WLs, where fast configuration skips the WLs in 'wls_to_skip'
+ *******************************************************************/
+struct ConfigTimeEstimation {
+  std::vector<size_t> region_cycles;
+  std::vector<size_t> region_fast_cycles;
+  std::vector<size_t> region_wls;
+  std::vector<size_t> region_wls_to_skip;
+  size_t cycles = 0;
+  size_t fast_cycles = 0;
+};
+
+/********************************************************************
+ * Count the addresses which cannot be skipped by fast configuration,
+ * i.e., at least one region has a data input different from the value
+ * to be skipped. Applicable to any bitstream organized by address
+ *******************************************************************/
+template <class T>
+static size_t count_unskippable_addresses(const T& fabric_bits_by_addr,
+                                          const bool& bit_value_to_skip) {
+  size_t num_addrs = 0;
+  for (const auto& addr_din_pair : fabric_bits_by_addr) {
+    for (const bool& bit : addr_din_pair.second) {
+      if (bit_value_to_skip != bit) {
+        num_addrs++;
+        break;
+      }
+    }
+  }
+  return num_addrs;
+}
+
+/********************************************************************
+ * Configuration chains: each bit costs a cycle on each programming clock.
+ * Fast configuration skips the leading bits which are equal to the value
+ * to be skipped; shorter regions are padded to the longest region
+ *******************************************************************/
+static void estimate_configuration_chain_time(
+  ConfigTimeEstimation& estimation, const ConfigProtocol& config_protocol,
+  const bool& bit_value_to_skip, const FabricBitstream& fabric_bitstream) {
+  size_t num_prog_clocks =
+    std::max(size_t(1), config_protocol.num_prog_clocks());
+
+  for (const FabricBitRegionId& region : fabric_bitstream.regions()) {
+    size_t num_bits = fabric_bitstream.region_bits(region).size();
+    size_t num_bits_to_skip =
+      find_configuration_chain_fabric_bitstream_size_to_be_skipped(
+        fabric_bitstream, bit_value_to_skip,
+        std::vector<size_t>{size_t(region)});
+    estimation.region_cycles.push_back(num_prog_clocks * num_bits);
+    estimation.region_fast_cycles.push_back(num_prog_clocks *
+                                            (num_bits - num_bits_to_skip));
+  }
+
+  size_t regional_bitstream_max_size =
+    find_fabric_regional_bitstream_max_size(fabric_bitstream);
+  size_t num_bits_to_skip =
+    find_configuration_chain_fabric_bitstream_size_to_be_skipped(
+      fabric_bitstream, bit_value_to_skip);
+  estimation.cycles = 1 + num_prog_clocks * regional_bitstream_max_size;
+  estimation.fast_cycles =
+    1 + num_prog_clocks * (regional_bitstream_max_size - num_bits_to_skip);
+}
+
+/********************************************************************
+ * Protocols which program one address at a time (memory banks with
+ * decoders and frame-based memories). Regions sharing the same address are
+ * programmed in the same cycle, and fast configuration skips the addresses
+ * whose data inputs of all the regions are equal to the value to be skipped
+ *******************************************************************/
+static void estimate_regional_address_time(
+  ConfigTimeEstimation& estimation, const bool& bit_value_to_skip,
+  const FabricBitstream& fabric_bitstream) {
+  for (const FabricBitRegionId& region : fabric_bitstream.regions()) {
+    size_t num_bits = 0;
+    size_t num_unskippable_bits = 0;
+    for (const FabricBitId& bit_id : fabric_bitstream.region_bits(region)) {
+      num_bits++;
+      if (bit_value_to_skip != fabric_bitstream.bit_din(bit_id)) {
+        num_unskippable_bits++;
+      }
+    }
+    estimation.region_cycles.push_back(num_bits);
+    estimation.region_fast_cycles.push_back(num_unskippable_bits);
+  }
+}
+
+static void estimate_memory_bank_decoder_time(
+  ConfigTimeEstimation& estimation, const bool& bit_value_to_skip,
+  const FabricBitstream& fabric_bitstream) {
+  estimate_regional_address_time(estimation, bit_value_to_skip,
+                                 fabric_bitstream);
+
+  MemoryBankFabricBitstream fabric_bits_by_addr =
+    build_memory_bank_fabric_bitstream_by_address(fabric_bitstream);
+  estimation.cycles = 1 + fabric_bits_by_addr.size();
+  estimation.fast_cycles =
+    1 + count_unskippable_addresses(fabric_bits_by_addr, bit_value_to_skip);
+}
+
+static void estimate_frame_based_time(ConfigTimeEstimation& estimation,
+                                      const bool& bit_value_to_skip,
+                                      const FabricBitstream& fabric_bitstream) {
+  estimate_regional_address_time(estimation, bit_value_to_skip,
+                                 fabric_bitstream);
+
+  FrameFabricBitstream fabric_bits_by_addr =
+    build_frame_based_fabric_bitstream_by_address(fabric_bitstream);
+  estimation.cycles = 1 + fabric_bits_by_addr.size();
+  estimation.fast_cycles =
+    1 + count_unskippable_addresses(fabric_bits_by_addr, bit_value_to_skip);
+}
+
+/********************************************************************
+ * QL memory banks using flatten BL/WLs: a WL is programmed per cycle, while
+ * fast configuration skips the WLs whose BLs are all equal to the value to
+ * be skipped (see 'wls_to_skip' of the memory bank database)
+ *******************************************************************/
+static void estimate_ql_memory_bank_flatten_time(
+  ConfigTimeEstimation& estimation, const bool& bit_value_to_skip,
+  const FabricBitstream& fabric_bitstream) {
+  const FabricBitstreamMemoryBank& memory_bank =
+    fabric_bitstream.memory_bank_info(false, bit_value_to_skip);
+  for (size_t region = 0; region < memory_bank.datas.size(); ++region) {
+    estimation.region_wls.push_back(memory_bank.datas[region].size());
+    estimation.region_cycles.push_back(memory_bank.datas[region].size());
+  }
+  estimation.cycles = 1 + memory_bank.get_longest_effective_wl_count();
+
+  /* Note that the memory bank database is updated in place */
+  fabric_bitstream.memory_bank_info(true, bit_value_to_skip);
+  for (size_t region = 0; region < memory_bank.datas.size(); ++region) {
+    estimation.region_wls_to_skip.push_back(
+      memory_bank.num_wls_to_skip[region]);
+    estimation.region_fast_cycles.push_back(
+      memory_bank.datas[region].size() - memory_bank.num_wls_to_skip[region]);
+  }
+  estimation.fast_cycles = 1 + memory_bank.get_longest_effective_wl_count();
+}
+
+/********************************************************************
+ * QL memory banks using flatten BLs and WLs in shift registers, or BLs in
+ * shift registers: the WL addresses are merged across regions, so that
+ * only the total number of cycles is estimated
+ *******************************************************************/
+static void estimate_ql_memory_bank_merged_time(
+  ConfigTimeEstimation& estimation, const bool& bit_value_to_skip,
+  const FabricBitstream& fabric_bitstream) {
+  estimation.cycles = 1 + build_memory_bank_flatten_fabric_bitstream(
+                            fabric_bitstream, false, bit_value_to_skip)
+                            .size();
+  estimation.fast_cycles = 1 + build_memory_bank_flatten_fabric_bitstream(
+                                 fabric_bitstream, true, bit_value_to_skip)
+                                 .size();
+}
+
+/********************************************************************
+ * Estimate the programming cycles for a given configuration protocol
+ *******************************************************************/
+static int estimate_configuration_time(
+  ConfigTimeEstimation& estimation, const ConfigProtocol& config_protocol,
+  const bool& bit_value_to_skip, const FabricBitstream& fabric_bitstream) {
+  switch (config_protocol.type()) {
+    case CONFIG_MEM_STANDALONE:
+      /* All the configuration memories are loaded in 1 cycle */
+      for (size_t region = 0; region < fabric_bitstream.num_regions();
+           ++region) {
+        estimation.region_cycles.push_back(1);
+        estimation.region_fast_cycles.push_back(1);
+      }
+      estimation.cycles = 2;
+      estimation.fast_cycles = 2;
+      break;
+    case CONFIG_MEM_SCAN_CHAIN:
+      estimate_configuration_chain_time(estimation, config_protocol,
+                                        bit_value_to_skip, fabric_bitstream);
+      break;
+    case CONFIG_MEM_MEMORY_BANK:
+      estimate_memory_bank_decoder_time(estimation, bit_value_to_skip,
+                                        fabric_bitstream);
+      break;
+    case CONFIG_MEM_QL_MEMORY_BANK:
+      if (BLWL_PROTOCOL_DECODER == config_protocol.bl_protocol_type()) {
+        estimate_memory_bank_decoder_time(estimation, bit_value_to_skip,
+                                          fabric_bitstream);
+      } else if (BLWL_PROTOCOL_FLATTEN == config_protocol.bl_protocol_type() &&
+                 BLWL_PROTOCOL_FLATTEN == config_protocol.wl_protocol_type()) {
+        estimate_ql_memory_bank_flatten_time(estimation, bit_value_to_skip,
+                                             fabric_bitstream);
+      } else {
+        estimate_ql_memory_bank_merged_time(estimation, bit_value_to_skip,
+                                            fabric_bitstream);
+      }
+      break;
+    case CONFIG_MEM_FRAME_BASED:
+      estimate_frame_based_time(estimation, bit_value_to_skip,
+                                fabric_bitstream);
+      break;
+    default:
+      VTR_LOG_ERROR("Invalid type of configuration protocol!\n");
+      return CMD_EXEC_FATAL_ERROR;
+  }
+  return CMD_EXEC_SUCCESS;
+}
+
+/********************************************************************
+ * Print the estimation as a table, e.g.,
+ *   Region  Cycles  Fast cycles  WLs  WLs skipped
+ *   0       1024    312          32   22
+ *   ...
+ *   Total   1025    313
+ *******************************************************************/
+static void print_configuration_time(std::ostream& fp,
+                                     const ConfigTimeEstimation& estimation,
+                                     const ConfigProtocol& config_protocol,
+                                     const bool& fast_configuration,
+                                     const bool& bit_value_to_skip) {
+  fp << "Configuration protocol: "
+     << CONFIG_PROTOCOL_TYPE_STRING[config_protocol.type()];
+  if (CONFIG_MEM_QL_MEMORY_BANK == config_protocol.type()) {
+    fp << " (BL: "
+       << BLWL_PROTOCOL_TYPE_STRING[config_protocol.bl_protocol_type()]
+       << ", WL: "
+       << BLWL_PROTOCOL_TYPE_STRING[config_protocol.wl_protocol_type()] << ")";
+  }
+  fp << "\n";
+  if (fast_configuration) {
+    fp << "Fast configuration skips bits of value '" << bit_value_to_skip
+       << "'\n";
+  } else {
+    fp << "Fast configuration is not applicable to the fabric. The numbers "
+          "with fast configuration are given for a reset of the configuration "
+          "memories to '"
+       << bit_value_to_skip << "'\n";
+  }
+
+  bool show_wls = !estimation.region_wls.empty();
+  char line[128];
+  snprintf(line, sizeof(line), "%-8s %12s %12s", "Region", "Cycles",
+           "Fast cycles");
+  fp << line;
+  if (show_wls) {
+    snprintf(line, sizeof(line), " %10s %12s", "WLs", "WLs skipped");
+    fp << line;
+  }
+  fp << "\n";
+
+  for (size_t region = 0; region < estimation.region_cycles.size(); ++region) {
+    snprintf(line, sizeof(line), "%-8lu %12lu %12lu", region,
+             estimation.region_cycles[region],
+             estimation.region_fast_cycles[region]);
+    fp << line;
+    if (show_wls) {
+      snprintf(line, sizeof(line), " %10lu %12lu",
+               estimation.region_wls[region],
+               estimation.region_wls_to_skip[region]);
+      fp << line;
+    }
+    fp << "\n";
+  }
+  if (estimation.region_cycles.empty()) {
+    fp << "(Regional cycles are not available for the protocol, since the "
+          "addresses are merged across regions)\n";
+  }
+
+  snprintf(line, sizeof(line), "%-8s %12lu %12lu", "Total", estimation.cycles,
+           estimation.fast_cycles);
+  fp << line << "\n";
+  fp << "Total cycles include 1 cycle to reset configuration memories\n";
+
+  /* Savings are only meaningful when fast configuration can be used */
+  if (fast_configuration && 0 < estimation.cycles) {
+    fp << "Fast configuration saves "
+       << 100. * (1. - (double)estimation.fast_cycles /
+                         (double)estimation.cycles)
+       << "% of configuration cycles\n";
+  }
+
+  if (fast_configuration && show_wls) {
+    size_t num_wls = 0;
+    size_t num_wls_to_skip = 0;
+    for (size_t region = 0; region < estimation.region_wls.size(); ++region) {
+      num_wls += estimation.region_wls[region];
+      num_wls_to_skip += estimation.region_wls_to_skip[region];
+    }
+    fp << "WLs to skip: " << num_wls_to_skip << " of " << num_wls
+       << " WLs are skipped across regions\n";
+  }
+}
+
+/********************************************************************
+ * Top-level function to estimate and report the programming cycles
+ * The report is always printed to log, and written to a file when the
+ * file name is not empty
+ *******************************************************************/
+int report_configuration_time(const std::string& fname,
+                              const ConfigProtocol& config_protocol,
+                              const FabricGlobalPortInfo& global_ports,
+                              const FabricBitstream& fabric_bitstream,
+                              const bool& verbose) {
+  vtr::ScopedStartFinishTimer timer("Report configuration time");
+
+  bool fast_configuration = is_fast_configuration_applicable(global_ports);
+  bool bit_value_to_skip = false;
+  if (fast_configuration) {
+    bit_value_to_skip = find_bit_value_to_skip_for_fast_configuration(
+      config_protocol.type(), global_ports, fabric_bitstream);
+  }
+
+  ConfigTimeEstimation estimation;
+  if (CMD_EXEC_SUCCESS !=
+      estimate_configuration_time(estimation, config_protocol,
+                                  bit_value_to_skip, fabric_bitstream)) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  VTR_LOGV(verbose, "Estimated programming cycles for %lu regions\n",
+           fabric_bitstream.num_regions());
+
+  std::stringstream report;
+  print_configuration_time(report, estimation, config_protocol,
+                           fast_configuration, bit_value_to_skip);
+  VTR_LOG("%s", report.str().c_str());
+
+  if (fname.empty()) {
+    return CMD_EXEC_SUCCESS;
+  }
+
+  std::fstream fp;
+  fp.open(fname, std::fstream::out | std::fstream::trunc);
+  check_file_stream(fname.c_str(), fp);
+  fp << report.str();
+  fp.close();
+
+  return CMD_EXEC_SUCCESS;
+}
+
+} /* end namespace openfpga */
@@ -0,0 +1,28 @@
+#ifndef REPORT_CONFIGURATION_TIME_H
+#define REPORT_CONFIGURATION_TIME_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include <string>
+
+#include "config_protocol.h"
+#include "fabric_bitstream.h"
+#include "fabric_global_port_info.h"
+
+/********************************************************************
+ * Function declaration
+ *******************************************************************/
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+int report_configuration_time(const std::string& fname,
+                              const ConfigProtocol& config_protocol,
+                              const FabricGlobalPortInfo& global_ports,
+                              const FabricBitstream& fabric_bitstream,
+                              const bool& verbose);
+
+} /* end namespace openfpga */
+
+#endif
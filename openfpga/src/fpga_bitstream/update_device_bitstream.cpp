@@ -0,0 +1,517 @@
+/********************************************************************
+ * This file includes functions to update an existing architecture
+ * bitstream incrementally for a new implementation on the same FPGA
+ * fabric, e.g., a design with a few LUT functions or routed nets changed.
+ *
+ * When a bitstream is built, a digest of the design data is recorded for
+ * each grid (the physical pbs of the clusters placed on it) and for each
+ * GSB (the nets and the previous nodes of its routing tracks and input
+ * pins). On an update, only the grids and GSBs whose digest differs are
+ * rebuilt, into a scratch database, whose bits are then copied to the
+ * blocks with the same names in the existing database.
+ *******************************************************************/
+#include <set>
+#include <string>
+
+/* Headers from vtrutil library */
+#include "vtr_assert.h"
+#include "vtr_log.h"
+#include "vtr_time.h"
+
+/* Headers from openfpgautil library */
+#include "bitstream_manager_utils.h"
+#include "build_grid_bitstream.h"
+#include "build_routing_bitstream.h"
+#include "command_exit_codes.h"
+#include "openfpga_file_cache.h"
+#include "openfpga_naming.h"
+#include "openfpga_side_manager.h"
+#include "physical_pb.h"
+#include "update_device_bitstream.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/********************************************************************
+ * Append a value or a string to the buffer which a digest is computed on
+ *******************************************************************/
+template <typename T>
+static void append_digest_value(std::string& buffer, const T& value) {
+  buffer.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+static void append_digest_string(std::string& buffer, const std::string& str) {
+  buffer += str;
+  buffer.push_back('\0');
+}
+
+/********************************************************************
+ * Nets are identified by their names rather than their ids, so that the
+ * nets which are not touched by a change of the netlist keep their digests
+ *******************************************************************/
+static void append_atom_net_digest(std::string& buffer,
+                                   const AtomContext& atom_ctx,
+                                   const AtomNetId& atom_net) {
+  if (atom_ctx.nlist.valid_net_id(atom_net)) {
+    append_digest_string(buffer, atom_ctx.nlist.net_name(atom_net));
+  } else {
+    buffer.push_back('\0');
+  }
+}
+
+static void append_pb_graph_pins_digest(std::string& buffer,
+                                        const AtomContext& atom_ctx,
+                                        const PhysicalPb& phy_pb,
+                                        const PhysicalPbId& pb,
+                                        t_pb_graph_pin** pins,
+                                        const int& num_ports,
+                                        const int* num_pins) {
+  for (int iport = 0; iport < num_ports; ++iport) {
+    for (int ipin = 0; ipin < num_pins[iport]; ++ipin) {
+      const t_pb_graph_pin* pin = &(pins[iport][ipin]);
+      append_atom_net_digest(buffer, atom_ctx,
+                             phy_pb.pb_graph_pin_atom_net(pb, pin));
+      append_digest_value(buffer, phy_pb.is_wire_lut_output(pb, pin));
+    }
+  }
+}
+
+/********************************************************************
+ * Append all the data of a physical pb which its bitstream is built from
+ *******************************************************************/
+static void append_physical_pb_digest(std::string& buffer,
+                                      const AtomContext& atom_ctx,
+                                      const PhysicalPb& phy_pb) {
+  for (const PhysicalPbId& pb : phy_pb.pbs()) {
+    const t_pb_graph_node* pb_graph_node = phy_pb.pb_graph_node(pb);
+    append_digest_value(buffer, pb_graph_node);
+    append_digest_string(buffer, phy_pb.name(pb));
+
+    std::vector<AtomBlockId> atom_blocks = phy_pb.atom_blocks(pb);
+    append_digest_value(buffer, atom_blocks.size());
+    for (const AtomBlockId& atom_block : atom_blocks) {
+      append_digest_string(buffer, atom_ctx.nlist.block_name(atom_block));
+    }
+
+    std::vector<size_t> mode_bits = phy_pb.mode_bits(pb);
+    append_digest_value(buffer, mode_bits.size());
+    for (const size_t& mode_bit : mode_bits) {
+      append_digest_value(buffer, mode_bit);
+    }
+
+    append_digest_string(buffer, phy_pb.fixed_bitstream(pb));
+    append_digest_value(buffer, phy_pb.fixed_bitstream_offset(pb));
+    append_digest_string(buffer, phy_pb.fixed_mode_select_bitstream(pb));
+    append_digest_value(buffer, phy_pb.fixed_mode_select_bitstream_offset(pb));
+
+    append_digest_value(buffer, phy_pb.truth_tables(pb).size());
+    for (const auto& truth_table : phy_pb.truth_tables(pb)) {
+      append_digest_value(buffer, truth_table.first);
+      append_digest_value(buffer, truth_table.second.size());
+      for (const auto& row : truth_table.second) {
+        append_digest_value(buffer, row.size());
+        for (const vtr::LogicValue& value : row) {
+          append_digest_value(buffer, value);
+        }
+      }
+    }
+
+    if (nullptr == pb_graph_node) {
+      continue;
+    }
+    append_pb_graph_pins_digest(buffer, atom_ctx, phy_pb, pb,
+                                pb_graph_node->input_pins,
+                                pb_graph_node->num_input_ports,
+                                pb_graph_node->num_input_pins);
+    append_pb_graph_pins_digest(buffer, atom_ctx, phy_pb, pb,
+                                pb_graph_node->output_pins,
+                                pb_graph_node->num_output_ports,
+                                pb_graph_node->num_output_pins);
+    append_pb_graph_pins_digest(buffer, atom_ctx, phy_pb, pb,
+                                pb_graph_node->clock_pins,
+                                pb_graph_node->num_clock_ports,
+                                pb_graph_node->num_clock_pins);
+  }
+}
+
+/********************************************************************
+ * Compute the digest of the design data of each grid
+ *******************************************************************/
+static vtr::Matrix<uint64_t> build_grid_design_digests(
+  const VprContext& vpr_ctx, const OpenfpgaContext& openfpga_ctx) {
+  const DeviceGrid& grids = vpr_ctx.device().grid;
+  vtr::Matrix<uint64_t> digests({grids.width(), grids.height()}, 0);
+
+  std::string buffer;
+  for (size_t ix = 0; ix < grids.width(); ++ix) {
+    for (size_t iy = 0; iy < grids.height(); ++iy) {
+      buffer.clear();
+      for (const ClusterBlockId& cluster_block :
+           openfpga_ctx.vpr_placement_annotation().grid_blocks(
+             vtr::Point<size_t>(ix, iy))) {
+        /* Only the content of a cluster matters, not its id */
+        bool placed = (ClusterBlockId::INVALID() != cluster_block);
+        append_digest_value(buffer, placed);
+        if (placed) {
+          append_physical_pb_digest(
+            buffer, vpr_ctx.atom(),
+            openfpga_ctx.vpr_clustering_annotation().physical_pb(
+              cluster_block));
+        }
+      }
+      digests[ix][iy] = file_digest(buffer.data(), buffer.size());
+    }
+  }
+
+  return digests;
+}
+
+/********************************************************************
+ * Append the routing data of a node, i.e., its net and previous node, or
+ * only its net when the node drives a routing multiplexer
+ *******************************************************************/
+static void append_rr_node_net_digest(
+  std::string& buffer, const AtomContext& atom_ctx,
+  const VprRoutingAnnotation& routing_annotation, const RRNodeId& rr_node) {
+  ClusterNetId net = routing_annotation.rr_node_net(rr_node);
+  append_digest_value(buffer, ClusterNetId::INVALID() != net);
+  append_atom_net_digest(buffer, atom_ctx, atom_ctx.lookup.atom_net(net));
+}
+
+static void append_rr_node_digest(
+  std::string& buffer, const AtomContext& atom_ctx,
+  const VprRoutingAnnotation& routing_annotation, const RRGraphView& rr_graph,
+  const RRNodeId& rr_node, const std::vector<RREdgeId>& driver_rr_edges) {
+  append_digest_value(buffer,
+                      size_t(routing_annotation.rr_node_prev_node(rr_node)));
+  append_rr_node_net_digest(buffer, atom_ctx, routing_annotation, rr_node);
+  for (const RREdgeId& edge : driver_rr_edges) {
+    append_rr_node_net_digest(buffer, atom_ctx, routing_annotation,
+                              rr_graph.edge_src_node(edge));
+  }
+}
+
+/********************************************************************
+ * Compute the digest of the routing data of each GSB, which covers the
+ * multiplexers of its switch block and connection blocks
+ *******************************************************************/
+static vtr::Matrix<uint64_t> build_gsb_design_digests(
+  const VprContext& vpr_ctx, const OpenfpgaContext& openfpga_ctx) {
+  const RRGraphView& rr_graph = vpr_ctx.device().rr_graph;
+  const DeviceRRGSB& device_rr_gsb = openfpga_ctx.device_rr_gsb();
+  const VprRoutingAnnotation& routing_annotation =
+    openfpga_ctx.vpr_routing_annotation();
+  vtr::Point<size_t> gsb_range = device_rr_gsb.get_gsb_range();
+  vtr::Matrix<uint64_t> digests({gsb_range.x(), gsb_range.y()}, 0);
+
+  std::string buffer;
+  for (size_t ix = 0; ix < gsb_range.x(); ++ix) {
+    for (size_t iy = 0; iy < gsb_range.y(); ++iy) {
+      const RRGSB& rr_gsb = device_rr_gsb.get_gsb(ix, iy);
+      buffer.clear();
+      for (size_t side = 0; side < rr_gsb.get_num_sides(); ++side) {
+        SideManager side_manager(side);
+        e_side gsb_side = side_manager.get_side();
+        for (size_t itrack = 0; itrack < rr_gsb.get_chan_width(gsb_side);
+             ++itrack) {
+          /* Only output port indicates a routing multiplexer */
+          if (OUT_PORT != rr_gsb.get_chan_node_direction(gsb_side, itrack)) {
+            continue;
+          }
+          append_rr_node_digest(
+            buffer, vpr_ctx.atom(), routing_annotation, rr_graph,
+            rr_gsb.get_chan_node(gsb_side, itrack),
+            rr_gsb.get_chan_node_in_edges(rr_graph, gsb_side, itrack));
+        }
+        for (size_t inode = 0; inode < rr_gsb.get_num_ipin_nodes(gsb_side);
+             ++inode) {
+          append_rr_node_digest(
+            buffer, vpr_ctx.atom(), routing_annotation, rr_graph,
+            rr_gsb.get_ipin_node(gsb_side, inode),
+            rr_gsb.get_ipin_node_in_edges(rr_graph, gsb_side, inode));
+        }
+      }
+      digests[ix][iy] = file_digest(buffer.data(), buffer.size());
+    }
+  }
+
+  return digests;
+}
+
+/********************************************************************
+ * Record the digests of the design data which a bitstream database has
+ * been built from, so that it can be updated incrementally later
+ *******************************************************************/
+void record_device_bitstream_digest(DeviceBitstreamDigest& bitstream_digest,
+                                    const BitstreamManager& bitstream_manager,
+                                    const VprContext& vpr_ctx,
+                                    const OpenfpgaContext& openfpga_ctx) {
+  vtr::ScopedStartFinishTimer timer("Record digests of implementation");
+
+  bitstream_digest.set_digests(
+    bitstream_manager, build_grid_design_digests(vpr_ctx, openfpga_ctx),
+    build_gsb_design_digests(vpr_ctx, openfpga_ctx));
+}
+
+static bool same_matrix_size(const vtr::Matrix<uint64_t>& a,
+                             const vtr::Matrix<uint64_t>& b) {
+  return a.dim_size(0) == b.dim_size(0) && a.dim_size(1) == b.dim_size(1);
+}
+
+/********************************************************************
+ * Find the coordinates where the digests differ
+ *******************************************************************/
+static std::set<vtr::Point<size_t>> find_changed_coordinates(
+  const vtr::Matrix<uint64_t>& prev_digests,
+  const vtr::Matrix<uint64_t>& curr_digests) {
+  std::set<vtr::Point<size_t>> coords;
+  for (size_t ix = 0; ix < curr_digests.dim_size(0); ++ix) {
+    for (size_t iy = 0; iy < curr_digests.dim_size(1); ++iy) {
+      if (prev_digests[ix][iy] != curr_digests[ix][iy]) {
+        coords.insert(vtr::Point<size_t>(ix, iy));
+      }
+    }
+  }
+  return coords;
+}
+
+/********************************************************************
+ * Find the block under which the grids and routing blocks are built,
+ * which is the top-level block, or the core block when an fpga_core
+ * wrapper is added. See build_device_bitstream() for details
+ *******************************************************************/
+static ConfigBlockId find_fabric_block(
+  const BitstreamManager& bitstream_manager,
+  const OpenfpgaContext& openfpga_ctx) {
+  std::string top_block_name =
+    openfpga_ctx.module_name_map().name(generate_fpga_top_module_name());
+  /* The top-level block is always the first block being built */
+  ConfigBlockId top_block = ConfigBlockId(0);
+  if (!bitstream_manager.valid_block_id(top_block) ||
+      top_block_name != bitstream_manager.block_name(top_block)) {
+    return ConfigBlockId::INVALID();
+  }
+
+  std::string core_block_name = generate_fpga_core_module_name();
+  if (openfpga_ctx.module_name_map().name_exist(core_block_name)) {
+    core_block_name = openfpga_ctx.module_name_map().name(core_block_name);
+  }
+  const ModuleId& core_module =
+    openfpga_ctx.module_graph().find_module(core_block_name);
+  if (!openfpga_ctx.module_graph().valid_module_id(core_module)) {
+    return top_block;
+  }
+  ModuleId top_module = openfpga_ctx.module_graph().find_module(top_block_name);
+  return bitstream_manager.find_child_block(
+    top_block,
+    openfpga_ctx.module_graph().instance_name(top_module, core_module, 0));
+}
+
+/********************************************************************
+ * Copy the bits and the path/net annotations of a block and all its child
+ * blocks from a scratch database to the block with the same hierarchy in
+ * the existing database. Return the number of bits whose values change
+ *******************************************************************/
+static size_t rec_copy_bitstream_block(
+  BitstreamManager& bitstream_manager, const ConfigBlockId& block,
+  const BitstreamManager& src_bitstream_manager,
+  const ConfigBlockId& src_block, DeviceBitstreamDigest& bitstream_digest,
+  std::set<ConfigBlockId>& touched_blocks) {
+  bitstream_manager.add_path_id_to_block(
+    block, src_bitstream_manager.block_path_id(src_block));
+  bitstream_manager.add_input_net_id_to_block(
+    block, src_bitstream_manager.block_input_net_ids(src_block));
+  bitstream_manager.add_output_net_id_to_block(
+    block, src_bitstream_manager.block_output_net_ids(src_block));
+
+  size_t num_changed_bits = 0;
+  std::vector<ConfigBitId> bits = bitstream_manager.block_bits(block);
+  std::vector<ConfigBitId> src_bits =
+    src_bitstream_manager.block_bits(src_block);
+  VTR_ASSERT(bits.size() == src_bits.size());
+  for (size_t ibit = 0; ibit < bits.size(); ++ibit) {
+    bool value = src_bitstream_manager.bit_value(src_bits[ibit]);
+    if (value == bitstream_manager.bit_value(bits[ibit])) {
+      continue;
+    }
+    bitstream_manager.set_bit_value(bits[ibit], value);
+    bitstream_digest.add_changed_bit(bits[ibit]);
+    touched_blocks.insert(block);
+    num_changed_bits++;
+  }
+
+  for (const ConfigBlockId& src_child :
+       src_bitstream_manager.block_children(src_block)) {
+    ConfigBlockId child = bitstream_manager.find_child_block(
+      block, src_bitstream_manager.block_name(src_child));
+    VTR_ASSERT(bitstream_manager.valid_block_id(child));
+    num_changed_bits +=
+      rec_copy_bitstream_block(bitstream_manager, child, src_bitstream_manager,
+                               src_child, bitstream_digest, touched_blocks);
+  }
+
+  return num_changed_bits;
+}
+
+/********************************************************************
+ * Update an architecture bitstream for the current implementation by
+ * rebuilding only the grids and GSBs whose design data differ from the
+ * ones recorded when the bitstream was built. The bits overwritten by the
+ * bitstream setting of the previous run are restored as well, so that the
+ * bitstream setting can be applied again.
+ * All the bits which are changed are recorded, so that the fabric
+ * bitstream can be patched on them only.
+ *******************************************************************/
+int update_device_bitstream(BitstreamManager& bitstream_manager,
+                            DeviceBitstreamDigest& bitstream_digest,
+                            const VprContext& vpr_ctx,
+                            const OpenfpgaContext& openfpga_ctx,
+                            const bool& verbose) {
+  std::string timer_message =
+    std::string("\nUpdate fabric-independent bitstream for implementation '") +
+    vpr_ctx.atom().nlist.netlist_name() + std::string("'\n");
+  vtr::ScopedStartFinishTimer timer(timer_message);
+
+  ConfigBlockId fabric_block =
+    find_fabric_block(bitstream_manager, openfpga_ctx);
+  if (!bitstream_digest.valid(bitstream_manager) ||
+      !bitstream_manager.valid_block_id(fabric_block)) {
+    VTR_LOG_ERROR(
+      "Architecture bitstream was not built for the current fabric! Unable "
+      "to update it incrementally.\n");
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  vtr::Matrix<uint64_t> grid_digests =
+    build_grid_design_digests(vpr_ctx, openfpga_ctx);
+  vtr::Matrix<uint64_t> gsb_digests =
+    build_gsb_design_digests(vpr_ctx, openfpga_ctx);
+  if (!same_matrix_size(grid_digests, bitstream_digest.grid_digests()) ||
+      !same_matrix_size(gsb_digests, bitstream_digest.gsb_digests())) {
+    VTR_LOG_ERROR(
+      "Device has changed since the architecture bitstream was built! Unable "
+      "to update it incrementally.\n");
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  /* Restore the bits overwritten by the previous run in reverse order, in
+   * case that a bit is overwritten more than once */
+  const std::vector<std::pair<ConfigBitId, bool>>& overwritten_bits =
+    bitstream_digest.overwritten_bits();
+  for (auto it = overwritten_bits.rbegin(); it != overwritten_bits.rend();
+       ++it) {
+    bitstream_manager.set_bit_value(it->first, it->second);
+    bitstream_digest.add_changed_bit(it->first);
+  }
+  bitstream_digest.set_overwritten_bits(
+    std::vector<std::pair<ConfigBitId, bool>>());
+
+  std::set<vtr::Point<size_t>> grid_coords =
+    find_changed_coordinates(bitstream_digest.grid_digests(), grid_digests);
+  std::set<vtr::Point<size_t>> gsb_coords =
+    find_changed_coordinates(bitstream_digest.gsb_digests(), gsb_digests);
+
+  /* Rebuild the changed blocks in a scratch database under a block of the
+   * same name as the existing one */
+  BitstreamManager scratch_bitstream_manager;
+  ConfigBlockId scratch_block = scratch_bitstream_manager.add_block(
+    bitstream_manager.block_name(fabric_block));
+  if (!grid_coords.empty()) {
+    build_grid_bitstream(
+      scratch_bitstream_manager, scratch_block, openfpga_ctx.module_graph(),
+      openfpga_ctx.module_name_map(), openfpga_ctx.fabric_tile(),
+      openfpga_ctx.arch().circuit_lib, openfpga_ctx.mux_lib(),
+      vpr_ctx.device().grid, 0, vpr_ctx.atom(),
+      openfpga_ctx.vpr_device_annotation(),
+      openfpga_ctx.vpr_clustering_annotation(),
+      openfpga_ctx.vpr_placement_annotation(),
+      openfpga_ctx.vpr_bitstream_annotation(), grid_coords, false);
+  }
+  if (!gsb_coords.empty()) {
+    build_routing_bitstream(
+      scratch_bitstream_manager, scratch_block, openfpga_ctx.module_graph(),
+      openfpga_ctx.module_name_map(), openfpga_ctx.fabric_tile(),
+      openfpga_ctx.arch().circuit_lib, openfpga_ctx.mux_lib(), vpr_ctx.atom(),
+      openfpga_ctx.vpr_device_annotation(),
+      openfpga_ctx.vpr_routing_annotation(), vpr_ctx.device().rr_graph,
+      openfpga_ctx.device_rr_gsb(),
+      openfpga_ctx.flow_manager().compress_routing(), gsb_coords, false);
+  }
+
+  std::set<ConfigBlockId> touched_blocks;
+  size_t num_changed_bits = rec_copy_bitstream_block(
+    bitstream_manager, fabric_block, scratch_bitstream_manager, scratch_block,
+    bitstream_digest, touched_blocks);
+
+  bitstream_digest.set_digests(bitstream_manager, grid_digests, gsb_digests);
+
+  VTR_LOG(
+    "Rebuilt %lu grids and %lu GSBs, where %lu of %lu configuration bits "
+    "changed in %lu blocks\n",
+    grid_coords.size(), gsb_coords.size(), num_changed_bits,
+    scratch_bitstream_manager.num_bits(), touched_blocks.size());
+
+  if (verbose) {
+    for (const vtr::Point<size_t>& coord : grid_coords) {
+      VTR_LOG("\tRebuilt grid[%lu][%lu]\n", coord.x(), coord.y());
+    }
+    for (const vtr::Point<size_t>& coord : gsb_coords) {
+      VTR_LOG("\tRebuilt GSB[%lu][%lu]\n", coord.x(), coord.y());
+    }
+    for (const ConfigBlockId& block : touched_blocks) {
+      VTR_LOG("\tTouched block '%s'\n",
+              find_bitstream_manager_block_hierarchy_name(bitstream_manager,
+                                                          block)
+                .c_str());
+    }
+  }
+
+  return CMD_EXEC_SUCCESS;
+}
+
+/********************************************************************
+ * Compare an architecture bitstream to a reference, which is typically
+ * built from scratch. Both should be built for the same fabric, so that
+ * their bits can be compared one by one
+ *******************************************************************/
+int verify_device_bitstream(const BitstreamManager& bitstream_manager,
+                            const BitstreamManager& ref_bitstream_manager,
+                            const bool& verbose) {
+  vtr::ScopedStartFinishTimer timer("Verify fabric-independent bitstream");
+
+  if (bitstream_manager.num_bits() != ref_bitstream_manager.num_bits() ||
+      bitstream_manager.num_blocks() != ref_bitstream_manager.num_blocks()) {
+    VTR_LOG_ERROR(
+      "Architecture bitstream has %lu bits in %lu blocks while the reference "
+      "has %lu bits in %lu blocks!\n",
+      bitstream_manager.num_bits(), bitstream_manager.num_blocks(),
+      ref_bitstream_manager.num_bits(), ref_bitstream_manager.num_blocks());
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  size_t num_mismatches = 0;
+  for (const ConfigBitId& bit : bitstream_manager.bits()) {
+    if (bitstream_manager.bit_value(bit) ==
+        ref_bitstream_manager.bit_value(bit)) {
+      continue;
+    }
+    VTR_LOGV(verbose, "\tMismatch on bit %lu of block '%s'\n", size_t(bit),
+             find_bitstream_manager_block_hierarchy_name(
+               bitstream_manager, bitstream_manager.bit_parent_block(bit))
+               .c_str());
+    num_mismatches++;
+  }
+
+  if (0 < num_mismatches) {
+    VTR_LOG_ERROR(
+      "Found %lu mismatches against the reference architecture bitstream!\n",
+      num_mismatches);
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  VTR_LOG("Architecture bitstream matches the reference bitstream\n");
+
+  return CMD_EXEC_SUCCESS;
+}
+
+} /* end namespace openfpga */
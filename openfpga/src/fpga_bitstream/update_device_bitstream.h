@@ -0,0 +1,39 @@
+#ifndef UPDATE_DEVICE_BITSTREAM_H
+#define UPDATE_DEVICE_BITSTREAM_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include <utility>
+#include <vector>
+
+#include "bitstream_manager.h"
+#include "device_bitstream_digest.h"
+#include "openfpga_context.h"
+#include "vpr_context.h"
+
+/********************************************************************
+ * Function declaration
+ *******************************************************************/
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+void record_device_bitstream_digest(DeviceBitstreamDigest& bitstream_digest,
+                                    const BitstreamManager& bitstream_manager,
+                                    const VprContext& vpr_ctx,
+                                    const OpenfpgaContext& openfpga_ctx);
+
+int update_device_bitstream(BitstreamManager& bitstream_manager,
+                            DeviceBitstreamDigest& bitstream_digest,
+                            const VprContext& vpr_ctx,
+                            const OpenfpgaContext& openfpga_ctx,
+                            const bool& verbose);
+
+int verify_device_bitstream(const BitstreamManager& bitstream_manager,
+                            const BitstreamManager& ref_bitstream_manager,
+                            const bool& verbose);
+
+} /* end namespace openfpga */
+
+#endif
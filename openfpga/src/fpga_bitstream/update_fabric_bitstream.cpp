@@ -0,0 +1,175 @@
+/********************************************************************
+ * This file includes functions to update an existing fabric bitstream
+ * incrementally when the architecture bitstream is updated for a design
+ * with small changes (e.g., a few LUT functions or routed nets), on the
+ * same FPGA fabric.
+ *
+ * The addresses of configuration bits depend only on the fabric, so that
+ * they are kept as they are. Only the values of the bits changed in the
+ * architecture bitstream since the fabric bitstream was last built are
+ * patched.
+ *******************************************************************/
+#include <algorithm>
+#include <set>
+#include <string>
+#include <vector>
+
+/* Headers from vtrutil library */
+#include "vtr_assert.h"
+#include "vtr_log.h"
+#include "vtr_time.h"
+
+/* Headers from openfpgautil library */
+#include "bitstream_manager_utils.h"
+#include "command_exit_codes.h"
+#include "update_fabric_bitstream.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/********************************************************************
+ * A fabric bitstream can be updated only when it has been built from an
+ * architecture bitstream database with exactly the same blocks and bits,
+ * so that each fabric bit still refers to the same configuration memory.
+ * Since the architecture bitstream database is organized by the module
+ * graph, this is true as long as the fabric is not changed.
+ *******************************************************************/
+bool fabric_bitstream_updatable(const FabricBitstream& fabric_bitstream,
+                                const BitstreamManager& bitstream_manager) {
+  if (0 == fabric_bitstream.num_bits()) {
+    return false;
+  }
+  if (fabric_bitstream.num_bits() != bitstream_manager.num_bits()) {
+    return false;
+  }
+  return fabric_bitstream.arch_bitstream_digest() ==
+         bitstream_manager_structure_digest(bitstream_manager);
+}
+
+/********************************************************************
+ * Patch the values of the bits in a fabric bitstream which are changed in
+ * the architecture bitstream database, and report the blocks being touched.
+ * When the changed bits are unknown, e.g., the architecture bitstream is
+ * built from scratch, all the bits are compared.
+ *******************************************************************/
+int update_fabric_bitstream(FabricBitstream& fabric_bitstream,
+                            const BitstreamManager& bitstream_manager,
+                            const DeviceBitstreamDigest& bitstream_digest,
+                            const bool& verbose) {
+  vtr::ScopedStartFinishTimer timer("\nUpdate fabric dependent bitstream\n");
+
+  std::vector<FabricBitId> fabric_bits_to_check;
+  if (bitstream_digest.all_bits_changed()) {
+    if (!fabric_bitstream_updatable(fabric_bitstream, bitstream_manager)) {
+      VTR_LOG_ERROR(
+        "Fabric bitstream does not match the architecture bitstream! Unable "
+        "to update it incrementally.\n");
+      return CMD_EXEC_FATAL_ERROR;
+    }
+    fabric_bits_to_check.reserve(fabric_bitstream.num_bits());
+    for (const FabricBitId& fabric_bit : fabric_bitstream.bits()) {
+      fabric_bits_to_check.push_back(fabric_bit);
+    }
+  } else {
+    /* The architecture bitstream is updated in place since the fabric
+     * bitstream was built, so that its structure is the same */
+    for (const ConfigBitId& config_bit : bitstream_digest.changed_bits()) {
+      FabricBitId fabric_bit = fabric_bitstream.find_fabric_bit(config_bit);
+      VTR_ASSERT(fabric_bitstream.valid_bit_id(fabric_bit));
+      fabric_bits_to_check.push_back(fabric_bit);
+    }
+  }
+
+  size_t num_changed_bits = 0;
+  std::set<ConfigBlockId> touched_blocks;
+  for (const FabricBitId& fabric_bit : fabric_bits_to_check) {
+    const ConfigBitId& config_bit = fabric_bitstream.config_bit(fabric_bit);
+    bool new_value = bitstream_manager.bit_value(config_bit);
+    if (new_value == fabric_bitstream.bit_value(fabric_bit)) {
+      continue;
+    }
+    fabric_bitstream.set_bit_value(fabric_bit, new_value);
+    touched_blocks.insert(bitstream_manager.bit_parent_block(config_bit));
+    num_changed_bits++;
+  }
+
+  VTR_LOG("Checked %lu and updated %lu of %lu configuration bits in %lu "
+          "blocks\n",
+          fabric_bits_to_check.size(), num_changed_bits,
+          fabric_bitstream.num_bits(), touched_blocks.size());
+
+  if (verbose) {
+    for (const ConfigBlockId& block : touched_blocks) {
+      VTR_LOG("\tTouched block '%s'\n",
+              find_bitstream_manager_block_hierarchy_name(bitstream_manager,
+                                                          block)
+                .c_str());
+    }
+  }
+
+  return CMD_EXEC_SUCCESS;
+}
+
+/********************************************************************
+ * Compare a fabric bitstream to a reference, which is typically built from
+ * scratch, bit by bit. Any difference in sequence, address or value of the
+ * bits is reported.
+ *******************************************************************/
+int verify_fabric_bitstream(const FabricBitstream& fabric_bitstream,
+                            const FabricBitstream& ref_fabric_bitstream,
+                            const bool& verbose) {
+  vtr::ScopedStartFinishTimer timer("Verify fabric dependent bitstream");
+
+  if (fabric_bitstream.num_bits() != ref_fabric_bitstream.num_bits() ||
+      fabric_bitstream.use_address() != ref_fabric_bitstream.use_address() ||
+      fabric_bitstream.use_wl_address() !=
+        ref_fabric_bitstream.use_wl_address()) {
+    VTR_LOG_ERROR(
+      "Fabric bitstream has %lu bits while the reference has %lu bits!\n",
+      fabric_bitstream.num_bits(), ref_fabric_bitstream.num_bits());
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  size_t num_mismatches = 0;
+  for (const FabricBitId& fabric_bit : fabric_bitstream.bits()) {
+    bool match =
+      fabric_bitstream.config_bit(fabric_bit) ==
+        ref_fabric_bitstream.config_bit(fabric_bit) &&
+      fabric_bitstream.bit_value(fabric_bit) ==
+        ref_fabric_bitstream.bit_value(fabric_bit);
+    if (match && fabric_bitstream.use_address()) {
+      match = fabric_bitstream.bit_din(fabric_bit) ==
+                ref_fabric_bitstream.bit_din(fabric_bit) &&
+              fabric_bitstream.bit_address(fabric_bit) ==
+                ref_fabric_bitstream.bit_address(fabric_bit);
+    }
+    if (match && fabric_bitstream.use_wl_address()) {
+      match = fabric_bitstream.bit_wl_address(fabric_bit) ==
+              ref_fabric_bitstream.bit_wl_address(fabric_bit);
+    }
+    if (!match) {
+      VTR_LOGV(verbose, "\tMismatch on fabric bit %lu\n", size_t(fabric_bit));
+      num_mismatches++;
+    }
+  }
+
+  /* The compact memory bank data is used by the bitstream writers */
+  if (fabric_bitstream.use_wl_address() &&
+      fabric_bitstream.memory_bank_info().datas !=
+        ref_fabric_bitstream.memory_bank_info().datas) {
+    VTR_LOG_ERROR("Memory bank data mismatches the reference!\n");
+    num_mismatches++;
+  }
+
+  if (0 < num_mismatches) {
+    VTR_LOG_ERROR("Found %lu mismatches against the reference bitstream!\n",
+                  num_mismatches);
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  VTR_LOG("Fabric bitstream matches the reference bitstream\n");
+
+  return CMD_EXEC_SUCCESS;
+}
+
+} /* end namespace openfpga */
@@ -0,0 +1,32 @@
+#ifndef UPDATE_FABRIC_BITSTREAM_H
+#define UPDATE_FABRIC_BITSTREAM_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include "bitstream_manager.h"
+#include "device_bitstream_digest.h"
+#include "fabric_bitstream.h"
+
+/********************************************************************
+ * Function declaration
+ *******************************************************************/
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+bool fabric_bitstream_updatable(const FabricBitstream& fabric_bitstream,
+                                const BitstreamManager& bitstream_manager);
+
+int update_fabric_bitstream(FabricBitstream& fabric_bitstream,
+                            const BitstreamManager& bitstream_manager,
+                            const DeviceBitstreamDigest& bitstream_digest,
+                            const bool& verbose);
+
+int verify_fabric_bitstream(const FabricBitstream& fabric_bitstream,
+                            const FabricBitstream& ref_fabric_bitstream,
+                            const bool& verbose);
+
+} /* end namespace openfpga */
+
+#endif
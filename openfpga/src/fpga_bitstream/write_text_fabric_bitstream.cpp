@@ -2,9 +2,12 @@
  * This file includes functions that output a fabric-dependent
  * bitstream database to files in plain text
  *******************************************************************/
+#include <algorithm>
+#include <array>
 #include <chrono>
 #include <ctime>
 #include <fstream>
+#include <string>
 
 /* Headers from vtrutil library */
 #include "vtr_assert.h"
@@ -42,8 +45,65 @@ static void write_fabric_bitstream_text_file_head(
   }
 }
 
+/********************************************************************
+ * Write a line of bitstream, which consists of characters '0', '1' and 'x',
+ * to a plain text file, without any line break.
+ * In hexadecimal format, the line is padded with '0' on the MSB side (the
+ * beginning of the line) to a multiple of 4 bits, so that $readmemh loads the
+ * same value as $readmemb does for the line in binary format.
+ * A hexadecimal digit is 'x' only when all its 4 bits are don't care bits.
+ * Otherwise, don't care bits are considered as '0'.
+ *******************************************************************/
+static void write_fabric_bitstream_text_line(std::fstream& fp,
+                                             const char* bits,
+                                             const size_t& num_bits,
+                                             const bool& hex) {
+  if (!hex) {
+    fp.write(bits, num_bits);
+    return;
+  }
+  const char* HEX_CHARS = "0123456789abcdef";
+  size_t num_pads = (4 - num_bits % 4) % 4;
+  std::string hex_line((num_bits + num_pads) / 4, '0');
+  size_t ibit = 0;
+  for (char& hex_char : hex_line) {
+    size_t hex_value = 0;
+    size_t num_dont_cares = 0;
+    for (size_t inibble = 0; inibble < 4; ++inibble) {
+      hex_value <<= 1;
+      if (0 < num_pads) {
+        num_pads--;
+        continue;
+      }
+      if ('1' == bits[ibit]) {
+        hex_value |= 1;
+      } else if ('0' != bits[ibit]) {
+        num_dont_cares++;
+      }
+      ibit++;
+    }
+    hex_char = (4 == num_dont_cares) ? 'x' : HEX_CHARS[hex_value];
+  }
+  fp.write(hex_line.data(), hex_line.size());
+}
+
+static void write_fabric_bitstream_text_line(std::fstream& fp,
+                                             const std::string& bits,
+                                             const bool& hex) {
+  write_fabric_bitstream_text_line(fp, bits.data(), bits.size(), hex);
+}
+
+/* Number of bits of a flatten bitstream which are buffered before being
+ * written. It is a multiple of 4, so that a chunk is converted to complete
+ * hexadecimal digits without any padding */
+constexpr size_t FLATTEN_BITSTREAM_CHUNK_SIZE = 64 * 1024;
+
 /********************************************************************
  * Write the flatten fabric bitstream to a plain text file
+ * The bitstream is a single line, which is written in fixed-size chunks,
+ * so that memory usage does not depend on the bitstream size. The first
+ * chunk takes the remainder of the bits, so that only the beginning of the
+ * line is padded in hexadecimal format.
  *
  * Return:
  *  - 0 if succeed
@@ -51,7 +111,7 @@ static void write_fabric_bitstream_text_file_head(
  *******************************************************************/
 static int write_flatten_fabric_bitstream_to_text_file(
   std::fstream& fp, const BitstreamManager& bitstream_manager,
-  const FabricBitstream& fabric_bitstream) {
+  const FabricBitstream& fabric_bitstream, const bool& hex) {
   if (false == valid_file_stream(fp)) {
     return 1;
   }
@@ -60,8 +120,24 @@ static int write_flatten_fabric_bitstream_to_text_file(
   fp << "// Bitstream length: " << fabric_bitstream.num_bits() << std::endl;
 
   /* Output bitstream data */
+  size_t chunk_size =
+    fabric_bitstream.num_bits() % FLATTEN_BITSTREAM_CHUNK_SIZE;
+  if (0 == chunk_size) {
+    chunk_size = FLATTEN_BITSTREAM_CHUNK_SIZE;
+  }
+  std::string chunk;
+  chunk.reserve(std::min(fabric_bitstream.num_bits(),
+                         FLATTEN_BITSTREAM_CHUNK_SIZE));
   for (const FabricBitId& fabric_bit : fabric_bitstream.bits()) {
-    fp << bitstream_manager.bit_value(fabric_bitstream.config_bit(fabric_bit));
+    chunk.push_back(
+      bitstream_manager.bit_value(fabric_bitstream.config_bit(fabric_bit))
+        ? '1'
+        : '0');
+    if (chunk_size == chunk.size()) {
+      write_fabric_bitstream_text_line(fp, chunk, hex);
+      chunk.clear();
+      chunk_size = FLATTEN_BITSTREAM_CHUNK_SIZE;
+    }
   }
 
   return 0;
@@ -78,7 +154,7 @@ static int write_flatten_fabric_bitstream_to_text_file(
 static int write_config_chain_fabric_bitstream_to_text_file(
   std::fstream& fp, const bool& fast_configuration,
   const bool& bit_value_to_skip, const BitstreamManager& bitstream_manager,
-  const FabricBitstream& fabric_bitstream) {
+  const FabricBitstream& fabric_bitstream, const bool& hex) {
   int status = 0;
 
   size_t regional_bitstream_max_size =
@@ -92,7 +168,7 @@ static int write_config_chain_fabric_bitstream_to_text_file(
   if (true == fast_configuration) {
     num_bits_to_skip =
       find_configuration_chain_fabric_bitstream_size_to_be_skipped(
-        fabric_bitstream, bitstream_manager, bit_value_to_skip);
+        fabric_bitstream, bit_value_to_skip);
     VTR_ASSERT(num_bits_to_skip < regional_bitstream_max_size);
     VTR_LOG(
       "Fast configuration will skip %g% (%lu/%lu) of configuration "
@@ -108,11 +184,13 @@ static int write_config_chain_fabric_bitstream_to_text_file(
      << std::endl;
 
   /* Output bitstream data */
+  std::string line(regional_bitstreams.size(), '0');
   for (size_t ibit = num_bits_to_skip; ibit < regional_bitstream_max_size;
        ++ibit) {
-    for (const auto& region_bitstream : regional_bitstreams) {
-      fp << region_bitstream[ibit];
+    for (size_t iregion = 0; iregion < regional_bitstreams.size(); ++iregion) {
+      line[iregion] = regional_bitstreams[iregion][ibit] ? '1' : '0';
     }
+    write_fabric_bitstream_text_line(fp, line, hex);
     if (ibit < regional_bitstream_max_size - 1) {
       fp << std::endl;
     }
@@ -131,7 +209,8 @@ static int write_config_chain_fabric_bitstream_to_text_file(
  *******************************************************************/
 static int write_memory_bank_fabric_bitstream_to_text_file(
   std::fstream& fp, const bool& fast_configuration,
-  const bool& bit_value_to_skip, const FabricBitstream& fabric_bitstream) {
+  const bool& bit_value_to_skip, const FabricBitstream& fabric_bitstream,
+  const bool& hex) {
   int status = 0;
 
   MemoryBankFabricBitstream fabric_bits_by_addr =
@@ -168,6 +247,7 @@ static int write_memory_bank_fabric_bitstream_to_text_file(
   fp << "<data input " << din_size << " bits>";
   fp << std::endl;
 
+  std::string line;
   for (const auto& addr_din_pair : fabric_bits_by_addr) {
     /* When fast configuration is enabled,
      * the rule to skip any configuration bit should consider the whole data
@@ -182,13 +262,14 @@ static int write_memory_bank_fabric_bitstream_to_text_file(
     }
 
     /* Write BL address code */
-    fp << addr_din_pair.first.first;
+    line = addr_din_pair.first.first;
     /* Write WL address code */
-    fp << addr_din_pair.first.second;
+    line += addr_din_pair.first.second;
     /* Write data input */
     for (const bool& din_value : addr_din_pair.second) {
-      fp << din_value;
+      line.push_back(din_value ? '1' : '0');
     }
+    write_fabric_bitstream_text_line(fp, line, hex);
     fp << std::endl;
   }
 
@@ -206,7 +287,7 @@ static int write_memory_bank_fabric_bitstream_to_text_file(
 static int write_memory_bank_flatten_fabric_bitstream_to_text_file(
   std::fstream& fp, const bool& fast_configuration,
   const bool& bit_value_to_skip, const FabricBitstream& fabric_bitstream,
-  const bool& keep_dont_care_bits) {
+  const bool& keep_dont_care_bits, const bool& hex) {
   int status = 0;
 
   char dont_care_bit = '0';
@@ -230,15 +311,18 @@ static int write_memory_bank_flatten_fabric_bitstream_to_text_file(
   fp << "<wl_address " << wl_addr_size << " bits>";
   fp << std::endl;
 
+  std::string line;
   for (const auto& wl_vec : fabric_bits.wl_vectors()) {
+    line.clear();
     /* Write BL address code */
     for (const auto& bl_unit : fabric_bits.bl_vector(wl_vec)) {
-      fp << bl_unit;
+      line += bl_unit;
     }
     /* Write WL address code */
     for (const auto& wl_unit : wl_vec) {
-      fp << wl_unit;
+      line += wl_unit;
     }
+    write_fabric_bitstream_text_line(fp, line, hex);
     fp << std::endl;
   }
 
@@ -255,6 +339,11 @@ static int write_memory_bank_flatten_fabric_bitstream_to_text_file(
  *  1. Original function used 600 seconds and needs high memory usage
  *  2. This new function only needs 1 second and 4M Bytes
  *
+ * Each line is assembled in a preallocated buffer, where BLs are decoded
+ * byte by byte from the datas/masks arrays, and written out in one shot.
+ * WLs to skip are looked up in a bitmap, so the runtime only grows with
+ * the number of bits written.
+ *
  * Old function only print WL in decremental order. It is not by intentional
  * It is because of the map-key ordering
  * In QL Memory Bank with Flatten BL/WL, data is stored by WL address,
@@ -276,23 +365,26 @@ static int write_memory_bank_flatten_fabric_bitstream_to_text_file(
 static int fast_write_memory_bank_flatten_fabric_bitstream_to_text_file(
   std::fstream& fp, const bool& fast_configuration,
   const bool& bit_value_to_skip, const FabricBitstream& fabric_bitstream,
-  const bool& keep_dont_care_bits, const bool& wl_incremental_order) {
+  const bool& keep_dont_care_bits, const bool& wl_incremental_order,
+  const bool& hex) {
   int status = 0;
 
-  std::string dont_care_bit = "0";
+  char dont_care_bit = '0';
   if (keep_dont_care_bits) {
-    dont_care_bit = "x";
+    dont_care_bit = 'x';
   }
   const FabricBitstreamMemoryBank& memory_bank =
     fabric_bitstream.memory_bank_info(fast_configuration, bit_value_to_skip);
 
   fabric_size_t longest_effective_wl_count =
     memory_bank.get_longest_effective_wl_count();
+  fabric_size_t total_bl_addr_size = memory_bank.get_total_bl_addr_size();
+  fabric_size_t total_wl_addr_size = memory_bank.get_total_wl_addr_size();
   /* Output information about how to intepret the bitstream */
   fp << "// Bitstream length: " << longest_effective_wl_count << std::endl;
   fp << "// Bitstream width (LSB -> MSB): ";
-  fp << "<bl_address " << memory_bank.get_total_bl_addr_size() << " bits>";
-  fp << "<wl_address " << memory_bank.get_total_wl_addr_size() << " bits>";
+  fp << "<bl_address " << total_bl_addr_size << " bits>";
+  fp << "<wl_address " << total_wl_addr_size << " bits>";
   fp << std::endl;
 
   // Step 1
@@ -300,7 +392,12 @@ static int fast_write_memory_bank_flatten_fabric_bitstream_to_text_file(
   // The intialization depends the ordering of WL
   // It could either be 0 (if wl_incremental_order=true) or
   // last WL index (if wl_incremental_order=false)
+  // Also find the offset of each region in the BL and WL part of a line
   std::vector<fabric_size_t> wl_indexes;
+  std::vector<size_t> bl_offsets;
+  std::vector<size_t> wl_offsets;
+  size_t bl_offset = 0;
+  size_t wl_offset = total_bl_addr_size;
   for (size_t region = 0; region < memory_bank.datas.size(); region++) {
     if (wl_incremental_order) {
       wl_indexes.push_back(0);
@@ -308,34 +405,57 @@ static int fast_write_memory_bank_flatten_fabric_bitstream_to_text_file(
       wl_indexes.push_back(
         (fabric_size_t)(memory_bank.datas[region].size() - 1));
     }
+    bl_offsets.push_back(bl_offset);
+    wl_offsets.push_back(wl_offset);
+    bl_offset += memory_bank.blwl_lengths[region].bl;
+    wl_offset += memory_bank.blwl_lengths[region].wl;
   }
+
+  // Each line is built in a preallocated buffer and written in one shot
+  // The WL part is a one-hot code, so it is reset to all '0' once and only
+  // the hot bit is touched per line
+  std::string line(total_bl_addr_size + total_wl_addr_size + 1, '0');
+  line.back() = '\n';
+  // The BL characters of a byte of datas/masks are looked up in a table:
+  //   bl_chars[mask][data] = 8 characters in the order BL #0 -> BL #7
+  std::vector<std::array<char, 8>> bl_chars(256 * 256);
+  for (size_t mask = 0; mask < 256; mask++) {
+    for (size_t data = 0; data < 256; data++) {
+      for (size_t ibit = 0; ibit < 8; ibit++) {
+        char& c = bl_chars[(mask << 8) | data][ibit];
+        if (mask & (1 << ibit)) {
+          c = (data & (1 << ibit)) ? '1' : '0';
+        } else {
+          c = dont_care_bit;
+        }
+      }
+    }
+  }
+
   // Step 2
   // Loop through total WL count that we would like to configure
   for (size_t wl_index = 0; wl_index < longest_effective_wl_count; wl_index++) {
-    // Step 3
-    // Write BL address
     // We cascade all regions: 0, 1, 2 ...
     for (size_t region = 0; region < memory_bank.datas.size(); region++) {
       // Step 3a
       // The sequence of configuration of each region WL is not the same
       //   since WL to skip for each region is not the same
       // If it happen that current WL that we are going to program is
-      //   one of the WLs (stored in wls_to_skip) that we had determined
+      //   one of the WLs (marked in wls_to_skip) that we had determined
       //   to skip, the we will increment or decrement to next
       //   depending on wl_incremental_order
       const fabric_blwl_length& lengths = memory_bank.blwl_lengths[region];
-      fabric_size_t current_wl = wl_indexes[region];
-      while (std::find(memory_bank.wls_to_skip[region].begin(),
-                       memory_bank.wls_to_skip[region].end(),
-                       current_wl) != memory_bank.wls_to_skip[region].end()) {
+      while (memory_bank.is_wl_skipped(region, wl_indexes[region])) {
         // We would like to skip this
         if (wl_incremental_order) {
           wl_indexes[region]++;
         } else {
           wl_indexes[region]--;
         }
-        current_wl = wl_indexes[region];
       }
+      fabric_size_t current_wl = wl_indexes[region];
+      char* bl_chunk = &line[bl_offsets[region]];
+      char* wl_chunk = &line[wl_offsets[region]];
       // Step 3b
       // If current WL still within the valid range, we will print BL
       // Otherwise it is either
@@ -350,70 +470,22 @@ static int fast_write_memory_bank_flatten_fabric_bitstream_to_text_file(
         const std::vector<uint8_t>& mask =
           memory_bank.masks[region][current_wl];
         // Step 3c
-        // Real code to print BL data that we had stored
+        // Decode BL data that we had stored, one byte (8 BLs) at a time
         // mask tell you each BL is valid
         //   for invalid BL, we will print don't care
         // data tell you the real din value
-        // (bl >> 3) - This is to find Byte index of the BL
-        // (1 << (bl & 7)) - This is to find Bit index of the BL
-        //                   within that Byte index
-        // When we '&' both, we can know if that BL is set or unset
-        /*
-          -----------------------------------------------------------------
-          |  bit (bl)  |  Byte index (bl >> 3) | Bit index (1 << (bl & 7)) |
-          |----------------------------------------------------------------
-          |  0         |             0         |    b0000_0001 (or 0x01)   |
-          |  1         |             0         |    b0000_0010 (or 0x02)   |
-          |  2         |             0         |    b0000_0100 (or 0x04)   |
-          |  3         |             0         |    b0000_1000 (or 0x08)   |
-          |  4         |             0         |    b0001_0000 (or 0x10)   |
-          |  5         |             0         |    b0010_0000 (or 0x20)   |
-          |  6         |             0         |    b0100_0000 (or 0x40)   |
-          |  7         |             0         |    b1000_0000 (or 0x80)   |
-          |  8         |             1         |    b0000_0001 (or 0x01)   |
-          | ...        |            ...        |          ...              |
-          ------------------------------------------------------------------
-          Each BL can be uniquely represented by bit slice in byte array
-        */
-        for (size_t bl = 0; bl < lengths.bl; bl++) {
-          if (mask[bl >> 3] & (1 << (bl & 7))) {
-            if (data[bl >> 3] & (1 << (bl & 7))) {
-              fp << "1";
-            } else {
-              fp << "0";
-            }
-          } else {
-            fp << dont_care_bit.c_str();
-          }
-        }
-      } else {
-        /* However not all region has equal WL, for those that is shorter,
-         * print 'x' for all BL*/
-        for (size_t bl = 0; bl < lengths.bl; bl++) {
-          fp << dont_care_bit.c_str();
+        // The last byte may be partially used when the BL size is not a
+        // multiple of 8
+        for (size_t bl = 0; bl < lengths.bl; bl += 8) {
+          const std::array<char, 8>& chars =
+            bl_chars[((size_t)(mask[bl >> 3]) << 8) | data[bl >> 3]];
+          size_t num_chars = std::min(size_t(8), (size_t)(lengths.bl) - bl);
+          std::copy(chars.begin(), chars.begin() + num_chars, bl_chunk + bl);
         }
-      }
-    }
-    // Step 4
-    // Write WL address
-    // We cascade all regions: 0, 1, 2 ...
-    for (size_t region = 0; region < memory_bank.datas.size(); region++) {
-      const fabric_blwl_length& lengths = memory_bank.blwl_lengths[region];
-      fabric_size_t current_wl = wl_indexes[region];
-      // Step 4a
-      // If current WL still within the valid range, we will print WL
-      // Otherwise it is overflow/underflow then we will print don't care
-      if (current_wl < memory_bank.datas[region].size()) {
-        // Step 4b
-        // One hot printing
-        for (size_t wl_temp = 0; wl_temp < lengths.wl; wl_temp++) {
-          if (wl_temp == current_wl) {
-            fp << "1";
-          } else {
-            fp << "0";
-          }
-        }
-        // Step 4b
+        // Step 4
+        // Write WL address as a one-hot code
+        std::fill(wl_chunk, wl_chunk + lengths.wl, '0');
+        wl_chunk[current_wl] = '1';
         // Increment or decrement to next depending on wl_incremental_order
         if (wl_incremental_order) {
           wl_indexes[region]++;
@@ -422,13 +494,17 @@ static int fast_write_memory_bank_flatten_fabric_bitstream_to_text_file(
         }
       } else {
         /* However not all region has equal WL, for those that is shorter,
-         * print 'x' for all WL */
-        for (size_t wl_temp = 0; wl_temp < lengths.wl; wl_temp++) {
-          fp << dont_care_bit.c_str();
-        }
+         * print 'x' for all BL and WL */
+        std::fill(bl_chunk, bl_chunk + lengths.bl, dont_care_bit);
+        std::fill(wl_chunk, wl_chunk + lengths.wl, dont_care_bit);
       }
     }
-    fp << std::endl;
+    if (hex) {
+      write_fabric_bitstream_text_line(fp, line.data(), line.size() - 1, hex);
+      fp << '\n';
+    } else {
+      fp.write(line.data(), line.size());
+    }
   }
   return status;
 }
@@ -503,7 +579,8 @@ static int write_memory_bank_shift_register_fabric_bitstream_to_text_file(
  *******************************************************************/
 static int write_frame_based_fabric_bitstream_to_text_file(
   std::fstream& fp, const bool& fast_configuration,
-  const bool& bit_value_to_skip, const FabricBitstream& fabric_bitstream) {
+  const bool& bit_value_to_skip, const FabricBitstream& fabric_bitstream,
+  const bool& hex) {
   int status = 0;
 
   FrameFabricBitstream fabric_bits_by_addr =
@@ -536,6 +613,7 @@ static int write_frame_based_fabric_bitstream_to_text_file(
   fp << "// Bitstream width (LSB -> MSB): <address " << addr_size
      << " bits><data input " << din_size << " bits>" << std::endl;
 
+  std::string line;
   for (const auto& addr_din_pair : fabric_bits_by_addr) {
     /* When fast configuration is enabled,
      * the rule to skip any configuration bit should consider the whole data
@@ -550,12 +628,13 @@ static int write_frame_based_fabric_bitstream_to_text_file(
     }
 
     /* Write address code */
-    fp << addr_din_pair.first;
+    line = addr_din_pair.first;
 
     /* Write data input */
     for (const bool& din_value : addr_din_pair.second) {
-      fp << din_value;
+      line.push_back(din_value ? '1' : '0');
     }
+    write_fabric_bitstream_text_line(fp, line, hex);
     fp << std::endl;
   }
 
@@ -614,8 +693,7 @@ int write_fabric_bitstream_to_text_file(
   bool bit_value_to_skip = false;
   if (apply_fast_configuration) {
     bit_value_to_skip = find_bit_value_to_skip_for_fast_configuration(
-      config_protocol.type(), global_ports, bitstream_manager,
-      fabric_bitstream);
+      config_protocol.type(), global_ports, fabric_bitstream);
   }
 
   /* Write file head */
@@ -626,12 +704,12 @@ int write_fabric_bitstream_to_text_file(
   switch (config_protocol.type()) {
     case CONFIG_MEM_STANDALONE:
       status = write_flatten_fabric_bitstream_to_text_file(
-        fp, bitstream_manager, fabric_bitstream);
+        fp, bitstream_manager, fabric_bitstream, options.hex());
       break;
     case CONFIG_MEM_SCAN_CHAIN:
       status = write_config_chain_fabric_bitstream_to_text_file(
         fp, apply_fast_configuration, bit_value_to_skip, bitstream_manager,
-        fabric_bitstream);
+        fabric_bitstream, options.hex());
       break;
     case CONFIG_MEM_QL_MEMORY_BANK: {
       /* Bitstream organization depends on the BL/WL protocols
@@ -645,22 +723,33 @@ int write_fabric_bitstream_to_text_file(
        */
       if (BLWL_PROTOCOL_DECODER == config_protocol.bl_protocol_type()) {
         status = write_memory_bank_fabric_bitstream_to_text_file(
-          fp, apply_fast_configuration, bit_value_to_skip, fabric_bitstream);
+          fp, apply_fast_configuration, bit_value_to_skip, fabric_bitstream,
+          options.hex());
       } else if (BLWL_PROTOCOL_FLATTEN == config_protocol.bl_protocol_type() &&
                  BLWL_PROTOCOL_FLATTEN == config_protocol.wl_protocol_type()) {
         // If both BL and WL protocols are flatten, use new way to write the
         // bitstream
         status = fast_write_memory_bank_flatten_fabric_bitstream_to_text_file(
           fp, apply_fast_configuration, bit_value_to_skip, fabric_bitstream,
-          options.keep_dont_care_bits(), !options.wl_decremental_order());
+          options.keep_dont_care_bits(), !options.wl_decremental_order(),
+          options.hex());
 
       } else if (BLWL_PROTOCOL_FLATTEN == config_protocol.bl_protocol_type()) {
         status = write_memory_bank_flatten_fabric_bitstream_to_text_file(
           fp, apply_fast_configuration, bit_value_to_skip, fabric_bitstream,
-          options.keep_dont_care_bits());
+          options.keep_dont_care_bits(), options.hex());
       } else {
         VTR_ASSERT(BLWL_PROTOCOL_SHIFT_REGISTER ==
                    config_protocol.bl_protocol_type());
+        /* Each word is split into lines of shift register heads, which are
+         * only readable in binary format */
+        if (options.hex()) {
+          VTR_LOG_ERROR(
+            "Hexadecimal format is not supported by memory bank using shift "
+            "registers!\n");
+          status = 1;
+          break;
+        }
         status = write_memory_bank_shift_register_fabric_bitstream_to_text_file(
           fp, apply_fast_configuration, bit_value_to_skip, fabric_bitstream,
           blwl_sr_banks, options.keep_dont_care_bits());
@@ -669,11 +758,13 @@ int write_fabric_bitstream_to_text_file(
     }
     case CONFIG_MEM_MEMORY_BANK:
       status = write_memory_bank_fabric_bitstream_to_text_file(
-        fp, apply_fast_configuration, bit_value_to_skip, fabric_bitstream);
+        fp, apply_fast_configuration, bit_value_to_skip, fabric_bitstream,
+        options.hex());
       break;
     case CONFIG_MEM_FRAME_BASED:
       status = write_frame_based_fabric_bitstream_to_text_file(
-        fp, apply_fast_configuration, bit_value_to_skip, fabric_bitstream);
+        fp, apply_fast_configuration, bit_value_to_skip, fabric_bitstream,
+        options.hex());
       break;
     default:
       VTR_LOGF_ERROR(__FILE__, __LINE__,
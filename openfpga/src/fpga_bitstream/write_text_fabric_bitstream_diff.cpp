@@ -0,0 +1,429 @@
+/********************************************************************
+ * This file includes functions to output the difference between the
+ * fabric bitstream and a reference architecture bitstream (typically
+ * written by a previous run on the same fabric) to a plain text file,
+ * as well as to apply such a difference to an architecture bitstream.
+ *
+ * Each line of the difference includes the full path of a configuration
+ * bit in the hierarchy of FPGA fabric and its new value, e.g.,
+ *   fpga_top.grid_clb_1__1_.logical_tile_clb_mode_clb__0.mem_out[3] 1
+ * followed by the address of the bit, if the configuration protocol
+ * uses any. The lines are grouped by configuration regions.
+ * For memory banks whose BLs are not driven by decoders, a WL is written
+ * as a whole. Therefore, all the bits on a WL with any change are
+ * included, while the WLs without changes are skipped.
+ *******************************************************************/
+#include <algorithm>
+#include <chrono>
+#include <ctime>
+#include <fstream>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+/* Headers from vtrutil library */
+#include "vtr_assert.h"
+#include "vtr_log.h"
+#include "vtr_time.h"
+#include "vtr_vector.h"
+
+/* Headers from openfpgautil library */
+#include "bitstream_manager_utils.h"
+#include "command_exit_codes.h"
+#include "openfpga_decode.h"
+#include "openfpga_digest.h"
+#include "openfpga_tokenizer.h"
+#include "openfpga_version.h"
+#include "write_text_fabric_bitstream_diff.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/********************************************************************
+ * Find the block in the reference bitstream which has the same
+ * hierarchy as a given block. Found blocks are cached, as most of the
+ * bits share a few upper-level blocks.
+ * Return an invalid id if not found.
+ *******************************************************************/
+static ConfigBlockId find_reference_bitstream_block(
+  const BitstreamManager& bitstream_manager,
+  const BitstreamManager& ref_bitstream_manager, const ConfigBlockId& block,
+  std::map<ConfigBlockId, ConfigBlockId>& ref_blocks) {
+  auto result = ref_blocks.find(block);
+  if (result != ref_blocks.end()) {
+    return result->second;
+  }
+
+  ConfigBlockId ref_block = ConfigBlockId::INVALID();
+  ConfigBlockId parent_block = bitstream_manager.block_parent(block);
+  if (!bitstream_manager.valid_block_id(parent_block)) {
+    for (const ConfigBlockId& cand :
+         find_bitstream_manager_top_blocks(ref_bitstream_manager)) {
+      if (ref_bitstream_manager.block_name(cand) ==
+          bitstream_manager.block_name(block)) {
+        ref_block = cand;
+      }
+    }
+  } else {
+    ConfigBlockId ref_parent_block = find_reference_bitstream_block(
+      bitstream_manager, ref_bitstream_manager, parent_block, ref_blocks);
+    if (ref_bitstream_manager.valid_block_id(ref_parent_block)) {
+      ref_block = ref_bitstream_manager.find_child_block(
+        ref_parent_block, bitstream_manager.block_name(block));
+    }
+  }
+
+  ref_blocks[block] = ref_block;
+  return ref_block;
+}
+
+/********************************************************************
+ * Paths and indices of the configuration bits, which are looked up for
+ * every bit written. Bit indices are built once for all the blocks, while
+ * the path of a block is built on demand and shared by all its bits.
+ *******************************************************************/
+struct FabricBitstreamDiffPaths {
+  vtr::vector<ConfigBitId, size_t> bit_indices;
+  std::map<ConfigBlockId, std::string> block_paths;
+};
+
+/********************************************************************
+ * Find the index of each configuration bit in its parent block
+ *******************************************************************/
+static void build_fabric_bitstream_diff_bit_indices(
+  const BitstreamManager& bitstream_manager,
+  FabricBitstreamDiffPaths& diff_paths) {
+  diff_paths.bit_indices.resize(bitstream_manager.num_bits(), 0);
+  for (const ConfigBlockId& block : bitstream_manager.blocks()) {
+    std::vector<ConfigBitId> block_bits = bitstream_manager.block_bits(block);
+    for (size_t ibit = 0; ibit < block_bits.size(); ++ibit) {
+      diff_paths.bit_indices[block_bits[ibit]] = ibit;
+    }
+  }
+}
+
+/********************************************************************
+ * Find the full path of a block in the hierarchy of FPGA fabric, which
+ * is extended from the cached path of its parent
+ *******************************************************************/
+static const std::string& fabric_bitstream_diff_block_path(
+  const BitstreamManager& bitstream_manager, const ConfigBlockId& block,
+  FabricBitstreamDiffPaths& diff_paths) {
+  auto result = diff_paths.block_paths.find(block);
+  if (result != diff_paths.block_paths.end()) {
+    return result->second;
+  }
+
+  std::string path;
+  ConfigBlockId parent_block = bitstream_manager.block_parent(block);
+  if (bitstream_manager.valid_block_id(parent_block)) {
+    path = fabric_bitstream_diff_block_path(bitstream_manager, parent_block,
+                                            diff_paths) +
+           std::string(".");
+  }
+  path += bitstream_manager.block_name(block);
+
+  return diff_paths.block_paths.emplace(block, path).first->second;
+}
+
+/********************************************************************
+ * Find the full path of a configuration bit, which can be recognized by
+ * BitstreamManager::find_bit()
+ *******************************************************************/
+static std::string fabric_bitstream_diff_bit_path(
+  const BitstreamManager& bitstream_manager, const ConfigBitId& config_bit,
+  FabricBitstreamDiffPaths& diff_paths) {
+  return fabric_bitstream_diff_block_path(
+           bitstream_manager, bitstream_manager.bit_parent_block(config_bit),
+           diff_paths) +
+         std::string("[") + std::to_string(diff_paths.bit_indices[config_bit]) +
+         std::string("]");
+}
+
+static std::string fabric_bitstream_diff_address(
+  const std::vector<char>& address) {
+  return std::string(address.begin(), address.end());
+}
+
+/********************************************************************
+ * Find the index of the WL of a bit under memory bank protocols, so that
+ * the WLs can be written in their numeric order. When the compact memory
+ * bank data is available, the index of WL is used directly. Otherwise, it
+ * is decoded from the WL address, which is a binary number for decoders
+ * and a one-hot code for the others.
+ *******************************************************************/
+static size_t fabric_bitstream_diff_wl(
+  const FabricBitstream& fabric_bitstream,
+  const FabricBitstreamMemoryBank& memory_bank,
+  const ConfigProtocol& config_protocol, const FabricBitId& fabric_bit) {
+  if (size_t(fabric_bit) < memory_bank.fabric_bit_datas.size()) {
+    return memory_bank.fabric_bit_datas[size_t(fabric_bit)].wl;
+  }
+  std::vector<char> wl_address = fabric_bitstream.bit_wl_address(fabric_bit);
+  if (BLWL_PROTOCOL_DECODER == config_protocol.wl_protocol_type()) {
+    return bintoi_charvec(wl_address);
+  }
+  return std::find(wl_address.begin(), wl_address.end(), '1') -
+         wl_address.begin();
+}
+
+static std::string fabric_bitstream_diff_bl(
+  const FabricBitstream& fabric_bitstream,
+  const FabricBitstreamMemoryBank& memory_bank, const FabricBitId& fabric_bit) {
+  if (size_t(fabric_bit) < memory_bank.fabric_bit_datas.size()) {
+    return std::to_string(memory_bank.fabric_bit_datas[size_t(fabric_bit)].bl);
+  }
+  return fabric_bitstream_diff_address(
+    fabric_bitstream.bit_bl_address(fabric_bit));
+}
+
+/********************************************************************
+ * Write a line for a configuration bit to the difference file
+ *******************************************************************/
+static void write_fabric_bitstream_diff_bit(
+  std::fstream& fp, const BitstreamManager& bitstream_manager,
+  const FabricBitstream& fabric_bitstream,
+  const FabricBitstreamMemoryBank& memory_bank,
+  const ConfigProtocol& config_protocol, const FabricBitId& fabric_bit,
+  FabricBitstreamDiffPaths& diff_paths) {
+  const ConfigBitId& config_bit = fabric_bitstream.config_bit(fabric_bit);
+  fp << fabric_bitstream_diff_bit_path(bitstream_manager, config_bit,
+                                       diff_paths)
+     << " "
+     << bitstream_manager.bit_value(config_bit);
+  if (CONFIG_MEM_QL_MEMORY_BANK == config_protocol.type()) {
+    fp << " "
+       << fabric_bitstream_diff_bl(fabric_bitstream, memory_bank, fabric_bit);
+  } else if (fabric_bitstream.use_address()) {
+    fp << " "
+       << fabric_bitstream_diff_address(
+            fabric_bitstream.bit_address(fabric_bit));
+  } else {
+    fp << " " << size_t(fabric_bit);
+  }
+  fp << "\n";
+}
+
+/********************************************************************
+ * Write the bits of a region which differ from the reference
+ * Return the number of bits written
+ *******************************************************************/
+static size_t write_fabric_bitstream_region_diff(
+  std::fstream& fp, const BitstreamManager& bitstream_manager,
+  const FabricBitstream& fabric_bitstream,
+  const FabricBitstreamMemoryBank& memory_bank,
+  const ConfigProtocol& config_protocol, const FabricBitRegionId& region,
+  const std::vector<bool>& changed_bits, FabricBitstreamDiffPaths& diff_paths) {
+  size_t num_written_bits = 0;
+
+  /* A memory bank with BLs driven by decoders is configured bit by bit,
+   * while others are configured WL by WL */
+  if (CONFIG_MEM_QL_MEMORY_BANK == config_protocol.type() &&
+      BLWL_PROTOCOL_DECODER != config_protocol.bl_protocol_type()) {
+    std::map<size_t, std::vector<FabricBitId>> wl_bits;
+    std::set<size_t> changed_wls;
+    for (const FabricBitId& fabric_bit :
+         fabric_bitstream.region_bits(region)) {
+      size_t wl = fabric_bitstream_diff_wl(fabric_bitstream, memory_bank,
+                                           config_protocol, fabric_bit);
+      wl_bits[wl].push_back(fabric_bit);
+      if (changed_bits[size_t(fabric_bit)]) {
+        changed_wls.insert(wl);
+      }
+    }
+    for (const size_t& wl : changed_wls) {
+      fp << "// WL " << wl << "\n";
+      for (const FabricBitId& fabric_bit : wl_bits[wl]) {
+        write_fabric_bitstream_diff_bit(
+          fp, bitstream_manager, fabric_bitstream, memory_bank,
+          config_protocol, fabric_bit, diff_paths);
+        num_written_bits++;
+      }
+    }
+    return num_written_bits;
+  }
+
+  for (const FabricBitId& fabric_bit : fabric_bitstream.region_bits(region)) {
+    if (!changed_bits[size_t(fabric_bit)]) {
+      continue;
+    }
+    write_fabric_bitstream_diff_bit(fp, bitstream_manager, fabric_bitstream,
+                                    memory_bank, config_protocol, fabric_bit,
+                                    diff_paths);
+    num_written_bits++;
+  }
+  return num_written_bits;
+}
+
+/********************************************************************
+ * Top-level function to write the difference between the fabric bitstream
+ * and a reference architecture bitstream
+ *******************************************************************/
+int write_fabric_bitstream_diff_to_text_file(
+  const BitstreamManager& bitstream_manager,
+  const BitstreamManager& ref_bitstream_manager,
+  const FabricBitstream& fabric_bitstream,
+  const ConfigProtocol& config_protocol, const std::string& fname,
+  const std::string& ref_fname, const bool& include_time_stamp,
+  const bool& verbose) {
+  std::string timer_message =
+    std::string("Write fabric bitstream difference into plain text file '") +
+    fname + std::string("'");
+  vtr::ScopedStartFinishTimer timer(timer_message);
+
+  FabricBitstreamDiffPaths diff_paths;
+  build_fabric_bitstream_diff_bit_indices(bitstream_manager, diff_paths);
+
+  /* Find the bits whose values differ from the reference. The bits of each
+   * reference block are cached, as they are shared by many bits */
+  std::vector<bool> changed_bits(fabric_bitstream.num_bits(), false);
+  std::map<ConfigBlockId, ConfigBlockId> ref_blocks;
+  std::map<ConfigBlockId, std::vector<ConfigBitId>> ref_block_bits;
+  size_t num_changed_bits = 0;
+  for (const FabricBitId& fabric_bit : fabric_bitstream.bits()) {
+    const ConfigBitId& config_bit = fabric_bitstream.config_bit(fabric_bit);
+    ConfigBlockId ref_block = find_reference_bitstream_block(
+      bitstream_manager, ref_bitstream_manager,
+      bitstream_manager.bit_parent_block(config_bit), ref_blocks);
+    size_t bit_index = diff_paths.bit_indices[config_bit];
+    const std::vector<ConfigBitId>* ref_bits = nullptr;
+    if (ref_bitstream_manager.valid_block_id(ref_block)) {
+      auto result = ref_block_bits.find(ref_block);
+      if (result == ref_block_bits.end()) {
+        result = ref_block_bits
+                   .emplace(ref_block,
+                            ref_bitstream_manager.block_bits(ref_block))
+                   .first;
+      }
+      ref_bits = &result->second;
+    }
+    if (nullptr == ref_bits || bit_index >= ref_bits->size()) {
+      VTR_LOG_ERROR(
+        "Configuration bit '%s' is not found in the reference bitstream '%s'! "
+        "The reference bitstream should be created for the same FPGA "
+        "fabric.\n",
+        fabric_bitstream_diff_bit_path(bitstream_manager, config_bit,
+                                       diff_paths)
+          .c_str(),
+        ref_fname.c_str());
+      return CMD_EXEC_FATAL_ERROR;
+    }
+    if (bitstream_manager.bit_value(config_bit) !=
+        ref_bitstream_manager.bit_value((*ref_bits)[bit_index])) {
+      changed_bits[size_t(fabric_bit)] = true;
+      num_changed_bits++;
+    }
+  }
+
+  /* Create the file stream */
+  std::fstream fp;
+  fp.open(fname, std::fstream::out | std::fstream::trunc);
+  check_file_stream(fname.c_str(), fp);
+
+  fp << "// Fabric bitstream difference" << std::endl;
+  if (include_time_stamp) {
+    auto end = std::chrono::system_clock::now();
+    std::time_t end_time = std::chrono::system_clock::to_time_t(end);
+    /* Note that version is also a type of time stamp */
+    fp << "// Version: " << openfpga::VERSION << std::endl;
+    fp << "// Date: " << std::ctime(&end_time);
+  }
+  fp << "// Reference: " << ref_fname << std::endl;
+  fp << "// Number of changed bits: " << num_changed_bits << std::endl;
+
+  /* The compact memory bank data is only available for memory banks */
+  FabricBitstreamMemoryBank empty_memory_bank;
+  const FabricBitstreamMemoryBank& memory_bank =
+    fabric_bitstream.use_wl_address() ? fabric_bitstream.memory_bank_info()
+                                      : empty_memory_bank;
+
+  size_t num_written_bits = 0;
+  for (const FabricBitRegionId& region : fabric_bitstream.regions()) {
+    fp << "// Region " << size_t(region) << std::endl;
+    num_written_bits += write_fabric_bitstream_region_diff(
+      fp, bitstream_manager, fabric_bitstream, memory_bank, config_protocol,
+      region, changed_bits, diff_paths);
+  }
+
+  fp.close();
+
+  VTR_LOG("Found %lu changed bits, written %lu of %lu bits\n",
+          num_changed_bits, num_written_bits, fabric_bitstream.num_bits());
+  VTR_LOGV(verbose, "Compared against %lu bits in the reference bitstream\n",
+           ref_bitstream_manager.num_bits());
+
+  return CMD_EXEC_SUCCESS;
+}
+
+/********************************************************************
+ * Apply a difference file to the architecture bitstream, by overwriting
+ * the value of each bit listed in the file
+ * Note that only the architecture bitstream database in memory is patched.
+ * No bitstream file is modified: to patch a base bitstream file, it should
+ * be loaded into the database first, and the fabric bitstream should be
+ * built and written again after the difference is applied.
+ *******************************************************************/
+int apply_fabric_bitstream_diff(BitstreamManager& bitstream_manager,
+                                const std::string& fname,
+                                const bool& verbose) {
+  std::string timer_message =
+    std::string("Apply fabric bitstream difference from file '") + fname +
+    std::string("'");
+  vtr::ScopedStartFinishTimer timer(timer_message);
+
+  std::fstream fp;
+  fp.open(fname, std::fstream::in);
+  if (!valid_file_stream(fp)) {
+    VTR_LOG_ERROR("Unable to open fabric bitstream difference '%s'!\n",
+                  fname.c_str());
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  std::string line;
+  size_t line_num = 0;
+  size_t num_applied_bits = 0;
+  size_t num_changed_bits = 0;
+  while (getline(fp, line)) {
+    line_num++;
+    StringToken tokenizer(line);
+    std::vector<std::string> tokens = tokenizer.split(" \t\r");
+    if (tokens.empty() || 0 == tokens[0].find("//")) {
+      continue;
+    }
+    if (2 > tokens.size() || (tokens[1] != "0" && tokens[1] != "1")) {
+      VTR_LOG_ERROR(
+        "Invalid line %lu in fabric bitstream difference '%s'! Expect "
+        "'<bit path> <value>'.\n",
+        line_num, fname.c_str());
+      return CMD_EXEC_FATAL_ERROR;
+    }
+    ConfigBitId config_bit = bitstream_manager.find_bit(tokens[0]);
+    if (!bitstream_manager.valid_bit_id(config_bit)) {
+      VTR_LOG_ERROR(
+        "Invalid or unknown bit path '%s' at line %lu in fabric bitstream "
+        "difference '%s'! The difference should be created for the same "
+        "FPGA fabric.\n",
+        tokens[0].c_str(), line_num, fname.c_str());
+      return CMD_EXEC_FATAL_ERROR;
+    }
+    bool value = tokens[1] == "1";
+    VTR_LOGV(verbose, "Overwrite bitstream path='%s' to value='%s'\n",
+             tokens[0].c_str(), tokens[1].c_str());
+    if (bitstream_manager.bit_value(config_bit) != value) {
+      num_changed_bits++;
+    }
+    bitstream_manager.set_bit_value(config_bit, value);
+    num_applied_bits++;
+  }
+  fp.close();
+
+  VTR_LOG(
+    "Applied %lu bits to architecture bitstream, among which %lu bits are "
+    "changed\n",
+    num_applied_bits, num_changed_bits);
+
+  return CMD_EXEC_SUCCESS;
+}
+
+} /* end namespace openfpga */
@@ -0,0 +1,34 @@
+#ifndef WRITE_TEXT_FABRIC_BITSTREAM_DIFF_H
+#define WRITE_TEXT_FABRIC_BITSTREAM_DIFF_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include <string>
+
+#include "bitstream_manager.h"
+#include "config_protocol.h"
+#include "fabric_bitstream.h"
+
+/********************************************************************
+ * Function declaration
+ *******************************************************************/
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+int write_fabric_bitstream_diff_to_text_file(
+  const BitstreamManager& bitstream_manager,
+  const BitstreamManager& ref_bitstream_manager,
+  const FabricBitstream& fabric_bitstream,
+  const ConfigProtocol& config_protocol, const std::string& fname,
+  const std::string& ref_fname, const bool& include_time_stamp,
+  const bool& verbose);
+
+int apply_fabric_bitstream_diff(BitstreamManager& bitstream_manager,
+                                const std::string& fname,
+                                const bool& verbose);
+
+} /* end namespace openfpga */
+
+#endif
@@ -91,12 +91,13 @@ int fpga_fabric_spice(const ModuleManager& module_manager,
   /* Generate routing blocks */
   if (true == options.compress_routing()) {
     print_spice_unique_routing_modules(netlist_manager, module_manager,
-                                       device_rr_gsb, rr_dir_path);
+                                       device_rr_gsb, rr_dir_path,
+                                       options.num_threads());
   } else {
     VTR_ASSERT(false == options.compress_routing());
     print_spice_flatten_routing_modules(netlist_manager, module_manager,
                                         device_rr_gsb, device_ctx.rr_graph,
-                                        rr_dir_path);
+                                        rr_dir_path, options.num_threads());
   }
 
   /* Generate grids */
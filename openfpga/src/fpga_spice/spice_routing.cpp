@@ -9,6 +9,7 @@
 
 /* Headers from openfpgautil library */
 #include "openfpga_digest.h"
+#include "openfpga_parallel.h"
 
 /* Include FPGA-Verilog header files*/
 #include "openfpga_naming.h"
@@ -74,11 +75,13 @@ namespace openfpga {
  *
  *  W: routing channel width
  *
+ * Return the name of the netlist file, which is to be added to the netlist
+ * manager by the caller. This function does not modify any shared data, so
+ * that it can be called from multiple threads
  ********************************************************************/
-static void print_spice_routing_connection_box_unique_module(
-  NetlistManager& netlist_manager, const ModuleManager& module_manager,
-  const std::string& subckt_dir, const RRGSB& rr_gsb,
-  const t_rr_type& cb_type) {
+static std::string print_spice_routing_connection_box_unique_module(
+  const ModuleManager& module_manager, const std::string& subckt_dir,
+  const RRGSB& rr_gsb, const t_rr_type& cb_type) {
   /* Create the netlist */
   vtr::Point<size_t> gsb_coordinate(rr_gsb.get_cb_x(cb_type),
                                     rr_gsb.get_cb_y(cb_type));
@@ -113,11 +116,7 @@ static void print_spice_routing_connection_box_unique_module(
   /* Close file handler */
   fp.close();
 
-  /* Add fname to the netlist name list */
-  NetlistId nlist_id = netlist_manager.add_netlist(spice_fname);
-  VTR_ASSERT(NetlistId::INVALID() != nlist_id);
-  netlist_manager.set_netlist_type(nlist_id,
-                                   NetlistManager::ROUTING_MODULE_NETLIST);
+  return spice_fname;
 }
 
 /*********************************************************************
@@ -178,11 +177,12 @@ static void print_spice_routing_connection_box_unique_module(
  *                       Grid[x][y]     ChanY[x][y]      Grid[x+1][y]
  *                       right_pins    inputs/outputs      left_pins
  *
- *
+ * Return the name of the netlist file, which is to be added to the netlist
+ * manager by the caller
  ********************************************************************/
-static void print_spice_routing_switch_box_unique_module(
-  NetlistManager& netlist_manager, const ModuleManager& module_manager,
-  const std::string& subckt_dir, const RRGSB& rr_gsb) {
+static std::string print_spice_routing_switch_box_unique_module(
+  const ModuleManager& module_manager, const std::string& subckt_dir,
+  const RRGSB& rr_gsb) {
   /* Create the netlist */
   vtr::Point<size_t> gsb_coordinate(rr_gsb.get_sb_x(), rr_gsb.get_sb_y());
   std::string spice_fname(subckt_dir +
@@ -213,21 +213,59 @@ static void print_spice_routing_switch_box_unique_module(
   /* Close file handler */
   fp.close();
 
+  return spice_fname;
+}
+
+/********************************************************************
+ * A routing block whose SPICE netlist is to be written: either the switch
+ * block or a connection block of a GSB
+ *******************************************************************/
+struct SpiceRoutingModuleTask {
+  const RRGSB* rr_gsb;
+  bool is_sb;
+  t_rr_type cb_type;
+};
+
+/********************************************************************
+ * Write the netlists of a list of routing blocks. Each netlist is an
+ * independent file, so that the netlists can be written in parallel.
+ * The netlists are added to the netlist manager in the order of the list
+ * after all of them are written, so that the netlist manager is the same
+ * regardless of the number of threads
+ *******************************************************************/
+static void print_spice_routing_module_tasks(
+  NetlistManager& netlist_manager, const ModuleManager& module_manager,
+  const std::vector<SpiceRoutingModuleTask>& tasks,
+  const std::string& subckt_dir, const size_t& num_threads) {
+  std::vector<std::string> netlist_names(tasks.size());
+
+  parallel_for(tasks.size(), num_threads, [&](const size_t& itask) {
+    const SpiceRoutingModuleTask& task = tasks[itask];
+    if (task.is_sb) {
+      netlist_names[itask] = print_spice_routing_switch_box_unique_module(
+        module_manager, subckt_dir, *task.rr_gsb);
+    } else {
+      netlist_names[itask] = print_spice_routing_connection_box_unique_module(
+        module_manager, subckt_dir, *task.rr_gsb, task.cb_type);
+    }
+  });
+
   /* Add fname to the netlist name list */
-  NetlistId nlist_id = netlist_manager.add_netlist(spice_fname);
-  VTR_ASSERT(NetlistId::INVALID() != nlist_id);
-  netlist_manager.set_netlist_type(nlist_id,
-                                   NetlistManager::ROUTING_MODULE_NETLIST);
+  for (const std::string& netlist_name : netlist_names) {
+    NetlistId nlist_id = netlist_manager.add_netlist(netlist_name);
+    VTR_ASSERT(NetlistId::INVALID() != nlist_id);
+    netlist_manager.set_netlist_type(nlist_id,
+                                     NetlistManager::ROUTING_MODULE_NETLIST);
+  }
 }
 
 /********************************************************************
  * Iterate over all the connection blocks in a device
- * and build a module for each of them
+ * and collect a netlist to write for each of them
  *******************************************************************/
-static void print_spice_flatten_connection_block_modules(
-  NetlistManager& netlist_manager, const ModuleManager& module_manager,
-  const DeviceRRGSB& device_rr_gsb, const std::string& subckt_dir,
-  const t_rr_type& cb_type) {
+static void collect_spice_flatten_connection_block_tasks(
+  std::vector<SpiceRoutingModuleTask>& tasks,
+  const DeviceRRGSB& device_rr_gsb, const t_rr_type& cb_type) {
   /* Build unique X-direction connection block modules */
   vtr::Point<size_t> cb_range = device_rr_gsb.get_gsb_range();
 
@@ -241,8 +279,7 @@ static void print_spice_flatten_connection_block_modules(
       if (true != rr_gsb.is_cb_exist(cb_type)) {
         continue;
       }
-      print_spice_routing_connection_box_unique_module(
-        netlist_manager, module_manager, subckt_dir, rr_gsb, cb_type);
+      tasks.push_back({&rr_gsb, false, cb_type});
     }
   }
 }
@@ -260,10 +297,9 @@ void print_spice_flatten_routing_modules(NetlistManager& netlist_manager,
                                          const ModuleManager& module_manager,
                                          const DeviceRRGSB& device_rr_gsb,
                                          const RRGraphView& rr_graph,
-                                         const std::string& subckt_dir) {
-  /* Create a vector to contain all the Verilog netlist names that have been
-   * generated in this function */
-  std::vector<std::string> netlist_names;
+                                         const std::string& subckt_dir,
+                                         const size_t& num_threads) {
+  std::vector<SpiceRoutingModuleTask> tasks;
 
   vtr::Point<size_t> sb_range = device_rr_gsb.get_gsb_range();
 
@@ -274,16 +310,16 @@ void print_spice_flatten_routing_modules(NetlistManager& netlist_manager,
       if (true != rr_gsb.is_sb_exist(rr_graph)) {
         continue;
       }
-      print_spice_routing_switch_box_unique_module(
-        netlist_manager, module_manager, subckt_dir, rr_gsb);
+      tasks.push_back({&rr_gsb, true, NUM_RR_TYPES});
     }
   }
 
-  print_spice_flatten_connection_block_modules(
-    netlist_manager, module_manager, device_rr_gsb, subckt_dir, CHANX);
+  collect_spice_flatten_connection_block_tasks(tasks, device_rr_gsb, CHANX);
+
+  collect_spice_flatten_connection_block_tasks(tasks, device_rr_gsb, CHANY);
 
-  print_spice_flatten_connection_block_modules(
-    netlist_manager, module_manager, device_rr_gsb, subckt_dir, CHANY);
+  print_spice_routing_module_tasks(netlist_manager, module_manager, tasks,
+                                   subckt_dir, num_threads);
 
   /*
   VTR_LOG("Writing header file for routing submodules '%s'...",
@@ -309,36 +345,33 @@ void print_spice_flatten_routing_modules(NetlistManager& netlist_manager,
 void print_spice_unique_routing_modules(NetlistManager& netlist_manager,
                                         const ModuleManager& module_manager,
                                         const DeviceRRGSB& device_rr_gsb,
-                                        const std::string& subckt_dir) {
-  /* Create a vector to contain all the Verilog netlist names that have been
-   * generated in this function */
-  std::vector<std::string> netlist_names;
+                                        const std::string& subckt_dir,
+                                        const size_t& num_threads) {
+  std::vector<SpiceRoutingModuleTask> tasks;
 
   /* Build unique switch block modules */
   for (size_t isb = 0; isb < device_rr_gsb.get_num_sb_unique_module(); ++isb) {
     const RRGSB& unique_mirror = device_rr_gsb.get_sb_unique_module(isb);
-    print_spice_routing_switch_box_unique_module(
-      netlist_manager, module_manager, subckt_dir, unique_mirror);
+    tasks.push_back({&unique_mirror, true, NUM_RR_TYPES});
   }
 
   /* Build unique X-direction connection block modules */
   for (size_t icb = 0; icb < device_rr_gsb.get_num_cb_unique_module(CHANX);
        ++icb) {
     const RRGSB& unique_mirror = device_rr_gsb.get_cb_unique_module(CHANX, icb);
-
-    print_spice_routing_connection_box_unique_module(
-      netlist_manager, module_manager, subckt_dir, unique_mirror, CHANX);
+    tasks.push_back({&unique_mirror, false, CHANX});
   }
 
   /* Build unique X-direction connection block modules */
   for (size_t icb = 0; icb < device_rr_gsb.get_num_cb_unique_module(CHANY);
        ++icb) {
     const RRGSB& unique_mirror = device_rr_gsb.get_cb_unique_module(CHANY, icb);
-
-    print_spice_routing_connection_box_unique_module(
-      netlist_manager, module_manager, subckt_dir, unique_mirror, CHANY);
+    tasks.push_back({&unique_mirror, false, CHANY});
   }
 
+  print_spice_routing_module_tasks(netlist_manager, module_manager, tasks,
+                                   subckt_dir, num_threads);
+
   /*
   VTR_LOG("Writing header file for routing submodules '%s'...",
           ROUTING_VERILOG_FILE_NAME);
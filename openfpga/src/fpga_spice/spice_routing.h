@@ -22,12 +22,14 @@ void print_spice_flatten_routing_modules(NetlistManager& netlist_manager,
                                          const ModuleManager& module_manager,
                                          const DeviceRRGSB& device_rr_gsb,
                                          const RRGraphView& rr_graph,
-                                         const std::string& subckt_dir);
+                                         const std::string& subckt_dir,
+                                         const size_t& num_threads = 1);
 
 void print_spice_unique_routing_modules(NetlistManager& netlist_manager,
                                         const ModuleManager& module_manager,
                                         const DeviceRRGSB& device_rr_gsb,
-                                        const std::string& subckt_dir);
+                                        const std::string& subckt_dir,
+                                        const size_t& num_threads = 1);
 
 } /* end namespace openfpga */
 
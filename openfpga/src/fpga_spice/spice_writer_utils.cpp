@@ -26,19 +26,31 @@ namespace openfpga {
 /************************************************
  * Generate header comments for a Spice netlist
  * include the description
+ * Netlists can be written by multiple threads, so the date is formatted
+ * in a local buffer rather than by std::ctime(), which uses a static one
  ***********************************************/
 void print_spice_file_header(std::fstream& fp, const std::string& usage) {
   VTR_ASSERT(true == valid_file_stream(fp));
 
   auto end = std::chrono::system_clock::now();
   std::time_t end_time = std::chrono::system_clock::to_time_t(end);
+  std::tm end_tm;
+#ifdef _WIN32
+  localtime_s(&end_tm, &end_time);
+#else
+  localtime_r(&end_time, &end_tm);
+#endif
+  /* Same format as std::ctime() */
+  char end_date[64];
+  std::strftime(end_date, sizeof(end_date), "%a %b %e %H:%M:%S %Y\n",
+                &end_tm);
 
   fp << "*********************************************" << std::endl;
   fp << "*\tFPGA-SPICE Netlist" << std::endl;
   fp << "*\tDescription: " << usage << std::endl;
   fp << "*\tAuthor: Xifan TANG" << std::endl;
   fp << "*\tOrganization: University of Utah" << std::endl;
-  fp << "*\tDate: " << std::ctime(&end_time);
+  fp << "*\tDate: " << end_date;
   fp << "*********************************************" << std::endl;
   fp << std::endl;
 }
@@ -16,6 +16,7 @@
 
 /* Headers from openfpgautil library */
 #include "openfpga_digest.h"
+#include "openfpga_trace.h"
 #include "openfpga_side_manager.h"
 
 /* Headers from vpr library */
@@ -86,6 +87,8 @@ static void print_verilog_primitive_block(
           verilog_fpath.c_str(), primitive_pb_graph_node->pb_type->name);
   VTR_LOGV(verbose, "\n");
 
+  OPENFPGA_TRACE_SCOPE_DETAIL("write_verilog_netlist", verilog_fpath);
+
   /* Create the file stream */
   std::fstream fp;
   fp.open(verilog_fpath, std::fstream::out | std::fstream::trunc);
@@ -204,6 +207,8 @@ static void rec_print_verilog_logical_tile(
           verilog_fpath.c_str(), physical_pb_type->name);
   VTR_LOGV(verbose, "\n");
 
+  OPENFPGA_TRACE_SCOPE_DETAIL("write_verilog_netlist", verilog_fpath);
+
   /* Create the file stream */
   std::fstream fp;
   fp.open(verilog_fpath, std::fstream::out | std::fstream::trunc);
@@ -322,6 +327,8 @@ static void print_verilog_physical_tile_netlist(
             verilog_fpath.c_str(), phy_block_type->name.c_str());
   }
 
+  OPENFPGA_TRACE_SCOPE_DETAIL("write_verilog_netlist", verilog_fpath);
+
   /* Create the file stream */
   std::fstream fp;
   fp.open(verilog_fpath, std::fstream::out | std::fstream::trunc);
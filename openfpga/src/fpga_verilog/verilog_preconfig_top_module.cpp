@@ -135,6 +135,140 @@ static void print_verilog_preconfig_top_module_ports(
   fp << std::endl;
 }
 
+/********************************************************************
+ * Impose the bitstream of a block on its configuration memories
+ * using either 'force' or '$deposit' syntax, e.g.,
+ *   force <block_path>.mem_out[0:3] = 4'b0101;
+ *   $deposit(<block_path>.mem_out[0:3], 4'b0101);
+ * The constant values are streamed to the file directly, in the same
+ * format as generate_verilog_constant_values()
+ *******************************************************************/
+static void print_verilog_preconfig_block_bits(
+  std::fstream &fp, const std::string &port_name,
+  const BitstreamManager &bitstream_manager,
+  const std::vector<ConfigBitId> &block_bits, const bool &inverted,
+  const bool &use_deposit) {
+  BasicPort config_port(port_name, block_bits.size());
+
+  /* Identify if all the values are the same, which can be in short format */
+  bool first_val = (inverted != bitstream_manager.bit_value(block_bits.back()));
+  bool same_values = (1 < block_bits.size());
+  for (const ConfigBitId &config_bit : block_bits) {
+    if (first_val != (inverted != bitstream_manager.bit_value(config_bit))) {
+      same_values = false;
+      break;
+    }
+  }
+
+  fp << "\t";
+  if (true == use_deposit) {
+    fp << "$deposit(";
+    fp << generate_verilog_port(VERILOG_PORT_CONKT, config_port);
+    fp << ", ";
+  } else {
+    fp << "force ";
+    fp << generate_verilog_port(VERILOG_PORT_CONKT, config_port);
+    fp << " = ";
+  }
+
+  if (true == same_values) {
+    fp << "{" << block_bits.size() << "{1'b" << (first_val ? '1' : '0')
+       << "}}";
+  } else {
+    fp << block_bits.size() << "'b";
+    for (const ConfigBitId &config_bit : block_bits) {
+      fp << ((inverted != bitstream_manager.bit_value(config_bit)) ? '1'
+                                                                   : '0');
+    }
+  }
+
+  if (true == use_deposit) {
+    fp << ")";
+  }
+  fp << ";\n";
+}
+
+/********************************************************************
+ * Walk through the block hierarchy of the bitstream manager and impose
+ * the bitstream of each block on its configuration memories.
+ * The hierarchical path of a block is kept in a buffer shared by all the
+ * blocks: the name of a block is appended when descending and truncated
+ * when returning, so that the path of each block is built only once.
+ * The block with the top block name is replaced by the instance name of
+ * the FPGA fabric in the path.
+ *******************************************************************/
+static void rec_print_verilog_preconfig_top_module_bitstream(
+  std::fstream &fp, const std::string &top_block_name,
+  const BitstreamManager &bitstream_manager, const ConfigBlockId &block,
+  std::string &block_path, const bool &under_top_block,
+  const bool &output_datab_bits, const bool &use_deposit) {
+  size_t parent_path_length = block_path.size();
+  std::string parent_path;
+  bool is_top_block = (top_block_name == bitstream_manager.block_name(block));
+  if (true == is_top_block) {
+    parent_path.swap(block_path);
+    block_path = std::string(FORMAL_VERIFICATION_TOP_MODULE_UUT_NAME);
+  } else {
+    block_path += std::string(".");
+    block_path += bitstream_manager.block_name(block);
+  }
+  bool under_top = under_top_block || is_top_block;
+
+  /* We only cares blocks with configuration bits */
+  std::vector<ConfigBitId> block_bits = bitstream_manager.block_bits(block);
+  if (false == block_bits.empty()) {
+    /* Ensure that the block is under the module we want to drop! */
+    VTR_ASSERT(true == under_top);
+    size_t block_path_length = block_path.size();
+
+    /* Wire it to the configuration bit: access both data out and data outb
+     * ports */
+    block_path += std::string(".");
+    block_path += generate_configurable_memory_data_out_name();
+    print_verilog_preconfig_block_bits(fp, block_path, bitstream_manager,
+                                       block_bits, false, use_deposit);
+    block_path.resize(block_path_length);
+
+    if (true == output_datab_bits) {
+      block_path += std::string(".");
+      block_path += generate_configurable_memory_inverted_data_out_name();
+      print_verilog_preconfig_block_bits(fp, block_path, bitstream_manager,
+                                         block_bits, true, use_deposit);
+      block_path.resize(block_path_length);
+    }
+  }
+
+  for (const ConfigBlockId &child_block :
+       bitstream_manager.block_children(block)) {
+    rec_print_verilog_preconfig_top_module_bitstream(
+      fp, top_block_name, bitstream_manager, child_block, block_path,
+      under_top, output_datab_bits, use_deposit);
+  }
+
+  /* Restore the path of the parent block */
+  if (true == is_top_block) {
+    block_path.swap(parent_path);
+  } else {
+    block_path.resize(parent_path_length);
+  }
+}
+
+/********************************************************************
+ * Impose the bitstream on the configuration memories of all the blocks
+ *******************************************************************/
+static void print_verilog_preconfig_top_module_block_bitstream(
+  std::fstream &fp, const std::string &top_block_name,
+  const BitstreamManager &bitstream_manager, const bool &output_datab_bits,
+  const bool &use_deposit) {
+  std::string block_path;
+  for (const ConfigBlockId &top_block :
+       find_bitstream_manager_top_blocks(bitstream_manager)) {
+    rec_print_verilog_preconfig_top_module_bitstream(
+      fp, top_block_name, bitstream_manager, top_block, block_path, false,
+      output_datab_bits, use_deposit);
+  }
+}
+
 /********************************************************************
  * Impose the bitstream on the configuration memories
  * This function uses 'assign' syntax to impost the bitstream at mem port
@@ -152,58 +286,8 @@ static void print_verilog_preconfig_top_module_force_bitstream(
 
   fp << "initial begin" << std::endl;
 
-  for (const ConfigBlockId &config_block_id : bitstream_manager.blocks()) {
-    /* We only cares blocks with configuration bits */
-    if (0 == bitstream_manager.block_bits(config_block_id).size()) {
-      continue;
-    }
-    /* Build the hierarchical path of the configuration bit in modules */
-    std::vector<ConfigBlockId> block_hierarchy =
-      find_bitstream_manager_block_hierarchy(bitstream_manager, config_block_id,
-                                             top_block_name);
-    /* Ensure that this is the module we want to drop! */
-    VTR_ASSERT(top_block_name ==
-               bitstream_manager.block_name(block_hierarchy[0]));
-    block_hierarchy.erase(block_hierarchy.begin());
-    /* Build the full hierarchy path */
-    std::string bit_hierarchy_path(FORMAL_VERIFICATION_TOP_MODULE_UUT_NAME);
-    for (const ConfigBlockId &temp_block : block_hierarchy) {
-      bit_hierarchy_path += std::string(".");
-      bit_hierarchy_path += bitstream_manager.block_name(temp_block);
-    }
-    bit_hierarchy_path += std::string(".");
-
-    /* Find the bit index in the parent block */
-    BasicPort config_data_port(
-      bit_hierarchy_path + generate_configurable_memory_data_out_name(),
-      bitstream_manager.block_bits(config_block_id).size());
-
-    /* Wire it to the configuration bit: access both data out and data outb
-     * ports */
-    std::vector<size_t> config_data_values;
-    for (const ConfigBitId config_bit :
-         bitstream_manager.block_bits(config_block_id)) {
-      config_data_values.push_back(bitstream_manager.bit_value(config_bit));
-    }
-    print_verilog_force_wire_constant_values(fp, config_data_port,
-                                             config_data_values);
-
-    if (true == output_datab_bits) {
-      /* Find the bit index in the parent block */
-      BasicPort config_datab_port(
-        bit_hierarchy_path +
-          generate_configurable_memory_inverted_data_out_name(),
-        bitstream_manager.block_bits(config_block_id).size());
-
-      std::vector<size_t> config_datab_values;
-      for (const ConfigBitId config_bit :
-           bitstream_manager.block_bits(config_block_id)) {
-        config_datab_values.push_back(!bitstream_manager.bit_value(config_bit));
-      }
-      print_verilog_force_wire_constant_values(fp, config_datab_port,
-                                               config_datab_values);
-    }
-  }
+  print_verilog_preconfig_top_module_block_bitstream(
+    fp, top_block_name, bitstream_manager, output_datab_bits, false);
 
   fp << "end" << std::endl;
 
@@ -228,63 +312,8 @@ static void print_verilog_preconfig_top_module_deposit_bitstream(
 
   fp << "initial begin" << std::endl;
 
-  for (const ConfigBlockId &config_block_id : bitstream_manager.blocks()) {
-    /* We only cares blocks with configuration bits */
-    if (0 == bitstream_manager.block_bits(config_block_id).size()) {
-      continue;
-    }
-    /* Build the hierarchical path of the configuration bit in modules */
-    std::vector<ConfigBlockId> block_hierarchy =
-      find_bitstream_manager_block_hierarchy(bitstream_manager, config_block_id,
-                                             top_block_name);
-    /* Drop the first block, which is the top module, it should be replaced by
-     * the instance name here */
-    /* Ensure that this is the module we want to drop! */
-    VTR_ASSERT(top_block_name ==
-               bitstream_manager.block_name(block_hierarchy[0]));
-    block_hierarchy.erase(block_hierarchy.begin());
-
-    /* Build the full hierarchy path */
-    std::string bit_hierarchy_path(FORMAL_VERIFICATION_TOP_MODULE_UUT_NAME);
-    for (const ConfigBlockId &temp_block : block_hierarchy) {
-      bit_hierarchy_path += std::string(".");
-      bit_hierarchy_path += bitstream_manager.block_name(temp_block);
-    }
-    bit_hierarchy_path += std::string(".");
-
-    /* Find the bit index in the parent block */
-    BasicPort config_data_port(
-      bit_hierarchy_path + generate_configurable_memory_data_out_name(),
-      bitstream_manager.block_bits(config_block_id).size());
-
-    /* Wire it to the configuration bit: access both data out and data outb
-     * ports */
-    std::vector<size_t> config_data_values;
-    for (const ConfigBitId config_bit :
-         bitstream_manager.block_bits(config_block_id)) {
-      config_data_values.push_back(bitstream_manager.bit_value(config_bit));
-    }
-    print_verilog_deposit_wire_constant_values(fp, config_data_port,
-                                               config_data_values);
-
-    /* Skip datab ports if specified */
-    if (false == output_datab_bits) {
-      continue;
-    }
-
-    BasicPort config_datab_port(
-      bit_hierarchy_path +
-        generate_configurable_memory_inverted_data_out_name(),
-      bitstream_manager.block_bits(config_block_id).size());
-
-    std::vector<size_t> config_datab_values;
-    for (const ConfigBitId config_bit :
-         bitstream_manager.block_bits(config_block_id)) {
-      config_datab_values.push_back(!bitstream_manager.bit_value(config_bit));
-    }
-    print_verilog_deposit_wire_constant_values(fp, config_datab_port,
-                                               config_datab_values);
-  }
+  print_verilog_preconfig_top_module_block_bitstream(
+    fp, top_block_name, bitstream_manager, output_datab_bits, true);
 
   fp << "end" << std::endl;
 
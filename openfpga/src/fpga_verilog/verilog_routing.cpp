@@ -9,6 +9,7 @@
 
 /* Headers from openfpgautil library */
 #include "openfpga_digest.h"
+#include "openfpga_trace.h"
 
 /* Include FPGA-Verilog header files*/
 #include "openfpga_naming.h"
@@ -95,6 +96,8 @@ static void print_verilog_routing_connection_box_unique_module(
 
   std::string verilog_fpath(subckt_dir + verilog_fname);
 
+  OPENFPGA_TRACE_SCOPE_DETAIL("write_verilog_netlist", verilog_fpath);
+
   /* Create the file stream */
   std::fstream fp;
   fp.open(verilog_fpath, std::fstream::out | std::fstream::trunc);
@@ -214,6 +217,8 @@ static void print_verilog_routing_switch_box_unique_module(
   }
   std::string verilog_fpath(subckt_dir + verilog_fname);
 
+  OPENFPGA_TRACE_SCOPE_DETAIL("write_verilog_netlist", verilog_fpath);
+
   /* Create the file stream */
   std::fstream fp;
   fp.open(verilog_fpath, std::fstream::out | std::fstream::trunc);
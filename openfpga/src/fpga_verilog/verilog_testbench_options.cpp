@@ -19,6 +19,7 @@ VerilogTestbenchOption::VerilogTestbenchOption() {
   dut_module_ = "fpga_top";
   fabric_netlist_file_path_.clear();
   reference_benchmark_file_path_.clear();
+  hex_bitstream_ = false;
   print_preconfig_top_testbench_ = false;
   print_formal_verification_top_netlist_ = false;
   print_top_testbench_ = false;
@@ -72,6 +73,8 @@ bool VerilogTestbenchOption::fast_configuration() const {
   return fast_configuration_;
 }
 
+bool VerilogTestbenchOption::hex_bitstream() const { return hex_bitstream_; }
+
 bool VerilogTestbenchOption::print_simulation_ini() const {
   return !simulation_ini_path_.empty();
 }
@@ -176,6 +179,10 @@ void VerilogTestbenchOption::set_fast_configuration(const bool& enabled) {
   fast_configuration_ = enabled;
 }
 
+void VerilogTestbenchOption::set_hex_bitstream(const bool& enabled) {
+  hex_bitstream_ = enabled;
+}
+
 void VerilogTestbenchOption::set_print_preconfig_top_testbench(
   const bool& enabled) {
   print_preconfig_top_testbench_ =
@@ -52,6 +52,7 @@ class VerilogTestbenchOption {
   std::string fabric_netlist_file_path() const;
   std::string reference_benchmark_file_path() const;
   bool fast_configuration() const;
+  bool hex_bitstream() const;
   bool print_formal_verification_top_netlist() const;
   bool print_preconfig_top_testbench() const;
   bool print_top_testbench() const;
@@ -95,6 +96,9 @@ class VerilogTestbenchOption {
    * verification top netlist is enabled */
   void set_print_preconfig_top_testbench(const bool& enabled);
   void set_fast_configuration(const bool& enabled);
+  /* The bitstream file is written in hexadecimal digits, which should be
+   * loaded by $readmemh rather than $readmemb */
+  void set_hex_bitstream(const bool& enabled);
   void set_print_top_testbench(const bool& enabled);
   void set_print_simulation_ini(const std::string& simulation_ini_path);
   void set_explicit_port_mapping(const bool& enabled);
@@ -127,6 +131,7 @@ class VerilogTestbenchOption {
   std::string fabric_netlist_file_path_;
   std::string reference_benchmark_file_path_;
   bool fast_configuration_;
+  bool hex_bitstream_;
   bool print_formal_verification_top_netlist_;
   bool print_preconfig_top_testbench_;
   bool print_top_testbench_;
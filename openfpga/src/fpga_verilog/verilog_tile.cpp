@@ -10,6 +10,7 @@
 
 #include "command_exit_codes.h"
 #include "openfpga_digest.h"
+#include "openfpga_trace.h"
 #include "openfpga_naming.h"
 #include "verilog_constants.h"
 #include "verilog_module_writer.h"
@@ -48,6 +49,8 @@ static int print_verilog_tile_module_netlist(
   VTR_LOG("Writing Verilog netlist '%s' for tile module '%s'...",
           verilog_fpath.c_str(), tile_module_name.c_str());
 
+  OPENFPGA_TRACE_SCOPE_DETAIL("write_verilog_netlist", verilog_fpath);
+
   /* Create the file stream */
   std::fstream fp;
   fp.open(verilog_fpath, std::fstream::out | std::fstream::trunc);
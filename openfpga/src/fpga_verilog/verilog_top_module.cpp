@@ -12,6 +12,7 @@
 
 /* Headers from openfpgautil library */
 #include "openfpga_digest.h"
+#include "openfpga_trace.h"
 #include "openfpga_naming.h"
 #include "verilog_constants.h"
 #include "verilog_module_writer.h"
@@ -51,6 +52,8 @@ void print_verilog_core_module(NetlistManager& netlist_manager,
   VTR_LOG("Writing Verilog netlist for wrapper module of FPGA fabric '%s'...",
           verilog_fpath.c_str());
 
+  OPENFPGA_TRACE_SCOPE_DETAIL("write_verilog_netlist", verilog_fpath);
+
   /* Create the file stream */
   std::fstream fp;
   fp.open(verilog_fpath, std::fstream::out | std::fstream::trunc);
@@ -115,6 +118,8 @@ void print_verilog_top_module(NetlistManager& netlist_manager,
   VTR_LOG("Writing Verilog netlist for top-level module of FPGA fabric '%s'...",
           verilog_fpath.c_str());
 
+  OPENFPGA_TRACE_SCOPE_DETAIL("write_verilog_netlist", verilog_fpath);
+
   /* Create the file stream */
   std::fstream fp;
   fp.open(verilog_fpath, std::fstream::out | std::fstream::trunc);
@@ -979,8 +979,7 @@ static void print_verilog_top_testbench_ports(
  *******************************************************************/
 static size_t calculate_num_config_clock_cycles(
   const ConfigProtocol& config_protocol, const bool& fast_configuration,
-  const bool& bit_value_to_skip, const BitstreamManager& bitstream_manager,
-  const FabricBitstream& fabric_bitstream) {
+  const bool& bit_value_to_skip, const FabricBitstream& fabric_bitstream) {
   /* Find the longest regional bitstream */
   size_t regional_bitstream_max_size =
     find_fabric_regional_bitstream_max_size(fabric_bitstream);
@@ -1021,13 +1020,13 @@ static size_t calculate_num_config_clock_cycles(
          */
         size_t num_bits_to_skip =
           find_configuration_chain_fabric_bitstream_size_to_be_skipped(
-            fabric_bitstream, bitstream_manager, bit_value_to_skip);
+            fabric_bitstream, bit_value_to_skip);
 
         if (config_protocol.num_prog_clocks() > 1) {
           num_bits_to_skip =
             config_protocol.num_prog_clocks() *
             find_configuration_chain_fabric_bitstream_size_to_be_skipped(
-              fabric_bitstream, bitstream_manager, bit_value_to_skip);
+              fabric_bitstream, bit_value_to_skip);
         }
 
         num_config_clock_cycles =
@@ -1473,8 +1472,8 @@ static int print_verilog_top_testbench_configuration_protocol_stimulus(
  *******************************************************************/
 static void print_verilog_full_testbench_vanilla_bitstream(
   std::fstream& fp, const std::string& bitstream_file,
-  const ModuleManager& module_manager, const ModuleId& top_module,
-  const FabricBitstream& fabric_bitstream) {
+  const bool& hex_bitstream, const ModuleManager& module_manager,
+  const ModuleId& top_module, const FabricBitstream& fabric_bitstream) {
   /* Validate the file stream */
   valid_file_stream(fp);
 
@@ -1525,8 +1524,9 @@ static void print_verilog_full_testbench_vanilla_bitstream(
   print_verilog_comment(
     fp, "----- Preload bitstream file to a virtual memory -----");
   fp << "\t";
-  fp << "$readmemb(\"" << bitstream_file << "\", "
-     << TOP_TB_BITSTREAM_MEM_REG_NAME << ");";
+  fp << generate_verilog_readmem(bitstream_file,
+                                 std::string(TOP_TB_BITSTREAM_MEM_REG_NAME),
+                                 hex_bitstream);
   fp << std::endl;
 
   fp << "\t\t@(negedge "
@@ -1588,9 +1588,9 @@ static void print_verilog_full_testbench_vanilla_bitstream(
  *******************************************************************/
 static void print_verilog_full_testbench_configuration_chain_bitstream(
   std::fstream& fp, const std::string& bitstream_file,
-  const bool& fast_configuration, const bool& bit_value_to_skip,
-  const ModuleManager& module_manager, const ModuleId& top_module,
-  const BitstreamManager& bitstream_manager,
+  const bool& hex_bitstream, const bool& fast_configuration,
+  const bool& bit_value_to_skip, const ModuleManager& module_manager,
+  const ModuleId& top_module, const BitstreamManager& bitstream_manager,
   const FabricBitstream& fabric_bitstream,
   const ConfigProtocol& config_protocol) {
   /* Validate the file stream */
@@ -1608,7 +1608,7 @@ static void print_verilog_full_testbench_configuration_chain_bitstream(
   if (true == fast_configuration) {
     num_bits_to_skip =
       find_configuration_chain_fabric_bitstream_size_to_be_skipped(
-        fabric_bitstream, bitstream_manager, bit_value_to_skip);
+        fabric_bitstream, bit_value_to_skip);
   }
   VTR_ASSERT(num_bits_to_skip < regional_bitstream_max_size);
 
@@ -1677,8 +1677,9 @@ static void print_verilog_full_testbench_configuration_chain_bitstream(
     fp, "----- Preload bitstream file to a virtual memory -----");
   fp << "initial begin" << std::endl;
   fp << "\t";
-  fp << "$readmemb(\"" << bitstream_file << "\", "
-     << TOP_TB_BITSTREAM_MEM_REG_NAME << ");";
+  fp << generate_verilog_readmem(bitstream_file,
+                                 std::string(TOP_TB_BITSTREAM_MEM_REG_NAME),
+                                 hex_bitstream);
   fp << std::endl;
 
   print_verilog_comment(fp, "----- Configuration chain default input -----");
@@ -1992,9 +1993,9 @@ static void print_verilog_full_testbench_configuration_chain_bitstream(
  *******************************************************************/
 static void print_verilog_full_testbench_memory_bank_bitstream(
   std::fstream& fp, const std::string& bitstream_file,
-  const bool& fast_configuration, const bool& bit_value_to_skip,
-  const ModuleManager& module_manager, const ModuleId& top_module,
-  const FabricBitstream& fabric_bitstream) {
+  const bool& hex_bitstream, const bool& fast_configuration,
+  const bool& bit_value_to_skip, const ModuleManager& module_manager,
+  const ModuleId& top_module, const FabricBitstream& fabric_bitstream) {
   /* Validate the file stream */
   valid_file_stream(fp);
 
@@ -2055,8 +2056,9 @@ static void print_verilog_full_testbench_memory_bank_bitstream(
     fp, "----- Preload bitstream file to a virtual memory -----");
   fp << "initial begin" << std::endl;
   fp << "\t";
-  fp << "$readmemb(\"" << bitstream_file << "\", "
-     << TOP_TB_BITSTREAM_MEM_REG_NAME << ");";
+  fp << generate_verilog_readmem(bitstream_file,
+                                 std::string(TOP_TB_BITSTREAM_MEM_REG_NAME),
+                                 hex_bitstream);
   fp << std::endl;
 
   print_verilog_comment(fp, "----- Bit-Line Address port default input -----");
@@ -2153,9 +2155,9 @@ static void print_verilog_full_testbench_memory_bank_bitstream(
  *******************************************************************/
 static void print_verilog_full_testbench_frame_decoder_bitstream(
   std::fstream& fp, const std::string& bitstream_file,
-  const bool& fast_configuration, const bool& bit_value_to_skip,
-  const ModuleManager& module_manager, const ModuleId& top_module,
-  const FabricBitstream& fabric_bitstream) {
+  const bool& hex_bitstream, const bool& fast_configuration,
+  const bool& bit_value_to_skip, const ModuleManager& module_manager,
+  const ModuleId& top_module, const FabricBitstream& fabric_bitstream) {
   /* Validate the file stream */
   valid_file_stream(fp);
 
@@ -2208,8 +2210,9 @@ static void print_verilog_full_testbench_frame_decoder_bitstream(
     fp, "----- Preload bitstream file to a virtual memory -----");
   fp << "initial begin" << std::endl;
   fp << "\t";
-  fp << "$readmemb(\"" << bitstream_file << "\", "
-     << TOP_TB_BITSTREAM_MEM_REG_NAME << ");";
+  fp << generate_verilog_readmem(bitstream_file,
+                                 std::string(TOP_TB_BITSTREAM_MEM_REG_NAME),
+                                 hex_bitstream);
   fp << std::endl;
 
   print_verilog_comment(fp, "----- Address port default input -----");
@@ -2298,39 +2301,41 @@ static void print_verilog_full_testbench_frame_decoder_bitstream(
  *******************************************************************/
 static void print_verilog_full_testbench_bitstream(
   std::fstream& fp, const std::string& bitstream_file,
-  const ConfigProtocol& config_protocol, const bool& fast_configuration,
-  const bool& bit_value_to_skip, const ModuleManager& module_manager,
-  const ModuleId& top_module, const BitstreamManager& bitstream_manager,
+  const bool& hex_bitstream, const ConfigProtocol& config_protocol,
+  const bool& fast_configuration, const bool& bit_value_to_skip,
+  const ModuleManager& module_manager, const ModuleId& top_module,
+  const BitstreamManager& bitstream_manager,
   const FabricBitstream& fabric_bitstream,
   const MemoryBankShiftRegisterBanks& blwl_sr_banks) {
   /* Branch on the type of configuration protocol */
   switch (config_protocol.type()) {
     case CONFIG_MEM_STANDALONE:
       print_verilog_full_testbench_vanilla_bitstream(
-        fp, bitstream_file, module_manager, top_module, fabric_bitstream);
+        fp, bitstream_file, hex_bitstream, module_manager, top_module,
+        fabric_bitstream);
 
       break;
     case CONFIG_MEM_SCAN_CHAIN:
       print_verilog_full_testbench_configuration_chain_bitstream(
-        fp, bitstream_file, fast_configuration, bit_value_to_skip,
-        module_manager, top_module, bitstream_manager, fabric_bitstream,
-        config_protocol);
+        fp, bitstream_file, hex_bitstream, fast_configuration,
+        bit_value_to_skip, module_manager, top_module, bitstream_manager,
+        fabric_bitstream, config_protocol);
       break;
     case CONFIG_MEM_MEMORY_BANK:
       print_verilog_full_testbench_memory_bank_bitstream(
-        fp, bitstream_file, fast_configuration, bit_value_to_skip,
-        module_manager, top_module, fabric_bitstream);
+        fp, bitstream_file, hex_bitstream, fast_configuration,
+        bit_value_to_skip, module_manager, top_module, fabric_bitstream);
       break;
     case CONFIG_MEM_QL_MEMORY_BANK:
       print_verilog_full_testbench_ql_memory_bank_bitstream(
-        fp, bitstream_file, config_protocol, fast_configuration,
+        fp, bitstream_file, hex_bitstream, config_protocol, fast_configuration,
         bit_value_to_skip, module_manager, top_module, fabric_bitstream,
         blwl_sr_banks);
       break;
     case CONFIG_MEM_FRAME_BASED:
       print_verilog_full_testbench_frame_decoder_bitstream(
-        fp, bitstream_file, fast_configuration, bit_value_to_skip,
-        module_manager, top_module, fabric_bitstream);
+        fp, bitstream_file, hex_bitstream, fast_configuration,
+        bit_value_to_skip, module_manager, top_module, fabric_bitstream);
 
       break;
     default:
@@ -2527,8 +2532,7 @@ int print_verilog_full_testbench(
   bool bit_value_to_skip = false;
   if (true == apply_fast_configuration) {
     bit_value_to_skip = find_bit_value_to_skip_for_fast_configuration(
-      config_protocol.type(), global_ports, bitstream_manager,
-      fabric_bitstream);
+      config_protocol.type(), global_ports, fabric_bitstream);
   }
 
   /* Start of testbench */
@@ -2553,7 +2557,7 @@ int print_verilog_full_testbench(
   /* Estimate the number of configuration clock cycles */
   size_t num_config_clock_cycles = calculate_num_config_clock_cycles(
     config_protocol, apply_fast_configuration, bit_value_to_skip,
-    bitstream_manager, fabric_bitstream);
+    fabric_bitstream);
 
   /* Generate stimuli for general control signals */
   print_verilog_top_testbench_generic_stimulus(
@@ -2625,9 +2629,9 @@ int print_verilog_full_testbench(
 
   /* load bitstream to FPGA fabric in a configuration phase */
   print_verilog_full_testbench_bitstream(
-    fp, bitstream_file, config_protocol, apply_fast_configuration,
-    bit_value_to_skip, module_manager, core_module, bitstream_manager,
-    fabric_bitstream, blwl_sr_banks);
+    fp, bitstream_file, options.hex_bitstream(), config_protocol,
+    apply_fast_configuration, bit_value_to_skip, module_manager, core_module,
+    bitstream_manager, fabric_bitstream, blwl_sr_banks);
 
   /* Add signal initialization:
    * Bypass writing codes to files due to the autogenerated codes are very
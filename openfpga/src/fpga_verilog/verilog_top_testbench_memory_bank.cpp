@@ -566,9 +566,9 @@ int print_verilog_top_testbench_configuration_protocol_ql_memory_bank_stimulus(
  * BL/WLs */
 static void print_verilog_full_testbench_ql_memory_bank_flatten_bitstream(
   std::fstream& fp, const std::string& bitstream_file,
-  const bool& fast_configuration, const bool& bit_value_to_skip,
-  const ModuleManager& module_manager, const ModuleId& top_module,
-  const FabricBitstream& fabric_bitstream) {
+  const bool& hex_bitstream, const bool& fast_configuration,
+  const bool& bit_value_to_skip, const ModuleManager& module_manager,
+  const ModuleId& top_module, const FabricBitstream& fabric_bitstream) {
   /* Validate the file stream */
   valid_file_stream(fp);
 
@@ -634,8 +634,9 @@ static void print_verilog_full_testbench_ql_memory_bank_flatten_bitstream(
     fp, "----- Preload bitstream file to a virtual memory -----");
   fp << "initial begin" << std::endl;
   fp << "\t";
-  fp << "$readmemb(\"" << bitstream_file << "\", "
-     << TOP_TB_BITSTREAM_MEM_REG_NAME << ");";
+  fp << generate_verilog_readmem(bitstream_file,
+                                 std::string(TOP_TB_BITSTREAM_MEM_REG_NAME),
+                                 hex_bitstream);
   fp << std::endl;
 
   print_verilog_comment(fp, "----- Bit-Line Address port default input -----");
@@ -1086,9 +1087,9 @@ print_verilog_full_testbench_ql_memory_bank_shift_register_bitstream(
  * decoders */
 static void print_verilog_full_testbench_ql_memory_bank_decoder_bitstream(
   std::fstream& fp, const std::string& bitstream_file,
-  const bool& fast_configuration, const bool& bit_value_to_skip,
-  const ModuleManager& module_manager, const ModuleId& top_module,
-  const FabricBitstream& fabric_bitstream) {
+  const bool& hex_bitstream, const bool& fast_configuration,
+  const bool& bit_value_to_skip, const ModuleManager& module_manager,
+  const ModuleId& top_module, const FabricBitstream& fabric_bitstream) {
   /* Validate the file stream */
   valid_file_stream(fp);
 
@@ -1149,8 +1150,9 @@ static void print_verilog_full_testbench_ql_memory_bank_decoder_bitstream(
     fp, "----- Preload bitstream file to a virtual memory -----");
   fp << "initial begin" << std::endl;
   fp << "\t";
-  fp << "$readmemb(\"" << bitstream_file << "\", "
-     << TOP_TB_BITSTREAM_MEM_REG_NAME << ");";
+  fp << generate_verilog_readmem(bitstream_file,
+                                 std::string(TOP_TB_BITSTREAM_MEM_REG_NAME),
+                                 hex_bitstream);
   fp << std::endl;
 
   print_verilog_comment(fp, "----- Bit-Line Address port default input -----");
@@ -1243,24 +1245,31 @@ static void print_verilog_full_testbench_ql_memory_bank_decoder_bitstream(
 
 void print_verilog_full_testbench_ql_memory_bank_bitstream(
   std::fstream& fp, const std::string& bitstream_file,
-  const ConfigProtocol& config_protocol, const bool& fast_configuration,
-  const bool& bit_value_to_skip, const ModuleManager& module_manager,
-  const ModuleId& top_module, const FabricBitstream& fabric_bitstream,
+  const bool& hex_bitstream, const ConfigProtocol& config_protocol,
+  const bool& fast_configuration, const bool& bit_value_to_skip,
+  const ModuleManager& module_manager, const ModuleId& top_module,
+  const FabricBitstream& fabric_bitstream,
   const MemoryBankShiftRegisterBanks& blwl_sr_banks) {
   if ((BLWL_PROTOCOL_DECODER == config_protocol.bl_protocol_type()) &&
       (BLWL_PROTOCOL_DECODER == config_protocol.wl_protocol_type())) {
     print_verilog_full_testbench_ql_memory_bank_decoder_bitstream(
-      fp, bitstream_file, fast_configuration, bit_value_to_skip, module_manager,
-      top_module, fabric_bitstream);
+      fp, bitstream_file, hex_bitstream, fast_configuration, bit_value_to_skip,
+      module_manager, top_module, fabric_bitstream);
   } else if ((BLWL_PROTOCOL_FLATTEN == config_protocol.bl_protocol_type()) &&
              (BLWL_PROTOCOL_FLATTEN == config_protocol.wl_protocol_type())) {
     print_verilog_full_testbench_ql_memory_bank_flatten_bitstream(
-      fp, bitstream_file, fast_configuration, bit_value_to_skip, module_manager,
-      top_module, fabric_bitstream);
+      fp, bitstream_file, hex_bitstream, fast_configuration, bit_value_to_skip,
+      module_manager, top_module, fabric_bitstream);
   } else if ((BLWL_PROTOCOL_SHIFT_REGISTER ==
               config_protocol.bl_protocol_type()) &&
              (BLWL_PROTOCOL_SHIFT_REGISTER ==
               config_protocol.wl_protocol_type())) {
+    /* The shift register banks are loaded from a binary bitstream only */
+    if (hex_bitstream) {
+      VTR_LOG_WARN(
+        "Hexadecimal bitstream is not supported by memory bank using shift "
+        "registers! Load the bitstream file in binary format.\n");
+    }
     print_verilog_full_testbench_ql_memory_bank_shift_register_bitstream(
       fp, bitstream_file, fast_configuration, bit_value_to_skip, module_manager,
       top_module, fabric_bitstream, blwl_sr_banks);
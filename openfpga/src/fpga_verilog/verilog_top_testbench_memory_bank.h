@@ -63,9 +63,10 @@ int print_verilog_top_testbench_configuration_protocol_ql_memory_bank_stimulus(
  */
 void print_verilog_full_testbench_ql_memory_bank_bitstream(
   std::fstream& fp, const std::string& bitstream_file,
-  const ConfigProtocol& config_protocol, const bool& fast_configuration,
-  const bool& bit_value_to_skip, const ModuleManager& module_manager,
-  const ModuleId& top_module, const FabricBitstream& fabric_bitstream,
+  const bool& hex_bitstream, const ConfigProtocol& config_protocol,
+  const bool& fast_configuration, const bool& bit_value_to_skip,
+  const ModuleManager& module_manager, const ModuleId& top_module,
+  const FabricBitstream& fabric_bitstream,
   const MemoryBankShiftRegisterBanks& blwl_sr_banks);
 
 } /* end namespace openfpga */
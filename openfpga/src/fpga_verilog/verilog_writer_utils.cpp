@@ -815,6 +815,19 @@ std::string generate_verilog_ports_constant_values(
   return port_str;
 }
 
+/********************************************************************
+ * Generate a system task to load a file into a memory, e.g.,
+ *   $readmemb("<file_name>", <mem_name>);
+ * Use $readmemh when the file is written in hexadecimal digits
+ *******************************************************************/
+std::string generate_verilog_readmem(const std::string& file_name,
+                                     const std::string& mem_name,
+                                     const bool& hex) {
+  std::string readmem_str(hex ? "$readmemh" : "$readmemb");
+  readmem_str += "(\"" + file_name + "\", " + mem_name + ");";
+  return readmem_str;
+}
+
 /********************************************************************
  * Generate a wire connection, that assigns constant values to a
  * Verilog port
@@ -119,6 +119,10 @@ std::string generate_verilog_ports_constant_values(
   const std::vector<BasicPort>& output_ports,
   const std::vector<size_t>& const_values, const bool& is_register = false);
 
+std::string generate_verilog_readmem(const std::string& file_name,
+                                     const std::string& mem_name,
+                                     const bool& hex = false);
+
 void print_verilog_wire_constant_values(
   std::fstream& fp, const BasicPort& output_port,
   const std::vector<size_t>& const_values);
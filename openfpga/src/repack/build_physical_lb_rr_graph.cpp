@@ -401,6 +401,9 @@ static LbRRGraph build_lb_type_physical_lb_rr_graph(
 
   VTR_LOGV(verbose, "\tNumber of edges: %lu\n", lb_rr_graph.edges().size());
 
+  /* Group edges by modes in a compact storage, which is walked by router */
+  lb_rr_graph.build_edge_spans();
+
   return lb_rr_graph;
 }
 
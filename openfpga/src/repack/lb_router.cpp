@@ -760,7 +760,8 @@ void LbRouter::expand_edges(const LbRRGraph& lb_rr_graph, t_mode* mode,
   int usage;
   float incr_cost;
 
-  for (const LbRREdgeId& iedge : lb_rr_graph.node_out_edges(cur_inode, mode)) {
+  for (const LbRREdgeId& iedge :
+       lb_rr_graph.node_out_edge_span(cur_inode, mode)) {
     /* Init new expansion node */
     enode.prev_index = cur_inode;
     enode.node_index = lb_rr_graph.edge_sink_node(iedge);
@@ -797,7 +798,8 @@ void LbRouter::expand_edges(const LbRRGraph& lb_rr_graph, t_mode* mode,
                         ->parent_node->pb_type->modes[0]);
       }
     }
-    if (lb_rr_graph.node_out_edges(enode.node_index, next_mode).size() > 1) {
+    if (lb_rr_graph.node_out_edge_span(enode.node_index, next_mode).size() >
+        1) {
       fanout_factor = 0.85 + (0.25 / net_fanout);
     } else {
       fanout_factor = 1.15 - (0.25 / net_fanout);
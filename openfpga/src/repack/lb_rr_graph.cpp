@@ -4,6 +4,8 @@
  ***********************************************************************/
 #include "lb_rr_graph.h"
 
+#include <algorithm>
+
 #include "vtr_assert.h"
 #include "vtr_log.h"
 
@@ -16,6 +18,7 @@ namespace openfpga {
 LbRRGraph::LbRRGraph() {
   ext_source_node_ = LbRRNodeId::INVALID();
   ext_sink_node_ = LbRRNodeId::INVALID();
+  edge_spans_built_ = false;
 }
 
 /**************************************************
@@ -62,6 +65,10 @@ std::vector<LbRREdgeId> LbRRGraph::node_in_edges(const LbRRNodeId& node,
   std::vector<LbRREdgeId> in_edges;
 
   VTR_ASSERT(true == valid_node_id(node));
+  if (true == edge_spans_built_) {
+    edge_span span = node_in_edge_span(node, mode);
+    return std::vector<LbRREdgeId>(span.begin(), span.end());
+  }
   for (const LbRREdgeId& edge : node_in_edges_[node]) {
     if (mode == edge_mode(edge)) {
       in_edges.push_back(edge);
@@ -82,6 +89,10 @@ std::vector<LbRREdgeId> LbRRGraph::node_out_edges(const LbRRNodeId& node,
   std::vector<LbRREdgeId> out_edges;
 
   VTR_ASSERT(true == valid_node_id(node));
+  if (true == edge_spans_built_) {
+    edge_span span = node_out_edge_span(node, mode);
+    return std::vector<LbRREdgeId>(span.begin(), span.end());
+  }
   for (const LbRREdgeId& edge : node_out_edges_[node]) {
     if (mode == edge_mode(edge)) {
       out_edges.push_back(edge);
@@ -91,6 +102,40 @@ std::vector<LbRREdgeId> LbRRGraph::node_out_edges(const LbRRNodeId& node,
   return out_edges;
 }
 
+LbRRGraph::edge_span LbRRGraph::node_in_edge_span(const LbRRNodeId& node,
+                                                  t_mode* mode) const {
+  return find_edge_span(span_in_edges_, in_edge_mode_spans_,
+                        node_in_span_offsets_, node, mode);
+}
+
+LbRRGraph::edge_span LbRRGraph::node_out_edge_span(const LbRRNodeId& node,
+                                                   t_mode* mode) const {
+  return find_edge_span(span_out_edges_, out_edge_mode_spans_,
+                        node_out_span_offsets_, node, mode);
+}
+
+bool LbRRGraph::edge_spans_built() const { return edge_spans_built_; }
+
+/* Find the group of edges under a given mode for a node in the compact edge
+ * storage. An empty span is returned if the node has no edge in the mode.
+ * A node has only a few modes, so a linear search is fast enough */
+LbRRGraph::edge_span LbRRGraph::find_edge_span(
+  const std::vector<LbRREdgeId>& span_edges,
+  const std::vector<t_edge_mode_span>& mode_spans,
+  const std::vector<size_t>& node_span_offsets, const LbRRNodeId& node,
+  t_mode* mode) const {
+  VTR_ASSERT(true == edge_spans_built_);
+  VTR_ASSERT_SAFE(true == valid_node_id(node));
+  for (size_t ispan = node_span_offsets[size_t(node)];
+       ispan < node_span_offsets[size_t(node) + 1]; ++ispan) {
+    if (mode == mode_spans[ispan].mode) {
+      return vtr::make_range(span_edges.begin() + mode_spans[ispan].begin,
+                             span_edges.begin() + mode_spans[ispan].end);
+    }
+  }
+  return vtr::make_range(span_edges.end(), span_edges.end());
+}
+
 LbRRNodeId LbRRGraph::find_node(const e_lb_rr_type& type,
                                 const t_pb_graph_pin* pb_graph_pin) const {
   if (size_t(type) >= node_lookup_.size()) {
@@ -139,6 +184,29 @@ t_mode* LbRRGraph::edge_mode(const LbRREdgeId& edge) const {
   return edge_modes_[edge];
 }
 
+void LbRRGraph::memory_usage(MemoryUsage& usage) const {
+  usage.add_container(node_ids_);
+  usage.add_container(node_types_);
+  usage.add_container(node_capacities_);
+  usage.add_container(node_pb_graph_pins_);
+  usage.add_container(node_intrinsic_costs_);
+  usage.add_container(node_in_edges_);
+  usage.add_container(node_out_edges_);
+  usage.add_container(edge_ids_);
+  usage.add_container(edge_src_nodes_);
+  usage.add_container(edge_sink_nodes_);
+  usage.add_container(edge_intrinsic_costs_);
+  usage.add_container(edge_modes_);
+  usage.add_container(span_in_edges_);
+  usage.add_container(in_edge_mode_spans_);
+  usage.add_container(node_in_span_offsets_);
+  usage.add_container(span_out_edges_);
+  usage.add_container(out_edge_mode_spans_);
+  usage.add_container(node_out_span_offsets_);
+
+  usage.add_lookup(node_lookup_);
+}
+
 /******************************************************************************
  * Public Mutators
  ******************************************************************************/
@@ -249,6 +317,9 @@ LbRREdgeId LbRRGraph::create_edge(const LbRRNodeId& source,
   node_out_edges_[source].push_back(edge);
   node_in_edges_[sink].push_back(edge);
 
+  /* Edge spans are outdated */
+  edge_spans_built_ = false;
+
   return edge;
 }
 
@@ -258,6 +329,58 @@ void LbRRGraph::set_edge_intrinsic_cost(const LbRREdgeId& edge,
   edge_intrinsic_costs_[edge] = cost;
 }
 
+void LbRRGraph::build_edge_spans() {
+  flatten_node_edges(node_in_edges_, span_in_edges_, in_edge_mode_spans_,
+                     node_in_span_offsets_);
+  flatten_node_edges(node_out_edges_, span_out_edges_, out_edge_mode_spans_,
+                     node_out_span_offsets_);
+  edge_spans_built_ = true;
+}
+
+/* Flatten the per-node edge lists into the compact edge storage.
+ * The edges of a node are grouped by modes, in the order that each mode first
+ * appears, while the original order of edges is kept inside each group.
+ * This ensures the edge spans give the same edges in the same order as
+ * node_in_edges()/node_out_edges() with a mode */
+void LbRRGraph::flatten_node_edges(
+  const vtr::vector<LbRRNodeId, std::vector<LbRREdgeId>>& node_edges,
+  std::vector<LbRREdgeId>& span_edges,
+  std::vector<t_edge_mode_span>& mode_spans,
+  std::vector<size_t>& node_span_offsets) const {
+  span_edges.clear();
+  span_edges.reserve(edge_ids_.size());
+  mode_spans.clear();
+  node_span_offsets.clear();
+  node_span_offsets.reserve(node_ids_.size() + 1);
+
+  std::vector<t_mode*> node_modes;
+  for (const LbRRNodeId& node : nodes()) {
+    node_span_offsets.push_back(mode_spans.size());
+
+    node_modes.clear();
+    for (const LbRREdgeId& edge : node_edges[node]) {
+      if (node_modes.end() ==
+          std::find(node_modes.begin(), node_modes.end(), edge_modes_[edge])) {
+        node_modes.push_back(edge_modes_[edge]);
+      }
+    }
+
+    for (t_mode* mode : node_modes) {
+      t_edge_mode_span mode_span;
+      mode_span.mode = mode;
+      mode_span.begin = span_edges.size();
+      for (const LbRREdgeId& edge : node_edges[node]) {
+        if (mode == edge_modes_[edge]) {
+          span_edges.push_back(edge);
+        }
+      }
+      mode_span.end = span_edges.size();
+      mode_spans.push_back(mode_span);
+    }
+  }
+  node_span_offsets.push_back(mode_spans.size());
+}
+
 /******************************************************************************
  * Public validators/invalidators
  ******************************************************************************/
@@ -159,6 +159,9 @@
 /* Header from readarch library */
 #include "physical_types.h"
 
+/* Header from openfpgautil library */
+#include "openfpga_memory_usage.h"
+
 /* Header from vpr library */
 #include "lb_rr_graph_fwd.h"
 #include "pack_types.h"
@@ -177,6 +180,10 @@ class LbRRGraph {
   typedef vtr::Range<node_iterator> node_range;
   typedef vtr::Range<edge_iterator> edge_range;
 
+  /* Range of edges in the compact edge storage, see build_edge_spans() */
+  typedef std::vector<LbRREdgeId>::const_iterator edge_span_iterator;
+  typedef vtr::Range<edge_span_iterator> edge_span;
+
  public: /* Constructors */
   LbRRGraph();
 
@@ -216,6 +223,20 @@ class LbRRGraph {
   std::vector<LbRREdgeId> node_out_edges(const LbRRNodeId& node,
                                          t_mode* mode) const;
 
+  /* Get the incoming/outgoing edges of a node under a mode, without copying
+   * the edge list. This is the preferred way for routers to walk the graph
+   * Note that the edge spans must be built by build_edge_spans() in advance
+   *  -----------------------------------------------------------------
+   *    Example:
+   *      for (const LbRREdgeId& edge : lb_rr_graph.node_out_edge_span(node,
+   *                                                                mode)) {
+   *        // Do something with each edge
+   *      }
+   */
+  edge_span node_in_edge_span(const LbRRNodeId& node, t_mode* mode) const;
+  edge_span node_out_edge_span(const LbRRNodeId& node, t_mode* mode) const;
+  bool edge_spans_built() const;
+
   /* General method to look up a node with type and only pb_graph_pin
    * information */
   LbRRNodeId find_node(const e_lb_rr_type& type,
@@ -235,6 +256,8 @@ class LbRRGraph {
   float edge_intrinsic_cost(const LbRREdgeId& edge) const;
   t_mode* edge_mode(const LbRREdgeId& edge) const;
 
+  void memory_usage(MemoryUsage& usage) const;
+
  public: /* Mutators */
   /* Reserve the lists of nodes, edges, switches etc. to be memory efficient.
    * This function is mainly used to reserve memory space inside RRGraph,
@@ -281,6 +304,11 @@ class LbRRGraph {
                          t_mode* mode);
   void set_edge_intrinsic_cost(const LbRREdgeId& edge, const float& cost);
 
+  /* Build the compact storage of edges, where the incoming/outgoing edges of
+   * each node are grouped by modes. This should be called once the graph is
+   * completely built. Any edge creation afterwards invalidates the storage */
+  void build_edge_spans();
+
  public: /* Public validators */
   /* Validate is the node id does exist in the RRGraph */
   bool valid_node_id(const LbRRNodeId& node) const;
@@ -306,6 +334,25 @@ class LbRRGraph {
   bool validate_nodes_out_edges() const;
   bool validate_nodes_edges() const;
 
+ private: /* Internal types */
+  /* A group of edges under the same mode in the compact edge storage */
+  struct t_edge_mode_span {
+    t_mode* mode;
+    size_t begin;
+    size_t end;
+  };
+
+ private: /* Internal functions */
+  void flatten_node_edges(
+    const vtr::vector<LbRRNodeId, std::vector<LbRREdgeId>>& node_edges,
+    std::vector<LbRREdgeId>& span_edges,
+    std::vector<t_edge_mode_span>& mode_spans,
+    std::vector<size_t>& node_span_offsets) const;
+  edge_span find_edge_span(const std::vector<LbRREdgeId>& span_edges,
+                           const std::vector<t_edge_mode_span>& mode_spans,
+                           const std::vector<size_t>& node_span_offsets,
+                           const LbRRNodeId& node, t_mode* mode) const;
+
  private: /* Internal Data */
   /* Node related data */
   vtr::vector<LbRRNodeId, LbRRNodeId> node_ids_;
@@ -332,6 +379,23 @@ class LbRRGraph {
   vtr::vector<LbRREdgeId, float> edge_intrinsic_costs_;
   vtr::vector<LbRREdgeId, t_mode*> edge_modes_;
 
+  /* Compact (CSR) storage of edges, built by build_edge_spans()
+   * The edges of all the nodes are stored in a flat array, where the edges of
+   * a node are grouped by modes:
+   *   [<node0 mode0 edges><node0 mode1 edges>][<node1 mode0 edges>]...
+   * The mode groups of node i are
+   *   out_edge_mode_spans_[node_out_span_offsets_[i]] ...
+   *   out_edge_mode_spans_[node_out_span_offsets_[i + 1] - 1]
+   * so that routers can get the edges of a (node, mode) pair as a span
+   */
+  std::vector<LbRREdgeId> span_in_edges_;
+  std::vector<t_edge_mode_span> in_edge_mode_spans_;
+  std::vector<size_t> node_in_span_offsets_;
+  std::vector<LbRREdgeId> span_out_edges_;
+  std::vector<t_edge_mode_span> out_edge_mode_spans_;
+  std::vector<size_t> node_out_span_offsets_;
+  bool edge_spans_built_;
+
   /* Fast look-up to search a node by its type, coordinator and ptc_num
    * Indexing of fast look-up: [0..NUM_TYPES-1][t_pb_graph_pin*]
    */
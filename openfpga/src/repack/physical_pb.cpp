@@ -9,6 +9,30 @@
 /* begin namespace openfpga */
 namespace openfpga {
 
+/* Index of a pin which does not belong to the pb_graph_node of a pb */
+constexpr size_t INVALID_PIN_INDEX = size_t(-1);
+
+/**************************************************
+ * Count the number of pins of a pb_graph_node,
+ * which is the size of pin-level data of a pb
+ *************************************************/
+static size_t pb_graph_node_num_pins(const t_pb_graph_node* pb_graph_node) {
+  size_t num_pins = 0;
+  if (nullptr == pb_graph_node) {
+    return num_pins;
+  }
+  for (int iport = 0; iport < pb_graph_node->num_input_ports; ++iport) {
+    num_pins += pb_graph_node->num_input_pins[iport];
+  }
+  for (int iport = 0; iport < pb_graph_node->num_output_ports; ++iport) {
+    num_pins += pb_graph_node->num_output_pins[iport];
+  }
+  for (int iport = 0; iport < pb_graph_node->num_clock_ports; ++iport) {
+    num_pins += pb_graph_node->num_clock_pins[iport];
+  }
+  return num_pins;
+}
+
 /**************************************************
  * Public Accessors
  *************************************************/
@@ -39,9 +63,10 @@ const t_pb_graph_node* PhysicalPb::pb_graph_node(const PhysicalPbId& pb) const {
 
 /* Find the module id by a given name, return invalid if not found */
 PhysicalPbId PhysicalPb::find_pb(const t_pb_graph_node* pb_graph_node) const {
-  if (type2id_map_.find(pb_graph_node) != type2id_map_.end()) {
+  size_t index = type2id_map_.find(pb_graph_node);
+  if (PointerIndexTable<t_pb_graph_node>::INVALID_INDEX != index) {
     /* Find it, return the id */
-    return type2id_map_.at(pb_graph_node);
+    return PhysicalPbId(index);
   }
   /* Not found, return an invalid id */
   return PhysicalPbId::INVALID();
@@ -72,9 +97,10 @@ std::vector<AtomBlockId> PhysicalPb::atom_blocks(const PhysicalPbId& pb) const {
 AtomNetId PhysicalPb::pb_graph_pin_atom_net(
   const PhysicalPbId& pb, const t_pb_graph_pin* pb_graph_pin) const {
   VTR_ASSERT(true == valid_pb_id(pb));
-  if (pin_atom_nets_[pb].find(pb_graph_pin) != pin_atom_nets_[pb].end()) {
+  size_t pin = pin_index(pb, pb_graph_pin);
+  if (INVALID_PIN_INDEX != pin) {
     /* Find it, return the id */
-    return pin_atom_nets_[pb].at(pb_graph_pin);
+    return pin_atom_nets_[pb][pin];
   }
   /* Not found, return an invalid id */
   return AtomNetId::INVALID();
@@ -83,15 +109,16 @@ AtomNetId PhysicalPb::pb_graph_pin_atom_net(
 bool PhysicalPb::is_wire_lut_output(const PhysicalPbId& pb,
                                     const t_pb_graph_pin* pb_graph_pin) const {
   VTR_ASSERT(true == valid_pb_id(pb));
-  if (wire_lut_outputs_[pb].find(pb_graph_pin) != wire_lut_outputs_[pb].end()) {
+  size_t pin = pin_index(pb, pb_graph_pin);
+  if (INVALID_PIN_INDEX != pin) {
     /* Find it, return the status */
-    return wire_lut_outputs_[pb].at(pb_graph_pin);
+    return wire_lut_outputs_[pb][pin];
   }
   /* Not found, return false */
   return false;
 }
 
-std::map<const t_pb_graph_pin*, AtomNetlist::TruthTable>
+const std::map<const t_pb_graph_pin*, AtomNetlist::TruthTable>&
 PhysicalPb::truth_tables(const PhysicalPbId& pb) const {
   VTR_ASSERT(true == valid_pb_id(pb));
   return truth_tables_[pb];
@@ -124,15 +151,32 @@ size_t PhysicalPb::fixed_mode_select_bitstream_offset(
   return fixed_mode_select_bitstream_offsets_[pb];
 }
 
+void PhysicalPb::memory_usage(MemoryUsage& usage) const {
+  usage.add_container(pb_ids_);
+  usage.add_container(pb_graph_nodes_);
+  usage.add_container(names_);
+  usage.add_container(atom_blocks_);
+  usage.add_container(pin_atom_nets_);
+  usage.add_container(wire_lut_outputs_);
+  usage.add_container(child_pbs_);
+  usage.add_container(parent_pbs_);
+  usage.add_container(truth_tables_);
+  usage.add_container(mode_bits_);
+  usage.add_container(fixed_bitstreams_);
+  usage.add_container(fixed_bitstream_offsets_);
+  usage.add_container(fixed_mode_select_bitstreams_);
+  usage.add_container(fixed_mode_select_bitstream_offsets_);
+  type2id_map_.memory_usage(usage);
+}
+
 /******************************************************************************
  * Private Mutators
  ******************************************************************************/
 PhysicalPbId PhysicalPb::create_pb(const t_pb_graph_node* pb_graph_node) {
   /* Find if the name has been used. If used, return an invalid Id and report
    * error! */
-  std::map<const t_pb_graph_node*, PhysicalPbId>::iterator it =
-    type2id_map_.find(pb_graph_node);
-  if (it != type2id_map_.end()) {
+  if (PointerIndexTable<t_pb_graph_node>::INVALID_INDEX !=
+      type2id_map_.find(pb_graph_node)) {
     return PhysicalPbId::INVALID();
   }
 
@@ -144,8 +188,9 @@ PhysicalPbId PhysicalPb::create_pb(const t_pb_graph_node* pb_graph_node) {
   names_.emplace_back();
   pb_graph_nodes_.push_back(pb_graph_node);
   atom_blocks_.emplace_back();
-  pin_atom_nets_.emplace_back();
-  wire_lut_outputs_.emplace_back();
+  size_t num_pins = pb_graph_node_num_pins(pb_graph_node);
+  pin_atom_nets_.emplace_back(num_pins, AtomNetId::INVALID());
+  wire_lut_outputs_.emplace_back(num_pins, false);
 
   child_pbs_.emplace_back();
   parent_pbs_.push_back(PhysicalPbId::INVALID());
@@ -159,7 +204,8 @@ PhysicalPbId PhysicalPb::create_pb(const t_pb_graph_node* pb_graph_node) {
   fixed_mode_select_bitstream_offsets_.push_back(0);
 
   /* Register in the name2id map */
-  type2id_map_[pb_graph_node] = pb;
+  size_t index = type2id_map_.insert(pb_graph_node);
+  VTR_ASSERT(size_t(pb) == index);
 
   return pb;
 }
@@ -214,25 +260,29 @@ void PhysicalPb::set_pb_graph_pin_atom_net(const PhysicalPbId& pb,
                                            const t_pb_graph_pin* pb_graph_pin,
                                            const AtomNetId& atom_net) {
   VTR_ASSERT(true == valid_pb_id(pb));
-  if (pin_atom_nets_[pb].end() != pin_atom_nets_[pb].find(pb_graph_pin)) {
+  size_t pin = pin_index(pb, pb_graph_pin);
+  VTR_ASSERT(INVALID_PIN_INDEX != pin);
+  if (AtomNetId::INVALID() != pin_atom_nets_[pb][pin]) {
     VTR_LOG_WARN("Overwrite pb_graph_pin '%s[%d]' atom net '%lu' with '%lu'\n",
                  pb_graph_pin->port->name, pb_graph_pin->pin_number,
-                 size_t(pin_atom_nets_[pb][pb_graph_pin]), size_t(atom_net));
+                 size_t(pin_atom_nets_[pb][pin]), size_t(atom_net));
   }
 
-  pin_atom_nets_[pb][pb_graph_pin] = atom_net;
+  pin_atom_nets_[pb][pin] = atom_net;
 }
 
 void PhysicalPb::set_wire_lut_output(const PhysicalPbId& pb,
                                      const t_pb_graph_pin* pb_graph_pin,
                                      const bool& wire_lut_output) {
   VTR_ASSERT(true == valid_pb_id(pb));
-  if (wire_lut_outputs_[pb].end() != wire_lut_outputs_[pb].find(pb_graph_pin)) {
+  size_t pin = pin_index(pb, pb_graph_pin);
+  VTR_ASSERT(INVALID_PIN_INDEX != pin);
+  if (true == wire_lut_outputs_[pb][pin]) {
     VTR_LOG_WARN("Overwrite pb_graph_pin '%s[%d]' status on wire LUT output\n",
                  pb_graph_pin->port->name, pb_graph_pin->pin_number);
   }
 
-  wire_lut_outputs_[pb][pb_graph_pin] = wire_lut_output;
+  wire_lut_outputs_[pb][pin] = wire_lut_output;
 }
 
 void PhysicalPb::set_fixed_bitstream(const PhysicalPbId& pb,
@@ -259,6 +309,49 @@ void PhysicalPb::set_fixed_mode_select_bitstream_offset(const PhysicalPbId& pb,
   fixed_mode_select_bitstream_offsets_[pb] = offset;
 }
 
+/******************************************************************************
+ * Private functions
+ ******************************************************************************/
+/* Find the index of a pb_graph_pin in the pin-level data of a pb.
+ * The pins are indexed in the order of
+ *   [<input pins>][<output pins>][<clock pins>]
+ * where the pins of each type are ordered by ports and then pin numbers.
+ * Return an invalid index if the pin does not belong to the pb
+ */
+size_t PhysicalPb::pin_index(const PhysicalPbId& pb,
+                             const t_pb_graph_pin* pb_graph_pin) const {
+  const t_pb_graph_node* pb_graph_node = pb_graph_nodes_[pb];
+  if ((nullptr == pb_graph_node) || (nullptr == pb_graph_pin) ||
+      (pb_graph_node != pb_graph_pin->parent_node)) {
+    return INVALID_PIN_INDEX;
+  }
+
+  int ipin = pb_graph_pin->pin_number;
+  size_t offset = 0;
+  for (int iport = 0; iport < pb_graph_node->num_input_ports; ++iport) {
+    if ((ipin < pb_graph_node->num_input_pins[iport]) &&
+        (pb_graph_pin == &(pb_graph_node->input_pins[iport][ipin]))) {
+      return offset + ipin;
+    }
+    offset += pb_graph_node->num_input_pins[iport];
+  }
+  for (int iport = 0; iport < pb_graph_node->num_output_ports; ++iport) {
+    if ((ipin < pb_graph_node->num_output_pins[iport]) &&
+        (pb_graph_pin == &(pb_graph_node->output_pins[iport][ipin]))) {
+      return offset + ipin;
+    }
+    offset += pb_graph_node->num_output_pins[iport];
+  }
+  for (int iport = 0; iport < pb_graph_node->num_clock_ports; ++iport) {
+    if ((ipin < pb_graph_node->num_clock_pins[iport]) &&
+        (pb_graph_pin == &(pb_graph_node->clock_pins[iport][ipin]))) {
+      return offset + ipin;
+    }
+    offset += pb_graph_node->num_clock_pins[iport];
+  }
+  return INVALID_PIN_INDEX;
+}
+
 /******************************************************************************
  * Private validators/invalidators
  ******************************************************************************/
@@ -14,6 +14,8 @@
 /* Headers from vpr library */
 #include "atom_netlist.h"
 #include "physical_pb_fwd.h"
+#include "openfpga_memory_usage.h"
+#include "pointer_index_table.h"
 
 /* Begin namespace openfpga */
 namespace openfpga {
@@ -52,13 +54,14 @@ class PhysicalPb {
                                   const t_pb_graph_pin* pb_graph_pin) const;
   bool is_wire_lut_output(const PhysicalPbId& pb,
                           const t_pb_graph_pin* pb_graph_pin) const;
-  std::map<const t_pb_graph_pin*, AtomNetlist::TruthTable> truth_tables(
-    const PhysicalPbId& pb) const;
+  const std::map<const t_pb_graph_pin*, AtomNetlist::TruthTable>&
+  truth_tables(const PhysicalPbId& pb) const;
   std::vector<size_t> mode_bits(const PhysicalPbId& pb) const;
   std::string fixed_bitstream(const PhysicalPbId& pb) const;
   size_t fixed_bitstream_offset(const PhysicalPbId& pb) const;
   std::string fixed_mode_select_bitstream(const PhysicalPbId& pb) const;
   size_t fixed_mode_select_bitstream_offset(const PhysicalPbId& pb) const;
+  void memory_usage(MemoryUsage& usage) const;
 
  public: /* Public mutators */
   PhysicalPbId create_pb(const t_pb_graph_node* pb_graph_node);
@@ -88,15 +91,20 @@ class PhysicalPb {
   bool valid_pb_id(const PhysicalPbId& pb_id) const;
   bool empty() const;
 
+ private: /* Internal functions */
+  size_t pin_index(const PhysicalPbId& pb,
+                   const t_pb_graph_pin* pb_graph_pin) const;
+
  private: /* Internal Data */
   vtr::vector<PhysicalPbId, PhysicalPbId> pb_ids_;
   vtr::vector<PhysicalPbId, const t_pb_graph_node*> pb_graph_nodes_;
   vtr::vector<PhysicalPbId, std::string> names_;
   vtr::vector<PhysicalPbId, std::vector<AtomBlockId>> atom_blocks_;
-  vtr::vector<PhysicalPbId, std::map<const t_pb_graph_pin*, AtomNetId>>
-    pin_atom_nets_;
-  vtr::vector<PhysicalPbId, std::map<const t_pb_graph_pin*, bool>>
-    wire_lut_outputs_;
+  /* Pin-level data are stored in dense arrays, which are allocated for all
+   * the pins of the pb_graph_node when a pb is created. The pins are indexed
+   * as [<input pins>][<output pins>][<clock pins>], see pin_index() */
+  vtr::vector<PhysicalPbId, std::vector<AtomNetId>> pin_atom_nets_;
+  vtr::vector<PhysicalPbId, std::vector<bool>> wire_lut_outputs_;
 
   /* Child pbs are organized as
    * [0..num_child_pb_types-1][0..child_pb_type->num_pb-1] */
@@ -120,8 +128,9 @@ class PhysicalPb {
   vtr::vector<PhysicalPbId, std::string> fixed_mode_select_bitstreams_;
   vtr::vector<PhysicalPbId, size_t> fixed_mode_select_bitstream_offsets_;
 
-  /* Fast lookup */
-  std::map<const t_pb_graph_node*, PhysicalPbId> type2id_map_;
+  /* Fast lookup: pbs are created in the same order as they are added to the
+   * table, so the index of a pb_graph_node is the id of its pb */
+  PointerIndexTable<t_pb_graph_node> type2id_map_;
 };
 
 } /* End namespace openfpga*/
@@ -11,6 +11,7 @@
 #include "build_physical_lb_rr_graph.h"
 #include "lb_router.h"
 #include "lb_router_utils.h"
+#include "openfpga_trace.h"
 #include "pb_graph_utils.h"
 #include "pb_type_utils.h"
 #include "physical_pb_utils.h"
@@ -955,6 +956,8 @@ static void repack_cluster(const AtomContext& atom_ctx,
                            const VprBitstreamAnnotation& bitstream_annotation,
                            const ClusterBlockId& block_id,
                            const RepackOption& options) {
+  OPENFPGA_TRACE_SCOPE_DETAIL("repack_cluster",
+                              clustering_ctx.clb_nlist.block_name(block_id));
   /* Get the pb graph that current clustered block is mapped to */
   t_logical_block_type_ptr lb_type =
     clustering_ctx.clb_nlist.block_type(block_id);
@@ -20,6 +20,35 @@
 /* begin namespace openfpga */
 namespace openfpga {
 
+/********************************************************************
+ * Check if the values recorded in a fabric bitstream are the same as the
+ * architecture bitstream database. The recorded values are used by fast
+ * configuration and the compact memory bank data, while the other writers
+ * read the values from the database. They diverge when the database is
+ * rebuilt or patched (e.g., by apply_fabric_bitstream_diff) without
+ * building the fabric bitstream again.
+ * Return false and report an error if they are not in sync.
+ *******************************************************************/
+bool check_fabric_bitstream_in_sync(const BitstreamManager& bitstream_manager,
+                                    const FabricBitstream& fabric_bitstream) {
+  bool in_sync = fabric_bitstream.num_bits() == bitstream_manager.num_bits();
+  for (const FabricBitId& fabric_bit : fabric_bitstream.bits()) {
+    if (!in_sync) {
+      break;
+    }
+    const ConfigBitId& config_bit = fabric_bitstream.config_bit(fabric_bit);
+    in_sync = bitstream_manager.valid_bit_id(config_bit) &&
+              bitstream_manager.bit_value(config_bit) ==
+                fabric_bitstream.bit_value(fabric_bit);
+  }
+  if (!in_sync) {
+    VTR_LOG_ERROR(
+      "Fabric bitstream is out of date with the architecture bitstream "
+      "database! Please run build_fabric_bitstream again.\n");
+  }
+  return in_sync;
+}
+
 /********************************************************************
  * Find the longest bitstream size of a fabric bitstream
  * Only care the region in whitelist. If the whitelist is empty, consider all
@@ -55,12 +84,17 @@ size_t find_fabric_regional_bitstream_max_size(
  * Find the longest bitstream size of a fabric bitstream
  *******************************************************************/
 size_t find_configuration_chain_fabric_bitstream_size_to_be_skipped(
-  const FabricBitstream& fabric_bitstream,
-  const BitstreamManager& bitstream_manager, const bool& bit_value_to_skip,
+  const FabricBitstream& fabric_bitstream, const bool& bit_value_to_skip,
   const std::vector<size_t>& region_whitelist) {
   size_t regional_bitstream_max_size =
     find_fabric_regional_bitstream_max_size(fabric_bitstream, region_whitelist);
 
+  /* The leading runs of each region are cached in the fabric bitstream */
+  const FabricBitstreamSkipInfo& skip_info = fabric_bitstream.skip_info();
+  const std::vector<size_t>& region_leading_bits =
+    bit_value_to_skip ? skip_info.region_leading_ones
+                      : skip_info.region_leading_zeros;
+
   size_t num_bits_to_skip = size_t(-1);
   for (const auto& region : fabric_bitstream.regions()) {
     if (!region_whitelist.empty() &&
@@ -68,14 +102,7 @@ size_t find_configuration_chain_fabric_bitstream_size_to_be_skipped(
                    size_t(region)) == region_whitelist.end())) {
       continue;
     }
-    size_t curr_region_num_bits_to_skip = 0;
-    for (const FabricBitId& bit_id : fabric_bitstream.region_bits(region)) {
-      if (bit_value_to_skip !=
-          bitstream_manager.bit_value(fabric_bitstream.config_bit(bit_id))) {
-        break;
-      }
-      curr_region_num_bits_to_skip++;
-    }
+    size_t curr_region_num_bits_to_skip = region_leading_bits[size_t(region)];
     /* For regional bitstream which is short than the longest region bitstream,
      * The number of bits to skip
      */
@@ -24,13 +24,15 @@
 /* begin namespace openfpga */
 namespace openfpga {
 
+bool check_fabric_bitstream_in_sync(const BitstreamManager& bitstream_manager,
+                                    const FabricBitstream& fabric_bitstream);
+
 size_t find_fabric_regional_bitstream_max_size(
   const FabricBitstream& fabric_bitstream,
   const std::vector<size_t>& region_whitelist = std::vector<size_t>{});
 
 size_t find_configuration_chain_fabric_bitstream_size_to_be_skipped(
-  const FabricBitstream& fabric_bitstream,
-  const BitstreamManager& bitstream_manager, const bool& bit_value_to_skip,
+  const FabricBitstream& fabric_bitstream, const bool& bit_value_to_skip,
   const std::vector<size_t>& region_whitelist = std::vector<size_t>{});
 
 /* Alias to a specific organization of bitstreams for frame-based configuration
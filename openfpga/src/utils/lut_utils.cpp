@@ -436,6 +436,45 @@ static std::vector<bool> build_single_output_lut_bitstream(
   return lut_bitstream;
 }
 
+/********************************************************************
+ * Find the configuration bits of a fracturable LUT which implement the
+ * function of an output pin, depending on the fracturable level and the
+ * output mask of the corresponding circuit model output port
+ *******************************************************************/
+LutOutputBitRange find_frac_lut_output_bit_range(
+  const CircuitLibrary& circuit_lib, const MuxGraph& lut_mux_graph,
+  const VprDeviceAnnotation& device_annotation, const t_port* lut_output_port,
+  const size_t& pin) {
+  /* Find the corresponding circuit model output port and assoicated
+   * lut_output_mask */
+  CircuitPortId lut_model_output_port =
+    device_annotation.pb_circuit_port(lut_output_port);
+  size_t lut_frac_level =
+    circuit_lib.port_lut_frac_level(lut_model_output_port);
+  /* By default, lut_frac_level will be the lut_size, i.e., number of levels
+   * of the mux graph */
+  if (size_t(-1) == lut_frac_level) {
+    lut_frac_level = lut_mux_graph.num_levels();
+  }
+
+  /* Find the corresponding circuit model output port and assoicated
+   * lut_output_mask */
+  size_t lut_output_mask =
+    circuit_lib.port_lut_output_mask(lut_model_output_port)[pin];
+
+  /* Depending on the frac-level, we get the location(starting/end points) of
+   * sram bits */
+  LutOutputBitRange bit_range;
+  bit_range.length = (size_t)pow(2., (double)(lut_frac_level));
+  bit_range.offset = bit_range.length * lut_output_mask;
+  /* Ensure the offset is in range */
+  VTR_ASSERT(bit_range.offset < lut_mux_graph.num_inputs());
+  VTR_ASSERT(bit_range.offset + bit_range.length <=
+             lut_mux_graph.num_inputs());
+
+  return bit_range;
+}
+
 /********************************************************************
  * Generate bitstream for a fracturable LUT (also applicable to single-output
  *LUT) Check type of truth table of each mapped logical block if it is on-set,
@@ -451,67 +490,51 @@ std::vector<bool> build_frac_lut_bitstream(
   std::vector<bool> lut_bitstream(lut_mux_graph.num_inputs(),
                                   default_sram_bit_value);
 
-  for (std::pair<const t_pb_graph_pin*, AtomNetlist::TruthTable> element :
-       truth_tables) {
-    /* Find the corresponding circuit model output port and assoicated
-     * lut_output_mask */
-    CircuitPortId lut_model_output_port =
-      device_annotation.pb_circuit_port(element.first->port);
-    size_t lut_frac_level =
-      circuit_lib.port_lut_frac_level(lut_model_output_port);
-    /* By default, lut_frac_level will be the lut_size, i.e., number of levels
-     * of the mux graph */
-    if (size_t(-1) == lut_frac_level) {
-      lut_frac_level = lut_mux_graph.num_levels();
-    }
-
-    /* Find the corresponding circuit model output port and assoicated
-     * lut_output_mask */
-    size_t lut_output_mask = circuit_lib.port_lut_output_mask(
-      lut_model_output_port)[element.first->pin_number];
+  for (const auto& element : truth_tables) {
+    LutOutputBitRange bit_range = find_frac_lut_output_bit_range(
+      circuit_lib, lut_mux_graph, device_annotation, element.first->port,
+      element.first->pin_number);
 
     /* Decode lut sram bits */
     std::vector<bool> temp_bitstream = build_single_output_lut_bitstream(
       element.second, lut_mux_graph, default_sram_bit_value);
 
-    /* Depending on the frac-level, we get the location(starting/end points) of
-     * sram bits */
-    size_t length_of_temp_bitstream_to_copy =
-      (size_t)pow(2., (double)(lut_frac_level));
-    size_t bitstream_offset =
-      length_of_temp_bitstream_to_copy * lut_output_mask;
-    /* Ensure the offset is in range */
-    VTR_ASSERT(bitstream_offset < lut_bitstream.size());
-    VTR_ASSERT(bitstream_offset + length_of_temp_bitstream_to_copy <=
-               lut_bitstream.size());
-
-    /* Print debug information
-    bool verbose = true;
-    VTR_LOGV(verbose, "Full truth table\n");
-    for (const std::string& tt_line : truth_table_to_string(element.second)) {
-      VTR_LOGV(verbose, "\t%s\n", tt_line.c_str());
+    /* Copy to the segment of bitstream */
+    for (size_t bit = bit_range.offset;
+         bit < bit_range.offset + bit_range.length; ++bit) {
+      lut_bitstream[bit] = temp_bitstream[bit];
     }
-    VTR_LOGV(verbose, "\n");
+  }
 
-    VTR_LOGV(verbose, "Bitstream (size = %ld)\n", temp_bitstream.size());
-    for (const bool& bit : temp_bitstream) {
-      if (true == bit) {
-        VTR_LOGV(verbose, "1");
-      } else {
-        VTR_ASSERT(false == bit);
-        VTR_LOGV(verbose, "0");
-      }
-    }
-    VTR_LOGV(verbose, "\n");
+  return lut_bitstream;
+}
 
-    VTR_LOGV(verbose, "Bitstream offset = %d\n", bitstream_offset);
-    VTR_LOGV(verbose, "Bitstream length to be used = %d\n",
-    length_of_temp_bitstream_to_copy);
-     */
+/********************************************************************
+ * Generate bitstream for a fracturable LUT, where the configuration bits
+ * of each output pin have been found, e.g., when building a bitstream
+ * template for the LUT. The bit ranges are indexed by [port][pin] of the
+ * pb_type of the LUT
+ *******************************************************************/
+std::vector<bool> build_frac_lut_bitstream(
+  const MuxGraph& lut_mux_graph,
+  const std::vector<std::vector<LutOutputBitRange>>& output_bit_ranges,
+  const std::map<const t_pb_graph_pin*, AtomNetlist::TruthTable>& truth_tables,
+  const size_t& default_sram_bit_value) {
+  /* Initialization */
+  std::vector<bool> lut_bitstream(lut_mux_graph.num_inputs(),
+                                  default_sram_bit_value);
+
+  for (const auto& element : truth_tables) {
+    const LutOutputBitRange& bit_range =
+      output_bit_ranges[element.first->port->index][element.first->pin_number];
+
+    /* Decode lut sram bits */
+    std::vector<bool> temp_bitstream = build_single_output_lut_bitstream(
+      element.second, lut_mux_graph, default_sram_bit_value);
 
     /* Copy to the segment of bitstream */
-    for (size_t bit = bitstream_offset;
-         bit < bitstream_offset + length_of_temp_bitstream_to_copy; ++bit) {
+    for (size_t bit = bit_range.offset;
+         bit < bit_range.offset + bit_range.length; ++bit) {
       lut_bitstream[bit] = temp_bitstream[bit];
     }
   }
@@ -36,12 +36,30 @@ AtomNetlist::TruthTable adapt_truth_table_for_frac_lut(
 
 bool lut_truth_table_use_on_set(const AtomNetlist::TruthTable& truth_table);
 
+/* The configuration bits [offset, offset + length) of a fracturable LUT which
+ * implement the function of an output pin */
+struct LutOutputBitRange {
+  size_t offset;
+  size_t length;
+};
+
+LutOutputBitRange find_frac_lut_output_bit_range(
+  const CircuitLibrary& circuit_lib, const MuxGraph& lut_mux_graph,
+  const VprDeviceAnnotation& device_annotation, const t_port* lut_output_port,
+  const size_t& pin);
+
 std::vector<bool> build_frac_lut_bitstream(
   const CircuitLibrary& circuit_lib, const MuxGraph& lut_mux_graph,
   const VprDeviceAnnotation& device_annotation,
   const std::map<const t_pb_graph_pin*, AtomNetlist::TruthTable>& truth_tables,
   const size_t& default_sram_bit_value);
 
+std::vector<bool> build_frac_lut_bitstream(
+  const MuxGraph& lut_mux_graph,
+  const std::vector<std::vector<LutOutputBitRange>>& output_bit_ranges,
+  const std::map<const t_pb_graph_pin*, AtomNetlist::TruthTable>& truth_tables,
+  const size_t& default_sram_bit_value);
+
 bool is_wired_lut(const std::vector<AtomNetId>& input_nets,
                   const AtomNetId& output_net);
 
@@ -103,14 +103,19 @@ size_t count_module_manager_module_configurable_children(
 
 /******************************************************************************
  * Find the module id and instance id in module manager with a given instance
- *name This function will exhaustively search all the child module under a given
- *parent module
+ *name This function will search all the child module under a given parent
+ *module through the fast look-up of instance names first, and then through
+ *the instance names of each child module
  ******************************************************************************/
 std::pair<ModuleId, size_t> find_module_manager_instance_module_info(
   const ModuleManager& module_manager, const ModuleId& parent,
   const std::string& instance_name) {
-  /* Deposit invalid values as default */
-  std::pair<ModuleId, size_t> instance_info(ModuleId::INVALID(), 0);
+  std::pair<ModuleId, size_t> instance_info =
+    module_manager.find_child_instance(parent, instance_name);
+  if (true == module_manager.valid_module_instance_id(
+                parent, instance_info.first, instance_info.second)) {
+    return instance_info;
+  }
 
   /* Search all the child module and see we have a match */
   for (const ModuleId& child : module_manager.child_modules(parent)) {
@@ -118,13 +123,12 @@ std::pair<ModuleId, size_t> find_module_manager_instance_module_info(
       module_manager.instance_id(parent, child, instance_name);
     if (true == module_manager.valid_module_instance_id(parent, child,
                                                         child_instance)) {
-      instance_info.first = child;
-      instance_info.second = child_instance;
-      return instance_info;
+      return std::pair<ModuleId, size_t>(child, child_instance);
     }
   }
 
-  return instance_info;
+  /* Deposit invalid values as default */
+  return std::pair<ModuleId, size_t>(ModuleId::INVALID(), 0);
 }
 
 /******************************************************************************
@@ -10,6 +10,8 @@
 
 #include "command_exit_codes.h"
 #include "globals.h"
+#include "net_delay.h"
+#include "read_circuit.h"
 #include "tatum/error.hpp"
 #include "vpr_api.h"
 #include "vpr_error.h"
@@ -23,6 +25,14 @@
 
 namespace vpr {
 
+/**
+ * Setup and architecture of the last run of 'vpr' which keeps its results.
+ * They are kept so that the results of another design can be loaded on the
+ * device built by the run, see vpr_load_results()
+ */
+static t_vpr_setup kept_vpr_setup;
+static t_arch* kept_arch = nullptr;
+
 /**
  * VPR program without clean up
  * VPR program
@@ -59,6 +69,8 @@ static int vpr(int argc, char** argv) {
       VTR_LOG("VPR failed to implement circuit\n");
       return UNIMPLEMENTABLE_EXIT_CODE;
     }
+    kept_vpr_setup = vpr_setup;
+    kept_arch = Arch;
 
     auto& timing_ctx = g_vpr_ctx.timing();
     print_timing_stats("Flow", timing_ctx.stats);
@@ -103,6 +115,81 @@ int vpr_wrapper(int argc, char** argv) {
   return openfpga::CMD_EXEC_SUCCESS;
 }
 
+/**
+ * Load the packing, placement and routing results of a design on the device
+ * built by the last run of 'vpr', without reading the architecture and
+ * building the device again. The results must be implemented on the same
+ * architecture, device and channel width.
+ * The atom netlist of the design is read again, as the packing results refer
+ * to it. Timing analysis is skipped, so only the results themselves, which
+ * bitstream generation requires, are available
+ */
+int vpr_load_results(const std::string& circuit_file,
+                     const std::string& net_file,
+                     const std::string& place_file,
+                     const std::string& route_file) {
+  vtr::ScopedStartFinishTimer t("Load VPR results of '" + circuit_file + "'");
+
+  if (nullptr == kept_arch) {
+    VTR_LOG_ERROR(
+      "No device is built by 'vpr' to load the results of '%s'!\n",
+      circuit_file.c_str());
+    return openfpga::CMD_EXEC_FATAL_ERROR;
+  }
+
+  t_vpr_setup vpr_setup = kept_vpr_setup;
+  vpr_setup.PackerOpts.circuit_file_name = circuit_file;
+  vpr_setup.FileNameOpts.NetFile = net_file;
+  vpr_setup.FileNameOpts.PlaceFile = place_file;
+  vpr_setup.FileNameOpts.RouteFile = route_file;
+  vpr_setup.PackerOpts.doPacking = STAGE_LOAD;
+  vpr_setup.PlacerOpts.doPlacement = STAGE_LOAD;
+  vpr_setup.RouterOpts.doRouting = STAGE_LOAD;
+  vpr_setup.AnalysisOpts.doAnalysis = STAGE_SKIP;
+  vpr_setup.TimingEnabled = false;
+  vpr_setup.Timing.timing_analysis_enabled = false;
+
+  try {
+    /* Release the clustered netlist of the previous design first, which owns
+     * the pbs referring to the atom netlist */
+    auto& cluster_ctx = g_vpr_ctx.mutable_clustering();
+    for (auto blk_id : cluster_ctx.clb_nlist.blocks()) {
+      cluster_ctx.clb_nlist.remove_block(blk_id);
+    }
+    cluster_ctx.clb_nlist = ClusteredNetlist();
+
+    auto& atom_ctx = g_vpr_ctx.mutable_atom();
+    atom_ctx.lookup = AtomLookup();
+    atom_ctx.nlist =
+      read_and_process_circuit(e_circuit_format::AUTO, vpr_setup, *kept_arch);
+
+    vpr_load_packing(vpr_setup, *kept_arch);
+    vpr_load_placement(vpr_setup, *kept_arch);
+
+    NetPinsMatrix<float> net_delay =
+      make_net_pins_matrix<float>((const Netlist<>&)cluster_ctx.clb_nlist);
+    RouteStatus route_status = vpr_load_routing(
+      vpr_setup, *kept_arch, g_vpr_ctx.device().chan_width.max, nullptr,
+      net_delay, vpr_setup.RouterOpts.flat_routing);
+    if (!route_status.success()) {
+      VTR_LOG_ERROR("Routing results in '%s' are not legal!\n",
+                    route_file.c_str());
+      return openfpga::CMD_EXEC_FATAL_ERROR;
+    }
+
+  } catch (const VprError& vpr_error) {
+    vpr_print_error(vpr_error);
+    return openfpga::CMD_EXEC_FATAL_ERROR;
+
+  } catch (const vtr::VtrError& vtr_error) {
+    VTR_LOG_ERROR("%s:%d %s\n", vtr_error.filename_c_str(), vtr_error.line(),
+                  vtr_error.what());
+    return openfpga::CMD_EXEC_FATAL_ERROR;
+  }
+
+  return openfpga::CMD_EXEC_SUCCESS;
+}
+
 /**
  * VPR program with clean up
  */
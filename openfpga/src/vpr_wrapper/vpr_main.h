@@ -1,6 +1,8 @@
 #ifndef VPR_MAIN_H
 #define VPR_MAIN_H
 
+#include <string>
+
 /* Begin namespace vpr */
 namespace vpr {
 
@@ -8,6 +10,11 @@ int vpr_wrapper(int argc, char** argv);
 
 int vpr_standalone_wrapper(int argc, char** argv);
 
+int vpr_load_results(const std::string& circuit_file,
+                     const std::string& net_file,
+                     const std::string& place_file,
+                     const std::string& route_file);
+
 } /* End namespace vpr */
 
 #endif
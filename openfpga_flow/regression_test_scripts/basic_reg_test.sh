@@ -27,6 +27,22 @@ run-task basic_tests/preload_unique_blocks/write_bin_unique_blocks_full_flow $@
 run-task basic_tests/preload_unique_blocks/read_unique_blocks_bin    $@
 run-task basic_tests/preload_unique_blocks/read_bin_write_xml $@
 
+echo -e "Testing fabric checkpoints"
+run-task basic_tests/fabric_checkpoint/write_checkpoint $@
+run-task basic_tests/fabric_checkpoint/read_checkpoint $@
+run-task basic_tests/fabric_checkpoint/build_fabric_threads $@
+
+echo -e "Testing bitstream-only view of fabric"
+run-task basic_tests/bitstream_only/full_build $@
+run-task basic_tests/bitstream_only/bitstream_only $@
+run-task basic_tests/bitstream_only/full_build_using_index $@
+run-task basic_tests/bitstream_only/bitstream_only_using_index $@
+run-task basic_tests/bitstream_only/bitstream_only_random_key $@
+run-task basic_tests/bitstream_only/full_build_random_key $@
+
+echo -e "Testing a batch of designs on one fabric"
+run-task basic_tests/design_batch $@
+
 
 echo -e "Testing testbenches using fpga core wrapper"
 run-task basic_tests/full_testbench/fpga_core_wrapper $@
@@ -46,6 +62,7 @@ run-task basic_tests/full_testbench/configuration_chain_use_setb $@
 run-task basic_tests/full_testbench/configuration_chain_use_set_reset $@
 run-task basic_tests/full_testbench/configuration_chain_config_enable_scff $@
 run-task basic_tests/full_testbench/multi_region_configuration_chain $@
+run-task basic_tests/full_testbench/multi_region_configuration_chain_balanced $@
 run-task basic_tests/full_testbench/multi_region_configuration_chain_2clk $@
 run-task basic_tests/full_testbench/multi_region_configuration_chain_3clk $@
 run-task basic_tests/full_testbench/fast_configuration_chain $@
@@ -18,6 +18,13 @@ run-task fpga_bitstream/generate_bitstream/ql_memory_bank_shift_register/device_
 echo -e "Testing bitstream generation for an 4x4 FPGA device (randomly overwrite fabric bits)";
 run-task fpga_bitstream/overwrite_bitstream/device_4x4 $@
 
+echo -e "Testing incremental update of fabric bitstream";
+run-task fpga_bitstream/incremental_fabric_bitstream $@
+
+echo -e "Testing difference between bitstreams";
+run-task fpga_bitstream/fabric_bitstream_diff/configuration_chain $@
+run-task fpga_bitstream/fabric_bitstream_diff/ql_memory_bank_flatten $@
+
 echo -e "Testing bitstream generation for an 96x96 FPGA device";
 run-task fpga_bitstream/generate_bitstream/configuration_chain/device_96x96 $@
 run-task fpga_bitstream/generate_bitstream/ql_memory_bank_shift_register/device_72x72 $@
@@ -49,6 +56,11 @@ echo -e "Testing report bitstream distribution to file";
 run-task fpga_bitstream/report_bitstream_distribution/default_depth $@
 run-task fpga_bitstream/report_bitstream_distribution/custom_depth $@
 
+echo -e "Testing report configuration time to file";
+run-task fpga_bitstream/report_configuration_time/configuration_chain $@
+run-task fpga_bitstream/report_configuration_time/memory_bank $@
+run-task fpga_bitstream/report_configuration_time/ql_memory_bank_flatten $@
+
 echo -e "Testing bitstream file with don't care bits";
 run-task fpga_bitstream/dont_care_bits/ql_memory_bank_flatten $@
 run-task fpga_bitstream/dont_care_bits/ql_memory_bank_shift_register $@
@@ -0,0 +1,81 @@
+#!/usr/bin/env python3
+"""
+Generate a bitstream setting file which flips a number of configuration bits
+of a fabric bitstream, so that a modified bitstream can be built on the same
+fabric and design. This is used by regression tests of incremental bitstream
+generation and bitstream differences.
+
+Usage:
+  python3 generate_overwrite_bitstream_setting.py
+    --fabric_bitstream <fabric_bitstream.xml>
+    --output <bitstream_setting.xml>
+    [--num_bits <int>] [--seed <int>]
+
+The fabric bitstream should be written by the command 'write_fabric_bitstream'
+in XML format. When the number of bits is 0, an empty bitstream setting file is
+written, which can be used to drop any overwriting of the bitstream.
+"""
+
+import argparse
+import random
+import sys
+import xml.etree.ElementTree as ET
+
+
+def read_fabric_bitstream_bits(fname):
+    """Return the list of (path, value) of all the bits in a fabric bitstream"""
+    bits = []
+    root = ET.parse(fname).getroot()
+    if root.tag != "fabric_bitstream":
+        sys.exit("Root tag of '%s' is not 'fabric_bitstream', but '%s'" % (fname, root.tag))
+    for region in root:
+        for bit in region:
+            if bit.tag != "bit" or "path" not in bit.attrib or "value" not in bit.attrib:
+                sys.exit("Invalid bit node in '%s'" % fname)
+            bits.append((bit.attrib["path"], bit.attrib["value"]))
+    return bits
+
+
+def write_bitstream_setting(fname, bits):
+    """Write a bitstream setting file which overwrites the given bits"""
+    with open(fname, "w") as fp:
+        if not bits:
+            fp.write("<openfpga_bitstream_setting/>\n")
+            return
+        fp.write("<openfpga_bitstream_setting>\n")
+        fp.write("  <overwrite_bitstream>\n")
+        for path, value in bits:
+            # Paths of bitstream settings do not include the memory port
+            fp.write('    <bit value="%s" path="%s"/>\n' % (value, path.replace(".mem_out[", "[")))
+        fp.write("  </overwrite_bitstream>\n")
+        fp.write("</openfpga_bitstream_setting>\n")
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Generate a bitstream setting file flipping bits of a fabric bitstream"
+    )
+    parser.add_argument("--fabric_bitstream", help="Fabric bitstream in XML format")
+    parser.add_argument("--output", required=True, help="Bitstream setting file to write")
+    parser.add_argument("--num_bits", type=int, default=10, help="Number of bits to flip")
+    parser.add_argument("--seed", type=int, default=1, help="Seed to select the bits")
+    args = parser.parse_args()
+
+    flipped_bits = []
+    if args.num_bits > 0:
+        if not args.fabric_bitstream:
+            sys.exit("A fabric bitstream is required to flip any bit")
+        bits = [
+            bit for bit in read_fabric_bitstream_bits(args.fabric_bitstream) if bit[1] in ("0", "1")
+        ]
+        if args.num_bits > len(bits):
+            sys.exit("Cannot flip %d bits out of %d bits" % (args.num_bits, len(bits)))
+        random.seed(args.seed)
+        for path, value in random.sample(bits, args.num_bits):
+            flipped_bits.append((path, "1" if value == "0" else "0"))
+    write_bitstream_setting(args.output, flipped_bits)
+    print("Flipped %d bits in '%s'" % (len(flipped_bits), args.output))
+
+
+if __name__ == "__main__":
+    main()
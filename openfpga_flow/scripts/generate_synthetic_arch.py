@@ -0,0 +1,958 @@
+# = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = =
+# Script Name   : generate_synthetic_arch.py
+# Description   : This script generates a pair of consistent VPR and OpenFPGA
+#                 architecture files of an arbitrary array size, together with
+#                 a synthetic benchmark which fills the array and OpenFPGA
+#                 shell scripts to implement the benchmark and to run the
+#                 full OpenFPGA flow on it.
+#                 It is the input of run_synthetic_stress.py, which records
+#                 the runtime and peak memory of each OpenFPGA command
+# Args          : python3 generate_synthetic_arch.py --help
+# = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = =
+
+import os
+import sys
+import json
+import random
+import argparse
+import logging
+
+if sys.version_info[0] < 3:
+    raise Exception("generate_synthetic_arch script must be using Python 3")
+
+#####################################################################
+# Error codes
+#####################################################################
+error_codes = {"SUCCESS": 0, "ERROR": 1, "OPTION_ERROR": 2, "FILE_ERROR": 3}
+
+#####################################################################
+# Initialize logger
+#####################################################################
+logging.basicConfig(format="%(levelname)s: %(message)s", level=logging.INFO)
+
+openfpga_path = os.path.abspath(
+    os.path.join(os.path.dirname(os.path.abspath(__file__)), os.pardir, os.pardir)
+)
+
+# Number of I/Os per I/O tile, same as the k4_N4 architectures
+IO_CAPACITY = 8
+
+# Name of the files written to the output directory
+MANIFEST_FILE = "synthetic_arch.json"
+VPR_ARCH_FILE = "vpr_arch.xml"
+OPENFPGA_ARCH_FILE = "openfpga_arch.xml"
+BENCHMARK_NAME = "synthetic"
+IMPLEMENT_SCRIPT_FILE = "implement.openfpga"
+FLOW_SCRIPT_FILE = "flow.openfpga"
+
+#####################################################################
+# Memory cells of each configuration protocol, which are the same as
+# the k4_N4_40nm_<cc|bank|frame|standalone>_openfpga.xml architectures
+#####################################################################
+config_memory_models = {
+    "scan_chain": (
+        "DFF",
+        """    <circuit_model type="ccff" name="DFF" prefix="DFF" verilog_netlist="${OPENFPGA_PATH}/openfpga_flow/openfpga_cell_library/verilog/dff.v">
+      <design_technology type="cmos"/>
+      <input_buffer exist="true" circuit_model_name="INVTX1"/>
+      <output_buffer exist="true" circuit_model_name="INVTX1"/>
+      <port type="input" prefix="D" size="1"/>
+      <port type="output" prefix="Q" size="1"/>
+      <port type="output" prefix="QN" size="1"/>
+      <port type="clock" prefix="prog_clk" lib_name="CK" size="1" is_global="true" default_val="0" is_prog="true"/>
+    </circuit_model>
+""",
+    ),
+    "memory_bank": (
+        "SRAM",
+        """    <circuit_model type="sram" name="SRAM" prefix="SRAM" verilog_netlist="${OPENFPGA_PATH}/openfpga_flow/openfpga_cell_library/verilog/sram.v">
+      <design_technology type="cmos"/>
+      <input_buffer exist="true" circuit_model_name="INVTX1"/>
+      <output_buffer exist="true" circuit_model_name="INVTX1"/>
+      <port type="bl" prefix="bl" lib_name="D" size="1"/>
+      <port type="wl" prefix="wl" lib_name="WE" size="1"/>
+      <port type="output" prefix="out" lib_name="Q" size="1"/>
+      <port type="output" prefix="outb" lib_name="QN" size="1"/>
+    </circuit_model>
+""",
+    ),
+    "frame_based": (
+        "LATCH",
+        """    <circuit_model type="sram" name="LATCH" prefix="LATCH" verilog_netlist="${OPENFPGA_PATH}/openfpga_flow/openfpga_cell_library/verilog/latch.v">
+      <design_technology type="cmos"/>
+      <input_buffer exist="true" circuit_model_name="INVTX1"/>
+      <output_buffer exist="true" circuit_model_name="INVTX1"/>
+      <port type="bl" prefix="bl" lib_name="D" size="1"/>
+      <port type="wl" prefix="wl" lib_name="WE" size="1"/>
+      <port type="output" prefix="Q" lib_name="Q" size="1"/>
+      <port type="output" prefix="Qb" lib_name="QN" size="1"/>
+    </circuit_model>
+""",
+    ),
+    "standalone": (
+        "LATCHR",
+        """    <circuit_model type="sram" name="LATCHR" prefix="LATCHR" verilog_netlist="${OPENFPGA_PATH}/openfpga_flow/openfpga_cell_library/verilog/latch.v">
+      <design_technology type="cmos"/>
+      <input_buffer exist="true" circuit_model_name="INVTX1"/>
+      <output_buffer exist="true" circuit_model_name="INVTX1"/>
+      <port type="input" prefix="pReset" lib_name="RST" size="1" is_global="true" default_val="0" is_reset="true" is_prog="true"/>
+      <port type="bl" prefix="bl" lib_name="D" size="1"/>
+      <port type="wl" prefix="wl" lib_name="WE" size="1"/>
+      <port type="output" prefix="Q" lib_name="Q" size="1"/>
+      <port type="output" prefix="Qb" lib_name="QN" size="1"/>
+    </circuit_model>
+""",
+    ),
+}
+
+
+#####################################################################
+# Compute the dimensions of the array and the number of each tile,
+# which are shared by the architecture and benchmark generators
+#####################################################################
+def compute_tile_counts(args):
+    counts = {}
+    counts["io"] = 2 * (args.width + args.height)
+    counts["dsp_cols"] = 0
+    if 0 < args.dsp_period:
+        counts["dsp_cols"] = len(range(args.dsp_startx, args.width + 1, args.dsp_period))
+    # A multiplier is 2 rows high, an odd row at the top is left empty
+    counts["dsp"] = counts["dsp_cols"] * (args.height // 2)
+    counts["clb"] = (args.width - counts["dsp_cols"]) * args.height
+    return counts
+
+
+#####################################################################
+# Write the VPR architecture
+# - A perimeter of I/O tiles with a capacity of IO_CAPACITY
+# - Configurable logic blocks of N basic logic elements, each of which
+#   is a K-input LUT which can be optionally registered
+# - Optional columns of 8-bit multipliers
+# - Unidirectional routing wires of a single length
+#####################################################################
+def write_vpr_arch(fname, args):
+    k = args.lut_size
+    n = args.cluster_size
+    num_clb_inputs = (k * (n + 1)) // 2
+    use_dsp = 0 < args.dsp_period
+
+    models = ""
+    dsp_tile = ""
+    dsp_cols = ""
+    dsp_pb_type = ""
+    if use_dsp:
+        models = """    <model name="mult_8">
+      <input_ports>
+        <port name="A" combinational_sink_ports="Y"/>
+        <port name="B" combinational_sink_ports="Y"/>
+      </input_ports>
+      <output_ports>
+        <port name="Y"/>
+      </output_ports>
+    </model>
+"""
+        dsp_tile = """    <tile name="mult_8" height="2" area="396000">
+      <sub_tile name="mult_8">
+        <equivalent_sites>
+          <site pb_type="mult_8" pin_mapping="direct"/>
+        </equivalent_sites>
+        <input name="a" num_pins="8"/>
+        <input name="b" num_pins="8"/>
+        <output name="out" num_pins="16"/>
+        <fc in_type="frac" in_val="0.15" out_type="frac" out_val="0.10"/>
+        <pinlocations pattern="custom">
+          <loc side="left">mult_8.a[0:3] mult_8.b[0:3] mult_8.out[0:7]</loc>
+          <loc side="top"/>
+          <loc side="right">mult_8.a[4:7] mult_8.b[4:7] mult_8.out[8:15]</loc>
+          <loc side="bottom"/>
+        </pinlocations>
+      </sub_tile>
+    </tile>
+"""
+        dsp_cols = """      <col type="mult_8" startx="{start}" starty="1" repeatx="{period}" priority="20"/>
+      <col type="EMPTY" startx="{start}" repeatx="{period}" starty="1" priority="19"/>
+""".format(
+            start=args.dsp_startx, period=args.dsp_period
+        )
+        dsp_pb_type = """    <pb_type name="mult_8">
+      <input name="a" num_pins="8"/>
+      <input name="b" num_pins="8"/>
+      <output name="out" num_pins="16"/>
+      <mode name="mult_8x8">
+        <pb_type name="mult_8x8" blif_model=".subckt mult_8" num_pb="1">
+          <input name="A" num_pins="8"/>
+          <input name="B" num_pins="8"/>
+          <output name="Y" num_pins="16"/>
+          <delay_constant max="1.523e-9" min="0.776e-9" in_port="mult_8x8.A" out_port="mult_8x8.Y"/>
+          <delay_constant max="1.523e-9" min="0.776e-9" in_port="mult_8x8.B" out_port="mult_8x8.Y"/>
+        </pb_type>
+        <interconnect>
+          <direct name="a2a" input="mult_8.a" output="mult_8x8.A">
+            <delay_constant max="134e-12" min="74e-12" in_port="mult_8.a" out_port="mult_8x8.A"/>
+          </direct>
+          <direct name="b2b" input="mult_8.b" output="mult_8x8.B">
+            <delay_constant max="134e-12" min="74e-12" in_port="mult_8.b" out_port="mult_8x8.B"/>
+          </direct>
+          <direct name="out2out" input="mult_8x8.Y" output="mult_8.out">
+            <delay_constant max="1.93e-9" min="74e-12" in_port="mult_8x8.Y" out_port="mult_8.out"/>
+          </direct>
+        </interconnect>
+      </mode>
+    </pb_type>
+"""
+
+    lut_delays = "".join(["                261e-12\n" for ipin in range(k)])
+
+    arch = """<?xml version="1.0"?>
+<!--
+  Synthetic architecture generated by generate_synthetic_arch.py
+  - General purpose logic block: K = {k}, N = {n}, I = {i}
+  - Routing architecture: L = {seg_len}, fc_in = 0.15, Fc_out = 0.1
+  - Fixed layout '{device}' with a channel width of {chan_width}
+-->
+<architecture>
+  <models>
+    <model name="io">
+      <input_ports>
+        <port name="outpad"/>
+      </input_ports>
+      <output_ports>
+        <port name="inpad"/>
+      </output_ports>
+    </model>
+{models}  </models>
+  <tiles>
+    <tile name="io" area="0">
+      <sub_tile name="io" capacity="{io_capacity}">
+        <equivalent_sites>
+          <site pb_type="io"/>
+        </equivalent_sites>
+        <input name="outpad" num_pins="1"/>
+        <output name="inpad" num_pins="1"/>
+        <fc in_type="frac" in_val="0.15" out_type="frac" out_val="0.10"/>
+        <pinlocations pattern="custom">
+          <loc side="left">io.outpad io.inpad</loc>
+          <loc side="top">io.outpad io.inpad</loc>
+          <loc side="right">io.outpad io.inpad</loc>
+          <loc side="bottom">io.outpad io.inpad</loc>
+        </pinlocations>
+      </sub_tile>
+    </tile>
+    <tile name="clb" area="53894">
+      <sub_tile name="clb">
+        <equivalent_sites>
+          <site pb_type="clb"/>
+        </equivalent_sites>
+        <input name="I" num_pins="{i}" equivalent="full"/>
+        <output name="O" num_pins="{n}" equivalent="none"/>
+        <clock name="clk" num_pins="1"/>
+        <fc in_type="frac" in_val="0.15" out_type="frac" out_val="0.10"/>
+        <pinlocations pattern="spread"/>
+      </sub_tile>
+    </tile>
+{dsp_tile}  </tiles>
+  <layout tileable="true" concat_wire="false" concat_pass_wire="true">
+    <fixed_layout name="{device}" width="{layout_width}" height="{layout_height}">
+      <!--Perimeter of 'io' blocks with 'EMPTY' blocks at corners-->
+      <perimeter type="io" priority="100"/>
+      <corners type="EMPTY" priority="101"/>
+      <!--Fill with 'clb'-->
+      <fill type="clb" priority="10"/>
+{dsp_cols}    </fixed_layout>
+  </layout>
+  <device>
+    <sizing R_minW_nmos="8926" R_minW_pmos="16067"/>
+    <area grid_logic_tile_area="0"/>
+    <chan_width_distr>
+      <x distr="uniform" peak="1.000000"/>
+      <y distr="uniform" peak="1.000000"/>
+    </chan_width_distr>
+    <switch_block type="wilton" fs="3"/>
+    <connection_block input_switch_name="ipin_cblock"/>
+  </device>
+  <switchlist>
+    <switch type="mux" name="0" R="551" Cin=".77e-15" Cout="4e-15" Tdel="58e-12" mux_trans_size="2.630740" buf_size="27.645901"/>
+    <switch type="mux" name="ipin_cblock" R="2231.5" Cout="0." Cin="1.47e-15" Tdel="7.247000e-11" mux_trans_size="1.222260" buf_size="auto"/>
+  </switchlist>
+  <segmentlist>
+    <segment name="L{seg_len}" freq="1.000000" length="{seg_len}" type="unidir" Rmetal="101" Cmetal="22.5e-15">
+      <mux name="0"/>
+      <sb type="pattern">{sb_pattern}</sb>
+      <cb type="pattern">{cb_pattern}</cb>
+    </segment>
+  </segmentlist>
+  <complexblocklist>
+    <pb_type name="io">
+      <input name="outpad" num_pins="1"/>
+      <output name="inpad" num_pins="1"/>
+      <mode name="physical" disable_packing="true">
+        <pb_type name="iopad" blif_model=".subckt io" num_pb="1">
+          <input name="outpad" num_pins="1"/>
+          <output name="inpad" num_pins="1"/>
+        </pb_type>
+        <interconnect>
+          <direct name="outpad" input="io.outpad" output="iopad.outpad">
+            <delay_constant max="1.394e-11" in_port="io.outpad" out_port="iopad.outpad"/>
+          </direct>
+          <direct name="inpad" input="iopad.inpad" output="io.inpad">
+            <delay_constant max="4.243e-11" in_port="iopad.inpad" out_port="io.inpad"/>
+          </direct>
+        </interconnect>
+      </mode>
+      <mode name="inpad">
+        <pb_type name="inpad" blif_model=".input" num_pb="1">
+          <output name="inpad" num_pins="1"/>
+        </pb_type>
+        <interconnect>
+          <direct name="inpad" input="inpad.inpad" output="io.inpad">
+            <delay_constant max="4.243e-11" in_port="inpad.inpad" out_port="io.inpad"/>
+          </direct>
+        </interconnect>
+      </mode>
+      <mode name="outpad">
+        <pb_type name="outpad" blif_model=".output" num_pb="1">
+          <input name="outpad" num_pins="1"/>
+        </pb_type>
+        <interconnect>
+          <direct name="outpad" input="io.outpad" output="outpad.outpad">
+            <delay_constant max="1.394e-11" in_port="io.outpad" out_port="outpad.outpad"/>
+          </direct>
+        </interconnect>
+      </mode>
+      <power method="ignore"/>
+    </pb_type>
+    <pb_type name="clb">
+      <input name="I" num_pins="{i}" equivalent="full"/>
+      <output name="O" num_pins="{n}" equivalent="none"/>
+      <clock name="clk" num_pins="1"/>
+      <pb_type name="fle" num_pb="{n}">
+        <input name="in" num_pins="{k}"/>
+        <output name="out" num_pins="1"/>
+        <clock name="clk" num_pins="1"/>
+        <mode name="n1_lut{k}">
+          <pb_type name="ble{k}" num_pb="1">
+            <input name="in" num_pins="{k}"/>
+            <output name="out" num_pins="1"/>
+            <clock name="clk" num_pins="1"/>
+            <pb_type name="lut{k}" blif_model=".names" num_pb="1" class="lut">
+              <input name="in" num_pins="{k}" port_class="lut_in"/>
+              <output name="out" num_pins="1" port_class="lut_out"/>
+              <delay_matrix type="max" in_port="lut{k}.in" out_port="lut{k}.out">
+{lut_delays}              </delay_matrix>
+            </pb_type>
+            <pb_type name="ff" blif_model=".latch" num_pb="1" class="flipflop">
+              <input name="D" num_pins="1" port_class="D"/>
+              <output name="Q" num_pins="1" port_class="Q"/>
+              <clock name="clk" num_pins="1" port_class="clock"/>
+              <T_setup value="66e-12" port="ff.D" clock="clk"/>
+              <T_clock_to_Q max="124e-12" port="ff.Q" clock="clk"/>
+            </pb_type>
+            <interconnect>
+              <direct name="direct1" input="ble{k}.in" output="lut{k}[0:0].in"/>
+              <direct name="direct2" input="lut{k}.out" output="ff.D">
+                <pack_pattern name="ble{k}" in_port="lut{k}.out" out_port="ff.D"/>
+              </direct>
+              <direct name="direct3" input="ble{k}.clk" output="ff.clk"/>
+              <mux name="mux1" input="ff.Q lut{k}.out" output="ble{k}.out">
+                <delay_constant max="25e-12" in_port="lut{k}.out" out_port="ble{k}.out"/>
+                <delay_constant max="45e-12" in_port="ff.Q" out_port="ble{k}.out"/>
+              </mux>
+            </interconnect>
+          </pb_type>
+          <interconnect>
+            <direct name="direct1" input="fle.in" output="ble{k}.in"/>
+            <direct name="direct2" input="ble{k}.out" output="fle.out[0:0]"/>
+            <direct name="direct3" input="fle.clk" output="ble{k}.clk"/>
+          </interconnect>
+        </mode>
+      </pb_type>
+      <interconnect>
+        <complete name="crossbar" input="clb.I fle[{msb}:0].out" output="fle[{msb}:0].in">
+          <delay_constant max="95e-12" in_port="clb.I" out_port="fle[{msb}:0].in"/>
+          <delay_constant max="75e-12" in_port="fle[{msb}:0].out" out_port="fle[{msb}:0].in"/>
+        </complete>
+        <complete name="clks" input="clb.clk" output="fle[{msb}:0].clk">
+        </complete>
+        <direct name="clbouts1" input="fle[{msb}:0].out" output="clb.O"/>
+      </interconnect>
+    </pb_type>
+{dsp_pb_type}  </complexblocklist>
+</architecture>
+""".format(
+        k=k,
+        n=n,
+        i=num_clb_inputs,
+        msb=n - 1,
+        seg_len=args.segment_length,
+        sb_pattern=" ".join(["1"] * (args.segment_length + 1)),
+        cb_pattern=" ".join(["1"] * args.segment_length),
+        device=args.device,
+        chan_width=args.chan_width,
+        layout_width=args.width + 2,
+        layout_height=args.height + 2,
+        io_capacity=IO_CAPACITY,
+        models=models,
+        dsp_tile=dsp_tile,
+        dsp_cols=dsp_cols,
+        dsp_pb_type=dsp_pb_type,
+        lut_delays=lut_delays,
+    )
+
+    with open(fname, "w") as fp:
+        fp.write(arch)
+
+
+#####################################################################
+# Write the OpenFPGA architecture, which annotates every pb_type and
+# routing resource of the VPR architecture written by write_vpr_arch()
+# The circuit models are the same as the k4_N4 architectures, except
+# the LUT size and the memory cell of the configuration protocol
+#####################################################################
+def write_openfpga_arch(fname, args):
+    k = args.lut_size
+    mem_model_name, mem_model = config_memory_models[args.config_protocol]
+    use_dsp = 0 < args.dsp_period
+
+    dsp_model = ""
+    dsp_annotation = ""
+    if use_dsp:
+        dsp_model = """    <circuit_model type="hard_logic" name="mult_8x8" prefix="mult_8x8" is_default="true" verilog_netlist="${OPENFPGA_PATH}/openfpga_flow/openfpga_cell_library/verilog/mult_8x8.v">
+      <design_technology type="cmos"/>
+      <input_buffer exist="true" circuit_model_name="INVTX1"/>
+      <output_buffer exist="true" circuit_model_name="INVTX1"/>
+      <port type="input" prefix="A" lib_name="A" size="8"/>
+      <port type="input" prefix="B" lib_name="B" size="8"/>
+      <port type="output" prefix="Y" lib_name="Y" size="16"/>
+    </circuit_model>
+"""
+        dsp_annotation = """    <pb_type name="mult_8" physical_mode_name="mult_8x8" idle_mode_name="mult_8x8"/>
+    <pb_type name="mult_8[mult_8x8].mult_8x8" circuit_model_name="mult_8x8"/>
+"""
+
+    arch = """<?xml version="1.0"?>
+<!-- Synthetic architecture annotation generated by generate_synthetic_arch.py
+     - General purpose logic block: K = {k}, N = {n}
+     - Configuration protocol: {protocol}
+  -->
+<openfpga_architecture>
+  <technology_library>
+    <device_library>
+      <device_model name="logic" type="transistor">
+        <lib type="industry" corner="TOP_TT" ref="M" path="${{OPENFPGA_PATH}}/openfpga_flow/tech/PTM_45nm/45nm.pm"/>
+        <design vdd="0.9" pn_ratio="2"/>
+        <pmos name="pch" chan_length="40e-9" min_width="140e-9" variation="logic_transistor_var"/>
+        <nmos name="nch" chan_length="40e-9" min_width="140e-9" variation="logic_transistor_var"/>
+      </device_model>
+    </device_library>
+    <variation_library>
+      <variation name="logic_transistor_var" abs_deviation="0.1" num_sigma="3"/>
+    </variation_library>
+  </technology_library>
+  <circuit_library>
+    <circuit_model type="inv_buf" name="INVTX1" prefix="INVTX1" is_default="true">
+      <design_technology type="cmos" topology="inverter" size="1"/>
+      <device_technology device_model_name="logic"/>
+      <port type="input" prefix="in" size="1"/>
+      <port type="output" prefix="out" size="1"/>
+      <delay_matrix type="rise" in_port="in" out_port="out">
+        10e-12
+      </delay_matrix>
+      <delay_matrix type="fall" in_port="in" out_port="out">
+        10e-12
+      </delay_matrix>
+    </circuit_model>
+    <circuit_model type="inv_buf" name="buf4" prefix="buf4" is_default="false">
+      <design_technology type="cmos" topology="buffer" size="1" num_level="2" f_per_stage="4"/>
+      <device_technology device_model_name="logic"/>
+      <port type="input" prefix="in" size="1"/>
+      <port type="output" prefix="out" size="1"/>
+      <delay_matrix type="rise" in_port="in" out_port="out">
+        10e-12
+      </delay_matrix>
+      <delay_matrix type="fall" in_port="in" out_port="out">
+        10e-12
+      </delay_matrix>
+    </circuit_model>
+    <circuit_model type="inv_buf" name="tap_buf4" prefix="tap_buf4" is_default="false">
+      <design_technology type="cmos" topology="buffer" size="1" num_level="3" f_per_stage="4"/>
+      <device_technology device_model_name="logic"/>
+      <port type="input" prefix="in" size="1"/>
+      <port type="output" prefix="out" size="1"/>
+      <delay_matrix type="rise" in_port="in" out_port="out">
+        10e-12
+      </delay_matrix>
+      <delay_matrix type="fall" in_port="in" out_port="out">
+        10e-12
+      </delay_matrix>
+    </circuit_model>
+    <circuit_model type="pass_gate" name="TGATE" prefix="TGATE" is_default="true">
+      <design_technology type="cmos" topology="transmission_gate" nmos_size="1" pmos_size="2"/>
+      <device_technology device_model_name="logic"/>
+      <input_buffer exist="false"/>
+      <output_buffer exist="false"/>
+      <port type="input" prefix="in" size="1"/>
+      <port type="input" prefix="sel" size="1"/>
+      <port type="input" prefix="selb" size="1"/>
+      <port type="output" prefix="out" size="1"/>
+      <delay_matrix type="rise" in_port="in sel selb" out_port="out">
+        10e-12 5e-12 5e-12
+      </delay_matrix>
+      <delay_matrix type="fall" in_port="in sel selb" out_port="out">
+        10e-12 5e-12 5e-12
+      </delay_matrix>
+    </circuit_model>
+    <circuit_model type="chan_wire" name="chan_segment" prefix="track_seg" is_default="true">
+      <design_technology type="cmos"/>
+      <input_buffer exist="false"/>
+      <output_buffer exist="false"/>
+      <port type="input" prefix="in" size="1"/>
+      <port type="output" prefix="out" size="1"/>
+      <wire_param model_type="pi" R="101" C="22.5e-15" num_level="1"/>
+    </circuit_model>
+    <circuit_model type="wire" name="direct_interc" prefix="direct_interc" is_default="true">
+      <design_technology type="cmos"/>
+      <input_buffer exist="false"/>
+      <output_buffer exist="false"/>
+      <port type="input" prefix="in" size="1"/>
+      <port type="output" prefix="out" size="1"/>
+      <wire_param model_type="pi" R="0" C="0" num_level="1"/>
+    </circuit_model>
+    <circuit_model type="mux" name="mux_tree" prefix="mux_tree" dump_structural_verilog="true">
+      <design_technology type="cmos" structure="tree" add_const_input="true" const_input_val="1"/>
+      <input_buffer exist="true" circuit_model_name="INVTX1"/>
+      <output_buffer exist="true" circuit_model_name="INVTX1"/>
+      <pass_gate_logic circuit_model_name="TGATE"/>
+      <port type="input" prefix="in" size="1"/>
+      <port type="output" prefix="out" size="1"/>
+      <port type="sram" prefix="sram" size="1"/>
+    </circuit_model>
+    <circuit_model type="mux" name="mux_tree_tapbuf" prefix="mux_tree_tapbuf" is_default="true" dump_structural_verilog="true">
+      <design_technology type="cmos" structure="tree" add_const_input="true" const_input_val="1"/>
+      <input_buffer exist="true" circuit_model_name="INVTX1"/>
+      <output_buffer exist="true" circuit_model_name="tap_buf4"/>
+      <pass_gate_logic circuit_model_name="TGATE"/>
+      <port type="input" prefix="in" size="1"/>
+      <port type="output" prefix="out" size="1"/>
+      <port type="sram" prefix="sram" size="1"/>
+    </circuit_model>
+    <circuit_model type="ff" name="DFFSRQ" prefix="DFFSRQ" verilog_netlist="${{OPENFPGA_PATH}}/openfpga_flow/openfpga_cell_library/verilog/dff.v">
+      <design_technology type="cmos"/>
+      <input_buffer exist="true" circuit_model_name="INVTX1"/>
+      <output_buffer exist="true" circuit_model_name="INVTX1"/>
+      <port type="input" prefix="D" size="1"/>
+      <port type="input" prefix="set" lib_name="SET" size="1" is_global="true" default_val="0" is_set="true"/>
+      <port type="input" prefix="reset" lib_name="RST" size="1" is_global="true" default_val="0" is_reset="true"/>
+      <port type="output" prefix="Q" size="1"/>
+      <port type="clock" prefix="clk" lib_name="CK" size="1" is_global="true" default_val="0"/>
+    </circuit_model>
+    <circuit_model type="lut" name="lut{k}" prefix="lut{k}" dump_structural_verilog="true">
+      <design_technology type="cmos"/>
+      <input_buffer exist="true" circuit_model_name="INVTX1"/>
+      <output_buffer exist="true" circuit_model_name="INVTX1"/>
+      <lut_input_inverter exist="true" circuit_model_name="INVTX1"/>
+      <lut_input_buffer exist="true" circuit_model_name="buf4"/>
+      <pass_gate_logic circuit_model_name="TGATE"/>
+      <port type="input" prefix="in" size="{k}"/>
+      <port type="output" prefix="out" size="1"/>
+      <port type="sram" prefix="sram" size="{lut_sram_size}"/>
+    </circuit_model>
+{mem_model}    <circuit_model type="iopad" name="GPIO" prefix="GPIO" verilog_netlist="${{OPENFPGA_PATH}}/openfpga_flow/openfpga_cell_library/verilog/gpio.v">
+      <design_technology type="cmos"/>
+      <input_buffer exist="true" circuit_model_name="INVTX1"/>
+      <output_buffer exist="true" circuit_model_name="INVTX1"/>
+      <port type="inout" prefix="PAD" size="1" is_global="true" is_io="true" is_data_io="true"/>
+      <port type="sram" prefix="DIR" size="1" mode_select="true" circuit_model_name="{mem_model_name}" default_val="1"/>
+      <port type="input" prefix="outpad" lib_name="A" size="1"/>
+      <port type="output" prefix="inpad" lib_name="Y" size="1"/>
+    </circuit_model>
+{dsp_model}  </circuit_library>
+  <configuration_protocol>
+    <organization type="{protocol}" circuit_model_name="{mem_model_name}"/>
+  </configuration_protocol>
+  <connection_block>
+    <switch name="ipin_cblock" circuit_model_name="mux_tree_tapbuf"/>
+  </connection_block>
+  <switch_block>
+    <switch name="0" circuit_model_name="mux_tree_tapbuf"/>
+  </switch_block>
+  <routing_segment>
+    <segment name="L{seg_len}" circuit_model_name="chan_segment"/>
+  </routing_segment>
+  <pb_type_annotations>
+    <pb_type name="io" physical_mode_name="physical" idle_mode_name="inpad"/>
+    <pb_type name="io[physical].iopad" circuit_model_name="GPIO" mode_bits="1"/>
+    <pb_type name="io[inpad].inpad" physical_pb_type_name="io[physical].iopad" mode_bits="1"/>
+    <pb_type name="io[outpad].outpad" physical_pb_type_name="io[physical].iopad" mode_bits="0"/>
+    <pb_type name="clb">
+      <interconnect name="crossbar" circuit_model_name="mux_tree"/>
+    </pb_type>
+    <pb_type name="clb.fle[n1_lut{k}].ble{k}.lut{k}" circuit_model_name="lut{k}"/>
+    <pb_type name="clb.fle[n1_lut{k}].ble{k}.ff" circuit_model_name="DFFSRQ"/>
+{dsp_annotation}  </pb_type_annotations>
+</openfpga_architecture>
+""".format(
+        k=k,
+        n=args.cluster_size,
+        lut_sram_size=2**k,
+        protocol=args.config_protocol,
+        seg_len=args.segment_length,
+        mem_model=mem_model,
+        mem_model_name=mem_model_name,
+        dsp_model=dsp_model,
+        dsp_annotation=dsp_annotation,
+    )
+
+    with open(fname, "w") as fp:
+        fp.write(arch.replace("${OPENFPGA_PATH}", openfpga_path))
+
+
+#####################################################################
+# Synthetic benchmark
+# The netlist is a random directed acyclic graph of K-input LUTs, where
+# - each LUT consumes at least one signal which has no fanout yet, so
+#   that no logic is swept by VPR,
+# - other inputs are picked among the most recent signals, so that the
+#   netlist has some locality which keeps it routable at large sizes,
+# - a fraction of LUTs is registered and 8-bit multipliers are
+#   interleaved when the architecture contains them.
+# Signals which have no fanout at the end are reduced by XOR trees
+# until they fit the primary outputs
+#####################################################################
+class SyntheticNetlist:
+    def __init__(self, lut_size, rng, window):
+        self.lut_size = lut_size
+        self.rng = rng
+        self.window = window
+        self.inputs = []
+        self.outputs = []
+        self.signals = []
+        self.dangling = {}
+        self.luts = []
+        self.latches = []
+        self.mults = []
+
+    def add_signal(self, name):
+        self.signals.append(name)
+        # A dict keeps insertion order, the oldest dangling signal first
+        self.dangling[name] = None
+
+    def pick_inputs(self, num_inputs):
+        picked = []
+        if self.dangling:
+            oldest = next(iter(self.dangling))
+            picked.append(oldest)
+        recent = self.signals[-self.window :]
+        num_trials = 0
+        while (len(picked) < num_inputs) and (num_trials < 4 * num_inputs):
+            candidate = self.rng.choice(recent)
+            if candidate not in picked:
+                picked.append(candidate)
+            num_trials += 1
+        for signal in picked:
+            self.dangling.pop(signal, None)
+        return picked
+
+    def add_lut(self, registered):
+        index = len(self.luts)
+        inputs = self.pick_inputs(self.lut_size)
+        # Random truth table which is neither constant 0 nor constant 1
+        num_rows = 2 ** len(inputs)
+        truth_table = self.rng.getrandbits(num_rows)
+        if truth_table in (0, (1 << num_rows) - 1):
+            truth_table ^= 1
+        output = "n" + str(index)
+        self.luts.append((inputs, output, truth_table))
+        if registered:
+            self.latches.append((output, "q" + str(index)))
+            output = "q" + str(index)
+        self.add_signal(output)
+
+    def add_mult(self):
+        index = len(self.mults)
+        inputs = self.pick_inputs(16)
+        while len(inputs) < 16:
+            inputs.append(self.rng.choice(self.signals))
+        outputs = ["m" + str(index) + "_" + str(ipin) for ipin in range(16)]
+        self.mults.append((inputs, outputs))
+        for output in outputs:
+            self.add_signal(output)
+
+    def reduce_dangling(self, num_outputs):
+        index = 0
+        while len(self.dangling) > num_outputs:
+            group = list(self.dangling)[: self.lut_size]
+            for signal in group:
+                self.dangling.pop(signal)
+            # Parity of all the inputs
+            truth_table = 0
+            for row in range(2 ** len(group)):
+                if 1 == bin(row).count("1") % 2:
+                    truth_table |= 1 << row
+            output = "x" + str(index)
+            self.luts.append((group, output, truth_table))
+            self.add_signal(output)
+            index += 1
+
+    def write_blif(self, fname, model_name, clock):
+        with open(fname, "w") as fp:
+            fp.write("# Synthetic benchmark generated by generate_synthetic_arch.py\n")
+            fp.write(".model " + model_name + "\n")
+            fp.write(".inputs " + " ".join(([clock] if self.latches else []) + self.inputs) + "\n")
+            fp.write(".outputs " + " ".join(self.outputs) + "\n")
+            for inputs, output, truth_table in self.luts:
+                fp.write(".names " + " ".join(inputs) + " " + output + "\n")
+                for row in range(2 ** len(inputs)):
+                    if (truth_table >> row) & 1:
+                        bits = [str((row >> ipin) & 1) for ipin in range(len(inputs))]
+                        fp.write("".join(bits) + " 1\n")
+            for data, output in self.latches:
+                fp.write(".latch " + data + " " + output + " re " + clock + " 0\n")
+            for inputs, outputs in self.mults:
+                pins = ["A[" + str(ipin) + "]=" + inputs[ipin] for ipin in range(8)]
+                pins += ["B[" + str(ipin) + "]=" + inputs[8 + ipin] for ipin in range(8)]
+                pins += ["Y[" + str(ipin) + "]=" + outputs[ipin] for ipin in range(16)]
+                fp.write(".subckt mult_8 " + " ".join(pins) + "\n")
+            fp.write(".end\n")
+            if self.mults:
+                fp.write("\n.model mult_8\n")
+                fp.write(".inputs " + " ".join(["A[" + str(ipin) + "]" for ipin in range(8)]))
+                fp.write(" " + " ".join(["B[" + str(ipin) + "]" for ipin in range(8)]) + "\n")
+                fp.write(
+                    ".outputs " + " ".join(["Y[" + str(ipin) + "]" for ipin in range(16)]) + "\n"
+                )
+                fp.write(".blackbox\n.end\n")
+
+
+def generate_benchmark(fname, args, counts):
+    rng = random.Random(args.seed)
+    num_luts = int(args.utilization * counts["clb"] * args.cluster_size)
+    num_mults = int(args.dsp_utilization * counts["dsp"])
+    # Reserve one I/O for the clock
+    num_ios = max(2 * args.lut_size, int(args.io_utilization * counts["io"] * IO_CAPACITY)) - 1
+    num_inputs = num_ios // 2
+    num_outputs = num_ios - num_inputs
+    window = max(args.locality, args.lut_size)
+
+    netlist = SyntheticNetlist(args.lut_size, rng, window)
+    for ipin in range(num_inputs):
+        name = "pi" + str(ipin)
+        netlist.inputs.append(name)
+        netlist.add_signal(name)
+
+    # Interleave multipliers evenly among LUTs
+    mult_period = num_luts // (num_mults + 1) if num_mults else num_luts + 1
+    for ilut in range(num_luts):
+        netlist.add_lut(rng.random() < args.ff_ratio)
+        if (0 == (ilut + 1) % mult_period) and (len(netlist.mults) < num_mults):
+            netlist.add_mult()
+
+    netlist.reduce_dangling(num_outputs)
+    netlist.outputs = list(netlist.dangling)
+    # Drive the remaining outputs by the most recent signals
+    for signal in reversed(netlist.signals):
+        if len(netlist.outputs) >= num_outputs:
+            break
+        if (signal not in netlist.dangling) and (signal not in netlist.inputs):
+            netlist.outputs.append(signal)
+
+    netlist.write_blif(fname, BENCHMARK_NAME, "clk")
+    return {
+        "num_inputs": len(netlist.inputs) + (1 if netlist.latches else 0),
+        "num_outputs": len(netlist.outputs),
+        "num_luts": len(netlist.luts),
+        "num_latches": len(netlist.latches),
+        "num_mults": len(netlist.mults),
+    }
+
+
+#####################################################################
+# Write OpenFPGA shell scripts
+# - The implementation script packs, places and routes the benchmark,
+#   which is done once per output directory
+# - The flow script loads the implementation and runs the OpenFPGA
+#   commands, which is the script to be profiled
+#####################################################################
+def write_shell_scripts(outdir, args):
+    vpr_cmd_tail = "{arch} {blif} --device {device} --route_chan_width {chan_width} --clock_modeling route".format(
+        arch=os.path.join(outdir, VPR_ARCH_FILE),
+        blif=os.path.join(outdir, BENCHMARK_NAME + ".blif"),
+        device=args.device,
+        chan_width=args.chan_width,
+    )
+    with open(os.path.join(outdir, IMPLEMENT_SCRIPT_FILE), "w") as fp:
+        fp.write("# Pack, place and route the synthetic benchmark\n")
+        for stage in ["pack", "place", "route"]:
+            fp.write(
+                "vpr_standalone "
+                + vpr_cmd_tail.replace(" --device", " --" + stage + " --device", 1)
+                + "\n"
+            )
+        fp.write("exit\n")
+
+    cmds = [
+        "vpr " + vpr_cmd_tail.replace(" --device", " --analysis --device", 1),
+        "read_openfpga_arch -f " + os.path.join(outdir, OPENFPGA_ARCH_FILE),
+        "read_openfpga_simulation_setting -f "
+        + os.path.join(
+            openfpga_path,
+            "openfpga_flow",
+            "openfpga_simulation_settings",
+            "fixed_sim_openfpga.xml",
+        ),
+        "link_openfpga_arch --sort_gsb_chan_node_in_edges",
+        "check_netlist_naming_conflict --fix --report ./netlist_renaming.xml",
+        "pb_pin_fixup",
+        "lut_truth_table_fixup",
+        "build_fabric --compress_routing",
+        "repack",
+        "build_architecture_bitstream",
+        "build_fabric_bitstream",
+        "write_fabric_bitstream --file fabric_bitstream.bit --format plain_text",
+    ]
+    if not args.no_writers:
+        cmds += [
+            "write_fabric_verilog --file ./SRC --explicit_port_mapping --include_timing",
+            "write_pnr_sdc --file ./SDC",
+        ]
+    cmds.append("exit")
+    with open(os.path.join(outdir, FLOW_SCRIPT_FILE), "w") as fp:
+        fp.write("# Run the OpenFPGA flow on the implemented synthetic benchmark\n")
+        fp.write("\n".join(cmds) + "\n")
+
+
+#####################################################################
+# Check the options which must be consistent with each other
+#####################################################################
+def check_options(args):
+    if (args.width < 1) or (args.height < 1):
+        logging.error("Array size must be positive!")
+        return False
+    if (args.lut_size < 2) or (args.lut_size > 8):
+        logging.error("LUT size must be in [2, 8]!")
+        return False
+    if args.cluster_size < 1:
+        logging.error("Cluster size must be positive!")
+        return False
+    if (args.chan_width < 2) or (0 != args.chan_width % 2):
+        logging.error("Channel width must be an even number, as routing wires are unidirectional!")
+        return False
+    if args.segment_length < 1:
+        logging.error("Segment length must be positive!")
+        return False
+    if (0 < args.dsp_period) and ((args.dsp_startx < 1) or (args.dsp_startx > args.width)):
+        logging.error("The first column of multipliers must be inside the array!")
+        return False
+    for ratio in [args.utilization, args.io_utilization, args.ff_ratio, args.dsp_utilization]:
+        if (ratio < 0.0) or (ratio > 1.0):
+            logging.error("Utilization and ratio options must be in [0, 1]!")
+            return False
+    return True
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Generate a synthetic architecture and benchmark of a given size"
+    )
+    parser.add_argument("--outdir", required=True, help="Directory to write all the files")
+    parser.add_argument(
+        "--width", type=int, default=100, help="Number of columns of the core array"
+    )
+    parser.add_argument("--height", type=int, default=100, help="Number of rows of the core array")
+    parser.add_argument("--chan_width", type=int, default=60, help="Routing channel width")
+    parser.add_argument("--segment_length", type=int, default=4, help="Length of routing wires")
+    parser.add_argument("--lut_size", type=int, default=4, help="Number of inputs of LUTs (K)")
+    parser.add_argument("--cluster_size", type=int, default=4, help="Number of LUTs per CLB (N)")
+    parser.add_argument(
+        "--dsp_period",
+        type=int,
+        default=0,
+        help="Insert a column of 8-bit multipliers every <int> columns. 0 disables multipliers",
+    )
+    parser.add_argument("--dsp_startx", type=int, default=2, help="Column of the first multipliers")
+    parser.add_argument(
+        "--config_protocol",
+        default="scan_chain",
+        choices=sorted(config_memory_models.keys()),
+        help="Configuration protocol of the fabric",
+    )
+    parser.add_argument(
+        "--utilization", type=float, default=0.5, help="Ratio of LUTs used by the benchmark"
+    )
+    parser.add_argument(
+        "--io_utilization", type=float, default=0.5, help="Ratio of I/Os used by the benchmark"
+    )
+    parser.add_argument(
+        "--dsp_utilization",
+        type=float,
+        default=0.5,
+        help="Ratio of multipliers used by the benchmark",
+    )
+    parser.add_argument("--ff_ratio", type=float, default=0.3, help="Ratio of registered LUTs")
+    parser.add_argument(
+        "--locality",
+        type=int,
+        default=256,
+        help="Number of recent signals where LUT inputs are picked",
+    )
+    parser.add_argument("--seed", type=int, default=1, help="Seed of the random generator")
+    parser.add_argument(
+        "--no_writers",
+        action="store_true",
+        help="Do not write Verilog and SDC in the flow script",
+    )
+    args = parser.parse_args()
+
+    if not check_options(args):
+        exit(error_codes["OPTION_ERROR"])
+
+    args.device = str(args.width) + "x" + str(args.height)
+    outdir = os.path.abspath(args.outdir)
+    os.makedirs(outdir, exist_ok=True)
+
+    counts = compute_tile_counts(args)
+    logging.info(
+        "Generating a {} array of {} CLBs, {} I/O tiles and {} multipliers in '{}'".format(
+            args.device, counts["clb"], counts["io"], counts["dsp"], outdir
+        )
+    )
+    write_vpr_arch(os.path.join(outdir, VPR_ARCH_FILE), args)
+    write_openfpga_arch(os.path.join(outdir, OPENFPGA_ARCH_FILE), args)
+    stats = generate_benchmark(os.path.join(outdir, BENCHMARK_NAME + ".blif"), args, counts)
+    logging.info(
+        "Benchmark has {num_luts} LUTs, {num_latches} FFs, {num_mults} multipliers, "
+        "{num_inputs} inputs and {num_outputs} outputs".format(**stats)
+    )
+    write_shell_scripts(outdir, args)
+
+    # Parameters are recorded to tag the results of the stress test
+    manifest = {
+        "params": {
+            "device": args.device,
+            "chan_width": args.chan_width,
+            "segment_length": args.segment_length,
+            "lut_size": args.lut_size,
+            "cluster_size": args.cluster_size,
+            "dsp_period": args.dsp_period,
+            "config_protocol": args.config_protocol,
+            "utilization": args.utilization,
+            "seed": args.seed,
+        },
+        "tiles": counts,
+        "benchmark": stats,
+        "files": {
+            "vpr_arch": VPR_ARCH_FILE,
+            "openfpga_arch": OPENFPGA_ARCH_FILE,
+            "benchmark": BENCHMARK_NAME + ".blif",
+            "implement_script": IMPLEMENT_SCRIPT_FILE,
+            "flow_script": FLOW_SCRIPT_FILE,
+            "implementation": [BENCHMARK_NAME + ext for ext in [".net", ".place", ".route"]],
+        },
+    }
+    with open(os.path.join(outdir, MANIFEST_FILE), "w") as fp:
+        json.dump(manifest, fp, indent=2)
+
+    exit(error_codes["SUCCESS"])
+
+
+if __name__ == "__main__":
+    main()
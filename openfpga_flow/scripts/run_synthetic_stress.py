@@ -0,0 +1,333 @@
+# = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = =
+# Script Name   : run_synthetic_stress.py
+# Description   : This script runs the OpenFPGA flow on a synthetic
+#                 architecture generated by generate_synthetic_arch.py and
+#                 records the runtime and peak memory of each command.
+#                 The peak memory of each command is recorded by the
+#                 OpenFPGA shell (--record_memory), see report_memory_usage.
+#                 Results are written in JSON lines, in the same format as
+#                 the openfpga_bench tool, so that they can be tracked
+#                 across revisions
+# Args          : python3 run_synthetic_stress.py --help
+# = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = =
+
+import os
+import re
+import sys
+import json
+import time
+import shutil
+import argparse
+import logging
+import subprocess
+import threading
+
+if sys.version_info[0] < 3:
+    raise Exception("run_synthetic_stress script must be using Python 3")
+
+#####################################################################
+# Error codes
+#####################################################################
+error_codes = {"SUCCESS": 0, "ERROR": 1, "OPTION_ERROR": 2, "FILE_ERROR": 3}
+
+#####################################################################
+# Initialize logger
+#####################################################################
+logging.basicConfig(format="%(levelname)s: %(message)s", level=logging.INFO)
+
+openfpga_path = os.path.abspath(
+    os.path.join(os.path.dirname(os.path.abspath(__file__)), os.pardir, os.pardir)
+)
+
+# Message printed by the OpenFPGA shell before executing a command of a script
+COMMAND_MARKER = "Command line to execute: "
+# Command appended to scripts to report the memory of each command, and the
+# message printed before its records
+REPORT_COMMAND = "report_memory_usage"
+RECORDS_MARKER = "Resident memory of executed commands (MiB):"
+
+
+#####################################################################
+# Monitor the memory of a running process
+# The resident memory of the process (VmRSS) is sampled periodically,
+# whose maximum is a lower bound of the peak. It is only used for the
+# commands which are not recorded by the OpenFPGA shell, e.g., the
+# start-up. The peak memory of the process (VmHWM) is not reset here,
+# as the shell resets it for each command when recording memory
+#####################################################################
+class MemoryMonitor:
+    def __init__(self, pid, interval):
+        self.pid = pid
+        self.interval = interval
+        self.lock = threading.Lock()
+        self.sampled_peak_kb = 0
+        self.stopped = threading.Event()
+        self.thread = threading.Thread(target=self.sample, daemon=True)
+        self.thread.start()
+
+    def read_status_kb(self, key):
+        try:
+            with open("/proc/" + str(self.pid) + "/status") as fp:
+                for line in fp:
+                    if line.startswith(key + ":"):
+                        return int(line.split()[1])
+        except (OSError, ValueError):
+            pass
+        return 0
+
+    def sample(self):
+        while not self.stopped.wait(self.interval):
+            rss_kb = self.read_status_kb("VmRSS")
+            with self.lock:
+                self.sampled_peak_kb = max(self.sampled_peak_kb, rss_kb)
+
+    # Return the sampled peak memory since the last call, and start a new period
+    def next_period(self):
+        with self.lock:
+            peak_kb = max(self.sampled_peak_kb, self.read_status_kb("VmRSS"))
+            self.sampled_peak_kb = 0
+        return peak_kb
+
+    def stop(self):
+        self.stopped.set()
+        self.thread.join()
+
+
+#####################################################################
+# Write a copy of an OpenFPGA shell script which reports the memory of
+# each command by report_memory_usage before the script exits
+#####################################################################
+def write_profiled_script(script, profiled_script):
+    with open(script) as fp:
+        lines = fp.read().splitlines()
+    # Insert the report before the trailing exit command, if any
+    iexit = len(lines)
+    for iline in range(len(lines) - 1, -1, -1):
+        cmd = lines[iline].strip()
+        if not cmd or cmd.startswith("#"):
+            continue
+        if cmd.split()[0] == "exit":
+            iexit = iline
+        break
+    lines.insert(iexit, REPORT_COMMAND)
+    with open(profiled_script, "w") as fp:
+        fp.write("\n".join(lines) + "\n")
+
+
+#####################################################################
+# Parse the peak memory of each top-level command reported by
+# report_memory_usage, as a list of (command line, peak memory in KiB)
+# A row of the report is
+#   <before> <after> <delta> <peak>[*] <indent by depth><command line>
+#####################################################################
+def parse_command_memory_records(log_lines):
+    records = []
+    in_report = False
+    row = re.compile(r"^\s*[\d.]+\s+[\d.]+\s+[-+][\d.]+\s+([\d.]+)[ *] (\s*)(\S.*)$")
+    for line in log_lines:
+        if line.startswith(RECORDS_MARKER):
+            records = []
+            in_report = True
+            continue
+        if not in_report:
+            continue
+        match = row.match(line)
+        if match is None:
+            # Skip the header of the table
+            if records:
+                in_report = False
+            continue
+        # Only keep the commands of the script, not the ones they call
+        if match.group(2):
+            continue
+        records.append((match.group(3).strip(), float(match.group(1)) * 1024.0))
+    return records
+
+
+#####################################################################
+# Run an OpenFPGA shell script and split its runtime and peak memory
+# per command, using the messages printed before each command
+# The peak memory of each command is recorded by the OpenFPGA shell and
+# reported by report_memory_usage at the end of the script
+# Return the status of the process and the list of commands as
+# (command line, runtime in seconds, peak memory in KiB)
+#####################################################################
+def run_openfpga_script(openfpga_exec, script, run_dir, log_fname, interval):
+    profiled_script = os.path.splitext(log_fname)[0] + "_profiled.openfpga"
+    write_profiled_script(script, profiled_script)
+    cmd = [openfpga_exec, "--record_memory", "-batch", "-f", profiled_script]
+    # The shell prints through stdio, which is fully buffered to a pipe.
+    # Force line buffering so that markers are received when printed
+    if shutil.which("stdbuf"):
+        cmd = ["stdbuf", "-oL", "-eL"] + cmd
+    else:
+        logging.warning("stdbuf is not found, the boundary of commands may be delayed")
+
+    logging.info("Running '{}' in '{}'".format(" ".join(cmd), run_dir))
+    commands = []
+    log_lines = []
+    with open(log_fname, "w") as log:
+        process = subprocess.Popen(
+            cmd,
+            cwd=run_dir,
+            stdout=subprocess.PIPE,
+            stderr=subprocess.STDOUT,
+            universal_newlines=True,
+            bufsize=1,
+        )
+        monitor = MemoryMonitor(process.pid, interval)
+        # Time spent before the first command is the start-up of the shell
+        current_cmd = "startup"
+        start = time.monotonic()
+        for line in process.stdout:
+            log.write(line)
+            log_lines.append(line.rstrip("\n"))
+            if not line.startswith(COMMAND_MARKER):
+                continue
+            now = time.monotonic()
+            commands.append((current_cmd, now - start, monitor.next_period()))
+            current_cmd = line[len(COMMAND_MARKER) :].strip()
+            start = now
+        status = process.wait()
+        commands.append((current_cmd, time.monotonic() - start, monitor.next_period()))
+        monitor.stop()
+
+    # Replace the sampled peaks by the recorded ones, matching the commands in
+    # order. Commands without records, e.g., macro commands, keep the samples
+    records = parse_command_memory_records(log_lines)
+    if not records:
+        logging.warning(
+            "No memory record is found in '{}', ".format(log_fname)
+            + "peak memory is sampled every {} s".format(interval)
+        )
+    irecord = 0
+    profiled_commands = []
+    for cmd_line, runtime, peak_kb in commands:
+        if cmd_line == REPORT_COMMAND:
+            continue
+        for inext in range(irecord, len(records)):
+            if records[inext][0] == cmd_line:
+                peak_kb = records[inext][1]
+                irecord = inext + 1
+                break
+        profiled_commands.append((cmd_line, runtime, peak_kb))
+    return status, profiled_commands
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Profile the OpenFPGA flow on a synthetic architecture"
+    )
+    parser.add_argument(
+        "run_dir", help="Directory of a synthetic architecture by generate_synthetic_arch.py"
+    )
+    parser.add_argument(
+        "--openfpga",
+        default=os.path.join(openfpga_path, "build", "openfpga", "openfpga"),
+        help="Path to the OpenFPGA executable",
+    )
+    parser.add_argument(
+        "--output",
+        default="synthetic_stress.jsonl",
+        help="File to write results in JSON lines",
+    )
+    parser.add_argument(
+        "--append",
+        action="store_true",
+        help="Append results to the output file instead of overwriting it",
+    )
+    parser.add_argument(
+        "--reimplement",
+        action="store_true",
+        help="Pack, place and route the benchmark again, even if results exist",
+    )
+    parser.add_argument(
+        "--profile_implementation",
+        action="store_true",
+        help="Record the commands of packing, placement and routing as well",
+    )
+    parser.add_argument(
+        "--tag",
+        default="",
+        help="Tag of the results, e.g., a revision, to compare results",
+    )
+    parser.add_argument(
+        "--interval",
+        type=float,
+        default=0.05,
+        help="Interval in seconds of memory sampling",
+    )
+    args = parser.parse_args()
+
+    run_dir = os.path.abspath(args.run_dir)
+    manifest_fname = os.path.join(run_dir, "synthetic_arch.json")
+    if not os.path.isfile(manifest_fname):
+        logging.error(
+            "'{}' is not found! Run generate_synthetic_arch.py first".format(manifest_fname)
+        )
+        exit(error_codes["FILE_ERROR"])
+    if not os.path.isfile(args.openfpga):
+        logging.error("OpenFPGA executable '{}' is not found!".format(args.openfpga))
+        exit(error_codes["FILE_ERROR"])
+    with open(manifest_fname) as fp:
+        manifest = json.load(fp)
+    files = manifest["files"]
+
+    params = dict(manifest["params"])
+    params.update(manifest["benchmark"])
+    if args.tag:
+        params["tag"] = args.tag
+    params = {key: str(value) for key, value in params.items()}
+
+    # Pack, place and route once, so that following runs only profile OpenFPGA
+    scripts = []
+    implemented = all(
+        [os.path.isfile(os.path.join(run_dir, fname)) for fname in files["implementation"]]
+    )
+    if args.reimplement or not implemented:
+        scripts.append(("implement", files["implement_script"], args.profile_implementation))
+    scripts.append(("flow", files["flow_script"], True))
+
+    results = []
+    for name, script, recorded in scripts:
+        log_fname = os.path.join(run_dir, name + ".log")
+        status, commands = run_openfpga_script(
+            args.openfpga, os.path.join(run_dir, script), run_dir, log_fname, args.interval
+        )
+        if 0 != status:
+            logging.error("Script '{}' failed! See '{}'".format(script, log_fname))
+            exit(error_codes["ERROR"])
+        if not recorded:
+            continue
+        for cmd_line, runtime, peak_kb in commands:
+            cmd_name = cmd_line.split(" ")[0]
+            logging.info(
+                "{:<40} {:>12.3f} s {:>12.1f} MiB".format(cmd_name, runtime, peak_kb / 1024.0)
+            )
+            results.append(
+                {
+                    "suite": "stress",
+                    "name": name + "." + cmd_name,
+                    "params": params,
+                    "command": cmd_line,
+                    "num_items": 1,
+                    "num_samples": 1,
+                    "min_s": runtime,
+                    "median_s": runtime,
+                    "mean_s": runtime,
+                    "max_s": runtime,
+                    "samples_s": [runtime],
+                    "peak_memory_kib": peak_kb,
+                }
+            )
+
+    with open(args.output, "a" if args.append else "w") as fp:
+        for result in results:
+            fp.write(json.dumps(result) + "\n")
+    logging.info("Wrote {} results to '{}'".format(len(results), args.output))
+
+    exit(error_codes["SUCCESS"])
+
+
+if __name__ == "__main__":
+    main()